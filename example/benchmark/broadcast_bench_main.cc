@@ -0,0 +1,133 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/dx_log.h>
+#include <gflags/gflags.h>
+#include <chrono>
+#include <random>
+#include <vector>
+#include "../../src/graph/op/kernel/broadcast.h"
+
+DEFINE_int32(loops, 20, "number of loops");
+
+namespace deepx_core {
+namespace {
+
+using steady_clock_t = std::chrono::steady_clock;
+using Meta = BinaryMulMeta<float>;
+
+// The element-wise kernel, which walks Z linearly and carries indices of the
+// original axes.
+template <class Func>
+void NaiveForEach(const BroadcastAux& aux, Func&& func) {
+  int rank = aux.Z.rank();
+  int index[SHAPE_MAX_RANK] = {0};
+  int x = 0, y = 0;
+  for (int z = 0; z < aux.Z_total_dim; ++z) {
+    func(x, y, z);
+    for (int j = rank - 1; j >= 0; --j) {
+      x += aux.Xstrides[j];
+      y += aux.Ystrides[j];
+      if (++index[j] < aux.Z[j]) {
+        break;
+      }
+      index[j] = 0;
+      x -= aux.Z[j] * aux.Xstrides[j];
+      y -= aux.Z[j] * aux.Ystrides[j];
+    }
+  }
+}
+
+void NaiveBroadcast(const float* X, const float* Y, float* Z,
+                    const BroadcastAux& aux) {
+  NaiveForEach(aux, [&](int x, int y, int z) {
+    Meta::Forward(X + x, Y + y, Z + z);
+  });
+}
+
+void NaiveBroadcastBackward(const float* X, const float* Y, const float* Z,
+                            const float* gZ, float* gX, float* gY,
+                            const BroadcastAux& aux) {
+  NaiveForEach(aux, [&](int x, int y, int z) {
+    Meta::Backward(X + x, Y + y, Z + z, gZ + z, gX + x, gY + y);
+  });
+}
+
+// Return G elements/s.
+template <class Func>
+double Run(Func&& func, int total_dim) {
+  func();  // warm up
+  auto begin = steady_clock_t::now();
+  for (int i = 0; i < FLAGS_loops; ++i) {
+    func();
+  }
+  double seconds =
+      std::chrono::duration<double>(steady_clock_t::now() - begin).count();
+  return 1.0 * total_dim * FLAGS_loops / seconds / 1e9;
+}
+
+void Bench(const char* name, const Shape& Xshape, const Shape& Yshape) {
+  BroadcastAux aux;
+  DXCHECK_THROW(BroadcastPrepare(Xshape, Yshape, &aux));
+  int total_dim = aux.Z_total_dim;
+  std::vector<float> X(Xshape.total_dim()), Y(Yshape.total_dim());
+  std::vector<float> Z1(total_dim), Z2(total_dim);
+  std::vector<float> gX(X.size()), gY(Y.size());
+  std::default_random_engine engine;
+  std::uniform_real_distribution<float> dist;
+  for (float& x : X) {
+    x = dist(engine);
+  }
+  for (float& y : Y) {
+    y = dist(engine);
+  }
+
+  double naive = Run(
+      [&]() { NaiveBroadcast(X.data(), Y.data(), Z1.data(), aux); },
+      total_dim);
+  double engine_forward = Run(
+      [&]() {
+        detail::Broadcast<float, Meta>(X.data(), Y.data(), Z2.data(), aux);
+      },
+      total_dim);
+  DXCHECK_THROW(Z1 == Z2);
+  double naive_backward = Run(
+      [&]() {
+        NaiveBroadcastBackward(X.data(), Y.data(), Z1.data(), Z1.data(),
+                               gX.data(), gY.data(), aux);
+      },
+      total_dim);
+  double engine_backward = Run(
+      [&]() {
+        detail::BroadcastBackward<float, Meta>(X.data(), Y.data(), Z1.data(),
+                                               Z1.data(), gX.data(),
+                                               gY.data(), aux);
+      },
+      total_dim);
+  DXINFO(
+      "%-24s forward %6.2f -> %6.2f G/s, backward %6.2f -> %6.2f G/s", name,
+      naive, engine_forward, naive_backward, engine_backward);
+}
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  Bench("same", Shape(256, 1024), Shape(256, 1024));
+  Bench("scalar", Shape(256, 1024), Shape(1));
+  // bias, batch 256, 1024 units
+  Bench("row", Shape(256, 1024), Shape(1024));
+  // per-sample weight, batch 256, 1024 units
+  Bench("col", Shape(256, 1024), Shape(256, 1));
+  Bench("outer", Shape(256, 1), Shape(1, 1024));
+  // field attention, batch 256, 39 fields, embedding size 16
+  Bench("general", Shape(256, 39, 16), Shape(256, 1, 16));
+
+  google::ShutDownCommandLineFlags();
+  return 0;
+}
+
+}  // namespace
+}  // namespace deepx_core
+
+int main(int argc, char** argv) { return deepx_core::main(argc, argv); }
@@ -0,0 +1,140 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/common/chunked_stream.h>
+#include <deepx_core/common/stream.h>
+#include <deepx_core/dx_log.h>
+#include <gflags/gflags.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>  // remove
+#include <random>
+#include <string>
+#include <vector>
+
+DEFINE_string(file, "/tmp/deepx_checkpoint_compress_bench.bin", "file");
+DEFINE_int32(rows, 1000000, "number of rows of the sparse parameter");
+DEFINE_int32(col, 16, "number of columns of the sparse parameter");
+DEFINE_double(zero_ratio, 0.5, "ratio of all-zero rows, e.g. cold features");
+DEFINE_int32(chunk_size, 16, "chunk size(MB) of chunked files");
+DEFINE_int32(thread_size, 0, "number of threads of chunked files");
+
+namespace deepx_core {
+namespace {
+
+using steady_clock_t = std::chrono::steady_clock;
+
+double Seconds(steady_clock_t::time_point begin) {
+  return std::chrono::duration<double>(steady_clock_t::now() - begin).count();
+}
+
+// Rows of a sparse parameter, a feature id followed by its embedding.
+std::string MakeParam() {
+  std::default_random_engine engine;
+  std::uniform_int_distribution<uint64_t> id_dist;
+  std::normal_distribution<float> value_dist(0, 0.01f);  // magic number
+  std::uniform_real_distribution<double> zero_dist(0, 1);
+  std::vector<float> row(FLAGS_col);
+  std::string param;
+  param.reserve((size_t)FLAGS_rows *
+                (sizeof(uint64_t) + sizeof(float) * FLAGS_col));
+  for (int i = 0; i < FLAGS_rows; ++i) {
+    uint64_t id = id_dist(engine);
+    bool zero = zero_dist(engine) < FLAGS_zero_ratio;
+    for (float& value : row) {
+      value = zero ? 0 : value_dist(engine);
+    }
+    param.append((const char*)&id, sizeof(id));
+    param.append((const char*)row.data(), sizeof(float) * row.size());
+  }
+  return param;
+}
+
+size_t GetFileSize(const std::string& file, size_t chunk_size) {
+  FileStat stat;
+  size_t size = 0;
+  DXCHECK_THROW(LocalFileSystem().Stat(file, &stat));
+  size += stat.GetFileSize();
+  if (chunk_size > 0) {
+    for (int i = 0;; ++i) {
+      if (!LocalFileSystem().Stat(GetChunkFile(file, i), &stat) ||
+          !stat.Exists()) {
+        break;
+      }
+      size += stat.GetFileSize();
+    }
+  }
+  return size;
+}
+
+void Remove(const std::string& file) {
+  (void)remove(file.c_str());
+  for (int i = 0;; ++i) {
+    if (remove(GetChunkFile(file, i).c_str()) != 0) {
+      break;
+    }
+  }
+}
+
+void Bench(const std::string& param, size_t chunk_size, bool compress) {
+  auto begin = steady_clock_t::now();
+  if (chunk_size > 0) {
+    ChunkedOutputFileStream os(chunk_size, FLAGS_thread_size);
+    os.set_compress(compress);
+    DXCHECK_THROW(os.Open(FLAGS_file));
+    DXCHECK_THROW(os.Write(param.data(), param.size()) == param.size());
+    DXCHECK_THROW(os.Close());
+  } else {
+    DXCHECK_THROW(SaveFile(
+        FLAGS_file, 0,
+        [&param](OutputStream& os) {
+          return os.Write(param.data(), param.size()) == param.size();
+        },
+        compress));
+  }
+  double save_seconds = Seconds(begin);
+  size_t file_size = GetFileSize(FLAGS_file, chunk_size);
+
+  begin = steady_clock_t::now();
+  ChunkedInputFileStream is(FLAGS_thread_size);
+  DXCHECK_THROW(is.Open(FLAGS_file));
+  std::string buf(1024 * 1024, 0);  // magic number
+  size_t bytes, total_bytes = 0;
+  while ((bytes = is.Read(&buf[0], buf.size())) > 0) {
+    total_bytes += bytes;
+  }
+  DXCHECK_THROW(total_bytes == param.size());
+  double load_seconds = Seconds(begin);
+  Remove(FLAGS_file);
+
+  DXINFO("%-8s%-6s%12zu%8.3f%10.3f s%10.3f s", chunk_size ? "chunked" : "file",
+         compress ? "lz4" : "none", file_size,
+         (double)file_size / param.size(), save_seconds, load_seconds);
+}
+
+int main(int argc, char** argv) {
+  google::SetUsageMessage("Usage: [Options]");
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  DXCHECK_THROW(FLAGS_rows > 0);
+  DXCHECK_THROW(FLAGS_col > 0);
+  DXCHECK_THROW(FLAGS_chunk_size > 0);
+
+  std::string param = MakeParam();
+  DXINFO("%-8s%-6s%12s%8s%12s%12s", "format", "codec", "bytes", "ratio",
+         "save", "load");
+  for (size_t chunk_size : {(size_t)0, (size_t)FLAGS_chunk_size << 20}) {
+    for (bool compress : {false, true}) {
+      Bench(param, chunk_size, compress);
+    }
+  }
+
+  google::ShutDownCommandLineFlags();
+  return 0;
+}
+
+}  // namespace
+}  // namespace deepx_core
+
+int main(int argc, char** argv) { return deepx_core::main(argc, argv); }
@@ -0,0 +1,113 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/common/stream.h>
+#include <deepx_core/dx_log.h>
+#include <gflags/gflags.h>
+#include <chrono>
+#include <random>
+#include <string>
+
+DEFINE_string(file, "",
+              "input file, a libsvm-like file is generated if it is empty");
+DEFINE_string(tmp_file, "/tmp/deepx_getline_bench.txt", "generated file");
+DEFINE_int32(mb, 256, "MB of the generated file");
+DEFINE_int32(repeats, 3, "number of repeats, the best is reported");
+
+namespace deepx_core {
+namespace {
+
+using steady_clock_t = std::chrono::steady_clock;
+
+void Generate(const std::string& file, size_t bytes) {
+  AutoOutputFileStream os;
+  DXCHECK_THROW(os.Open(file));
+  std::default_random_engine engine;
+  std::uniform_int_distribution<int> features(10, 200);  // magic number
+  std::uniform_int_distribution<int> id(1, 1000000);     // magic number
+  std::string line;
+  size_t written = 0;
+  while (written < bytes) {
+    line = "1";
+    int n = features(engine);
+    for (int i = 0; i < n; ++i) {
+      line += ' ';
+      line += std::to_string(id(engine));
+      line += ":1";
+    }
+    line += '\n';
+    DXCHECK_THROW(os.Write(line.data(), line.size()) == line.size());
+    written += line.size();
+  }
+}
+
+// the original 'GetLine'
+InputStream& GetLineByChar(InputStream& is, std::string& line) {  // NOLINT
+  char c;
+  line.clear();
+  for (;;) {
+    c = is.ReadChar();
+    if (!is || c == '\n') {
+      break;
+    }
+    line.push_back(c);
+  }
+  return is;
+}
+
+template <class Func>
+void Bench(const char* name, const std::string& file, Func&& func) {
+  double best = 0;
+  size_t lines = 0;
+  for (int i = 0; i < FLAGS_repeats; ++i) {
+    AutoInputFileStream is;
+    DXCHECK_THROW(is.Open(file));
+    std::string line;
+    size_t bytes = 0;
+    lines = 0;
+    auto begin = steady_clock_t::now();
+    while (func(is, line)) {
+      bytes += line.size() + 1;
+      ++lines;
+    }
+    double seconds =
+        std::chrono::duration<double>(steady_clock_t::now() - begin).count();
+    double mbps = bytes / seconds / 1e6;
+    if (best < mbps) {
+      best = mbps;
+    }
+  }
+  DXINFO("%-16s%12zu lines%12.1f MB/s", name, lines, best);
+}
+
+int main(int argc, char** argv) {
+  google::SetUsageMessage("Usage: [Options]");
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  DXCHECK_THROW(FLAGS_mb > 0);
+  DXCHECK_THROW(FLAGS_repeats > 0);
+
+  std::string file = FLAGS_file;
+  if (file.empty()) {
+    file = FLAGS_tmp_file;
+    DXINFO("Generating %s...", file.c_str());
+    Generate(file, (size_t)FLAGS_mb * 1024 * 1024);
+    DXINFO("Done.");
+  }
+
+  Bench("ReadChar loop", file, [](InputStream& is, std::string& line) {
+    return (bool)GetLineByChar(is, line);
+  });
+  Bench("GetLine", file, [](InputStream& is, std::string& line) {
+    return (bool)GetLine(is, line);
+  });
+
+  google::ShutDownCommandLineFlags();
+  return 0;
+}
+
+}  // namespace
+}  // namespace deepx_core
+
+int main(int argc, char** argv) { return deepx_core::main(argc, argv); }
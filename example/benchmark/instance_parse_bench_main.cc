@@ -0,0 +1,179 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/dx_log.h>
+#include <deepx_core/instance/libsvm.h>
+#include <deepx_core/instance/libsvm_ex.h>
+#include <deepx_core/instance/uch.h>
+#include <deepx_core/tensor/data_type.h>
+#include <gflags/gflags.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+DEFINE_int32(lines, 100000, "number of lines");
+DEFINE_int32(features, 100, "number of features per line");
+DEFINE_int32(batch, 32, "batch size");
+DEFINE_int32(repeats, 5, "number of repeats, the best is reported");
+
+namespace deepx_core {
+namespace {
+
+using steady_clock_t = std::chrono::steady_clock;
+using float_t = DataType::float_t;
+using int_t = DataType::int_t;
+using tsr_t = DataType::tsr_t;
+using csr_t = DataType::csr_t;
+using tsrs_t = DataType::tsrs_t;
+
+// 'groups' > 1 separates features with '|'.
+// 'value' is the format of feature values, "" for no values.
+std::vector<std::string> Generate(int groups, const char* value) {
+  std::default_random_engine engine;
+  std::uniform_int_distribution<uint64_t> id(1, UINT64_C(1) << 48);
+  std::vector<std::string> lines((size_t)FLAGS_lines);
+  for (std::string& line : lines) {
+    line = "1";
+    for (int i = 0; i < FLAGS_features; ++i) {
+      line += ' ';
+      if (groups > 1 && i > 0 && i % (FLAGS_features / groups) == 0) {
+        line += "| ";
+      }
+      line += std::to_string(id(engine));
+      if (*value) {
+        line += ':';
+        line += value;
+      }
+    }
+  }
+  return lines;
+}
+
+template <class Func>
+void Bench(const char* name, const std::vector<std::string>& lines,
+           Func&& func) {
+  size_t bytes = 0;
+  for (const std::string& line : lines) {
+    bytes += line.size() + 1;
+  }
+
+  double best = 0;
+  for (int i = 0; i < FLAGS_repeats; ++i) {
+    double seconds = 0;
+    for (size_t j = 0; j < lines.size(); j += (size_t)FLAGS_batch) {
+      size_t k = std::min(j + (size_t)FLAGS_batch, lines.size());
+      seconds += func(lines, j, k);
+    }
+    double mbps = bytes / seconds / 1e6;
+    if (best < mbps) {
+      best = mbps;
+    }
+  }
+  DXINFO("%-24s%12.1f MB/s", name, best);
+}
+
+double Seconds(steady_clock_t::time_point begin) {
+  return std::chrono::duration<double>(steady_clock_t::now() - begin).count();
+}
+
+void BenchLibsvm(const char* name, const char* value) {
+  using reader_t = LibsvmInstanceReaderHelper<float_t, int_t>;
+  csr_t X;
+  tsr_t Y, W;
+  Bench(name, Generate(1, value),
+        [&X, &Y, &W](const std::vector<std::string>& lines, size_t j,
+                     size_t k) {
+          X.clear();
+          Y.resize(0, 1);
+          W.resize(0, 1);
+          auto begin = steady_clock_t::now();
+          for (; j < k; ++j) {
+            DXCHECK_THROW(reader_t(lines[j]).Parse(&X, &Y, &W, nullptr));
+          }
+          return Seconds(begin);
+        });
+}
+
+void BenchLibsvmEx(const char* name, const char* value) {
+  using reader_t = LibsvmExInstanceReaderHelper<float_t, int_t>;
+  const int groups = 4;  // magic number
+  std::vector<csr_t> _X(groups);
+  std::vector<csr_t*> X;
+  for (csr_t& x : _X) {
+    X.emplace_back(&x);
+  }
+  tsr_t Y, W;
+  Bench(name, Generate(groups, value),
+        [&_X, &X, &Y, &W](const std::vector<std::string>& lines, size_t j,
+                          size_t k) {
+          for (csr_t& x : _X) {
+            x.clear();
+          }
+          Y.resize(0, 1);
+          W.resize(0, 1);
+          auto begin = steady_clock_t::now();
+          for (; j < k; ++j) {
+            DXCHECK_THROW(reader_t(lines[j]).Parse(&X, &Y, &W, nullptr));
+          }
+          return Seconds(begin);
+        });
+}
+
+void BenchUCH(const char* name, const char* value) {
+  using reader_t = UCHInstanceReaderHelper<float_t, int_t>;
+  const int groups = 4;  // magic number
+  csr_t X_user, X_cand;
+  std::vector<csr_t> _X_hist(groups - 2);
+  std::vector<csr_t*> X_hist;
+  for (csr_t& x : _X_hist) {
+    X_hist.emplace_back(&x);
+  }
+  tsr_t X_hist_size, Y, W;
+  Bench(name, Generate(groups, value),
+        [&](const std::vector<std::string>& lines, size_t j, size_t k) {
+          X_user.clear();
+          X_cand.clear();
+          for (csr_t& x : _X_hist) {
+            x.clear();
+          }
+          X_hist_size.resize(0);
+          Y.resize(0, 1);
+          W.resize(0, 1);
+          auto begin = steady_clock_t::now();
+          for (; j < k; ++j) {
+            DXCHECK_THROW(reader_t(lines[j]).Parse(
+                &X_user, &X_cand, &X_hist, &X_hist_size, &Y, &W, nullptr));
+          }
+          return Seconds(begin);
+        });
+}
+
+int main(int argc, char** argv) {
+  google::SetUsageMessage("Usage: [Options]");
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  DXCHECK_THROW(FLAGS_lines > 0);
+  DXCHECK_THROW(FLAGS_features >= 4);
+  DXCHECK_THROW(FLAGS_batch > 0);
+  DXCHECK_THROW(FLAGS_repeats > 0);
+
+  BenchLibsvm("libsvm id", "");
+  BenchLibsvm("libsvm id:1", "1");
+  BenchLibsvm("libsvm id:0.125", "0.125");
+  BenchLibsvm("libsvm id:-0.3207547", "-0.3207547");
+  BenchLibsvmEx("libsvm_ex id", "");
+  BenchLibsvmEx("libsvm_ex id:0.125", "0.125");
+  BenchUCH("uch id", "");
+  BenchUCH("uch id:0.125", "0.125");
+
+  google::ShutDownCommandLineFlags();
+  return 0;
+}
+
+}  // namespace
+}  // namespace deepx_core
+
+int main(int argc, char** argv) { return deepx_core::main(argc, argv); }
@@ -0,0 +1,115 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/common/any_map.h>
+#include <deepx_core/common/str_util.h>
+#include <deepx_core/common/stream.h>
+#include <deepx_core/dx_log.h>
+#include <deepx_core/graph/instance_reader.h>
+#include <gflags/gflags.h>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+DEFINE_string(file, "",
+              "input file, a libsvm file is generated if it is empty");
+DEFINE_string(tmp_file, "/tmp/deepx_instance_reader_bench.txt",
+              "generated file");
+DEFINE_int32(mb, 256, "MB of the generated file");
+DEFINE_string(instance_reader, "libsvm", "instance reader name");
+DEFINE_string(instance_reader_config, "batch=32",
+              "instance reader config, parse_thread is appended");
+DEFINE_string(parse_threads, "1;2;4;8", "values of parse_thread");
+DEFINE_int32(repeats, 3, "number of repeats, the best is reported");
+
+namespace deepx_core {
+namespace {
+
+using steady_clock_t = std::chrono::steady_clock;
+
+void Generate(const std::string& file, size_t bytes) {
+  AutoOutputFileStream os;
+  DXCHECK_THROW(os.Open(file));
+  std::default_random_engine engine;
+  std::uniform_int_distribution<int> features(10, 200);  // magic number
+  std::uniform_int_distribution<uint64_t> id(1, UINT64_C(1) << 48);
+  std::string line;
+  size_t written = 0;
+  while (written < bytes) {
+    line = "1";
+    int n = features(engine);
+    for (int i = 0; i < n; ++i) {
+      line += ' ';
+      line += std::to_string(id(engine));
+      line += ":1";
+    }
+    line += '\n';
+    DXCHECK_THROW(os.Write(line.data(), line.size()) == line.size());
+    written += line.size();
+  }
+}
+
+void Bench(const std::string& file, int parse_thread) {
+  StringMap config;
+  DXCHECK_THROW(ParseConfig(FLAGS_instance_reader_config, &config));
+  config["parse_thread"] = std::to_string(parse_thread);
+
+  size_t bytes;
+  DXCHECK_THROW(AutoFileSystem::GetFileSize(file, &bytes));
+  double best = 0;
+  size_t rows = 0;
+  for (int i = 0; i < FLAGS_repeats; ++i) {
+    std::unique_ptr<InstanceReader> reader =
+        NewInstanceReader(FLAGS_instance_reader);
+    DXCHECK_THROW(reader);
+    DXCHECK_THROW(reader->InitConfig(config));
+    DXCHECK_THROW(reader->Open(file));
+    Instance inst;
+    rows = 0;
+    auto begin = steady_clock_t::now();
+    while (reader->GetBatch(&inst)) {
+      rows += (size_t)inst.batch();
+    }
+    rows += (size_t)inst.batch();
+    double seconds =
+        std::chrono::duration<double>(steady_clock_t::now() - begin).count();
+    double mbps = bytes / seconds / 1e6;
+    if (best < mbps) {
+      best = mbps;
+    }
+  }
+  DXINFO("parse_thread=%-4d%12zu rows%12.1f MB/s", parse_thread, rows, best);
+}
+
+int main(int argc, char** argv) {
+  google::SetUsageMessage("Usage: [Options]");
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  DXCHECK_THROW(FLAGS_mb > 0);
+  DXCHECK_THROW(FLAGS_repeats > 0);
+  std::vector<int> parse_threads;
+  DXCHECK_THROW(Split(FLAGS_parse_threads, ";", &parse_threads));
+
+  std::string file = FLAGS_file;
+  if (file.empty()) {
+    file = FLAGS_tmp_file;
+    DXINFO("Generating %s...", file.c_str());
+    Generate(file, (size_t)FLAGS_mb * 1024 * 1024);
+    DXINFO("Done.");
+  }
+
+  for (int parse_thread : parse_threads) {
+    Bench(file, parse_thread);
+  }
+
+  google::ShutDownCommandLineFlags();
+  return 0;
+}
+
+}  // namespace
+}  // namespace deepx_core
+
+int main(int argc, char** argv) { return deepx_core::main(argc, argv); }
@@ -0,0 +1,127 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/common/io_uring.h>
+#include <deepx_core/common/stream.h>
+#include <deepx_core/dx_log.h>
+#include <gflags/gflags.h>
+#include <unistd.h>  // sync
+#include <chrono>
+#include <cstdio>   // remove
+#include <cstdlib>  // setenv
+#include <string>
+#include <vector>
+
+DEFINE_string(dir, "/tmp/deepx_io_uring_bench", "working dir");
+DEFINE_int32(mb, 256, "MB of the file read and written");
+DEFINE_int32(files, 20000, "number of files listed");
+DEFINE_int32(repeats, 3, "number of repeats, the best is reported");
+DEFINE_bool(drop_caches, false, "drop the page cache before every run");
+
+namespace deepx_core {
+namespace {
+
+using steady_clock_t = std::chrono::steady_clock;
+
+double Seconds(steady_clock_t::time_point begin) {
+  return std::chrono::duration<double>(steady_clock_t::now() - begin).count();
+}
+
+void SetIoUring(int io_uring) {
+  DXCHECK_THROW(setenv("DEEPX_IO_URING", io_uring ? "1" : "0", 1) == 0);
+}
+
+// It requires root.
+void DropCaches() {
+  sync();
+  CFileStream os;
+  DXCHECK_THROW(os.Open("/proc/sys/vm/drop_caches", FILE_OPEN_MODE_OUT));
+  DXCHECK_THROW(os.Write("3", 1) == 1 && os.Flush());
+}
+
+template <class Func>
+void Bench(const char* name, Func&& func) {
+  for (int io_uring : {0, 1}) {
+    SetIoUring(io_uring);
+    double best = 1e30;  // magic number
+    for (int i = 0; i < FLAGS_repeats; ++i) {
+      if (FLAGS_drop_caches) {
+        DropCaches();
+      }
+      auto begin = steady_clock_t::now();
+      func();
+      double seconds = Seconds(begin);
+      if (best > seconds) {
+        best = seconds;
+      }
+    }
+    DXINFO("%-16s%-12s%12.3f s", name, io_uring ? "io_uring" : "stdio", best);
+  }
+}
+
+int main(int argc, char** argv) {
+  google::SetUsageMessage("Usage: [Options]");
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  DXCHECK_THROW(FLAGS_mb > 0);
+  DXCHECK_THROW(FLAGS_files > 0);
+  DXCHECK_THROW(FLAGS_repeats > 0);
+  DXINFO("io_uring is %savailable.", IoUring::Available() ? "" : "un");
+
+  (void)AutoFileSystem::MakeDir(FLAGS_dir);
+  std::string file = FLAGS_dir + "/file.txt";
+  std::string data(1024 * 1024, 'x');  // magic number
+  for (size_t i = 127; i < data.size(); i += 128) {
+    data[i] = '\n';
+  }
+
+  Bench("write", [&file, &data]() {
+    AutoOutputFileStream os;
+    DXCHECK_THROW(os.Open(file));
+    for (int i = 0; i < FLAGS_mb; ++i) {
+      DXCHECK_THROW(os.Write(data.data(), data.size()) == data.size());
+    }
+    DXCHECK_THROW(os.Flush());
+    // Count writing back the page cache.
+    sync();
+  });
+
+  Bench("read", [&file]() {
+    AutoInputFileStream is;
+    is.set_read_ahead(true);
+    DXCHECK_THROW(is.Open(file));
+    std::string line;
+    size_t bytes = 0;
+    while (GetLine(is, line)) {
+      bytes += line.size() + 1;
+    }
+    DXCHECK_THROW(bytes == (size_t)FLAGS_mb * 1024 * 1024);
+  });
+  (void)remove(file.c_str());
+
+  std::string list_dir = FLAGS_dir + "/list";
+  (void)AutoFileSystem::MakeDir(list_dir);
+  SetIoUring(0);
+  for (int i = 0; i < FLAGS_files; ++i) {
+    AutoOutputFileStream os;
+    DXCHECK_THROW(os.Open(list_dir + "/" + std::to_string(i)));
+  }
+
+  Bench("list", [&list_dir]() {
+    std::vector<std::string> children;
+    DXCHECK_THROW(AutoFileSystem::ListRecursive(list_dir, true, &children));
+    DXCHECK_THROW(children.size() == (size_t)FLAGS_files);
+  });
+  for (int i = 0; i < FLAGS_files; ++i) {
+    (void)remove((list_dir + "/" + std::to_string(i)).c_str());
+  }
+
+  google::ShutDownCommandLineFlags();
+  return 0;
+}
+
+}  // namespace
+}  // namespace deepx_core
+
+int main(int argc, char** argv) { return deepx_core::main(argc, argv); }
@@ -0,0 +1,147 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/common/blocking_queue.h>
+#include <deepx_core/common/mpmc_queue.h>
+#include <deepx_core/dx_log.h>
+#include <gflags/gflags.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+DEFINE_int32(producers, 2, "number of producer threads");
+DEFINE_int32(consumers, 2, "number of consumer threads");
+DEFINE_int32(items, 4000000, "number of items");
+DEFINE_int32(capacity, 1024, "capacity of MPMCQueue");
+DEFINE_int32(batch, 32, "batch size of batch push/pop");
+
+namespace deepx_core {
+namespace {
+
+using steady_clock_t = std::chrono::steady_clock;
+
+// Run producers and consumers, return items per second.
+template <class PushFunc, class PopFunc>
+double Run(PushFunc&& push_func, PopFunc&& pop_func, void (*stop_func)(void*),
+           void* queue) {
+  int per_producer = FLAGS_items / FLAGS_producers;
+  std::atomic<int> producers(FLAGS_producers);
+  std::atomic<long long> popped(0);
+  std::vector<std::thread> threads;
+
+  auto begin = steady_clock_t::now();
+  for (int p = 0; p < FLAGS_producers; ++p) {
+    threads.emplace_back([&, per_producer]() {
+      push_func(per_producer);
+      if (--producers == 0) {
+        stop_func(queue);
+      }
+    });
+  }
+  for (int c = 0; c < FLAGS_consumers; ++c) {
+    threads.emplace_back([&]() { popped += pop_func(); });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  double seconds =
+      std::chrono::duration<double>(steady_clock_t::now() - begin).count();
+  DXCHECK_THROW(popped == (long long)per_producer * FLAGS_producers);
+  return popped / seconds;
+}
+
+void BenchBlockingQueue() {
+  BlockingQueue<int> queue;
+  queue.start();
+  double qps = Run(
+      [&queue](int n) {
+        for (int i = 0; i < n; ++i) {
+          queue.push(i);
+        }
+      },
+      [&queue]() {
+        long long popped = 0;
+        int item;
+        while (queue.pop(&item)) {
+          ++popped;
+        }
+        return popped;
+      },
+      [](void* q) { ((BlockingQueue<int>*)q)->stop(); }, &queue);
+  DXINFO("%-28s%12.0f items/s", "BlockingQueue", qps);
+}
+
+template <class WaitPolicy>
+void BenchMPMCQueue(const char* name) {
+  using queue_t = MPMCQueue<int, WaitPolicy>;
+  queue_t queue((size_t)FLAGS_capacity);
+  queue.start();
+  double qps = Run(
+      [&queue](int n) {
+        for (int i = 0; i < n; ++i) {
+          queue.push(i);
+        }
+      },
+      [&queue]() {
+        long long popped = 0;
+        int item;
+        while (queue.pop(&item)) {
+          ++popped;
+        }
+        return popped;
+      },
+      [](void* q) { ((queue_t*)q)->stop(); }, &queue);
+  DXINFO("%-28s%12.0f items/s", name, qps);
+}
+
+void BenchMPMCQueueBatch() {
+  using queue_t = MPMCQueue<int>;
+  queue_t queue((size_t)FLAGS_capacity);
+  queue.start();
+  double qps = Run(
+      [&queue](int n) {
+        std::vector<int> items((size_t)FLAGS_batch);
+        for (int i = 0; i < n; i += FLAGS_batch) {
+          size_t m = (size_t)std::min(FLAGS_batch, n - i);
+          queue.push_batch(items.begin(), m);
+        }
+      },
+      [&queue]() {
+        long long popped = 0;
+        std::vector<int> items((size_t)FLAGS_batch);
+        size_t m;
+        while ((m = queue.pop_batch(items.begin(), items.size())) > 0) {
+          popped += (long long)m;
+        }
+        return popped;
+      },
+      [](void* q) { ((queue_t*)q)->stop(); }, &queue);
+  DXINFO("%-28s%12.0f items/s", "MPMCQueue<Blocking> batch", qps);
+}
+
+int main(int argc, char** argv) {
+  google::SetUsageMessage("Usage: [Options]");
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  DXCHECK_THROW(FLAGS_producers > 0);
+  DXCHECK_THROW(FLAGS_consumers > 0);
+  DXCHECK_THROW(FLAGS_items > 0);
+  DXCHECK_THROW(FLAGS_capacity > 0);
+  DXCHECK_THROW(FLAGS_batch > 0);
+
+  BenchBlockingQueue();
+  BenchMPMCQueue<BlockingWaitPolicy>("MPMCQueue<Blocking>");
+  BenchMPMCQueue<YieldingWaitPolicy>("MPMCQueue<Yielding>");
+  BenchMPMCQueueBatch();
+
+  google::ShutDownCommandLineFlags();
+  return 0;
+}
+
+}  // namespace
+}  // namespace deepx_core
+
+int main(int argc, char** argv) { return deepx_core::main(argc, argv); }
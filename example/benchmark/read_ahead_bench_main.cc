@@ -0,0 +1,93 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/common/stream.h>
+#include <deepx_core/dx_log.h>
+#include <gflags/gflags.h>
+#include <chrono>
+#include <string>
+#include <thread>
+
+DEFINE_int32(mb, 64, "MB of data");
+DEFINE_int32(latency_us, 2000, "latency of every read of the source");
+DEFINE_int32(source_mbps, 400, "throughput of the source in MB/s");
+DEFINE_int32(consumer_mbps, 200, "throughput of the consumer in MB/s");
+DEFINE_int32(block_size, 1024 * 1024, "block size");
+DEFINE_int32(blocks, 4, "number of blocks read ahead");
+
+namespace deepx_core {
+namespace {
+
+using steady_clock_t = std::chrono::steady_clock;
+
+// A source like HDFS, every read takes a round trip plus the transfer.
+class SlowInputStream : public InputStringStream {
+ public:
+  size_t Read(void* data, size_t size) override {
+    size_t bytes = InputStringStream::Read(data, size);
+    std::this_thread::sleep_for(std::chrono::microseconds(
+        FLAGS_latency_us + (int64_t)bytes / FLAGS_source_mbps));
+    return bytes;
+  }
+};
+
+// Spin to simulate parsing.
+void Consume(size_t bytes) {
+  auto end = steady_clock_t::now() +
+             std::chrono::nanoseconds((int64_t)bytes * 1000 /
+                                      FLAGS_consumer_mbps);
+  while (steady_clock_t::now() < end) {
+  }
+}
+
+double Bench(InputStream& is) {  // NOLINT
+  std::string line;
+  auto begin = steady_clock_t::now();
+  while (GetLine(is, line)) {
+    Consume(line.size() + 1);
+  }
+  return std::chrono::duration<double>(steady_clock_t::now() - begin).count();
+}
+
+int main(int argc, char** argv) {
+  google::SetUsageMessage("Usage: [Options]");
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  DXCHECK_THROW(FLAGS_mb > 0);
+  DXCHECK_THROW(FLAGS_source_mbps > 0);
+  DXCHECK_THROW(FLAGS_consumer_mbps > 0);
+  DXCHECK_THROW(FLAGS_block_size > 0);
+  DXCHECK_THROW(FLAGS_blocks > 0);
+
+  std::string data;
+  std::string line(127, 'x');  // magic number
+  line += '\n';
+  while (data.size() < (size_t)FLAGS_mb * 1024 * 1024) {
+    data += line;
+  }
+
+  {
+    SlowInputStream source;
+    source.SetView(data);
+    BufferedInputStream is(&source, (size_t)FLAGS_block_size);
+    DXINFO("%-24s%12.3f s", "BufferedInputStream", Bench(is));
+  }
+
+  {
+    SlowInputStream source;
+    source.SetView(data);
+    ReadAheadInputStream is(&source, FLAGS_blocks, (size_t)FLAGS_block_size);
+    double seconds = Bench(is);
+    DXINFO("%-24s%12.3f s, stalled %d times, %.3f s", "ReadAheadInputStream",
+           seconds, is.stall_count(), is.stall_seconds());
+  }
+
+  google::ShutDownCommandLineFlags();
+  return 0;
+}
+
+}  // namespace
+}  // namespace deepx_core
+
+int main(int argc, char** argv) { return deepx_core::main(argc, argv); }
@@ -0,0 +1,110 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/common/str_util.h>
+#include <deepx_core/common/stream.h>
+#include <deepx_core/dx_log.h>
+#include <deepx_core/ps/rpc_server.h>
+#include <deepx_core/ps/tcp_connection.h>
+#include <deepx_core/ps/tcp_server.h>
+#include <gflags/gflags.h>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+DEFINE_string(tcp_addr, "127.0.0.1:61547", "loopback tcp address");
+#if OS_POSIX == 1
+DEFINE_string(unix_addr, "unix:/tmp/deepx_rpc_bench.sock",
+              "unix domain socket address");
+#endif
+DEFINE_string(sizes, "64;4096;65536;1048576;16777216",
+              "request sizes in bytes");
+DEFINE_int32(bytes, 1 << 30, "bytes per size, bounds the number of calls");
+DEFINE_int32(max_calls, 20000, "max number of calls per size");
+
+namespace deepx_core {
+namespace {
+
+using steady_clock_t = std::chrono::steady_clock;
+
+const int RPC_TYPE_ECHO = 1;  // magic number
+
+int Echo(const std::string& request, std::string* response) {
+  *response = request;
+  return 0;
+}
+
+void Bench(const char* name, const std::string& addr,
+           const std::vector<size_t>& sizes) {
+  TcpServerConfig config;
+  config.listen_endpoint = MakeTcpEndpoint(addr);
+  RpcServer server;
+  server.set_config(config);
+  server.RegisterRequestHandler<std::string, std::string>(RPC_TYPE_ECHO,
+                                                          &Echo);
+  std::thread server_thread([&server] { server.Run(); });
+
+  IoContext io;
+  TcpConnection conn(&io);
+  DXCHECK_THROW(conn.ConnectRetry(config.listen_endpoint, 100, 1) == 0);
+
+  OutputStringStream os;
+  for (size_t size : sizes) {
+    std::string& buf = conn.mutable_out_message()->mutable_user_request()->buf;
+    buf.clear();
+    os.SetView(&buf);
+    os << RPC_TYPE_ECHO << std::string(size, 'x');
+    DXCHECK_THROW(os);
+
+    int calls = (int)(FLAGS_bytes / size);
+    if (calls > FLAGS_max_calls) {
+      calls = FLAGS_max_calls;
+    } else if (calls < 10) {  // magic number
+      calls = 10;             // magic number
+    }
+
+    // warm up
+    DXCHECK_THROW(conn.RpcUserRequest() == 0);
+    auto begin = steady_clock_t::now();
+    for (int i = 0; i < calls; ++i) {
+      DXCHECK_THROW(conn.RpcUserRequest() == 0);
+    }
+    double seconds =
+        std::chrono::duration<double>(steady_clock_t::now() - begin).count();
+    DXCHECK_THROW(conn.in_message().user_response().buf.size() == buf.size());
+
+    // A call moves the request and the response.
+    DXINFO("%-8s%12zu%12.2f us%12.1f MB/s", name, size,
+           seconds / calls * 1e6, 2.0 * size * calls / seconds / 1e6);
+  }
+
+  DXCHECK_THROW(conn.RpcTerminationNotify() == 0);
+  server_thread.join();
+}
+
+int main(int argc, char** argv) {
+  google::SetUsageMessage("Usage: [Options]");
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  DXCHECK_THROW(FLAGS_bytes > 0);
+  DXCHECK_THROW(FLAGS_max_calls > 0);
+  std::vector<size_t> sizes;
+  DXCHECK_THROW(Split(FLAGS_sizes, ";", &sizes));
+  DXCHECK_THROW(!sizes.empty());
+
+  DXINFO("%-8s%12s%15s%17s", "socket", "bytes", "latency", "throughput");
+  Bench("tcp", FLAGS_tcp_addr, sizes);
+#if OS_POSIX == 1
+  Bench("unix", FLAGS_unix_addr, sizes);
+#endif
+
+  google::ShutDownCommandLineFlags();
+  return 0;
+}
+
+}  // namespace
+}  // namespace deepx_core
+
+int main(int argc, char** argv) { return deepx_core::main(argc, argv); }
@@ -0,0 +1,218 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/common/thread_pool.h>
+#include <deepx_core/dx_log.h>
+#include <gflags/gflags.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <forward_list>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+DEFINE_int32(threads, 4, "number of worker threads");
+DEFINE_int32(tasks, 1000000, "number of tasks in throughput benchmarks");
+DEFINE_int32(rounds, 10000, "number of rounds in latency benchmarks");
+DEFINE_int32(cpu_affinity, 0, "pin worker threads to cpus");
+
+namespace deepx_core {
+namespace {
+
+/************************************************************************/
+/* LegacyThreadPool */
+/************************************************************************/
+// The previous ThreadPool: one mutex, one condition variable and one list.
+class LegacyThreadPool {
+ private:
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  int started_ = 0;
+  std::forward_list<std::function<void()>> tasks_;
+  std::vector<std::thread> threads_;
+
+  void worker_thread() {
+    std::function<void()> func;
+    for (;;) {
+      std::unique_lock<std::mutex> guard(mutex_);
+      while (started_ && tasks_.empty()) {
+        cond_.wait(guard);
+      }
+      if (!started_) {
+        break;
+      }
+      func = std::move(tasks_.front());
+      tasks_.pop_front();
+      guard.unlock();
+      func();
+    }
+
+    std::unique_lock<std::mutex> guard(mutex_);
+    while (!tasks_.empty()) {
+      func = std::move(tasks_.front());
+      tasks_.pop_front();
+      guard.unlock();
+      func();
+      guard.lock();
+    }
+  }
+
+ public:
+  ~LegacyThreadPool() { stop(); }
+
+  void set_cpu_affinity(int /*cpu_affinity*/) noexcept {}
+
+  void start(int n) {
+    std::unique_lock<std::mutex> guard(mutex_);
+    started_ = 1;
+    for (int i = 0; i < n; ++i) {
+      threads_.emplace_back([this]() { worker_thread(); });
+    }
+  }
+
+  void stop() {
+    {
+      std::unique_lock<std::mutex> guard(mutex_);
+      started_ = 0;
+      cond_.notify_all();
+    }
+    for (std::thread& thread : threads_) {
+      thread.join();
+    }
+    threads_.clear();
+  }
+
+  void post(std::function<void()> func) {
+    {
+      std::unique_lock<std::mutex> guard(mutex_);
+      tasks_.emplace_front(std::move(func));
+    }
+    cond_.notify_one();
+  }
+};
+
+using steady_clock_t = std::chrono::steady_clock;
+
+double ElapsedSeconds(const steady_clock_t::time_point& begin) {
+  return std::chrono::duration<double>(steady_clock_t::now() - begin).count();
+}
+
+void WaitFor(const std::atomic<int>& counter, int value) {
+  while (counter.load(std::memory_order_acquire) < value) {
+    std::this_thread::yield();
+  }
+}
+
+// External thread posts 'tasks' tiny tasks.
+template <class Pool>
+void BenchExternalPost(const char* name) {
+  Pool pool;
+  std::atomic<int> done(0);
+  pool.set_cpu_affinity(FLAGS_cpu_affinity);
+  pool.start(FLAGS_threads);
+  auto begin = steady_clock_t::now();
+  for (int i = 0; i < FLAGS_tasks; ++i) {
+    pool.post([&done]() { done.fetch_add(1, std::memory_order_release); });
+  }
+  WaitFor(done, FLAGS_tasks);
+  double seconds = ElapsedSeconds(begin);
+  pool.stop();
+  DXINFO("%-8s external post:  %10.0f tasks/s", name, FLAGS_tasks / seconds);
+}
+
+// Every worker posts tasks concurrently, tasks carry a 48-byte capture.
+template <class Pool>
+void BenchInternalPost(const char* name) {
+  Pool pool;
+  std::atomic<int> done(0);
+  int per_thread = FLAGS_tasks / FLAGS_threads;
+  int total = per_thread * FLAGS_threads;
+  pool.set_cpu_affinity(FLAGS_cpu_affinity);
+  pool.start(FLAGS_threads);
+  auto begin = steady_clock_t::now();
+  for (int t = 0; t < FLAGS_threads; ++t) {
+    pool.post([&pool, &done, per_thread]() {
+      for (int i = 0; i < per_thread; ++i) {
+        double a = i, b = i, c = i, d = i, e = i;
+        pool.post([&done, a, b, c, d, e]() {
+          if (a + b + c + d + e >= 0) {
+            done.fetch_add(1, std::memory_order_release);
+          }
+        });
+      }
+    });
+  }
+  WaitFor(done, total);
+  double seconds = ElapsedSeconds(begin);
+  pool.stop();
+  DXINFO("%-8s internal post:  %10.0f tasks/s", name, total / seconds);
+}
+
+// Post one task and wait for it, like ModelShard::AsyncPull.
+template <class Pool>
+void BenchLatency(const char* name) {
+  Pool pool;
+  std::vector<double> latencies((size_t)FLAGS_rounds);
+  pool.set_cpu_affinity(FLAGS_cpu_affinity);
+  pool.start(FLAGS_threads);
+  for (int i = 0; i < FLAGS_rounds; ++i) {
+    std::atomic<int> done(0);
+    auto begin = steady_clock_t::now();
+    pool.post([&done]() { done.store(1, std::memory_order_release); });
+    WaitFor(done, 1);
+    latencies[(size_t)i] = ElapsedSeconds(begin) * 1e6;
+  }
+  pool.stop();
+  std::sort(latencies.begin(), latencies.end());
+  double sum = 0;
+  for (double latency : latencies) {
+    sum += latency;
+  }
+  DXINFO("%-8s round trip:     avg=%.2fus p50=%.2fus p99=%.2fus", name,
+         sum / latencies.size(), latencies[latencies.size() / 2],
+         latencies[latencies.size() * 99 / 100]);
+}
+
+void BenchParallelFor() {
+  ThreadPool pool;
+  std::vector<float> v((size_t)FLAGS_tasks, 1);
+  pool.set_cpu_affinity(FLAGS_cpu_affinity);
+  pool.start(FLAGS_threads);
+  auto begin = steady_clock_t::now();
+  for (int k = 0; k < 10; ++k) {
+    pool.parallel_for(0, v.size(), 1024, [&v](size_t i) { v[i] *= 1.0001f; });
+  }
+  double seconds = ElapsedSeconds(begin);
+  pool.stop();
+  DXINFO("%-8s parallel_for:   %10.0f elements/s", "new",
+         10 * v.size() / seconds);
+}
+
+int main(int argc, char** argv) {
+  google::SetUsageMessage("Usage: [Options]");
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  DXCHECK_THROW(FLAGS_threads > 0);
+  DXCHECK_THROW(FLAGS_tasks > 0);
+  DXCHECK_THROW(FLAGS_rounds > 0);
+
+  BenchExternalPost<LegacyThreadPool>("legacy");
+  BenchExternalPost<ThreadPool>("new");
+  BenchInternalPost<LegacyThreadPool>("legacy");
+  BenchInternalPost<ThreadPool>("new");
+  BenchLatency<LegacyThreadPool>("legacy");
+  BenchLatency<ThreadPool>("new");
+  BenchParallelFor();
+
+  google::ShutDownCommandLineFlags();
+  return 0;
+}
+
+}  // namespace
+}  // namespace deepx_core
+
+int main(int argc, char** argv) { return deepx_core::main(argc, argv); }
@@ -0,0 +1,113 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/dx_log.h>
+#include <gflags/gflags.h>
+#include <chrono>
+#include <random>
+#include <vector>
+#include "../../src/graph/op/kernel/transpose.h"
+
+DEFINE_int32(loops, 20, "number of loops");
+
+namespace deepx_core {
+namespace {
+
+using steady_clock_t = std::chrono::steady_clock;
+
+// The element-wise gather kernel, which transposes by walking Z linearly.
+void NaiveTranspose(const float* X, float* Z, const TransposeAux& aux) {
+  int rank = aux.Z.rank();
+  int index[SHAPE_MAX_RANK] = {0};
+  int k = 0;
+  for (int i = 0; i < aux.Z.total_dim(); ++i) {
+    Z[i] = X[k];
+    for (int j = rank - 1; j >= 0; --j) {
+      k += aux.Zstrides[j];
+      if (++index[j] < aux.Z[j]) {
+        break;
+      }
+      index[j] = 0;
+      k -= aux.Z[j] * aux.Zstrides[j];
+    }
+  }
+}
+
+void NaiveTransposeBackward(const float* gZ, float* gX,
+                            const TransposeAux& aux) {
+  int rank = aux.Z.rank();
+  int index[SHAPE_MAX_RANK] = {0};
+  int k = 0;
+  for (int i = 0; i < aux.Z.total_dim(); ++i) {
+    gX[k] += gZ[i];
+    for (int j = rank - 1; j >= 0; --j) {
+      k += aux.Zstrides[j];
+      if (++index[j] < aux.Z[j]) {
+        break;
+      }
+      index[j] = 0;
+      k -= aux.Z[j] * aux.Zstrides[j];
+    }
+  }
+}
+
+// Return GB/s.
+template <class Func>
+double Run(Func&& func, int total_dim) {
+  func();  // warm up
+  auto begin = steady_clock_t::now();
+  for (int i = 0; i < FLAGS_loops; ++i) {
+    func();
+  }
+  double seconds =
+      std::chrono::duration<double>(steady_clock_t::now() - begin).count();
+  return 2.0 * total_dim * sizeof(float) * FLAGS_loops / seconds / 1e9;
+}
+
+void Bench(const char* name, const Shape& Xshape, const Shape& axes) {
+  TransposeAux aux;
+  DXCHECK_THROW(TransposePrepare(Xshape, axes, &aux));
+  int total_dim = Xshape.total_dim();
+  std::vector<float> X(total_dim), Z1(total_dim), Z2(total_dim);
+  std::vector<float> gX(total_dim);
+  std::default_random_engine engine;
+  std::uniform_real_distribution<float> dist;
+  for (float& x : X) {
+    x = dist(engine);
+  }
+
+  double naive = Run([&]() { NaiveTranspose(X.data(), Z1.data(), aux); },
+                     total_dim);
+  double tiled = Run([&]() { detail::Transpose(X.data(), Z2.data(), aux); },
+                     total_dim);
+  DXCHECK_THROW(Z1 == Z2);
+  double naive_backward = Run(
+      [&]() { NaiveTransposeBackward(Z1.data(), gX.data(), aux); }, total_dim);
+  double tiled_backward = Run(
+      [&]() { detail::TransposeBackward(Z1.data(), gX.data(), aux); },
+      total_dim);
+  DXINFO("%-24s forward %6.2f -> %6.2f GB/s, backward %6.2f -> %6.2f GB/s",
+         name, naive, tiled, naive_backward, tiled_backward);
+}
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  // batch 32, sequence 128, 8 heads, head size 64
+  Bench("split heads", Shape(32, 128, 8, 64), Shape(0, 2, 1, 3));
+  Bench("transpose K", Shape(32, 8, 128, 64), Shape(0, 1, 3, 2));
+  Bench("merge heads", Shape(32, 8, 128, 64), Shape(0, 2, 1, 3));
+  // CIN, batch 256, 39 fields, embedding size 16
+  Bench("CIN", Shape(256, 39, 16), Shape(0, 2, 1));
+  Bench("matrix", Shape(1000, 1000), Shape(1, 0));
+  Bench("reverse axes", Shape(16, 32, 64, 32), Shape(3, 2, 1, 0));
+
+  google::ShutDownCommandLineFlags();
+  return 0;
+}
+
+}  // namespace
+}  // namespace deepx_core
+
+int main(int argc, char** argv) { return deepx_core::main(argc, argv); }
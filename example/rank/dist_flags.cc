@@ -18,6 +18,11 @@ DEFINE_string(cs_addr, "127.0.0.1:61000", "coord server address");
 DEFINE_string(ps_addrs, "127.0.0.1:60000", "param server addresses");
 DEFINE_int32(ps_id, 0, "param server id");
 DEFINE_int32(ps_thread, 1, "# of param server working threads");
+DEFINE_string(shard_func, "default", "shard func name: default or bucket");
+DEFINE_string(srm_storage_dtype, "",
+              "storage dtype of sparse params in ps memory, model files and "
+              "pull responses: float, float16 or bfloat16, "
+              "empty keeps that of the input model");
 
 DEFINE_string(instance_reader, "libsvm", "instance reader name");
 DEFINE_string(instance_reader_config, "", "instance reader config");
@@ -34,6 +39,9 @@ DEFINE_string(in_model, "", "input model dir");
 DEFINE_string(warmup_model, "", "warmup model dir");
 DEFINE_int32(out_model_remove_zeros, 0, "remove zeros from output model");
 DEFINE_string(out_model, "", "output model dir");
+DEFINE_int32(out_model_chunk_size, 0,
+             "chunk size(MB) of output model files, 0 disables chunking");
+DEFINE_int32(out_model_compress, 0, "compress output model files by LZ4");
 DEFINE_string(out_text_model, "", "output text model dir(optional)");
 DEFINE_string(out_feature_kv_model, "",
               "output feature kv model dir(optional)");
@@ -56,6 +64,7 @@ TcpEndpoint FLAGS_cs_endpoint;
 std::vector<TcpEndpoint> FLAGS_ps_endpoints;
 int FLAGS_ps_size = 0;
 Shard FLAGS_shard;
+int FLAGS_srm_storage_dtype_enum = TENSOR_DTYPE_NONE;
 
 void CheckFlags() {
   AutoFileSystem fs;
@@ -80,6 +89,16 @@ void CheckFlags() {
   DXCHECK_THROW(0 <= FLAGS_ps_id && FLAGS_ps_id < FLAGS_ps_size);
   DXCHECK_THROW(FLAGS_ps_thread > 0);
 
+  if (FLAGS_srm_storage_dtype == "float16") {
+    FLAGS_srm_storage_dtype_enum = TENSOR_DTYPE_FLOAT16;
+  } else if (FLAGS_srm_storage_dtype == "bfloat16") {
+    FLAGS_srm_storage_dtype_enum = TENSOR_DTYPE_BFLOAT16;
+  } else {
+    DXCHECK_THROW(FLAGS_srm_storage_dtype.empty() ||
+                  FLAGS_srm_storage_dtype == "float");
+    FLAGS_srm_storage_dtype_enum = TENSOR_DTYPE_NONE;
+  }
+
   DXCHECK_THROW(!FLAGS_instance_reader.empty());
   StringMap config;
   DXCHECK_THROW(ParseConfig(FLAGS_instance_reader_config, &config));
@@ -132,6 +151,7 @@ void CheckFlags() {
     DXCHECK_THROW(fs.Open(FLAGS_out_model));
     DXCHECK_THROW(!IsStdinStdoutPath(FLAGS_out_model));
     (void)AutoFileSystem::MakeDir(FLAGS_out_model);
+    DXCHECK_THROW(FLAGS_out_model_chunk_size >= 0);
 
     CanonicalizePath(&FLAGS_out_text_model);
     if (!FLAGS_out_text_model.empty()) {
@@ -172,7 +192,7 @@ void CheckFlags() {
                   (google::uint64)std::numeric_limits<DataType::freq_t>::max());
   }
 
-  FLAGS_shard.InitShard(FLAGS_ps_size, "default");
+  FLAGS_shard.InitShard(FLAGS_ps_size, FLAGS_shard_func);
 }
 
 }  // namespace deepx_core
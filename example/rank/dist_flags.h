@@ -15,6 +15,8 @@ DECLARE_string(cs_addr);
 DECLARE_string(ps_addrs);
 DECLARE_int32(ps_id);
 DECLARE_int32(ps_thread);
+DECLARE_string(shard_func);
+DECLARE_string(srm_storage_dtype);
 
 DECLARE_string(instance_reader);
 DECLARE_string(instance_reader_config);
@@ -31,6 +33,8 @@ DECLARE_string(in_model);
 DECLARE_string(warmup_model);
 DECLARE_int32(out_model_remove_zeros);
 DECLARE_string(out_model);
+DECLARE_int32(out_model_chunk_size);
+DECLARE_int32(out_model_compress);
 DECLARE_string(out_text_model);
 DECLARE_string(out_feature_kv_model);
 DECLARE_int32(out_feature_kv_protocol_version);
@@ -50,6 +54,7 @@ extern TcpEndpoint FLAGS_cs_endpoint;
 extern std::vector<TcpEndpoint> FLAGS_ps_endpoints;
 extern int FLAGS_ps_size;
 extern Shard FLAGS_shard;
+extern int FLAGS_srm_storage_dtype_enum;
 
 void CheckFlags();
 
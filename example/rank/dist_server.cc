@@ -66,8 +66,13 @@ void RankParamServer::Init() {
     }
 
     model_shard_.seed(FLAGS_seed + FLAGS_ps_id * 10099);  // magic number
+    model_shard_.seed_keyed(FLAGS_seed);
     model_shard_.InitShard(&FLAGS_shard, FLAGS_ps_id);
     model_shard_.InitGraph(&graph_);
+    model_shard_.set_chunk_size((size_t)FLAGS_out_model_chunk_size << 20);
+    model_shard_.set_compress(FLAGS_out_model_compress != 0);
+    // Rows of sparse params in 16 bits stay in 16 bits in memory.
+    model_shard_.set_keep_srm_storage_dtype(true);
     if (FLAGS_in_model.empty()) {
       DXCHECK_THROW(model_shard_.InitModel());
       DXCHECK_THROW(
@@ -116,11 +121,18 @@ void RankParamServer::Init() {
     DXCHECK_THROW(LoadGraph(FLAGS_in_model, &graph_));
     model_shard_.InitShard(&FLAGS_shard, FLAGS_ps_id);
     model_shard_.InitGraph(&graph_);
+    model_shard_.set_keep_srm_storage_dtype(true);
     DXCHECK_THROW(model_shard_.LoadModel(FLAGS_in_model));
   }
 
   DXCHECK_THROW(model_shard_.model().HasSRM());
 
+  if (!FLAGS_srm_storage_dtype.empty()) {
+    // Rows are converted by rounding to nearest.
+    model_shard_.mutable_model()->SetSRMStorageDtype(
+        FLAGS_srm_storage_dtype_enum);
+  }
+
   if (FLAGS_is_train && config_.thread > 1) {
     DXCHECK_THROW(model_shard_.InitLock());
   }
@@ -43,6 +43,8 @@ class TrainerContextDist : public TrainerContext {
   std::vector<std::unique_ptr<TensorMap>> overwritten_params_;
   std::vector<id_set_t*> aux1_;
   std::vector<srm_t*> aux2_;
+  std::vector<std::string> pull_profile_names_;
+  std::vector<std::string> push_profile_names_;
 
  public:
   TrainerContextDist();
@@ -53,6 +55,7 @@ class TrainerContextDist : public TrainerContext {
  private:
   void Pull();
   void Push();
+  void AddShardProfile(const std::vector<std::string>& names);
 };
 
 TrainerContextDist::TrainerContextDist() : io_(), ps_conns_(&io_) {}
@@ -75,6 +78,12 @@ void TrainerContextDist::Init(ModelShard* local_model_shard) {
   }
   aux1_.resize(shard_size_);
   aux2_.resize(shard_size_);
+  pull_profile_names_.resize(shard_size_);
+  push_profile_names_.resize(shard_size_);
+  for (int i = 0; i < shard_size_; ++i) {
+    pull_profile_names_[i] = "Pull shard " + std::to_string(i);
+    push_profile_names_[i] = "Push shard " + std::to_string(i);
+  }
 }
 
 void TrainerContextDist::TrainBatch() {
@@ -187,21 +196,27 @@ void TrainerContextDist::Pull() {
     }
   }
 
-  DXCHECK_THROW(ps_conns_.RpcPullRequest(&pull_request_masks_) == 0);
-
   for (int i = 0; i < shard_size_; ++i) {
-    if (pull_request_masks_[i]) {
-      const const_string_view& buf =
-          ps_conns_[i]->in_message().pull_response().buf;
-      is_.SetView(buf.data(), buf.size());
-      // view, zero-copy
-      ReadView(is_, *params_[i]);
-      DXCHECK_THROW(is_);
-    } else {
+    if (!pull_request_masks_[i]) {
       params_[i]->clear();
     }
   }
 
+  // Responses are deserialized in completion order,
+  // overlapping with other responses in flight.
+  DXCHECK_THROW(ps_conns_.RpcPullRequestAsync(
+                    &pull_request_masks_, [this](size_t i) {
+                      const const_string_view& buf =
+                          ps_conns_[i]->in_message().pull_response().buf;
+                      is_.SetView(buf.data(), buf.size());
+                      // view, zero-copy
+                      ReadView(is_, *params_[i]);
+                      DXCHECK_THROW(is_);
+                    }) == 0);
+  if (enable_profile_) {
+    AddShardProfile(pull_profile_names_);
+  }
+
   local_model_shard_->mutable_model()->SetParam(&params_);
 }
 
@@ -222,7 +237,19 @@ void TrainerContextDist::Push() {
     }
   }
 
-  DXCHECK_THROW(ps_conns_.RpcPushNotify(&pull_request_masks_) == 0);
+  DXCHECK_THROW(ps_conns_.RpcPushNotifyAsync(&pull_request_masks_) == 0);
+  if (enable_profile_) {
+    AddShardProfile(push_profile_names_);
+  }
+}
+
+void TrainerContextDist::AddShardProfile(
+    const std::vector<std::string>& names) {
+  // per shard latencies reveal stragglers
+  const std::vector<double>& latencies = ps_conns_.latencies();
+  for (int i = 0; i < shard_size_; ++i) {
+    profile_breakdown_map_[names[i]] += latencies[i];
+  }
 }
 
 /************************************************************************/
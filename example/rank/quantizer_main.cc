@@ -0,0 +1,252 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/common/misc.h>
+#include <deepx_core/common/stream.h>
+#include <deepx_core/dx_log.h>
+#include <deepx_core/graph/graph.h>
+#include <deepx_core/graph/instance_reader.h>
+#include <deepx_core/graph/model_shard.h>
+#include <deepx_core/graph/op_context.h>
+#include <deepx_core/graph/shard.h>
+#include <gflags/gflags.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+DEFINE_string(in_model, "", "input model dir");
+DEFINE_string(out_model, "", "output quantized model dir");
+DEFINE_string(instance_reader, "libsvm", "instance reader name");
+DEFINE_string(instance_reader_config, "", "instance reader config");
+DEFINE_int32(batch, 32, "batch size");
+DEFINE_string(in, "",
+              "input dir/file of evaluating data(optional), "
+              "the accuracy delta of the quantized model is reported");
+
+namespace deepx_core {
+namespace {
+
+Shard FLAGS_shard;
+
+/************************************************************************/
+/* EvalDelta */
+/************************************************************************/
+struct EvalDelta {
+  double n = 0;
+  double sum_abs_diff = 0;
+  double max_abs_diff = 0;
+  double labeled_n = 0;
+  double loss = 0;
+  double quantized_loss = 0;
+
+  void Update(const DataType::tsr_t& Z, const DataType::tsr_t& quantized_Z,
+              const DataType::tsr_t* Y) {
+    constexpr double EPS = 1e-7;  // magic number
+    DXCHECK_THROW(Z.shape() == quantized_Z.shape());
+    int m = Z.dim(0);
+    int k = Z.total_dim() / m;
+    for (int i = 0; i < Z.total_dim(); ++i) {
+      double diff = std::fabs((double)Z.data(i) - (double)quantized_Z.data(i));
+      sum_abs_diff += diff;
+      max_abs_diff = (diff > max_abs_diff) ? diff : max_abs_diff;
+    }
+    n += Z.total_dim();
+
+    // Log loss is computed for binary probabilities.
+    if (Y == nullptr || k != 1 || Y->total_dim() != m) {
+      return;
+    }
+    for (int i = 0; i < m; ++i) {
+      double y = Y->data(i);
+      double p = std::min(std::max((double)Z.data(i), EPS), 1 - EPS);
+      double q = std::min(std::max((double)quantized_Z.data(i), EPS), 1 - EPS);
+      loss -= y * std::log(p) + (1 - y) * std::log(1 - p);
+      quantized_loss -= y * std::log(q) + (1 - y) * std::log(1 - q);
+    }
+    labeled_n += m;
+  }
+
+  void Dump() const {
+    if (n == 0) {
+      DXINFO("No evaluating data.");
+      return;
+    }
+    DXINFO("Predictions: %.0f", n);
+    DXINFO("Mean absolute delta: %g", sum_abs_diff / n);
+    DXINFO("Max absolute delta: %g", max_abs_diff);
+    if (labeled_n > 0) {
+      DXINFO("Log loss: %g -> %g, delta: %g", loss / labeled_n,
+             quantized_loss / labeled_n, (quantized_loss - loss) / labeled_n);
+    }
+  }
+};
+
+/************************************************************************/
+/* Quantizer */
+/************************************************************************/
+class Quantizer {
+ private:
+  Graph graph_;
+  ModelShard model_shard_;
+  ModelShard quantized_model_shard_;
+
+ public:
+  void Init();
+  void Quantize();
+  void Eval();
+  void Save();
+
+ private:
+  void EvalFile(const std::string& file, EvalDelta* delta);
+};
+
+void Quantizer::Init() {
+  DXCHECK_THROW(LoadGraph(FLAGS_in_model, &graph_));
+
+  model_shard_.InitShard(&FLAGS_shard, 0);
+  model_shard_.InitGraph(&graph_);
+  DXCHECK_THROW(model_shard_.LoadModel(FLAGS_in_model));
+
+  quantized_model_shard_.InitShard(&FLAGS_shard, 0);
+  quantized_model_shard_.InitGraph(&graph_);
+  DXCHECK_THROW(quantized_model_shard_.LoadModel(FLAGS_in_model));
+}
+
+void Quantizer::Quantize() {
+  int quantized = quantized_model_shard_.mutable_model()->Quantize();
+  DXINFO("Quantized %d params.", quantized);
+}
+
+void Quantizer::Eval() {
+  if (FLAGS_in.empty()) {
+    return;
+  }
+
+  std::vector<std::string> files;
+  DXCHECK_THROW(AutoFileSystem::ListRecursive(FLAGS_in, true, &files));
+  EvalDelta delta;
+  for (const std::string& file : files) {
+    DXINFO("Evaluating %s...", file.c_str());
+    EvalFile(file, &delta);
+  }
+  delta.Dump();
+}
+
+void Quantizer::EvalFile(const std::string& file, EvalDelta* delta) {
+  // Check out graph target conventions.
+  const std::string& target_name = graph_.target(1).name();
+  OpContext op_context, quantized_op_context;
+  op_context.Init(&graph_, model_shard_.mutable_param());
+  DXCHECK_THROW(op_context.InitOp({target_name}, -1));
+  quantized_op_context.Init(&graph_, quantized_model_shard_.mutable_param());
+  DXCHECK_THROW(quantized_op_context.InitOp({target_name}, -1));
+
+  std::unique_ptr<InstanceReader> instance_reader(
+      NewInstanceReader(FLAGS_instance_reader));
+  DXCHECK_THROW(instance_reader);
+  StringMap config;
+  DXCHECK_THROW(ParseConfig(FLAGS_instance_reader_config, &config));
+  config["batch"] = std::to_string(FLAGS_batch);
+  DXCHECK_THROW(instance_reader->InitConfig(config));
+  DXCHECK_THROW(instance_reader->Open(file));
+
+  int op_context_batch = -1;
+  Instance* inst = op_context.mutable_inst();
+  auto predict_batch = [&]() {
+    *quantized_op_context.mutable_inst() = *inst;
+    if (op_context_batch != inst->batch()) {
+      op_context_batch = inst->batch();
+      op_context.InitPredict();
+      quantized_op_context.InitPredict();
+    }
+    op_context.Predict();
+    quantized_op_context.Predict();
+
+    const DataType::tsr_t* Y = nullptr;
+    auto it = inst->find(Y_NAME);
+    if (it != inst->end()) {
+      Y = &it->second.to_ref<DataType::tsr_t>();
+    }
+    delta->Update(*op_context.ptr().get<DataType::tsr_t*>(target_name),
+                  *quantized_op_context.ptr().get<DataType::tsr_t*>(
+                      target_name),
+                  Y);
+  };
+
+  inst->clear();
+  while (instance_reader->GetBatch(inst)) {
+    predict_batch();
+  }
+  if (inst->batch() > 0) {
+    predict_batch();
+  }
+}
+
+void Quantizer::Save() {
+  if (!AutoFileSystem::Exists(FLAGS_out_model)) {
+    DXCHECK_THROW(AutoFileSystem::MakeDir(FLAGS_out_model));
+  }
+  DXCHECK_THROW(SaveGraph(FLAGS_out_model, graph_));
+  DXCHECK_THROW(SaveShard(FLAGS_out_model, FLAGS_shard));
+  DXCHECK_THROW(quantized_model_shard_.SaveModel(FLAGS_out_model));
+}
+
+/************************************************************************/
+/* main */
+/************************************************************************/
+void CheckFlags() {
+  AutoFileSystem fs;
+
+  CanonicalizePath(&FLAGS_in_model);
+  DXCHECK_THROW(!FLAGS_in_model.empty());
+  DXCHECK_THROW(fs.Open(FLAGS_in_model));
+  DXCHECK_THROW(!IsStdinStdoutPath(FLAGS_in_model));
+
+  CanonicalizePath(&FLAGS_out_model);
+  DXCHECK_THROW(!FLAGS_out_model.empty());
+  DXCHECK_THROW(fs.Open(FLAGS_out_model));
+  DXCHECK_THROW(!IsStdinStdoutPath(FLAGS_out_model));
+  DXCHECK_THROW(FLAGS_out_model != FLAGS_in_model);
+
+  if (!FLAGS_in.empty()) {
+    CanonicalizePath(&FLAGS_in);
+    DXCHECK_THROW(fs.Open(FLAGS_in));
+    DXCHECK_THROW(!FLAGS_instance_reader.empty());
+    DXCHECK_THROW(FLAGS_batch > 0);
+  }
+
+  DXCHECK_THROW(LoadShard(FLAGS_in_model, &FLAGS_shard));
+  if (FLAGS_shard.shard_mode() != 0) {
+    DXERROR("Quantized models are only supported in non shard mode.");
+    DXCHECK_THROW(FLAGS_shard.shard_mode() == 0);
+  }
+}
+
+int main(int argc, char** argv) {
+  google::SetUsageMessage("Usage: [Options]");
+#if HAVE_COMPILE_FLAGS_H == 1
+  google::SetVersionString("\n\n"
+#include "compile_flags.h"
+  );
+#endif
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  CheckFlags();
+
+  Quantizer quantizer;
+  quantizer.Init();
+  quantizer.Quantize();
+  quantizer.Eval();
+  quantizer.Save();
+
+  google::ShutDownCommandLineFlags();
+  return 0;
+}
+
+}  // namespace
+}  // namespace deepx_core
+
+int main(int argc, char** argv) { return deepx_core::main(argc, argv); }
@@ -21,15 +21,17 @@ namespace deepx_core {
 /* TrainerContext */
 /************************************************************************/
 void TrainerContext::DumpProfile() const {
-  if (profile_map_.empty()) {
-    return;
-  }
+  for (const auto* profile_map : {&profile_map_, &profile_breakdown_map_}) {
+    if (profile_map->empty()) {
+      continue;
+    }
 
-  std::vector<ProfileItem> items;
-  for (const auto& entry : profile_map_) {
-    items.emplace_back(entry.first, entry.second);
+    std::vector<ProfileItem> items;
+    for (const auto& entry : *profile_map) {
+      items.emplace_back(entry.first, entry.second);
+    }
+    DumpProfileItems(&items);
   }
-  DumpProfileItems(&items);
 }
 
 void TrainerContext::_Init(ModelShard* local_model_shard) {
@@ -44,6 +46,7 @@ void TrainerContext::_Init(ModelShard* local_model_shard) {
   if (enable_profile_) {
     DumpProfile();
     profile_map_.clear();
+    profile_breakdown_map_.clear();
   }
 }
 
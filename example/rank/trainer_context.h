@@ -58,6 +58,8 @@ class TrainerContext : public DataType {
  protected:
   int enable_profile_ = 0;
   std::unordered_map<std::string, double> profile_map_;
+  // breakdowns of items in 'profile_map_', dumped separately
+  std::unordered_map<std::string, double> profile_breakdown_map_;
 
  protected:
   void DumpProfile() const;
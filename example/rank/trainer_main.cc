@@ -286,6 +286,7 @@ void TrainerShard::Init() {
   model_shards_.resize(shard_size_);
   for (int i = 0; i < shard_size_; ++i) {
     model_shards_[i].seed(FLAGS_seed + i * 10099);  // magic number
+    model_shards_[i].seed_keyed(FLAGS_seed);
     model_shards_[i].InitShard(&FLAGS_shard, i);
     model_shards_[i].InitGraph(&graph_);
     if (FLAGS_in_model.empty()) {
@@ -185,7 +185,8 @@ bool operator!=(ArrayView<T> left, std::nullptr_t) noexcept {
 using string_view = ArrayView<char>;
 
 inline bool operator==(string_view left, const std::string& right) noexcept {
-  return left.size() == right.size() && right.compare(left.data()) == 0;
+  return left.size() == right.size() &&
+         right.compare(0, right.size(), left.data(), left.size()) == 0;
 }
 
 inline bool operator!=(string_view left, const std::string& right) noexcept {
@@ -193,7 +194,8 @@ inline bool operator!=(string_view left, const std::string& right) noexcept {
 }
 
 inline bool operator==(const std::string& left, string_view right) noexcept {
-  return left.size() == right.size() && left.compare(right.data()) == 0;
+  return left.size() == right.size() &&
+         left.compare(0, left.size(), right.data(), right.size()) == 0;
 }
 
 inline bool operator!=(const std::string& left, string_view right) noexcept {
@@ -354,7 +356,8 @@ using const_string_view = ConstArrayView<char>;
 
 inline bool operator==(const_string_view left,
                        const std::string& right) noexcept {
-  return left.size() == right.size() && right.compare(left.data()) == 0;
+  return left.size() == right.size() &&
+         right.compare(0, right.size(), left.data(), left.size()) == 0;
 }
 
 inline bool operator!=(const_string_view left,
@@ -364,7 +367,8 @@ inline bool operator!=(const_string_view left,
 
 inline bool operator==(const std::string& left,
                        const_string_view right) noexcept {
-  return left.size() == right.size() && left.compare(right.data()) == 0;
+  return left.size() == right.size() &&
+         left.compare(0, left.size(), right.data(), right.size()) == 0;
 }
 
 inline bool operator!=(const std::string& left,
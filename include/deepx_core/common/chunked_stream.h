@@ -0,0 +1,176 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#pragma once
+#include <deepx_core/common/compress.h>
+#include <deepx_core/common/stream.h>
+#include <deepx_core/common/thread_pool.h>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace deepx_core {
+
+/************************************************************************/
+/* Chunked file format */
+/************************************************************************/
+// A chunked file 'file' consists of a manifest file 'file' and
+// chunk files 'file.chunk.0', 'file.chunk.1', ...
+//
+// The manifest holds the size and the checksum of every chunk.
+// The concatenation of all chunks is the logical content of 'file'.
+//
+// Chunks are written and read by a thread pool concurrently,
+// so that a large file is not bound by the speed of a single stream.
+//
+// Chunks may be compressed as independent LZ4 frames,
+// so they are compressed and decompressed concurrently too.
+//
+// A writer may also write self-contained chunks by 'WriteChunk',
+// and a reader may parse them concurrently by 'ForEachChunk'.
+
+// Return the chunk file name of chunk 'chunk_id' of 'file'.
+std::string GetChunkFile(const std::string& file, int chunk_id);
+
+// Return if 'file' is a chunked file.
+bool IsChunkedFile(const std::string& file);
+
+// Write 'file' by 'func(os)'.
+//
+// 'file' is written as a chunked file if 'chunk_size' > 0,
+// otherwise it is written as an ordinary file.
+// If 'compress' is true, chunks or the ordinary file are compressed by LZ4.
+bool SaveFile(const std::string& file, size_t chunk_size,
+              const std::function<bool(OutputStream&)>& func,
+              bool compress = false);
+
+/************************************************************************/
+/* ChunkedOutputFileStream */
+/************************************************************************/
+class ChunkedOutputFileStream : public OutputStream {
+ private:
+  struct Chunk {
+    uint64_t size = 0;
+    uint64_t checksum = 0;
+  };
+
+  std::string file_;
+  size_t chunk_size_;
+  int thread_size_;
+  std::string buf_;
+  ThreadPool thread_pool_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::vector<Chunk> chunks_;
+  int pending_ = 0;
+  int failed_ = 0;
+  int compress_ = 0;
+
+ public:
+  // 'chunk_size' is the size of every chunk except the last one.
+  // At most 'thread_size' chunks are written concurrently,
+  // non-positive values mean the number of hardware threads.
+  explicit ChunkedOutputFileStream(
+      size_t chunk_size = 64 * 1024 * 1024,  // magic number
+      int thread_size = 8);                  // magic number
+  ~ChunkedOutputFileStream() override;
+  size_t Write(const void* data, size_t size) override;
+
+ public:
+  bool Open(const std::string& file);
+  bool IsOpen() const noexcept { return !file_.empty(); }
+  // Compress chunks by LZ4, it must be called before 'Open'.
+  void set_compress(bool compress) noexcept { compress_ = compress ? 1 : 0; }
+  bool compress() const noexcept { return compress_ != 0; }
+  // End the current chunk, and write 'data' as one chunk regardless of
+  // 'chunk_size', so that it can be read as a whole by
+  // 'ChunkedInputFileStream::ForEachChunk'.
+  //
+  // 'data' is cleared.
+  bool WriteChunk(std::string* data);
+  // Write the remaining chunk, wait for all chunks and write the manifest.
+  //
+  // Return false if any chunk or the manifest fails to be written.
+  bool Close();
+
+ private:
+  void PostChunk();
+};
+
+/************************************************************************/
+/* ChunkedInputFileStream */
+/************************************************************************/
+// It reads chunked files and ordinary files written by AutoOutputFileStream,
+// both of which may be compressed by 'SaveFile'.
+//
+// Chunks are read ahead and decompressed by a thread pool,
+// and verified by their checksums.
+class ChunkedInputFileStream : public InputStream {
+ private:
+  struct Chunk {
+    uint64_t size = 0;
+    uint64_t checksum = 0;
+    std::string data;
+    int done = 0;
+    int ok = 0;
+  };
+
+  // ordinary file
+  std::unique_ptr<AutoInputFileStream> is_;
+  std::unique_ptr<LZ4FrameInputStream> lz4_is_;
+  InputStream* ordinary_ = nullptr;  // is_ or lz4_is_
+
+  // chunked file
+  std::string file_;
+  int thread_size_;
+  std::unique_ptr<ThreadPool> thread_pool_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::vector<Chunk> chunks_;
+  int codec_ = 0;
+  int next_post_ = 0;
+  int cur_ = 0;
+  size_t offset_ = 0;
+
+ public:
+  // At most 'thread_size' chunks are read ahead,
+  // non-positive values mean the number of hardware threads.
+  explicit ChunkedInputFileStream(int thread_size = 8);  // magic number
+  ~ChunkedInputFileStream() override;
+  size_t Read(void* data, size_t size) override;
+  char ReadChar() override;
+  size_t Peek(void* data, size_t size) override;
+
+ public:
+  bool Open(const std::string& file);
+  bool IsOpen() const noexcept { return is_ || thread_pool_; }
+  void Close() noexcept;
+  // Read the remaining chunks concurrently and call 'func(chunk_id, is)'
+  // for each of them, where 'is' holds the whole chunk.
+  // 'func' is called concurrently.
+  //
+  // The stream must be a chunked file at the beginning of a chunk,
+  // it is at the end after that.
+  //
+  // Return false if any chunk fails to be read or 'func' returns false.
+  bool ForEachChunk(
+      const std::function<bool(int, InputStringStream&)>& func);
+
+ private:
+  bool ReadManifest(InputStream& is);  // NOLINT
+  // Read, decompress and verify chunk 'chunk_id' to 'data'.
+  bool ReadChunk(int chunk_id, std::string* data) const;
+  void PostChunk();
+  // Wait for chunk 'chunk_id', return false if it fails to be read.
+  bool WaitChunk(int chunk_id);
+  // Release chunk 'cur_' and move to the next one.
+  void NextChunk();
+};
+
+}  // namespace deepx_core
@@ -3,6 +3,7 @@
 //
 
 #pragma once
+#include <deepx_core/common/stream.h>
 #include <string>
 
 namespace deepx_core {
@@ -13,4 +14,82 @@ bool HighCompress(const std::string& in, std::string* out);
 bool Decompress(const char* in, int in_size, std::string* out);
 bool Decompress(const std::string& in, std::string* out);
 
+/************************************************************************/
+/* LZ4 frame functions */
+/************************************************************************/
+// LZ4 frames are compatible with the lz4 command line tool.
+// Blocks are independent of each other and frames carry content checksums.
+
+// Return if 'data' begins with the magic number of LZ4 frames.
+bool IsLZ4Frame(const void* data, size_t size) noexcept;
+bool LZ4FrameCompress(const char* in, size_t in_size, std::string* out);
+// 'in' may be a concatenation of frames.
+bool LZ4FrameDecompress(const char* in, size_t in_size, std::string* out);
+
+/************************************************************************/
+/* LZ4FrameOutputStream */
+/************************************************************************/
+// It compresses data to 'os' as an LZ4 frame of 4MB blocks.
+//
+// 'Close' writes the end of the frame, it is called by the destructor,
+// but only the return value of 'Close' tells if the frame is complete.
+class LZ4FrameOutputStream : public OutputStream {
+ private:
+  OutputStream* const os_;
+  void* ctx_ = nullptr;
+  std::string in_buf_;
+  std::string out_buf_;
+  int begun_ = 0;
+  int closed_ = 0;
+
+ private:
+  bool WriteOutBuf(size_t size);
+  bool CompressBuf();
+
+ public:
+  explicit LZ4FrameOutputStream(OutputStream* os);
+  ~LZ4FrameOutputStream() override;
+  size_t Write(const void* data, size_t size) override;
+  // Compress buffered data as a block and flush 'os'.
+  bool Flush() override;
+
+ public:
+  bool Close();
+};
+
+/************************************************************************/
+/* LZ4FrameInputStream */
+/************************************************************************/
+// It decompresses LZ4 frames from 'is'.
+//
+// A truncated or corrupted frame makes the stream bad.
+// 'Peek' returns at most the bytes of a decompressed block.
+// 'Read' of at least a block decompresses to 'data' directly.
+class LZ4FrameInputStream : public InputStream {
+ private:
+  InputStream* const is_;
+  void* ctx_ = nullptr;
+  std::string in_buf_;
+  size_t in_begin_ = 0;
+  size_t in_end_ = 0;
+  std::string out_buf_;
+  const char* cur_ = nullptr;
+  const char* end_ = nullptr;
+  int frame_end_ = 1;
+
+ private:
+  // Decompress at most 'size' bytes to 'data'.
+  // Return the number of bytes, 0 at the end or on errors.
+  size_t DecompressTo(char* data, size_t size);
+  bool FillOutBuf();
+
+ public:
+  explicit LZ4FrameInputStream(InputStream* is);
+  ~LZ4FrameInputStream() override;
+  size_t Read(void* data, size_t size) override;
+  char ReadChar() override;
+  size_t Peek(void* data, size_t size) override;
+  void ReadLine(std::string* line, char delim) override;
+};
+
 }  // namespace deepx_core
@@ -4,6 +4,8 @@
 
 #pragma once
 #include <cstdint>
+#include <cstring>  // memcpy
+#include <type_traits>  // std::is_signed
 
 namespace deepx_core {
 
@@ -60,4 +62,161 @@ inline int64_t fast_strtoi(const char* s, char** end) noexcept {
   return fast_strtoi64(s, end);
 }
 
+namespace detail {
+
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define FAST_STRTOX_SWAR 1
+#else
+#define FAST_STRTOX_SWAR 0
+#endif
+
+#if FAST_STRTOX_SWAR == 1
+const uint64_t ASCII_ZEROS = UINT64_C(0x3030303030303030);
+
+// Return the number of leading digits in 8 bytes 'chunk'.
+inline int LeadingDigits(uint64_t chunk) noexcept {
+  const uint64_t high = UINT64_C(0xF0F0F0F0F0F0F0F0);
+  // A byte of 'x' is 0, iff it is a digit.
+  // '+ 6' carries only from bytes above '9', which are not digits.
+  uint64_t x = ((chunk & high) ^ ASCII_ZEROS) |
+               (((chunk + UINT64_C(0x0606060606060606)) & high) ^ ASCII_ZEROS);
+  return x == 0 ? 8 : __builtin_ctzll(x) >> 3;
+}
+
+// Convert the leading 'n'(1 <= n <= 8) digits in 8 bytes 'chunk'.
+inline uint64_t ConvertDigits(uint64_t chunk, int n) noexcept {
+  const uint64_t mask = UINT64_C(0x000000FF000000FF);
+  const uint64_t mul1 = UINT64_C(0x000F424000000064);  // 100 + (1000000 << 32)
+  const uint64_t mul2 = UINT64_C(0x0000271000000001);  // 1 + (10000 << 32)
+  // Bytes after the digits are shifted out, leading bytes become 0.
+  uint64_t v = (chunk - ASCII_ZEROS) << (64 - 8 * n);
+  v = v * 10 + (v >> 8);
+  return ((v & mask) * mul1 + ((v >> 16) & mask) * mul2) >> 32;
+}
+#endif
+
+// Accumulate digits in [s, s_end) to '*value'.
+//
+// Return the end of digits.
+inline const char* ScanDigits(const char* s, const char* s_end,
+                              uint64_t* value) noexcept {
+  uint64_t v = *value;
+#if FAST_STRTOX_SWAR == 1
+  static constexpr uint64_t POW10[] = {
+      1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+  };
+  // Digits are found with a bitmask and converted 8 at a time, no branch
+  // depends on the number of digits.
+  uint64_t chunk;
+  int n;
+  while (s_end - s >= 8) {
+    memcpy(&chunk, s, 8);
+    n = LeadingDigits(chunk);
+    if (n == 0) {
+      *value = v;
+      return s;
+    }
+    // no overflow check
+    v = v * POW10[n] + ConvertDigits(chunk, n);
+    s += n;
+    if (n < 8) {
+      *value = v;
+      return s;
+    }
+  }
+#endif
+  while (s < s_end && '0' <= *s && *s <= '9') {
+    // no overflow check
+    v = v * 10 + (uint64_t)(*s - '0');
+    ++s;
+  }
+  *value = v;
+  return s;
+}
+
+inline const char* SkipSpace(const char* s, const char* s_end) noexcept {
+  while (s < s_end && (*s == ' ' || *s == '\t')) {
+    ++s;
+  }
+  return s;
+}
+
+}  // namespace detail
+
+// Bounded versions of 'fast_strtod' and 'fast_strtoi'.
+//
+// Digits in [s, s_end) are converted 8 at a time.
+// '*s_end' must not be part of the number, e.g. it is the terminating NUL of
+// a std::string, then results are the same as those of unbounded versions.
+inline double fast_strtod(const char* s, const char* s_end,
+                          char** end) noexcept {
+  static constexpr double NEG_POW10[] = {
+      1E-000, 1E-001, 1E-002, 1E-003, 1E-004, 1E-005, 1E-006, 1E-007,
+      1E-008, 1E-009, 1E-010, 1E-011, 1E-012, 1E-013, 1E-014, 1E-015,
+  };
+
+  // Fast path for numbers like "-0.125".
+  // At most 15 digits are exact in double,
+  // the result is the same as that of the slow path.
+  const char* p = s;
+  int negate = 0;
+  if (p < s_end && (*p == '-' || *p == '+')) {
+    negate = *p == '-';
+    ++p;
+  }
+  uint64_t b = 0;
+  const char* q = detail::ScanDigits(p, s_end, &b);
+  int digits = (int)(q - p);
+  int decimals = 0;
+  if (q < s_end && *q == '.') {
+    p = q + 1;
+    q = detail::ScanDigits(p, s_end, &b);
+    decimals = (int)(q - p);
+    digits += decimals;
+  }
+  if (digits > 15 || (q < s_end && (*q == '.' || (*q | ('e' ^ 'E')) == 'e'))) {
+    // slow path
+    return fast_strtod(s, end);
+  }
+
+  *end = (char*)q;
+  // signed conversion is faster
+  double d = (double)(int64_t)b;
+  if (negate) {
+    d = -d;
+  }
+  return d * NEG_POW10[decimals];
+}
+
+inline uint64_t fast_strtou64(const char* s, const char* s_end,
+                              char** end) noexcept {
+  uint64_t result = 0;
+  s = detail::SkipSpace(s, s_end);
+  *end = (char*)detail::ScanDigits(s, s_end, &result);
+  return result;
+}
+
+inline int64_t fast_strtoi64(const char* s, const char* s_end,
+                             char** end) noexcept {
+  uint64_t result = 0;
+  int negative = 0;
+  s = detail::SkipSpace(s, s_end);
+  if (s < s_end && *s == '-') {
+    negative = 1;
+    ++s;
+  }
+  *end = (char*)detail::ScanDigits(s, s_end, &result);
+  return (int64_t)(negative ? 0 - result : result);
+}
+
+template <typename Int>
+inline Int fast_strtoi(const char* s, const char* s_end, char** end) noexcept {
+  if (std::is_signed<Int>::value) {
+    return (Int)fast_strtoi64(s, s_end, end);
+  } else {
+    return (Int)fast_strtou64(s, s_end, end);
+  }
+}
+
 }  // namespace deepx_core
@@ -593,6 +593,20 @@ class FlatHashMap {
     return 1;
   }
 
+  // Prefetch the first probed bucket of 'k',
+  // so that a following lookup of 'k' is less likely to miss cache.
+  void prefetch(const key_type& k) const noexcept {
+#if defined __GNUC__
+    if (!bucket_.empty()) {
+      size_type index = khash_(k) & (bucket_.size() - 1);
+      __builtin_prefetch(&meta_[index]);
+      __builtin_prefetch(&bucket_[index]);
+    }
+#else
+    (void)k;
+#endif
+  }
+
   std::pair<iterator, bool> insert(const_reference kv) { return emplace(kv); }
 
   template <typename II>
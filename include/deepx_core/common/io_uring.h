@@ -0,0 +1,192 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#pragma once
+#include <deepx_core/common/stream.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace deepx_core {
+
+/************************************************************************/
+/* IoUring */
+/************************************************************************/
+// A minimal io_uring by raw system calls, without liburing.
+//
+// It is unavailable on non-Linux systems, old kernels, or when io_uring is
+// disabled, e.g. by seccomp, in which case 'Open' fails.
+// At most 'entries' requests are in flight, so completions never overflow.
+class IoUring {
+ private:
+  int fd_ = -1;
+  void* sq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  void* cq_ring_ = nullptr;
+  size_t cq_ring_size_ = 0;
+  void* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+  unsigned* sq_head_ = nullptr;
+  unsigned* sq_tail_ = nullptr;
+  unsigned* sq_mask_ = nullptr;
+  unsigned* sq_array_ = nullptr;
+  unsigned* cq_head_ = nullptr;
+  unsigned* cq_tail_ = nullptr;
+  unsigned* cq_mask_ = nullptr;
+  void* cqes_ = nullptr;
+  unsigned entries_ = 0;
+  unsigned queued_ = 0;     // number of requests not submitted
+  unsigned in_flight_ = 0;  // number of requests not completed
+
+ private:
+  // Queue 'sqe', a 'struct io_uring_sqe'.
+  bool Push(const void* sqe) noexcept;
+
+ public:
+  IoUring() = default;
+  ~IoUring();
+  IoUring(const IoUring&) = delete;
+  IoUring& operator=(const IoUring&) = delete;
+
+ public:
+  bool Open(unsigned entries) noexcept;
+  bool IsOpen() const noexcept { return fd_ != -1; }
+  void Close() noexcept;
+  unsigned entries() const noexcept { return entries_; }
+  unsigned in_flight() const noexcept { return in_flight_; }
+
+  // Queue a request tagged by 'user_data'.
+  // Return false if 'entries' requests are in flight.
+  bool PrepareRead(int fd, void* buf, size_t size, uint64_t offset,
+                   uint64_t user_data) noexcept;
+  bool PrepareWrite(int fd, const void* buf, size_t size, uint64_t offset,
+                    uint64_t user_data) noexcept;
+  // Like lstat, 'statx_buf' points to a 'struct statx'.
+  bool PrepareStat(const char* path, void* statx_buf,
+                   uint64_t user_data) noexcept;
+  // Submit queued requests.
+  bool Submit() noexcept;
+  // Submit queued requests and wait for a completion.
+  // 'res' is the result of the request, or -errno on failure.
+  bool Wait(uint64_t* user_data, int* res) noexcept;
+
+ public:
+  // Whether io_uring works on this machine, probed once.
+  static bool Available() noexcept;
+};
+
+/************************************************************************/
+/* IoUringInputStream */
+/************************************************************************/
+// It reads a local regular file by io_uring, block by block.
+//
+// At most 'blocks' reads of 'block_size' bytes are in flight.
+// The file is read up to its size at 'Open'.
+// 'Peek' returns at most the bytes in 'blocks' blocks.
+class IoUringInputStream : public InputStream {
+ protected:
+  struct Block {
+    std::unique_ptr<char[]> buf;
+    size_t size = 0;
+    int done = 0;
+    int res = 0;
+  };
+
+  const size_t block_size_;
+  std::vector<Block> blocks_;
+  IoUring ring_;
+  int fd_ = -1;
+  size_t file_size_ = 0;
+  size_t submitted_ = 0;  // number of blocks submitted
+  size_t consumed_ = 0;   // number of blocks released
+  int holding_ = 0;
+  const char* cur_ = nullptr;
+  const char* end_ = nullptr;
+
+ protected:
+  bool SubmitBlocks();
+  bool WaitBlock(size_t i);
+  // Release the current block and wait for the next one.
+  bool NextBlock();
+
+ public:
+  explicit IoUringInputStream(
+      int blocks = 4,                    // magic number
+      size_t block_size = 1024 * 1024);  // magic number
+  ~IoUringInputStream() override;
+  size_t Read(void* data, size_t size) override;
+  char ReadChar() override;
+  size_t Peek(void* data, size_t size) override;
+  void ReadLine(std::string* line, char delim) override;
+
+ public:
+  bool Open(const std::string& file);
+  bool IsOpen() const noexcept { return fd_ != -1; }
+  void Close() noexcept;
+};
+
+/************************************************************************/
+/* IoUringOutputStream */
+/************************************************************************/
+// It writes a local file by io_uring, with O_DIRECT if the file system
+// supports it.
+//
+// Data are buffered in 'blocks' aligned blocks of 'block_size' bytes,
+// at most 'blocks' writes are in flight.
+// 'Flush' waits for them, and writes the partial block without O_DIRECT.
+// Errors of writes in flight are reported by 'Flush' or 'Close'.
+class IoUringOutputStream : public OutputStream {
+ protected:
+  struct AlignedDeleter {
+    void operator()(char* p) const noexcept;
+  };
+
+  struct Block {
+    std::unique_ptr<char, AlignedDeleter> buf;
+    int in_flight = 0;
+  };
+
+  const size_t block_size_;
+  std::vector<Block> blocks_;
+  IoUring ring_;
+  int fd_ = -1;
+  int direct_ = 0;
+  size_t written_ = 0;  // number of blocks submitted
+  size_t size_ = 0;     // bytes in the current block
+  std::string file_;
+
+ protected:
+  bool WaitOne();
+  bool WaitAll();
+  bool SubmitBlock();
+
+ public:
+  explicit IoUringOutputStream(
+      int blocks = 4,                    // magic number
+      size_t block_size = 1024 * 1024);  // magic number
+  ~IoUringOutputStream() override;
+  size_t Write(const void* data, size_t size) override;
+  bool Flush() override;
+
+ public:
+  bool Open(const std::string& file);
+  bool IsOpen() const noexcept { return fd_ != -1; }
+  bool direct() const noexcept { return direct_ != 0; }
+  bool Close() noexcept;
+};
+
+/************************************************************************/
+/* IoUringStat */
+/************************************************************************/
+// Stat local 'paths' like 'LocalFileSystem::Stat',
+// with at most 'batch' stats in flight.
+//
+// It falls back to 'LocalFileSystem::Stat' if io_uring is unavailable.
+// Return false if any of 'paths' fails.
+bool IoUringStat(const std::vector<std::string>& paths,
+                 std::vector<FileStat>* stats,
+                 int batch = 64);  // magic number
+
+}  // namespace deepx_core
@@ -70,6 +70,9 @@ class LRUCache {
     evict_callback_ = callback;
   }
 
+  size_type hit() const noexcept { return hit_; }
+  size_type miss() const noexcept { return miss_; }
+
   double hit_rate() const noexcept {
     size_type total = hit_ + miss_;
     return total == 0 ? 0 : 1.0 * hit_ / total;
@@ -0,0 +1,454 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#if !defined NDEBUG
+#include <stdexcept>  // std::runtime_error
+#endif
+
+namespace deepx_core {
+
+/************************************************************************/
+/* Wait policies */
+/************************************************************************/
+// Spin, then yield, then park on a condition variable.
+struct BlockingWaitPolicy {
+  static constexpr int SPIN_COUNT = 128;
+  static constexpr int YIELD_COUNT = 16;
+  static constexpr bool PARK = true;
+};
+
+// Spin, then yield forever.
+// It trades cpu for latency, use it only if threads outnumber cpus rarely.
+struct YieldingWaitPolicy {
+  static constexpr int SPIN_COUNT = 128;
+  static constexpr int YIELD_COUNT = 0;
+  static constexpr bool PARK = false;
+};
+
+/************************************************************************/
+/* MPMCQueue */
+/************************************************************************/
+// A bounded lock-free multi-producer multi-consumer queue.
+//
+// Dmitry Vyukov's bounded MPMC queue,
+// every cell carries a sequence number telling producers and consumers
+// whether it is ready, so push and pop only do one CAS on the hot path.
+//
+// Start/stop semantics are the same as BlockingQueue.
+//
+// The destructor stops the queue and waits for blocked producers and
+// consumers to return, but no call may begin after it begins.
+template <typename T, class WaitPolicy = BlockingWaitPolicy>
+class MPMCQueue {
+ public:
+  using value_type = T;
+  using pointer = value_type*;
+  using const_reference = const value_type&;
+  using wait_policy_t = WaitPolicy;
+
+ private:
+  struct Cell {
+    std::atomic<size_t> seq;
+    typename std::aligned_storage<sizeof(value_type),
+                                  alignof(value_type)>::type storage;
+
+    pointer value() noexcept { return reinterpret_cast<pointer>(&storage); }
+  };
+
+  // Keep producer and consumer positions in different cache lines.
+  struct Position {
+    std::atomic<size_t> pos{0};
+    char pad[64 - sizeof(std::atomic<size_t>)];
+  };
+
+  std::unique_ptr<Cell[]> cells_;
+  size_t mask_ = 0;
+  Position enqueue_;
+  Position dequeue_;
+  std::atomic<int> started_{0};
+  std::atomic<int> push_waiters_{0};
+  std::atomic<int> pop_waiters_{0};
+  std::atomic<int> blocked_{0};
+  std::atomic<size_t> epoch_{0};
+  std::mutex mutex_;
+  std::condition_variable not_empty_cond_;
+  std::condition_variable not_full_cond_;
+
+ public:
+  // 'capacity' will be rounded up to a power of 2.
+  explicit MPMCQueue(size_t capacity = 1024) {
+    size_t n = 2;
+    while (n < capacity) {
+      n *= 2;
+    }
+    cells_.reset(new Cell[n]);
+    for (size_t i = 0; i < n; ++i) {
+      cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    mask_ = n - 1;
+  }
+
+  ~MPMCQueue() {
+    stop();
+    while (blocked_.load(std::memory_order_acquire) > 0) {
+      std::this_thread::yield();
+    }
+
+    size_t end = enqueue_.pos.load(std::memory_order_relaxed);
+    for (size_t pos = dequeue_.pos.load(std::memory_order_relaxed); pos != end;
+         ++pos) {
+      Cell* cell = &cells_[pos & mask_];
+      if (cell->seq.load(std::memory_order_relaxed) == pos + 1) {
+        cell->value()->~value_type();
+      }
+    }
+  }
+
+  MPMCQueue(const MPMCQueue&) = delete;
+  MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+  size_t capacity() const noexcept { return mask_ + 1; }
+
+  // Return the approximate number of elements.
+  size_t size() const noexcept {
+    size_t e = enqueue_.pos.load(std::memory_order_relaxed);
+    size_t d = dequeue_.pos.load(std::memory_order_relaxed);
+    return e > d ? e - d : 0;
+  }
+
+  bool empty() const noexcept { return size() == 0; }
+
+  // Start the queue.
+  void start() {
+    std::unique_lock<std::mutex> guard(mutex_);
+    started_.store(1, std::memory_order_release);
+  }
+
+  // Stop the queue.
+  //
+  // Blocked producers and consumers are woken up,
+  // consumers drain the remaining elements before they fail.
+  void stop() {
+    std::unique_lock<std::mutex> guard(mutex_);
+    if (started_.load(std::memory_order_relaxed)) {
+      started_.store(0, std::memory_order_release);
+      not_empty_cond_.notify_all();
+      not_full_cond_.notify_all();
+    }
+  }
+
+  // Push an element constructed by 'args' if the queue is not full.
+  //
+  // Return true, the element is pushed.
+  // Return false, the queue is full.
+  template <typename... Args>
+  bool try_push(Args&&... args) {
+    Cell* cell;
+    size_t pos = enqueue_.pos.load(std::memory_order_relaxed);
+    for (;;) {
+      cell = &cells_[pos & mask_];
+      size_t seq = cell->seq.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+      if (diff == 0) {
+        if (enqueue_.pos.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_.pos.load(std::memory_order_relaxed);
+      }
+    }
+    new (cell->value()) value_type(std::forward<Args>(args)...);
+    cell->seq.store(pos + 1, std::memory_order_release);
+    notify(&pop_waiters_, &not_empty_cond_, 0);
+    return true;
+  }
+
+  // Pop an element if the queue is not empty.
+  //
+  // Return true, 'v' is got.
+  // Return false, the queue is empty.
+  bool try_pop(pointer v) {
+    Cell* cell;
+    size_t pos = dequeue_.pos.load(std::memory_order_relaxed);
+    for (;;) {
+      cell = &cells_[pos & mask_];
+      size_t seq = cell->seq.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+      if (diff == 0) {
+        if (dequeue_.pos.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeue_.pos.load(std::memory_order_relaxed);
+      }
+    }
+    *v = std::move(*cell->value());
+    cell->value()->~value_type();
+    cell->seq.store(pos + mask_ + 1, std::memory_order_release);
+    notify(&push_waiters_, &not_full_cond_, 0);
+    return true;
+  }
+
+  // Push up to 'n' elements from 'first' with one CAS.
+  //
+  // Return the number of elements pushed.
+  template <class Iterator>
+  size_t try_push_batch(Iterator first, size_t n) {
+    if (n == 0) {
+      return 0;
+    }
+    size_t pos = enqueue_.pos.load(std::memory_order_relaxed);
+    size_t m;
+    for (;;) {
+      // Claim the longest prefix of free cells.
+      for (m = 0; m < n; ++m) {
+        const Cell& cell = cells_[(pos + m) & mask_];
+        if (cell.seq.load(std::memory_order_acquire) != pos + m) {
+          break;
+        }
+      }
+      if (m == 0) {
+        size_t seq = cells_[pos & mask_].seq.load(std::memory_order_acquire);
+        if ((intptr_t)seq - (intptr_t)pos < 0) {
+          return 0;
+        }
+        pos = enqueue_.pos.load(std::memory_order_relaxed);
+        continue;
+      }
+      if (enqueue_.pos.compare_exchange_weak(pos, pos + m,
+                                             std::memory_order_relaxed)) {
+        break;
+      }
+    }
+    for (size_t i = 0; i < m; ++i, ++first) {
+      Cell* cell = &cells_[(pos + i) & mask_];
+      new (cell->value()) value_type(*first);
+      cell->seq.store(pos + i + 1, std::memory_order_release);
+    }
+    notify(&pop_waiters_, &not_empty_cond_, 1);
+    return m;
+  }
+
+  // Pop up to 'n' elements to 'first' with one CAS.
+  //
+  // Return the number of elements popped.
+  template <class Iterator>
+  size_t try_pop_batch(Iterator first, size_t n) {
+    if (n == 0) {
+      return 0;
+    }
+    size_t pos = dequeue_.pos.load(std::memory_order_relaxed);
+    size_t m;
+    for (;;) {
+      // Claim the longest prefix of ready cells.
+      for (m = 0; m < n; ++m) {
+        const Cell& cell = cells_[(pos + m) & mask_];
+        if (cell.seq.load(std::memory_order_acquire) != pos + m + 1) {
+          break;
+        }
+      }
+      if (m == 0) {
+        size_t seq = cells_[pos & mask_].seq.load(std::memory_order_acquire);
+        if ((intptr_t)seq - (intptr_t)(pos + 1) < 0) {
+          return 0;
+        }
+        pos = dequeue_.pos.load(std::memory_order_relaxed);
+        continue;
+      }
+      if (dequeue_.pos.compare_exchange_weak(pos, pos + m,
+                                             std::memory_order_relaxed)) {
+        break;
+      }
+    }
+    for (size_t i = 0; i < m; ++i, ++first) {
+      Cell* cell = &cells_[(pos + i) & mask_];
+      *first = std::move(*cell->value());
+      cell->value()->~value_type();
+      cell->seq.store(pos + i + mask_ + 1, std::memory_order_release);
+    }
+    notify(&push_waiters_, &not_full_cond_, 1);
+    return m;
+  }
+
+  // Push an element constructed by 'args' in blocking mode.
+  //
+  // Return true, the element is pushed.
+  // Return false, the queue is stopped and full.
+  //
+  // The queue must be started.
+  template <typename... Args>
+  bool push(Args&&... args) {
+#if !defined NDEBUG
+    if (!started()) {
+      throw std::runtime_error("push: the queue is not started.");
+    }
+#endif
+    return wait(&push_waiters_, &not_full_cond_, [&]() {
+      return try_push(std::forward<Args>(args)...);
+    });
+  }
+
+  // Pop an element in blocking mode.
+  //
+  // Return true, 'v' is got.
+  // Return false, the queue is stopped and empty.
+  bool pop(pointer v) {
+    return wait(&pop_waiters_, &not_empty_cond_,
+                [this, v]() { return try_pop(v); });
+  }
+
+  // Push 'n' elements from 'first' in blocking mode.
+  //
+  // Return the number of elements pushed,
+  // it is less than 'n' only if the queue is stopped and full.
+  //
+  // The queue must be started.
+  template <class Iterator>
+  size_t push_batch(Iterator first, size_t n) {
+#if !defined NDEBUG
+    if (!started()) {
+      throw std::runtime_error("push_batch: the queue is not started.");
+    }
+#endif
+    size_t pushed = 0;
+    while (pushed < n) {
+      size_t m = 0;
+      if (!wait(&push_waiters_, &not_full_cond_, [&]() {
+            m = try_push_batch(first, n - pushed);
+            return m > 0;
+          })) {
+        break;
+      }
+      std::advance(first, m);
+      pushed += m;
+    }
+    return pushed;
+  }
+
+  // Pop at least one and up to 'n' elements to 'first' in blocking mode.
+  //
+  // Return the number of elements popped,
+  // it is 0 only if the queue is stopped and empty.
+  template <class Iterator>
+  size_t pop_batch(Iterator first, size_t n) {
+    size_t m = 0;
+    if (!wait(&pop_waiters_, &not_empty_cond_, [&]() {
+          m = try_pop_batch(first, n);
+          return m > 0;
+        })) {
+      return 0;
+    }
+    return m;
+  }
+
+ private:
+  int started() const noexcept {
+    return started_.load(std::memory_order_acquire);
+  }
+
+  void notify(std::atomic<int>* waiters, std::condition_variable* cond,
+              int all) {
+    if (!wait_policy_t::PARK) {
+      return;
+    }
+    // Pairs with the fence in 'wait'.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters->load(std::memory_order_relaxed) > 0) {
+      std::unique_lock<std::mutex> guard(mutex_);
+      epoch_.fetch_add(1, std::memory_order_relaxed);
+      if (all) {
+        cond->notify_all();
+      } else {
+        cond->notify_one();
+      }
+    }
+  }
+
+  // Count callers which are blocked, the destructor waits for them.
+  class BlockedGuard {
+   private:
+    std::atomic<int>* const blocked_;
+
+   public:
+    explicit BlockedGuard(std::atomic<int>* blocked) : blocked_(blocked) {
+      blocked_->fetch_add(1, std::memory_order_relaxed);
+    }
+    ~BlockedGuard() { blocked_->fetch_sub(1, std::memory_order_release); }
+    BlockedGuard(const BlockedGuard&) = delete;
+    BlockedGuard& operator=(const BlockedGuard&) = delete;
+  };
+
+  // Wait until 'func' returns true or the queue is stopped.
+  //
+  // Return true, 'func' returns true.
+  // Return false, 'func' returns false and the queue is stopped.
+  template <class Func>
+  bool wait(std::atomic<int>* waiters, std::condition_variable* cond,
+            Func&& func) {
+    if (func()) {
+      return true;
+    }
+
+    // The blocked caller must not touch the queue after 'guard' is released.
+    BlockedGuard guard(&blocked_);
+    for (int i = 0; i < wait_policy_t::SPIN_COUNT; ++i) {
+      if (func()) {
+        return true;
+      }
+    }
+
+    for (int i = 0; !wait_policy_t::PARK || i < wait_policy_t::YIELD_COUNT;
+         ++i) {
+      if (func()) {
+        return true;
+      }
+      if (!started()) {
+        // the last try, consumers drain the remaining elements
+        return func();
+      }
+      std::this_thread::yield();
+    }
+
+    for (;;) {
+      waiters->fetch_add(1, std::memory_order_relaxed);
+      // Pairs with the fence in 'notify'.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      size_t epoch = epoch_.load(std::memory_order_relaxed);
+      if (func()) {
+        waiters->fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+
+      std::unique_lock<std::mutex> guard(mutex_);
+      while (started() && epoch == epoch_.load(std::memory_order_relaxed)) {
+        cond->wait(guard);
+      }
+      guard.unlock();
+      waiters->fetch_sub(1, std::memory_order_relaxed);
+      if (!started()) {
+        return func();
+      }
+    }
+  }
+};
+
+}  // namespace deepx_core
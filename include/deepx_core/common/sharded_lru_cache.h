@@ -0,0 +1,223 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#pragma once
+#include <deepx_core/common/lru_cache.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace deepx_core {
+
+/************************************************************************/
+/* ShardedLRUCache */
+/************************************************************************/
+// A thread safe LRU cache.
+//
+// Keys are distributed to 'shard_size' LRUCaches by their hash values,
+// each of them is guarded by its own mutex.
+// The LRU policy is applied per shard.
+template <typename Key, typename Value, class KeyHash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>>
+class ShardedLRUCache {
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using size_type = size_t;
+  using lru_cache_t = LRUCache<Key, Value, KeyHash, KeyEqual>;
+  using evict_callback = typename lru_cache_t::evict_callback;
+
+ private:
+  struct Shard {
+    std::mutex mutex;
+    lru_cache_t cache;
+  };
+
+  using key_hash_t = KeyHash;
+  key_hash_t key_hash_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+  size_type shard_mask_ = 0;
+
+ public:
+  ShardedLRUCache() = default;
+  ShardedLRUCache(const ShardedLRUCache&) = delete;
+  ShardedLRUCache& operator=(const ShardedLRUCache&) = delete;
+
+  // Set the evict callback of all shards.
+  //
+  // 'callback' is called with the shard mutex held,
+  // it may be called by several threads concurrently.
+  //
+  // It must be called after 'init'.
+  void set_evict_callback(const evict_callback& callback) {
+    for (auto& shard : shards_) {
+      std::unique_lock<std::mutex> guard(shard->mutex);
+      shard->cache.set_evict_callback(callback);
+    }
+  }
+
+  // Return the aggregated hit rate of all shards.
+  double hit_rate() const {
+    size_type hit = 0, miss = 0;
+    for (auto& shard : shards_) {
+      std::unique_lock<std::mutex> guard(shard->mutex);
+      hit += shard->cache.hit();
+      miss += shard->cache.miss();
+    }
+    size_type total = hit + miss;
+    return total == 0 ? 0 : 1.0 * hit / total;
+  }
+
+  void clear_hit_rate() {
+    for (auto& shard : shards_) {
+      std::unique_lock<std::mutex> guard(shard->mutex);
+      shard->cache.clear_hit_rate();
+    }
+  }
+
+ public:
+  // Initialize the cache.
+  //
+  // It can hold about 'capacity' elements at most.
+  // 'shard_size' will be rounded up to a power of 2.
+  //
+  // It is not thread safe.
+  void init(size_type capacity, size_type shard_size = 16) {
+    size_type n = 1;
+    while (n < shard_size) {
+      n *= 2;
+    }
+    shards_.clear();
+    shards_.reserve(n);
+    for (size_type i = 0; i < n; ++i) {
+      std::unique_ptr<Shard> shard(new Shard);
+      shard->cache.init((capacity + n - 1) / n);
+      shards_.emplace_back(std::move(shard));
+    }
+    shard_mask_ = n - 1;
+  }
+
+  // Return if the cache is initialized.
+  bool initialized() const noexcept { return !shards_.empty(); }
+
+  // Return the number of shards.
+  size_type shard_size() const noexcept { return shards_.size(); }
+
+  // Return the number of elements.
+  size_type size() const {
+    size_type n = 0;
+    for (auto& shard : shards_) {
+      std::unique_lock<std::mutex> guard(shard->mutex);
+      n += shard->cache.size();
+    }
+    return n;
+  }
+
+  // Return the capacity.
+  size_type capacity() const noexcept {
+    size_type n = 0;
+    for (auto& shard : shards_) {
+      n += shard->cache.capacity();
+    }
+    return n;
+  }
+
+  // Clear all elements.
+  void clear() {
+    for (auto& shard : shards_) {
+      std::unique_lock<std::mutex> guard(shard->mutex);
+      shard->cache.init(shard->cache.capacity());
+    }
+  }
+
+  // Get or insert 'key' and call 'func(value)' with the shard mutex held.
+  //
+  // Return true if 'key' exists.
+  template <class Func>
+  bool get_or_insert(const key_type& key, Func&& func) {
+    Shard& shard = get_shard(key);
+    std::unique_lock<std::mutex> guard(shard.mutex);
+    size_type prev_hit = shard.cache.hit();
+    auto node = shard.cache.get_or_insert(key);
+    func(node->mutable_value());
+    return shard.cache.hit() != prev_hit;
+  }
+
+  // Get or insert 'key', mark it as the most recently used.
+  //
+  // Return true if 'key' exists.
+  bool get_or_insert(const key_type& key) {
+    return get_or_insert(key, [](mapped_type*) {});
+  }
+
+  // Get or insert all keys in ['first', 'last').
+  //
+  // Keys are grouped by shards, every shard mutex is locked once.
+  template <class Iterator>
+  void get_or_insert_batch(Iterator first, Iterator last) {
+    std::vector<std::vector<key_type>> shard_keys(shards_.size());
+    for (; first != last; ++first) {
+      shard_keys[get_shard_id(*first)].emplace_back(*first);
+    }
+    for (size_type i = 0; i < shards_.size(); ++i) {
+      if (shard_keys[i].empty()) {
+        continue;
+      }
+      Shard& shard = *shards_[i];
+      std::unique_lock<std::mutex> guard(shard.mutex);
+      for (const key_type& key : shard_keys[i]) {
+        (void)shard.cache.get_or_insert(key);
+      }
+    }
+  }
+
+  // Insert 'key' and 'value', existing element will be updated.
+  void insert(const key_type& key, const mapped_type& value) {
+    Shard& shard = get_shard(key);
+    std::unique_lock<std::mutex> guard(shard.mutex);
+    (void)shard.cache.insert(key, value);
+  }
+
+  // Get the value by 'key'.
+  //
+  // Return true and copy the value to 'value' if 'key' exists.
+  // Return false if 'key' does not exist.
+  bool get(const key_type& key, mapped_type* value) {
+    Shard& shard = get_shard(key);
+    std::unique_lock<std::mutex> guard(shard.mutex);
+    auto node = shard.cache.get(key);
+    if (!node) {
+      return false;
+    }
+    *value = node->value();
+    return true;
+  }
+
+  // Erase by 'key'.
+  //
+  // Return 1 if 'key' exists and the associated element is removed.
+  // Return 0 if 'key' does not exist.
+  size_type erase(const key_type& key) {
+    Shard& shard = get_shard(key);
+    std::unique_lock<std::mutex> guard(shard.mutex);
+    return shard.cache.erase(key);
+  }
+
+ private:
+  size_type get_shard_id(const key_type& key) const {
+    // LRUCache uses the low bits to select buckets,
+    // mix the hash value and use the high bits to select shards.
+    uint64_t h = (uint64_t)key_hash_(key) * 0x9e3779b97f4a7c15ULL;
+    return (size_type)(h >> 40) & shard_mask_;
+  }
+
+  Shard& get_shard(const key_type& key) {
+    return *shards_[get_shard_id(key)];
+  }
+};
+
+}  // namespace deepx_core
@@ -3,9 +3,12 @@
 //
 
 #pragma once
+#include <condition_variable>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <type_traits>  // std::is_pod, ...
 #include <unordered_map>
 #include <unordered_set>
@@ -271,6 +274,12 @@ class InputStream : virtual public StreamBase {
   virtual size_t Read(void* data, size_t size) = 0;
   virtual char ReadChar() = 0;
   virtual size_t Peek(void* data, size_t size) = 0;
+  // Read until 'delim', append bytes before 'delim' to 'line'.
+  // If the end is reached before 'delim', the stream becomes bad.
+  //
+  // The default implementation calls 'ReadChar' for each byte,
+  // buffered streams scan their buffers in bulk.
+  virtual void ReadLine(std::string* line, char delim);
 
  public:
   template <typename T>
@@ -305,6 +314,12 @@ void InputStream::ReadObject(Args&&... args) {
 InputStream& GetLine(InputStream& is, std::string& line);              // NOLINT
 InputStream& GetLine(InputStream& is, std::string& line, char delim);  // NOLINT
 
+// Append bytes of [begin, end) before 'delim' to 'line'.
+//
+// Return the number of scanned bytes, including 'delim' if it is found.
+size_t ScanLine(const char* begin, const char* end, char delim,
+                std::string* line, bool* found);
+
 /************************************************************************/
 /* IOStream */
 /************************************************************************/
@@ -332,6 +347,7 @@ class BufferedInputStream : public InputStream {
   size_t Read(void* data, size_t size) override;
   char ReadChar() override;
   size_t Peek(void* data, size_t size) override;
+  void ReadLine(std::string* line, char delim) override;
 };
 
 /************************************************************************/
@@ -361,6 +377,59 @@ class GunzipInputStream : public InputStream {
   size_t Read(void* data, size_t size) override;
   char ReadChar() override;
   size_t Peek(void* data, size_t size) override;
+  void ReadLine(std::string* line, char delim) override;
+};
+
+/************************************************************************/
+/* ReadAheadInputStream */
+/************************************************************************/
+// It reads 'is' in a background thread, block by block.
+//
+// At most 'blocks' blocks of 'block_size' bytes are read ahead.
+// The consumer waits for 'is' only when all of them have been consumed,
+// which is a stall.
+// 'Peek' returns at most the bytes in 'blocks' blocks.
+class ReadAheadInputStream : public InputStream {
+ protected:
+  struct Block {
+    std::unique_ptr<char[]> buf;
+    size_t size = 0;
+  };
+
+  InputStream* const is_;
+  const size_t block_size_;
+  std::vector<Block> blocks_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::thread thread_;
+  size_t produced_ = 0;  // number of blocks read
+  size_t consumed_ = 0;  // number of blocks released
+  int eof_ = 0;
+  int stop_ = 0;
+  int holding_ = 0;
+  const char* cur_ = nullptr;
+  const char* end_ = nullptr;
+  int stall_count_ = 0;
+  double stall_seconds_ = 0;
+
+ protected:
+  void Produce();
+  // Release the current block and wait for the next one.
+  bool NextBlock();
+
+ public:
+  explicit ReadAheadInputStream(
+      InputStream* is, int blocks = 4,   // magic number
+      size_t block_size = 1024 * 1024);  // magic number
+  ~ReadAheadInputStream() override;
+  size_t Read(void* data, size_t size) override;
+  char ReadChar() override;
+  size_t Peek(void* data, size_t size) override;
+  void ReadLine(std::string* line, char delim) override;
+
+ public:
+  int stall_count() const noexcept { return stall_count_; }
+  double stall_seconds() const noexcept { return stall_seconds_; }
 };
 
 /************************************************************************/
@@ -454,6 +523,7 @@ class InputStringStream : public InputStream {
   size_t Read(void* data, size_t size) override;
   char ReadChar() override;
   size_t Peek(void* data, size_t size) override;
+  void ReadLine(std::string* line, char delim) override;
   size_t Skip(size_t size);
 
  public:
@@ -643,19 +713,44 @@ class AutoFileSystem : public FileSystem {
 /************************************************************************/
 /* AutoInputFileStream */
 /************************************************************************/
+// If 'set_read_ahead(true)' is called before 'Open',
+// local files and HDFS files are read ahead by 'ReadAheadInputStream'.
+// It is for large files read sequentially, e.g. training data,
+// other files are read without a background thread.
+//
+// The number of blocks and the block size are flags 'read_ahead_blocks' and
+// 'read_ahead_block_size', or environment variables 'DEEPX_READ_AHEAD_BLOCKS'
+// and 'DEEPX_READ_AHEAD_BLOCK_SIZE'.
+// 0 blocks disable read-ahead.
+//
+// If flag 'io_uring' or environment variable 'DEEPX_IO_URING' is 1 and
+// io_uring is available, local regular files are read by
+// 'IoUringInputStream' instead, with the same number of blocks in flight.
 class AutoInputFileStream : public InputStream {
  protected:
   std::unique_ptr<HDFSHandle> hdfs_handle_;
   std::unique_ptr<InputStream> is_extra_;
+  std::unique_ptr<InputStream> is_read_ahead_;
   std::unique_ptr<InputStream> is_;
+  std::string file_;
+  const ReadAheadInputStream* read_ahead_ = nullptr;
+  int use_read_ahead_ = 0;
+
+ protected:
+  // Build 'is_' on 'is_extra_'.
+  void InitInputStream(const std::string& file, bool read_ahead);
 
  public:
   AutoInputFileStream();
   size_t Read(void* data, size_t size) override;
   char ReadChar() override;
   size_t Peek(void* data, size_t size) override;
+  void ReadLine(std::string* line, char delim) override;
 
  public:
+  void set_read_ahead(bool read_ahead) noexcept {
+    use_read_ahead_ = read_ahead ? 1 : 0;
+  }
   bool Open(const std::string& file);
   bool IsOpen() const noexcept;
   void Close() noexcept;
@@ -664,6 +759,8 @@ class AutoInputFileStream : public InputStream {
 /************************************************************************/
 /* AutoOutputFileStream */
 /************************************************************************/
+// If flag 'io_uring' or environment variable 'DEEPX_IO_URING' is 1 and
+// io_uring is available, local files are written by 'IoUringOutputStream'.
 class AutoOutputFileStream : public OutputStream {
  protected:
   std::unique_ptr<HDFSHandle> hdfs_handle_;
@@ -3,11 +3,17 @@
 //
 
 #pragma once
+#include <atomic>
 #include <condition_variable>
-#include <forward_list>
+#include <cstddef>
+#include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
+#include <new>
 #include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace deepx_core {
@@ -15,6 +21,16 @@ namespace deepx_core {
 /************************************************************************/
 /* ThreadPool */
 /************************************************************************/
+// A work-stealing thread pool.
+//
+// Each worker owns a Chase-Lev deque.
+// Tasks posted by a worker go to its own deque, the worker pops them in LIFO
+// order and idle workers steal them in FIFO order.
+// Tasks posted by other threads go to a shared injection queue in FIFO order.
+//
+// Tasks are stored in recycled nodes with a small inline buffer,
+// posting small function objects does not allocate memory in steady state,
+// from workers or other threads.
 class ThreadPool {
  public:
   struct WaitToken {
@@ -25,19 +41,179 @@ class ThreadPool {
   using function_t = std::function<void()>;
   using wait_token_t = WaitToken;
 
+  /************************************************************************/
+  /* ThreadPool::Task */
+  /************************************************************************/
+  class Task {
+   public:
+    static constexpr size_t INLINE_SIZE = 64;
+
+   private:
+    friend class ThreadPool;
+    using storage_t =
+        typename std::aligned_storage<INLINE_SIZE,
+                                      alignof(std::max_align_t)>::type;
+    storage_t storage_;
+    void (*invoke_)(void*) = nullptr;
+    void (*destroy_)(void*) = nullptr;
+
+    template <typename Func>
+    struct Inline {
+      static void invoke(void* p) { (*static_cast<Func*>(p))(); }
+      static void destroy(void* p) { static_cast<Func*>(p)->~Func(); }
+    };
+
+    template <typename Func>
+    struct Outline {
+      static void invoke(void* p) { (**static_cast<Func**>(p))(); }
+      static void destroy(void* p) { delete *static_cast<Func**>(p); }
+    };
+
+    template <typename Func>
+    void emplace(Func&& func, std::true_type /*is_inline*/) {
+      using func_t = typename std::decay<Func>::type;
+      new (&storage_) func_t(std::forward<Func>(func));
+      invoke_ = &Inline<func_t>::invoke;
+      destroy_ = &Inline<func_t>::destroy;
+    }
+
+    template <typename Func>
+    void emplace(Func&& func, std::false_type /*is_inline*/) {
+      using func_t = typename std::decay<Func>::type;
+      func_t* p = new func_t(std::forward<Func>(func));
+      new (&storage_) func_t*(p);
+      invoke_ = &Outline<func_t>::invoke;
+      destroy_ = &Outline<func_t>::destroy;
+    }
+
+   public:
+    Task() = default;
+    ~Task() { reset(); }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    // Store 'func' inline if it fits in 'INLINE_SIZE' bytes,
+    // otherwise store it on the heap.
+    template <typename Func>
+    void emplace(Func&& func) {
+      using func_t = typename std::decay<Func>::type;
+      using is_inline_t = std::integral_constant<
+          bool, sizeof(func_t) <= INLINE_SIZE &&
+                    alignof(func_t) <= alignof(std::max_align_t)>;
+      emplace(std::forward<Func>(func), is_inline_t());
+    }
+
+    void operator()() { invoke_(&storage_); }
+
+    void reset() noexcept {
+      if (destroy_) {
+        destroy_(&storage_);
+        invoke_ = nullptr;
+        destroy_ = nullptr;
+      }
+    }
+  };
+
+  /************************************************************************/
+  /* ThreadPool::TaskGroup */
+  /************************************************************************/
+  // Fork-join helper.
+  //
+  // 'spawn' posts function objects to the thread pool,
+  // 'wait' blocks until all of them are completed.
+  // If 'wait' is called in a worker thread, the worker runs other tasks while
+  // waiting, so task groups can be nested.
+  class TaskGroup {
+   private:
+    ThreadPool* const pool_;
+    std::atomic<int> pending_{0};
+    std::mutex mutex_;
+    std::condition_variable cond_;
+
+    // The last 'done' decrements and notifies under 'mutex_',
+    // 'wait' acquires 'mutex_' before it returns,
+    // so the group is not touched after 'wait' returns.
+    void done() {
+      std::unique_lock<std::mutex> guard(mutex_);
+      if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        cond_.notify_all();
+      }
+    }
+
+   public:
+    explicit TaskGroup(ThreadPool* pool) : pool_(pool) {}
+    ~TaskGroup() { wait(); }
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    template <typename Func>
+    void spawn(Func&& func) {
+      pending_.fetch_add(1, std::memory_order_relaxed);
+      using func_t = typename std::decay<Func>::type;
+      struct Wrapper {
+        TaskGroup* group;
+        func_t func;
+        void operator()() {
+          func();
+          group->done();
+        }
+      };
+      pool_->post(Wrapper{this, func_t(std::forward<Func>(func))});
+    }
+
+    void wait();
+  };
+
  private:
-  mutable std::mutex mutex_;
-  std::condition_variable cond_;
-  int started_ = 0;
-  std::forward_list<function_t> tasks_;
-  std::vector<std::thread> threads_;
+  struct Worker;
+  std::atomic<int> started_{0};
+  int cpu_affinity_ = 0;
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  std::mutex inject_mutex_;
+  std::deque<Task*> inject_queue_;
+  std::atomic<size_t> inject_size_{0};
+
+  std::mutex park_mutex_;
+  std::condition_variable park_cond_;
+  std::atomic<int> sleeping_{0};
+
+  // free task nodes shared by workers and other threads
+  static constexpr size_t MAX_FREE_SIZE = 4096;
+  std::mutex free_mutex_;
+  std::vector<Task*> free_tasks_;
+  std::atomic<size_t> free_size_{0};
 
  private:
-  int started() const;
-  void worker_thread();
+  static Worker*& current_worker() noexcept;
+  Task* allocate_task();
+  void release_task(Task* task) noexcept;
+  int started() const noexcept;
+  void post_task(Task* task);
+  void notify_one();
+  bool has_work() const noexcept;
+  Task* pop_inject() noexcept;
+  Task* steal(Worker* thief) noexcept;
+  Task* find_task(Worker* worker) noexcept;
+  bool try_run_one();
+  void worker_thread(Worker* worker);
+  void wait(wait_token_t* token);
 
  public:
+  ThreadPool();
   ~ThreadPool();
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Return the number of worker threads.
+  int size() const noexcept { return (int)workers_.size(); }
+
+  // Pin worker 'i' to cpu 'i % hardware_concurrency'.
+  //
+  // It must be called before 'start' and is only effective on Linux.
+  void set_cpu_affinity(int cpu_affinity) noexcept {
+    cpu_affinity_ = cpu_affinity;
+  }
 
   // Start 'n' worker threads.
   void start(int n);
@@ -49,7 +225,12 @@ class ThreadPool {
   // 'func' will be run in a worker thread.
   //
   // The thread pool must be started.
-  void post(function_t func);
+  template <typename Func>
+  void post(Func&& func) {
+    Task* task = allocate_task();
+    task->emplace(std::forward<Func>(func));
+    post_task(task);
+  }
 
   // Run 'func' in a worker thread and wait for the completion.
   //
@@ -60,6 +241,48 @@ class ThreadPool {
   //
   // The thread pool must be started.
   void run(const std::vector<function_t>& funcs, wait_token_t* token);
+
+  // Run 'func(i)' for 'i' in ['begin', 'end') in worker threads and the
+  // calling thread, 'grain' consecutive indices at a time,
+  // and wait for the completion.
+  //
+  // The thread pool must be started.
+  template <typename Func>
+  void parallel_for(size_t begin, size_t end, size_t grain, Func&& func) {
+    if (begin >= end) {
+      return;
+    }
+    if (grain == 0) {
+      grain = 1;
+    }
+
+    size_t chunks = (end - begin + grain - 1) / grain;
+    std::atomic<size_t> next(0);
+    auto body = [begin, end, grain, chunks, &next, &func]() {
+      for (;;) {
+        size_t chunk = next.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= chunks) {
+          break;
+        }
+        size_t first = begin + chunk * grain;
+        size_t last = (end - first > grain) ? first + grain : end;
+        for (size_t i = first; i < last; ++i) {
+          func(i);
+        }
+      }
+    };
+
+    size_t helpers = (size_t)size();
+    if (helpers > chunks - 1) {
+      helpers = chunks - 1;
+    }
+    TaskGroup group(this);
+    for (size_t i = 0; i < helpers; ++i) {
+      group.spawn(body);
+    }
+    body();
+    group.wait();
+  }
 };
 
 }  // namespace deepx_core
@@ -10,8 +10,8 @@
 #include <deepx_core/graph/model.h>
 #include <deepx_core/graph/tensor_map.h>
 #include <deepx_core/tensor/data_type.h>
+#include <deepx_core/tensor/philox.h>
 #include <memory>
-#include <random>
 #include <string>
 
 namespace deepx_core {
@@ -21,7 +21,7 @@ namespace deepx_core {
 /************************************************************************/
 class WePSModel : public DataType {
  private:
-  std::default_random_engine engine_;
+  PhiloxEngine engine_;
   WePSClient* client_ = nullptr;
   const Graph* graph_ = nullptr;
   std::unique_ptr<Model> model_;
@@ -32,9 +32,9 @@ class WePSModel : public DataType {
  public:
   template <typename Int>
   void seed(Int s) {
-    engine_.seed((std::default_random_engine::result_type)s);
+    engine_.seed((uint64_t)s);
   }
-  std::default_random_engine& engine() noexcept { return engine_; }
+  PhiloxEngine& engine() noexcept { return engine_; }
   WePSClient* mutable_client() noexcept { return client_; }
   const Graph& graph() const noexcept { return *graph_; }
   Model* mutable_model() noexcept { return model_.get(); }
@@ -5,10 +5,11 @@
 #pragma once
 // include all headers needed by WePSOptimizers
 #include <deepx_core/common/class_factory.h>
-#include <deepx_core/common/lru_cache.h>
+#include <deepx_core/common/sharded_lru_cache.h>
 #include <deepx_core/contrib/we_ps/optimizer/ll_we_ps_optimizer.h>
 #include <deepx_core/contrib/we_ps/optimizer/we_ps_optimizer.h>
 #include <deepx_core/dx_log.h>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -58,9 +59,9 @@ class WePSOptimizerImpl : public WePSOptimizer {
   StringMap config_;
   std::unordered_map<std::string, WePSOptimizerTSRSlot> tsr_slot_map_;
   std::unordered_map<std::string, WePSOptimizerSRMSlot> srm_slot_map_;
-  LRUCache<srm_t::key_type, bool> cache_;
-  id_set_t evicted_ids_;
-  id_set_t active_ids_;
+  ShardedLRUCache<srm_t::key_type, bool> cache_;
+  std::mutex evicted_ids_mutex_;
+  std::vector<int_t> evicted_ids_;
   int update_times_ = 0;
 
  public:
@@ -97,7 +98,8 @@ class WePSOptimizerImpl : public WePSOptimizer {
                              const srm_t& W, srm_t* D,
                              WePSOptimizerSRMSlot* slot) const = 0;
   void InitCache(size_t cache_size);
-  void UpdateCache();
+  void UpdateCache(const srm_t& G);
+  void RemoveEvictedIds();
 };
 
 /************************************************************************/
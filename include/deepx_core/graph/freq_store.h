@@ -43,7 +43,10 @@ class FreqStore : public DataType {
   void InitLock();
   bool Write(OutputStream& os) const;  // NOLINT
   bool Read(InputStream& is);          // NOLINT
-  bool Save(const std::string& file) const;
+  // Save to a chunked file if 'chunk_size' > 0.
+  // Compress it by LZ4 if 'compress' is true.
+  bool Save(const std::string& file, size_t chunk_size = 0,
+            bool compress = false) const;
   bool Load(const std::string& file);
   void Merge(FreqStore* other, const Shard* shard = nullptr, int shard_id = 0);
   void RemoveIf(
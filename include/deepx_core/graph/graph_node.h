@@ -841,6 +841,12 @@ class BatchFMInteraction2Node : public GraphNodeBinaryBase {
   DEFINE_GRAPH_NODE_LIKE(BatchFMInteraction2Node);
 };
 
+class BatchFMInnerProductNode : public GraphNodeUnaryBase {
+ public:
+  BatchFMInnerProductNode(std::string name, GraphNode* X);
+  DEFINE_GRAPH_NODE_LIKE(BatchFMInnerProductNode);
+};
+
 class BatchFMQuadraticNode : public GraphNode {
  public:
   BatchFMQuadraticNode(std::string name, GraphNode* X, GraphNode* V);
@@ -1129,6 +1135,13 @@ class SigmoidBCELoss2Node : public GraphNodeBinaryElementWiseBase {
   DEFINE_GRAPH_NODE_LIKE(SigmoidBCELoss2Node);
 };
 
+class WeightedSigmoidBCELossNode : public GraphNode {
+ public:
+  WeightedSigmoidBCELossNode(std::string name, GraphNode* X, GraphNode* Y,
+                             GraphNode* W);
+  DEFINE_GRAPH_NODE_LIKE(WeightedSigmoidBCELossNode);
+};
+
 class BatchCELossNode : public GraphNodeBinaryBase {
  public:
   BatchCELossNode(std::string name, GraphNode* X, GraphNode* Y);
@@ -1798,6 +1811,7 @@ DEFINE_GRAPH_NODE_CREATOR(ArgMax)
 DEFINE_GRAPH_NODE_CREATOR(ArgMin)
 DEFINE_GRAPH_NODE_CREATOR(BatchFMInteraction)
 DEFINE_GRAPH_NODE_CREATOR(BatchFMInteraction2)
+DEFINE_GRAPH_NODE_CREATOR(BatchFMInnerProduct)
 DEFINE_GRAPH_NODE_CREATOR(BatchFMQuadratic)
 DEFINE_GRAPH_NODE_CREATOR(BatchGroupFMQuadratic)
 DEFINE_GRAPH_NODE_CREATOR(BatchGroupFMQuadratic2)
@@ -1922,6 +1936,7 @@ DEFINE_GRAPH_NODE_CREATOR(BCELoss)
 DEFINE_GRAPH_NODE_CREATOR(BCELoss2)
 DEFINE_GRAPH_NODE_CREATOR(SigmoidBCELoss)
 DEFINE_GRAPH_NODE_CREATOR(SigmoidBCELoss2)
+DEFINE_GRAPH_NODE_CREATOR(WeightedSigmoidBCELoss)
 DEFINE_GRAPH_NODE_CREATOR(BatchCELoss)
 DEFINE_GRAPH_NODE_CREATOR(BatchCELoss2)
 DEFINE_GRAPH_NODE_CREATOR(BatchSoftmaxCELoss)
@@ -11,6 +11,9 @@ namespace deepx_core {
 struct SimpConfig {
   int max_iteration = 2;
   int use_static_shape = 0;
+  // The simplified graph is used for inference only,
+  // e.g. BatchNorm may be folded into FullyConnect.
+  int inference = 0;
 };
 
 // Simplify graph.
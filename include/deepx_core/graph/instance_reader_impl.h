@@ -6,8 +6,12 @@
 // include all headers needed by instance readers
 #include <deepx_core/common/class_factory.h>
 #include <deepx_core/common/stream.h>
+#include <deepx_core/common/thread_pool.h>
 #include <deepx_core/dx_log.h>
 #include <deepx_core/graph/instance_reader.h>
+#include <cstddef>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace deepx_core {
@@ -22,12 +26,22 @@ namespace deepx_core {
 /************************************************************************/
 /* InstanceReaderImpl */
 /************************************************************************/
+// If 'parse_thread' > 1, a regular local file is parsed in parallel.
+//
+// The file is split into ranges of 'parse_chunk_size' bytes.
+// A range owns the lines beginning in it.
+// 'parse_thread' ranges are parsed by clones of the reader concurrently,
+// into per-range instances, whose rows are appended to batches in order.
+// Batches are the same as those of sequential parsing.
 class InstanceReaderImpl : public InstanceReader {
  protected:
   int batch_ = 32;
   int label_size_ = 1;
   int has_w_ = 0;
   int has_uuid_ = 0;
+  int parse_thread_ = 1;
+  size_t parse_chunk_size_ = 4 * 1024 * 1024;  // magic number
+  StringMap config_;
 
   AutoInputFileStream is_;
   std::string line_;
@@ -35,11 +49,31 @@ class InstanceReaderImpl : public InstanceReader {
   tsr_t* W_ = nullptr;
   tsrs_t* uuid_ = nullptr;
 
+  // parallel parsing
+  struct Range {
+    size_t begin = 0;
+    size_t end = 0;
+    std::string buf;
+    size_t line_begin = 0;
+    int ok = 0;
+    Instance inst;
+  };
+  std::vector<std::unique_ptr<InstanceReaderImpl>> parsers_;
+  std::unique_ptr<ThreadPool> thread_pool_;
+  std::vector<Range> ranges_;
+  size_t range_size_ = 0;
+  int fd_ = -1;
+  size_t file_size_ = 0;
+  size_t offset_ = 0;
+  size_t cur_range_ = 0;
+  int cur_row_ = 0;
+
  public:
+  ~InstanceReaderImpl() override;
   bool InitConfig(const AnyMap& config) override;
   bool InitConfig(const StringMap& config) override;
   bool Open(const std::string& file) override;
-  void Close() noexcept override { is_.Close(); }
+  void Close() noexcept override;
   bool GetBatch(Instance* inst) override;
 
  protected:
@@ -49,6 +83,22 @@ class InstanceReaderImpl : public InstanceReader {
   virtual void InitX(Instance* inst) = 0;
   virtual void InitXBatch(Instance* inst) = 0;
   virtual bool ParseLine() = 0;
+
+ private:
+  bool InitParsers();
+  bool OpenParallel(const std::string& file);
+  bool GetBatchParallel(Instance* inst);
+  // Read the lines beginning in ['range->begin', 'range->end') of the file.
+  bool ReadRange(Range* range) const;
+  // Parse the next 'parse_thread_' ranges.
+  //
+  // Return false at the end of the file.
+  bool ParseRanges();
+  // Parse lines in 'range' to 'range->inst'.
+  void ParseRange(Range* range);
+  // Append rows ['begin', 'end') of 'from' to 'to'.
+  static void AppendRows(const Instance& from, int begin, int end,
+                         Instance* to);
 };
 
 }  // namespace deepx_core
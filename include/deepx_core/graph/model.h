@@ -4,15 +4,16 @@
 
 #pragma once
 #include <deepx_core/common/any_map.h>
+#include <deepx_core/common/chunked_stream.h>
 #include <deepx_core/common/stream.h>
 #include <deepx_core/graph/dist_proto.h>
 #include <deepx_core/graph/graph.h>
 #include <deepx_core/graph/shard.h>
 #include <deepx_core/graph/tensor_map.h>
 #include <deepx_core/tensor/data_type.h>
+#include <deepx_core/tensor/philox.h>
 #include <functional>
 #include <memory>
-#include <random>
 #include <string>
 #include <vector>
 
@@ -27,42 +28,86 @@ class Model : public DataType {
   TensorMap param_;
   int use_lock_ = 0;
   AnyMap param_lock_;
+  int keep_srm_storage_dtype_ = 0;
 
  public:
   const Graph& graph() const noexcept { return *graph_; }
   TensorMap* mutable_param() noexcept { return &param_; }
   const TensorMap& param() const noexcept { return param_; }
   AnyMap* mutable_param_lock() noexcept { return &param_lock_; }
+  // Rows of value type 'srm_t' stored in 16 bits are decoded to 'float_t'
+  // after being read, so that ops can use them,
+  // unless 'keep_srm_storage_dtype' is true.
+  void set_keep_srm_storage_dtype(bool keep_srm_storage_dtype) noexcept {
+    keep_srm_storage_dtype_ = keep_srm_storage_dtype ? 1 : 0;
+  }
+  bool keep_srm_storage_dtype() const noexcept {
+    return keep_srm_storage_dtype_ != 0;
+  }
 
  public:
   void Init(const Graph* graph) noexcept;
   bool InitParamPlaceholder();
-  bool InitParam(std::default_random_engine& engine,  // NOLINT
+  bool InitParam(PhiloxEngine& engine,  // NOLINT
                  const Shard* shard = nullptr, int shard_id = 0);
   void InitLock();
   // backward compatibility
   bool WriteLegacy(OutputStream& os) const;  // NOLINT
   bool Write(OutputStream& os) const;        // NOLINT
+  // Write to a chunked file.
+  //
+  // Rows of value type 'srm_t' are split into row ranges of about
+  // 'chunk_size' bytes, each of which is written as a self-contained chunk.
+  bool WriteChunked(ChunkedOutputFileStream& os,  // NOLINT
+                    size_t chunk_size) const;
   // backward compatibility
   bool ReadLegacy(InputStream& is);  // NOLINT
   bool Read(InputStream& is);        // NOLINT
+  // Read like 'Read', but row ranges are parsed concurrently.
+  //
+  // If 'shard' is not null, only rows of value type 'srm_t' owned by
+  // 'shard_id' are kept, others are dropped as soon as they are read.
+  bool ReadChunked(ChunkedInputFileStream& is,  // NOLINT
+                   const Shard* shard = nullptr, int shard_id = 0);
   // backward compatibility
   bool SaveLegacy(const std::string& file) const;
-  bool Save(const std::string& file) const;
+  // Save to a chunked file if 'chunk_size' > 0.
+  // Compress it by LZ4 if 'compress' is true.
+  bool Save(const std::string& file, size_t chunk_size = 0,
+            bool compress = false) const;
   // backward compatibility
   bool LoadLegacy(const std::string& file);
-  bool Load(const std::string& file);
+  // 'shard' and 'shard_id' are the same as 'ReadChunked'.
+  bool Load(const std::string& file, const Shard* shard = nullptr,
+            int shard_id = 0);
   bool SaveText(const std::string& file) const;
   bool SaveFeatureKV(const std::string& file,
                      int feature_kv_protocol_version) const;
+  // An empty 'srm_t' takes the storage dtype of that of 'other'.
   void Merge(Model* other, const Shard* shard = nullptr, int shard_id = 0);
 
  public:
   bool HasSRM() const noexcept;
   void RemoveZerosSRM();
   void ForEachSRM(const std::function<void(const std::string&, srm_t*)>& func);
+  // Call 'set_storage_dtype' for value type 'srm_t'.
+  void SetSRMStorageDtype(int storage_dtype);
+  // Quantize params to int8 for inference, return the number of quantized
+  // params.
+  //
+  // A 'tsr_t' is quantized to 'qtsr_t' with per channel scales, if it is only
+  // used as W of 'FullyConnectNode'.
+  // A 'srm_t' is quantized to 'qsrm_t' with per row scales, if it is only used
+  // as W of 'EmbeddingLookupNode', 'GroupEmbeddingLookupNode' or
+  // 'GroupEmbeddingLookup2Node', and its embedding size is at least
+  // 'QUANTIZE_MIN_COL'.
+  //
+  // Ops of these nodes predict with quantized params, but they can't be
+  // trained, and quantized params are not supported by 'Pull' in shard mode.
+  int Quantize();
+  static constexpr int QUANTIZE_MIN_COL = 4;
   // thread safe after 'InitLock'
-  void Pull(std::default_random_engine& engine,  // NOLINT
+  void Pull(PhiloxEngine& engine,  // NOLINT
             const PullRequest& pull_request, TensorMap* remote_param);
   void SetParam(std::vector<std::unique_ptr<TensorMap>>* remote_params);
   // thread safe after 'InitLock'
@@ -79,6 +124,16 @@ class Model : public DataType {
   void Reduce(Model* other, const tsr_reduce_func_t& tsr_reduce_func,
               const srm_reduce_func_t& srm_reduce_func,
               const Shard* shard = nullptr, int shard_id = 0);
+  bool ReadHeader(InputStream& is, int* range_size,  // NOLINT
+                  const Shard* shard = nullptr, int shard_id = 0);
+  void PullHalf(PhiloxEngine& engine,  // NOLINT
+                const std::string& name, bool is_train, const id_set_t& id_set,
+                srm_t* local_W, srm_t* remote_W);
+  bool MergeRange(const std::string& name, srm_t* range,
+                  const Shard* shard = nullptr, int shard_id = 0);
+  // Salt random initial values of rows of value type 'srm_t' by their names,
+  // so that SRMs are not initialized identically for the same ids.
+  void InitSRMSalt();
 };
 
 }  // namespace deepx_core
@@ -15,9 +15,9 @@
 #include <deepx_core/graph/tensor_map.h>
 #include <deepx_core/graph/ts_store.h>
 #include <deepx_core/tensor/data_type.h>
+#include <deepx_core/tensor/philox.h>
 #include <functional>
 #include <memory>
-#include <random>
 #include <string>
 #include <vector>
 
@@ -28,9 +28,12 @@ namespace deepx_core {
 /************************************************************************/
 class ModelShard : public DataType {
  private:
-  std::default_random_engine engine_;
+  PhiloxEngine engine_;
   const Shard* shard_ = nullptr;
   int shard_id_ = 0;
+  size_t chunk_size_ = 0;
+  int compress_ = 0;
+  int keep_srm_storage_dtype_ = 0;
   const Graph* graph_ = nullptr;
   std::unique_ptr<Model> model_;
   std::unique_ptr<Optimizer> optimizer_;
@@ -42,11 +45,33 @@ class ModelShard : public DataType {
  public:
   template <typename Int>
   void seed(Int s) {
-    engine_.seed((std::default_random_engine::result_type)s);
+    engine_.seed((uint64_t)s);
   }
-  std::default_random_engine& engine() noexcept { return engine_; }
+  // Call it after 'seed'.
+  template <typename Int>
+  void seed_keyed(Int s) {
+    engine_.seed_keyed((uint64_t)s);
+  }
+  PhiloxEngine& engine() noexcept { return engine_; }
   const Shard& shard() const noexcept { return *shard_; }
   int shard_id() const noexcept { return shard_id_; }
+  // If 'chunk_size' > 0, 'SaveModel', 'SaveOptimizer', 'SaveTSStore' and
+  // 'SaveFreqStore' write chunked files in parallel.
+  void set_chunk_size(size_t chunk_size) noexcept { chunk_size_ = chunk_size; }
+  size_t chunk_size() const noexcept { return chunk_size_; }
+  // If 'compress' is true, they compress files by LZ4,
+  // chunked files are decompressed in parallel when loaded.
+  void set_compress(bool compress) noexcept { compress_ = compress ? 1 : 0; }
+  bool compress() const noexcept { return compress_ != 0; }
+  // If 'keep_srm_storage_dtype' is true, models loaded by 'LoadModel*' and
+  // 'WarmupModel*' keep rows of value type 'srm_t' stored in 16 bits,
+  // see 'Model::set_keep_srm_storage_dtype'.
+  void set_keep_srm_storage_dtype(bool keep_srm_storage_dtype) noexcept {
+    keep_srm_storage_dtype_ = keep_srm_storage_dtype ? 1 : 0;
+  }
+  bool keep_srm_storage_dtype() const noexcept {
+    return keep_srm_storage_dtype_ != 0;
+  }
   const Graph& graph() const noexcept { return *graph_; }
   Model* mutable_model() noexcept { return model_.get(); }
   const Model& model() const noexcept { return *model_; }
@@ -165,6 +190,25 @@ class ModelShard : public DataType {
   int GetShardStatusLegacy(const std::string& dir, Shard* remote_shard) const;
   int GetShardStatus(const std::string& dir, Shard* remote_shard) const;
 
+  // max number of threads to load remote shards
+  static constexpr int MAX_LOAD_THREAD = 4;
+
+  // Return ids of remote shards which may own parameters of this shard.
+  std::vector<int> GetRemoteShardIds(const Shard& remote_shard) const;
+
+  // Load remote shards 'remote_shard_ids' in parallel and merge them.
+  //
+  // 'load_func(remote_shard_id, T*)' loads a remote shard, it is called
+  // concurrently.
+  // 'merge_func(T*)' merges a loaded remote shard, keeping only parameters of
+  // this shard, it is called serially.
+  //
+  // A remote shard is freed right after it is merged, so at most
+  // 'MAX_LOAD_THREAD' remote shards are in memory.
+  template <class T, class LoadFunc, class MergeFunc>
+  static bool LoadRemoteShards(const std::vector<int>& remote_shard_ids,
+                               LoadFunc&& load_func, MergeFunc&& merge_func);
+
  public:
   // backward compatibility
   bool LoadModelLegacy(const std::string& dir);
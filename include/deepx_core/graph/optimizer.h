@@ -54,7 +54,10 @@ class Optimizer : public DataType {
 std::unique_ptr<Optimizer> NewOptimizer(const std::string& name);
 // backward compatibility
 bool SaveOptimizerLegacy(const std::string& file, const Optimizer& optimizer);
-bool SaveOptimizer(const std::string& file, const Optimizer& optimizer);
+// Save to a chunked file if 'chunk_size' > 0.
+// Compress it by LZ4 if 'compress' is true.
+bool SaveOptimizer(const std::string& file, const Optimizer& optimizer,
+                   size_t chunk_size = 0, bool compress = false);
 // backward compatibility
 std::unique_ptr<Optimizer> LoadOptimizerLegacy(const std::string& file);
 std::unique_ptr<Optimizer> LoadOptimizer(const std::string& file);
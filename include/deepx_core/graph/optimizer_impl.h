@@ -8,6 +8,8 @@
 #include <deepx_core/common/read_write_lock.h>
 #include <deepx_core/dx_log.h>
 #include <deepx_core/graph/optimizer.h>
+#include <deepx_core/tensor/philox.h>
+#include <atomic>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -240,6 +242,17 @@ class OptimizerImpl : public Optimizer {
                              OptimizerSRMSlot* slot) const = 0;
 
  private:
+  // seeds of engines rounding rows in 16 bits
+  std::atomic<uint64_t> round_seed_{0};
+
+ private:
+  // Update rows of 'W' stored in 16 bits.
+  //
+  // They are decoded to 'float_t', updated by 'UpdateSRM2SRM',
+  // and converted back rounding stochastically,
+  // so that small updates are not lost on average.
+  void UpdateHalfSRM2SRM(const std::string& name, const srm_t& G, srm_t* W,
+                         OptimizerSRMSlot* slot);
   using config_reduce_func_t = std::function<void(StringMap&, StringMap&)>;
   using tsr_reduce_func_t =
       std::function<void(const std::string&, tsr_t&, tsr_t&)>;
@@ -6,6 +6,7 @@
 #pragma once
 #include <deepx_core/common/stream.h>
 #include <deepx_core/tensor/data_type.h>
+#include <cstdint>
 #include <string>
 
 namespace deepx_core {
@@ -24,6 +25,10 @@ bool LoadShard(const std::string& dir, Shard* shard);
 /* Shard */
 /************************************************************************/
 class Shard : public DataType {
+ public:
+  // number of virtual buckets of the "bucket" shard func
+  static constexpr int BUCKET_SIZE = 65536;
+
  private:
   // 0, non-shard mode
   // 1, shard mode
@@ -76,6 +81,28 @@ class Shard : public DataType {
   bool HasSRM(int shard_id, int_t id) const noexcept {
     return srm_shard_func_(id, shard_size_) == shard_id;
   }
+
+  // Return if shard 'shard_id' may own any parameter owned by
+  // shard 'other_shard_id' of 'other'.
+  //
+  // When a model saved with 'other' is loaded with this shard,
+  // shard files which do not overlap can be skipped.
+  bool Overlap(int shard_id, const Shard& other, int other_shard_id) const;
+
+  // Return the shard id of 'bucket' among 'shard_size' shards.
+  static int GetBucketShardId(int bucket, int shard_size) noexcept {
+    return (int)((int64_t)bucket * shard_size / BUCKET_SIZE);
+  }
+
+  // Get the bucket range ['begin', 'end') of shard 'shard_id'
+  // among 'shard_size' shards.
+  static void GetBucketRange(int shard_id, int shard_size, int* begin,
+                             int* end) noexcept {
+    *begin = (int)(((int64_t)shard_id * BUCKET_SIZE + shard_size - 1) /
+                   shard_size);
+    *end = (int)(((int64_t)(shard_id + 1) * BUCKET_SIZE + shard_size - 1) /
+                 shard_size);
+  }
 };
 
 }  // namespace deepx_core
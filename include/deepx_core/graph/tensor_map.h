@@ -6,8 +6,8 @@
 #include <deepx_core/common/any_map.h>
 #include <deepx_core/common/stream.h>
 #include <deepx_core/tensor/data_type.h>
+#include <deepx_core/tensor/philox.h>
 #include <iostream>
-#include <random>
 #include <utility>
 
 namespace deepx_core {
@@ -71,16 +71,16 @@ std::ostream& operator<<(std::ostream& os, const Instance& inst);
 /************************************************************************/
 class Hidden : public TensorMap {
  private:
-  std::default_random_engine engine_;
+  PhiloxEngine engine_;
   float_t* loss_ = nullptr;
   Instance inst_;
 
  public:
   template <typename Int>
   void seed(Int s) {
-    engine_.seed((std::default_random_engine::result_type)s);
+    engine_.seed((uint64_t)s);
   }
-  std::default_random_engine& engine() noexcept { return engine_; }
+  PhiloxEngine& engine() noexcept { return engine_; }
   void clear_loss() noexcept { loss_ = nullptr; }
   void set_loss(float_t* loss) noexcept { loss_ = loss; }
   bool has_loss() const noexcept { return loss_ != nullptr; }
@@ -47,7 +47,10 @@ class TSStore : public DataType {
   bool Read(InputStream& is);        // NOLINT
   // backward compatibility
   bool SaveLegacy(const std::string& file) const;
-  bool Save(const std::string& file) const;
+  // Save to a chunked file if 'chunk_size' > 0.
+  // Compress it by LZ4 if 'compress' is true.
+  bool Save(const std::string& file, size_t chunk_size = 0,
+            bool compress = false) const;
   // backward compatibility
   bool LoadLegacy(const std::string& file);
   bool Load(const std::string& file);
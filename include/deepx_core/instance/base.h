@@ -79,7 +79,7 @@ bool InstanceReaderHelper<T, I>::ParseLabelWeight() noexcept {
   }
 
   // label
-  label_ = (float_t)fast_strtod(s_, &end);
+  label_ = (float_t)fast_strtod(s_, line_end_, &end);
   if (s_ == end) {
     DXERROR("Invalid label: %s.", line_.c_str());
     return false;
@@ -102,7 +102,7 @@ bool InstanceReaderHelper<T, I>::ParseLabelWeight() noexcept {
     // weight
     s_ = end + 1;
 
-    weight_ = (float_t)fast_strtod(s_, &end);
+    weight_ = (float_t)fast_strtod(s_, line_end_, &end);
     if (s_ == end) {
       DXERROR("Invalid weight: %s.", line_.c_str());
       return false;
@@ -166,7 +166,7 @@ bool InstanceReaderHelper<T, I>::ParseFeatures(csr_t* X, char sep) {
     }
 
     // feature id
-    feature_id = fast_strtoi<int_t>(s_, &end);
+    feature_id = fast_strtoi<int_t>(s_, line_end_, &end);
     if (s_ == end) {
       DXERROR("Invalid feature id: %s.", line_.c_str());
       return false;
@@ -191,7 +191,7 @@ bool InstanceReaderHelper<T, I>::ParseFeatures(csr_t* X, char sep) {
       // feature value
       s_ = end + 1;
 
-      feature_value = (float_t)fast_strtod(s_, &end);
+      feature_value = (float_t)fast_strtod(s_, line_end_, &end);
       if (s_ == end) {
         DXERROR("Invalid feature value: %s.", line_.c_str());
         return false;
@@ -154,6 +154,24 @@ class DistMessage {
 OutputStringStream& operator<<(OutputStringStream& os,
                                const DistMessage& message);
 
+/************************************************************************/
+/* DistMessageSegments */
+/************************************************************************/
+// A serialized 'DistMessage' in 2 segments,
+// its payload buf is referenced in place instead of being copied.
+//
+// 'head' + 'payload' equals the output of 'os << message'.
+struct DistMessageSegments {
+  std::string head;
+  const_string_view payload;
+
+  size_t size() const noexcept { return head.size() + payload.size(); }
+};
+
+// 'segments' is valid until the payload buf of 'message' is modified.
+void SerializeSegments(const DistMessage& message,
+                       DistMessageSegments* segments);
+
 /************************************************************************/
 /* DistMessageView */
 /************************************************************************/
@@ -7,25 +7,71 @@
 #include <deepx_core/common/stream.h>
 #include <deepx_core/ps/dist_message.h>
 #include <asio.hpp>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
+#include <system_error>
 #include <vector>
 
 namespace deepx_core {
 
 using IoContext = asio::io_context;
 using IpAddress = asio::ip::address;
-using TcpEndpoint = asio::ip::tcp::endpoint;
-using TcpSocket = asio::ip::tcp::socket;
+// Sockets and acceptors are generic, so that tcp and unix domain endpoints
+// share the same connections and servers.
+using TcpSocket = asio::generic::stream_protocol::socket;
 using MutableBuffers = asio::mutable_buffers_1;
-using TcpAcceptor = asio::ip::tcp::acceptor;
+// head and payload of a 'DistMessageSegments'
+using ConstBuffers = std::array<asio::const_buffer, 2>;
+using TcpAcceptor = asio::basic_socket_acceptor<asio::generic::stream_protocol>;
 using TcpNoDelay = asio::ip::tcp::no_delay;
 using SteadyTimer = asio::steady_timer;
 
+/************************************************************************/
+/* TcpEndpoint */
+/************************************************************************/
+// A tcp endpoint, or a unix domain socket endpoint for co-located peers.
+//
+// Unix domain socket endpoints are only supported on POSIX systems.
+class TcpEndpoint : public asio::generic::stream_protocol::endpoint {
+ private:
+  using base_t = asio::generic::stream_protocol::endpoint;
+  using ip_endpoint_t = asio::ip::tcp::endpoint;
+#if OS_POSIX == 1
+  using unix_endpoint_t = asio::local::stream_protocol::endpoint;
+#endif
+
+ public:
+  TcpEndpoint() : base_t(ip_endpoint_t()) {}
+  TcpEndpoint(const base_t& other) : base_t(other) {}  // NOLINT
+  TcpEndpoint(const ip_endpoint_t& other) : base_t(other) {}  // NOLINT
+#if OS_POSIX == 1
+  TcpEndpoint(const unix_endpoint_t& other) : base_t(other) {}  // NOLINT
+#endif
+
+ public:
+#if OS_POSIX == 1
+  bool is_unix() const noexcept { return data()->sa_family == AF_UNIX; }
+#else
+  bool is_unix() const noexcept { return false; }
+#endif
+  // Only for tcp endpoints.
+  ip_endpoint_t to_tcp() const;
+  IpAddress address() const { return to_tcp().address(); }
+  uint16_t port() const { return to_tcp().port(); }
+  // Only for unix domain socket endpoints.
+  std::string path() const;
+};
+
 /************************************************************************/
 /* TcpEndpoint functions */
 /************************************************************************/
 TcpEndpoint MakeTcpEndpoint(const std::string& ip, int port);
+// 'addr' is "ip:port", or "unix:path" for a unix domain socket on POSIX
+// systems.
 TcpEndpoint MakeTcpEndpoint(const std::string& addr);
 std::vector<TcpEndpoint> MakeTcpEndpoints(const std::string& addrs);
 std::string to_string(const TcpEndpoint& endpoint);
@@ -48,9 +94,11 @@ class TcpConnection {
   InputStringStream in_stream_;
   // bytes read for current message
   size_t in_bytes_ = 0;
+  size_t last_packet_bytes_ = 0;
 
   DistMessage out_message_;
-  OutputStringStream out_stream_;
+  // The payload of 'out_message_' is written in place.
+  DistMessageSegments out_segments_;
   // bytes written for current message
   size_t out_bytes_ = 0;
 
@@ -83,8 +131,9 @@ class TcpConnection {
   void Close();
   void Reset();
   MutableBuffers GetInBuf();
+  // 'out_message_' must not be modified until it has been written.
   void PrepareOutBuf();
-  MutableBuffers GetOutBuf();
+  ConstBuffers GetOutBuf() const noexcept;
 
   // 'in_bytes' bytes has been read,
   // try to deserialize data to 'in_message_'.
@@ -153,9 +202,23 @@ class TcpConnection {
 /* TcpConnections */
 /************************************************************************/
 class TcpConnections : public std::vector<std::unique_ptr<TcpConnection>> {
+ public:
+  using callback_t = std::function<void(size_t i)>;
+
  private:
   IoContext* const io_;
 
+  // states of the running 'RpcAsync'
+  int async_type_ = 0;
+  const callback_t* async_callback_ = nullptr;
+  int async_error_ = 0;
+  std::vector<std::chrono::steady_clock::time_point> async_begin_;
+  // latencies of the last 'RpcAsync' in nanoseconds
+  std::vector<double> latencies_;
+
+ public:
+  const std::vector<double>& latencies() const noexcept { return latencies_; }
+
  public:
   explicit TcpConnections(IoContext* io);
   ~TcpConnections();
@@ -191,6 +254,38 @@ class TcpConnections : public std::vector<std::unique_ptr<TcpConnection>> {
   int RpcUserRequest(const std::vector<int>* masks = nullptr);
   int RpcUserResponse(const std::vector<int>* masks = nullptr);
   int RpcUserNotify(const std::vector<int>* masks = nullptr);
+
+ public:
+  // Async rpc client functions.
+  //
+  // Requests are written to all connections concurrently,
+  // responses are read concurrently.
+  // 'callback' is called with the index of a connection once its rpc
+  // completes(its response has been read or its notification has been
+  // written), i.e. in completion order,
+  // so that a response can be processed while others are still in flight.
+  //
+  // 'io_' is run by the calling thread, it must not be run by other threads.
+  //
+  // Per connection latencies from writing the request to reading the
+  // response(or writing the notification) are recorded to 'latencies_',
+  // 0 for masked connections.
+  //
+  // Return 0, success.
+  // Return -1, error.
+  int RpcAsync(int type, const std::vector<int>* masks = nullptr,
+               const callback_t& callback = callback_t());
+  int RpcPullRequestAsync(const std::vector<int>* masks = nullptr,
+                          const callback_t& callback = callback_t());
+  int RpcPushNotifyAsync(const std::vector<int>* masks = nullptr);
+
+ private:
+  void AsyncWrite(size_t i);
+  void OnWrite(size_t i, size_t out_bytes);
+  void AsyncRead(size_t i);
+  void OnRead(size_t i, size_t in_bytes);
+  void OnRpcAsync(size_t i);
+  void OnRpcAsyncError(size_t i, const char* op, const std::error_code& ec);
 };
 
 }  // namespace deepx_core
@@ -79,6 +79,8 @@ class CSRMatrix {
   inline void add_row();
   inline void emplace(int_t col, float_t value);
   inline void trim(size_t value_size);
+  // Append rows ['begin_row', 'end_row') of 'other'.
+  void append(const CSRMatrix& other, int begin_row, int end_row);
 
  public:
   // comparison
@@ -199,6 +201,22 @@ inline void CSRMatrix<T, I>::trim(size_t value_size) {
   value_.erase(value_.begin() + value_size, value_.end());
 }
 
+template <typename T, typename I>
+void CSRMatrix<T, I>::append(const CSRMatrix& other, int begin_row,
+                             int end_row) {
+  int col_begin = other.row_offset_[begin_row];
+  int col_end = other.row_offset_[end_row];
+  int offset = (int)col_.size() - col_begin;
+  for (int i = begin_row + 1; i <= end_row; ++i) {
+    row_offset_.emplace_back(other.row_offset_[i] + offset);
+  }
+  col_.insert(col_.end(), other.col_.begin() + col_begin,
+              other.col_.begin() + col_end);
+  value_.insert(value_.end(), other.value_.begin() + col_begin,
+                other.value_.begin() + col_end);
+  row_ += end_row - begin_row;
+}
+
 template <typename T, typename I>
 bool CSRMatrix<T, I>::operator==(const CSRMatrix& right) const noexcept {
   return row_ == right.row_ && row_offset_ == right.row_offset_ &&
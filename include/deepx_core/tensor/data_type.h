@@ -6,6 +6,8 @@
 #include <deepx_core/tensor/csr_matrix.h>
 #include <deepx_core/tensor/ll_math.h>
 #include <deepx_core/tensor/ll_tensor.h>
+#include <deepx_core/tensor/quantized_sparse_row_matrix.h>
+#include <deepx_core/tensor/quantized_tensor.h>
 #include <deepx_core/tensor/sparse_row_matrix.h>
 #include <deepx_core/tensor/tensor.h>
 #include <cstdint>
@@ -29,6 +31,8 @@ class DataTypeT {
   using csr_t = CSRMatrix<float_t, int_t>;
   using tsri_t = Tensor<int_t>;
   using tsrs_t = Tensor<std::string>;
+  using qtsr_t = QuantizedTensor<float_t>;
+  using qsrm_t = QuantizedSparseRowMatrix<float_t, int_t>;
   using ll_math_t = LLMath<float_t>;
   using ll_tensor_t = LLTensor<float_t>;
   using ll_sparse_tensor_t = LLSparseTensor<float_t, int_t>;
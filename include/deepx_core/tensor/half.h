@@ -0,0 +1,183 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#pragma once
+#include <deepx_core/tensor/tensor_type.h>
+#include <cstdint>
+#include <cstring>  // memcpy
+
+namespace deepx_core {
+
+// Reduced precision floats are stored as uint16_t.
+//
+// TENSOR_DTYPE_FLOAT16 is IEEE 754 binary16,
+// 1 sign bit, 5 exponent bits and 10 mantissa bits.
+//
+// TENSOR_DTYPE_BFLOAT16 is the upper half of binary32,
+// 1 sign bit, 8 exponent bits and 7 mantissa bits.
+//
+// Conversions from float round to nearest even,
+// or round stochastically with random bits 'r'.
+// With stochastic rounding, x rounds up with probability equal to its
+// distance from the value below, so that the rounding is unbiased.
+
+namespace detail {
+
+inline uint32_t FloatBits(float f) noexcept {
+  uint32_t x;
+  memcpy(&x, &f, sizeof(x));
+  return x;
+}
+
+inline float BitsFloat(uint32_t x) noexcept {
+  float f;
+  memcpy(&f, &x, sizeof(f));
+  return f;
+}
+
+// Drop 'shift' low bits of 'm', round to nearest even if 'stochastic' is 0,
+// otherwise round up if the dropped bits are greater than the random bits.
+inline uint32_t HalfRoundBits(uint32_t m, int shift, int stochastic,
+                              uint32_t r) noexcept {
+  if (shift >= 32) {
+    return 0;
+  }
+  uint32_t mask = (1u << shift) - 1;
+  uint32_t rem = m & mask;
+  uint32_t h = m >> shift;
+  if (stochastic) {
+    h += (r & mask) < rem;
+  } else {
+    uint32_t half = 1u << (shift - 1);
+    h += (rem > half) || (rem == half && (h & 1));
+  }
+  return h;
+}
+
+inline uint16_t FloatToBF16(float f, int stochastic, uint32_t r) noexcept {
+  uint32_t x = FloatBits(f);
+  if ((x & 0x7fffffff) > 0x7f800000) {
+    return (uint16_t)((x >> 16) | 0x40);  // quiet NaN
+  }
+  if ((x & 0x7fffffff) == 0x7f800000) {
+    return (uint16_t)(x >> 16);  // Inf
+  }
+  // A carry out of the mantissa increments the exponent.
+  return (uint16_t)HalfRoundBits(x, 16, stochastic, r);
+}
+
+inline uint16_t FloatToFP16(float f, int stochastic, uint32_t r) noexcept {
+  uint32_t x = FloatBits(f);
+  uint32_t sign = (x >> 16) & 0x8000;
+  uint32_t a = x & 0x7fffffff;
+  if (a > 0x7f800000) {
+    return (uint16_t)(sign | 0x7e00);  // quiet NaN
+  }
+
+  int e = (int)(a >> 23) - 127 + 15;
+  if (e >= 31) {
+    return (uint16_t)(sign | 0x7c00);  // Inf
+  }
+
+  uint32_t h;
+  if (e <= 0) {
+    // subnormal, the implicit leading 1 is kept in the mantissa
+    uint32_t m = (a & 0x7fffff) | 0x800000;
+    h = HalfRoundBits(m, 14 - e, stochastic, r);
+  } else {
+    // A carry out of the mantissa increments the exponent,
+    // it may overflow to Inf.
+    uint32_t m = ((uint32_t)e << 23) | (a & 0x7fffff);
+    h = HalfRoundBits(m, 13, stochastic, r);
+  }
+  return (uint16_t)(sign | h);
+}
+
+}  // namespace detail
+
+inline bool IsHalfDtype(int dtype) noexcept {
+  return dtype == TENSOR_DTYPE_FLOAT16 || dtype == TENSOR_DTYPE_BFLOAT16;
+}
+
+inline uint16_t FloatToBF16(float f) noexcept {
+  return detail::FloatToBF16(f, 0, 0);
+}
+
+inline uint16_t FloatToBF16(float f, uint32_t r) noexcept {
+  return detail::FloatToBF16(f, 1, r);
+}
+
+inline float BF16ToFloat(uint16_t h) noexcept {
+  return detail::BitsFloat((uint32_t)h << 16);
+}
+
+inline uint16_t FloatToFP16(float f) noexcept {
+  return detail::FloatToFP16(f, 0, 0);
+}
+
+inline uint16_t FloatToFP16(float f, uint32_t r) noexcept {
+  return detail::FloatToFP16(f, 1, r);
+}
+
+inline float FP16ToFloat(uint16_t h) noexcept {
+  uint32_t sign = ((uint32_t)h & 0x8000) << 16;
+  uint32_t e = ((uint32_t)h >> 10) & 0x1f;
+  uint32_t m = (uint32_t)h & 0x3ff;
+  if (e == 0) {
+    // zero or subnormal, m * 2^-24
+    float f = (float)m * 5.9604644775390625e-8f;  // magic number
+    return detail::BitsFloat(sign | detail::FloatBits(f));
+  }
+  if (e == 31) {
+    return detail::BitsFloat(sign | 0x7f800000 | (m << 13));
+  }
+  return detail::BitsFloat(sign | ((e + 127 - 15) << 23) | (m << 13));
+}
+
+// Convert 'n' elements of 'X' to 'dtype'.
+template <typename T>
+void HalfEncode(int dtype, int n, const T* X, uint16_t* Y) noexcept {
+  if (dtype == TENSOR_DTYPE_BFLOAT16) {
+    for (int i = 0; i < n; ++i) {
+      Y[i] = FloatToBF16((float)X[i]);
+    }
+  } else {
+    for (int i = 0; i < n; ++i) {
+      Y[i] = FloatToFP16((float)X[i]);
+    }
+  }
+}
+
+// Convert 'n' elements of 'X' from 'dtype'.
+template <typename T>
+void HalfDecode(int dtype, int n, const uint16_t* X, T* Y) noexcept {
+  if (dtype == TENSOR_DTYPE_BFLOAT16) {
+    for (int i = 0; i < n; ++i) {
+      Y[i] = (T)BF16ToFloat(X[i]);
+    }
+  } else {
+    for (int i = 0; i < n; ++i) {
+      Y[i] = (T)FP16ToFloat(X[i]);
+    }
+  }
+}
+
+// Convert 'n' elements of 'X' to 'dtype', rounding stochastically.
+//
+// 'engine' generates at least 24 random bits.
+template <typename T, class RandomEngine>
+void HalfEncode(int dtype, RandomEngine&& engine, int n, const T* X,
+                uint16_t* Y) {
+  if (dtype == TENSOR_DTYPE_BFLOAT16) {
+    for (int i = 0; i < n; ++i) {
+      Y[i] = FloatToBF16((float)X[i], (uint32_t)engine());
+    }
+  } else {
+    for (int i = 0; i < n; ++i) {
+      Y[i] = FloatToFP16((float)X[i], (uint32_t)engine());
+    }
+  }
+}
+
+}  // namespace deepx_core
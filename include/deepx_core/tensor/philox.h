@@ -0,0 +1,435 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstring>  // memcpy
+#include <random>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace deepx_core {
+
+/************************************************************************/
+/* Philox4x32-10 */
+/************************************************************************/
+// Philox4x32-10 is a counter-based random number generator,
+// "Parallel random numbers: as easy as 1, 2, 3", Salmon et al. 2011.
+//
+// A block of 4 random words is a pure function of a 64-bit key and
+// a 128-bit counter, blocks are independent of each other,
+// so that they can be generated in any order and in parallel.
+
+constexpr uint32_t PHILOX_M0 = 0xd2511f53;  // magic number
+constexpr uint32_t PHILOX_M1 = 0xcd9e8d57;  // magic number
+constexpr uint32_t PHILOX_W0 = 0x9e3779b9;  // magic number
+constexpr uint32_t PHILOX_W1 = 0xbb67ae85;  // magic number
+constexpr int PHILOX_ROUNDS = 10;           // magic number
+
+// Generate a block of 4 words 'out' for counter 'ctr' and key 'key'.
+inline void Philox4x32(const uint32_t ctr[4], uint64_t key,
+                       uint32_t out[4]) noexcept {
+  uint32_t c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+  uint32_t k0 = (uint32_t)key, k1 = (uint32_t)(key >> 32);
+  for (int r = 0; r < PHILOX_ROUNDS; ++r) {
+    uint64_t p0 = (uint64_t)PHILOX_M0 * c0;
+    uint64_t p1 = (uint64_t)PHILOX_M1 * c2;
+    c0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+    c1 = (uint32_t)p1;
+    c2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+    c3 = (uint32_t)p0;
+    k0 += PHILOX_W0;
+    k1 += PHILOX_W1;
+  }
+  out[0] = c0;
+  out[1] = c1;
+  out[2] = c2;
+  out[3] = c3;
+}
+
+// Generate 'blocks' blocks of 4 words 'out' for key 'key' and
+// counters ('counter' + i, 'stream'), i = 0, 1, ..., 'blocks' - 1.
+inline void PhiloxFill(uint64_t key, uint64_t stream, uint64_t counter,
+                       int blocks, uint32_t* out) noexcept {
+  int i = 0;
+#if defined(__AVX2__)
+  constexpr int LANE = 8;  // magic number
+  const __m256i m0 = _mm256_set1_epi32((int)PHILOX_M0);
+  const __m256i m1 = _mm256_set1_epi32((int)PHILOX_M1);
+  // 8 blocks are generated at a time, word j of them are in vj.
+  //
+  // 'mulhilo' computes high and low words of 32-bit products,
+  // from 64-bit products of even and odd lanes.
+  auto mulhilo = [](__m256i a, __m256i m, __m256i* hi, __m256i* lo) {
+    __m256i even = _mm256_mul_epu32(a, m);
+    __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), m);
+    *hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xaa);
+    *lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xaa);
+  };
+  const __m256i iota = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  const __m256i sign = _mm256_set1_epi32((int)0x80000000);
+  // A partial group of at least 4 blocks is still faster than scalar code.
+  for (; i + 3 < blocks; i += LANE) {
+    // counters, a carry is propagated from low words to high words
+    uint64_t c = counter + (uint64_t)i;
+    __m256i c_lo = _mm256_set1_epi32((int)(uint32_t)c);
+    __m256i v0 = _mm256_add_epi32(c_lo, iota);
+    __m256i carry = _mm256_cmpgt_epi32(_mm256_xor_si256(c_lo, sign),
+                                       _mm256_xor_si256(v0, sign));
+    __m256i v1 =
+        _mm256_sub_epi32(_mm256_set1_epi32((int)(uint32_t)(c >> 32)), carry);
+    __m256i v2 = _mm256_set1_epi32((int)(uint32_t)stream);
+    __m256i v3 = _mm256_set1_epi32((int)(uint32_t)(stream >> 32));
+    uint32_t k0 = (uint32_t)key, k1 = (uint32_t)(key >> 32);
+    for (int r = 0; r < PHILOX_ROUNDS; ++r) {
+      __m256i hi0, lo0, hi1, lo1;
+      mulhilo(v0, m0, &hi0, &lo0);
+      mulhilo(v2, m1, &hi1, &lo1);
+      v0 = _mm256_xor_si256(_mm256_xor_si256(hi1, v1),
+                            _mm256_set1_epi32((int)k0));
+      v1 = lo1;
+      v2 = _mm256_xor_si256(_mm256_xor_si256(hi0, v3),
+                            _mm256_set1_epi32((int)k1));
+      v3 = lo0;
+      k0 += PHILOX_W0;
+      k1 += PHILOX_W1;
+    }
+
+    // transpose to blocks
+    __m256i t0 = _mm256_unpacklo_epi32(v0, v1);
+    __m256i t1 = _mm256_unpackhi_epi32(v0, v1);
+    __m256i t2 = _mm256_unpacklo_epi32(v2, v3);
+    __m256i t3 = _mm256_unpackhi_epi32(v2, v3);
+    __m256i b04 = _mm256_unpacklo_epi64(t0, t2);
+    __m256i b15 = _mm256_unpackhi_epi64(t0, t2);
+    __m256i b26 = _mm256_unpacklo_epi64(t1, t3);
+    __m256i b37 = _mm256_unpackhi_epi64(t1, t3);
+    __m256i b[4];  // 2 blocks each
+    b[0] = _mm256_permute2x128_si256(b04, b15, 0x20);
+    b[1] = _mm256_permute2x128_si256(b26, b37, 0x20);
+    b[2] = _mm256_permute2x128_si256(b04, b15, 0x31);
+    b[3] = _mm256_permute2x128_si256(b26, b37, 0x31);
+    int group = (blocks - i < LANE) ? blocks - i : LANE;
+    uint32_t* block = out + (size_t)i * 4;
+    for (int j = 0; j < 4; ++j) {
+      if (2 * j + 2 <= group) {
+        _mm256_storeu_si256((__m256i*)(block + 8 * j), b[j]);
+      } else if (2 * j + 1 == group) {
+        _mm_storeu_si128((__m128i*)(block + 8 * j),
+                         _mm256_castsi256_si128(b[j]));
+      }
+    }
+  }
+#endif
+  uint32_t ctr[4];
+  ctr[2] = (uint32_t)stream;
+  ctr[3] = (uint32_t)(stream >> 32);
+  for (; i < blocks; ++i) {
+    uint64_t c = counter + (uint64_t)i;
+    ctr[0] = (uint32_t)c;
+    ctr[1] = (uint32_t)(c >> 32);
+    Philox4x32(ctr, key, out + (size_t)i * 4);
+  }
+}
+
+// Map a word to a uniform real value in (0, 1).
+template <typename T>
+T PhiloxUniform(uint32_t x) noexcept {
+  // 23 bits + 0.5 is exact in float, 1 is never reached.
+  return (T)(((float)(x >> 9) + 0.5f) * 1.1920928955078125e-07f);
+}
+
+// Keyed generators use a different key from sequential ones.
+constexpr uint64_t PHILOX_KEYED_KEY_MASK =
+    0x9e3779b97f4a7c15;                  // magic number
+constexpr int PHILOX_CHUNK_WORDS = 256;  // magic number
+
+/************************************************************************/
+/* PhiloxEngine */
+/************************************************************************/
+// A random engine satisfying UniformRandomBitGenerator,
+// it can be used with distributions in <random>.
+//
+// Besides, it has bulk generators of uniform and normal values.
+//
+// Sequential generators consume counters of the engine.
+// Keyed generators are pure functions of the keyed seed and 'id',
+// they are used to initialize rows of 'SparseRowMatrix',
+// so that initial values of a row do not depend on the order rows arrive.
+//
+// 'seed' sets both seeds, 'seed_keyed' sets the keyed seed only.
+// Engines of different shards have different seeds,
+// but should share the keyed seed,
+// so that initial values of a row do not depend on the number of shards.
+class PhiloxEngine {
+ public:
+  using result_type = uint32_t;
+  static constexpr uint64_t default_seed = 1;  // magic number
+  static constexpr result_type min() noexcept { return 0; }
+  static constexpr result_type max() noexcept { return 0xffffffff; }
+
+ private:
+  uint64_t key_ = default_seed;
+  uint64_t keyed_key_ = default_seed ^ PHILOX_KEYED_KEY_MASK;
+  uint64_t counter_ = 0;
+  uint32_t buf_[4] = {0, 0, 0, 0};
+  int buf_pos_ = 4;
+
+ public:
+  PhiloxEngine() = default;
+  explicit PhiloxEngine(uint64_t s) noexcept { seed(s); }
+  void seed(uint64_t s = default_seed) noexcept {
+    key_ = s;
+    keyed_key_ = s ^ PHILOX_KEYED_KEY_MASK;
+    counter_ = 0;
+    buf_pos_ = 4;
+  }
+  void seed_keyed(uint64_t s) noexcept {
+    keyed_key_ = s ^ PHILOX_KEYED_KEY_MASK;
+  }
+
+  result_type operator()() noexcept {
+    if (buf_pos_ == 4) {
+      PhiloxFill(key_, 0, counter_++, 1, buf_);
+      buf_pos_ = 0;
+    }
+    return buf_[buf_pos_++];
+  }
+
+ public:
+  // sequential generators
+  // Fill 'n' elements of 'X' with uniform values in ('a', 'b').
+  template <typename T>
+  void uniform(int n, T* X, T a, T b) noexcept {
+    Uniform(key_, 0, &counter_, n, X, a, b);
+  }
+  // Fill 'n' elements of 'X' with normal values.
+  template <typename T>
+  void normal(int n, T* X, T mean, T stddev) noexcept {
+    Normal(key_, 0, &counter_, n, X, mean, stddev);
+  }
+
+  // keyed generators
+  // Values depend on the keyed seed, 'salt' and 'id' only.
+  // Different 'salt's, e.g. hashes of parameter names, give independent
+  // values for the same 'id'.
+  template <typename T>
+  void uniform(uint64_t salt, uint64_t id, int n, T* X, T a,
+               T b) const noexcept {
+    uint64_t counter = 0;
+    Uniform(keyed_key_ ^ salt, id, &counter, n, X, a, b);
+  }
+  template <typename T>
+  void normal(uint64_t salt, uint64_t id, int n, T* X, T mean,
+              T stddev) const noexcept {
+    uint64_t counter = 0;
+    Normal(keyed_key_ ^ salt, id, &counter, n, X, mean, stddev);
+  }
+
+ private:
+  template <typename T>
+  static void Uniform(uint64_t key, uint64_t stream, uint64_t* counter,
+                      int n, T* X, T a, T b) noexcept;
+  template <typename T>
+  static void Normal(uint64_t key, uint64_t stream, uint64_t* counter, int n,
+                     T* X, T mean, T stddev) noexcept;
+};
+
+template <typename T>
+void PhiloxEngine::Uniform(uint64_t key, uint64_t stream, uint64_t* counter,
+                           int n, T* X, T a, T b) noexcept {
+  uint32_t buf[PHILOX_CHUNK_WORDS];
+  T scale = b - a;
+  for (int i = 0; i < n; i += PHILOX_CHUNK_WORDS) {
+    int m = (n - i < PHILOX_CHUNK_WORDS) ? n - i : PHILOX_CHUNK_WORDS;
+    int blocks = (m + 3) / 4;
+    PhiloxFill(key, stream, *counter, blocks, buf);
+    *counter += (uint64_t)blocks;
+    T* Xi = X + i;
+    for (int j = 0; j < m; ++j) {
+      Xi[j] = a + scale * PhiloxUniform<T>(buf[j]);
+    }
+  }
+}
+
+// Compute -2 * log('u') for 'u' in (0, 1), the relative error is about 1e-7.
+//
+// It is branch free, so that loops calling it are vectorizable.
+inline float PhiloxMinus2Log(float u) noexcept {
+  constexpr float SQRT2 = 1.41421356f;  // magic number
+  constexpr float LN2 = 0.693147181f;   // magic number
+  uint32_t i;
+  memcpy(&i, &u, sizeof(i));
+  float e = (float)((int)(i >> 23) - 127);
+  i = (i & 0x007fffff) | 0x3f800000;
+  float m;
+  memcpy(&m, &i, sizeof(m));
+  // m in [sqrt(0.5), sqrt(2))
+  float big = (m >= SQRT2) ? 1.0f : 0.0f;
+  m = m * (1 - 0.5f * big);
+  e = e + big;
+  // log(m) = 2 * atanh(s)
+  float s = (m - 1) / (m + 1);
+  float s2 = s * s;
+  float p = 1.0f / 9;
+  p = p * s2 + 1.0f / 7;
+  p = p * s2 + 1.0f / 5;
+  p = p * s2 + 1.0f / 3;
+  p = p * s2 + 1;
+  return -2 * (e * LN2 + 2 * s * p);
+}
+
+// Compute sin(2 * pi * 'u') and cos(2 * pi * 'u') for 'u' in [0, 1),
+// the absolute error is about 1e-7.
+//
+// It is branch free, so that loops calling it are vectorizable.
+inline void PhiloxSinCos2Pi(float u, float* sin_x, float* cos_x) noexcept {
+  constexpr float HALF_PI = 1.57079633f;  // magic number
+  // 2 * pi * u = a + q * pi / 2, a in [-pi / 4, pi / 4]
+  float t = 4 * u;
+  int q = (int)(t + 0.5f);
+  float a = (t - (float)q) * HALF_PI;
+  float a2 = a * a;
+  float s = -1.0f / 5040;
+  s = s * a2 + 1.0f / 120;
+  s = s * a2 - 1.0f / 6;
+  s = (s * a2 + 1) * a;
+  float c = 1.0f / 40320;
+  c = c * a2 - 1.0f / 720;
+  c = c * a2 + 1.0f / 24;
+  c = c * a2 - 0.5f;
+  c = c * a2 + 1;
+  // rotate by q quadrants
+  float sin_sign = (q & 2) ? -1.0f : 1.0f;
+  float cos_sign = ((q + 1) & 2) ? -1.0f : 1.0f;
+  *sin_x = ((q & 1) ? c : s) * sin_sign;
+  *cos_x = ((q & 1) ? s : c) * cos_sign;
+}
+
+template <typename T>
+void PhiloxEngine::Normal(uint64_t key, uint64_t stream, uint64_t* counter,
+                          int n, T* X, T mean, T stddev) noexcept {
+  // Box-Muller transform,
+  // the first half of a chunk are radii, the second half are angles,
+  // so that loops are contiguous and vectorizable.
+  //
+  // The number of pairs is rounded up to a multiple of 8,
+  // so that short rows do not fall into scalar code.
+  constexpr int PAIR_ALIGN = 8;  // magic number
+  uint32_t buf[PHILOX_CHUNK_WORDS];
+  float Z[PHILOX_CHUNK_WORDS];
+  for (int i = 0; i < n; i += PHILOX_CHUNK_WORDS) {
+    int m = (n - i < PHILOX_CHUNK_WORDS) ? n - i : PHILOX_CHUNK_WORDS;
+    int h = ((m + 1) / 2 + PAIR_ALIGN - 1) / PAIR_ALIGN * PAIR_ALIGN;
+    int blocks = h / 2;
+    PhiloxFill(key, stream, *counter, blocks, buf);
+    *counter += (uint64_t)blocks;
+    for (int j = 0; j < h; ++j) {
+      float r = std::sqrt(PhiloxMinus2Log(PhiloxUniform<float>(buf[j])));
+      float sin_x, cos_x;
+      PhiloxSinCos2Pi(PhiloxUniform<float>(buf[h + j]), &sin_x, &cos_x);
+      Z[j] = r * cos_x;
+      Z[h + j] = r * sin_x;
+    }
+    T* Xi = X + i;
+    for (int j = 0; j < m; ++j) {
+      Xi[j] = mean + stddev * (T)Z[j];
+    }
+  }
+}
+
+/************************************************************************/
+/* random fill */
+/************************************************************************/
+// Fill 'n' elements of 'X' with random values drawn from 'engine'.
+//
+// 'PhiloxEngine' uses its bulk generators,
+// other engines use distributions in <random>.
+template <class RandomEngine, typename T>
+void RandUniform(RandomEngine& engine, int n, T* X, T a, T b) {  // NOLINT
+  std::uniform_real_distribution<T> dist(a, b);
+  for (int i = 0; i < n; ++i) {
+    X[i] = dist(engine);
+  }
+}
+
+template <typename T>
+void RandUniform(PhiloxEngine& engine, int n, T* X, T a, T b) {  // NOLINT
+  engine.uniform(n, X, a, b);
+}
+
+template <class RandomEngine, typename T>
+void RandNormal(RandomEngine& engine, int n, T* X, T mean,  // NOLINT
+                T stddev) {
+  std::normal_distribution<T> dist(mean, stddev);
+  for (int i = 0; i < n; ++i) {
+    X[i] = dist(engine);
+  }
+}
+
+template <typename T>
+void RandNormal(PhiloxEngine& engine, int n, T* X, T mean,  // NOLINT
+                T stddev) {
+  engine.normal(n, X, mean, stddev);
+}
+
+// Normal values out of [mean - 2 * stddev, mean + 2 * stddev] are redrawn.
+template <class RandomEngine, typename T>
+void RandNormalTruncated(RandomEngine& engine, int n, T* X,  // NOLINT
+                         T mean, T stddev) {
+  std::normal_distribution<T> dist(mean, stddev);
+  T upper = mean + 2 * stddev;
+  T lower = mean - 2 * stddev;
+  for (int i = 0; i < n;) {
+    X[i] = dist(engine);
+    if (X[i] <= upper && X[i] >= lower) {
+      ++i;
+    }
+  }
+}
+
+template <typename T>
+void RandNormalTruncated(PhiloxEngine& engine, int n, T* X,  // NOLINT
+                         T mean, T stddev) {
+  T upper = mean + 2 * stddev;
+  T lower = mean - 2 * stddev;
+  engine.normal(n, X, mean, stddev);
+  for (int i = 0; i < n; ++i) {
+    while (!(X[i] <= upper && X[i] >= lower)) {
+      engine.normal(1, &X[i], mean, stddev);
+    }
+  }
+}
+
+// Fill row 'id' of a lazily initialized matrix salted by 'salt'.
+//
+// 'PhiloxEngine' uses its keyed generators,
+// other engines ignore 'salt' and 'id'.
+template <class RandomEngine, typename I, typename T>
+void RandUniformKeyed(RandomEngine& engine, uint64_t /*salt*/,  // NOLINT
+                      I /*id*/, int n, T* X, T a, T b) {
+  RandUniform(engine, n, X, a, b);
+}
+
+template <typename I, typename T>
+void RandUniformKeyed(PhiloxEngine& engine, uint64_t salt, I id,  // NOLINT
+                      int n, T* X, T a, T b) {
+  engine.uniform(salt, (uint64_t)id, n, X, a, b);
+}
+
+template <class RandomEngine, typename I, typename T>
+void RandNormalKeyed(RandomEngine& engine, uint64_t /*salt*/,  // NOLINT
+                     I /*id*/, int n, T* X, T mean, T stddev) {
+  RandNormal(engine, n, X, mean, stddev);
+}
+
+template <typename I, typename T>
+void RandNormalKeyed(PhiloxEngine& engine, uint64_t salt, I id,  // NOLINT
+                     int n, T* X, T mean, T stddev) {
+  engine.normal(salt, (uint64_t)id, n, X, mean, stddev);
+}
+
+}  // namespace deepx_core
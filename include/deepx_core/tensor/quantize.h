@@ -0,0 +1,111 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#pragma once
+#include <cmath>
+#include <cstdint>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace deepx_core {
+
+// Symmetric int8 quantization.
+//
+// A row of real values x is represented by int8 values q and a real scale s,
+// x ~= s * q, where s = max(|x|) / 127 and q = round(x / s).
+//
+// q is in [-127, 127], -128 is never used, so that products of two int8
+// values can be summed in pairs by 'pmaddubsw' without saturation.
+
+constexpr int QUANTIZE_INT8_MAX = 127;  // magic number
+
+// Quantize 'n' elements of 'X' to 'Q', return the scale.
+template <typename T>
+T QuantizeRow(int n, const T* X, int8_t* Q) noexcept {
+  T max_abs = 0;
+  for (int i = 0; i < n; ++i) {
+    T abs_x = std::fabs(X[i]);
+    max_abs = (abs_x > max_abs) ? abs_x : max_abs;
+  }
+
+  if (max_abs == 0) {
+    for (int i = 0; i < n; ++i) {
+      Q[i] = 0;
+    }
+    return 0;
+  }
+
+  T scale = max_abs / QUANTIZE_INT8_MAX;
+  T inv_scale = QUANTIZE_INT8_MAX / max_abs;
+  for (int i = 0; i < n; ++i) {
+    long q = std::lrint(X[i] * inv_scale);
+    q = (q > QUANTIZE_INT8_MAX) ? QUANTIZE_INT8_MAX : q;
+    q = (q < -QUANTIZE_INT8_MAX) ? -QUANTIZE_INT8_MAX : q;
+    Q[i] = (int8_t)q;
+  }
+  return scale;
+}
+
+// Compute X = scale * Q of 'n' elements.
+template <typename T>
+void DequantizeRow(int n, const int8_t* Q, T scale, T* X) noexcept {
+  for (int i = 0; i < n; ++i) {
+    X[i] = scale * Q[i];
+  }
+}
+
+// Compute the dot product of 'n' int8 elements in [-127, 127].
+inline int32_t QuantizedDot(int n, const int8_t* X, const int8_t* Y) noexcept {
+  int32_t sum = 0;
+  int i = 0;
+#if defined(__AVX2__)
+  constexpr int LANE = 32;  // magic number
+  const __m256i ones = _mm256_set1_epi16(1);
+  __m256i acc = _mm256_setzero_si256();
+  for (; i + LANE <= n; i += LANE) {
+    __m256i x = _mm256_loadu_si256((const __m256i*)(X + i));
+    __m256i y = _mm256_loadu_si256((const __m256i*)(Y + i));
+    // |x| * (sign(x) * y) in unsigned * signed form,
+    // a pair sum is at most 2 * 127 * 127, no saturation.
+    __m256i xy =
+        _mm256_maddubs_epi16(_mm256_abs_epi8(x), _mm256_sign_epi8(y, x));
+    acc = _mm256_add_epi32(acc, _mm256_madd_epi16(xy, ones));
+  }
+  __m128i acc4 = _mm_add_epi32(_mm256_castsi256_si128(acc),
+                               _mm256_extracti128_si256(acc, 1));
+  acc4 = _mm_add_epi32(acc4, _mm_shuffle_epi32(acc4, 0x4e));
+  acc4 = _mm_add_epi32(acc4, _mm_shuffle_epi32(acc4, 0xb1));
+  sum = _mm_cvtsi128_si32(acc4);
+#endif
+  for (; i < n; ++i) {
+    sum += (int32_t)X[i] * (int32_t)Y[i];
+  }
+  return sum;
+}
+
+// Compute Z(m, n) = (diag(Xscale) * X) * (diag(Wscale) * W)^T,
+// where 'X'(m, k) and 'W'(n, k) are row-major int8 matrices,
+// i.e. each row of W is an output channel.
+template <typename T>
+void QuantizedGEMM(int m, int n, int k, const int8_t* X, const T* Xscale,
+                   const int8_t* W, const T* Wscale, T* Z) noexcept {
+  // A block of W rows stays in cache while all rows of X are visited.
+  constexpr int BLOCK_BYTES = 32 * 1024;  // magic number
+  int block = BLOCK_BYTES / (k > 0 ? k : 1);
+  block = (block < 1) ? 1 : block;
+  for (int j0 = 0; j0 < n; j0 += block) {
+    int j1 = (j0 + block < n) ? j0 + block : n;
+    for (int i = 0; i < m; ++i) {
+      const int8_t* Xi = X + (size_t)i * k;
+      T* Zi = Z + (size_t)i * n;
+      for (int j = j0; j < j1; ++j) {
+        Zi[j] = Xscale[i] * Wscale[j] *
+                (T)QuantizedDot(k, Xi, W + (size_t)j * k);
+      }
+    }
+  }
+}
+
+}  // namespace deepx_core
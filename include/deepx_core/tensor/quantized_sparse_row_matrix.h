@@ -0,0 +1,214 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#pragma once
+#include <deepx_core/common/hash.h>
+#include <deepx_core/common/hash_map.h>
+#include <deepx_core/common/hash_map_io.h>
+#include <deepx_core/common/stream.h>
+#include <deepx_core/dx_log.h>
+#include <deepx_core/tensor/quantize.h>
+#include <deepx_core/tensor/shape.h>
+#include <deepx_core/tensor/sparse_row_matrix.h>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace deepx_core {
+
+/************************************************************************/
+/* QuantizedSparseRowMatrix */
+/************************************************************************/
+// An int8 quantized 'SparseRowMatrix' with per row scales.
+//
+// Rows are stored contiguously, 'row_map_' maps a row to its index.
+//
+// It is read only, it is used by inference only,
+// rows are dequantized on the fly when they are looked up.
+template <typename T, typename I>
+class QuantizedSparseRowMatrix {
+ private:
+  using map_t = HashMap<I, int, MurmurHash<I>>;
+
+ public:
+  using float_t = T;
+  using int_t = I;
+
+ private:
+  Shape shape_{0, 0};
+  map_t row_map_;
+  std::vector<int8_t> data_;
+  std::vector<float_t> scale_;
+
+  template <typename T2, typename I2>
+  friend OutputStream& operator<<(
+      OutputStream& os, const QuantizedSparseRowMatrix<T2, I2>& qsrm);
+  template <typename T2, typename I2>
+  friend InputStream& operator>>(InputStream& is,
+                                 QuantizedSparseRowMatrix<T2, I2>& qsrm);
+
+ public:
+  const Shape& shape() const noexcept { return shape_; }
+  int col() const noexcept { return shape_[1]; }
+  size_t size() const noexcept { return row_map_.size(); }
+  bool empty() const noexcept { return row_map_.empty(); }
+
+ public:
+  void clear() noexcept;
+  void quantize(const SparseRowMatrix<float_t, int_t>& W);
+  void dequantize(SparseRowMatrix<float_t, int_t>* W) const;
+
+ public:
+  // Return int8 values of 'row' and output its scale,
+  // or nullptr if 'row' is not found.
+  const int8_t* get_row_no_init(int_t row, float_t* scale) const noexcept {
+    auto it = row_map_.find(row);
+    if (it == row_map_.end()) {
+      return nullptr;
+    }
+    *scale = scale_[it->second];
+    return data_.data() + (size_t)it->second * col();
+  }
+  // Prefetch the hash bucket of 'row'.
+  void prefetch_row(int_t row) const noexcept { row_map_.prefetch(row); }
+
+ public:
+  // comparison
+  bool operator==(const QuantizedSparseRowMatrix& right) const noexcept;
+  bool operator!=(const QuantizedSparseRowMatrix& right) const noexcept {
+    return !(operator==(right));
+  }
+};
+
+template <typename T, typename I>
+void QuantizedSparseRowMatrix<T, I>::clear() noexcept {
+  shape_.resize(0, 0);
+  row_map_.clear();
+  data_.clear();
+  scale_.clear();
+}
+
+template <typename T, typename I>
+void QuantizedSparseRowMatrix<T, I>::quantize(
+    const SparseRowMatrix<float_t, int_t>& W) {
+  int n = W.col();
+  clear();
+  shape_.resize(0, n);
+  row_map_.reserve(W.size());
+  data_.resize(W.size() * n);
+  scale_.resize(W.size());
+  int index = 0;
+  for (const auto& entry : W) {
+    row_map_.emplace(entry.first, index);
+    scale_[index] =
+        QuantizeRow(n, entry.second, &data_[(size_t)index * n]);
+    ++index;
+  }
+}
+
+template <typename T, typename I>
+void QuantizedSparseRowMatrix<T, I>::dequantize(
+    SparseRowMatrix<float_t, int_t>* W) const {
+  int n = col();
+  std::vector<float_t> row_value(n);
+  W->clear();
+  W->set_col(n);
+  W->reserve(size());
+  for (const auto& entry : row_map_) {
+    int index = entry.second;
+    DequantizeRow(n, data_.data() + (size_t)index * n, scale_[index],
+                  row_value.data());
+    W->assign(entry.first, row_value.data());
+  }
+}
+
+template <typename T, typename I>
+bool QuantizedSparseRowMatrix<T, I>::operator==(
+    const QuantizedSparseRowMatrix& right) const noexcept {
+  if (shape_ != right.shape_ || size() != right.size()) {
+    return false;
+  }
+
+  int n = col();
+  for (const auto& entry : row_map_) {
+    float_t right_scale;
+    const int8_t* right_row = right.get_row_no_init(entry.first, &right_scale);
+    if (right_row == nullptr || right_scale != scale_[entry.second]) {
+      return false;
+    }
+    const int8_t* row = data_.data() + (size_t)entry.second * n;
+    for (int i = 0; i < n; ++i) {
+      if (row[i] != right_row[i]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename T, typename I>
+OutputStream& operator<<(OutputStream& os,
+                         const QuantizedSparseRowMatrix<T, I>& qsrm) {
+  int version = 0x0a0c72f1;  // magic number version
+  os << version;
+  os << qsrm.col() << qsrm.row_map_ << qsrm.data_ << qsrm.scale_;
+  return os;
+}
+
+template <typename T, typename I>
+InputStream& operator>>(InputStream& is,
+                        QuantizedSparseRowMatrix<T, I>& qsrm) {
+  int version;
+  is >> version;
+  if (!is) {
+    return is;
+  }
+
+  if (version != 0x0a0c72f1) {  // magic number version
+    DXERROR("Invalid version: %d.", version);
+    is.set_bad();
+    return is;
+  }
+
+  int col;
+  is >> col >> qsrm.row_map_ >> qsrm.data_ >> qsrm.scale_;
+  if (!is) {
+    return is;
+  }
+
+  qsrm.shape_.resize(0, col);
+  if (qsrm.scale_.size() != qsrm.row_map_.size() ||
+      qsrm.data_.size() != qsrm.scale_.size() * col) {
+    DXERROR("Invalid quantized sparse row matrix.");
+    is.set_bad();
+  }
+  return is;
+}
+
+template <typename T, typename I>
+InputStringStream& ReadView(InputStringStream& is,                  // NOLINT
+                            QuantizedSparseRowMatrix<T, I>& qsrm) {  // NOLINT
+  // no actual view
+  is >> qsrm;
+  return is;
+}
+
+template <typename T, typename I>
+std::ostream& operator<<(std::ostream& os,
+                         const QuantizedSparseRowMatrix<T, I>& qsrm) {
+  os << qsrm.shape() << std::endl;
+  // unordered
+  SparseRowMatrix<T, I> W;
+  qsrm.dequantize(&W);
+  for (const auto& entry : W) {
+    os << "row " << entry.first << ":";
+    for (int i = 0; i < W.col(); ++i) {
+      os << " " << entry.second[i];
+    }
+    os << std::endl;
+  }
+  return os;
+}
+
+}  // namespace deepx_core
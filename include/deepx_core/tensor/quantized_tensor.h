@@ -0,0 +1,163 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#pragma once
+#include <deepx_core/common/stream.h>
+#include <deepx_core/dx_log.h>
+#include <deepx_core/tensor/quantize.h>
+#include <deepx_core/tensor/shape.h>
+#include <deepx_core/tensor/tensor.h>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace deepx_core {
+
+/************************************************************************/
+/* QuantizedTensor */
+/************************************************************************/
+// An int8 quantized rank 2 weight W(k, n) with per output channel scales.
+//
+// W is stored transposed, row j holds the k int8 values of output channel j,
+// so that both operands of 'QuantizedGEMM' are traversed contiguously.
+//
+// It is read only, it is used by inference only.
+template <typename T>
+class QuantizedTensor {
+ public:
+  using float_t = T;
+
+ private:
+  Shape shape_;  // shape of W
+  std::vector<int8_t> data_;
+  std::vector<float_t> scale_;
+
+  template <typename T2>
+  friend OutputStream& operator<<(OutputStream& os,
+                                  const QuantizedTensor<T2>& qtsr);
+  template <typename T2>
+  friend InputStream& operator>>(InputStream& is, QuantizedTensor<T2>& qtsr);
+
+ public:
+  const Shape& shape() const noexcept { return shape_; }
+  int dim(int i) const noexcept { return shape_[i]; }
+  bool empty() const noexcept { return data_.empty(); }
+  const int8_t* data() const noexcept { return data_.data(); }
+  const float_t* scale() const noexcept { return scale_.data(); }
+  // int8 values of output channel 'j'
+  const int8_t* channel(int j) const noexcept {
+    return data_.data() + (size_t)j * shape_[0];
+  }
+
+ public:
+  void clear() noexcept;
+  void quantize(const Tensor<float_t>& W);
+  void dequantize(Tensor<float_t>* W) const;
+
+ public:
+  // comparison
+  bool operator==(const QuantizedTensor& right) const noexcept {
+    return shape_ == right.shape_ && data_ == right.data_ &&
+           scale_ == right.scale_;
+  }
+  bool operator!=(const QuantizedTensor& right) const noexcept {
+    return !(operator==(right));
+  }
+};
+
+template <typename T>
+void QuantizedTensor<T>::clear() noexcept {
+  shape_.clear();
+  data_.clear();
+  scale_.clear();
+}
+
+template <typename T>
+void QuantizedTensor<T>::quantize(const Tensor<float_t>& W) {
+  if (!W.is_rank(2)) {
+    DXTHROW_INVALID_ARGUMENT("Invalid W: rank of W %d must be 2.", W.rank());
+  }
+
+  int k = W.dim(0);
+  int n = W.dim(1);
+  shape_ = W.shape();
+  data_.resize((size_t)n * k);
+  scale_.resize(n);
+  std::vector<float_t> column(k);
+  for (int j = 0; j < n; ++j) {
+    for (int i = 0; i < k; ++i) {
+      column[i] = W.data(i * n + j);
+    }
+    scale_[j] = QuantizeRow(k, column.data(), &data_[(size_t)j * k]);
+  }
+}
+
+template <typename T>
+void QuantizedTensor<T>::dequantize(Tensor<float_t>* W) const {
+  int k = shape_[0];
+  int n = shape_[1];
+  W->resize(shape_);
+  for (int j = 0; j < n; ++j) {
+    const int8_t* Qj = channel(j);
+    for (int i = 0; i < k; ++i) {
+      W->data(i * n + j) = scale_[j] * Qj[i];
+    }
+  }
+}
+
+template <typename T>
+OutputStream& operator<<(OutputStream& os, const QuantizedTensor<T>& qtsr) {
+  int version = 0x0a0c72f0;  // magic number version
+  os << version;
+  os << qtsr.shape_ << qtsr.data_ << qtsr.scale_;
+  return os;
+}
+
+template <typename T>
+InputStream& operator>>(InputStream& is, QuantizedTensor<T>& qtsr) {
+  int version;
+  is >> version;
+  if (!is) {
+    return is;
+  }
+
+  if (version != 0x0a0c72f0) {  // magic number version
+    DXERROR("Invalid version: %d.", version);
+    is.set_bad();
+    return is;
+  }
+
+  is >> qtsr.shape_ >> qtsr.data_ >> qtsr.scale_;
+  if (is && (!qtsr.shape_.is_rank(2) ||
+             qtsr.data_.size() != (size_t)qtsr.shape_.total_dim() ||
+             qtsr.scale_.size() != (size_t)qtsr.shape_[1])) {
+    DXERROR("Invalid quantized tensor.");
+    is.set_bad();
+  }
+  return is;
+}
+
+template <typename T>
+InputStringStream& ReadView(InputStringStream& is,     // NOLINT
+                            QuantizedTensor<T>& qtsr) {  // NOLINT
+  // no actual view
+  is >> qtsr;
+  return is;
+}
+
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const QuantizedTensor<T>& qtsr) {
+  os << qtsr.shape() << std::endl;
+  for (int j = 0; j < qtsr.dim(1); ++j) {
+    os << "channel " << j << ": scale=" << qtsr.scale()[j] << ":";
+    const int8_t* Qj = qtsr.channel(j);
+    for (int i = 0; i < qtsr.dim(0); ++i) {
+      os << " " << (int)Qj[i];
+    }
+    os << std::endl;
+  }
+  return os;
+}
+
+}  // namespace deepx_core
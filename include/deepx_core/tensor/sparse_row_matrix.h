@@ -11,8 +11,11 @@
 #include <deepx_core/common/vector.h>
 #include <deepx_core/common/vector_io.h>
 #include <deepx_core/dx_log.h>
+#include <deepx_core/tensor/half.h>
+#include <deepx_core/tensor/philox.h>
 #include <deepx_core/tensor/shape.h>
 #include <deepx_core/tensor/tensor_type.h>
+#include <cstdint>
 #include <cstring>  // memcpy
 #include <initializer_list>
 #include <iostream>
@@ -126,13 +129,17 @@ class SparseRowMatrix {
   using key_type = typename map_t::key_type;
   using mapped_type = typename map_t::mapped_type;
   using value_type = typename map_t::value_type;
+  using half_map_t = HashMap<I, Vector<uint16_t>, MurmurHash<I>>;
 
  private:
   Shape shape_{0, 0};
   map_t row_map_;
+  half_map_t half_row_map_;
   int initializer_type_ = TENSOR_INITIALIZER_TYPE_NONE;
   float_t initializer_param1_ = 0;
   float_t initializer_param2_ = 0;
+  int storage_dtype_ = TENSOR_DTYPE_NONE;
+  uint64_t initializer_salt_ = 0;
 
   template <typename T2, typename I2>
   friend OutputStream& operator<<(OutputStream& os,
@@ -173,6 +180,58 @@ class SparseRowMatrix {
  public:
   void set_initializer(int initializer_type, float_t initializer_param1 = 0,
                        float_t initializer_param2 = 0);
+  int initializer_type() const noexcept { return initializer_type_; }
+  float_t initializer_param1() const noexcept { return initializer_param1_; }
+  float_t initializer_param2() const noexcept { return initializer_param2_; }
+  // 'initializer_salt' salts random initial values of rows,
+  // so that SRMs sharing ids are not initialized identically.
+  // It is not serialized.
+  void set_initializer_salt(uint64_t initializer_salt) noexcept {
+    initializer_salt_ = initializer_salt;
+  }
+  uint64_t initializer_salt() const noexcept { return initializer_salt_; }
+
+ public:
+  // 'storage_dtype' is TENSOR_DTYPE_NONE, TENSOR_DTYPE_FLOAT16 or
+  // TENSOR_DTYPE_BFLOAT16.
+  //
+  // If it is TENSOR_DTYPE_NONE, rows are stored in 'float_t'.
+  // Otherwise, rows are stored in 'storage_dtype' both in memory and in
+  // serialization, which halves the size of the matrix.
+  //
+  // Rows in 'storage_dtype' are accessed by 'half_rows', 'get_half_row*',
+  // 'assign_half_view', 'decode_row' and 'assign*', which convert rows from
+  // and to 'float_t'.
+  // Other row accessors and iterators are for rows in 'float_t' only.
+  //
+  // Existing rows are converted, rounding to nearest.
+  void set_storage_dtype(int storage_dtype);
+  int storage_dtype() const noexcept { return storage_dtype_; }
+  const half_map_t& half_rows() const noexcept { return half_row_map_; }
+
+ private:
+  // Initialize 'row_value' of 'row' with the initializer.
+  //
+  // If 'engine' is a 'PhiloxEngine', random values are keyed by
+  // 'initializer_salt' and 'row',
+  // they do not depend on the order rows are initialized.
+  template <class RandomEngine>
+  void init_row(RandomEngine& engine, int_t row,  // NOLINT
+                ptr_t row_value) const;
+  // Initialize 'row_value' of 'row' in 'storage_dtype', rounding to nearest.
+  template <class RandomEngine>
+  void init_half_row(RandomEngine& engine, int_t row,  // NOLINT
+                     uint16_t* row_value) const;
+  bool has_row(int_t row) const noexcept;
+  void assign_half(int_t row, const uint16_t* row_value);
+  template <class Map, class Func>
+  static void merge_map_if(Map* map, const Map& other_map, Func&& func);
+  template <class Map, class Func>
+  static void merge_map_if(Map* map, Map&& other_map, Func&& func);
+  template <class Map, class Func>
+  static void remove_map_if(Map* map, Func&& func);
+  void write_half(OutputStream& os) const;  // NOLINT
+  void read_half(InputStream& is);          // NOLINT
 
  public:
   SparseRowMatrix() = default;
@@ -184,9 +243,14 @@ class SparseRowMatrix {
   template <typename Int>
   void reserve(Int size);
   void clear() noexcept;
-  void zeros() noexcept { row_map_.clear(); }
-  size_t size() const noexcept { return row_map_.size(); }
-  bool empty() const noexcept { return row_map_.empty(); }
+  void zeros() noexcept;
+  size_t size() const noexcept {
+    return row_map_.size() + half_row_map_.size();
+  }
+  bool empty() const noexcept { return size() == 0; }
+  // Rows of 'other' are converted to 'storage_dtype' if they are not in it.
+  //
+  // 'func(row)' filters rows of 'other' in '*_if'.
   void upsert(const SparseRowMatrix& other);
   template <class Func>
   void upsert_if(const SparseRowMatrix& other, Func&& func);
@@ -196,10 +260,18 @@ class SparseRowMatrix {
   void merge_if(const SparseRowMatrix& other, Func&& func);
   template <class Func>
   void merge_if(SparseRowMatrix&& other, Func&& func);
+  // 'row_value' is converted to 'storage_dtype', rounding to nearest.
   void assign(int_t row, cptr_t row_value);
+  // 'row_value' is converted to 'storage_dtype', rounding stochastically,
+  // so that small updates to rows are not lost on average.
+  template <class RandomEngine>
+  void assign_stochastic(RandomEngine&& engine, int_t row, cptr_t row_value);
   void assign_view(int_t row, cptr_t row_value);
+  void assign_half_view(int_t row, const uint16_t* row_value);
+  // Remove rows for which 'func(row)' is true.
   template <class Func>
   void remove_if(Func&& func);
+  size_t erase(int_t row);
   void remove_zeros();
 
   void upsert(const SparseRowMatrix& other, ReadWriteLock* lock);
@@ -207,6 +279,9 @@ class SparseRowMatrix {
   void upsert_if(const SparseRowMatrix& other, Func&& func,
                  ReadWriteLock* lock);
   void assign(int_t row, cptr_t row_value, ReadWriteLock* lock);
+  template <class RandomEngine>
+  void assign_stochastic(RandomEngine&& engine, int_t row, cptr_t row_value,
+                         ReadWriteLock* lock);
 
  public:
   template <class RandomEngine>
@@ -217,6 +292,23 @@ class SparseRowMatrix {
   inline float_t& get_scalar(RandomEngine&& engine, int_t row);
   inline float_t& get_scalar_no_init(int_t row);
   inline float_t get_scalar_no_init(int_t row) const noexcept;
+  template <class RandomEngine>
+  inline const uint16_t* get_half_row(RandomEngine&& engine, int_t row);
+  inline const uint16_t* get_half_row_no_init(int_t row) const noexcept;
+  // Copy 'row' to 'row_value' in 'float_t',
+  // return false and leave 'row_value' untouched if 'row' does not exist.
+  bool decode_row(int_t row, ptr_t row_value) const;
+  // Call 'func(row, row_value)' for every row, 'row_value' is in 'float_t'.
+  template <class Func>
+  void for_each_row(Func&& func) const;
+  // Prefetch the hash bucket of 'row'.
+  void prefetch_row(int_t row) const noexcept {
+    if (IsHalfDtype(storage_dtype_)) {
+      half_row_map_.prefetch(row);
+    } else {
+      row_map_.prefetch(row);
+    }
+  }
 
   template <class RandomEngine>
   inline ptr_t get_row(RandomEngine&& engine, int_t row, ReadWriteLock* lock);
@@ -227,6 +319,10 @@ class SparseRowMatrix {
                              ReadWriteLock* lock);
   inline float_t& get_scalar_no_init(int_t row, ReadWriteLock* lock);
   inline float_t get_scalar_no_init(int_t row, ReadWriteLock* lock) const;
+  template <class RandomEngine>
+  inline const uint16_t* get_half_row(RandomEngine&& engine, int_t row,
+                                      ReadWriteLock* lock);
+  bool decode_row(int_t row, ptr_t row_value, ReadWriteLock* lock) const;
 
  public:
   // iterator
@@ -271,6 +367,11 @@ std::ostream& operator<<(std::ostream& os, const SparseRowMatrix<T, I>& srm);
 /************************************************************************/
 template <typename T, typename I>
 OutputStream& operator<<(OutputStream& os, const SparseRowMatrix<T, I>& srm) {
+  if (IsHalfDtype(srm.storage_dtype_)) {
+    srm.write_half(os);
+    return os;
+  }
+
   int version = 0x0a0c72e7;  // magic number version
   os << version;
   os << srm.col() << srm.row_map_ << srm.initializer_type_
@@ -287,12 +388,16 @@ InputStream& operator>>(InputStream& is, SparseRowMatrix<T, I>& srm) {
 
   if (version == 0x0a0c72e7) {  // magic number version
     int col;
+    srm.half_row_map_.clear();
+    srm.storage_dtype_ = TENSOR_DTYPE_NONE;
     is >> version;
     is >> col >> srm.row_map_ >> srm.initializer_type_ >>
         srm.initializer_param1_ >> srm.initializer_param2_;
     if (is) {
       srm.set_col(col);
     }
+  } else if (version == 0x0a0c72e8) {  // magic number version
+    srm.read_half(is);
   } else {
     // backward compatibility
     srm.clear();
@@ -319,6 +424,8 @@ InputStringStream& ReadView(InputStringStream& is,         // NOLINT
 
   if (version == 0x0a0c72e7) {  // magic number version
     int col;
+    srm.half_row_map_.clear();
+    srm.storage_dtype_ = TENSOR_DTYPE_NONE;
     ReadView(is, version);
     ReadView(is, col);
     ReadView(is, srm.row_map_);
@@ -328,6 +435,9 @@ InputStringStream& ReadView(InputStringStream& is,         // NOLINT
     if (is) {
       srm.set_col(col);
     }
+  } else if (version == 0x0a0c72e8) {  // magic number version
+    // no actual view
+    srm.read_half(is);
   } else {
     // backward compatibility
     is.set_bad();
@@ -345,15 +455,21 @@ InputStream& ReadSRP(InputStream& is,               // NOLINT
 
   if (version == 0x0a0c72e7) {  // magic number version
     int col;
+    srm.half_row_map_.clear();
+    srm.storage_dtype_ = TENSOR_DTYPE_NONE;
     is >> version;
     is >> col >> srm.row_map_ >> srm.initializer_type_ >>
         srm.initializer_param1_ >> srm.initializer_param2_;
     if (is) {
       srm.set_col(col);
     }
+  } else if (version == 0x0a0c72e8) {  // magic number version
+    srm.read_half(is);
   } else {
     // backward compatibility
     int col;
+    srm.half_row_map_.clear();
+    srm.storage_dtype_ = TENSOR_DTYPE_NONE;
     is >> col >> srm.row_map_ >> srm.initializer_type_ >>
         srm.initializer_param1_ >> srm.initializer_param2_;
     if (is) {
@@ -395,13 +511,13 @@ InputStringStream& ReadSVPView(InputStringStream& is,         // NOLINT
 template <typename T, typename I>
 std::ostream& operator<<(std::ostream& os, const SparseRowMatrix<T, I>& srm) {
   os << srm.shape() << std::endl;
-  for (const auto& entry : srm) {
-    os << "row " << entry.first << ":";
+  srm.for_each_row([&os, &srm](I row, const T* row_value) {
+    os << "row " << row << ":";
     for (int i = 0; i < srm.col(); ++i) {
-      os << " " << entry.second[i];
+      os << " " << row_value[i];
     }
     os << std::endl;
-  }
+  });
   return os;
 }
 
@@ -431,6 +547,179 @@ void SparseRowMatrix<T, I>::set_initializer(int initializer_type,
   initializer_param2_ = initializer_param2;
 }
 
+template <typename T, typename I>
+void SparseRowMatrix<T, I>::set_storage_dtype(int storage_dtype) {
+  if (storage_dtype != TENSOR_DTYPE_NONE && !IsHalfDtype(storage_dtype)) {
+    DXTHROW_INVALID_ARGUMENT("Invalid storage_dtype: %d.", storage_dtype);
+  }
+
+  if (storage_dtype == storage_dtype_) {
+    return;
+  }
+
+  SparseRowMatrix other;
+  other.set_col(col());
+  other.storage_dtype_ = storage_dtype;
+  other.upsert(*this);
+  row_map_ = std::move(other.row_map_);
+  half_row_map_ = std::move(other.half_row_map_);
+  storage_dtype_ = storage_dtype;
+}
+
+template <typename T, typename I>
+template <class RandomEngine>
+void SparseRowMatrix<T, I>::init_row(RandomEngine& engine, int_t row,  // NOLINT
+                                     ptr_t row_value) const {
+  switch (initializer_type_) {
+    case TENSOR_INITIALIZER_TYPE_ONES: {
+      for (int i = 0; i < col(); ++i) {
+        row_value[i] = 1;
+      }
+    } break;
+    case TENSOR_INITIALIZER_TYPE_CONSTANT: {
+      for (int i = 0; i < col(); ++i) {
+        row_value[i] = initializer_param1_;
+      }
+    } break;
+    case TENSOR_INITIALIZER_TYPE_RAND: {
+      RandUniformKeyed(engine, initializer_salt_, row, col(), row_value,
+                       initializer_param1_, initializer_param2_);
+    } break;
+    case TENSOR_INITIALIZER_TYPE_RANDN: {
+      RandNormalKeyed(engine, initializer_salt_, row, col(), row_value,
+                      initializer_param1_, initializer_param2_);
+    } break;
+  }
+}
+
+template <typename T, typename I>
+template <class RandomEngine>
+void SparseRowMatrix<T, I>::init_half_row(RandomEngine& engine,  // NOLINT
+                                          int_t row,
+                                          uint16_t* row_value) const {
+  std::vector<float_t> buf(col());
+  init_row(engine, row, buf.data());
+  HalfEncode(storage_dtype_, col(), buf.data(), row_value);
+}
+
+template <typename T, typename I>
+bool SparseRowMatrix<T, I>::has_row(int_t row) const noexcept {
+  if (IsHalfDtype(storage_dtype_)) {
+    return half_row_map_.find(row) != half_row_map_.end();
+  }
+  return row_map_.find(row) != row_map_.end();
+}
+
+template <typename T, typename I>
+void SparseRowMatrix<T, I>::assign_half(int_t row, const uint16_t* row_value) {
+  auto& value = half_row_map_[row];
+  value.resize(col());
+  memcpy(&value[0], row_value, col() * sizeof(uint16_t));
+}
+
+template <typename T, typename I>
+template <class Func>
+void SparseRowMatrix<T, I>::for_each_row(Func&& func) const {
+  if (IsHalfDtype(storage_dtype_)) {
+    std::vector<float_t> buf(col());
+    for (const auto& entry : half_row_map_) {
+      HalfDecode(storage_dtype_, col(), entry.second.data(), buf.data());
+      func(entry.first, (cptr_t)buf.data());
+    }
+  } else {
+    for (const auto& entry : row_map_) {
+      func(entry.first, entry.second.data());
+    }
+  }
+}
+
+template <typename T, typename I>
+template <class Map, class Func>
+void SparseRowMatrix<T, I>::merge_map_if(Map* map, const Map& other_map,
+                                         Func&& func) {
+  map->reserve(map->size() + other_map.size());
+  for (const auto& entry : other_map) {
+    if (func(entry.first)) {
+      map->emplace(entry);
+    }
+  }
+}
+
+template <typename T, typename I>
+template <class Map, class Func>
+void SparseRowMatrix<T, I>::merge_map_if(Map* map, Map&& other_map,
+                                         Func&& func) {
+  map->reserve(map->size() + other_map.size());
+  for (auto& entry : other_map) {
+    if (func(entry.first)) {
+      map->emplace(entry.first, std::move(entry.second));
+    }
+  }
+}
+
+template <typename T, typename I>
+template <class Map, class Func>
+void SparseRowMatrix<T, I>::remove_map_if(Map* map, Func&& func) {
+  auto first = map->begin();
+  auto last = map->end();
+  for (; first != last;) {
+    if (func(*first)) {
+      first = map->erase(first);
+    } else {
+      ++first;
+    }
+  }
+}
+
+template <typename T, typename I>
+void SparseRowMatrix<T, I>::write_half(OutputStream& os) const {  // NOLINT
+  int version = 0x0a0c72e8;  // magic number version
+  uint64_t size = (uint64_t)half_row_map_.size();
+  os << version;
+  os << col() << storage_dtype_ << size;
+  for (const auto& entry : half_row_map_) {
+    os << entry.first;
+    os.Write(entry.second.data(), sizeof(uint16_t) * col());
+    if (!os) {
+      return;
+    }
+  }
+  os << initializer_type_ << initializer_param1_ << initializer_param2_;
+}
+
+template <typename T, typename I>
+void SparseRowMatrix<T, I>::read_half(InputStream& is) {  // NOLINT
+  int version, _col, storage_dtype;
+  uint64_t size;
+  is >> version;
+  is >> _col >> storage_dtype >> size;
+  if (!is) {
+    return;
+  }
+
+  if (!IsHalfDtype(storage_dtype)) {
+    DXERROR("Invalid storage_dtype: %d.", storage_dtype);
+    is.set_bad();
+    return;
+  }
+
+  clear();
+  set_col(_col);
+  storage_dtype_ = storage_dtype;
+  half_row_map_.reserve((size_t)size);
+  int_t row;
+  for (uint64_t i = 0; i < size; ++i) {
+    is >> row;
+    auto& value = half_row_map_[row];
+    value.resize(_col);
+    is.Read(&value[0], sizeof(uint16_t) * _col);
+    if (!is) {
+      return;
+    }
+  }
+  is >> initializer_type_ >> initializer_param1_ >> initializer_param2_;
+}
+
 template <typename T, typename I>
 SparseRowMatrix<T, I>::SparseRowMatrix(
     std::initializer_list<int_t> rows,
@@ -468,28 +757,34 @@ SparseRowMatrix<T, I>::SparseRowMatrix(
 template <typename T, typename I>
 template <typename Int>
 void SparseRowMatrix<T, I>::reserve(Int size) {
-  row_map_.reserve((size_t)size);
+  if (IsHalfDtype(storage_dtype_)) {
+    half_row_map_.reserve((size_t)size);
+  } else {
+    row_map_.reserve((size_t)size);
+  }
 }
 
 template <typename T, typename I>
 void SparseRowMatrix<T, I>::clear() noexcept {
   shape_.resize(0, 0);
   row_map_.clear();
+  half_row_map_.clear();
   initializer_type_ = TENSOR_INITIALIZER_TYPE_NONE;
   initializer_param1_ = 0;
   initializer_param2_ = 0;
+  storage_dtype_ = TENSOR_DTYPE_NONE;
+  initializer_salt_ = 0;
 }
 
 template <typename T, typename I>
-void SparseRowMatrix<T, I>::upsert(const SparseRowMatrix& other) {
-  if (col() != other.col()) {
-    DXTHROW_INVALID_ARGUMENT("Inconsistent col: %d vs %d.", col(), other.col());
-  }
+void SparseRowMatrix<T, I>::zeros() noexcept {
+  row_map_.clear();
+  half_row_map_.clear();
+}
 
-  row_map_.reserve(row_map_.size() + other.row_map_.size());
-  for (const auto& entry : other.row_map_) {
-    assign(entry.first, entry.second.data());
-  }
+template <typename T, typename I>
+void SparseRowMatrix<T, I>::upsert(const SparseRowMatrix& other) {
+  upsert_if(other, [](int_t /*row*/) { return true; });
 }
 
 template <typename T, typename I>
@@ -500,37 +795,30 @@ void SparseRowMatrix<T, I>::upsert_if(const SparseRowMatrix& other,
     DXTHROW_INVALID_ARGUMENT("Inconsistent col: %d vs %d.", col(), other.col());
   }
 
-  row_map_.reserve(row_map_.size() + other.row_map_.size());
-  for (const auto& entry : other.row_map_) {
-    if (func(entry)) {
-      assign(entry.first, entry.second.data());
+  reserve(size() + other.size());
+  if (IsHalfDtype(storage_dtype_) && storage_dtype_ == other.storage_dtype_) {
+    for (const auto& entry : other.half_row_map_) {
+      if (func(entry.first)) {
+        assign_half(entry.first, entry.second.data());
+      }
     }
+  } else {
+    other.for_each_row([this, &func](int_t row, cptr_t row_value) {
+      if (func(row)) {
+        assign(row, row_value);
+      }
+    });
   }
 }
 
 template <typename T, typename I>
 void SparseRowMatrix<T, I>::merge(const SparseRowMatrix& other) {
-  if (col() != other.col()) {
-    DXTHROW_INVALID_ARGUMENT("Inconsistent col: %d vs %d.", col(), other.col());
-  }
-
-  row_map_.reserve(row_map_.size() + other.row_map_.size());
-  for (const auto& entry : other.row_map_) {
-    row_map_.emplace(entry);
-  }
+  merge_if(other, [](int_t /*row*/) { return true; });
 }
 
 template <typename T, typename I>
 void SparseRowMatrix<T, I>::merge(SparseRowMatrix&& other) {
-  if (col() != other.col()) {
-    DXTHROW_INVALID_ARGUMENT("Inconsistent col: %d vs %d.", col(), other.col());
-  }
-
-  row_map_.reserve(row_map_.size() + other.row_map_.size());
-  for (auto& entry : other.row_map_) {
-    row_map_.emplace(entry.first, std::move(entry.second));
-  }
-  other.zeros();
+  merge_if(std::move(other), [](int_t /*row*/) { return true; });
 }
 
 template <typename T, typename I>
@@ -541,11 +829,16 @@ void SparseRowMatrix<T, I>::merge_if(const SparseRowMatrix& other,
     DXTHROW_INVALID_ARGUMENT("Inconsistent col: %d vs %d.", col(), other.col());
   }
 
-  row_map_.reserve(row_map_.size() + other.row_map_.size());
-  for (const auto& entry : other.row_map_) {
-    if (func(entry)) {
-      row_map_.emplace(entry);
-    }
+  if (storage_dtype_ == other.storage_dtype_) {
+    merge_map_if(&row_map_, other.row_map_, func);
+    merge_map_if(&half_row_map_, other.half_row_map_, func);
+  } else {
+    reserve(size() + other.size());
+    other.for_each_row([this, &func](int_t row, cptr_t row_value) {
+      if (func(row) && !has_row(row)) {
+        assign(row, row_value);
+      }
+    });
   }
 }
 
@@ -556,45 +849,92 @@ void SparseRowMatrix<T, I>::merge_if(SparseRowMatrix&& other, Func&& func) {
     DXTHROW_INVALID_ARGUMENT("Inconsistent col: %d vs %d.", col(), other.col());
   }
 
-  row_map_.reserve(row_map_.size() + other.row_map_.size());
-  for (auto& entry : other.row_map_) {
-    if (func(entry)) {
-      row_map_.emplace(entry.first, std::move(entry.second));
-    }
+  if (storage_dtype_ == other.storage_dtype_) {
+    merge_map_if(&row_map_, std::move(other.row_map_), func);
+    merge_map_if(&half_row_map_, std::move(other.half_row_map_), func);
+  } else {
+    merge_if((const SparseRowMatrix&)other, func);
   }
   other.zeros();
 }
 
 template <typename T, typename I>
 void SparseRowMatrix<T, I>::assign(int_t row, cptr_t row_value) {
+  if (IsHalfDtype(storage_dtype_)) {
+    auto& value = half_row_map_[row];
+    value.resize(col());
+    HalfEncode(storage_dtype_, col(), row_value, &value[0]);
+    return;
+  }
+
   auto& value = row_map_[row];
   value.resize(col());
   memcpy(&value[0], row_value, col() * sizeof(float_t));
 }
 
+template <typename T, typename I>
+template <class RandomEngine>
+void SparseRowMatrix<T, I>::assign_stochastic(RandomEngine&& engine, int_t row,
+                                              cptr_t row_value) {
+  if (IsHalfDtype(storage_dtype_)) {
+    auto& value = half_row_map_[row];
+    value.resize(col());
+    HalfEncode(storage_dtype_, engine, col(), row_value, &value[0]);
+    return;
+  }
+
+  assign(row, row_value);
+}
+
 template <typename T, typename I>
 void SparseRowMatrix<T, I>::assign_view(int_t row, cptr_t row_value) {
+  DXASSERT(!IsHalfDtype(storage_dtype_));
   auto& value = row_map_[row];
   value.view(row_value, col());
 }
 
+template <typename T, typename I>
+void SparseRowMatrix<T, I>::assign_half_view(int_t row,
+                                             const uint16_t* row_value) {
+  DXASSERT(IsHalfDtype(storage_dtype_));
+  auto& value = half_row_map_[row];
+  value.view(row_value, col());
+}
+
 template <typename T, typename I>
 template <class Func>
 void SparseRowMatrix<T, I>::remove_if(Func&& func) {
-  auto first = row_map_.begin();
-  auto last = row_map_.end();
-  for (; first != last;) {
-    if (func(*first)) {
-      first = row_map_.erase(first);
-    } else {
-      ++first;
+  remove_map_if(&row_map_, [&func](const typename map_t::value_type& entry) {
+    return func(entry.first);
+  });
+  remove_map_if(&half_row_map_,
+                [&func](const typename half_map_t::value_type& entry) {
+                  return func(entry.first);
+                });
+}
+
+template <typename T, typename I>
+size_t SparseRowMatrix<T, I>::erase(int_t row) {
+  if (IsHalfDtype(storage_dtype_)) {
+    auto it = half_row_map_.find(row);
+    if (it == half_row_map_.end()) {
+      return 0;
     }
+    half_row_map_.erase(it);
+    return 1;
   }
+
+  auto it = row_map_.find(row);
+  if (it == row_map_.end()) {
+    return 0;
+  }
+  row_map_.erase(it);
+  return 1;
 }
 
 template <typename T, typename I>
 void SparseRowMatrix<T, I>::remove_zeros() {
-  remove_if([this](const value_type& entry) {
+  remove_map_if(&row_map_, [this](const typename map_t::value_type& entry) {
     for (int i = 0; i < col(); ++i) {
       if (entry.second[i] != 0) {
         return false;
@@ -602,22 +942,22 @@ void SparseRowMatrix<T, I>::remove_zeros() {
     }
     return true;
   });
+  remove_map_if(&half_row_map_,
+                [this](const typename half_map_t::value_type& entry) {
+                  for (int i = 0; i < col(); ++i) {
+                    // either +0 or -0
+                    if ((entry.second[i] & 0x7fff) != 0) {
+                      return false;
+                    }
+                  }
+                  return true;
+                });
 }
 
 template <typename T, typename I>
 void SparseRowMatrix<T, I>::upsert(const SparseRowMatrix& other,
                                    ReadWriteLock* lock) {
-  if (col() != other.col()) {
-    DXTHROW_INVALID_ARGUMENT("Inconsistent col: %d vs %d.", col(), other.col());
-  }
-
-  {
-    WriteLockGuard guard(lock);
-    row_map_.reserve(row_map_.size() + other.row_map_.size());
-  }
-  for (const auto& entry : other.row_map_) {
-    assign(entry.first, entry.second.data(), lock);
-  }
+  upsert_if(other, [](int_t /*row*/) { return true; }, lock);
 }
 
 template <typename T, typename I>
@@ -630,12 +970,21 @@ void SparseRowMatrix<T, I>::upsert_if(const SparseRowMatrix& other, Func&& func,
 
   {
     WriteLockGuard guard(lock);
-    row_map_.reserve(row_map_.size() + other.row_map_.size());
+    reserve(size() + other.size());
   }
-  for (const auto& entry : other.row_map_) {
-    if (func(entry)) {
-      assign(entry.first, entry.second.data(), lock);
+  if (IsHalfDtype(storage_dtype_) && storage_dtype_ == other.storage_dtype_) {
+    for (const auto& entry : other.half_row_map_) {
+      if (func(entry.first)) {
+        WriteLockGuard guard(lock);
+        assign_half(entry.first, entry.second.data());
+      }
     }
+  } else {
+    other.for_each_row([this, &func, lock](int_t row, cptr_t row_value) {
+      if (func(row)) {
+        assign(row, row_value, lock);
+      }
+    });
   }
 }
 
@@ -643,14 +992,23 @@ template <typename T, typename I>
 void SparseRowMatrix<T, I>::assign(int_t row, cptr_t row_value,
                                    ReadWriteLock* lock) {
   WriteLockGuard guard(lock);
-  ptr_t value = get_row_no_init(row);
-  memcpy(value, row_value, col() * sizeof(float_t));
+  assign(row, row_value);
+}
+
+template <typename T, typename I>
+template <class RandomEngine>
+void SparseRowMatrix<T, I>::assign_stochastic(RandomEngine&& engine, int_t row,
+                                              cptr_t row_value,
+                                              ReadWriteLock* lock) {
+  WriteLockGuard guard(lock);
+  assign_stochastic(engine, row, row_value);
 }
 
 template <typename T, typename I>
 template <class RandomEngine>
 inline auto SparseRowMatrix<T, I>::get_row(RandomEngine&& engine, int_t row)
     -> ptr_t {
+  DXASSERT(!IsHalfDtype(storage_dtype_));
   auto it = row_map_.find(row);
   if (it != row_map_.end()) {
     return &it->second[0];
@@ -658,37 +1016,13 @@ inline auto SparseRowMatrix<T, I>::get_row(RandomEngine&& engine, int_t row)
 
   auto& value = row_map_[row];
   value.resize(col());
-  switch (initializer_type_) {
-    case TENSOR_INITIALIZER_TYPE_ONES: {
-      for (int i = 0; i < col(); ++i) {
-        value[i] = 1;
-      }
-    } break;
-    case TENSOR_INITIALIZER_TYPE_CONSTANT: {
-      for (int i = 0; i < col(); ++i) {
-        value[i] = initializer_param1_;
-      }
-    } break;
-    case TENSOR_INITIALIZER_TYPE_RAND: {
-      std::uniform_real_distribution<float_t> dist(initializer_param1_,
-                                                   initializer_param2_);
-      for (int i = 0; i < col(); ++i) {
-        value[i] = dist(engine);
-      }
-    } break;
-    case TENSOR_INITIALIZER_TYPE_RANDN: {
-      std::normal_distribution<float_t> dist(initializer_param1_,
-                                             initializer_param2_);
-      for (int i = 0; i < col(); ++i) {
-        value[i] = dist(engine);
-      }
-    } break;
-  }
+  init_row(engine, row, &value[0]);
   return &value[0];
 }
 
 template <typename T, typename I>
 inline auto SparseRowMatrix<T, I>::get_row_no_init(int_t row) -> ptr_t {
+  DXASSERT(!IsHalfDtype(storage_dtype_));
   auto it = row_map_.find(row);
   if (it != row_map_.end()) {
     return &it->second[0];
@@ -721,24 +1055,7 @@ inline auto SparseRowMatrix<T, I>::get_scalar(RandomEngine&& engine, int_t row)
 
   auto& value = row_map_[row];
   value.resize(1);
-  switch (initializer_type_) {
-    case TENSOR_INITIALIZER_TYPE_ONES: {
-      value[0] = 1;
-    } break;
-    case TENSOR_INITIALIZER_TYPE_CONSTANT: {
-      value[0] = initializer_param1_;
-    } break;
-    case TENSOR_INITIALIZER_TYPE_RAND: {
-      std::uniform_real_distribution<float_t> dist(initializer_param1_,
-                                                   initializer_param2_);
-      value[0] = dist(engine);
-    } break;
-    case TENSOR_INITIALIZER_TYPE_RANDN: {
-      std::normal_distribution<float_t> dist(initializer_param1_,
-                                             initializer_param2_);
-      value[0] = dist(engine);
-    } break;
-  }
+  init_row(engine, row, &value[0]);
   return value[0];
 }
 
@@ -770,6 +1087,7 @@ template <typename T, typename I>
 template <class RandomEngine>
 inline auto SparseRowMatrix<T, I>::get_row(RandomEngine&& engine, int_t row,
                                            ReadWriteLock* lock) -> ptr_t {
+  DXASSERT(!IsHalfDtype(storage_dtype_));
   {
     ReadLockGuard guard(lock);
     auto it = row_map_.find(row);
@@ -782,32 +1100,7 @@ inline auto SparseRowMatrix<T, I>::get_row(RandomEngine&& engine, int_t row,
     WriteLockGuard guard(lock);
     auto& value = row_map_[row];
     value.resize(col());
-    switch (initializer_type_) {
-      case TENSOR_INITIALIZER_TYPE_ONES: {
-        for (int i = 0; i < col(); ++i) {
-          value[i] = 1;
-        }
-      } break;
-      case TENSOR_INITIALIZER_TYPE_CONSTANT: {
-        for (int i = 0; i < col(); ++i) {
-          value[i] = initializer_param1_;
-        }
-      } break;
-      case TENSOR_INITIALIZER_TYPE_RAND: {
-        std::uniform_real_distribution<float_t> dist(initializer_param1_,
-                                                     initializer_param2_);
-        for (int i = 0; i < col(); ++i) {
-          value[i] = dist(engine);
-        }
-      } break;
-      case TENSOR_INITIALIZER_TYPE_RANDN: {
-        std::normal_distribution<float_t> dist(initializer_param1_,
-                                               initializer_param2_);
-        for (int i = 0; i < col(); ++i) {
-          value[i] = dist(engine);
-        }
-      } break;
-    }
+    init_row(engine, row, &value[0]);
     return &value[0];
   }
 }
@@ -816,6 +1109,7 @@ template <typename T, typename I>
 inline auto SparseRowMatrix<T, I>::get_row_no_init(int_t row,
                                                    ReadWriteLock* lock)
     -> ptr_t {
+  DXASSERT(!IsHalfDtype(storage_dtype_));
   {
     ReadLockGuard guard(lock);
     auto it = row_map_.find(row);
@@ -861,24 +1155,7 @@ inline auto SparseRowMatrix<T, I>::get_scalar(RandomEngine&& engine, int_t row,
     WriteLockGuard guard(lock);
     auto& value = row_map_[row];
     value.resize(1);
-    switch (initializer_type_) {
-      case TENSOR_INITIALIZER_TYPE_ONES: {
-        value[0] = 1;
-      } break;
-      case TENSOR_INITIALIZER_TYPE_CONSTANT: {
-        value[0] = initializer_param1_;
-      } break;
-      case TENSOR_INITIALIZER_TYPE_RAND: {
-        std::uniform_real_distribution<float_t> dist(initializer_param1_,
-                                                     initializer_param2_);
-        value[0] = dist(engine);
-      } break;
-      case TENSOR_INITIALIZER_TYPE_RANDN: {
-        std::normal_distribution<float_t> dist(initializer_param1_,
-                                               initializer_param2_);
-        value[0] = dist(engine);
-      } break;
-    }
+    init_row(engine, row, &value[0]);
     return value[0];
   }
 }
@@ -917,6 +1194,78 @@ inline auto SparseRowMatrix<T, I>::get_scalar_no_init(int_t row,
   return 0;
 }
 
+template <typename T, typename I>
+template <class RandomEngine>
+inline const uint16_t* SparseRowMatrix<T, I>::get_half_row(
+    RandomEngine&& engine, int_t row) {
+  auto it = half_row_map_.find(row);
+  if (it != half_row_map_.end()) {
+    return &it->second[0];
+  }
+
+  auto& value = half_row_map_[row];
+  value.resize(col());
+  init_half_row(engine, row, &value[0]);
+  return &value[0];
+}
+
+template <typename T, typename I>
+inline const uint16_t* SparseRowMatrix<T, I>::get_half_row_no_init(
+    int_t row) const noexcept {
+  auto it = half_row_map_.find(row);
+  if (it != half_row_map_.end()) {
+    return &it->second[0];
+  }
+  return nullptr;
+}
+
+template <typename T, typename I>
+bool SparseRowMatrix<T, I>::decode_row(int_t row, ptr_t row_value) const {
+  if (IsHalfDtype(storage_dtype_)) {
+    const uint16_t* value = get_half_row_no_init(row);
+    if (value == nullptr) {
+      return false;
+    }
+    HalfDecode(storage_dtype_, col(), value, row_value);
+    return true;
+  }
+
+  cptr_t value = get_row_no_init(row);
+  if (value == nullptr) {
+    return false;
+  }
+  memcpy(row_value, value, col() * sizeof(float_t));
+  return true;
+}
+
+template <typename T, typename I>
+template <class RandomEngine>
+inline const uint16_t* SparseRowMatrix<T, I>::get_half_row(
+    RandomEngine&& engine, int_t row, ReadWriteLock* lock) {
+  {
+    ReadLockGuard guard(lock);
+    auto it = half_row_map_.find(row);
+    if (it != half_row_map_.end()) {
+      return &it->second[0];
+    }
+  }
+
+  {
+    WriteLockGuard guard(lock);
+    auto& value = half_row_map_[row];
+    value.resize(col());
+    init_half_row(engine, row, &value[0]);
+    return &value[0];
+  }
+}
+
+template <typename T, typename I>
+bool SparseRowMatrix<T, I>::decode_row(int_t row, ptr_t row_value,
+                                       ReadWriteLock* lock) const {
+  ReadLockGuard guard(lock);
+  return decode_row(row, row_value);
+}
+
 template <typename T, typename I>
 bool SparseRowMatrix<T, I>::operator==(const SparseRowMatrix& right) const
     noexcept {
@@ -926,7 +1275,8 @@ bool SparseRowMatrix<T, I>::operator==(const SparseRowMatrix& right) const
 
   if (initializer_type_ != right.initializer_type_ ||
       initializer_param1_ != right.initializer_param1_ ||
-      initializer_param2_ != right.initializer_param2_) {
+      initializer_param2_ != right.initializer_param2_ ||
+      storage_dtype_ != right.storage_dtype_) {
     return false;
   }
 
@@ -934,7 +1284,7 @@ bool SparseRowMatrix<T, I>::operator==(const SparseRowMatrix& right) const
     return false;
   }
 
-  return row_map_ == right.row_map_;
+  return row_map_ == right.row_map_ && half_row_map_ == right.half_row_map_;
 }
 
 /************************************************************************/
@@ -5,6 +5,7 @@
 #pragma once
 #include <deepx_core/common/stream.h>
 #include <deepx_core/dx_log.h>
+#include <deepx_core/tensor/philox.h>
 #include <deepx_core/tensor/shape.h>
 #include <deepx_core/tensor/tensor_type.h>
 #include <algorithm>  // std::equal, ...
@@ -1070,10 +1071,7 @@ template <class RandomEngine>
 Tensor<T>& Tensor<T>::rand(RandomEngine&& engine, value_type _min,
                            value_type _max) noexcept {
   static_assert(IS_FLOAT, "");
-  std::uniform_real_distribution<value_type> dist(_min, _max);
-  for (int i = 0; i < total_dim(); ++i) {
-    data_[i] = dist(engine);
-  }
+  RandUniform(engine, total_dim(), data_, _min, _max);
   return *this;
 }
 
@@ -1089,10 +1087,7 @@ template <class RandomEngine>
 Tensor<T>& Tensor<T>::randn(RandomEngine&& engine, value_type mean,
                             value_type stddev) noexcept {
   static_assert(IS_FLOAT, "");
-  std::normal_distribution<value_type> dist(mean, stddev);
-  for (int i = 0; i < total_dim(); ++i) {
-    data_[i] = dist(engine);
-  }
+  RandNormal(engine, total_dim(), data_, mean, stddev);
   return *this;
 }
 
@@ -1108,15 +1103,7 @@ template <class RandomEngine>
 Tensor<T>& Tensor<T>::randn_truncated(RandomEngine&& engine, value_type mean,
                                       value_type stddev) noexcept {
   static_assert(IS_FLOAT, "");
-  std::normal_distribution<value_type> dist(mean, stddev);
-  value_type upper = mean + 2 * stddev;
-  value_type lower = mean - 2 * stddev;
-  for (int i = 0; i < total_dim();) {
-    data_[i] = dist(engine);
-    if (data_[i] <= upper && data_[i] >= lower) {
-      ++i;
-    }
-  }
+  RandNormalTruncated(engine, total_dim(), data_, mean, stddev);
   return *this;
 }
 
@@ -23,6 +23,7 @@ enum TENSOR_DTYPE {
   TENSOR_DTYPE_UINT16 = 10,
   TENSOR_DTYPE_UINT32 = 11,
   TENSOR_DTYPE_UINT64 = 12,
+  TENSOR_DTYPE_BFLOAT16 = 13,
 };
 
 /************************************************************************/
@@ -35,6 +36,8 @@ enum TENSOR_TYPE {
   TENSOR_TYPE_CSR = 3,
   TENSOR_TYPE_TSRI = 4,
   TENSOR_TYPE_TSRS = 5,
+  TENSOR_TYPE_QTSR = 6,
+  TENSOR_TYPE_QSRM = 7,
   TENSOR_TYPE_SRP = 10,  // backward compatibility
   TENSOR_TYPE_SVP = 11,  // backward compatibility
   TENSOR_TYPE_SRG = 12,  // backward compatibility
@@ -323,6 +323,14 @@ TEST_F(ConstArrayViewTest, Compare_std_string) {
   EXPECT_FALSE(csv != S234);
   EXPECT_TRUE(S234 == csv);
   EXPECT_FALSE(S234 != csv);
+
+  // not null terminated
+  std::string s2345 = S234 + "5";
+  const_string_view csv234(s2345.data(), S234.size());
+  EXPECT_TRUE(csv234 == S234);
+  EXPECT_TRUE(S234 == csv234);
+  EXPECT_FALSE(csv234 == s2345);
+  EXPECT_FALSE(s2345 == csv234);
 }
 
 TEST_F(ConstArrayViewTest, WriteReadView) {
@@ -0,0 +1,538 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/common/chunked_stream.h>
+#include <deepx_core/common/hash.h>
+#include <deepx_core/dx_log.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <utility>
+
+namespace deepx_core {
+namespace {
+
+constexpr uint64_t CHUNKED_FILE_MAGIC = UINT64_C(0x6b6e7568635f7864);
+// version 0: uncompressed chunks
+// version 1: a codec follows the version
+constexpr int CHUNKED_FILE_VERSION = 1;
+constexpr int CHUNK_CODEC_NONE = 0;
+constexpr int CHUNK_CODEC_LZ4_FRAME = 1;
+constexpr uint64_t CHECKSUM_SEED = UINT64_C(0x5bd1e9955bd1e995);
+
+int GetThreadSize(int thread_size) noexcept {
+  if (thread_size > 0) {
+    return thread_size;
+  }
+  thread_size = (int)std::thread::hardware_concurrency();
+  return thread_size > 0 ? thread_size : 1;
+}
+
+uint64_t GetChecksum(const std::string& data) noexcept {
+  return MurmurHash2(data.data(), data.size(), CHECKSUM_SEED);
+}
+
+}  // namespace
+
+/************************************************************************/
+/* Chunked file format */
+/************************************************************************/
+std::string GetChunkFile(const std::string& file, int chunk_id) {
+  return file + ".chunk." + std::to_string(chunk_id);
+}
+
+bool IsChunkedFile(const std::string& file) {
+  AutoInputFileStream is;
+  if (!is.Open(file)) {
+    return false;
+  }
+  uint64_t magic;
+  return is.Peek(&magic, sizeof(magic)) == sizeof(magic) &&
+         magic == CHUNKED_FILE_MAGIC;
+}
+
+bool SaveFile(const std::string& file, size_t chunk_size,
+              const std::function<bool(OutputStream&)>& func,
+              bool compress) {
+  if (chunk_size == 0) {
+    AutoOutputFileStream os;
+    if (!os.Open(file)) {
+      DXERROR("Failed to open: %s.", file.c_str());
+      return false;
+    }
+    if (!compress) {
+      return func(os);
+    }
+    LZ4FrameOutputStream lz4_os(&os);
+    bool ok = func(lz4_os);
+    return lz4_os.Close() && ok;
+  }
+
+  ChunkedOutputFileStream os(chunk_size);
+  os.set_compress(compress);
+  if (!os.Open(file)) {
+    DXERROR("Failed to open: %s.", file.c_str());
+    return false;
+  }
+  bool ok = func(os);
+  return os.Close() && ok;
+}
+
+/************************************************************************/
+/* ChunkedOutputFileStream */
+/************************************************************************/
+ChunkedOutputFileStream::ChunkedOutputFileStream(size_t chunk_size,
+                                                 int thread_size)
+    : chunk_size_(chunk_size > 0 ? chunk_size : 1),
+      thread_size_(GetThreadSize(thread_size)) {
+  bad_ = 1;
+}
+
+ChunkedOutputFileStream::~ChunkedOutputFileStream() {
+  if (IsOpen()) {
+    (void)Close();
+  }
+}
+
+size_t ChunkedOutputFileStream::Write(const void* data, size_t size) {
+  if (bad_) {
+    return 0;
+  }
+
+  const char* p = (const char*)data;
+  size_t left = size;
+  while (left > 0) {
+    size_t n = std::min(left, chunk_size_ - buf_.size());
+    buf_.append(p, n);
+    p += n;
+    left -= n;
+    if (buf_.size() == chunk_size_) {
+      PostChunk();
+      if (bad_) {
+        return size - left;
+      }
+    }
+  }
+  return size;
+}
+
+bool ChunkedOutputFileStream::Open(const std::string& file) {
+  if (IsOpen()) {
+    (void)Close();
+  }
+
+  // Fail early if the manifest can not be written.
+  AutoOutputFileStream os;
+  if (!os.Open(file)) {
+    return false;
+  }
+
+  file_ = file;
+  buf_.clear();
+  chunks_.clear();
+  pending_ = 0;
+  failed_ = 0;
+  thread_pool_.start(thread_size_);
+  bad_ = 0;
+  return true;
+}
+
+bool ChunkedOutputFileStream::WriteChunk(std::string* data) {
+  if (bad_) {
+    return false;
+  }
+
+  if (!buf_.empty()) {
+    PostChunk();
+    if (bad_) {
+      return false;
+    }
+  }
+  buf_.swap(*data);
+  PostChunk();
+  data->clear();
+  return !bad_;
+}
+
+bool ChunkedOutputFileStream::Close() {
+  if (!IsOpen()) {
+    return false;
+  }
+
+  if (!bad_ && !buf_.empty()) {
+    PostChunk();
+  }
+  thread_pool_.stop();
+
+  bool ok = !bad_ && !failed_;
+  if (ok) {
+    AutoOutputFileStream os;
+    if (os.Open(file_)) {
+      // Uncompressed files are written in version 0 for old readers.
+      if (compress_) {
+        os << CHUNKED_FILE_MAGIC << CHUNKED_FILE_VERSION
+           << CHUNK_CODEC_LZ4_FRAME;
+      } else {
+        os << CHUNKED_FILE_MAGIC << 0;
+      }
+      os << (int)chunks_.size();
+      for (const Chunk& chunk : chunks_) {
+        os << chunk.size << chunk.checksum;
+      }
+      ok = os && os.Flush();
+    } else {
+      ok = false;
+    }
+    if (!ok) {
+      DXERROR("Failed to write chunk manifest: %s.", file_.c_str());
+    }
+  }
+
+  file_.clear();
+  std::string().swap(buf_);
+  chunks_.clear();
+  bad_ = 1;
+  return ok;
+}
+
+void ChunkedOutputFileStream::PostChunk() {
+  int chunk_id;
+  {
+    // Bound the number of chunks in memory.
+    std::unique_lock<std::mutex> guard(mutex_);
+    cond_.wait(guard, [this]() { return pending_ < thread_size_; });
+    if (failed_) {
+      bad_ = 1;
+      buf_.clear();
+      return;
+    }
+    chunk_id = (int)chunks_.size();
+    chunks_.emplace_back();
+    ++pending_;
+  }
+
+  std::shared_ptr<std::string> buf(new std::string);
+  buf->swap(buf_);
+  buf_.reserve(chunk_size_);
+  thread_pool_.post([this, chunk_id, buf]() {
+    std::string file = GetChunkFile(file_, chunk_id);
+    Chunk chunk;
+    chunk.size = buf->size();
+    chunk.checksum = GetChecksum(*buf);
+
+    bool ok = true;
+    if (compress_) {
+      std::string compressed;
+      ok = LZ4FrameCompress(buf->data(), buf->size(), &compressed);
+      buf->swap(compressed);
+    }
+
+    AutoOutputFileStream os;
+    ok = ok && os.Open(file) &&
+         os.Write(buf->data(), buf->size()) == buf->size() && os.Flush();
+    if (!ok) {
+      DXERROR("Failed to write chunk: %s.", file.c_str());
+    }
+    buf->clear();
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    chunks_[chunk_id] = chunk;
+    if (!ok) {
+      failed_ = 1;
+    }
+    --pending_;
+    cond_.notify_all();
+  });
+}
+
+/************************************************************************/
+/* ChunkedInputFileStream */
+/************************************************************************/
+ChunkedInputFileStream::ChunkedInputFileStream(int thread_size)
+    : thread_size_(GetThreadSize(thread_size)) {
+  bad_ = 1;
+}
+
+ChunkedInputFileStream::~ChunkedInputFileStream() { Close(); }
+
+size_t ChunkedInputFileStream::Read(void* data, size_t size) {
+  if (ordinary_) {
+    size_t bytes = ordinary_->Read(data, size);
+    bad_ = ordinary_->bad();
+    return bytes;
+  }
+
+  if (bad_) {
+    return 0;
+  }
+
+  char* p = (char*)data;
+  size_t bytes = 0;
+  while (bytes < size) {
+    if (cur_ >= (int)chunks_.size() || !WaitChunk(cur_)) {
+      bad_ = 1;
+      break;
+    }
+    const std::string& chunk_data = chunks_[cur_].data;
+    size_t n = std::min(size - bytes, chunk_data.size() - offset_);
+    memcpy(p + bytes, chunk_data.data() + offset_, n);
+    offset_ += n;
+    bytes += n;
+    if (offset_ == chunk_data.size()) {
+      NextChunk();
+    }
+  }
+  return bytes;
+}
+
+char ChunkedInputFileStream::ReadChar() {
+  char c = 0;
+  (void)Read(&c, 1);
+  return c;
+}
+
+size_t ChunkedInputFileStream::Peek(void* data, size_t size) {
+  if (ordinary_) {
+    size_t bytes = ordinary_->Peek(data, size);
+    bad_ = ordinary_->bad();
+    return bytes;
+  }
+
+  if (bad_) {
+    return 0;
+  }
+
+  char* p = (char*)data;
+  size_t bytes = 0;
+  size_t offset = offset_;
+  for (int chunk_id = cur_; bytes < size && chunk_id < (int)chunks_.size();
+       ++chunk_id) {
+    while (chunk_id >= next_post_) {
+      PostChunk();
+    }
+    if (!WaitChunk(chunk_id)) {
+      break;
+    }
+    const std::string& chunk_data = chunks_[chunk_id].data;
+    size_t n = std::min(size - bytes, chunk_data.size() - offset);
+    memcpy(p + bytes, chunk_data.data() + offset, n);
+    bytes += n;
+    offset = 0;
+  }
+  return bytes;
+}
+
+bool ChunkedInputFileStream::Open(const std::string& file) {
+  Close();
+
+  std::unique_ptr<AutoInputFileStream> is(new AutoInputFileStream);
+  if (!is->Open(file)) {
+    return false;
+  }
+
+  uint64_t magic = 0;
+  size_t magic_bytes = is->Peek(&magic, sizeof(magic));
+  if (magic_bytes != sizeof(magic) || magic != CHUNKED_FILE_MAGIC) {
+    // An ordinary file, reopen it to clear the state of 'Peek',
+    // and read it ahead, since it may be a large model file.
+    bool lz4 = IsLZ4Frame(&magic, magic_bytes);
+    is->set_read_ahead(true);
+    if (!is->Open(file)) {
+      return false;
+    }
+    is_ = std::move(is);
+    if (lz4) {
+      lz4_is_.reset(new LZ4FrameInputStream(is_.get()));
+      ordinary_ = lz4_is_.get();
+    } else {
+      ordinary_ = is_.get();
+    }
+    bad_ = 0;
+    return true;
+  }
+
+  if (!ReadManifest(*is)) {
+    DXERROR("Failed to read chunk manifest: %s.", file.c_str());
+    chunks_.clear();
+    return false;
+  }
+
+  file_ = file;
+  thread_pool_.reset(new ThreadPool);
+  thread_pool_->start(thread_size_);
+  while (next_post_ < thread_size_ && next_post_ < (int)chunks_.size()) {
+    PostChunk();
+  }
+  bad_ = 0;
+  return true;
+}
+
+void ChunkedInputFileStream::Close() noexcept {
+  if (thread_pool_) {
+    thread_pool_->stop();
+    thread_pool_.reset();
+  }
+  ordinary_ = nullptr;
+  lz4_is_.reset();
+  is_.reset();
+  file_.clear();
+  chunks_.clear();
+  codec_ = 0;
+  next_post_ = 0;
+  cur_ = 0;
+  offset_ = 0;
+  bad_ = 1;
+}
+
+bool ChunkedInputFileStream::ForEachChunk(
+    const std::function<bool(int, InputStringStream&)>& func) {
+  if (!thread_pool_ || bad_ || offset_ != 0) {
+    bad_ = 1;
+    return false;
+  }
+
+  // Wait for chunks read ahead, the others are read by 'thread_pool_'.
+  int posted = next_post_;
+  for (int chunk_id = cur_; chunk_id < posted; ++chunk_id) {
+    (void)WaitChunk(chunk_id);
+  }
+
+  std::atomic<bool> ok(true);
+  thread_pool_->parallel_for(
+      (size_t)cur_, chunks_.size(), 1, [this, posted, &func, &ok](size_t i) {
+        if (!ok) {
+          return;
+        }
+        int chunk_id = (int)i;
+        std::string data;
+        if (chunk_id < posted) {
+          std::lock_guard<std::mutex> guard(mutex_);
+          Chunk& chunk = chunks_[chunk_id];
+          if (!chunk.ok) {
+            ok = false;
+            return;
+          }
+          data.swap(chunk.data);
+        } else if (!ReadChunk(chunk_id, &data)) {
+          ok = false;
+          return;
+        }
+        InputStringStream is;
+        is.SetView(data);
+        if (!func(chunk_id, is)) {
+          ok = false;
+        }
+      });
+
+  cur_ = (int)chunks_.size();
+  next_post_ = cur_;
+  offset_ = 0;
+  if (!ok) {
+    bad_ = 1;
+  }
+  return ok;
+}
+
+bool ChunkedInputFileStream::ReadManifest(InputStream& is) {
+  uint64_t magic;
+  int version, size;
+  is >> magic >> version;
+  if (!is) {
+    return false;
+  }
+
+  if (version > CHUNKED_FILE_VERSION) {
+    DXERROR("Couldn't handle a higher version: %d.", version);
+    return false;
+  }
+
+  codec_ = CHUNK_CODEC_NONE;
+  if (version >= 1) {
+    is >> codec_;
+    if (codec_ != CHUNK_CODEC_NONE && codec_ != CHUNK_CODEC_LZ4_FRAME) {
+      DXERROR("Invalid chunk codec: %d.", codec_);
+      return false;
+    }
+  }
+
+  is >> size;
+  if (!is || size < 0) {
+    return false;
+  }
+
+  chunks_.resize(size);
+  for (Chunk& chunk : chunks_) {
+    is >> chunk.size >> chunk.checksum;
+  }
+  return (bool)is;
+}
+
+bool ChunkedInputFileStream::ReadChunk(int chunk_id, std::string* data) const {
+  std::string file = GetChunkFile(file_, chunk_id);
+  uint64_t size = chunks_[chunk_id].size;
+  uint64_t checksum = chunks_[chunk_id].checksum;
+  AutoInputFileStream is;
+  if (!is.Open(file)) {
+    DXERROR("Failed to open: %s.", file.c_str());
+    return false;
+  }
+
+  std::unique_ptr<LZ4FrameInputStream> lz4_is;
+  InputStream* chunk_is = &is;
+  if (codec_ == CHUNK_CODEC_LZ4_FRAME) {
+    // Decompress from the file to 'data' directly.
+    lz4_is.reset(new LZ4FrameInputStream(&is));
+    chunk_is = lz4_is.get();
+  }
+
+  data->resize((size_t)size);
+  char c;
+  if (chunk_is->Read(&(*data)[0], data->size()) != data->size() ||
+      chunk_is->Read(&c, 1) != 0) {
+    DXERROR("Inconsistent chunk size: %s.", file.c_str());
+    return false;
+  }
+  if (GetChecksum(*data) != checksum) {
+    DXERROR("Inconsistent chunk checksum: %s.", file.c_str());
+    return false;
+  }
+  return true;
+}
+
+void ChunkedInputFileStream::PostChunk() {
+  int chunk_id = next_post_++;
+  thread_pool_->post([this, chunk_id]() {
+    std::string data;
+    bool ok = ReadChunk(chunk_id, &data);
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    Chunk& chunk = chunks_[chunk_id];
+    chunk.data.swap(data);
+    chunk.done = 1;
+    chunk.ok = ok ? 1 : 0;
+    cond_.notify_all();
+  });
+}
+
+bool ChunkedInputFileStream::WaitChunk(int chunk_id) {
+  std::unique_lock<std::mutex> guard(mutex_);
+  const Chunk& chunk = chunks_[chunk_id];
+  cond_.wait(guard, [&chunk]() { return chunk.done != 0; });
+  return chunk.ok != 0;
+}
+
+void ChunkedInputFileStream::NextChunk() {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    std::string().swap(chunks_[cur_].data);
+  }
+  ++cur_;
+  offset_ = 0;
+  if (next_post_ < (int)chunks_.size()) {
+    PostChunk();
+  }
+}
+
+}  // namespace deepx_core
@@ -0,0 +1,229 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/common/chunked_stream.h>
+#include <gtest/gtest.h>
+#include <cstdio>  // std::remove
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace deepx_core {
+
+class ChunkedStreamTest : public testing::Test {
+ protected:
+  const std::string file = "chunked_stream_test.bin";
+  std::vector<int> values;
+
+ protected:
+  void SetUp() override {
+    for (int i = 0; i < 1000; ++i) {
+      values.emplace_back(i * 7);
+    }
+  }
+
+  void TearDown() override {
+    std::remove(file.c_str());
+    for (int i = 0; i < 1024; ++i) {
+      std::remove(GetChunkFile(file, i).c_str());
+    }
+  }
+
+  void Save(size_t chunk_size, int thread_size, bool compress = false) {
+    ChunkedOutputFileStream os(chunk_size, thread_size);
+    os.set_compress(compress);
+    ASSERT_TRUE(os.Open(file));
+    std::string s = "hello";
+    os << s << values;
+    ASSERT_TRUE(os);
+    ASSERT_TRUE(os.Close());
+  }
+
+  void Load(int thread_size) {
+    ChunkedInputFileStream is(thread_size);
+    ASSERT_TRUE(is.Open(file));
+    std::string s;
+    std::vector<int> read_values;
+    is >> s >> read_values;
+    ASSERT_TRUE(is);
+    EXPECT_EQ(s, "hello");
+    EXPECT_EQ(read_values, values);
+
+    char c;
+    EXPECT_EQ(is.Read(&c, 1), 0u);
+    EXPECT_FALSE(is);
+  }
+};
+
+TEST_F(ChunkedStreamTest, ReadWrite) {
+  for (size_t chunk_size : {16, 100, 4096, 1 << 20}) {
+    for (int thread_size : {1, 2, 4}) {
+      Save(chunk_size, thread_size);
+      EXPECT_TRUE(IsChunkedFile(file));
+      Load(thread_size);
+    }
+  }
+}
+
+TEST_F(ChunkedStreamTest, ReadWrite_Compress) {
+  for (size_t chunk_size : {16, 100, 4096, 1 << 20}) {
+    for (int thread_size : {1, 2, 4}) {
+      Save(chunk_size, thread_size, true);
+      EXPECT_TRUE(IsChunkedFile(file));
+      Load(thread_size);
+    }
+  }
+}
+
+TEST_F(ChunkedStreamTest, Peek) {
+  values.clear();
+  Save(3, 2);
+  ChunkedInputFileStream is(2);
+  ASSERT_TRUE(is.Open(file));
+  // The size of 's' crosses chunk boundaries.
+  int size = 0;
+  ASSERT_EQ(is.Peek(&size, sizeof(size)), sizeof(size));
+  EXPECT_EQ(size, 5);
+  size = 0;
+  ASSERT_EQ(is.Read(&size, sizeof(size)), sizeof(size));
+  EXPECT_EQ(size, 5);
+}
+
+TEST_F(ChunkedStreamTest, OrdinaryFile) {
+  ASSERT_TRUE(SaveFile(file, 0, [this](OutputStream& os) {
+    std::string s = "hello";
+    os << s << values;
+    return (bool)os;
+  }));
+  EXPECT_FALSE(IsChunkedFile(file));
+  Load(2);
+}
+
+TEST_F(ChunkedStreamTest, OrdinaryFile_Compress) {
+  ASSERT_TRUE(SaveFile(
+      file, 0,
+      [this](OutputStream& os) {
+        std::string s = "hello";
+        os << s << values;
+        return (bool)os;
+      },
+      true));
+  EXPECT_FALSE(IsChunkedFile(file));
+  {
+    AutoInputFileStream is;
+    ASSERT_TRUE(is.Open(file));
+    char magic[4];
+    ASSERT_EQ(is.Peek(magic, sizeof(magic)), sizeof(magic));
+    EXPECT_TRUE(IsLZ4Frame(magic, sizeof(magic)));
+  }
+  Load(2);
+}
+
+TEST_F(ChunkedStreamTest, Checksum) {
+  Save(100, 2);
+  {
+    AutoOutputFileStream os;
+    ASSERT_TRUE(os.Open(GetChunkFile(file, 1)));
+    std::string corrupted(100, 'x');
+    os.Write(corrupted.data(), corrupted.size());
+  }
+
+  ChunkedInputFileStream is(2);
+  ASSERT_TRUE(is.Open(file));
+  std::string s;
+  std::vector<int> read_values;
+  is >> s >> read_values;
+  EXPECT_FALSE(is);
+}
+
+TEST_F(ChunkedStreamTest, MissingChunk) {
+  Save(100, 2);
+  std::remove(GetChunkFile(file, 2).c_str());
+
+  ChunkedInputFileStream is(2);
+  ASSERT_TRUE(is.Open(file));
+  std::string s;
+  std::vector<int> read_values;
+  is >> s >> read_values;
+  EXPECT_FALSE(is);
+}
+
+TEST_F(ChunkedStreamTest, CorruptedCompressedChunk) {
+  Save(100, 2, true);
+  {
+    AutoOutputFileStream os;
+    ASSERT_TRUE(os.Open(GetChunkFile(file, 1)));
+    std::string corrupted(100, 'x');
+    os.Write(corrupted.data(), corrupted.size());
+  }
+
+  ChunkedInputFileStream is(2);
+  ASSERT_TRUE(is.Open(file));
+  std::string s;
+  std::vector<int> read_values;
+  is >> s >> read_values;
+  EXPECT_FALSE(is);
+}
+
+TEST_F(ChunkedStreamTest, ForEachChunk) {
+  const int chunks = 20;
+  for (bool compress : {false, true}) {
+    for (int thread_size : {1, 2, 4}) {
+      {
+        ChunkedOutputFileStream os(16, thread_size);
+        os.set_compress(compress);
+        ASSERT_TRUE(os.Open(file));
+        std::string s = "hello";
+        os << s;
+        for (int i = 0; i < chunks; ++i) {
+          // Chunks are larger than 'chunk_size'.
+          std::string buf;
+          OutputStringStream chunk_os;
+          chunk_os.SetView(&buf);
+          chunk_os << i << values;
+          ASSERT_TRUE(os.WriteChunk(&buf));
+        }
+        ASSERT_TRUE(os.Close());
+      }
+
+      ChunkedInputFileStream is(thread_size);
+      ASSERT_TRUE(is.Open(file));
+      std::string s;
+      is >> s;
+      ASSERT_TRUE(is);
+      EXPECT_EQ(s, "hello");
+
+      std::mutex mutex;
+      std::vector<int> read(chunks);
+      ASSERT_TRUE(is.ForEachChunk([this, &mutex, &read](
+                                      int /*chunk_id*/, InputStringStream& is) {
+        int i;
+        std::vector<int> read_values;
+        is >> i >> read_values;
+        if (!is || i < 0 || i >= (int)read.size() || read_values != values) {
+          return false;
+        }
+        std::lock_guard<std::mutex> guard(mutex);
+        ++read[i];
+        return true;
+      }));
+      EXPECT_EQ(read, std::vector<int>(chunks, 1));
+    }
+  }
+}
+
+TEST_F(ChunkedStreamTest, ForEachChunk_NotChunkBoundary) {
+  Save(16, 2);
+  ChunkedInputFileStream is(2);
+  ASSERT_TRUE(is.Open(file));
+  char c;
+  ASSERT_EQ(is.Read(&c, 1), 1u);
+  EXPECT_FALSE(
+      is.ForEachChunk([](int /*chunk_id*/, InputStringStream& /*is*/) {
+        return true;
+      }));
+  EXPECT_FALSE(is);
+}
+
+}  // namespace deepx_core
@@ -3,8 +3,12 @@
 //
 
 #include <deepx_core/common/compress.h>
+#include <deepx_core/dx_log.h>
 #include <lz4.h>
+#include <lz4frame.h>
 #include <lz4hc.h>
+#include <algorithm>  // std::min
+#include <cstring>    // memcpy
 
 namespace deepx_core {
 
@@ -63,4 +67,321 @@ bool Decompress(const std::string& in, std::string* out) {
   return Decompress(in.data(), (int)in.size(), out);
 }
 
+/************************************************************************/
+/* LZ4 frame functions */
+/************************************************************************/
+namespace {
+
+const size_t LZ4_FRAME_BLOCK_SIZE = 4 * 1024 * 1024;  // magic number
+const size_t LZ4_FRAME_IN_BUF_SIZE = 64 * 1024;       // magic number
+
+LZ4F_preferences_t GetLZ4FramePreferences(size_t content_size) noexcept {
+  LZ4F_preferences_t preferences;
+  memset(&preferences, 0, sizeof(preferences));
+  preferences.frameInfo.blockSizeID = LZ4F_max4MB;
+  preferences.frameInfo.blockMode = LZ4F_blockIndependent;
+  preferences.frameInfo.contentChecksumFlag = LZ4F_contentChecksumEnabled;
+  preferences.frameInfo.contentSize = content_size;
+  preferences.autoFlush = 1;
+  return preferences;
+}
+
+}  // namespace
+
+bool IsLZ4Frame(const void* data, size_t size) noexcept {
+  static const unsigned char MAGIC[4] = {0x04, 0x22, 0x4D, 0x18};
+  return size >= sizeof(MAGIC) && memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+bool LZ4FrameCompress(const char* in, size_t in_size, std::string* out) {
+  LZ4F_preferences_t preferences = GetLZ4FramePreferences(in_size);
+  out->resize(LZ4F_compressFrameBound(in_size, &preferences));
+  size_t out_size =
+      LZ4F_compressFrame(&(*out)[0], out->size(), in, in_size, &preferences);
+  if (LZ4F_isError(out_size)) {
+    DXERROR("Failed to compress: %s.", LZ4F_getErrorName(out_size));
+    out->clear();
+    return false;
+  }
+  out->resize(out_size);
+  return true;
+}
+
+bool LZ4FrameDecompress(const char* in, size_t in_size, std::string* out) {
+  LZ4F_dctx* ctx;
+  size_t ret = LZ4F_createDecompressionContext(&ctx, LZ4F_VERSION);
+  if (LZ4F_isError(ret)) {
+    DXERROR("Failed to create decompression context: %s.",
+            LZ4F_getErrorName(ret));
+    return false;
+  }
+
+  // Size 'out' by the content size in the frame header if it is known.
+  LZ4F_frameInfo_t frame_info;
+  size_t src_size = in_size;
+  ret = LZ4F_getFrameInfo(ctx, &frame_info, in, &src_size);
+  if (LZ4F_isError(ret)) {
+    DXERROR("Failed to decompress: %s.", LZ4F_getErrorName(ret));
+    (void)LZ4F_freeDecompressionContext(ctx);
+    out->clear();
+    return false;
+  }
+  in += src_size;
+  in_size -= src_size;
+
+  size_t out_size = 0;
+  out->clear();
+  out->resize(frame_info.contentSize > 0 ? (size_t)frame_info.contentSize
+                                         : LZ4_FRAME_BLOCK_SIZE);
+  for (;;) {
+    // The content size is unknown, or frames are concatenated.
+    if (out_size == out->size()) {
+      out->resize(out_size + LZ4_FRAME_BLOCK_SIZE);
+    }
+    size_t dst_size = out->size() - out_size;
+    src_size = in_size;
+    ret = LZ4F_decompress(ctx, &(*out)[out_size], &dst_size, in, &src_size,
+                          nullptr);
+    if (LZ4F_isError(ret)) {
+      DXERROR("Failed to decompress: %s.", LZ4F_getErrorName(ret));
+      break;
+    }
+    in += src_size;
+    in_size -= src_size;
+    out_size += dst_size;
+    if (ret == 0 && in_size == 0) {
+      break;
+    }
+    if (in_size == 0 && dst_size == 0) {
+      DXERROR("Truncated LZ4 frame.");
+      ret = 1;
+      break;
+    }
+  }
+  (void)LZ4F_freeDecompressionContext(ctx);
+  out->resize(ret == 0 ? out_size : 0);
+  return ret == 0;
+}
+
+/************************************************************************/
+/* LZ4FrameOutputStream */
+/************************************************************************/
+LZ4FrameOutputStream::LZ4FrameOutputStream(OutputStream* os) : os_(os) {
+  LZ4F_cctx* ctx;
+  size_t ret = LZ4F_createCompressionContext(&ctx, LZ4F_VERSION);
+  DXCHECK_THROW(!LZ4F_isError(ret));
+  ctx_ = ctx;
+  in_buf_.reserve(LZ4_FRAME_BLOCK_SIZE);
+}
+
+LZ4FrameOutputStream::~LZ4FrameOutputStream() {
+  (void)Close();
+  (void)LZ4F_freeCompressionContext((LZ4F_cctx*)ctx_);
+}
+
+bool LZ4FrameOutputStream::WriteOutBuf(size_t size) {
+  if (LZ4F_isError(size)) {
+    DXERROR("Failed to compress: %s.", LZ4F_getErrorName(size));
+    bad_ = 1;
+    return false;
+  }
+  if (os_->Write(out_buf_.data(), size) != size) {
+    bad_ = 1;
+    return false;
+  }
+  return true;
+}
+
+bool LZ4FrameOutputStream::CompressBuf() {
+  LZ4F_preferences_t preferences = GetLZ4FramePreferences(0);
+  LZ4F_cctx* ctx = (LZ4F_cctx*)ctx_;
+  if (!begun_) {
+    out_buf_.resize(LZ4F_HEADER_SIZE_MAX);
+    if (!WriteOutBuf(LZ4F_compressBegin(ctx, &out_buf_[0], out_buf_.size(),
+                                        &preferences))) {
+      return false;
+    }
+    begun_ = 1;
+  }
+
+  if (in_buf_.empty()) {
+    return true;
+  }
+  out_buf_.resize(LZ4F_compressBound(in_buf_.size(), &preferences));
+  size_t size = LZ4F_compressUpdate(ctx, &out_buf_[0], out_buf_.size(),
+                                    in_buf_.data(), in_buf_.size(), nullptr);
+  in_buf_.clear();
+  return WriteOutBuf(size);
+}
+
+size_t LZ4FrameOutputStream::Write(const void* data, size_t size) {
+  if (bad_ || closed_) {
+    bad_ = 1;
+    return 0;
+  }
+
+  const char* in = (const char*)data;
+  size_t left_bytes = size;
+  while (left_bytes > 0) {
+    size_t bytes =
+        std::min(left_bytes, LZ4_FRAME_BLOCK_SIZE - in_buf_.size());
+    in_buf_.append(in, bytes);
+    in += bytes;
+    left_bytes -= bytes;
+    if (in_buf_.size() == LZ4_FRAME_BLOCK_SIZE && !CompressBuf()) {
+      return 0;
+    }
+  }
+  return size;
+}
+
+bool LZ4FrameOutputStream::Flush() {
+  if (bad_ || closed_) {
+    return !bad_;
+  }
+  if (!CompressBuf() || !os_->Flush()) {
+    bad_ = 1;
+    return false;
+  }
+  return true;
+}
+
+bool LZ4FrameOutputStream::Close() {
+  if (closed_) {
+    return !bad_;
+  }
+  closed_ = 1;
+  if (bad_ || !CompressBuf()) {
+    return false;
+  }
+
+  LZ4F_preferences_t preferences = GetLZ4FramePreferences(0);
+  out_buf_.resize(LZ4F_compressBound(0, &preferences));
+  if (!WriteOutBuf(LZ4F_compressEnd((LZ4F_cctx*)ctx_, &out_buf_[0],
+                                    out_buf_.size(), nullptr)) ||
+      !os_->Flush()) {
+    bad_ = 1;
+    return false;
+  }
+  return true;
+}
+
+/************************************************************************/
+/* LZ4FrameInputStream */
+/************************************************************************/
+LZ4FrameInputStream::LZ4FrameInputStream(InputStream* is) : is_(is) {
+  LZ4F_dctx* ctx;
+  size_t ret = LZ4F_createDecompressionContext(&ctx, LZ4F_VERSION);
+  DXCHECK_THROW(!LZ4F_isError(ret));
+  ctx_ = ctx;
+  in_buf_.resize(LZ4_FRAME_IN_BUF_SIZE);
+}
+
+LZ4FrameInputStream::~LZ4FrameInputStream() {
+  (void)LZ4F_freeDecompressionContext((LZ4F_dctx*)ctx_);
+}
+
+size_t LZ4FrameInputStream::DecompressTo(char* data, size_t size) {
+  if (bad_) {
+    return 0;
+  }
+
+  for (;;) {
+    if (in_begin_ == in_end_) {
+      in_begin_ = 0;
+      in_end_ = is_->Read(&in_buf_[0], in_buf_.size());
+      if (in_end_ == 0) {
+        if (!frame_end_) {
+          DXERROR("Truncated LZ4 frame.");
+        }
+        bad_ = 1;
+        return 0;
+      }
+    }
+
+    size_t dst_size = size;
+    size_t src_size = in_end_ - in_begin_;
+    size_t ret = LZ4F_decompress((LZ4F_dctx*)ctx_, data, &dst_size,
+                                 &in_buf_[in_begin_], &src_size, nullptr);
+    if (LZ4F_isError(ret)) {
+      DXERROR("Failed to decompress: %s.", LZ4F_getErrorName(ret));
+      bad_ = 1;
+      return 0;
+    }
+    in_begin_ += src_size;
+    // A frame may be followed by another one.
+    frame_end_ = ret == 0;
+    if (dst_size > 0) {
+      return dst_size;
+    }
+  }
+}
+
+bool LZ4FrameInputStream::FillOutBuf() {
+  if (out_buf_.empty()) {
+    out_buf_.resize(LZ4_FRAME_BLOCK_SIZE);
+  }
+  size_t bytes = DecompressTo(&out_buf_[0], out_buf_.size());
+  cur_ = out_buf_.data();
+  end_ = cur_ + bytes;
+  return bytes > 0;
+}
+
+size_t LZ4FrameInputStream::Read(void* data, size_t size) {
+  char* out = (char*)data;
+  size_t need_bytes = size;
+  while (need_bytes > 0) {
+    if (cur_ == end_) {
+      if (need_bytes >= LZ4_FRAME_BLOCK_SIZE) {
+        // Skip 'out_buf_'.
+        size_t bytes = DecompressTo(out, need_bytes);
+        if (bytes == 0) {
+          break;
+        }
+        out += bytes;
+        need_bytes -= bytes;
+        continue;
+      }
+      if (!FillOutBuf()) {
+        break;
+      }
+    }
+    size_t bytes = std::min(need_bytes, (size_t)(end_ - cur_));
+    memcpy(out, cur_, bytes);
+    cur_ += bytes;
+    out += bytes;
+    need_bytes -= bytes;
+  }
+  return size - need_bytes;
+}
+
+char LZ4FrameInputStream::ReadChar() {
+  if (cur_ == end_ && !FillOutBuf()) {
+    return (char)-1;
+  }
+  return *cur_++;
+}
+
+size_t LZ4FrameInputStream::Peek(void* data, size_t size) {
+  if (size == 0 || (cur_ == end_ && !FillOutBuf())) {
+    return 0;
+  }
+  size_t bytes = std::min(size, (size_t)(end_ - cur_));
+  memcpy(data, cur_, bytes);
+  return bytes;
+}
+
+void LZ4FrameInputStream::ReadLine(std::string* line, char delim) {
+  bool found;
+  for (;;) {
+    if (cur_ == end_ && !FillOutBuf()) {
+      return;
+    }
+    cur_ += ScanLine(cur_, end_, delim, line, &found);
+    if (found) {
+      return;
+    }
+  }
+}
+
 }  // namespace deepx_core
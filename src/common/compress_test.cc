@@ -5,10 +5,22 @@
 #include <deepx_core/common/compress.h>
 #include <gtest/gtest.h>
 #include <string>
+#include <vector>
 
 namespace deepx_core {
 
-class CompressTest : public testing::Test {};
+class CompressTest : public testing::Test {
+ protected:
+  // 5MB of lines, more than a block of LZ4 frames.
+  static std::string MakeContent() {
+    std::string content;
+    for (int i = 0; content.size() < 5 * 1024 * 1024; ++i) {
+      content += std::to_string(i * 7919 % 100003);
+      content += '\n';
+    }
+    return content;
+  }
+};
 
 TEST_F(CompressTest, Compress_Decompress) {
   std::string in = "a short string";
@@ -33,4 +45,86 @@ TEST_F(CompressTest, HighCompress_Decompress) {
   EXPECT_EQ(in, expected_in);
 }
 
+TEST_F(CompressTest, LZ4FrameCompress_LZ4FrameDecompress) {
+  std::string in = MakeContent();
+  std::string out;
+  ASSERT_TRUE(LZ4FrameCompress(in.data(), in.size(), &out));
+  EXPECT_TRUE(IsLZ4Frame(out.data(), out.size()));
+  EXPECT_LT(out.size(), in.size());
+
+  std::string expected_in;
+  ASSERT_TRUE(LZ4FrameDecompress(out.data(), out.size(), &expected_in));
+  EXPECT_EQ(in, expected_in);
+
+  // concatenated frames
+  std::string out2;
+  ASSERT_TRUE(LZ4FrameCompress("", 0, &out2));
+  out += out2;
+  ASSERT_TRUE(LZ4FrameDecompress(out.data(), out.size(), &expected_in));
+  EXPECT_EQ(in, expected_in);
+
+  // truncated frame
+  EXPECT_FALSE(LZ4FrameDecompress(out.data(), out.size() / 2, &expected_in));
+  EXPECT_FALSE(IsLZ4Frame(in.data(), in.size()));
+}
+
+TEST_F(CompressTest, LZ4FrameOutputStream_LZ4FrameInputStream) {
+  std::string in = MakeContent();
+  OutputStringStream os;
+  {
+    LZ4FrameOutputStream lz4_os(&os);
+    // Write a small block by 'Flush', then full blocks.
+    ASSERT_EQ(lz4_os.Write(in.data(), 100), 100u);
+    ASSERT_TRUE(lz4_os.Flush());
+    ASSERT_EQ(lz4_os.Write(in.data() + 100, in.size() - 100),
+              in.size() - 100);
+    ASSERT_TRUE(lz4_os.Close());
+    EXPECT_EQ(lz4_os.Write(in.data(), 1), 0u);
+  }
+
+  std::string out;
+  ASSERT_TRUE(LZ4FrameDecompress(os.GetData(), os.GetSize(), &out));
+  EXPECT_EQ(in, out);
+
+  InputStringStream is;
+  is.SetView(os.GetBuf());
+  LZ4FrameInputStream lz4_is(&is);
+  char peek_buf[16];
+  ASSERT_EQ(lz4_is.Peek(peek_buf, sizeof(peek_buf)), sizeof(peek_buf));
+  EXPECT_EQ(std::string(peek_buf, sizeof(peek_buf)), in.substr(0, 16));
+  std::vector<std::string> lines;
+  std::string line;
+  while (GetLine(lz4_is, line)) {
+    lines.emplace_back(line);
+  }
+  std::string joined;
+  for (const std::string& l : lines) {
+    joined += l;
+    joined += '\n';
+  }
+  EXPECT_EQ(joined, in);
+
+  // Read more than a block, blocks are decompressed to 'read' directly.
+  is.SetView(os.GetBuf());
+  LZ4FrameInputStream lz4_is2(&is);
+  std::string read(in.size() + 1, 0);
+  ASSERT_EQ(lz4_is2.Read(&read[0], read.size()), in.size());
+  read.resize(in.size());
+  EXPECT_EQ(read, in);
+}
+
+TEST_F(CompressTest, LZ4FrameInputStream_Truncated) {
+  std::string in = MakeContent();
+  std::string out;
+  ASSERT_TRUE(LZ4FrameCompress(in.data(), in.size(), &out));
+  out.resize(out.size() / 2);
+
+  InputStringStream is;
+  is.SetView(out);
+  LZ4FrameInputStream lz4_is(&is);
+  std::string read(in.size(), 0);
+  EXPECT_LT(lz4_is.Read(&read[0], read.size()), in.size());
+  EXPECT_FALSE(lz4_is);
+}
+
 }  // namespace deepx_core
@@ -5,7 +5,9 @@
 #include <deepx_core/common/fast_strtox.h>
 #include <deepx_core/dx_gtest.h>
 #include <cstdint>
+#include <random>
 #include <string>
+#include <vector>
 
 namespace deepx_core {
 
@@ -149,4 +151,76 @@ TEST_F(FastStrtoxTest, fast_strtoi) {
   EXPECT_EQ(end, s.data());
 }
 
+TEST_F(FastStrtoxTest, fast_strtox_bounded) {
+  std::vector<std::string> ss = {"",
+                                 " ",
+                                 "-",
+                                 "+",
+                                 ".",
+                                 "-.",
+                                 "0",
+                                 "1",
+                                 "-1",
+                                 " \t 9527",
+                                 "- 9527",
+                                 "0.125",
+                                 "-0.3207547",
+                                 "1.2.3",
+                                 "95.27E-4",
+                                 "9527e",
+                                 "12345678",
+                                 "123456789",
+                                 "1234567812345678",
+                                 "123456781234567812345678",
+                                 "18446744073709551615",
+                                 "18446744073709551616",
+                                 "0.12345678901234",
+                                 "0.123456789012345678",
+                                 "1234567:1",
+                                 "12345678|1",
+                                 "123456789 1"};
+  std::default_random_engine engine;
+  std::uniform_int_distribution<int> length(0, 24);
+  std::uniform_int_distribution<int> c(0, 14);
+  // no 'e', large exponents are out of the range of 'fast_strtod'
+  const char CHARS[] = "0123456789.- :|";
+  for (int i = 0; i < 10000; ++i) {
+    std::string s;
+    int n = length(engine);
+    for (int j = 0; j < n; ++j) {
+      s.push_back(CHARS[c(engine)]);
+    }
+    ss.emplace_back(s);
+  }
+
+  char *end1, *end2;
+  for (const std::string& s : ss) {
+    const char* s_end = s.data() + s.size();
+    double d1 = fast_strtod(s.data(), &end1);
+    double d2 = fast_strtod(s.data(), s_end, &end2);
+    EXPECT_EQ(d1, d2) << s;
+    EXPECT_EQ(end1, end2) << s;
+
+    EXPECT_EQ(fast_strtoi<uint64_t>(s.data(), &end1),
+              fast_strtoi<uint64_t>(s.data(), s_end, &end2))
+        << s;
+    EXPECT_EQ(end1, end2) << s;
+
+    EXPECT_EQ(fast_strtoi<int64_t>(s.data(), &end1),
+              fast_strtoi<int64_t>(s.data(), s_end, &end2))
+        << s;
+    EXPECT_EQ(end1, end2) << s;
+
+    EXPECT_EQ(fast_strtoi<uint32_t>(s.data(), &end1),
+              fast_strtoi<uint32_t>(s.data(), s_end, &end2))
+        << s;
+    EXPECT_EQ(end1, end2) << s;
+
+    EXPECT_EQ(fast_strtoi<int32_t>(s.data(), &end1),
+              fast_strtoi<int32_t>(s.data(), s_end, &end2))
+        << s;
+    EXPECT_EQ(end1, end2) << s;
+  }
+}
+
 }  // namespace deepx_core
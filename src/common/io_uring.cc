@@ -0,0 +1,771 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/common/io_uring.h>
+#include <deepx_core/dx_log.h>
+#if OS_LINUX == 1
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include <algorithm>  // std::max, std::min
+#include <cerrno>
+#include <cstdlib>  // free, posix_memalign
+#include <cstring>  // memcpy, memset
+
+namespace deepx_core {
+
+#if OS_LINUX == 1
+namespace {
+
+constexpr size_t DIRECT_IO_ALIGNMENT = 4096;
+
+int io_uring_setup(unsigned entries, io_uring_params* p) noexcept {
+  return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+                   unsigned flags) noexcept {
+  return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags,
+                      nullptr, 0);
+}
+
+}  // namespace
+
+/************************************************************************/
+/* IoUring */
+/************************************************************************/
+IoUring::~IoUring() { Close(); }
+
+bool IoUring::Open(unsigned entries) noexcept {
+  Close();
+
+  io_uring_params p;
+  memset(&p, 0, sizeof(p));
+  int fd = io_uring_setup(entries > 0 ? entries : 1, &p);
+  if (fd == -1) {
+    return false;
+  }
+
+  sq_ring_size_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+  cq_ring_size_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+  if (p.features & IORING_FEAT_SINGLE_MMAP) {
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  }
+  sqes_size_ = p.sq_entries * sizeof(io_uring_sqe);
+
+  fd_ = fd;
+  sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+  if (sq_ring_ == MAP_FAILED) {
+    sq_ring_ = nullptr;
+    Close();
+    return false;
+  }
+  if (p.features & IORING_FEAT_SINGLE_MMAP) {
+    cq_ring_ = sq_ring_;
+  } else {
+    cq_ring_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    if (cq_ring_ == MAP_FAILED) {
+      cq_ring_ = nullptr;
+      Close();
+      return false;
+    }
+  }
+  sqes_ = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+  if (sqes_ == MAP_FAILED) {
+    sqes_ = nullptr;
+    Close();
+    return false;
+  }
+
+  char* sq_ring = (char*)sq_ring_;
+  char* cq_ring = (char*)cq_ring_;
+  sq_head_ = (unsigned*)(sq_ring + p.sq_off.head);
+  sq_tail_ = (unsigned*)(sq_ring + p.sq_off.tail);
+  sq_mask_ = (unsigned*)(sq_ring + p.sq_off.ring_mask);
+  sq_array_ = (unsigned*)(sq_ring + p.sq_off.array);
+  cq_head_ = (unsigned*)(cq_ring + p.cq_off.head);
+  cq_tail_ = (unsigned*)(cq_ring + p.cq_off.tail);
+  cq_mask_ = (unsigned*)(cq_ring + p.cq_off.ring_mask);
+  cqes_ = cq_ring + p.cq_off.cqes;
+  entries_ = p.sq_entries;
+  queued_ = 0;
+  in_flight_ = 0;
+  return true;
+}
+
+void IoUring::Close() noexcept {
+  if (fd_ == -1) {
+    return;
+  }
+
+  // Buffers of requests in flight are owned by the caller,
+  // wait for them before the caller frees the buffers.
+  uint64_t user_data;
+  int res;
+  while (in_flight_ > 0 && sq_ring_ && cq_ring_ && sqes_ &&
+         Wait(&user_data, &res)) {
+  }
+
+  if (sqes_) {
+    (void)munmap(sqes_, sqes_size_);
+  }
+  if (cq_ring_ && cq_ring_ != sq_ring_) {
+    (void)munmap(cq_ring_, cq_ring_size_);
+  }
+  if (sq_ring_) {
+    (void)munmap(sq_ring_, sq_ring_size_);
+  }
+  (void)close(fd_);
+  fd_ = -1;
+  sq_ring_ = nullptr;
+  cq_ring_ = nullptr;
+  sqes_ = nullptr;
+  entries_ = 0;
+  queued_ = 0;
+  in_flight_ = 0;
+}
+
+bool IoUring::Push(const void* sqe) noexcept {
+  if (in_flight_ >= entries_) {
+    return false;
+  }
+
+  // Without SQPOLL, the kernel reads the submission queue only in
+  // 'io_uring_enter', which is called by this thread.
+  unsigned tail = *sq_tail_;
+  unsigned index = tail & *sq_mask_;
+  memcpy((io_uring_sqe*)sqes_ + index, sqe, sizeof(io_uring_sqe));
+  sq_array_[index] = index;
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+  ++queued_;
+  ++in_flight_;
+  return true;
+}
+
+bool IoUring::PrepareRead(int fd, void* buf, size_t size, uint64_t offset,
+                          uint64_t user_data) noexcept {
+  io_uring_sqe sqe;
+  memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = IORING_OP_READ;
+  sqe.fd = fd;
+  sqe.off = offset;
+  sqe.addr = (uint64_t)buf;
+  sqe.len = (uint32_t)size;
+  sqe.user_data = user_data;
+  return Push(&sqe);
+}
+
+bool IoUring::PrepareWrite(int fd, const void* buf, size_t size,
+                           uint64_t offset, uint64_t user_data) noexcept {
+  io_uring_sqe sqe;
+  memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = IORING_OP_WRITE;
+  sqe.fd = fd;
+  sqe.off = offset;
+  sqe.addr = (uint64_t)buf;
+  sqe.len = (uint32_t)size;
+  sqe.user_data = user_data;
+  return Push(&sqe);
+}
+
+bool IoUring::PrepareStat(const char* path, void* statx_buf,
+                          uint64_t user_data) noexcept {
+  io_uring_sqe sqe;
+  memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = IORING_OP_STATX;
+  sqe.fd = AT_FDCWD;
+  sqe.addr = (uint64_t)path;
+  sqe.len = STATX_TYPE | STATX_SIZE;
+  sqe.off = (uint64_t)statx_buf;
+  sqe.statx_flags = AT_SYMLINK_NOFOLLOW;
+  sqe.user_data = user_data;
+  return Push(&sqe);
+}
+
+bool IoUring::Submit() noexcept {
+  while (queued_ > 0) {
+    int ret = io_uring_enter(fd_, queued_, 0, 0);
+    if (ret == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      DXERROR("Failed to io_uring_enter, errno=%d(%s).", errno,
+              strerror(errno));
+      return false;
+    }
+    if (ret == 0) {
+      return false;
+    }
+    queued_ -= (unsigned)ret;
+  }
+  return true;
+}
+
+bool IoUring::Wait(uint64_t* user_data, int* res) noexcept {
+  for (;;) {
+    unsigned head = *cq_head_;
+    if (head != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+      const io_uring_cqe* cqe = (const io_uring_cqe*)cqes_ + (head & *cq_mask_);
+      *user_data = cqe->user_data;
+      *res = cqe->res;
+      __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+      --in_flight_;
+      return true;
+    }
+
+    if (in_flight_ == 0) {
+      return false;
+    }
+
+    int ret = io_uring_enter(fd_, queued_, 1, IORING_ENTER_GETEVENTS);
+    if (ret == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      DXERROR("Failed to io_uring_enter, errno=%d(%s).", errno,
+              strerror(errno));
+      return false;
+    }
+    queued_ -= (unsigned)ret;
+  }
+}
+
+bool IoUring::Available() noexcept {
+  static const bool available = []() {
+    IoUring ring;
+    return ring.Open(1);
+  }();
+  return available;
+}
+
+/************************************************************************/
+/* IoUringInputStream */
+/************************************************************************/
+IoUringInputStream::IoUringInputStream(int blocks, size_t block_size)
+    : block_size_(block_size > 0 ? block_size : 1) {
+  bad_ = 1;
+  blocks_.resize(blocks > 0 ? (size_t)blocks : 1);
+}
+
+IoUringInputStream::~IoUringInputStream() { Close(); }
+
+bool IoUringInputStream::SubmitBlocks() {
+  size_t total = (file_size_ + block_size_ - 1) / block_size_;
+  while (submitted_ < total && submitted_ - consumed_ < blocks_.size()) {
+    // The slot is free, its block was released.
+    Block& block = blocks_[submitted_ % blocks_.size()];
+    if (!block.buf) {
+      block.buf.reset(new char[block_size_]);
+    }
+    size_t offset = submitted_ * block_size_;
+    block.size = std::min(block_size_, file_size_ - offset);
+    block.done = 0;
+    if (!ring_.PrepareRead(fd_, block.buf.get(), block.size, offset,
+                           submitted_)) {
+      break;
+    }
+    ++submitted_;
+  }
+  return ring_.Submit();
+}
+
+bool IoUringInputStream::WaitBlock(size_t i) {
+  Block& block = blocks_[i % blocks_.size()];
+  while (!block.done) {
+    uint64_t user_data;
+    int res;
+    if (!ring_.Wait(&user_data, &res)) {
+      return false;
+    }
+    Block& done_block = blocks_[user_data % blocks_.size()];
+    done_block.done = 1;
+    done_block.res = res;
+  }
+
+  if (block.res < 0) {
+    DXERROR("Failed to read, errno=%d(%s).", -block.res, strerror(-block.res));
+    return false;
+  }
+
+  // Short reads of regular files are rare, read the rest synchronously.
+  size_t bytes = (size_t)block.res;
+  while (bytes < block.size) {
+    ssize_t n = pread(fd_, block.buf.get() + bytes, block.size - bytes,
+                      (off_t)(i * block_size_ + bytes));
+    if (n == -1 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      // The file has been truncated.
+      break;
+    }
+    bytes += (size_t)n;
+  }
+  block.size = bytes;
+  block.res = (int)bytes;
+  return true;
+}
+
+bool IoUringInputStream::NextBlock() {
+  if (holding_) {
+    holding_ = 0;
+    ++consumed_;
+    if (!SubmitBlocks()) {
+      consumed_ = submitted_;
+    }
+  }
+
+  if (consumed_ == submitted_ || !WaitBlock(consumed_) ||
+      blocks_[consumed_ % blocks_.size()].size == 0) {
+    cur_ = nullptr;
+    end_ = nullptr;
+    bad_ = 1;
+    return false;
+  }
+
+  const Block& block = blocks_[consumed_ % blocks_.size()];
+  cur_ = block.buf.get();
+  end_ = cur_ + block.size;
+  holding_ = 1;
+  return true;
+}
+
+size_t IoUringInputStream::Read(void* data, size_t size) {
+  char* out = (char*)data;
+  size_t need_bytes = size;
+  while (need_bytes > 0) {
+    if (cur_ == end_ && !NextBlock()) {
+      break;
+    }
+    size_t bytes = std::min(need_bytes, (size_t)(end_ - cur_));
+    memcpy(out, cur_, bytes);
+    cur_ += bytes;
+    out += bytes;
+    need_bytes -= bytes;
+  }
+  return size - need_bytes;
+}
+
+char IoUringInputStream::ReadChar() {
+  if (cur_ == end_ && !NextBlock()) {
+    return (char)-1;
+  }
+  return *cur_++;
+}
+
+size_t IoUringInputStream::Peek(void* data, size_t size) {
+  if (size == 0 || (cur_ == end_ && !NextBlock())) {
+    return 0;
+  }
+
+  char* out = (char*)data;
+  size_t bytes = std::min(size, (size_t)(end_ - cur_));
+  memcpy(out, cur_, bytes);
+
+  // Copy the following blocks without releasing them.
+  for (size_t i = consumed_ + 1; bytes < size && i < submitted_; ++i) {
+    if (!WaitBlock(i)) {
+      break;
+    }
+    const Block& block = blocks_[i % blocks_.size()];
+    size_t block_bytes = std::min(size - bytes, block.size);
+    memcpy(out + bytes, block.buf.get(), block_bytes);
+    bytes += block_bytes;
+  }
+  return bytes;
+}
+
+void IoUringInputStream::ReadLine(std::string* line, char delim) {
+  bool found;
+  for (;;) {
+    if (cur_ == end_ && !NextBlock()) {
+      return;
+    }
+    cur_ += ScanLine(cur_, end_, delim, line, &found);
+    if (found) {
+      return;
+    }
+  }
+}
+
+bool IoUringInputStream::Open(const std::string& file) {
+  Close();
+
+  int fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    return false;
+  }
+
+  struct stat buf;
+  if (fstat(fd, &buf) == -1 || !S_ISREG(buf.st_mode) ||
+      !ring_.Open((unsigned)blocks_.size())) {
+    (void)close(fd);
+    return false;
+  }
+  (void)posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+  fd_ = fd;
+  file_size_ = (size_t)buf.st_size;
+  submitted_ = 0;
+  consumed_ = 0;
+  if (!SubmitBlocks()) {
+    Close();
+    return false;
+  }
+  bad_ = 0;
+  return true;
+}
+
+void IoUringInputStream::Close() noexcept {
+  // Wait for reads in flight before closing the file.
+  ring_.Close();
+  if (fd_ != -1) {
+    (void)close(fd_);
+    fd_ = -1;
+  }
+  file_size_ = 0;
+  submitted_ = 0;
+  consumed_ = 0;
+  holding_ = 0;
+  cur_ = nullptr;
+  end_ = nullptr;
+  bad_ = 1;
+}
+
+/************************************************************************/
+/* IoUringOutputStream */
+/************************************************************************/
+void IoUringOutputStream::AlignedDeleter::operator()(char* p) const noexcept {
+  free(p);
+}
+
+IoUringOutputStream::IoUringOutputStream(int blocks, size_t block_size)
+    : block_size_((std::max(block_size, (size_t)1) + DIRECT_IO_ALIGNMENT - 1) /
+                  DIRECT_IO_ALIGNMENT * DIRECT_IO_ALIGNMENT) {
+  bad_ = 1;
+  blocks_.resize(blocks > 0 ? (size_t)blocks : 1);
+}
+
+IoUringOutputStream::~IoUringOutputStream() { (void)Close(); }
+
+bool IoUringOutputStream::WaitOne() {
+  uint64_t user_data;
+  int res;
+  if (!ring_.Wait(&user_data, &res)) {
+    bad_ = 1;
+    return false;
+  }
+
+  blocks_[user_data % blocks_.size()].in_flight = 0;
+  if (res != (int)block_size_) {
+    if (res < 0) {
+      DXERROR("Failed to write %s, errno=%d(%s).", file_.c_str(), -res,
+              strerror(-res));
+    } else {
+      DXERROR("Failed to write %s, short write.", file_.c_str());
+    }
+    bad_ = 1;
+    return false;
+  }
+  return true;
+}
+
+bool IoUringOutputStream::WaitAll() {
+  while (ring_.in_flight() > 0) {
+    unsigned in_flight = ring_.in_flight();
+    if (!WaitOne() && ring_.in_flight() == in_flight) {
+      return false;
+    }
+  }
+  return !bad_;
+}
+
+bool IoUringOutputStream::SubmitBlock() {
+  Block& block = blocks_[written_ % blocks_.size()];
+  if (!ring_.PrepareWrite(fd_, block.buf.get(), block_size_,
+                          written_ * block_size_, written_) ||
+      !ring_.Submit()) {
+    bad_ = 1;
+    return false;
+  }
+  block.in_flight = 1;
+  ++written_;
+  size_ = 0;
+  return true;
+}
+
+size_t IoUringOutputStream::Write(const void* data, size_t size) {
+  const char* in = (const char*)data;
+  size_t need_bytes = size;
+  while (need_bytes > 0) {
+    Block& block = blocks_[written_ % blocks_.size()];
+    if (size_ == 0) {
+      while (block.in_flight) {
+        if (!WaitOne()) {
+          return size - need_bytes;
+        }
+      }
+      if (!block.buf) {
+        void* p;
+        if (posix_memalign(&p, DIRECT_IO_ALIGNMENT, block_size_) != 0) {
+          bad_ = 1;
+          return size - need_bytes;
+        }
+        block.buf.reset((char*)p);
+      }
+    }
+
+    size_t bytes = std::min(need_bytes, block_size_ - size_);
+    memcpy(block.buf.get() + size_, in, bytes);
+    size_ += bytes;
+    in += bytes;
+    need_bytes -= bytes;
+    if (size_ == block_size_ && !SubmitBlock()) {
+      return size - need_bytes;
+    }
+  }
+  return size;
+}
+
+bool IoUringOutputStream::Flush() {
+  if (fd_ == -1 || !WaitAll()) {
+    return false;
+  }
+
+  if (size_ > 0) {
+    // The partial block is unaligned, write it without O_DIRECT.
+    // It is rewritten with O_DIRECT when it is full.
+    int flags = fcntl(fd_, F_GETFL);
+    if (direct_ && fcntl(fd_, F_SETFL, flags & ~O_DIRECT) == -1) {
+      DXERROR("Failed to fcntl, errno=%d(%s).", errno, strerror(errno));
+      bad_ = 1;
+      return false;
+    }
+
+    const char* buf = blocks_[written_ % blocks_.size()].buf.get();
+    size_t bytes = 0;
+    while (bytes < size_) {
+      ssize_t n = pwrite(fd_, buf + bytes, size_ - bytes,
+                         (off_t)(written_ * block_size_ + bytes));
+      if (n == -1 && errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        DXERROR("Failed to write %s, errno=%d(%s).", file_.c_str(), errno,
+                strerror(errno));
+        bad_ = 1;
+        break;
+      }
+      bytes += (size_t)n;
+    }
+
+    if (direct_ && fcntl(fd_, F_SETFL, flags) == -1) {
+      DXERROR("Failed to fcntl, errno=%d(%s).", errno, strerror(errno));
+      bad_ = 1;
+    }
+  }
+  return !bad_;
+}
+
+bool IoUringOutputStream::Open(const std::string& file) {
+  (void)Close();
+
+  int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+  int direct = 1;
+  int fd = open(file.c_str(), flags | O_DIRECT, 0666);
+  if (fd == -1 && errno == EINVAL) {
+    // The file system does not support O_DIRECT, e.g. tmpfs.
+    direct = 0;
+    fd = open(file.c_str(), flags, 0666);
+  }
+  if (fd == -1) {
+    return false;
+  }
+
+  if (!ring_.Open((unsigned)blocks_.size())) {
+    (void)close(fd);
+    return false;
+  }
+
+  fd_ = fd;
+  direct_ = direct;
+  written_ = 0;
+  size_ = 0;
+  file_ = file;
+  bad_ = 0;
+  return true;
+}
+
+bool IoUringOutputStream::Close() noexcept {
+  if (fd_ == -1) {
+    return true;
+  }
+
+  bool ok = Flush();
+  ring_.Close();
+  if (close(fd_) == -1) {
+    DXERROR("Failed to close %s, errno=%d(%s).", file_.c_str(), errno,
+            strerror(errno));
+    ok = false;
+  }
+  fd_ = -1;
+  direct_ = 0;
+  written_ = 0;
+  size_ = 0;
+  file_.clear();
+  for (Block& block : blocks_) {
+    block.in_flight = 0;
+  }
+  bad_ = 1;
+  return ok;
+}
+
+/************************************************************************/
+/* IoUringStat */
+/************************************************************************/
+bool IoUringStat(const std::vector<std::string>& paths,
+                 std::vector<FileStat>* stats, int batch) {
+  stats->assign(paths.size(), FileStat());
+  IoUring ring;
+  if (!ring.Open(batch > 0 ? (unsigned)batch : 1)) {
+    LocalFileSystem fs;
+    bool ok = true;
+    for (size_t i = 0; i < paths.size(); ++i) {
+      ok = fs.Stat(paths[i], &(*stats)[i]) && ok;
+    }
+    return ok;
+  }
+
+  // Completions are out of order, slots are recycled by 'free_slots'.
+  std::vector<struct statx> bufs(ring.entries());
+  std::vector<size_t> slot_to_path(ring.entries());
+  std::vector<unsigned> free_slots;
+  for (unsigned slot = 0; slot < ring.entries(); ++slot) {
+    free_slots.emplace_back(slot);
+  }
+
+  bool ok = true;
+  size_t next = 0;
+  while (next < paths.size() || ring.in_flight() > 0) {
+    while (next < paths.size() && !free_slots.empty()) {
+      unsigned slot = free_slots.back();
+      if (!ring.PrepareStat(paths[next].c_str(), &bufs[slot], slot)) {
+        break;
+      }
+      free_slots.pop_back();
+      slot_to_path[slot] = next++;
+    }
+
+    uint64_t slot;
+    int res;
+    if (!ring.Wait(&slot, &res)) {
+      return false;
+    }
+    free_slots.emplace_back((unsigned)slot);
+
+    FileStat& stat = (*stats)[slot_to_path[slot]];
+    if (res < 0) {
+      ok = false;
+      continue;
+    }
+
+    const struct statx& buf = bufs[slot];
+    stat.set_exists(1);
+    int type;
+    if (S_ISDIR(buf.stx_mode)) {
+      type = FILE_TYPE_DIR;
+    } else if (S_ISREG(buf.stx_mode)) {
+      type = FILE_TYPE_REG_FILE;
+    } else if (S_ISLNK(buf.stx_mode)) {
+      type = FILE_TYPE_SYM_LINK;
+    } else {
+      type = FILE_TYPE_OTHER;
+    }
+    stat.set_type(type);
+    stat.set_file_size((size_t)buf.stx_size);
+  }
+  return ok;
+}
+#else
+/************************************************************************/
+/* IoUring */
+/************************************************************************/
+IoUring::~IoUring() {}
+bool IoUring::Open(unsigned /*entries*/) noexcept { return false; }
+void IoUring::Close() noexcept {}
+bool IoUring::Push(const void* /*sqe*/) noexcept { return false; }
+bool IoUring::PrepareRead(int, void*, size_t, uint64_t, uint64_t) noexcept {
+  return false;
+}
+bool IoUring::PrepareWrite(int, const void*, size_t, uint64_t,
+                           uint64_t) noexcept {
+  return false;
+}
+bool IoUring::PrepareStat(const char*, void*, uint64_t) noexcept {
+  return false;
+}
+bool IoUring::Submit() noexcept { return false; }
+bool IoUring::Wait(uint64_t*, int*) noexcept { return false; }
+bool IoUring::Available() noexcept { return false; }
+
+/************************************************************************/
+/* IoUringInputStream */
+/************************************************************************/
+IoUringInputStream::IoUringInputStream(int /*blocks*/, size_t block_size)
+    : block_size_(block_size) {
+  bad_ = 1;
+}
+IoUringInputStream::~IoUringInputStream() {}
+bool IoUringInputStream::SubmitBlocks() { return false; }
+bool IoUringInputStream::WaitBlock(size_t) { return false; }
+bool IoUringInputStream::NextBlock() { return false; }
+size_t IoUringInputStream::Read(void*, size_t) { return 0; }
+char IoUringInputStream::ReadChar() { return (char)-1; }
+size_t IoUringInputStream::Peek(void*, size_t) { return 0; }
+void IoUringInputStream::ReadLine(std::string*, char) {}
+bool IoUringInputStream::Open(const std::string&) { return false; }
+void IoUringInputStream::Close() noexcept {}
+
+/************************************************************************/
+/* IoUringOutputStream */
+/************************************************************************/
+void IoUringOutputStream::AlignedDeleter::operator()(char* p) const noexcept {
+  free(p);
+}
+IoUringOutputStream::IoUringOutputStream(int /*blocks*/, size_t block_size)
+    : block_size_(block_size) {
+  bad_ = 1;
+}
+IoUringOutputStream::~IoUringOutputStream() {}
+bool IoUringOutputStream::WaitOne() { return false; }
+bool IoUringOutputStream::WaitAll() { return false; }
+bool IoUringOutputStream::SubmitBlock() { return false; }
+size_t IoUringOutputStream::Write(const void*, size_t) { return 0; }
+bool IoUringOutputStream::Flush() { return false; }
+bool IoUringOutputStream::Open(const std::string&) { return false; }
+bool IoUringOutputStream::Close() noexcept { return true; }
+
+/************************************************************************/
+/* IoUringStat */
+/************************************************************************/
+bool IoUringStat(const std::vector<std::string>& paths,
+                 std::vector<FileStat>* stats, int /*batch*/) {
+  stats->assign(paths.size(), FileStat());
+  LocalFileSystem fs;
+  bool ok = true;
+  for (size_t i = 0; i < paths.size(); ++i) {
+    ok = fs.Stat(paths[i], &(*stats)[i]) && ok;
+  }
+  return ok;
+}
+#endif
+
+}  // namespace deepx_core
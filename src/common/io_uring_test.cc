@@ -0,0 +1,224 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/common/io_uring.h>
+#include <deepx_core/common/stream.h>
+#include <gtest/gtest.h>
+#include <cstdio>   // remove
+#include <cstdlib>  // setenv, unsetenv
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace deepx_core {
+
+class IoUringTest : public testing::Test {
+ protected:
+  std::string file_;
+  std::string content_;
+
+ protected:
+  void SetUp() override {
+    file_ = "testdata/common/stream/100.txt";
+    CFileStream fs;
+    ASSERT_TRUE(fs.Open(file_, FILE_OPEN_MODE_IN | FILE_OPEN_MODE_BINARY));
+    char buf[256];
+    size_t bytes;
+    while ((bytes = fs.Read(buf, sizeof(buf))) > 0) {
+      content_.append(buf, bytes);
+    }
+  }
+
+  static std::string ReadAll(InputStream& is) {  // NOLINT
+    std::string content;
+    char buf[100];
+    size_t bytes;
+    while ((bytes = is.Read(buf, sizeof(buf))) > 0) {
+      content.append(buf, bytes);
+    }
+    return content;
+  }
+};
+
+TEST_F(IoUringTest, IoUringInputStream_Read) {
+  if (!IoUring::Available()) {
+    return;
+  }
+
+  for (int blocks : {1, 2, 4}) {
+    for (size_t block_size : {64, 1000, 64 * 1024}) {
+      IoUringInputStream is(blocks, block_size);
+      ASSERT_TRUE(is.Open(file_));
+      EXPECT_EQ(ReadAll(is), content_);
+      EXPECT_FALSE(is);
+    }
+  }
+}
+
+TEST_F(IoUringTest, IoUringInputStream_GetLine) {
+  if (!IoUring::Available()) {
+    return;
+  }
+
+  std::vector<std::string> expected_lines;
+  {
+    InputStringStream is;
+    is.SetView(content_);
+    std::string line;
+    while (GetLine(is, line)) {
+      expected_lines.emplace_back(line);
+    }
+  }
+
+  for (int blocks : {1, 2, 4}) {
+    for (size_t block_size : {64, 1000, 64 * 1024}) {
+      IoUringInputStream is(blocks, block_size);
+      ASSERT_TRUE(is.Open(file_));
+      std::vector<std::string> lines;
+      std::string line;
+      while (GetLine(is, line)) {
+        lines.emplace_back(line);
+      }
+      EXPECT_EQ(lines, expected_lines);
+    }
+  }
+}
+
+TEST_F(IoUringTest, IoUringInputStream_Peek) {
+  if (!IoUring::Available()) {
+    return;
+  }
+
+  // Peek 256 bytes at most in 'blocks' blocks.
+  IoUringInputStream is(4, 128);
+  ASSERT_TRUE(is.Open(file_));
+  char peek_buf[256], read_buf[256];
+  size_t offset = 0;
+  for (;;) {
+    size_t peek_bytes = is.Peek(peek_buf, sizeof(peek_buf));
+    size_t read_bytes = is.Read(read_buf, sizeof(read_buf));
+    ASSERT_EQ(peek_bytes, read_bytes);
+    EXPECT_EQ(std::string(peek_buf, peek_bytes),
+              content_.substr(offset, peek_bytes));
+    EXPECT_EQ(std::string(read_buf, read_bytes),
+              content_.substr(offset, read_bytes));
+    offset += read_bytes;
+    if (read_bytes == 0) {
+      break;
+    }
+  }
+  EXPECT_EQ(offset, content_.size());
+}
+
+TEST_F(IoUringTest, IoUringInputStream_Open) {
+  if (!IoUring::Available()) {
+    return;
+  }
+
+  IoUringInputStream is;
+  EXPECT_FALSE(is.Open("not_exist.txt"));
+  // not a regular file
+  EXPECT_FALSE(is.Open("testdata/common/stream"));
+  ASSERT_TRUE(is.Open(file_));
+  EXPECT_EQ(ReadAll(is), content_);
+  // reopen
+  ASSERT_TRUE(is.Open(file_));
+  EXPECT_EQ(ReadAll(is), content_);
+}
+
+TEST_F(IoUringTest, IoUringOutputStream) {
+  if (!IoUring::Available()) {
+    return;
+  }
+
+  const std::string file = "io_uring_test.txt";
+  std::string expected_content;
+  for (int i = 0; i < 3000; ++i) {
+    expected_content += std::to_string(i);
+    expected_content += '\n';
+  }
+
+  for (int blocks : {1, 2, 4}) {
+    for (size_t block_size : {1, 4096, 8192}) {
+      IoUringOutputStream os(blocks, block_size);
+      ASSERT_TRUE(os.Open(file));
+      // Write the partial block by 'Flush', then fill it up.
+      ASSERT_EQ(os.Write(expected_content.data(), 100), 100u);
+      ASSERT_TRUE(os.Flush());
+      ASSERT_EQ(os.Write(expected_content.data() + 100, 5000), 5000u);
+      ASSERT_TRUE(os.Flush());
+      size_t size = expected_content.size() - 5100;
+      ASSERT_EQ(os.Write(expected_content.data() + 5100, size), size);
+      ASSERT_TRUE(os.Close());
+
+      IoUringInputStream is;
+      ASSERT_TRUE(is.Open(file));
+      EXPECT_EQ(ReadAll(is), expected_content);
+    }
+  }
+  std::remove(file.c_str());
+}
+
+TEST_F(IoUringTest, IoUringStat) {
+  std::vector<std::string> paths = {file_, "testdata/common/stream",
+                                    "testdata/common/stream/100.txt.link",
+                                    "testdata/common/stream/empty"};
+  std::vector<FileStat> stats;
+  ASSERT_TRUE(IoUringStat(paths, &stats, 2));
+  ASSERT_EQ(stats.size(), paths.size());
+  LocalFileSystem fs;
+  for (size_t i = 0; i < paths.size(); ++i) {
+    FileStat expected_stat;
+    ASSERT_TRUE(fs.Stat(paths[i], &expected_stat));
+    EXPECT_EQ(stats[i].Exists(), expected_stat.Exists());
+    EXPECT_EQ(stats[i].IsDir(), expected_stat.IsDir());
+    EXPECT_EQ(stats[i].IsRegFile(), expected_stat.IsRegFile());
+    EXPECT_EQ(stats[i].IsSymLink(), expected_stat.IsSymLink());
+    EXPECT_EQ(stats[i].GetFileSize(), expected_stat.GetFileSize());
+  }
+
+  paths.emplace_back("not_exist.txt");
+  ASSERT_FALSE(IoUringStat(paths, &stats));
+  EXPECT_FALSE(stats.back().Exists());
+}
+
+TEST_F(IoUringTest, LocalFileSystem_ListRecursive) {
+  LocalFileSystem fs;
+  std::vector<std::pair<FilePath, FileStat>> expected_children, children;
+  ASSERT_TRUE(fs.ListRecursive("testdata/common", false, &expected_children));
+  ASSERT_EQ(setenv("DEEPX_IO_URING", "1", 1), 0);
+  ASSERT_TRUE(fs.ListRecursive("testdata/common", false, &children));
+  ASSERT_EQ(unsetenv("DEEPX_IO_URING"), 0);
+  ASSERT_EQ(children.size(), expected_children.size());
+  for (size_t i = 0; i < children.size(); ++i) {
+    const FileStat& stat = children[i].second;
+    const FileStat& expected_stat = expected_children[i].second;
+    EXPECT_EQ(children[i].first.str(), expected_children[i].first.str());
+    EXPECT_EQ(stat.IsDir(), expected_stat.IsDir());
+    EXPECT_EQ(stat.IsSymLink(), expected_stat.IsSymLink());
+    EXPECT_EQ(stat.GetFileSize(), expected_stat.GetFileSize());
+  }
+}
+
+TEST_F(IoUringTest, AutoInputFileStream_AutoOutputFileStream) {
+  const std::string file = "io_uring_test.txt";
+  ASSERT_EQ(setenv("DEEPX_IO_URING", "1", 1), 0);
+  {
+    AutoOutputFileStream os;
+    ASSERT_TRUE(os.Open(file));
+    ASSERT_EQ(os.Write(content_.data(), content_.size()), content_.size());
+    ASSERT_TRUE(os.Flush());
+  }
+  {
+    AutoInputFileStream is;
+    ASSERT_TRUE(is.Open(file));
+    EXPECT_EQ(ReadAll(is), content_);
+    ASSERT_TRUE(is.Open(file_ + ".gz"));
+    EXPECT_EQ(ReadAll(is), content_);
+  }
+  ASSERT_EQ(unsetenv("DEEPX_IO_URING"), 0);
+  std::remove(file.c_str());
+}
+
+}  // namespace deepx_core
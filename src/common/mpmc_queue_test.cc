@@ -0,0 +1,201 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/common/mpmc_queue.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace deepx_core {
+
+class MPMCQueueTest : public testing::Test {
+ protected:
+  using mqi_t = MPMCQueue<int>;
+  const int N = 100;
+  const int M = 10000;
+};
+
+TEST_F(MPMCQueueTest, try_push_try_pop) {
+  mqi_t queue(5);
+  int item;
+  EXPECT_EQ(queue.capacity(), 8u);
+  EXPECT_TRUE(queue.empty());
+  EXPECT_FALSE(queue.try_pop(&item));
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_TRUE(queue.try_push(i));
+  }
+  EXPECT_FALSE(queue.try_push(8));
+  EXPECT_EQ(queue.size(), 8u);
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_TRUE(queue.try_pop(&item));
+    EXPECT_EQ(item, i);
+  }
+  EXPECT_FALSE(queue.try_pop(&item));
+}
+
+TEST_F(MPMCQueueTest, try_push_batch_try_pop_batch) {
+  mqi_t queue(8);
+  std::vector<int> in{0, 1, 2, 3, 4, 5};
+  std::vector<int> out(8, -1);
+  EXPECT_EQ(queue.try_push_batch(in.begin(), in.size()), 6u);
+  EXPECT_EQ(queue.try_push_batch(in.begin(), in.size()), 2u);
+  EXPECT_EQ(queue.try_push_batch(in.begin(), in.size()), 0u);
+  EXPECT_EQ(queue.try_pop_batch(out.begin(), 3), 3u);
+  EXPECT_EQ(queue.try_pop_batch(out.begin() + 3, 8), 5u);
+  EXPECT_EQ(queue.try_pop_batch(out.begin(), 8), 0u);
+  std::vector<int> expected_out{0, 1, 2, 3, 4, 5, 0, 1};
+  EXPECT_EQ(out, expected_out);
+}
+
+TEST_F(MPMCQueueTest, non_trivial_type) {
+  MPMCQueue<std::unique_ptr<int>> queue(4);
+  std::unique_ptr<int> item;
+  queue.start();
+  EXPECT_TRUE(queue.push(new int(1)));
+  EXPECT_TRUE(queue.push(std::unique_ptr<int>(new int(2))));
+  EXPECT_TRUE(queue.pop(&item));
+  EXPECT_EQ(*item, 1);
+  // The remaining element is released by the destructor.
+}
+
+TEST_F(MPMCQueueTest, stop) {
+  mqi_t queue(4);
+  int item = 0;
+  queue.start();
+  std::thread consumer([&queue, &item]() {
+    int v;
+    while (queue.pop(&v)) {
+      item += v;
+    }
+  });
+  EXPECT_TRUE(queue.push(1));
+  EXPECT_TRUE(queue.push(2));
+  queue.stop();
+  consumer.join();
+  EXPECT_EQ(item, 3);
+}
+
+TEST_F(MPMCQueueTest, destroy_with_blocked_consumer) {
+  std::unique_ptr<mqi_t> queue(new mqi_t(4));
+  queue->start();
+  std::atomic<int> popped(-1);
+  mqi_t* raw_queue = queue.get();
+  std::thread consumer([raw_queue, &popped]() {
+    int v;
+    popped = raw_queue->pop(&v) ? 1 : 0;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  // The destructor wakes up the consumer and waits for it.
+  queue.reset();
+  consumer.join();
+  EXPECT_EQ(popped, 0);
+}
+
+TEST_F(MPMCQueueTest, ProducerConsumer) {
+  mqi_t consumer_queue(N), producer_queue(N);
+  consumer_queue.start();
+  producer_queue.start();
+  for (int i = 0; i < N; ++i) {
+    consumer_queue.push(0);
+  }
+
+  auto producer = [this, &consumer_queue, &producer_queue]() {
+    int item;
+    for (int i = 0; i < M; ++i) {
+      (void)consumer_queue.pop(&item);
+      item = i;
+      producer_queue.push(item);
+    }
+    producer_queue.stop();
+  };
+
+  int sum = 0;
+  auto consumer = [&sum, &consumer_queue, &producer_queue]() {
+    int item;
+    for (;;) {
+      if (producer_queue.pop(&item)) {
+        sum += item;
+        item = -1;
+        consumer_queue.push(item);
+      } else {
+        consumer_queue.stop();
+        break;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.emplace_back(producer);
+  threads.emplace_back(consumer);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(sum, M * (M - 1) / 2);
+}
+
+TEST_F(MPMCQueueTest, MultiProducerMultiConsumer) {
+  const int P = 4, C = 4, B = 7;
+  mqi_t queue(64);
+  std::atomic<int> producers(P);
+  std::atomic<long long> sum(0);
+  queue.start();
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < P; ++p) {
+    threads.emplace_back([this, p, &queue, &producers]() {
+      std::vector<int> items;
+      for (int i = p; i < M; i += P) {
+        if (i % 2) {
+          queue.push(i);
+        } else {
+          items.emplace_back(i);
+        }
+      }
+      EXPECT_EQ(queue.push_batch(items.begin(), items.size()), items.size());
+      if (--producers == 0) {
+        queue.stop();
+      }
+    });
+  }
+  for (int c = 0; c < C; ++c) {
+    threads.emplace_back([&queue, &sum]() {
+      std::vector<int> items(B);
+      size_t n;
+      while ((n = queue.pop_batch(items.begin(), items.size())) > 0) {
+        for (size_t i = 0; i < n; ++i) {
+          sum += items[i];
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(sum, (long long)M * (M - 1) / 2);
+}
+
+TEST_F(MPMCQueueTest, YieldingWaitPolicy) {
+  MPMCQueue<int, YieldingWaitPolicy> queue(16);
+  std::atomic<long long> sum(0);
+  queue.start();
+  std::thread consumer([&queue, &sum]() {
+    int item;
+    while (queue.pop(&item)) {
+      sum += item;
+    }
+  });
+  for (int i = 0; i < M; ++i) {
+    queue.push(i);
+  }
+  queue.stop();
+  consumer.join();
+  EXPECT_EQ(sum, (long long)M * (M - 1) / 2);
+}
+
+}  // namespace deepx_core
@@ -0,0 +1,121 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/common/sharded_lru_cache.h>
+#include <deepx_core/dx_gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace deepx_core {
+
+class ShardedLRUCacheTest : public testing::Test {};
+
+TEST_F(ShardedLRUCacheTest, init) {
+  ShardedLRUCache<int, int> cache;
+  EXPECT_FALSE(cache.initialized());
+
+  cache.init(100, 3);
+  EXPECT_TRUE(cache.initialized());
+  EXPECT_EQ(cache.shard_size(), 4u);
+  EXPECT_GE(cache.capacity(), 100u);
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST_F(ShardedLRUCacheTest, get_insert_erase) {
+  ShardedLRUCache<int, int> cache;
+  int value;
+  cache.init(1024, 4);
+
+  EXPECT_FALSE(cache.get(1, &value));
+  cache.insert(1, 11);
+  EXPECT_TRUE(cache.get(1, &value));
+  EXPECT_EQ(value, 11);
+  cache.insert(1, 111);
+  EXPECT_TRUE(cache.get(1, &value));
+  EXPECT_EQ(value, 111);
+
+  EXPECT_FALSE(cache.get_or_insert(2, [](int* v) { *v = 22; }));
+  EXPECT_TRUE(cache.get_or_insert(2, [](int* v) { EXPECT_EQ(*v, 22); }));
+  EXPECT_EQ(cache.size(), 2u);
+
+  EXPECT_EQ(cache.erase(1), 1u);
+  EXPECT_EQ(cache.erase(1), 0u);
+  EXPECT_EQ(cache.size(), 1u);
+
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0u);
+  EXPECT_FALSE(cache.get(2, &value));
+}
+
+TEST_F(ShardedLRUCacheTest, hit_rate) {
+  ShardedLRUCache<int, int> cache;
+  cache.init(1024, 4);
+  for (int i = 0; i < 10; ++i) {
+    cache.get_or_insert(i);
+  }
+  for (int i = 0; i < 10; ++i) {
+    cache.get_or_insert(i);
+  }
+  EXPECT_DOUBLE_NEAR(cache.hit_rate(), 0.5);
+  cache.clear_hit_rate();
+  EXPECT_DOUBLE_NEAR(cache.hit_rate(), 0.0);
+}
+
+TEST_F(ShardedLRUCacheTest, Evict) {
+  ShardedLRUCache<int, int> cache;
+  std::vector<int> evicted;
+  cache.init(1, 1);
+  cache.set_evict_callback([&evicted](const int& key, const int& /*value*/) {
+    evicted.emplace_back(key);
+  });
+
+  // A single shard behaves like LRUCache.
+  for (int i = 0; i < 6; ++i) {
+    cache.get_or_insert(i);
+  }
+  cache.get_or_insert(2);
+  cache.get_or_insert(6);
+  std::vector<int> expected_evicted{0, 1, 3};
+  EXPECT_EQ(evicted, expected_evicted);
+}
+
+TEST_F(ShardedLRUCacheTest, get_or_insert_batch) {
+  ShardedLRUCache<int, int> cache;
+  std::vector<int> keys;
+  cache.init(1024, 8);
+  for (int i = 0; i < 100; ++i) {
+    keys.emplace_back(i);
+  }
+  cache.get_or_insert_batch(keys.begin(), keys.end());
+  EXPECT_EQ(cache.size(), 100u);
+  cache.get_or_insert_batch(keys.begin(), keys.end());
+  EXPECT_DOUBLE_NEAR(cache.hit_rate(), 0.5);
+}
+
+TEST_F(ShardedLRUCacheTest, MultiThread) {
+  const int T = 4, N = 10000;
+  ShardedLRUCache<int, int> cache;
+  std::atomic<int> evicted(0);
+  cache.init(1024, 16);
+  cache.set_evict_callback(
+      [&evicted](const int& /*key*/, const int& /*value*/) { ++evicted; });
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < T; ++t) {
+    threads.emplace_back([&cache, t]() {
+      for (int i = 0; i < N; ++i) {
+        cache.get_or_insert(t * N + i);
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(cache.size() + evicted, (size_t)T * N);
+  EXPECT_LE(cache.size(), cache.capacity());
+}
+
+}  // namespace deepx_core
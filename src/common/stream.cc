@@ -2,6 +2,7 @@
 // Author: Yafei Zhang (kimmyzhang@tencent.com)
 //
 
+#include <deepx_core/common/io_uring.h>
 #include <deepx_core/common/stream.h>
 #if OS_WIN == 1
 #if !defined WIN32_LEAN_AND_MEAN
@@ -11,28 +12,37 @@
 #else
 #include <dirent.h>
 #include <dlfcn.h>
+#include <fcntl.h>  // posix_fadvise
 #include <sys/stat.h>
 #include <sys/types.h>
 #endif
 #include <deepx_core/dx_log.h>
 #include <hdfs_c.h>
 #include <zlib.h>
-#include <algorithm>  // std::find_if, std::sort
+#include <algorithm>  // std::find_if, std::min, std::sort
 #include <cerrno>
+#include <chrono>
 #include <cstdio>
-#include <cstdlib>  // getenv
-#include <cstring>  // memset, memcpy
+#include <cstdlib>  // atoi, getenv
+#include <cstring>  // memchr, memcpy, memset
 #include <ctime>
 
 #if HAVE_STREAM_GFLAGS == 1
 #include <gflags/gflags.h>
 DEFINE_string(hdfs_ugi, "", "HDFS config string for hadoop.job.ugi");
 DEFINE_string(hdfs_user, "", "HDFS user name");
+DEFINE_int32(read_ahead_blocks, 4,
+             "number of blocks read ahead, 0 disables read-ahead");
+DEFINE_int32(read_ahead_block_size, 1024 * 1024, "read-ahead block size");
+DEFINE_bool(io_uring, false, "use io_uring for local files if available");
 #else
 namespace {
 
 std::string FLAGS_hdfs_ugi;
 std::string FLAGS_hdfs_user;
+int FLAGS_read_ahead_blocks = 4;                // magic number
+int FLAGS_read_ahead_block_size = 1024 * 1024;  // magic number
+bool FLAGS_io_uring = false;
 
 }  // namespace
 #endif
@@ -131,6 +141,29 @@ static bool LocalFileExists(const std::string& file) noexcept {
   return fs.Stat(file, &stat) && stat.IsFile();
 }
 
+static bool UseIoUring() noexcept {
+  bool io_uring = FLAGS_io_uring;
+  const char* DEEPX_IO_URING = getenv("DEEPX_IO_URING");
+  if (DEEPX_IO_URING) {
+    io_uring = atoi(DEEPX_IO_URING) != 0;
+  }
+  return io_uring && IoUring::Available();
+}
+
+static void GetReadAhead(int* blocks, int* block_size) noexcept {
+  *blocks = FLAGS_read_ahead_blocks;
+  *block_size = FLAGS_read_ahead_block_size;
+  const char* DEEPX_READ_AHEAD_BLOCKS = getenv("DEEPX_READ_AHEAD_BLOCKS");
+  const char* DEEPX_READ_AHEAD_BLOCK_SIZE =
+      getenv("DEEPX_READ_AHEAD_BLOCK_SIZE");
+  if (DEEPX_READ_AHEAD_BLOCKS) {
+    *blocks = atoi(DEEPX_READ_AHEAD_BLOCKS);
+  }
+  if (DEEPX_READ_AHEAD_BLOCK_SIZE) {
+    *block_size = atoi(DEEPX_READ_AHEAD_BLOCK_SIZE);
+  }
+}
+
 /************************************************************************/
 /* FilePath */
 /************************************************************************/
@@ -420,22 +453,13 @@ bool LocalFileSystem::Stat(const FilePath& path, FileStat* _stat) {
   return true;
 }
 
-static bool _List(LocalFileSystem* fs, const FilePath& path, bool skip_dir,
-                  std::vector<std::pair<FilePath, FileStat>>* children) {
-  FileStat stat;
-  if (!fs->Stat(path, &stat)) {
-    return false;
-  }
-
-  if (stat.IsFile()) {
-    children->emplace_back(path, stat);
-    return true;
-  }
-
+// Read children of the dir 'path' and stat them,
+// in batches by io_uring if it is enabled.
+static bool _ReadDir(LocalFileSystem* fs, const FilePath& path,
+                     std::vector<std::string>* child_paths,
+                     std::vector<FileStat>* child_stats) {
   DIR* d;
   dirent* f;
-  std::string child_path;
-  FileStat child_stat;
   d = opendir(path.c_str());
   if (d == nullptr) {
     return false;
@@ -446,20 +470,48 @@ static bool _List(LocalFileSystem* fs, const FilePath& path, bool skip_dir,
     if (f->d_name[0] == '.') {
       continue;
     }
+    child_paths->emplace_back(path.str() + "/" + f->d_name);
+  }
+  (void)closedir(d);
 
-    child_path = path.str() + "/" + f->d_name;
-    if (!fs->Stat(child_path, &child_stat)) {
-      (void)closedir(d);
+  if (UseIoUring()) {
+    return IoUringStat(*child_paths, child_stats);
+  }
+
+  child_stats->resize(child_paths->size());
+  for (size_t i = 0; i < child_paths->size(); ++i) {
+    if (!fs->Stat((*child_paths)[i], &(*child_stats)[i])) {
       return false;
     }
+  }
+  return true;
+}
 
-    if (skip_dir && child_stat.IsDir()) {
+static bool _List(LocalFileSystem* fs, const FilePath& path, bool skip_dir,
+                  std::vector<std::pair<FilePath, FileStat>>* children) {
+  FileStat stat;
+  if (!fs->Stat(path, &stat)) {
+    return false;
+  }
+
+  if (stat.IsFile()) {
+    children->emplace_back(path, stat);
+    return true;
+  }
+
+  std::vector<std::string> child_paths;
+  std::vector<FileStat> child_stats;
+  if (!_ReadDir(fs, path, &child_paths, &child_stats)) {
+    return false;
+  }
+
+  for (size_t i = 0; i < child_paths.size(); ++i) {
+    if (skip_dir && child_stats[i].IsDir()) {
       continue;
     } else {
-      children->emplace_back(child_path, child_stat);
+      children->emplace_back(child_paths[i], child_stats[i]);
     }
   }
-  (void)closedir(d);
   return true;
 }
 
@@ -476,40 +528,24 @@ static bool _ListRecursive(
     return true;
   }
 
-  DIR* d;
-  dirent* f;
-  std::string child_path;
-  FileStat child_stat;
-  d = opendir(path.c_str());
-  if (d == nullptr) {
+  std::vector<std::string> child_paths;
+  std::vector<FileStat> child_stats;
+  if (!_ReadDir(fs, path, &child_paths, &child_stats)) {
     return false;
   }
 
-  while ((f = readdir(d))) {
-    // skip . .. and stealth files
-    if (f->d_name[0] == '.') {
-      continue;
-    }
-
-    child_path = path.str() + "/" + f->d_name;
-    if (!fs->Stat(child_path, &child_stat)) {
-      (void)closedir(d);
-      return false;
-    }
-
-    if (child_stat.IsDir()) {
+  for (size_t i = 0; i < child_paths.size(); ++i) {
+    if (child_stats[i].IsDir()) {
       if (!skip_dir) {
-        children->emplace_back(child_path, child_stat);
+        children->emplace_back(child_paths[i], child_stats[i]);
       }
-      if (!_ListRecursive(fs, child_path, skip_dir, children)) {
-        (void)closedir(d);
+      if (!_ListRecursive(fs, child_paths[i], skip_dir, children)) {
         return false;
       }
     } else {
-      children->emplace_back(child_path, child_stat);
+      children->emplace_back(child_paths[i], child_stats[i]);
     }
   }
-  (void)closedir(d);
   return true;
 }
 
@@ -588,6 +624,20 @@ bool LocalFileSystem::ListRecursive(
   return true;
 }
 
+/************************************************************************/
+/* InputStream */
+/************************************************************************/
+void InputStream::ReadLine(std::string* line, char delim) {
+  char c;
+  for (;;) {
+    c = ReadChar();
+    if (!*this || c == delim) {
+      break;
+    }
+    line->push_back(c);
+  }
+}
+
 /************************************************************************/
 /* GetLine */
 /************************************************************************/
@@ -596,18 +646,24 @@ InputStream& GetLine(InputStream& is, std::string& line) {
 }
 
 InputStream& GetLine(InputStream& is, std::string& line, char delim) {
-  char c;
   line.clear();
-  for (;;) {
-    c = is.ReadChar();
-    if (!is || c == delim) {
-      break;
-    }
-    line.push_back(c);
-  }
+  is.ReadLine(&line, delim);
   return is;
 }
 
+size_t ScanLine(const char* begin, const char* end, char delim,
+                std::string* line, bool* found) {
+  const char* p = (const char*)memchr(begin, delim, end - begin);
+  if (p == nullptr) {
+    line->append(begin, end);
+    *found = false;
+    return end - begin;
+  }
+  line->append(begin, p);
+  *found = true;
+  return p - begin + 1;
+}
+
 /************************************************************************/
 /* BufferedInputStream */
 /************************************************************************/
@@ -712,6 +768,20 @@ size_t BufferedInputStream::Peek(void* data, size_t size) {
   return size;
 }
 
+void BufferedInputStream::ReadLine(std::string* line, char delim) {
+  bool found;
+  for (;;) {
+    if (cur_ == end_ && FillEmptyBuf() == 0) {
+      bad_ = 1;
+      return;
+    }
+    cur_ += ScanLine(cur_, end_, delim, line, &found);
+    if (found) {
+      return;
+    }
+  }
+}
+
 /************************************************************************/
 /* GunzipInputStream */
 /************************************************************************/
@@ -865,6 +935,171 @@ size_t GunzipInputStream::Peek(void* data, size_t size) {
   return size;
 }
 
+void GunzipInputStream::ReadLine(std::string* line, char delim) {
+  bool found;
+  for (;;) {
+    if (cur_ == end_ && FillEmptyBuf() == 0) {
+      bad_ = 1;
+      return;
+    }
+    cur_ += ScanLine(cur_, end_, delim, line, &found);
+    if (found) {
+      return;
+    }
+  }
+}
+
+/************************************************************************/
+/* ReadAheadInputStream */
+/************************************************************************/
+ReadAheadInputStream::ReadAheadInputStream(InputStream* is, int blocks,
+                                           size_t block_size)
+    : is_(is), block_size_(block_size) {
+  if (is_ == nullptr || block_size_ == 0) {
+    bad_ = 1;
+    return;
+  }
+
+  bad_ = 0;
+  blocks_.resize(blocks > 0 ? (size_t)blocks : 1);
+  thread_ = std::thread(&ReadAheadInputStream::Produce, this);
+}
+
+ReadAheadInputStream::~ReadAheadInputStream() {
+  if (thread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      stop_ = 1;
+    }
+    cond_.notify_all();
+    thread_.join();
+  }
+}
+
+void ReadAheadInputStream::Produce() {
+  std::unique_lock<std::mutex> guard(mutex_);
+  for (;;) {
+    cond_.wait(guard, [this]() {
+      return stop_ || produced_ - consumed_ < blocks_.size();
+    });
+    if (stop_) {
+      return;
+    }
+
+    // The consumer does not access this block until 'produced_' increases.
+    Block& block = blocks_[produced_ % blocks_.size()];
+    guard.unlock();
+    if (!block.buf) {
+      block.buf.reset(new char[block_size_]);
+    }
+    size_t bytes = is_->Read(block.buf.get(), block_size_);
+    int eof = bytes == 0 || is_->bad();
+    guard.lock();
+
+    if (bytes > 0) {
+      block.size = bytes;
+      ++produced_;
+    }
+    eof_ = eof;
+    cond_.notify_all();
+    if (eof) {
+      return;
+    }
+  }
+}
+
+bool ReadAheadInputStream::NextBlock() {
+  std::unique_lock<std::mutex> guard(mutex_);
+  if (holding_) {
+    holding_ = 0;
+    ++consumed_;
+    cond_.notify_all();
+  }
+
+  if (produced_ == consumed_ && !eof_) {
+    auto begin = std::chrono::steady_clock::now();
+    cond_.wait(guard, [this]() { return produced_ > consumed_ || eof_; });
+    stall_seconds_ += std::chrono::duration<double>(
+                          std::chrono::steady_clock::now() - begin)
+                          .count();
+    ++stall_count_;
+  }
+
+  if (produced_ == consumed_) {
+    cur_ = nullptr;
+    end_ = nullptr;
+    bad_ = 1;
+    return false;
+  }
+
+  const Block& block = blocks_[consumed_ % blocks_.size()];
+  cur_ = block.buf.get();
+  end_ = cur_ + block.size;
+  holding_ = 1;
+  return true;
+}
+
+size_t ReadAheadInputStream::Read(void* data, size_t size) {
+  char* out = (char*)data;
+  size_t need_bytes = size;
+  while (need_bytes > 0) {
+    if (cur_ == end_ && !NextBlock()) {
+      break;
+    }
+    size_t bytes = std::min(need_bytes, (size_t)(end_ - cur_));
+    memcpy(out, cur_, bytes);
+    cur_ += bytes;
+    out += bytes;
+    need_bytes -= bytes;
+  }
+  return size - need_bytes;
+}
+
+char ReadAheadInputStream::ReadChar() {
+  if (cur_ == end_ && !NextBlock()) {
+    return (char)-1;
+  }
+  return *cur_++;
+}
+
+size_t ReadAheadInputStream::Peek(void* data, size_t size) {
+  if (size == 0 || (cur_ == end_ && !NextBlock())) {
+    return 0;
+  }
+
+  char* out = (char*)data;
+  size_t bytes = std::min(size, (size_t)(end_ - cur_));
+  memcpy(out, cur_, bytes);
+
+  // Copy the following blocks without releasing them.
+  std::unique_lock<std::mutex> guard(mutex_);
+  for (size_t i = consumed_ + 1; bytes < size && i < consumed_ + blocks_.size();
+       ++i) {
+    cond_.wait(guard, [this, i]() { return produced_ > i || eof_; });
+    if (produced_ <= i) {
+      break;
+    }
+    const Block& block = blocks_[i % blocks_.size()];
+    size_t block_bytes = std::min(size - bytes, block.size);
+    memcpy(out + bytes, block.buf.get(), block_bytes);
+    bytes += block_bytes;
+  }
+  return bytes;
+}
+
+void ReadAheadInputStream::ReadLine(std::string* line, char delim) {
+  bool found;
+  for (;;) {
+    if (cur_ == end_ && !NextBlock()) {
+      return;
+    }
+    cur_ += ScanLine(cur_, end_, delim, line, &found);
+    if (found) {
+      return;
+    }
+  }
+}
+
 /************************************************************************/
 /* CFileStream */
 /************************************************************************/
@@ -978,6 +1213,13 @@ bool CFileStream::Open(const std::string& file, int mode) {
     mode_ = FILE_OPEN_MODE_NONE;
     return false;
   } else {
+#if OS_LINUX == 1
+    if ((mode & FILE_OPEN_MODE_IN) && !(mode & FILE_OPEN_MODE_OUT) &&
+        f_ != stdin) {
+      // Files are read sequentially, let the kernel read ahead more.
+      (void)posix_fadvise(fileno((FILE*)f_), 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+#endif
     bad_ = 0;
     mode_ = mode;
     return true;
@@ -1074,6 +1316,19 @@ size_t InputStringStream::Peek(void* data, size_t size) {
   }
 }
 
+void InputStringStream::ReadLine(std::string* line, char delim) {
+  if (cur_ == end_) {
+    bad_ = 1;
+    return;
+  }
+
+  bool found;
+  cur_ += ScanLine(cur_, end_, delim, line, &found);
+  if (!found) {
+    bad_ = 1;
+  }
+}
+
 size_t InputStringStream::Skip(size_t size) {
   size_t avail_bytes = end_ - cur_;
   if (avail_bytes >= size) {
@@ -1976,6 +2231,11 @@ size_t AutoInputFileStream::Peek(void* data, size_t size) {
   return bytes;
 }
 
+void AutoInputFileStream::ReadLine(std::string* line, char delim) {
+  is_->ReadLine(line, delim);
+  bad_ = is_->bad();
+}
+
 bool AutoInputFileStream::Open(const std::string& file) {
   Close();
 
@@ -2003,15 +2263,33 @@ bool AutoInputFileStream::Open(const std::string& file) {
 
     hdfs_handle_ = std::move(hdfs_handle);
     is_extra_ = std::move(is_extra);
-    if (IsGzipFile(file)) {
-      is_.reset(new GunzipInputStream(is_extra_.get()));
-    } else {
-      is_.reset(new BufferedInputStream(is_extra_.get()));
-    }
+    InitInputStream(file, use_read_ahead_ != 0);
     bad_ = 0;
     return true;
   }
 
+  if (!IsStdinStdoutPath(file) && LocalFileExists(file) && UseIoUring()) {
+    int blocks, block_size;
+    GetReadAhead(&blocks, &block_size);
+    if (block_size <= 0) {
+      block_size = 1024 * 1024;  // magic number
+    }
+    std::unique_ptr<IoUringInputStream> is_read_ahead(
+        new IoUringInputStream(blocks, (size_t)block_size));
+    // Otherwise, fall back to 'CFileStream', e.g. for non-regular files.
+    if (is_read_ahead->Open(file)) {
+      if (IsGzipFile(file)) {
+        is_read_ahead_ = std::move(is_read_ahead);
+        is_.reset(new GunzipInputStream(is_read_ahead_.get()));
+      } else {
+        // It is buffered.
+        is_ = std::move(is_read_ahead);
+      }
+      bad_ = 0;
+      return true;
+    }
+  }
+
   if (IsStdinStdoutPath(file) || LocalFileExists(file)) {
     std::unique_ptr<CFileStream> is_extra(new CFileStream);
     if (!is_extra->Open(file, FILE_OPEN_MODE_IN | FILE_OPEN_MODE_BINARY)) {
@@ -2019,11 +2297,8 @@ bool AutoInputFileStream::Open(const std::string& file) {
     }
 
     is_extra_ = std::move(is_extra);
-    if (IsGzipFile(file)) {
-      is_.reset(new GunzipInputStream(is_extra_.get()));
-    } else {
-      is_.reset(new BufferedInputStream(is_extra_.get()));
-    }
+    // Reading stdin ahead may block forever.
+    InitInputStream(file, use_read_ahead_ && !IsStdinStdoutPath(file));
     bad_ = 0;
     return true;
   }
@@ -2034,13 +2309,48 @@ bool AutoInputFileStream::Open(const std::string& file) {
 bool AutoInputFileStream::IsOpen() const noexcept { return is_.get(); }
 
 void AutoInputFileStream::Close() noexcept {
+  if (read_ahead_ && read_ahead_->stall_seconds() >= 1) {  // magic number
+    DXINFO("Reading %s stalled %d times, %.3f seconds.", file_.c_str(),
+           read_ahead_->stall_count(), read_ahead_->stall_seconds());
+  }
+  read_ahead_ = nullptr;
+  file_.clear();
+
   bad_ = 1;
-  is_extra_.reset();
+  // Stop the read-ahead thread before closing the file.
   is_.reset();
+  is_read_ahead_.reset();
+  is_extra_.reset();
   // put it last
   hdfs_handle_.reset();
 }
 
+void AutoInputFileStream::InitInputStream(const std::string& file,
+                                          bool read_ahead) {
+  int blocks, block_size;
+  GetReadAhead(&blocks, &block_size);
+  if (!read_ahead || blocks <= 0 || block_size <= 0) {
+    if (IsGzipFile(file)) {
+      is_.reset(new GunzipInputStream(is_extra_.get()));
+    } else {
+      is_.reset(new BufferedInputStream(is_extra_.get()));
+    }
+    return;
+  }
+
+  std::unique_ptr<ReadAheadInputStream> is_read_ahead(
+      new ReadAheadInputStream(is_extra_.get(), blocks, (size_t)block_size));
+  read_ahead_ = is_read_ahead.get();
+  file_ = file;
+  if (IsGzipFile(file)) {
+    is_read_ahead_ = std::move(is_read_ahead);
+    is_.reset(new GunzipInputStream(is_read_ahead_.get()));
+  } else {
+    // It is buffered.
+    is_ = std::move(is_read_ahead);
+  }
+}
+
 /************************************************************************/
 /* AutoOutputFileStream */
 /************************************************************************/
@@ -2084,6 +2394,16 @@ bool AutoOutputFileStream::Open(const std::string& file) {
     return true;
   }
 
+  if (!IsStdinStdoutPath(file) && UseIoUring()) {
+    std::unique_ptr<IoUringOutputStream> os(new IoUringOutputStream);
+    // Otherwise, fall back to 'CFileStream'.
+    if (os->Open(file)) {
+      os_ = std::move(os);
+      bad_ = 0;
+      return true;
+    }
+  }
+
   std::unique_ptr<CFileStream> os(new CFileStream);
   if (!os->Open(file, FILE_OPEN_MODE_OUT | FILE_OPEN_MODE_BINARY)) {
     return false;
@@ -322,6 +322,27 @@ TEST_F(BufferedInputStreamTest, GetLine_buf_size64k) {
   TestGetLine(is);
 }
 
+TEST_F(BufferedInputStreamTest, GetLine_across_buf) {
+  std::string buf;
+  std::vector<std::string> lines, expected_lines;
+  for (int i = 0; i < 100; ++i) {
+    expected_lines.emplace_back((size_t)i * 7, (char)('a' + i % 26));
+    buf += expected_lines.back();
+    buf += '\n';
+  }
+  buf += "no delim";
+
+  InputStringStream iss;
+  iss.SetView(buf);
+  BufferedInputStream is(&iss, 64);
+  std::string line;
+  while (GetLine(is, line)) {
+    lines.emplace_back(line);
+  }
+  EXPECT_EQ(lines, expected_lines);
+  EXPECT_EQ(line, "no delim");
+}
+
 TEST_F(BufferedInputStreamTest, Read_buf_size64) {
   CFileStream fs;
   ASSERT_TRUE(fs.Open(file_, FILE_OPEN_MODE_IN));
@@ -400,6 +421,104 @@ TEST_F(GunzipInputStreamTest, Peek_buf_size64k) {
   TestPeek(is);
 }
 
+/************************************************************************/
+/* ReadAheadInputStream */
+/************************************************************************/
+class ReadAheadInputStreamTest : public BufferedInputStreamTest {};
+
+TEST_F(ReadAheadInputStreamTest, GetLine) {
+  for (int blocks : {1, 2, 4}) {
+    for (size_t block_size : {64, 64 * 1024}) {
+      CFileStream fs;
+      ASSERT_TRUE(fs.Open(file_, FILE_OPEN_MODE_IN));
+      ReadAheadInputStream is(&fs, blocks, block_size);
+      TestGetLine(is);
+    }
+  }
+}
+
+TEST_F(ReadAheadInputStreamTest, GetLine_across_block) {
+  std::string buf;
+  std::vector<std::string> lines, expected_lines;
+  for (int i = 0; i < 100; ++i) {
+    expected_lines.emplace_back((size_t)i * 7, (char)('a' + i % 26));
+    buf += expected_lines.back();
+    buf += '\n';
+  }
+  buf += "no delim";
+
+  InputStringStream iss;
+  iss.SetView(buf);
+  ReadAheadInputStream is(&iss, 2, 64);
+  std::string line;
+  while (GetLine(is, line)) {
+    lines.emplace_back(line);
+  }
+  EXPECT_EQ(lines, expected_lines);
+  EXPECT_EQ(line, "no delim");
+}
+
+TEST_F(ReadAheadInputStreamTest, Read) {
+  for (int blocks : {1, 2, 4}) {
+    for (size_t block_size : {64, 64 * 1024}) {
+      CFileStream fs;
+      ASSERT_TRUE(fs.Open(file_, FILE_OPEN_MODE_IN));
+      ReadAheadInputStream is(&fs, blocks, block_size);
+      TestRead(is);
+    }
+  }
+}
+
+TEST_F(ReadAheadInputStreamTest, Peek) {
+  // Peek 256 bytes at most in 'blocks' blocks.
+  CFileStream fs1;
+  ASSERT_TRUE(fs1.Open(file_, FILE_OPEN_MODE_IN));
+  ReadAheadInputStream is1(&fs1, 4, 128);
+  TestPeek(is1);
+
+  CFileStream fs2;
+  ASSERT_TRUE(fs2.Open(file_, FILE_OPEN_MODE_IN));
+  ReadAheadInputStream is2(&fs2, 2, 64 * 1024);
+  TestPeek(is2);
+}
+
+TEST_F(ReadAheadInputStreamTest, Gunzip) {
+  CFileStream fs;
+  ASSERT_TRUE(
+      fs.Open(file_ + ".gz", FILE_OPEN_MODE_IN | FILE_OPEN_MODE_BINARY));
+  ReadAheadInputStream ras(&fs, 2, 64);
+  GunzipInputStream is(&ras, 64);
+  TestGetLine(is);
+}
+
+TEST_F(ReadAheadInputStreamTest, Close_early) {
+  CFileStream fs;
+  ASSERT_TRUE(fs.Open(file_, FILE_OPEN_MODE_IN));
+  ReadAheadInputStream is(&fs, 2, 64);
+  EXPECT_EQ(is.ReadChar(), '0');
+}
+
+/************************************************************************/
+/* AutoInputFileStream */
+/************************************************************************/
+class AutoInputFileStreamTest : public BufferedInputStreamTest {};
+
+TEST_F(AutoInputFileStreamTest, GetLine) {
+  AutoInputFileStream is;
+  ASSERT_TRUE(is.Open(file_));
+  TestGetLine(is);
+  ASSERT_TRUE(is.Open(file_ + ".gz"));
+  TestGetLine(is);
+}
+
+TEST_F(AutoInputFileStreamTest, Read) {
+  AutoInputFileStream is;
+  ASSERT_TRUE(is.Open(file_));
+  TestRead(is);
+  ASSERT_TRUE(is.Open(file_ + ".gz"));
+  TestRead(is);
+}
+
 /************************************************************************/
 /* CFileStream */
 /************************************************************************/
@@ -489,6 +608,21 @@ TEST_F(InputStringStreamTest, SetString_GetLine_delim) {
   EXPECT_EQ(lines, expected_lines);
 }
 
+TEST_F(InputStringStreamTest, SetString_GetLine_no_delim) {
+  InputStringStream is;
+  std::string line;
+  std::vector<std::string> lines;
+  std::vector<std::string> expected_lines{"1a2a"};
+  is.SetString("1a2a\n3a4a");
+  while (GetLine(is, line)) {
+    lines.emplace_back(line);
+  }
+  EXPECT_EQ(lines, expected_lines);
+  EXPECT_EQ(line, "3a4a");
+  EXPECT_FALSE(GetLine(is, line));
+  EXPECT_EQ(line, "");
+}
+
 TEST_F(InputStringStreamTest, SetString_Read) {
   InputStringStream is;
   char c;
@@ -3,87 +3,483 @@
 //
 
 #include <deepx_core/common/thread_pool.h>
+#include <chrono>
+#include <cstdint>
 #include <utility>
+#if OS_LINUX == 1
+#include <pthread.h>
+#include <sched.h>
+#endif
 #if !defined NDEBUG
 #include <stdexcept>  // std::runtime_error
 #endif
 
 namespace deepx_core {
 
-int ThreadPool::started() const {
-  std::unique_lock<std::mutex> guard(mutex_);
-  return started_;
-}
+namespace {
 
-void ThreadPool::worker_thread() {
-  function_t func;
-  for (;;) {
-    std::unique_lock<std::mutex> guard(mutex_);
-    while (started_ && tasks_.empty()) {
-      cond_.wait(guard);
+/************************************************************************/
+/* WorkStealingDeque */
+/************************************************************************/
+// Chase-Lev deque.
+//
+// "Correct and Efficient Work-Stealing for Weak Memory Models", PPoPP 2013.
+//
+// 'push' and 'pop' can only be called by the owner,
+// 'steal' can be called by any thread.
+template <typename T>
+class WorkStealingDeque {
+ private:
+  struct Array {
+    const int64_t capacity;
+    const int64_t mask;
+    std::unique_ptr<std::atomic<T*>[]> buf;
+
+    explicit Array(int64_t _capacity)
+        : capacity(_capacity),
+          mask(_capacity - 1),
+          buf(new std::atomic<T*>[(size_t)_capacity]) {}
+
+    T* get(int64_t i) const noexcept {
+      return buf[(size_t)(i & mask)].load(std::memory_order_relaxed);
     }
 
-    if (!started_) {
-      break;
+    void put(int64_t i, T* x) noexcept {
+      buf[(size_t)(i & mask)].store(x, std::memory_order_relaxed);
     }
+  };
 
-    func = std::move(tasks_.front());
-    tasks_.pop_front();
-    guard.unlock();
-    func();
+  std::atomic<int64_t> top_{0};
+  std::atomic<int64_t> bottom_{0};
+  std::atomic<Array*> array_;
+  // Retired arrays may still be read by thieves, they are released with the
+  // deque.
+  std::vector<std::unique_ptr<Array>> arrays_;
+
+  Array* grow(Array* a, int64_t b, int64_t t) {
+    std::unique_ptr<Array> new_a(new Array(a->capacity * 2));
+    for (int64_t i = t; i < b; ++i) {
+      new_a->put(i, a->get(i));
+    }
+    Array* p = new_a.get();
+    arrays_.emplace_back(std::move(new_a));
+    array_.store(p, std::memory_order_release);
+    return p;
   }
 
-  std::unique_lock<std::mutex> guard(mutex_);
-  while (!tasks_.empty()) {
-    func = std::move(tasks_.front());
-    tasks_.pop_front();
-    guard.unlock();
-    func();
-    guard.lock();
+ public:
+  explicit WorkStealingDeque(int64_t capacity = 256) {
+    arrays_.emplace_back(new Array(capacity));
+    array_.store(arrays_.back().get(), std::memory_order_relaxed);
   }
-}
 
-ThreadPool::~ThreadPool() { stop(); }
+  int64_t size() const noexcept {
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t t = top_.load(std::memory_order_relaxed);
+    return b > t ? b - t : 0;
+  }
 
-void ThreadPool::start(int n) {
-  std::unique_lock<std::mutex> guard(mutex_);
-  if (!started_) {
-    started_ = 1;
-    for (int i = 0; i < n; ++i) {
-      threads_.emplace_back([this]() { worker_thread(); });
+  void push(T* x) {
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t t = top_.load(std::memory_order_acquire);
+    Array* a = array_.load(std::memory_order_relaxed);
+    if (b - t > a->capacity - 1) {
+      a = grow(a, b, t);
     }
+    a->put(b, x);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
   }
-}
 
-void ThreadPool::stop() {
-  {
-    std::unique_lock<std::mutex> guard(mutex_);
-    if (started_) {
-      started_ = 0;
+  T* pop() noexcept {
+    int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    Array* a = array_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top_.load(std::memory_order_relaxed);
+    T* x = nullptr;
+    if (t <= b) {
+      x = a->get(b);
+      if (t == b) {
+        // the last element, race against thieves
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+          x = nullptr;
+        }
+        bottom_.store(b + 1, std::memory_order_relaxed);
+      }
+    } else {
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return x;
+  }
+
+  T* steal() noexcept {
+    int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom_.load(std::memory_order_acquire);
+    if (t < b) {
+      Array* a = array_.load(std::memory_order_acquire);
+      T* x = a->get(t);
+      if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+        return nullptr;
+      }
+      return x;
+    }
+    return nullptr;
+  }
+};
+
+/************************************************************************/
+/* TaskCache */
+/************************************************************************/
+// A thread local cache of task nodes.
+//
+// Tasks posted by other threads are released by workers,
+// they flow back to the posters by the free list of the thread pool
+// in batches of 'BATCH_SIZE'.
+class TaskCache {
+ public:
+  static constexpr size_t MAX_SIZE = 1024;
+  static constexpr size_t BATCH_SIZE = 64;
+
+ private:
+  std::vector<ThreadPool::Task*> tasks_;
+
+ public:
+  TaskCache() { tasks_.reserve(MAX_SIZE); }
+
+  ~TaskCache() {
+    for (ThreadPool::Task* task : tasks_) {
+      delete task;
+    }
+  }
+
+  bool empty() const noexcept { return tasks_.empty(); }
+  bool full() const noexcept { return tasks_.size() >= MAX_SIZE; }
+
+  ThreadPool::Task* get() {
+    if (tasks_.empty()) {
+      return new ThreadPool::Task;
     }
-    cond_.notify_all();
+    ThreadPool::Task* task = tasks_.back();
+    tasks_.pop_back();
+    return task;
   }
 
-  if (!threads_.empty()) {
-    for (std::thread& thread : threads_) {
-      thread.join();
+  void put(ThreadPool::Task* task) noexcept {
+    if (tasks_.size() < MAX_SIZE) {
+      tasks_.emplace_back(task);
+    } else {
+      delete task;
     }
-    threads_.clear();
   }
+
+  // Move at most 'BATCH_SIZE' tasks from 'from' to 'to'.
+  static void Move(std::vector<ThreadPool::Task*>* from,
+                   std::vector<ThreadPool::Task*>* to) {
+    size_t size = from->size() < BATCH_SIZE ? from->size() : BATCH_SIZE;
+    to->insert(to->end(), from->end() - size, from->end());
+    from->resize(from->size() - size);
+  }
+
+  std::vector<ThreadPool::Task*>* tasks() noexcept { return &tasks_; }
+};
+
+}  // namespace
+
+/************************************************************************/
+/* ThreadPool::Worker */
+/************************************************************************/
+struct ThreadPool::Worker {
+  ThreadPool* pool = nullptr;
+  int index = 0;
+  uint32_t seed = 0;
+  uint32_t tick = 0;
+  WorkStealingDeque<Task> deque;
+  std::thread thread;
+
+  uint32_t next_random() noexcept {
+    // xorshift32
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+  }
+};
+
+namespace {
+
+TaskCache& GetTaskCache() {
+  static thread_local TaskCache cache;
+  return cache;
+}
+
+constexpr int SPIN_COUNT = 64;
+// Check the injection queue first every 'INJECT_INTERVAL' tasks,
+// so that external submissions are not starved by local tasks.
+constexpr uint32_t INJECT_INTERVAL = 61;
+
+}  // namespace
+
+ThreadPool::Worker*& ThreadPool::current_worker() noexcept {
+  static thread_local Worker* worker = nullptr;
+  return worker;
 }
 
-void ThreadPool::post(function_t func) {
+ThreadPool::Task* ThreadPool::allocate_task() {
+  TaskCache& cache = GetTaskCache();
+  if (cache.empty() && free_size_.load(std::memory_order_relaxed) > 0) {
+    std::unique_lock<std::mutex> guard(free_mutex_);
+    TaskCache::Move(&free_tasks_, cache.tasks());
+    free_size_.store(free_tasks_.size(), std::memory_order_relaxed);
+  }
+  return cache.get();
+}
+
+void ThreadPool::release_task(Task* task) noexcept {
+  task->reset();
+  TaskCache& cache = GetTaskCache();
+  if (cache.full()) {
+    std::unique_lock<std::mutex> guard(free_mutex_);
+    if (free_tasks_.size() < MAX_FREE_SIZE) {
+      TaskCache::Move(cache.tasks(), &free_tasks_);
+      free_size_.store(free_tasks_.size(), std::memory_order_relaxed);
+    }
+  }
+  cache.put(task);
+}
+
+int ThreadPool::started() const noexcept {
+  return started_.load(std::memory_order_acquire);
+}
+
+void ThreadPool::post_task(Task* task) {
 #if !defined NDEBUG
   if (!started()) {
+    release_task(task);
     throw std::runtime_error("post: the thread pool is not started.");
   }
 #endif
 
+  Worker* worker = current_worker();
+  if (worker && worker->pool == this) {
+    worker->deque.push(task);
+  } else {
+    std::unique_lock<std::mutex> guard(inject_mutex_);
+    inject_queue_.emplace_back(task);
+    inject_size_.store(inject_queue_.size(), std::memory_order_relaxed);
+  }
+  notify_one();
+}
+
+void ThreadPool::notify_one() {
+  // Pairs with the fence in 'worker_thread' before it parks.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (sleeping_.load(std::memory_order_relaxed) > 0) {
+    std::unique_lock<std::mutex> guard(park_mutex_);
+    park_cond_.notify_one();
+  }
+}
+
+bool ThreadPool::has_work() const noexcept {
+  if (inject_size_.load(std::memory_order_relaxed) > 0) {
+    return true;
+  }
+  for (const std::unique_ptr<Worker>& worker : workers_) {
+    if (worker->deque.size() > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+ThreadPool::Task* ThreadPool::pop_inject() noexcept {
+  if (inject_size_.load(std::memory_order_relaxed) == 0) {
+    return nullptr;
+  }
+  std::unique_lock<std::mutex> guard(inject_mutex_);
+  if (inject_queue_.empty()) {
+    return nullptr;
+  }
+  Task* task = inject_queue_.front();
+  inject_queue_.pop_front();
+  inject_size_.store(inject_queue_.size(), std::memory_order_relaxed);
+  return task;
+}
+
+ThreadPool::Task* ThreadPool::steal(Worker* thief) noexcept {
+  int n = (int)workers_.size();
+  if (n == 0) {
+    return nullptr;
+  }
+  int begin = thief ? (int)(thief->next_random() % (uint32_t)n) : 0;
+  for (int i = 0; i < n; ++i) {
+    Worker* victim = workers_[(begin + i) % n].get();
+    if (victim == thief) {
+      continue;
+    }
+    Task* task = victim->deque.steal();
+    if (task) {
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+ThreadPool::Task* ThreadPool::find_task(Worker* worker) noexcept {
+  Task* task;
+  if (++worker->tick % INJECT_INTERVAL == 0) {
+    task = pop_inject();
+    if (task) {
+      return task;
+    }
+  }
+  task = worker->deque.pop();
+  if (task) {
+    return task;
+  }
+  task = pop_inject();
+  if (task) {
+    return task;
+  }
+  return steal(worker);
+}
+
+bool ThreadPool::try_run_one() {
+  Worker* worker = current_worker();
+  Task* task;
+  if (worker && worker->pool == this) {
+    task = find_task(worker);
+  } else {
+    task = pop_inject();
+    if (!task) {
+      task = steal(nullptr);
+    }
+  }
+  if (!task) {
+    return false;
+  }
+  (*task)();
+  release_task(task);
+  return true;
+}
+
+void ThreadPool::worker_thread(Worker* worker) {
+  current_worker() = worker;
+  for (;;) {
+    Task* task = find_task(worker);
+    for (int i = 0; task == nullptr && i < SPIN_COUNT; ++i) {
+      std::this_thread::yield();
+      task = find_task(worker);
+    }
+
+    if (task) {
+      (*task)();
+      release_task(task);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> guard(park_mutex_);
+    sleeping_.fetch_add(1, std::memory_order_relaxed);
+    // Pairs with the fence in 'notify_one'.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (has_work()) {
+      sleeping_.fetch_sub(1, std::memory_order_relaxed);
+      continue;
+    }
+    if (!started()) {
+      // All remaining tasks have been run.
+      sleeping_.fetch_sub(1, std::memory_order_relaxed);
+      break;
+    }
+    park_cond_.wait(guard);
+    sleeping_.fetch_sub(1, std::memory_order_relaxed);
+  }
+  current_worker() = nullptr;
+}
+
+void ThreadPool::wait(wait_token_t* token) {
+  Worker* worker = current_worker();
+  if (worker && worker->pool == this) {
+    // Run other tasks instead of blocking the worker.
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> guard(token->mutex);
+        if (token->remain == 0) {
+          return;
+        }
+      }
+      if (!try_run_one()) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  std::unique_lock<std::mutex> guard(token->mutex);
+  while (token->remain) {
+    token->cond.wait(guard);
+  }
+}
+
+ThreadPool::ThreadPool() = default;
+
+ThreadPool::~ThreadPool() {
+  stop();
+  for (Task* task : free_tasks_) {
+    delete task;
+  }
+}
+
+void ThreadPool::start(int n) {
+  std::unique_lock<std::mutex> guard(park_mutex_);
+  if (started()) {
+    return;
+  }
+
+  for (int i = 0; i < n; ++i) {
+    std::unique_ptr<Worker> worker(new Worker);
+    worker->pool = this;
+    worker->index = i;
+    worker->seed = (uint32_t)(2654435761u * (uint32_t)(i + 1));
+    workers_.emplace_back(std::move(worker));
+  }
+  started_.store(1, std::memory_order_release);
+
+  // Workers are created after 'workers_' is populated,
+  // since they steal from each other.
+#if OS_LINUX == 1
+  unsigned int cpus = std::thread::hardware_concurrency();
+#endif
+  for (std::unique_ptr<Worker>& worker : workers_) {
+    Worker* w = worker.get();
+    w->thread = std::thread([this, w]() { worker_thread(w); });
+#if OS_LINUX == 1
+    if (cpu_affinity_ && cpus > 0) {
+      cpu_set_t cpu_set;
+      CPU_ZERO(&cpu_set);
+      CPU_SET(w->index % cpus, &cpu_set);
+      pthread_setaffinity_np(w->thread.native_handle(), sizeof(cpu_set),
+                             &cpu_set);
+    }
+#endif
+  }
+}
+
+void ThreadPool::stop() {
   {
-    std::unique_lock<std::mutex> guard(mutex_);
-    tasks_.emplace_front(std::move(func));
+    std::unique_lock<std::mutex> guard(park_mutex_);
+    started_.store(0, std::memory_order_release);
+    park_cond_.notify_all();
+  }
+
+  for (std::unique_ptr<Worker>& worker : workers_) {
+    if (worker->thread.joinable()) {
+      worker->thread.join();
+    }
   }
-  cond_.notify_one();
+  workers_.clear();
 }
 
 void ThreadPool::run(const function_t& func, wait_token_t* token) {
@@ -101,11 +497,7 @@ void ThreadPool::run(const function_t& func, wait_token_t* token) {
       token->cond.notify_all();
     }
   });
-
-  std::unique_lock<std::mutex> guard(token->mutex);
-  while (token->remain) {
-    token->cond.wait(guard);
-  }
+  wait(token);
 }
 
 void ThreadPool::run(const std::vector<function_t>& funcs,
@@ -126,11 +518,25 @@ void ThreadPool::run(const std::vector<function_t>& funcs,
       }
     });
   }
+  wait(token);
+}
 
-  std::unique_lock<std::mutex> guard(token->mutex);
-  while (token->remain) {
-    token->cond.wait(guard);
+/************************************************************************/
+/* ThreadPool::TaskGroup */
+/************************************************************************/
+void ThreadPool::TaskGroup::wait() {
+  while (pending_.load(std::memory_order_acquire) > 0) {
+    if (pool_->try_run_one()) {
+      continue;
+    }
+    std::unique_lock<std::mutex> guard(mutex_);
+    // Wake up periodically to help with tasks posted meanwhile.
+    cond_.wait_for(guard, std::chrono::milliseconds(1), [this]() {
+      return pending_.load(std::memory_order_acquire) == 0;
+    });
   }
+  // Wait for the last 'done' to release 'mutex_'.
+  std::unique_lock<std::mutex> guard(mutex_);
 }
 
 }  // namespace deepx_core
@@ -5,6 +5,8 @@
 #include <deepx_core/common/thread_pool.h>
 #include <gtest/gtest.h>
 #include <atomic>
+#include <thread>
+#include <vector>
 
 namespace deepx_core {
 
@@ -24,6 +26,26 @@ TEST_F(ThreadPoolTest, post) {
   EXPECT_EQ(sum, N * (N - 1) / 2);
 }
 
+TEST_F(ThreadPoolTest, post_from_threads) {
+  // Task nodes released by workers flow back to the posters.
+  ThreadPool thread_pool;
+  std::atomic<int> sum(0);
+  thread_pool.start(2);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 2; ++i) {
+    threads.emplace_back([&thread_pool, &sum, this]() {
+      for (int j = 0; j < 10 * N; ++j) {
+        thread_pool.post([&sum]() { sum += 1; });
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  thread_pool.stop();
+  EXPECT_EQ(sum, 20 * N);
+}
+
 TEST_F(ThreadPoolTest, run_1) {
   ThreadPool thread_pool;
   ThreadPool::wait_token_t token;
@@ -49,4 +71,125 @@ TEST_F(ThreadPoolTest, run_2) {
   EXPECT_EQ(sum, N * (N - 1));
 }
 
+TEST_F(ThreadPoolTest, post_large_func) {
+  ThreadPool thread_pool;
+  std::atomic<int> sum(0);
+  thread_pool.start(4);
+  for (int i = 0; i < N; ++i) {
+    std::vector<int> v(i % 8 + 1, 1);
+    char padding[ThreadPool::Task::INLINE_SIZE] = {0};
+    thread_pool.post([&sum, v, padding]() {
+      for (int j : v) {
+        sum += j + padding[0];
+      }
+    });
+  }
+  thread_pool.stop();
+  int expected_sum = 0;
+  for (int i = 0; i < N; ++i) {
+    expected_sum += i % 8 + 1;
+  }
+  EXPECT_EQ(sum, expected_sum);
+}
+
+TEST_F(ThreadPoolTest, post_in_worker) {
+  ThreadPool thread_pool;
+  std::atomic<int> sum(0);
+  thread_pool.start(4);
+  for (int i = 0; i < N; ++i) {
+    thread_pool.post([&thread_pool, &sum, i]() {
+      thread_pool.post([&sum, i]() { sum += i; });
+    });
+  }
+  thread_pool.stop();
+  EXPECT_EQ(sum, N * (N - 1) / 2);
+}
+
+TEST_F(ThreadPoolTest, restart) {
+  ThreadPool thread_pool;
+  std::atomic<int> sum(0);
+  for (int k = 0; k < 3; ++k) {
+    thread_pool.start(2);
+    for (int i = 0; i < N; ++i) {
+      thread_pool.post([&sum, i]() { sum += i; });
+    }
+    thread_pool.stop();
+  }
+  EXPECT_EQ(sum, 3 * N * (N - 1) / 2);
+}
+
+TEST_F(ThreadPoolTest, parallel_for) {
+  ThreadPool thread_pool;
+  std::vector<int> v(N, 0);
+  thread_pool.start(4);
+  for (size_t grain : {0, 1, 7, 1000, 5000}) {
+    thread_pool.parallel_for(0, v.size(), grain, [&v](size_t i) { v[i] += 1; });
+  }
+  thread_pool.stop();
+  for (int i = 0; i < N; ++i) {
+    EXPECT_EQ(v[i], 5);
+  }
+}
+
+TEST_F(ThreadPoolTest, parallel_for_nested) {
+  ThreadPool thread_pool;
+  std::atomic<int> sum(0);
+  thread_pool.start(2);
+  thread_pool.parallel_for(0, 16, 1, [&thread_pool, &sum](size_t) {
+    thread_pool.parallel_for(0, 100, 10,
+                             [&sum](size_t j) { sum += (int)j; });
+  });
+  thread_pool.stop();
+  EXPECT_EQ(sum, 16 * 100 * 99 / 2);
+}
+
+TEST_F(ThreadPoolTest, parallel_for_stress) {
+  // Short-lived task groups on the stack are destroyed right after 'wait'.
+  ThreadPool thread_pool;
+  std::atomic<int> sum(0);
+  thread_pool.start(4);
+  for (int i = 0; i < 20 * N; ++i) {
+    thread_pool.parallel_for(0, 8, 1, [&sum](size_t j) { sum += (int)j; });
+  }
+  thread_pool.parallel_for(0, 200, 1, [&thread_pool, &sum](size_t) {
+    for (int i = 0; i < 50; ++i) {
+      thread_pool.parallel_for(0, 4, 1, [&sum](size_t j) { sum += (int)j; });
+    }
+  });
+  thread_pool.stop();
+  EXPECT_EQ(sum, 20 * N * 28 + 200 * 50 * 6);
+}
+
+TEST_F(ThreadPoolTest, TaskGroup) {
+  ThreadPool thread_pool;
+  std::atomic<int> sum(0);
+  thread_pool.start(4);
+  {
+    ThreadPool::TaskGroup group(&thread_pool);
+    for (int i = 0; i < N; ++i) {
+      group.spawn([&thread_pool, &sum, i]() {
+        ThreadPool::TaskGroup sub_group(&thread_pool);
+        sub_group.spawn([&sum, i]() { sum += i; });
+        sub_group.spawn([&sum, i]() { sum += i; });
+        sub_group.wait();
+      });
+    }
+    group.wait();
+    EXPECT_EQ(sum, N * (N - 1));
+  }
+  thread_pool.stop();
+}
+
+TEST_F(ThreadPoolTest, cpu_affinity) {
+  ThreadPool thread_pool;
+  std::atomic<int> sum(0);
+  thread_pool.set_cpu_affinity(1);
+  thread_pool.start(4);
+  for (int i = 0; i < N; ++i) {
+    thread_pool.post([&sum, i]() { sum += i; });
+  }
+  thread_pool.stop();
+  EXPECT_EQ(sum, N * (N - 1) / 2);
+}
+
 }  // namespace deepx_core
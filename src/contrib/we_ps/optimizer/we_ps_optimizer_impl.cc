@@ -151,9 +151,12 @@ void WePSOptimizerImpl::Update(TensorMap* grad, TensorMap* delta_param) {
     Update(name, &Gany, &Wany, &Dany);
   }
   PostUpdate();
+  RemoveEvictedIds();
 
   if (++update_times_ == 10000) {  // magic number
-    UpdateCache();
+    if (cache_.initialized()) {
+      DXINFO("Cache hit rate is: %.2f.", cache_.hit_rate());
+    }
     update_times_ = 0;
   }
 }
@@ -190,9 +193,7 @@ void WePSOptimizerImpl::Update(const std::string& name, Any* Gany, Any* Wany,
     auto& D = Dany->unsafe_to_ref<srm_t>();
     if (Gany->is<srm_t>()) {
       auto& G = Gany->unsafe_to_ref<srm_t>();
-      for (auto& entry : G) {
-        active_ids_.emplace(entry.first);
-      }
+      UpdateCache(G);
       ll_we_ps_optimizer_t::Clip(&G);
       UpdateSRM2SRM(name, G, W, &D, &srm_slot);
     }
@@ -200,28 +201,43 @@ void WePSOptimizerImpl::Update(const std::string& name, Any* Gany, Any* Wany,
 }
 
 void WePSOptimizerImpl::InitCache(size_t cache_size) {
+  cache_.init(cache_size);
   cache_.set_evict_callback(
       [this](const srm_t::key_type& key, const bool& /*value*/) {
-        evicted_ids_.emplace(key);
+        std::unique_lock<std::mutex> guard(evicted_ids_mutex_);
+        evicted_ids_.emplace_back(key);
       });
-  cache_.init(cache_size);
 }
 
-void WePSOptimizerImpl::UpdateCache() {
-  evicted_ids_.clear();
-  for (int_t id : active_ids_) {
-    cache_.get_or_insert(id);
+void WePSOptimizerImpl::UpdateCache(const srm_t& G) {
+  if (!cache_.initialized()) {
+    return;
   }
-  active_ids_.clear();
-  DXINFO("Cache hit rate is: %.2f.", cache_.hit_rate());
-  if (!evicted_ids_.empty()) {
-    auto filter = [this](const std::string& /*name*/, srm_t* W) {
-      W->remove_if([this](const srm_t::value_type& entry) {
-        return evicted_ids_.count(entry.first) > 0;
-      });
-    };
-    ForEachSRM(filter);
+
+  std::vector<int_t> ids;
+  ids.reserve(G.size());
+  for (const auto& entry : G) {
+    ids.emplace_back(entry.first);
   }
+  cache_.get_or_insert_batch(ids.begin(), ids.end());
+}
+
+void WePSOptimizerImpl::RemoveEvictedIds() {
+  std::vector<int_t> evicted_ids;
+  {
+    std::unique_lock<std::mutex> guard(evicted_ids_mutex_);
+    if (evicted_ids_.empty()) {
+      return;
+    }
+    evicted_ids.swap(evicted_ids_);
+  }
+
+  auto filter = [&evicted_ids](const std::string& /*name*/, srm_t* W) {
+    for (int_t id : evicted_ids) {
+      W->erase(id);
+    }
+  };
+  ForEachSRM(filter);
 }
 
 /************************************************************************/
@@ -6,12 +6,51 @@
 #include <deepx_core/dx_log.h>
 #include <deepx_core/graph/feature_kv_util.h>
 #include <cstring>  // memcpy
-#include <limits>   // std::numeric_limits
+#include <deque>
+#include <limits>  // std::numeric_limits
 #if HAVE_SAGE2 == 1
 #include <sage2/half.h>
 #endif
 
 namespace deepx_core {
+namespace {
+
+using float_t = DataType::float_t;
+using int_t = DataType::int_t;
+using srm_t = DataType::srm_t;
+using id_set_t = DataType::id_set_t;
+
+// Return 'W' if its rows are in 'float_t',
+// otherwise decode its rows to a new matrix in 'decoded'.
+//
+// If 'id_set' is not null, only its rows are decoded.
+const srm_t& GetFloatSRM(const srm_t& W, const id_set_t* id_set,
+                         std::deque<srm_t>* decoded) {
+  if (!IsHalfDtype(W.storage_dtype())) {
+    return W;
+  }
+
+  decoded->emplace_back();
+  srm_t& float_W = decoded->back();
+  float_W.set_col(W.col());
+  if (id_set) {
+    std::vector<float_t> row_value(W.col());
+    float_W.reserve(id_set->size());
+    for (int_t id : *id_set) {
+      if (W.decode_row(id, row_value.data())) {
+        float_W.assign(id, row_value.data());
+      }
+    }
+  } else {
+    float_W.reserve(W.size());
+    W.for_each_row([&float_W](int_t row, const float_t* row_value) {
+      float_W.assign(row, row_value);
+    });
+  }
+  return float_W;
+}
+
+}  // namespace
 
 /************************************************************************/
 /* FeatureKVUtil */
@@ -281,12 +320,14 @@ bool FeatureKVUtil::WriteSparseParam(OutputStream& os, const Graph& graph,
   CheckVersion(version);
 
   DXINFO("Collecting sparse param...");
+  std::deque<srm_t> decoded;
   id_2_sparse_values_t id_2_sparse_values;
   for (const auto& entry : param) {
     const std::string& name = entry.first;
     const Any& Wany = entry.second;
     if (Wany.is<srm_t>()) {
-      const auto& W = Wany.unsafe_to_ref<srm_t>();
+      const auto& W =
+          GetFloatSRM(Wany.unsafe_to_ref<srm_t>(), nullptr, &decoded);
       uint16_t node_id = graph.find_node(name)->node_id();
       uint16_t embedding_col = (uint16_t)W.col();  // NOLINT
       for (const auto& _entry : W) {
@@ -308,13 +349,15 @@ bool FeatureKVUtil::WriteSparseParam(OutputStream& os, const Graph& graph,
   DXINFO("Collecting sparse param within %zu ids...", id_set.size());
   using sparse_meta_t = std::tuple<const srm_t*, uint16_t>;
   using sparse_metas_t = std::vector<sparse_meta_t>;
+  std::deque<srm_t> decoded;
   sparse_metas_t sparse_metas;
   sparse_metas.reserve(param.size());
   for (const auto& entry : param) {
     const std::string& name = entry.first;
     const Any& Wany = entry.second;
     if (Wany.is<srm_t>()) {
-      const auto& W = Wany.unsafe_to_ref<srm_t>();
+      const auto& W =
+          GetFloatSRM(Wany.unsafe_to_ref<srm_t>(), &id_set, &decoded);
       uint16_t node_id = graph.find_node(name)->node_id();
       sparse_metas.emplace_back(&W, node_id);
     }
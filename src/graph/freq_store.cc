@@ -4,6 +4,7 @@
 // Author: Yafei Zhang (kimmyzhang@tencent.com)
 //
 
+#include <deepx_core/common/chunked_stream.h>
 #include <deepx_core/dx_log.h>
 #include <deepx_core/graph/freq_store.h>
 #include <limits>  // std::numeric_limits
@@ -66,14 +67,11 @@ bool FreqStore::Read(InputStream& is) {
   return true;
 }
 
-bool FreqStore::Save(const std::string& file) const {
-  AutoOutputFileStream os;
-  if (!os.Open(file)) {
-    DXERROR("Failed to open: %s.", file.c_str());
-    return false;
-  }
+bool FreqStore::Save(const std::string& file, size_t chunk_size,
+                     bool compress) const {
   DXINFO("Saving FreqStore to %s...", file.c_str());
-  if (!Write(os)) {
+  auto write = [this](OutputStream& os) { return Write(os); };
+  if (!SaveFile(file, chunk_size, write, compress)) {
     return false;
   }
   DXINFO("Done.");
@@ -81,7 +79,7 @@ bool FreqStore::Save(const std::string& file) const {
 }
 
 bool FreqStore::Load(const std::string& file) {
-  AutoInputFileStream is;
+  ChunkedInputFileStream is;
   if (!is.Open(file)) {
     DXERROR("Failed to open: %s.", file.c_str());
     return false;
@@ -222,9 +220,7 @@ void FreqStore::Filter_NoLock(TensorMap* grad) const {
     Any& Gany = entry.second;
     if (Gany.is<srm_t>()) {
       auto& G = Gany.unsafe_to_ref<srm_t>();
-      G.remove_if([this](const srm_t::value_type& entry) {
-        return Filter_NoLock(entry.first);
-      });
+      G.remove_if([this](int_t id) { return Filter_NoLock(id); });
     }
   }
 }
@@ -234,9 +230,7 @@ void FreqStore::Filter_Lock(TensorMap* grad) const {
     Any& Gany = entry.second;
     if (Gany.is<srm_t>()) {
       auto& G = Gany.unsafe_to_ref<srm_t>();
-      G.remove_if([this](const srm_t::value_type& entry) {
-        return Filter_Lock(entry.first);
-      });
+      G.remove_if([this](int_t id) { return Filter_Lock(id); });
     }
   }
 }
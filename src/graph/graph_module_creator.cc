@@ -420,14 +420,14 @@ std::vector<GraphNode*> BinaryClassificationTarget(const std::string& prefix,
   DXCHECK_THROW(X->shape().is_rank(2));
   DXCHECK_THROW(X->shape()[1] == 1);
   auto* Y = GetY(1);
-  auto* L = SigmoidBCELoss(prefix + "L", X, Y);
   auto* P = Sigmoid(prefix + "P", X);
   if (has_w) {
     auto* W = GetW(1);
-    auto* WL = Mul(prefix + "WL", L, W);
+    auto* WL = WeightedSigmoidBCELoss(prefix + "WL", X, Y, W);
     auto* WM = ReduceMean(prefix + "WM", WL);
     return {WM, P};
   } else {
+    auto* L = SigmoidBCELoss(prefix + "L", X, Y);
     auto* M = ReduceMean(prefix + "M", L);
     return {M, P};
   }
@@ -437,14 +437,14 @@ std::vector<GraphNode*> BinaryClassificationTarget(GraphNode* X, int has_w) {
   DXCHECK_THROW(X->shape().is_rank(2));
   DXCHECK_THROW(X->shape()[1] == 1);
   auto* Y = GetY(1);
-  auto* L = SigmoidBCELoss("", X, Y);
   auto* P = Sigmoid("", X);
   if (has_w) {
     auto* W = GetW(1);
-    auto* WL = Mul("", L, W);
+    auto* WL = WeightedSigmoidBCELoss("", X, Y, W);
     auto* WM = ReduceMean("", WL);
     return {WM, P};
   } else {
+    auto* L = SigmoidBCELoss("", X, Y);
     auto* M = ReduceMean("", L);
     return {M, P};
   }
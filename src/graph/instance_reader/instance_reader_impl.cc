@@ -3,32 +3,83 @@
 //
 
 #include <deepx_core/graph/instance_reader_impl.h>
+#if OS_POSIX == 1
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+#include <algorithm>  // std::copy, std::min
+#include <cerrno>
+#include <cstring>  // memchr, strerror
 
 namespace deepx_core {
 
-/************************************************************************/
-/* InstanceReaderImpl */
-/************************************************************************/
-bool InstanceReaderImpl::InitConfig(const AnyMap& config) {
-  if (!PreInitConfig()) {
-    return false;
-  }
+namespace {
 
-  for (const auto& entry : config) {
-    const std::string& k = entry.first;
-    const auto& v = entry.second.to_ref<std::string>();
-    if (!InitConfigKV(k, v)) {
+#if OS_POSIX == 1
+bool PRead(int fd, size_t offset, char* buf, size_t size) {
+  while (size > 0) {
+    ssize_t n = pread(fd, buf, size, (off_t)offset);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      DXERROR("Failed to pread, errno=%d(%s).", errno, strerror(errno));
       return false;
     }
+    if (n == 0) {
+      DXERROR("Unexpected end of file.");
+      return false;
+    }
+    offset += (size_t)n;
+    buf += n;
+    size -= (size_t)n;
+  }
+  return true;
+}
+#endif
+
+template <typename T>
+void AppendTensorRows(const Tensor<T>& from, int begin, int end,
+                      Tensor<T>* to) {
+  int row = to->rank() == 0 ? 0 : to->dim(0);
+  int col = from.total_dim() / from.dim(0);
+  switch (from.rank()) {
+    case 1:
+      to->resize(row + end - begin);
+      break;
+    case 2:
+      to->resize(row + end - begin, from.dim(1));
+      break;
+    default:
+      DXTHROW_INVALID_ARGUMENT("Invalid rank: %d.", from.rank());
   }
+  std::copy(from.data() + begin * col, from.data() + end * col,
+            to->data() + row * col);
+}
 
-  if (!PostInitConfig()) {
-    return false;
+}  // namespace
+
+/************************************************************************/
+/* InstanceReaderImpl */
+/************************************************************************/
+InstanceReaderImpl::~InstanceReaderImpl() { Close(); }
+
+bool InstanceReaderImpl::InitConfig(const AnyMap& config) {
+  StringMap _config;
+  for (const auto& entry : config) {
+    _config.emplace(entry.first, entry.second.to_ref<std::string>());
   }
-  return true;
+  return InitConfig(_config);
 }
 
 bool InstanceReaderImpl::InitConfig(const StringMap& config) {
+  config_ = config;
+  parsers_.clear();
+  thread_pool_.reset();
+  ranges_.clear();
+
   if (!PreInitConfig()) {
     return false;
   }
@@ -48,6 +99,11 @@ bool InstanceReaderImpl::InitConfig(const StringMap& config) {
 }
 
 bool InstanceReaderImpl::Open(const std::string& file) {
+  if (parse_thread_ > 1 && OpenParallel(file)) {
+    return true;
+  }
+
+  is_.set_read_ahead(true);
   if (!is_.Open(file)) {
     return false;
   }
@@ -55,6 +111,16 @@ bool InstanceReaderImpl::Open(const std::string& file) {
   return is_.IsOpen();
 }
 
+void InstanceReaderImpl::Close() noexcept {
+  is_.Close();
+#if OS_POSIX == 1
+  if (fd_ != -1) {
+    close(fd_);
+    fd_ = -1;
+  }
+#endif
+}
+
 bool InstanceReaderImpl::GetBatch(Instance* inst) {
   InitX(inst);
   Y_ = &inst->get_or_insert<tsr_t>(Y_NAME);
@@ -76,6 +142,10 @@ bool InstanceReaderImpl::GetBatch(Instance* inst) {
     inst->clear_batch();
   }
 
+  if (fd_ != -1) {
+    return GetBatchParallel(inst);
+  }
+
   for (;;) {
     if (!GetLine(is_, line_)) {
       is_.Close();
@@ -109,12 +179,245 @@ bool InstanceReaderImpl::InitConfigKV(const std::string& k,
     has_w_ = std::stoi(v);
   } else if (k == "uuid" || k == "has_uuid") {
     has_uuid_ = std::stoi(v);
+  } else if (k == "parse_thread") {
+    parse_thread_ = std::stoi(v);
+    if (parse_thread_ <= 0) {
+      DXERROR("Invalid %s: %s.", k.c_str(), v.c_str());
+      return false;
+    }
+  } else if (k == "parse_chunk_size") {
+    int parse_chunk_size = std::stoi(v);
+    if (parse_chunk_size <= 0) {
+      DXERROR("Invalid %s: %s.", k.c_str(), v.c_str());
+      return false;
+    }
+    parse_chunk_size_ = (size_t)parse_chunk_size;
   } else {
     return false;
   }
   return true;
 }
 
+bool InstanceReaderImpl::InitParsers() {
+  if (!parsers_.empty()) {
+    return true;
+  }
+
+  // Clone current reader by its class name.
+  for (int i = 0; i < parse_thread_; ++i) {
+    std::unique_ptr<InstanceReader> reader(INSTANCE_READER_NEW(class_name()));
+    auto* parser = dynamic_cast<InstanceReaderImpl*>(reader.get());
+    if (parser == nullptr || !parser->InitConfig(config_)) {
+      DXINFO("Failed to clone %s, parse files sequentially.", class_name());
+      parsers_.clear();
+      return false;
+    }
+    reader.release();
+    parsers_.emplace_back(parser);
+  }
+
+  ranges_.resize(parse_thread_);
+  thread_pool_.reset(new ThreadPool);
+  // The calling thread also parses.
+  thread_pool_->start(parse_thread_ - 1);
+  return true;
+}
+
+bool InstanceReaderImpl::OpenParallel(const std::string& file) {
+#if OS_POSIX == 1
+  if (IsStdinStdoutPath(file) || IsHDFSPath(file) || IsGzipFile(file)) {
+    return false;
+  }
+
+  int fd = open(file.c_str(), O_RDONLY);
+  if (fd == -1) {
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || !InitParsers()) {
+    close(fd);
+    return false;
+  }
+
+  Close();
+  fd_ = fd;
+  file_size_ = (size_t)st.st_size;
+  offset_ = 0;
+  range_size_ = 0;
+  cur_range_ = 0;
+  cur_row_ = 0;
+  return true;
+#else
+  (void)file;
+  return false;
+#endif
+}
+
+bool InstanceReaderImpl::GetBatchParallel(Instance* inst) {
+  for (;;) {
+    while (cur_range_ < range_size_) {
+      const Instance& from = ranges_[cur_range_].inst;
+      int rows = from.batch() - cur_row_;
+      if (rows == 0) {
+        ++cur_range_;
+        cur_row_ = 0;
+        continue;
+      }
+
+      rows = std::min(rows, batch_ - Y_->dim(0));
+      AppendRows(from, cur_row_, cur_row_ + rows, inst);
+      cur_row_ += rows;
+      inst->set_batch(Y_->dim(0));
+      if (Y_->dim(0) == batch_) {
+        return true;
+      }
+    }
+
+    if (!ParseRanges()) {
+      Close();
+      return false;
+    }
+  }
+}
+
+bool InstanceReaderImpl::ReadRange(Range* range) const {
+#if OS_POSIX == 1
+  const size_t extend_size = 64 * 1024;  // magic number
+  std::string& buf = range->buf;
+  // The line containing byte 'begin - 1' belongs to the previous range.
+  size_t first = range->begin == 0 ? 0 : range->begin - 1;
+  buf.resize(range->end - first);
+  if (!PRead(fd_, first, &buf[0], buf.size())) {
+    return false;
+  }
+
+  range->line_begin = 0;
+  if (range->begin > 0) {
+    const char* p = (const char*)memchr(buf.data(), '\n', buf.size());
+    range->line_begin = p ? (size_t)(p - buf.data()) + 1 : buf.size();
+  }
+  if (range->line_begin == buf.size()) {
+    return true;
+  }
+
+  // Complete the last line.
+  while (buf.back() != '\n') {
+    size_t size = buf.size();
+    size_t offset = first + size;
+    if (offset == file_size_) {
+      // Drop the unterminated last line, as 'GetLine' does.
+      size_t pos = buf.rfind('\n');
+      if (pos == std::string::npos || pos < range->line_begin) {
+        buf.resize(range->line_begin);
+      } else {
+        buf.resize(pos + 1);
+      }
+      break;
+    }
+
+    size_t extend = std::min(extend_size, file_size_ - offset);
+    buf.resize(size + extend);
+    if (!PRead(fd_, offset, &buf[size], extend)) {
+      return false;
+    }
+    const char* p = (const char*)memchr(&buf[size], '\n', extend);
+    if (p) {
+      buf.resize((size_t)(p - buf.data()) + 1);
+    }
+  }
+  return true;
+#else
+  (void)range;
+  return false;
+#endif
+}
+
+bool InstanceReaderImpl::ParseRanges() {
+  range_size_ = 0;
+  cur_range_ = 0;
+  cur_row_ = 0;
+  while (range_size_ < ranges_.size() && offset_ < file_size_) {
+    Range& range = ranges_[range_size_++];
+    range.begin = offset_;
+    if (file_size_ - offset_ > parse_chunk_size_) {
+      range.end = offset_ + parse_chunk_size_;
+    } else {
+      range.end = file_size_;
+    }
+    offset_ = range.end;
+  }
+
+  if (range_size_ == 0) {
+    return false;
+  }
+
+  thread_pool_->parallel_for(0, range_size_, 1, [this](size_t i) {
+    Range& range = ranges_[i];
+    range.ok = ReadRange(&range) ? 1 : 0;
+    if (range.ok) {
+      parsers_[i]->ParseRange(&range);
+    }
+  });
+
+  for (size_t i = 0; i < range_size_; ++i) {
+    if (!ranges_[i].ok) {
+      DXERROR("Failed to read range [%zu, %zu).", ranges_[i].begin,
+              ranges_[i].end);
+      // Stop after the ranges before it.
+      range_size_ = i;
+      offset_ = file_size_;
+      break;
+    }
+  }
+  return true;
+}
+
+void InstanceReaderImpl::ParseRange(Range* range) {
+  Instance* inst = &range->inst;
+  InitX(inst);
+  Y_ = &inst->get_or_insert<tsr_t>(Y_NAME);
+  W_ = has_w_ ? &inst->get_or_insert<tsr_t>(W_NAME) : nullptr;
+  uuid_ = has_uuid_ ? &inst->get_or_insert<tsrs_t>(UUID_NAME) : nullptr;
+  InitXBatch(inst);
+  Y_->resize(0, label_size_);
+  if (W_) {
+    W_->resize(0, label_size_);
+  }
+  if (uuid_) {
+    uuid_->clear();
+  }
+
+  // Every line ends with '\n'.
+  const char* begin = range->buf.data() + range->line_begin;
+  const char* end = range->buf.data() + range->buf.size();
+  while (begin < end) {
+    const char* p = (const char*)memchr(begin, '\n', end - begin);
+    line_.assign(begin, p);
+    ParseLine();
+    begin = p + 1;
+  }
+  inst->set_batch(Y_->dim(0));
+}
+
+void InstanceReaderImpl::AppendRows(const Instance& from, int begin, int end,
+                                    Instance* to) {
+  for (const auto& entry : from) {
+    const std::string& name = entry.first;
+    const Any& Xany = entry.second;
+    if (Xany.is<csr_t>()) {
+      to->get_or_insert<csr_t>(name).append(Xany.unsafe_to_ref<csr_t>(), begin,
+                                            end);
+    } else if (Xany.is<tsr_t>()) {
+      AppendTensorRows(Xany.unsafe_to_ref<tsr_t>(), begin, end,
+                       &to->get_or_insert<tsr_t>(name));
+    } else if (Xany.is<tsrs_t>()) {
+      AppendTensorRows(Xany.unsafe_to_ref<tsrs_t>(), begin, end,
+                       &to->get_or_insert<tsrs_t>(name));
+    }
+  }
+}
+
 /************************************************************************/
 /* InstanceReader functions */
 /************************************************************************/
@@ -0,0 +1,109 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/common/any_map.h>
+#include <deepx_core/common/stream.h>
+#include <deepx_core/graph/instance_reader.h>
+#include <gtest/gtest.h>
+#include <cstdio>  // remove
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace deepx_core {
+
+class InstanceReaderImplTest : public testing::Test, public DataType {
+ protected:
+  static void GetBatches(const std::string& name, const StringMap& config,
+                         const std::string& file,
+                         std::vector<Instance>* insts) {
+    std::unique_ptr<InstanceReader> reader(NewInstanceReader(name));
+    ASSERT_TRUE(reader->InitConfig(config));
+    ASSERT_TRUE(reader->Open(file));
+    Instance inst;
+    insts->clear();
+    while (reader->GetBatch(&inst)) {
+      insts->emplace_back(inst);
+    }
+    // the last partial batch
+    insts->emplace_back(inst);
+  }
+
+  static void ExpectEqual(const Instance& left, const Instance& right) {
+    EXPECT_EQ(left.batch(), right.batch());
+    EXPECT_EQ(left.size(), right.size());
+    for (const auto& entry : left) {
+      const Any& Xany = entry.second;
+      ASSERT_GT(right.count(entry.first), 0u);
+      const Any& Yany = right.at(entry.first);
+      if (Xany.is<csr_t>()) {
+        EXPECT_EQ(Xany.unsafe_to_ref<csr_t>(), Yany.to_ref<csr_t>());
+      } else if (Xany.is<tsr_t>()) {
+        EXPECT_EQ(Xany.unsafe_to_ref<tsr_t>(), Yany.to_ref<tsr_t>());
+      } else if (Xany.is<tsrs_t>()) {
+        EXPECT_EQ(Xany.unsafe_to_ref<tsrs_t>(), Yany.to_ref<tsrs_t>());
+      }
+    }
+  }
+
+  static void TestParseThread(const std::string& name, StringMap config,
+                              const std::string& file) {
+    for (int batch : {1, 7, 32}) {
+      config["batch"] = std::to_string(batch);
+      std::vector<Instance> expected_insts;
+      GetBatches(name, config, file, &expected_insts);
+      for (int parse_thread : {2, 3}) {
+        for (int parse_chunk_size : {1, 7, 100, 1000, 1 << 20}) {
+          config["parse_thread"] = std::to_string(parse_thread);
+          config["parse_chunk_size"] = std::to_string(parse_chunk_size);
+          std::vector<Instance> insts;
+          GetBatches(name, config, file, &insts);
+          ASSERT_EQ(insts.size(), expected_insts.size());
+          for (size_t i = 0; i < insts.size(); ++i) {
+            ExpectEqual(insts[i], expected_insts[i]);
+          }
+        }
+      }
+      config.erase("parse_thread");
+      config.erase("parse_chunk_size");
+    }
+  }
+};
+
+TEST_F(InstanceReaderImplTest, ParseThread_libsvm) {
+  StringMap config;
+  config["w"] = "1";
+  config["uuid"] = "1";
+  TestParseThread("libsvm", config,
+                  "testdata/graph/instance_reader/libsvm.txt");
+}
+
+TEST_F(InstanceReaderImplTest, ParseThread_libsvm_ex) {
+  StringMap config;
+  config["x_size"] = "2";
+  TestParseThread("libsvm_ex", config,
+                  "testdata/graph/instance_reader/libsvm_ex.txt");
+}
+
+TEST_F(InstanceReaderImplTest, ParseThread_uch) {
+  StringMap config;
+  config["w"] = "1";
+  config["x_hist_item_size"] = "3";
+  TestParseThread("uch", config, "testdata/graph/instance_reader/uch.txt");
+}
+
+TEST_F(InstanceReaderImplTest, ParseThread_unterminated_line) {
+  const std::string file = "instance_reader_impl_test.txt";
+  {
+    AutoOutputFileStream os;
+    ASSERT_TRUE(os.Open(file));
+    const std::string content = "1 1:1 2:2\n\n0 3:3\n1 4:4";
+    ASSERT_EQ(os.Write(content.data(), content.size()), content.size());
+  }
+  StringMap config;
+  TestParseThread("libsvm", config, file);
+  std::remove(file.c_str());
+}
+
+}  // namespace deepx_core
@@ -3,14 +3,70 @@
 // Author: Shuting Guo (tinkleguo@tencent.com)
 //
 
+#include <deepx_core/common/chunked_stream.h>
+#include <deepx_core/common/hash.h>
 #include <deepx_core/common/read_write_lock.h>
 #include <deepx_core/dx_log.h>
 #include <deepx_core/graph/feature_kv_util.h>
 #include <deepx_core/graph/model.h>
+#include <atomic>
 #include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <utility>
 
 namespace deepx_core {
+namespace {
+
+using float_t = DataType::float_t;
+using int_t = DataType::int_t;
+using srm_t = DataType::srm_t;
+
+// version 0: 'param_'
+// version 1: 'param_' with rows of 'srm_t' split into row ranges
+constexpr int MODEL_VERSION = 1;
+
+// Copy everything of 'W' to 'range' except rows.
+void InitRange(const srm_t& W, srm_t* range) {
+  range->clear();
+  range->set_col(W.col());
+  range->set_initializer(W.initializer_type(), W.initializer_param1(),
+                         W.initializer_param2());
+  range->set_storage_dtype(W.storage_dtype());
+}
+
+// Return the number of rows of a row range of about 'chunk_size' bytes.
+size_t GetRangeRows(const srm_t& W, size_t chunk_size) noexcept {
+  size_t value_bytes =
+      IsHalfDtype(W.storage_dtype()) ? sizeof(uint16_t) : sizeof(float_t);
+  size_t row_bytes = sizeof(int_t) + value_bytes * W.col();
+  size_t rows = chunk_size / row_bytes;
+  return rows > 0 ? rows : 1;
+}
+
+bool WriteRange(ChunkedOutputFileStream& os, const std::string& name,
+                const srm_t& range) {
+  std::string buf;
+  OutputStringStream range_os;
+  range_os.SetView(&buf);
+  range_os << name << range;
+  return range_os && os.WriteChunk(&buf);
+}
+
+// Write 'range' if it is full, or if 'flush' is true and it is not empty.
+bool WriteFullRange(ChunkedOutputFileStream& os, const std::string& name,
+                    size_t rows, bool flush, srm_t* range) {
+  if (range->size() == rows || (flush && range->size() > 0)) {
+    if (!WriteRange(os, name, *range)) {
+      return false;
+    }
+    range->zeros();
+  }
+  return true;
+}
+
+}  // namespace
 
 void Model::Init(const Graph* graph) noexcept { graph_ = graph; }
 
@@ -38,10 +94,11 @@ bool Model::InitParamPlaceholder() {
       } break;
     }
   }
+  InitSRMSalt();
   return true;
 }
 
-bool Model::InitParam(std::default_random_engine& engine, const Shard* shard,
+bool Model::InitParam(PhiloxEngine& engine, const Shard* shard,
                       int shard_id) {
   DXINFO("Initializing model...");
   for (const auto& entry : graph_->name_2_node()) {
@@ -75,10 +132,17 @@ bool Model::InitParam(std::default_random_engine& engine, const Shard* shard,
       } break;
     }
   }
+  InitSRMSalt();
   DXINFO("Done.");
   return true;
 }
 
+void Model::InitSRMSalt() {
+  ForEachSRM([](const std::string& name, srm_t* W) {
+    W->set_initializer_salt(MurmurHash2(name));
+  });
+}
+
 void Model::InitLock() {
   use_lock_ = 1;
   param_lock_.clear();
@@ -115,6 +179,76 @@ bool Model::Write(OutputStream& os) const {
   return true;
 }
 
+bool Model::WriteChunked(ChunkedOutputFileStream& os,
+                         size_t chunk_size) const {
+  // The header holds everything except rows of 'srm_t',
+  // and it is followed by row ranges.
+  TensorMap header;
+  int range_size = 0;
+  for (const auto& entry : param_) {
+    const std::string& name = entry.first;
+    const Any& Wany = entry.second;
+    if (Wany.is<srm_t>()) {
+      const auto& W = Wany.unsafe_to_ref<srm_t>();
+      InitRange(W, &header.insert<srm_t>(name));
+      size_t rows = GetRangeRows(W, chunk_size);
+      range_size += (int)((W.size() + rows - 1) / rows);
+    } else if (Wany.is<tsr_t>()) {
+      // view, zero-copy
+      header.insert<tsr_t>(name) = Wany.unsafe_to_ref<tsr_t>().get_view();
+    } else {
+      header[name] = Wany;
+    }
+  }
+
+  int version = MODEL_VERSION;
+  os << version;
+  os << header << range_size;
+  if (!os) {
+    DXERROR("Failed to write model.");
+    return false;
+  }
+
+  for (const auto& entry : param_) {
+    const std::string& name = entry.first;
+    const Any& Wany = entry.second;
+    if (!Wany.is<srm_t>()) {
+      continue;
+    }
+
+    const auto& W = Wany.unsafe_to_ref<srm_t>();
+    size_t rows = GetRangeRows(W, chunk_size);
+    srm_t range;
+    InitRange(W, &range);
+    range.reserve(rows < W.size() ? rows : W.size());
+    bool ok = true;
+    if (IsHalfDtype(W.storage_dtype())) {
+      for (const auto& row_entry : W.half_rows()) {
+        // view, zero-copy
+        range.assign_half_view(row_entry.first, row_entry.second.data());
+        if (!WriteFullRange(os, name, rows, false, &range)) {
+          ok = false;
+          break;
+        }
+      }
+    } else {
+      for (const auto& row_entry : W) {
+        // view, zero-copy
+        range.assign_view(row_entry.first, row_entry.second);
+        if (!WriteFullRange(os, name, rows, false, &range)) {
+          ok = false;
+          break;
+        }
+      }
+    }
+    if (!ok || !WriteFullRange(os, name, rows, true, &range)) {
+      DXERROR("Failed to write model.");
+      return false;
+    }
+  }
+  return true;
+}
+
 bool Model::ReadLegacy(InputStream& is) {
   int version;
   is >> version;
@@ -147,10 +281,75 @@ bool Model::ReadLegacy(InputStream& is) {
     DXERROR("Failed to read model.");
     return false;
   }
+  InitSRMSalt();
+  if (!keep_srm_storage_dtype_) {
+    SetSRMStorageDtype(TENSOR_DTYPE_NONE);
+  }
   return true;
 }
 
 bool Model::Read(InputStream& is) {
+  int range_size;
+  if (!ReadHeader(is, &range_size)) {
+    return false;
+  }
+
+  for (int i = 0; i < range_size; ++i) {
+    std::string name;
+    srm_t range;
+    is >> name >> range;
+    if (!is) {
+      DXERROR("Failed to read model.");
+      return false;
+    }
+    if (!MergeRange(name, &range)) {
+      return false;
+    }
+  }
+  InitSRMSalt();
+  if (!keep_srm_storage_dtype_) {
+    SetSRMStorageDtype(TENSOR_DTYPE_NONE);
+  }
+  return true;
+}
+
+bool Model::ReadChunked(ChunkedInputFileStream& is, const Shard* shard,
+                        int shard_id) {
+  int range_size;
+  if (!ReadHeader(is, &range_size, shard, shard_id)) {
+    return false;
+  }
+
+  if (range_size > 0) {
+    // Every remaining chunk is a row range.
+    std::mutex mutex;
+    std::atomic<int> ranges(0);
+    auto func = [this, shard, shard_id, &mutex, &ranges](
+                    int /*chunk_id*/, InputStringStream& range_is) {
+      std::string name;
+      srm_t range;
+      range_is >> name >> range;
+      if (!range_is) {
+        return false;
+      }
+      ++ranges;
+      std::lock_guard<std::mutex> guard(mutex);
+      return MergeRange(name, &range, shard, shard_id);
+    };
+    if (!is.ForEachChunk(func) || ranges != range_size) {
+      DXERROR("Failed to read model.");
+      return false;
+    }
+  }
+  InitSRMSalt();
+  if (!keep_srm_storage_dtype_) {
+    SetSRMStorageDtype(TENSOR_DTYPE_NONE);
+  }
+  return true;
+}
+
+bool Model::ReadHeader(InputStream& is, int* range_size, const Shard* shard,
+                       int shard_id) {
   int version;
   is >> version;
   if (!is) {
@@ -158,17 +357,54 @@ bool Model::Read(InputStream& is) {
     return false;
   }
 
-  if (version > 0) {
+  if (version > MODEL_VERSION) {
     DXERROR("Couldn't handle a higher version: %d.", version);
     is.set_bad();
     return false;
   }
 
   is >> param_;
-  if (!is) {
+  *range_size = 0;
+  if (version == 1) {
+    is >> *range_size;
+  }
+  if (!is || *range_size < 0) {
     DXERROR("Failed to read model.");
     return false;
   }
+
+  if (shard) {
+    // Rows of version 0 are in the header.
+    ForEachSRM([shard, shard_id](const std::string& /*name*/, srm_t* W) {
+      W->remove_if([shard, shard_id](int_t id) {
+        return !shard->HasSRM(shard_id, id);
+      });
+    });
+  }
+  return true;
+}
+
+bool Model::MergeRange(const std::string& name, srm_t* range,
+                       const Shard* shard, int shard_id) {
+  auto it = param_.find(name);
+  if (it == param_.end() || !it->second.is<srm_t>()) {
+    DXERROR("Invalid row range of SRM %s.", name.c_str());
+    return false;
+  }
+
+  auto& W = it->second.unsafe_to_ref<srm_t>();
+  if (W.col() != range->col()) {
+    DXERROR("Inconsistent col of SRM %s: %d vs %d.", name.c_str(), W.col(),
+            range->col());
+    return false;
+  }
+  if (shard) {
+    W.merge_if(std::move(*range), [shard, shard_id](int_t id) {
+      return shard->HasSRM(shard_id, id);
+    });
+  } else {
+    W.merge(std::move(*range));
+  }
   return true;
 }
 
@@ -186,15 +422,25 @@ bool Model::SaveLegacy(const std::string& file) const {
   return true;
 }
 
-bool Model::Save(const std::string& file) const {
-  AutoOutputFileStream os;
-  if (!os.Open(file)) {
-    DXERROR("Failed to open: %s.", file.c_str());
-    return false;
-  }
+bool Model::Save(const std::string& file, size_t chunk_size,
+                 bool compress) const {
   DXINFO("Saving model to %s...", file.c_str());
-  if (!Write(os)) {
-    return false;
+  if (chunk_size > 0) {
+    ChunkedOutputFileStream os(chunk_size);
+    os.set_compress(compress);
+    if (!os.Open(file)) {
+      DXERROR("Failed to open: %s.", file.c_str());
+      return false;
+    }
+    bool ok = WriteChunked(os, chunk_size);
+    if (!os.Close() || !ok) {
+      return false;
+    }
+  } else {
+    auto write = [this](OutputStream& os) { return Write(os); };
+    if (!SaveFile(file, chunk_size, write, compress)) {
+      return false;
+    }
   }
   DXINFO("Done.");
   return true;
@@ -214,14 +460,14 @@ bool Model::LoadLegacy(const std::string& file) {
   return true;
 }
 
-bool Model::Load(const std::string& file) {
-  AutoInputFileStream is;
+bool Model::Load(const std::string& file, const Shard* shard, int shard_id) {
+  ChunkedInputFileStream is;
   if (!is.Open(file)) {
     DXERROR("Failed to open: %s.", file.c_str());
     return false;
   }
   DXINFO("Loading model from %s...", file.c_str());
-  if (!Read(is)) {
+  if (!ReadChunked(is, shard, shard_id)) {
     return false;
   }
   DXINFO("Done.");
@@ -262,10 +508,12 @@ void Model::Merge(Model* other, const Shard* shard, int shard_id) {
   auto srm_reduce_func = [shard, shard_id](const std::string& name,
                                            srm_t& local_W, srm_t& remote_W) {
     DXINFO("Merging SRM %s...", name.c_str());
-    local_W.merge_if(
-        std::move(remote_W), [shard, shard_id](const srm_t::value_type& entry) {
-          return shard == nullptr || shard->HasSRM(shard_id, entry.first);
-        });
+    if (local_W.empty()) {
+      local_W.set_storage_dtype(remote_W.storage_dtype());
+    }
+    local_W.merge_if(std::move(remote_W), [shard, shard_id](int_t id) {
+      return shard == nullptr || shard->HasSRM(shard_id, id);
+    });
   };
   Reduce(other, tsr_reduce_func, srm_reduce_func, shard, shard_id);
   DXINFO("Done.");
@@ -297,6 +545,80 @@ void Model::RemoveZerosSRM() {
   DXINFO("Done.");
 }
 
+void Model::SetSRMStorageDtype(int storage_dtype) {
+  for (auto& entry : param_) {
+    Any& Wany = entry.second;
+    if (Wany.is<srm_t>()) {
+      auto& W = Wany.unsafe_to_ref<srm_t>();
+      W.set_storage_dtype(storage_dtype);
+    }
+  }
+}
+
+constexpr int Model::QUANTIZE_MIN_COL;
+
+int Model::Quantize() {
+  DXINFO("Quantizing model...");
+  // Quantizable params are used only by ops which have int8 predict paths.
+  std::unordered_map<std::string, int> quantizable;
+  for (const auto& entry : graph_->name_2_node()) {
+    const GraphNode* node = entry.second;
+    std::string class_name = node->class_name();
+    for (int i = 0; i < node->input_size(); ++i) {
+      const GraphNode* Wnode = node->input(i);
+      if (Wnode->node_type() != GRAPH_NODE_TYPE_PARAM) {
+        continue;
+      }
+
+      int flag = 0;
+      switch (Wnode->tensor_type()) {
+        case TENSOR_TYPE_TSR:
+          flag = class_name == "FullyConnectNode" && i == 1;
+          break;
+        case TENSOR_TYPE_SRM:
+          flag = (class_name == "EmbeddingLookupNode" ||
+                  class_name == "GroupEmbeddingLookupNode" ||
+                  class_name == "GroupEmbeddingLookup2Node") &&
+                 i >= 1;
+          break;
+      }
+      quantizable.emplace(Wnode->name(), 1).first->second &= flag;
+    }
+  }
+
+  int quantized = 0;
+  for (auto& entry : param_) {
+    const std::string& name = entry.first;
+    Any& Wany = entry.second;
+    auto it = quantizable.find(name);
+    if (it == quantizable.end() || !it->second) {
+      continue;
+    }
+
+    if (Wany.is<tsr_t>()) {
+      const auto& W = Wany.unsafe_to_ref<tsr_t>();
+      qtsr_t qW;
+      qW.quantize(W);
+      DXINFO("Quantized TSR %s.", name.c_str());
+      Wany = std::move(qW);
+      ++quantized;
+    } else if (Wany.is<srm_t>()) {
+      auto& W = Wany.unsafe_to_ref<srm_t>();
+      if (W.col() < QUANTIZE_MIN_COL) {
+        continue;
+      }
+      W.set_storage_dtype(TENSOR_DTYPE_NONE);
+      qsrm_t qW;
+      qW.quantize(W);
+      DXINFO("Quantized SRM %s with %zu rows.", name.c_str(), qW.size());
+      Wany = std::move(qW);
+      ++quantized;
+    }
+  }
+  DXINFO("Done.");
+  return quantized;
+}
+
 void Model::ForEachSRM(
     const std::function<void(const std::string&, srm_t*)>& func) {
   for (auto& entry : param_) {
@@ -309,8 +631,8 @@ void Model::ForEachSRM(
   }
 }
 
-void Model::Pull(std::default_random_engine& engine,
-                 const PullRequest& pull_request, TensorMap* remote_param) {
+void Model::Pull(PhiloxEngine& engine, const PullRequest& pull_request,
+                 TensorMap* remote_param) {
   remote_param->ClearValue();
 
   for (const std::string& name : pull_request.tsr_set) {
@@ -326,8 +648,13 @@ void Model::Pull(std::default_random_engine& engine,
     auto& local_W = param_.get<srm_t>(name);
     auto& remote_W = remote_param->get_or_insert<srm_t>(name);
     remote_W.set_col(local_W.col());
+    // ship rows in the storage dtype of 'local_W'
+    remote_W.set_storage_dtype(local_W.storage_dtype());
     remote_W.reserve(id_set.size());
-    if (pull_request.is_train) {
+    if (IsHalfDtype(local_W.storage_dtype())) {
+      PullHalf(engine, name, pull_request.is_train, id_set, &local_W,
+               &remote_W);
+    } else if (pull_request.is_train) {
       // get random values for missing keys
       if (use_lock_) {
         auto& lock =
@@ -359,6 +686,38 @@ void Model::Pull(std::default_random_engine& engine,
   remote_param->RemoveEmptyValue();
 }
 
+void Model::PullHalf(PhiloxEngine& engine, const std::string& name,
+                     bool is_train, const id_set_t& id_set, srm_t* local_W,
+                     srm_t* remote_W) {
+  if (is_train) {
+    // get random values for missing keys
+    if (use_lock_) {
+      auto& lock = param_lock_.unsafe_get<std::shared_ptr<ReadWriteLock>>(name);
+      for (int_t id : id_set) {
+        const uint16_t* embedding =
+            local_W->get_half_row(engine, id, lock.get());
+        // view, zero-copy
+        remote_W->assign_half_view(id, embedding);
+      }
+    } else {
+      for (int_t id : id_set) {
+        const uint16_t* embedding = local_W->get_half_row(engine, id);
+        // view, zero-copy
+        remote_W->assign_half_view(id, embedding);
+      }
+    }
+  } else {
+    // get nothing for missing keys
+    for (int_t id : id_set) {
+      const uint16_t* embedding = local_W->get_half_row_no_init(id);
+      if (embedding) {
+        // view, zero-copy
+        remote_W->assign_half_view(id, embedding);
+      }
+    }
+  }
+}
+
 void Model::SetParam(std::vector<std::unique_ptr<TensorMap>>* remote_params) {
   param_.ClearSRMValue();
 
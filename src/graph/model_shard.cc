@@ -6,6 +6,9 @@
 #include <deepx_core/common/stream.h>
 #include <deepx_core/dx_log.h>
 #include <deepx_core/graph/model_shard.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
 #include <utility>
 
 namespace deepx_core {
@@ -140,12 +143,14 @@ void ModelShard::InitGraph(const Graph* graph) noexcept { graph_ = graph; }
 bool ModelShard::InitModelPlaceholder() {
   model_.reset(new Model);
   model_->Init(graph_);
+  model_->set_keep_srm_storage_dtype(keep_srm_storage_dtype());
   return model_->InitParamPlaceholder();
 }
 
 bool ModelShard::InitModel() {
   model_.reset(new Model);
   model_->Init(graph_);
+  model_->set_keep_srm_storage_dtype(keep_srm_storage_dtype());
   return model_->InitParam(engine_, shard_, shard_id_);
 }
 
@@ -219,7 +224,7 @@ bool ModelShard::SaveModelLegacy(const std::string& dir) const {
 }
 
 bool ModelShard::SaveModel(const std::string& dir) const {
-  return model_->Save(GetModelFile(dir));
+  return model_->Save(GetModelFile(dir), chunk_size_, compress_ != 0);
 }
 
 bool ModelShard::SaveTextModel(const std::string& dir) const {
@@ -256,7 +261,8 @@ bool ModelShard::SaveOptimizerLegacy(const std::string& dir) const {
 }
 
 bool ModelShard::SaveOptimizer(const std::string& dir) const {
-  return deepx_core::SaveOptimizer(GetOptimizerFile(dir), *optimizer_);
+  return deepx_core::SaveOptimizer(GetOptimizerFile(dir), *optimizer_,
+                                   chunk_size_, compress_ != 0);
 }
 
 bool ModelShard::SaveTSStoreLegacy(const std::string& dir) const {
@@ -264,7 +270,7 @@ bool ModelShard::SaveTSStoreLegacy(const std::string& dir) const {
 }
 
 bool ModelShard::SaveTSStore(const std::string& dir) const {
-  return ts_store_->Save(GetTSStoreFile(dir));
+  return ts_store_->Save(GetTSStoreFile(dir), chunk_size_, compress_ != 0);
 }
 
 bool ModelShard::SaveFreqStoreLegacy(const std::string& dir) const {
@@ -272,7 +278,7 @@ bool ModelShard::SaveFreqStoreLegacy(const std::string& dir) const {
 }
 
 bool ModelShard::SaveFreqStore(const std::string& dir) const {
-  return freq_store_->Save(GetFreqStoreFile(dir));
+  return freq_store_->Save(GetFreqStoreFile(dir), chunk_size_, compress_ != 0);
 }
 
 bool ModelShard::SaveSuccessLegacy(const std::string& dir) const {
@@ -337,6 +343,68 @@ int ModelShard::GetShardStatus(const std::string& dir,
   return 1;
 }
 
+constexpr int ModelShard::MAX_LOAD_THREAD;
+
+std::vector<int> ModelShard::GetRemoteShardIds(
+    const Shard& remote_shard) const {
+  std::vector<int> remote_shard_ids;
+  for (int i = 0; i < remote_shard.shard_size(); ++i) {
+    if (shard_->Overlap(shard_id_, remote_shard, i)) {
+      remote_shard_ids.emplace_back(i);
+    }
+  }
+  DXINFO("Shard %d needs %zu of %d remote shards.", shard_id_,
+         remote_shard_ids.size(), remote_shard.shard_size());
+  return remote_shard_ids;
+}
+
+template <class T, class LoadFunc, class MergeFunc>
+bool ModelShard::LoadRemoteShards(const std::vector<int>& remote_shard_ids,
+                                  LoadFunc&& load_func,
+                                  MergeFunc&& merge_func) {
+  int thread_size = (int)std::thread::hardware_concurrency();
+  if (thread_size > MAX_LOAD_THREAD) {
+    thread_size = MAX_LOAD_THREAD;
+  }
+  if (thread_size > (int)remote_shard_ids.size()) {
+    thread_size = (int)remote_shard_ids.size();
+  }
+  if (thread_size <= 1) {
+    for (int remote_shard_id : remote_shard_ids) {
+      std::unique_ptr<T> remote(new T);
+      if (!load_func(remote_shard_id, remote.get()) ||
+          !merge_func(remote.get())) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::mutex merge_mutex;
+  std::atomic<bool> ok(true);
+  ThreadPool thread_pool;
+  thread_pool.start(thread_size - 1);
+  thread_pool.parallel_for(
+      0, remote_shard_ids.size(), 1,
+      [&remote_shard_ids, &load_func, &merge_func, &merge_mutex,
+       &ok](size_t i) {
+        if (!ok) {
+          return;
+        }
+        std::unique_ptr<T> remote(new T);
+        if (!load_func(remote_shard_ids[i], remote.get())) {
+          ok = false;
+          return;
+        }
+        std::lock_guard<std::mutex> guard(merge_mutex);
+        if (ok && !merge_func(remote.get())) {
+          ok = false;
+        }
+      });
+  thread_pool.stop();
+  return ok;
+}
+
 bool ModelShard::LoadModelLegacy(const std::string& dir) {
   Shard remote_shard;
   int status = GetShardStatusLegacy(dir, &remote_shard);
@@ -346,6 +414,7 @@ bool ModelShard::LoadModelLegacy(const std::string& dir) {
 
   model_.reset(new Model);
   model_->Init(graph_);
+  model_->set_keep_srm_storage_dtype(keep_srm_storage_dtype());
 
   if (status == 0) {
     if (!model_->InitParam(engine_, shard_, shard_id_)) {
@@ -355,6 +424,7 @@ bool ModelShard::LoadModelLegacy(const std::string& dir) {
     for (int i = 0; i < remote_shard.shard_size(); ++i) {
       Model remote_model;
       remote_model.Init(graph_);
+      remote_model.set_keep_srm_storage_dtype(keep_srm_storage_dtype());
       if (!remote_model.LoadLegacy(GetModelFileLegacy(dir, &remote_shard, i))) {
         return false;
       }
@@ -375,21 +445,26 @@ bool ModelShard::LoadModel(const std::string& dir) {
 
   model_.reset(new Model);
   model_->Init(graph_);
+  model_->set_keep_srm_storage_dtype(keep_srm_storage_dtype());
 
   if (status == 0) {
     if (!model_->InitParam(engine_, shard_, shard_id_)) {
       return false;
     }
 
-    for (int i = 0; i < remote_shard.shard_size(); ++i) {
-      Model remote_model;
-      remote_model.Init(graph_);
-      if (!remote_model.Load(GetModelFile(dir, &remote_shard, i))) {
-        return false;
-      }
-      model_->Merge(&remote_model, shard_, shard_id_);
-    }
-    return true;
+    return LoadRemoteShards<Model>(
+        GetRemoteShardIds(remote_shard),
+        [this, &dir, &remote_shard](int i, Model* remote_model) {
+          remote_model->Init(graph_);
+          remote_model->set_keep_srm_storage_dtype(
+              keep_srm_storage_dtype());
+          return remote_model->Load(GetModelFile(dir, &remote_shard, i),
+                                    shard_, shard_id_);
+        },
+        [this](Model* remote_model) {
+          model_->Merge(remote_model, shard_, shard_id_);
+          return true;
+        });
   } else {
     return model_->Load(GetModelFile(dir));
   }
@@ -466,16 +541,23 @@ bool ModelShard::LoadOptimizer(const std::string& dir,
       return false;
     }
 
-    for (int i = 0; i < remote_shard.shard_size(); ++i) {
-      std::unique_ptr<Optimizer> remote_optimizer(
-          deepx_core::LoadOptimizer(GetOptimizerFile(dir, &remote_shard, i)));
-      if (!remote_optimizer) {
-        return false;
-      }
-      remote_optimizer->Init(graph_, model_->mutable_param());
-      if (!optimizer_->Merge(remote_optimizer.get(), shard_, shard_id_)) {
-        return false;
-      }
+    if (!LoadRemoteShards<std::unique_ptr<Optimizer>>(
+            GetRemoteShardIds(remote_shard),
+            [this, &dir, &remote_shard](
+                int i, std::unique_ptr<Optimizer>* remote_optimizer) {
+              *remote_optimizer = deepx_core::LoadOptimizer(
+                  GetOptimizerFile(dir, &remote_shard, i));
+              if (!*remote_optimizer) {
+                return false;
+              }
+              (*remote_optimizer)->Init(graph_, model_->mutable_param());
+              return true;
+            },
+            [this](std::unique_ptr<Optimizer>* remote_optimizer) {
+              return optimizer_->Merge(remote_optimizer->get(), shard_,
+                                       shard_id_);
+            })) {
+      return false;
     }
   } else {
     optimizer_ = deepx_core::LoadOptimizer(GetOptimizerFile(dir));
@@ -536,17 +618,19 @@ bool ModelShard::LoadTSStore(const std::string& dir, ts_t now,
   ts_store_->Init(model_->mutable_param());
 
   if (status == 0) {
-    for (int i = 0; i < remote_shard.shard_size(); ++i) {
-      TSStore remote_ts_store;
-      remote_ts_store.set_now(now);
-      remote_ts_store.set_expire_threshold(expire_threshold);
-      remote_ts_store.Init(model_->mutable_param());
-      if (!remote_ts_store.Load(GetTSStoreFile(dir, &remote_shard, i))) {
-        return false;
-      }
-      ts_store_->Merge(&remote_ts_store, shard_, shard_id_);
-    }
-    return true;
+    return LoadRemoteShards<TSStore>(
+        GetRemoteShardIds(remote_shard),
+        [this, &dir, &remote_shard, now, expire_threshold](
+            int i, TSStore* remote_ts_store) {
+          remote_ts_store->set_now(now);
+          remote_ts_store->set_expire_threshold(expire_threshold);
+          remote_ts_store->Init(model_->mutable_param());
+          return remote_ts_store->Load(GetTSStoreFile(dir, &remote_shard, i));
+        },
+        [this](TSStore* remote_ts_store) {
+          ts_store_->Merge(remote_ts_store, shard_, shard_id_);
+          return true;
+        });
   } else {
     return ts_store_->Load(GetTSStoreFile(dir));
   }
@@ -594,16 +678,19 @@ bool ModelShard::LoadFreqStore(const std::string& dir,
   freq_store_->Init(model_->mutable_param());
 
   if (status == 0) {
-    for (int i = 0; i < remote_shard.shard_size(); ++i) {
-      FreqStore remote_freq_store;
-      remote_freq_store.set_freq_filter_threshold(freq_filter_threshold);
-      remote_freq_store.Init(model_->mutable_param());
-      if (!remote_freq_store.Load(GetFreqStoreFile(dir, &remote_shard, i))) {
-        return false;
-      }
-      freq_store_->Merge(&remote_freq_store, shard_, shard_id_);
-    }
-    return true;
+    return LoadRemoteShards<FreqStore>(
+        GetRemoteShardIds(remote_shard),
+        [this, &dir, &remote_shard, freq_filter_threshold](
+            int i, FreqStore* remote_freq_store) {
+          remote_freq_store->set_freq_filter_threshold(freq_filter_threshold);
+          remote_freq_store->Init(model_->mutable_param());
+          return remote_freq_store->Load(
+              GetFreqStoreFile(dir, &remote_shard, i));
+        },
+        [this](FreqStore* remote_freq_store) {
+          freq_store_->Merge(remote_freq_store, shard_, shard_id_);
+          return true;
+        });
   } else {
     return freq_store_->Load(GetFreqStoreFile(dir));
   }
@@ -620,6 +707,7 @@ bool ModelShard::WarmupModelLegacy(const std::string& dir) {
     for (int i = 0; i < remote_shard.shard_size(); ++i) {
       Model remote_model;
       remote_model.Init(graph_);
+      remote_model.set_keep_srm_storage_dtype(keep_srm_storage_dtype());
       if (!remote_model.LoadLegacy(GetModelFileLegacy(dir, &remote_shard, i))) {
         return false;
       }
@@ -628,6 +716,7 @@ bool ModelShard::WarmupModelLegacy(const std::string& dir) {
   } else {
     Model remote_model;
     remote_model.Init(graph_);
+    remote_model.set_keep_srm_storage_dtype(keep_srm_storage_dtype());
     if (!remote_model.LoadLegacy(GetModelFileLegacy(dir))) {
       return false;
     }
@@ -644,17 +733,25 @@ bool ModelShard::WarmupModel(const std::string& dir) {
   }
 
   if (status == 0) {
-    for (int i = 0; i < remote_shard.shard_size(); ++i) {
-      Model remote_model;
-      remote_model.Init(graph_);
-      if (!remote_model.Load(GetModelFile(dir, &remote_shard, i))) {
-        return false;
-      }
-      model_->Merge(&remote_model, shard_, shard_id_);
+    if (!LoadRemoteShards<Model>(
+            GetRemoteShardIds(remote_shard),
+            [this, &dir, &remote_shard](int i, Model* remote_model) {
+              remote_model->Init(graph_);
+              remote_model->set_keep_srm_storage_dtype(
+                  keep_srm_storage_dtype());
+              return remote_model->Load(GetModelFile(dir, &remote_shard, i),
+                                        shard_, shard_id_);
+            },
+            [this](Model* remote_model) {
+              model_->Merge(remote_model, shard_, shard_id_);
+              return true;
+            })) {
+      return false;
     }
   } else {
     Model remote_model;
     remote_model.Init(graph_);
+    remote_model.set_keep_srm_storage_dtype(keep_srm_storage_dtype());
     if (!remote_model.Load(GetModelFile(dir))) {
       return false;
     }
@@ -705,16 +802,23 @@ bool ModelShard::WarmupOptimizer(const std::string& dir) {
   }
 
   if (status == 0) {
-    for (int i = 0; i < remote_shard.shard_size(); ++i) {
-      std::unique_ptr<Optimizer> remote_optimizer(
-          deepx_core::LoadOptimizer(GetOptimizerFile(dir, &remote_shard, i)));
-      if (!remote_optimizer) {
-        return false;
-      }
-      remote_optimizer->Init(graph_, model_->mutable_param());
-      if (!optimizer_->Merge(remote_optimizer.get(), shard_, shard_id_)) {
-        return false;
-      }
+    if (!LoadRemoteShards<std::unique_ptr<Optimizer>>(
+            GetRemoteShardIds(remote_shard),
+            [this, &dir, &remote_shard](
+                int i, std::unique_ptr<Optimizer>* remote_optimizer) {
+              *remote_optimizer = deepx_core::LoadOptimizer(
+                  GetOptimizerFile(dir, &remote_shard, i));
+              if (!*remote_optimizer) {
+                return false;
+              }
+              (*remote_optimizer)->Init(graph_, model_->mutable_param());
+              return true;
+            },
+            [this](std::unique_ptr<Optimizer>* remote_optimizer) {
+              return optimizer_->Merge(remote_optimizer->get(), shard_,
+                                       shard_id_);
+            })) {
+      return false;
     }
   } else {
     std::unique_ptr<Optimizer> remote_optimizer(
@@ -770,15 +874,21 @@ bool ModelShard::WarmupTSStore(const std::string& dir) {
   }
 
   if (status == 0) {
-    for (int i = 0; i < remote_shard.shard_size(); ++i) {
-      TSStore remote_ts_store;
-      remote_ts_store.set_now(ts_store_->now());
-      remote_ts_store.set_expire_threshold(ts_store_->expire_threshold());
-      remote_ts_store.Init(model_->mutable_param());
-      if (!remote_ts_store.Load(GetTSStoreFile(dir, &remote_shard, i))) {
-        return false;
-      }
-      ts_store_->Merge(&remote_ts_store, shard_, shard_id_);
+    if (!LoadRemoteShards<TSStore>(
+            GetRemoteShardIds(remote_shard),
+            [this, &dir, &remote_shard](int i, TSStore* remote_ts_store) {
+              remote_ts_store->set_now(ts_store_->now());
+              remote_ts_store->set_expire_threshold(
+                  ts_store_->expire_threshold());
+              remote_ts_store->Init(model_->mutable_param());
+              return remote_ts_store->Load(
+                  GetTSStoreFile(dir, &remote_shard, i));
+            },
+            [this](TSStore* remote_ts_store) {
+              ts_store_->Merge(remote_ts_store, shard_, shard_id_);
+              return true;
+            })) {
+      return false;
     }
   } else {
     TSStore remote_ts_store;
@@ -833,15 +943,20 @@ bool ModelShard::WarmupFreqStore(const std::string& dir) {
   }
 
   if (status == 0) {
-    for (int i = 0; i < remote_shard.shard_size(); ++i) {
-      FreqStore remote_freq_store;
-      remote_freq_store.set_freq_filter_threshold(
-          freq_store_->freq_filter_threshold());
-      remote_freq_store.Init(model_->mutable_param());
-      if (!remote_freq_store.Load(GetFreqStoreFile(dir, &remote_shard, i))) {
-        return false;
-      }
-      freq_store_->Merge(&remote_freq_store, shard_, shard_id_);
+    if (!LoadRemoteShards<FreqStore>(
+            GetRemoteShardIds(remote_shard),
+            [this, &dir, &remote_shard](int i, FreqStore* remote_freq_store) {
+              remote_freq_store->set_freq_filter_threshold(
+                  freq_store_->freq_filter_threshold());
+              remote_freq_store->Init(model_->mutable_param());
+              return remote_freq_store->Load(
+                  GetFreqStoreFile(dir, &remote_shard, i));
+            },
+            [this](FreqStore* remote_freq_store) {
+              freq_store_->Merge(remote_freq_store, shard_, shard_id_);
+              return true;
+            })) {
+      return false;
     }
   } else {
     FreqStore remote_freq_store;
@@ -889,9 +1004,7 @@ void ModelShard::ExpireTSStore() {
   auto expired = ts_store_->Expire();
   auto filter = [&expired](const std::string& name, srm_t* W) {
     size_t prev_size = W->size();
-    W->remove_if([&expired](const srm_t::value_type& entry) {
-      return expired.count(entry.first) > 0;
-    });
+    W->remove_if([&expired](int_t id) { return expired.count(id) > 0; });
     DXINFO("SRM %s has %zu entries expired, %zu entries remained.",
            name.c_str(), prev_size - W->size(), W->size());
   };
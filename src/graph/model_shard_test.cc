@@ -0,0 +1,179 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/common/chunked_stream.h>
+#include <deepx_core/graph/graph.h>
+#include <deepx_core/graph/graph_node.h>
+#include <deepx_core/graph/model_shard.h>
+#include <deepx_core/graph/shard.h>
+#include <deepx_core/tensor/data_type.h>
+#include <gtest/gtest.h>
+#include <cstdio>  // std::remove
+#include <string>
+#include <vector>
+
+namespace deepx_core {
+
+class ModelShardTest : public testing::Test, public DataType {
+ protected:
+  const std::string dir = ".";
+  static constexpr int_t ID_SIZE = 1000;
+  Graph graph;
+  int max_shard_size = 0;
+
+ protected:
+  void SetUp() override {
+    auto* b = new VariableNode("b", Shape(2, 3), TENSOR_TYPE_TSR,
+                               TENSOR_INITIALIZER_TYPE_RANDN, 0, 1);
+    auto* W = new VariableNode("W", Shape(0, 4), TENSOR_TYPE_SRM,
+                               TENSOR_INITIALIZER_TYPE_RANDN, 0, 1);
+    ASSERT_TRUE(graph.Compile({b, W}, 1));
+  }
+
+  void TearDown() override { Remove(); }
+
+  void Remove() {
+    for (int i = 0; i < max_shard_size; ++i) {
+      std::string file = dir + "/model.bin." + std::to_string(i);
+      std::remove(file.c_str());
+      for (int j = 0; j < 1024; ++j) {
+        std::remove(GetChunkFile(file, j).c_str());
+      }
+    }
+    std::remove((dir + "/shard.bin").c_str());
+  }
+
+  void Save(const Shard& shard) {
+    if (max_shard_size < shard.shard_size()) {
+      max_shard_size = shard.shard_size();
+    }
+    for (int i = 0; i < shard.shard_size(); ++i) {
+      ModelShard model_shard;
+      model_shard.seed(1);
+      model_shard.InitShard(&shard, i);
+      model_shard.InitGraph(&graph);
+      ASSERT_TRUE(model_shard.InitModel());
+      TensorMap* param = model_shard.mutable_model()->mutable_param();
+      if (shard.HasTSR(i, "b")) {
+        param->get<tsr_t>("b").arange();
+      }
+      auto& W = param->get<srm_t>("W");
+      for (int_t id = 0; id < ID_SIZE; ++id) {
+        if (shard.HasSRM(i, id)) {
+          float_t* row = W.get_row_no_init(id);
+          for (int j = 0; j < W.col(); ++j) {
+            row[j] = (float_t)(id + j);
+          }
+        }
+      }
+      // Several row ranges per file.
+      model_shard.set_chunk_size(256);
+      ASSERT_TRUE(model_shard.SaveModel(dir));
+    }
+    ASSERT_TRUE(SaveShard(dir, shard));
+  }
+
+  void LoadAndCheck(const Shard& shard) {
+    tsr_t expected_b;
+    expected_b.resize(2, 3);
+    expected_b.arange();
+    for (int i = 0; i < shard.shard_size(); ++i) {
+      ModelShard model_shard;
+      model_shard.seed(1);
+      model_shard.InitShard(&shard, i);
+      model_shard.InitGraph(&graph);
+      ASSERT_TRUE(model_shard.LoadModel(dir));
+      const TensorMap& param = model_shard.model().param();
+      if (shard.HasTSR(i, "b")) {
+        EXPECT_EQ(param.get<tsr_t>("b"), expected_b);
+      } else {
+        EXPECT_EQ(param.find("b"), param.end());
+      }
+      const auto& W = param.get<srm_t>("W");
+      size_t rows = 0;
+      for (int_t id = 0; id < ID_SIZE; ++id) {
+        if (shard.HasSRM(i, id)) {
+          const float_t* row = W.get_row_no_init(id);
+          ASSERT_TRUE(row != nullptr);
+          for (int j = 0; j < W.col(); ++j) {
+            EXPECT_EQ(row[j], (float_t)(id + j));
+          }
+          ++rows;
+        }
+      }
+      // Rows of other shards are dropped.
+      EXPECT_EQ(W.size(), rows);
+    }
+  }
+
+  void TestReshard(const std::string& shard_func_name, int shard_size,
+                   int new_shard_size) {
+    Shard shard, new_shard;
+    shard.InitShard(shard_size, shard_func_name);
+    new_shard.InitShard(new_shard_size, shard_func_name);
+    Remove();
+    Save(shard);
+    LoadAndCheck(new_shard);
+  }
+};
+
+constexpr DataType::int_t ModelShardTest::ID_SIZE;
+
+TEST_F(ModelShardTest, LoadModel_same_shard_size) {
+  TestReshard("default", 3, 3);
+}
+
+TEST_F(ModelShardTest, LoadModel_more_shards) {
+  TestReshard("default", 3, 5);
+  TestReshard("bucket", 3, 5);
+}
+
+TEST_F(ModelShardTest, LoadModel_less_shards) {
+  TestReshard("default", 4, 2);
+  TestReshard("bucket", 4, 2);
+}
+
+TEST_F(ModelShardTest, PullPush_storage_dtype) {
+  Shard shard;
+  shard.InitNonShard();
+  ModelShard model_shard;
+  model_shard.seed(1);
+  model_shard.InitShard(&shard, 0);
+  model_shard.InitGraph(&graph);
+  ASSERT_TRUE(model_shard.InitModel());
+  ASSERT_TRUE(model_shard.InitOptimizer("sgd", "alpha=0.5"));
+  model_shard.mutable_model()->SetSRMStorageDtype(TENSOR_DTYPE_BFLOAT16);
+  auto& W = model_shard.mutable_param()->get<srm_t>("W");
+  std::vector<float_t> row_value = {1, 2, 3, 4};
+  W.assign(1, row_value.data());
+
+  PullRequest pull_request;
+  pull_request.is_train = 1;
+  pull_request.srm_map["W"] = {1, 9};
+  TensorMap remote_param;
+  model_shard.Pull(&pull_request, &remote_param);
+  const auto& remote_W = remote_param.get<srm_t>("W");
+  EXPECT_EQ(remote_W.storage_dtype(), TENSOR_DTYPE_BFLOAT16);
+  EXPECT_EQ(remote_W.size(), 2u);
+  // view, zero-copy
+  EXPECT_EQ(remote_W.get_half_row_no_init(1), W.get_half_row_no_init(1));
+  EXPECT_EQ(remote_W.get_half_row_no_init(9), W.get_half_row_no_init(9));
+
+  TensorMap grad;
+  auto& G = grad.insert<srm_t>("W");
+  G.set_col(4);
+  row_value = {1, 1, 1, 1};
+  G.assign(1, row_value.data());
+  G.assign(7, row_value.data());
+  model_shard.Push(&grad, nullptr);
+
+  // Rows are updated in 'float_t', but stay in 16 bits.
+  EXPECT_EQ(W.half_rows().size(), 3u);
+  EXPECT_TRUE(W.begin() == W.end());
+  ASSERT_TRUE(W.decode_row(1, row_value.data()));
+  EXPECT_EQ(row_value, std::vector<float_t>({0.5, 1.5, 2.5, 3.5}));
+  EXPECT_TRUE(W.get_half_row_no_init(7) != nullptr);
+}
+
+}  // namespace deepx_core
@@ -0,0 +1,106 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/common/chunked_stream.h>
+#include <deepx_core/graph/model.h>
+#include <deepx_core/tensor/data_type.h>
+#include <gtest/gtest.h>
+#include <cstdio>  // std::remove
+#include <string>
+
+namespace deepx_core {
+
+class ModelTest : public testing::Test, public DataType {
+ protected:
+  const std::string file = "model_test.bin";
+  Model model;
+
+ protected:
+  void SetUp() override {
+    TensorMap& param = *model.mutable_param();
+    param.insert<tsr_t>("b").resize(10).arange();
+
+    auto& W = param.insert<srm_t>("W");
+    W.set_col(4);
+    W.set_initializer(TENSOR_INITIALIZER_TYPE_RANDN, 0, 1);
+    for (int_t i = 0; i < 1000; ++i) {
+      float_t* row = W.get_row_no_init(i * 7);
+      for (int j = 0; j < W.col(); ++j) {
+        row[j] = (float_t)(i + j);
+      }
+    }
+
+    auto& E = param.insert<srm_t>("E");
+    E.set_col(2);
+
+    auto& H = param.insert<srm_t>("H");
+    H.set_col(3);
+    for (int_t i = 0; i < 100; ++i) {
+      float_t* row = H.get_row_no_init(i);
+      for (int j = 0; j < H.col(); ++j) {
+        row[j] = (float_t)(i - j);
+      }
+    }
+    H.set_storage_dtype(TENSOR_DTYPE_BFLOAT16);
+  }
+
+  void TearDown() override {
+    std::remove(file.c_str());
+    for (int i = 0; i < 1024; ++i) {
+      std::remove(GetChunkFile(file, i).c_str());
+    }
+  }
+
+  void Check(const Model& read_model) const {
+    const TensorMap& param = model.param();
+    const TensorMap& read_param = read_model.param();
+    EXPECT_EQ(read_param.size(), param.size());
+    EXPECT_EQ(read_param.get<tsr_t>("b"), param.get<tsr_t>("b"));
+    EXPECT_EQ(read_param.get<srm_t>("W"), param.get<srm_t>("W"));
+    EXPECT_EQ(read_param.get<srm_t>("E"), param.get<srm_t>("E"));
+    srm_t H = param.get<srm_t>("H");
+    if (!read_model.keep_srm_storage_dtype()) {
+      // Rows in 16 bits are decoded.
+      H.set_storage_dtype(TENSOR_DTYPE_NONE);
+    }
+    EXPECT_EQ(read_param.get<srm_t>("H"), H);
+  }
+};
+
+TEST_F(ModelTest, SaveLoad) {
+  for (bool compress : {false, true}) {
+    ASSERT_TRUE(model.Save(file, 0, compress));
+    EXPECT_FALSE(IsChunkedFile(file));
+    Model read_model;
+    read_model.set_keep_srm_storage_dtype(true);
+    ASSERT_TRUE(read_model.Load(file));
+    Check(read_model);
+  }
+}
+
+TEST_F(ModelTest, SaveLoad_Chunked) {
+  for (bool compress : {false, true}) {
+    // 10 rows of 'W' per row range.
+    ASSERT_TRUE(model.Save(file, 256, compress));
+    EXPECT_TRUE(IsChunkedFile(file));
+    for (bool keep_srm_storage_dtype : {false, true}) {
+      Model read_model;
+      read_model.set_keep_srm_storage_dtype(keep_srm_storage_dtype);
+      ASSERT_TRUE(read_model.Load(file));
+      Check(read_model);
+    }
+  }
+}
+
+TEST_F(ModelTest, Read_Chunked) {
+  // Row ranges can be read serially too.
+  ASSERT_TRUE(model.Save(file, 256));
+  ChunkedInputFileStream is;
+  ASSERT_TRUE(is.Open(file));
+  Model read_model;
+  ASSERT_TRUE(read_model.Read(is));
+  Check(read_model);
+}
+
+}  // namespace deepx_core
@@ -7,6 +7,7 @@
 #include <deepx_core/dx_log.h>
 #include <deepx_core/graph/feature_kv_util.h>
 #include <deepx_core/graph/ol_store.h>
+#include <vector>
 
 namespace deepx_core {
 
@@ -58,14 +59,22 @@ auto OLStore::Collect() -> id_set_t {
     if (Wany.is<srm_t>() && prev_Wany.is<srm_t>()) {
       const auto& W = Wany.unsafe_to_ref<srm_t>();
       auto& prev_W = prev_Wany.unsafe_to_ref<srm_t>();
+      // Rows may be stored in 16 bits, decode them.
+      std::vector<float_t> embedding_buf(W.col());
+      std::vector<float_t> prev_embedding_buf(W.col());
       auto first = srm_state.begin();
       auto last = srm_state.end();
       for (; first != last;) {
         int_t id = first->first;
         const State& state = first->second;
-        const float_t* embedding = W.get_row_no_init(id);
-        const float_t* prev_embedding =
-            ((const srm_t&)prev_W).get_row_no_init(id);
+        const float_t* embedding = nullptr;
+        const float_t* prev_embedding = nullptr;
+        if (W.decode_row(id, embedding_buf.data())) {
+          embedding = embedding_buf.data();
+        }
+        if (prev_W.decode_row(id, prev_embedding_buf.data())) {
+          prev_embedding = prev_embedding_buf.data();
+        }
         ++updated;
         if (Collect(state, W.col(), embedding, prev_embedding)) {
           ++collected;
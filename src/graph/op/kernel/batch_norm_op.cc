@@ -4,6 +4,7 @@
 //
 
 #include <deepx_core/graph/op_impl.h>
+#include "norm.h"
 
 namespace deepx_core {
 namespace {
@@ -57,15 +58,9 @@ struct BatchNormMutableAux {
   Tensor<T> mean;     // mean(X, axis=0)
   Tensor<T> var;      // var(X, axis=0)
   Tensor<T> inv_std;  // 1 / sqrt(var + eps)
-  Tensor<T> Z1;       // X - mean
-  Tensor<T> Z2;       // (X - mean) * (X - mean)
-  Tensor<T> Z3;       // (X - mean) / sqrt(var + eps)
-
-  Tensor<T> gvar;
-  Tensor<T> gZ3;
-  Tensor<T> I;
-  Tensor<T> buf1;
-  Tensor<T> buf2;
+  Tensor<T> scale;    // gamma * inv_std
+  Tensor<T> shift;    // beta - mean * scale
+  Tensor<T> buf;      // 2 * m
 };
 
 template <typename T>
@@ -73,48 +68,39 @@ void BatchNormPrepare(const BatchNormAux& aux, BatchNormMutableAux<T>* maux) {
   maux->mean.resize(aux.m);
   maux->var.resize(aux.m);
   maux->inv_std.resize(aux.m);
-  maux->Z1.resize(aux.Z);
-  maux->Z2.resize(aux.Z);
-  maux->Z3.resize(aux.Z);
+  maux->scale.resize(aux.m);
+  maux->shift.resize(aux.m);
+  maux->buf.resize(2 * aux.m);
 }
 
+// Compute Z = X * scale + shift, normalization and the affine transform are
+// fused in one sweep.
 template <typename T>
-void BatchNormPrepareBackward(const BatchNormAux& aux,
-                              BatchNormMutableAux<T>* maux) {
-  maux->gvar.resize(aux.m);
-  maux->gZ3.resize(aux.Z);
-  maux->I.resize(aux.Z);
-  maux->buf1.resize(aux.Z);
-  maux->buf2.resize(aux.m);
-}
-
-template <typename T>
-void BatchNorm(const Tensor<T>& X, const Tensor<T>& gamma,
-               const Tensor<T>& beta, Tensor<T>* Z, const BatchNormAux& aux,
-               BatchNormMutableAux<T>* maux) {
+void BatchNormApply(const Tensor<T>& X, const T* mean, const T* var,
+                    const Tensor<T>& gamma, const Tensor<T>& beta, Tensor<T>* Z,
+                    const BatchNormAux& aux,
+                    BatchNormMutableAux<T>* maux) noexcept {
   int batch = aux.batch;
   int m = aux.m;
-  int total_dim = batch * m;
-  const auto* _X = X.data();
-  const auto* _gamma = gamma.data();
-  const auto* _beta = beta.data();
-  auto* _Z = Z->data();
-  auto* _mean = maux->mean.data();
-  auto* _var = maux->var.data();
-  auto* _inv_std = maux->inv_std.data();
-  auto* _Z1 = maux->Z1.data();
-  auto* _Z2 = maux->Z2.data();
-  auto* _Z3 = maux->Z3.data();
-  LLMath<T>::sum_row(batch, m, (T)1 / batch, _X, 0, _mean);
-  LLMath<T>::sub_row(batch, m, 1, _X, 1, _mean, _Z1);
-  LLMath<T>::square(total_dim, _Z1, _Z2);
-  LLMath<T>::sum_row(batch, m, (T)1 / batch, _Z2, 0, _var);
-  LLMath<T>::add_scalar(m, _var, (T)1e-6, _inv_std);
-  LLMath<T>::sqrt(m, _inv_std, _inv_std);
-  LLMath<T>::inv(m, _inv_std, _inv_std);
-  LLMath<T>::mul_row(batch, m, _Z1, _inv_std, _Z3);
-  LLMath<T>::mul_row(batch, m, _Z3, _gamma, _Z);
-  LLMath<T>::add_row(batch, m, 1, _Z, 1, _beta, _Z);
+  const T* _X = X.data();
+  const T* _gamma = gamma.data();
+  const T* _beta = beta.data();
+  T* _Z = Z->data();
+  T* _inv_std = maux->inv_std.data();
+  T* _scale = maux->scale.data();
+  T* _shift = maux->shift.data();
+  for (int j = 0; j < m; ++j) {
+    _inv_std[j] = NormInvStd(var[j]);
+    _scale[j] = _gamma[j] * _inv_std[j];
+    _shift[j] = _beta[j] - mean[j] * _scale[j];
+  }
+  for (int i = 0; i < batch; ++i) {
+    for (int j = 0; j < m; ++j) {
+      _Z[j] = _X[j] * _scale[j] + _shift[j];
+    }
+    _X += m;
+    _Z += m;
+  }
 }
 
 // for forward
@@ -122,11 +108,13 @@ template <typename T>
 void BatchNorm(const Tensor<T>& X, const Tensor<T>& gamma,
                const Tensor<T>& beta, Tensor<T>* Z, const BatchNormAux& aux,
                BatchNormMutableAux<T>* maux, T moving_decay,
-               Tensor<T>* moving_mean, Tensor<T>* moving_var) {
-  BatchNorm(X, gamma, beta, Z, aux, maux);
+               Tensor<T>* moving_mean, Tensor<T>* moving_var) noexcept {
   int m = aux.m;
   auto* _mean = maux->mean.data();
   auto* _var = maux->var.data();
+  NormColMoments(aux.batch, m, X.data(), _mean, _var, maux->buf.data());
+  BatchNormApply(X, _mean, _var, gamma, beta, Z, aux, maux);
+
   auto* _moving_mean = moving_mean->data();
   auto* _moving_var = moving_var->data();
   T a = moving_decay;
@@ -144,76 +132,63 @@ void BatchNorm(const Tensor<T>& X, const Tensor<T>& gamma,
 template <typename T>
 void BatchNorm(const Tensor<T>& X, const Tensor<T>& mean, const Tensor<T>& var,
                const Tensor<T>& gamma, const Tensor<T>& beta, Tensor<T>* Z,
-               const BatchNormAux& aux, BatchNormMutableAux<T>* maux) {
-  int batch = aux.batch;
-  int m = aux.m;
-  const auto* _X = X.data();
-  const auto* _mean = mean.data();
-  const auto* _var = var.data();
-  const auto* _gamma = gamma.data();
-  const auto* _beta = beta.data();
-  auto* _Z = Z->data();
-  auto* _inv_std = maux->inv_std.data();
-  auto* _Z1 = maux->Z1.data();
-  auto* _Z3 = maux->Z3.data();
-  LLMath<T>::sub_row(batch, m, 1, _X, 1, _mean, _Z1);
-  LLMath<T>::add_scalar(m, _var, (T)1e-6, _inv_std);
-  LLMath<T>::sqrt(m, _inv_std, _inv_std);
-  LLMath<T>::inv(m, _inv_std, _inv_std);
-  LLMath<T>::mul_row(batch, m, _Z1, _inv_std, _Z3);
-  LLMath<T>::mul_row(batch, m, _Z3, _gamma, _Z);
-  LLMath<T>::add_row(batch, m, 1, _Z, 1, _beta, _Z);
+               const BatchNormAux& aux, BatchNormMutableAux<T>* maux) noexcept {
+  BatchNormApply(X, mean.data(), var.data(), gamma, beta, Z, aux, maux);
 }
 
 template <typename T>
-void BatchNormBackward(const Tensor<T>& /*X*/, const Tensor<T>& gamma,
+void BatchNormBackward(const Tensor<T>& X, const Tensor<T>& gamma,
                        const Tensor<T>& /*beta*/, const Tensor<T>& /*Z*/,
                        const Tensor<T>& gZ, Tensor<T>* gX, Tensor<T>* ggamma,
                        Tensor<T>* gbeta, const BatchNormAux& aux,
-                       BatchNormMutableAux<T>* maux) {
+                       BatchNormMutableAux<T>* maux) noexcept {
   int batch = aux.batch;
   int m = aux.m;
-  int total_dim = batch * m;
+  const auto* _X = X.data();
   const auto* _gamma = gamma.data();
   const auto* _gZ = gZ.data();
-  auto* _inv_std = maux->inv_std.data();
-  auto* _Z1 = maux->Z1.data();
-  auto* _Z3 = maux->Z3.data();
-  auto* _gvar = maux->gvar.data();
-  auto* _gZ3 = maux->gZ3.data();
-  auto* _I = maux->I.data();
-  auto* _buf1 = maux->buf1.data();
-  auto* _buf2 = maux->buf2.data();
+  const auto* _mean = maux->mean.data();
+  const auto* _inv_std = maux->inv_std.data();
+  auto* _sum = maux->buf.data();       // sum(gZ, axis=0)
+  auto* _sum2 = maux->buf.data() + m;  // sum(gZ * Xhat, axis=0)
+
+  // Xhat = (X - mean) * inv_std
+  for (int j = 0; j < m; ++j) {
+    _sum[j] = 0;
+    _sum2[j] = 0;
+  }
+  for (int i = 0; i < batch; ++i) {
+    for (int j = 0; j < m; ++j) {
+      _sum[j] += _gZ[j];
+      _sum2[j] += _gZ[j] * ((_X[j] - _mean[j]) * _inv_std[j]);
+    }
+    _X += m;
+    _gZ += m;
+  }
 
   if (gX) {
+    // gX = gamma * inv_std * (gZ - mean(gZ) - Xhat * mean(gZ * Xhat))
     auto* _gX = gX->data();
-    // gZ3
-    LLMath<T>::mul_row(batch, m, _gZ, _gamma, _gZ3);
-    // gvar
-    LLMath<T>::mul(total_dim, _gZ3, _Z1, _buf1);
-    LLMath<T>::cubic(m, _inv_std, _buf2);
-    LLMath<T>::mul_row(batch, m, _buf1, _buf2, _buf1);
-    LLMath<T>::sum_row(batch, m, (T)-0.5, _buf1, 0, _gvar);
-    // I
-    LLMath<T>::mul_row(batch, m, _gZ3, _inv_std, _I);
-    LLMath<T>::mul_row(batch, m, _Z1, _gvar, _buf1);
-    LLMath<T>::mul_scalar(total_dim, _buf1, (T)2 / batch, _buf1);
-    LLMath<T>::add(total_dim, _I, _buf1, _I);
-    // gX
-    LLMath<T>::sum_row(batch, m, (T)-1 / batch, _I, 0, _buf2);
-    LLMath<T>::add_row(batch, m, 1, _I, 1, _buf2, _buf1);
-    LLMath<T>::add(total_dim, _gX, _buf1, _gX);
+    _X = X.data();
+    _gZ = gZ.data();
+    for (int i = 0; i < batch; ++i) {
+      for (int j = 0; j < m; ++j) {
+        T Xhat = (_X[j] - _mean[j]) * _inv_std[j];
+        _gX[j] += _gamma[j] * _inv_std[j] *
+                  (_gZ[j] - (_sum[j] + Xhat * _sum2[j]) / batch);
+      }
+      _X += m;
+      _gZ += m;
+      _gX += m;
+    }
   }
 
   if (ggamma) {
-    auto* _ggamma = ggamma->data();
-    LLMath<T>::mul(total_dim, _gZ, _Z3, _buf1);
-    LLMath<T>::sum_row(batch, m, 1, _buf1, 1, _ggamma);
+    LLMath<T>::add(m, _sum2, ggamma->data(), ggamma->data());
   }
 
   if (gbeta) {
-    auto* _gbeta = gbeta->data();
-    LLMath<T>::sum_row(batch, m, 1, _gZ, 1, _gbeta);
+    LLMath<T>::add(m, _sum, gbeta->data(), gbeta->data());
   }
 }
 
@@ -307,9 +282,6 @@ class BatchNormOp : public OpImpl {
     gX_ = InitGradTSR(Xnode_, X_->shape());
     ggamma_ = InitGradTSR(gamma_node_, gamma_->shape());
     gbeta_ = InitGradTSR(beta_node_, beta_->shape());
-    if (gX_ || ggamma_ || gbeta_) {
-      BatchNormPrepareBackward(aux_, &maux_);
-    }
   }
 
   void Forward() override {
@@ -6,6 +6,32 @@
 
 namespace deepx_core {
 
+class BatchNormForwardTest : public testing::Test, public DataType {};
+
+TEST_F(BatchNormForwardTest, BatchNorm) {
+  int m = 2;
+  ConstantNode X("X", Shape(10, m), TENSOR_INITIALIZER_TYPE_ARANGE, 0, 0);
+  VariableNode gamma("gamma", Shape(m), TENSOR_INITIALIZER_TYPE_ONES, 0, 0);
+  VariableNode beta("beta", Shape(m), TENSOR_INITIALIZER_TYPE_ZEROS, 0, 0);
+  VariableNode mean("mean", Shape(m), TENSOR_INITIALIZER_TYPE_ZEROS, 0, 0);
+  mean.set_need_grad(0);
+  VariableNode var("var", Shape(m), TENSOR_INITIALIZER_TYPE_ONES, 0, 0);
+  var.set_need_grad(0);
+  BatchNormNode Z("Z", &X, &gamma, &beta, &mean, &var, 0.9);
+  tsr_t expected_Z{-1.5666989, -1.5666989,  //
+                   -1.2185436, -1.2185436,  //
+                   -0.8703883, -0.8703883,  //
+                   -0.5222330, -0.5222330,  //
+                   -0.1740777, -0.1740777,  //
+                   0.1740777,  0.1740777,   //
+                   0.5222330,  0.5222330,   //
+                   0.8703883,  0.8703883,   //
+                   1.2185436,  1.2185436,   //
+                   1.5666989,  1.5666989};
+  expected_Z.reshape(10, m);
+  CheckOpForward(&Z, 0, expected_Z);
+}
+
 class BatchNormBackwardTest : public testing::Test {};
 
 TEST_F(BatchNormBackwardTest, BatchNorm) {
@@ -22,4 +48,17 @@ TEST_F(BatchNormBackwardTest, BatchNorm) {
   CheckOpBackward(&Z, 0);
 }
 
+TEST_F(BatchNormBackwardTest, BatchNorm_rank3) {
+  int batch = 20;
+  VariableNode X("X", Shape(batch, 3, 4), TENSOR_INITIALIZER_TYPE_RANDN, 0, 1);
+  VariableNode gamma("gamma", Shape(12), TENSOR_INITIALIZER_TYPE_RANDN, 0, 1);
+  VariableNode beta("beta", Shape(12), TENSOR_INITIALIZER_TYPE_RANDN, 0, 1);
+  VariableNode mean("mean", Shape(12), TENSOR_INITIALIZER_TYPE_ZEROS, 0, 0);
+  mean.set_need_grad(0);
+  VariableNode var("var", Shape(12), TENSOR_INITIALIZER_TYPE_ONES, 0, 0);
+  var.set_need_grad(0);
+  BatchNormNode Z("Z", &X, &gamma, &beta, &mean, &var, 0.9);
+  CheckOpBackward(&Z, 0);
+}
+
 }  // namespace deepx_core
@@ -4,6 +4,7 @@
 
 #pragma once
 #include <deepx_core/graph/op_impl.h>
+#include <algorithm>
 #include "binary_meta.h"
 
 namespace deepx_core {
@@ -11,6 +12,16 @@ namespace deepx_core {
 // Bidirectional broadcast rule.
 // https://docs.scipy.org/doc/numpy/user/basics.broadcasting.html
 
+// Patterns of the canonical form.
+enum BROADCAST_PATTERN {
+  BROADCAST_PATTERN_SAME = 0,     // X and Y have the same total dim
+  BROADCAST_PATTERN_SCALAR = 1,   // X or Y has only one element
+  BROADCAST_PATTERN_ROW = 2,      // (m, n) and (1, n)
+  BROADCAST_PATTERN_COL = 3,      // (m, n) and (m, 1)
+  BROADCAST_PATTERN_OUTER = 4,    // (m, 1) and (1, n)
+  BROADCAST_PATTERN_GENERAL = 5,  // others
+};
+
 struct BroadcastAux {
   Shape Z;
   Shape Xstrides;
@@ -19,8 +30,71 @@ struct BroadcastAux {
   int Z_total_dim = 0;
   int XY_same_shape = 0;
   int vectorization = 0;  // last axis can be vectorized.
+  // canonical form, axes of dimension 1 in Z are removed and
+  // adjacent axes broadcast in the same way are merged
+  int pattern = BROADCAST_PATTERN_SAME;
+  int crank = 0;
+  int cZ[SHAPE_MAX_RANK];
+  int cXstrides[SHAPE_MAX_RANK];  // 0 means broadcast
+  int cYstrides[SHAPE_MAX_RANK];  // 0 means broadcast
+  int cZstrides[SHAPE_MAX_RANK];
 };
 
+namespace detail {
+
+// Compute the canonical form and pattern from Z, Xstrides and Ystrides.
+inline void BroadcastCanonicalize(BroadcastAux* aux) noexcept {
+  int crank = 0;
+  int Xbroadcast[SHAPE_MAX_RANK] = {0}, Ybroadcast[SHAPE_MAX_RANK] = {0};
+  for (int i = 0; i < aux->Z.rank(); ++i) {
+    if (aux->Z[i] == 1) {
+      continue;
+    }
+    int Xb = aux->Xstrides[i] == 0;
+    int Yb = aux->Ystrides[i] == 0;
+    if (crank > 0 && Xbroadcast[crank - 1] == Xb &&
+        Ybroadcast[crank - 1] == Yb) {
+      aux->cZ[crank - 1] *= aux->Z[i];
+    } else {
+      aux->cZ[crank] = aux->Z[i];
+      Xbroadcast[crank] = Xb;
+      Ybroadcast[crank] = Yb;
+      ++crank;
+    }
+  }
+  aux->crank = crank;
+
+  int Xstride = 1, Ystride = 1, Zstride = 1;
+  for (int i = crank - 1; i >= 0; --i) {
+    aux->cXstrides[i] = Xbroadcast[i] ? 0 : Xstride;
+    aux->cYstrides[i] = Ybroadcast[i] ? 0 : Ystride;
+    aux->cZstrides[i] = Zstride;
+    if (!Xbroadcast[i]) {
+      Xstride *= aux->cZ[i];
+    }
+    if (!Ybroadcast[i]) {
+      Ystride *= aux->cZ[i];
+    }
+    Zstride *= aux->cZ[i];
+  }
+
+  if (crank == 0 || (crank == 1 && !Xbroadcast[0] && !Ybroadcast[0])) {
+    aux->pattern = BROADCAST_PATTERN_SAME;
+  } else if (crank == 1) {
+    aux->pattern = BROADCAST_PATTERN_SCALAR;
+  } else if (crank == 2 && !Xbroadcast[1] && !Ybroadcast[1]) {
+    aux->pattern = BROADCAST_PATTERN_ROW;
+  } else if (crank == 2 && !Xbroadcast[0] && !Ybroadcast[0]) {
+    aux->pattern = BROADCAST_PATTERN_COL;
+  } else if (crank == 2) {
+    aux->pattern = BROADCAST_PATTERN_OUTER;
+  } else {
+    aux->pattern = BROADCAST_PATTERN_GENERAL;
+  }
+}
+
+}  // namespace detail
+
 inline bool BroadcastPrepare(const Shape& X, const Shape& Y,
                              BroadcastAux* aux) noexcept {
   int Xrank = X.rank();
@@ -100,7 +174,162 @@ inline bool BroadcastPrepare(const Shape& X, const Shape& Y,
   aux->vectorization = (X_reverse_strides[0] == 1) &&
                        (Y_reverse_strides[0] == 1) &&
                        (Z_reverse_strides[0] == 1);
+  detail::BroadcastCanonicalize(aux);
   return true;
 }
 
+namespace detail {
+
+constexpr int BROADCAST_BLOCK = 256;  // magic number
+
+// Call 'func(x, y, z)' for all runs along the last canonical axis,
+// 'x', 'y' and 'z' are the offsets of the runs in X, Y and Z.
+template <class Func>
+void BroadcastForEachRun(const BroadcastAux& aux, Func&& func) {
+  switch (aux.pattern) {
+    case BROADCAST_PATTERN_SCALAR:
+      func(0, 0, 0);
+      break;
+    case BROADCAST_PATTERN_ROW:
+    case BROADCAST_PATTERN_COL:
+    case BROADCAST_PATTERN_OUTER:
+      for (int i = 0; i < aux.cZ[0]; ++i) {
+        func(i * aux.cXstrides[0], i * aux.cYstrides[0], i * aux.cZstrides[0]);
+      }
+      break;
+    default: {
+      int rank = aux.crank - 1;
+      int index[SHAPE_MAX_RANK] = {0};
+      int x = 0, y = 0, z = 0;
+      for (;;) {
+        func(x, y, z);
+        int j = rank - 1;
+        for (; j >= 0; --j) {
+          x += aux.cXstrides[j];
+          y += aux.cYstrides[j];
+          z += aux.cZstrides[j];
+          if (++index[j] < aux.cZ[j]) {
+            break;
+          }
+          index[j] = 0;
+          x -= aux.cZ[j] * aux.cXstrides[j];
+          y -= aux.cZ[j] * aux.cYstrides[j];
+          z -= aux.cZ[j] * aux.cZstrides[j];
+        }
+        if (j < 0) {
+          break;
+        }
+      }
+    } break;
+  }
+}
+
+// Compute a run of 'n' elements of Z,
+// X or Y is a scalar repeated 'n' times if its stride is 0.
+//
+// The scalar is expanded to a block, so that 'Meta' is always vectorized.
+template <typename T, class Meta>
+void BroadcastRun(int n, const T* X, int Xstride, const T* Y, int Ystride,
+                  T* Z) noexcept {
+  if (Xstride && Ystride) {
+    Meta::Forward(n, X, Y, Z);
+    return;
+  }
+
+  T Xblock[BROADCAST_BLOCK], Yblock[BROADCAST_BLOCK];
+  int block = (n < BROADCAST_BLOCK) ? n : BROADCAST_BLOCK;
+  if (Xstride == 0) {
+    std::fill(Xblock, Xblock + block, *X);
+  }
+  if (Ystride == 0) {
+    std::fill(Yblock, Yblock + block, *Y);
+  }
+  for (int i = 0; i < n; i += BROADCAST_BLOCK) {
+    int m = (n - i < BROADCAST_BLOCK) ? n - i : BROADCAST_BLOCK;
+    Meta::Forward(m, Xstride ? X + i : Xblock, Ystride ? Y + i : Yblock,
+                  Z + i);
+  }
+}
+
+// The backward of 'BroadcastRun'.
+//
+// Gradients of a scalar are accumulated to a block by 'Meta',
+// and the block is reduced once at the end of the run.
+template <typename T, class Meta>
+void BroadcastBackwardRun(int n, const T* X, int Xstride, const T* Y,
+                          int Ystride, const T* Z, const T* gZ, T* gX,
+                          T* gY) noexcept {
+  if (Xstride && Ystride) {
+    Meta::Backward(n, X, Y, Z, gZ, gX, gY);
+    return;
+  }
+
+  T Xblock[BROADCAST_BLOCK], Yblock[BROADCAST_BLOCK];
+  T gXblock[BROADCAST_BLOCK], gYblock[BROADCAST_BLOCK];
+  int block = (n < BROADCAST_BLOCK) ? n : BROADCAST_BLOCK;
+  if (Xstride == 0) {
+    std::fill(Xblock, Xblock + block, *X);
+    std::fill(gXblock, gXblock + block, (T)0);
+  }
+  if (Ystride == 0) {
+    std::fill(Yblock, Yblock + block, *Y);
+    std::fill(gYblock, gYblock + block, (T)0);
+  }
+  for (int i = 0; i < n; i += BROADCAST_BLOCK) {
+    int m = (n - i < BROADCAST_BLOCK) ? n - i : BROADCAST_BLOCK;
+    T* _gX = nullptr;
+    T* _gY = nullptr;
+    if (gX) {
+      _gX = Xstride ? gX + i : gXblock;
+    }
+    if (gY) {
+      _gY = Ystride ? gY + i : gYblock;
+    }
+    Meta::Backward(m, Xstride ? X + i : Xblock, Ystride ? Y + i : Yblock,
+                   Z + i, gZ + i, _gX, _gY);
+  }
+  if (gX && Xstride == 0) {
+    *gX += LLMath<T>::sum(block, gXblock);
+  }
+  if (gY && Ystride == 0) {
+    *gY += LLMath<T>::sum(block, gYblock);
+  }
+}
+
+// Compute Z = Meta(X, Y) with bidirectional broadcast.
+template <typename T, class Meta>
+void Broadcast(const T* X, const T* Y, T* Z,
+               const BroadcastAux& aux) noexcept {
+  if (aux.pattern == BROADCAST_PATTERN_SAME) {
+    Meta::Forward(aux.Z_total_dim, X, Y, Z);
+    return;
+  }
+
+  int last = aux.crank - 1;
+  BroadcastForEachRun(aux, [&](int x, int y, int z) {
+    BroadcastRun<T, Meta>(aux.cZ[last], X + x, aux.cXstrides[last], Y + y,
+                          aux.cYstrides[last], Z + z);
+  });
+}
+
+// The backward of 'Broadcast', 'gX' or 'gY' may be nullptr.
+template <typename T, class Meta>
+void BroadcastBackward(const T* X, const T* Y, const T* Z, const T* gZ, T* gX,
+                       T* gY, const BroadcastAux& aux) noexcept {
+  if (aux.pattern == BROADCAST_PATTERN_SAME) {
+    Meta::Backward(aux.Z_total_dim, X, Y, Z, gZ, gX, gY);
+    return;
+  }
+
+  int last = aux.crank - 1;
+  BroadcastForEachRun(aux, [&](int x, int y, int z) {
+    BroadcastBackwardRun<T, Meta>(aux.cZ[last], X + x, aux.cXstrides[last],
+                                  Y + y, aux.cYstrides[last], Z + z, gZ + z,
+                                  gX ? gX + x : nullptr,
+                                  gY ? gY + y : nullptr);
+  });
+}
+
+}  // namespace detail
+
 }  // namespace deepx_core
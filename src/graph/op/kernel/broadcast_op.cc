@@ -3,6 +3,7 @@
 //
 
 #include <deepx_core/graph/op_impl.h>
+#include <algorithm>
 #include "broadcast.h"
 
 namespace deepx_core {
@@ -21,322 +22,12 @@ bool BroadcastInferShape(const Shape& X, const Shape& Y, Shape* Z) noexcept {
   return true;
 }
 
-template <typename T, class Meta>
-void _BroadcastRank1(const T* X, const T* Y, T* Z,
-                     const BroadcastAux& aux) noexcept {
-  if (aux.vectorization) {
-    Meta::Forward(aux.Z[0], X, Y, Z);
-  } else {
-    for (int i0 = 0; i0 < aux.Z[0]; ++i0) {
-      Meta::Forward(X, Y, Z);
-      X += aux.Xstrides[0];
-      Y += aux.Ystrides[0];
-      Z += aux.Zstrides[0];
-    }
-  }
-}
-
-template <typename T, class Meta>
-void _BroadcastRank2(const T* X, const T* Y, T* Z,
-                     const BroadcastAux& aux) noexcept {
-  const T* _X;
-  const T* _Y;
-  T* _Z;
-  for (int i0 = 0; i0 < aux.Z[0]; ++i0) {
-    if (aux.vectorization) {
-      Meta::Forward(aux.Z[1], X, Y, Z);
-    } else {
-      _X = X;
-      _Y = Y;
-      _Z = Z;
-      for (int i1 = 0; i1 < aux.Z[1]; ++i1) {
-        Meta::Forward(_X, _Y, _Z);
-        _X += aux.Xstrides[1];
-        _Y += aux.Ystrides[1];
-        _Z += aux.Zstrides[1];
-      }
-    }
-    X += aux.Xstrides[0];
-    Y += aux.Ystrides[0];
-    Z += aux.Zstrides[0];
-  }
-}
-
-template <typename T, class Meta>
-void _BroadcastRank3(const T* X, const T* Y, T* Z,
-                     const BroadcastAux& aux) noexcept {
-  const T* _X;
-  const T* _Y;
-  T* _Z;
-  const T* __X;
-  const T* __Y;
-  T* __Z;
-  for (int i0 = 0; i0 < aux.Z[0]; ++i0) {
-    _X = X;
-    _Y = Y;
-    _Z = Z;
-    for (int i1 = 0; i1 < aux.Z[1]; ++i1) {
-      if (aux.vectorization) {
-        Meta::Forward(aux.Z[2], _X, _Y, _Z);
-      } else {
-        __X = _X;
-        __Y = _Y;
-        __Z = _Z;
-        for (int i2 = 0; i2 < aux.Z[2]; ++i2) {
-          Meta::Forward(__X, __Y, __Z);
-          __X += aux.Xstrides[2];
-          __Y += aux.Ystrides[2];
-          __Z += aux.Zstrides[2];
-        }
-      }
-      _X += aux.Xstrides[1];
-      _Y += aux.Ystrides[1];
-      _Z += aux.Zstrides[1];
-    }
-    X += aux.Xstrides[0];
-    Y += aux.Ystrides[0];
-    Z += aux.Zstrides[0];
-  }
-}
-
-template <typename T, class Meta>
-void _BroadcastFallback(int level, const T* X, const T* Y, T* Z,
-                        const BroadcastAux& aux) noexcept {
-  if (level < aux.Z.rank() - 1) {
-    for (int i = 0; i < aux.Z[level]; ++i) {
-      _BroadcastFallback<T, Meta>(level + 1, X, Y, Z, aux);
-      X += aux.Xstrides[level];
-      Y += aux.Ystrides[level];
-      Z += aux.Zstrides[level];
-    }
-  } else {
-    if (aux.vectorization) {
-      Meta::Forward(aux.Z[level], X, Y, Z);
-    } else {
-      for (int i = 0; i < aux.Z[level]; ++i) {
-        Meta::Forward(X, Y, Z);
-        X += aux.Xstrides[level];
-        Y += aux.Ystrides[level];
-        Z += aux.Zstrides[level];
-      }
-    }
-  }
-}
-
-template <typename T, class Meta>
-void _Broadcast(const T* X, const T* Y, T* Z,
-                const BroadcastAux& aux) noexcept {
-  if (aux.XY_same_shape) {
-    Meta::Forward(aux.Z_total_dim, X, Y, Z);
-  } else if (aux.Z.is_rank(1)) {
-    _BroadcastRank1<T, Meta>(X, Y, Z, aux);
-  } else if (aux.Z.is_rank(2)) {
-    _BroadcastRank2<T, Meta>(X, Y, Z, aux);
-  } else if (aux.Z.is_rank(3)) {
-    _BroadcastRank3<T, Meta>(X, Y, Z, aux);
-  } else {
-    _BroadcastFallback<T, Meta>(0, X, Y, Z, aux);
-  }
-}
-
-template <typename T, class Meta>
-void _BroadcastBackwardRank1(const T* X, const T* Y, const T* Z, const T* gZ,
-                             T* gX, T* gY, const BroadcastAux& aux) noexcept {
-  if (aux.vectorization) {
-    Meta::Backward(aux.Z[0], X, Y, Z, gZ, gX, gY);
-  } else {
-    for (int i0 = 0; i0 < aux.Z[0]; ++i0) {
-      Meta::Backward(X, Y, Z, gZ, gX, gY);
-      X += aux.Xstrides[0];
-      Y += aux.Ystrides[0];
-      Z += aux.Zstrides[0];
-      gZ += aux.Zstrides[0];
-      if (gX) {
-        gX += aux.Xstrides[0];
-      }
-      if (gY) {
-        gY += aux.Ystrides[0];
-      }
-    }
-  }
-}
-
-template <typename T, class Meta>
-void _BroadcastBackwardRank2(const T* X, const T* Y, const T* Z, const T* gZ,
-                             T* gX, T* gY, const BroadcastAux& aux) noexcept {
-  const T* _X;
-  const T* _Y;
-  const T* _Z;
-  const T* _gZ;
-  T* _gX;
-  T* _gY;
-  for (int i0 = 0; i0 < aux.Z[0]; ++i0) {
-    if (aux.vectorization) {
-      Meta::Backward(aux.Z[1], X, Y, Z, gZ, gX, gY);
-    } else {
-      _X = X;
-      _Y = Y;
-      _Z = Z;
-      _gZ = gZ;
-      _gX = gX;
-      _gY = gY;
-      for (int i1 = 0; i1 < aux.Z[1]; ++i1) {
-        Meta::Backward(_X, _Y, _Z, _gZ, _gX, _gY);
-        _X += aux.Xstrides[1];
-        _Y += aux.Ystrides[1];
-        _Z += aux.Zstrides[1];
-        _gZ += aux.Zstrides[1];
-        if (_gX) {
-          _gX += aux.Xstrides[1];
-        }
-        if (_gY) {
-          _gY += aux.Ystrides[1];
-        }
-      }
-    }
-    X += aux.Xstrides[0];
-    Y += aux.Ystrides[0];
-    Z += aux.Zstrides[0];
-    gZ += aux.Zstrides[0];
-    if (gX) {
-      gX += aux.Xstrides[0];
-    }
-    if (gY) {
-      gY += aux.Ystrides[0];
-    }
-  }
-}
-
-template <typename T, class Meta>
-void _BroadcastBackwardRank3(const T* X, const T* Y, const T* Z, const T* gZ,
-                             T* gX, T* gY, const BroadcastAux& aux) noexcept {
-  const T* _X;
-  const T* _Y;
-  const T* _Z;
-  const T* _gZ;
-  T* _gX;
-  T* _gY;
-  const T* __X;
-  const T* __Y;
-  const T* __Z;
-  const T* __gZ;
-  T* __gX;
-  T* __gY;
-  for (int i0 = 0; i0 < aux.Z[0]; ++i0) {
-    _X = X;
-    _Y = Y;
-    _Z = Z;
-    _gZ = gZ;
-    _gX = gX;
-    _gY = gY;
-    for (int i1 = 0; i1 < aux.Z[1]; ++i1) {
-      if (aux.vectorization) {
-        Meta::Backward(aux.Z[2], _X, _Y, _Z, _gZ, _gX, _gY);
-      } else {
-        __X = _X;
-        __Y = _Y;
-        __Z = _Z;
-        __gZ = _gZ;
-        __gX = _gX;
-        __gY = _gY;
-        for (int i2 = 0; i2 < aux.Z[2]; ++i2) {
-          Meta::Backward(__X, __Y, __Z, __gZ, __gX, __gY);
-          __X += aux.Xstrides[2];
-          __Y += aux.Ystrides[2];
-          __Z += aux.Zstrides[2];
-          __gZ += aux.Zstrides[2];
-          if (__gX) {
-            __gX += aux.Xstrides[2];
-          }
-          if (__gY) {
-            __gY += aux.Ystrides[2];
-          }
-        }
-      }
-      _X += aux.Xstrides[1];
-      _Y += aux.Ystrides[1];
-      _Z += aux.Zstrides[1];
-      _gZ += aux.Zstrides[1];
-      if (_gX) {
-        _gX += aux.Xstrides[1];
-      }
-      if (_gY) {
-        _gY += aux.Ystrides[1];
-      }
-    }
-    X += aux.Xstrides[0];
-    Y += aux.Ystrides[0];
-    Z += aux.Zstrides[0];
-    gZ += aux.Zstrides[0];
-    if (gX) {
-      gX += aux.Xstrides[0];
-    }
-    if (gY) {
-      gY += aux.Ystrides[0];
-    }
-  }
-}
-
-template <typename T, class Meta>
-void _BroadcastBackwardFallback(int level, const T* X, const T* Y, const T* Z,
-                                const T* gZ, T* gX, T* gY,
-                                const BroadcastAux& aux) noexcept {
-  if (level < aux.Z.rank() - 1) {
-    for (int i = 0; i < aux.Z[level]; ++i) {
-      _BroadcastBackwardFallback<T, Meta>(level + 1, X, Y, Z, gZ, gX, gY, aux);
-      X += aux.Xstrides[level];
-      Y += aux.Ystrides[level];
-      Z += aux.Zstrides[level];
-      gZ += aux.Zstrides[level];
-      if (gX) {
-        gX += aux.Xstrides[level];
-      }
-      if (gY) {
-        gY += aux.Ystrides[level];
-      }
-    }
-  } else {
-    if (aux.vectorization) {
-      Meta::Backward(aux.Z[level], X, Y, Z, gZ, gX, gY);
-    } else {
-      for (int i = 0; i < aux.Z[level]; ++i) {
-        Meta::Backward(X, Y, Z, gZ, gX, gY);
-        X += aux.Xstrides[level];
-        Y += aux.Ystrides[level];
-        Z += aux.Zstrides[level];
-        gZ += aux.Zstrides[level];
-        if (gX) {
-          gX += aux.Xstrides[level];
-        }
-        if (gY) {
-          gY += aux.Ystrides[level];
-        }
-      }
-    }
-  }
-}
-
-template <typename T, class Meta>
-void _BroadcastBackward(const T* X, const T* Y, const T* Z, const T* gZ, T* gX,
-                        T* gY, const BroadcastAux& aux) noexcept {
-  if (aux.XY_same_shape) {
-    Meta::Backward(aux.Z_total_dim, X, Y, Z, gZ, gX, gY);
-  } else if (aux.Z.is_rank(1)) {
-    _BroadcastBackwardRank1<T, Meta>(X, Y, Z, gZ, gX, gY, aux);
-  } else if (aux.Z.is_rank(2)) {
-    _BroadcastBackwardRank2<T, Meta>(X, Y, Z, gZ, gX, gY, aux);
-  } else if (aux.Z.is_rank(3)) {
-    _BroadcastBackwardRank3<T, Meta>(X, Y, Z, gZ, gX, gY, aux);
-  } else {
-    _BroadcastBackwardFallback<T, Meta>(0, X, Y, Z, gZ, gX, gY, aux);
-  }
-}
-
-#define DEFINE_BROADCAST_OP(name)                                             \
-  template <typename T>                                                       \
-  void Broadcast##name(const Tensor<T>& X, const Tensor<T>& Y, Tensor<T>* Z,  \
-                       const BroadcastAux& aux) noexcept {                    \
-    _Broadcast<T, Binary##name##Meta<T>>(X.data(), Y.data(), Z->data(), aux); \
+#define DEFINE_BROADCAST_OP(name)                                            \
+  template <typename T>                                                      \
+  void Broadcast##name(const Tensor<T>& X, const Tensor<T>& Y, Tensor<T>* Z, \
+                       const BroadcastAux& aux) noexcept {                   \
+    detail::Broadcast<T, Binary##name##Meta<T>>(X.data(), Y.data(),          \
+                                                Z->data(), aux);             \
   }
 
 #define DEFINE_BROADCAST_OP_BACKWARD(name)                                \
@@ -348,7 +39,7 @@ void _BroadcastBackward(const T* X, const T* Y, const T* Z, const T* gZ, T* gX,
     T* _gX = gX ? gX->data() : nullptr;                                   \
     T* _gY = gY ? gY->data() : nullptr;                                   \
     if (_gX || _gY) {                                                     \
-      _BroadcastBackward<T, Binary##name##Meta<T>>(                       \
+      detail::BroadcastBackward<T, Binary##name##Meta<T>>(                \
           X.data(), Y.data(), Z.data(), gZ.data(), _gX, _gY, aux);        \
     }                                                                     \
   }
@@ -541,6 +232,7 @@ bool BroadcastToPrepare(const Shape& X, const Shape& Y,
   aux->vectorization = (X_reverse_strides[0] == 1) &&
                        (Y_reverse_strides[0] == 1) &&
                        (Z_reverse_strides[0] == 1);
+  detail::BroadcastCanonicalize(aux);
   return true;
 }
 
@@ -553,222 +245,42 @@ bool BroadcastToInferShape(const Shape& X, const Shape& Y, Shape* Z) noexcept {
   return true;
 }
 
-template <typename T>
-struct BroadcastToMeta {
-  static void Forward(const T* X, T* Z) noexcept { *Z = *X; }
-
-  static void Forward(int n, const T* X, T* Z) noexcept {
-    LLMath<T>::copy(n, X, Z);
-  }
-
-  static void Backward(const T* gZ, T* gX) noexcept { *gX += *gZ; }
-
-  static void Backward(int n, const T* gZ, T* gX) noexcept {
-    LLMath<T>::add(n, gX, gZ, gX);
-  }
-};
-
-template <typename T>
-void _BroadcastToRank1(const T* X, T* Z, const BroadcastAux& aux) noexcept {
-  if (aux.vectorization) {
-    BroadcastToMeta<T>::Forward(aux.Z[0], X, Z);
-  } else {
-    for (int i0 = 0; i0 < aux.Z[0]; ++i0) {
-      BroadcastToMeta<T>::Forward(X, Z);
-      X += aux.Xstrides[0];
-      Z += aux.Zstrides[0];
-    }
-  }
-}
-
-template <typename T>
-void _BroadcastToRank2(const T* X, T* Z, const BroadcastAux& aux) noexcept {
-  const T* _X;
-  T* _Z;
-  for (int i0 = 0; i0 < aux.Z[0]; ++i0) {
-    if (aux.vectorization) {
-      BroadcastToMeta<T>::Forward(aux.Z[1], X, Z);
-    } else {
-      _X = X;
-      _Z = Z;
-      for (int i1 = 0; i1 < aux.Z[1]; ++i1) {
-        BroadcastToMeta<T>::Forward(_X, _Z);
-        _X += aux.Xstrides[1];
-        _Z += aux.Zstrides[1];
-      }
-    }
-    X += aux.Xstrides[0];
-    Z += aux.Zstrides[0];
-  }
-}
-
-template <typename T>
-void _BroadcastToRank3(const T* X, T* Z, const BroadcastAux& aux) noexcept {
-  const T* _X;
-  T* _Z;
-  const T* __X;
-  T* __Z;
-  for (int i0 = 0; i0 < aux.Z[0]; ++i0) {
-    _X = X;
-    _Z = Z;
-    for (int i1 = 0; i1 < aux.Z[1]; ++i1) {
-      if (aux.vectorization) {
-        BroadcastToMeta<T>::Forward(aux.Z[2], _X, _Z);
-      } else {
-        __X = _X;
-        __Z = _Z;
-        for (int i2 = 0; i2 < aux.Z[2]; ++i2) {
-          BroadcastToMeta<T>::Forward(__X, __Z);
-          __X += aux.Xstrides[2];
-          __Z += aux.Zstrides[2];
-        }
-      }
-      _X += aux.Xstrides[1];
-      _Z += aux.Zstrides[1];
-    }
-    X += aux.Xstrides[0];
-    Z += aux.Zstrides[0];
-  }
-}
-
-template <typename T>
-void _BroadcastToFallback(int level, const T* X, T* Z,
-                          const BroadcastAux& aux) noexcept {
-  if (level < aux.Z.rank() - 1) {
-    for (int i = 0; i < aux.Z[level]; ++i) {
-      _BroadcastToFallback(level + 1, X, Z, aux);
-      X += aux.Xstrides[level];
-      Z += aux.Zstrides[level];
-    }
-  } else {
-    if (aux.vectorization) {
-      BroadcastToMeta<T>::Forward(aux.Z[level], X, Z);
-    } else {
-      for (int i = 0; i < aux.Z[level]; ++i) {
-        BroadcastToMeta<T>::Forward(X, Z);
-        X += aux.Xstrides[level];
-        Z += aux.Zstrides[level];
-      }
-    }
-  }
-}
-
 template <typename T>
 void _BroadcastTo(const T* X, T* Z, const BroadcastAux& aux) noexcept {
-  if (aux.XY_same_shape) {
-    BroadcastToMeta<T>::Forward(aux.Z_total_dim, X, Z);
-  } else if (aux.Z.is_rank(1)) {
-    _BroadcastToRank1(X, Z, aux);
-  } else if (aux.Z.is_rank(2)) {
-    _BroadcastToRank2(X, Z, aux);
-  } else if (aux.Z.is_rank(3)) {
-    _BroadcastToRank3(X, Z, aux);
-  } else {
-    _BroadcastToFallback(0, X, Z, aux);
-  }
-}
-
-template <typename T>
-void _BroadcastToBackwardRank1(const T* gZ, T* gX,
-                               const BroadcastAux& aux) noexcept {
-  if (aux.vectorization) {
-    BroadcastToMeta<T>::Backward(aux.Z[0], gZ, gX);
-  } else {
-    for (int i0 = 0; i0 < aux.Z[0]; ++i0) {
-      BroadcastToMeta<T>::Backward(gZ, gX);
-      gZ += aux.Zstrides[0];
-      gX += aux.Xstrides[0];
-    }
-  }
-}
-
-template <typename T>
-void _BroadcastToBackwardRank2(const T* gZ, T* gX,
-                               const BroadcastAux& aux) noexcept {
-  const T* _gZ;
-  T* _gX;
-  for (int i0 = 0; i0 < aux.Z[0]; ++i0) {
-    if (aux.vectorization) {
-      BroadcastToMeta<T>::Backward(aux.Z[1], gZ, gX);
-    } else {
-      _gZ = gZ;
-      _gX = gX;
-      for (int i1 = 0; i1 < aux.Z[1]; ++i1) {
-        BroadcastToMeta<T>::Backward(_gZ, _gX);
-        _gZ += aux.Zstrides[1];
-        _gX += aux.Xstrides[1];
-      }
-    }
-    gZ += aux.Zstrides[0];
-    gX += aux.Xstrides[0];
-  }
-}
-
-template <typename T>
-void _BroadcastToBackwardRank3(const T* gZ, T* gX,
-                               const BroadcastAux& aux) noexcept {
-  const T* _gZ;
-  T* _gX;
-  const T* __gZ;
-  T* __gX;
-  for (int i0 = 0; i0 < aux.Z[0]; ++i0) {
-    _gZ = gZ;
-    _gX = gX;
-    for (int i1 = 0; i1 < aux.Z[1]; ++i1) {
-      if (aux.vectorization) {
-        BroadcastToMeta<T>::Backward(aux.Z[2], _gZ, _gX);
-      } else {
-        __gZ = _gZ;
-        __gX = _gX;
-        for (int i2 = 0; i2 < aux.Z[2]; ++i2) {
-          BroadcastToMeta<T>::Backward(__gZ, __gX);
-          __gZ += aux.Zstrides[2];
-          __gX += aux.Xstrides[2];
-        }
-      }
-      _gZ += aux.Zstrides[1];
-      _gX += aux.Xstrides[1];
-    }
-    gZ += aux.Zstrides[0];
-    gX += aux.Xstrides[0];
+  if (aux.pattern == BROADCAST_PATTERN_SAME) {
+    LLMath<T>::copy(aux.Z_total_dim, X, Z);
+    return;
   }
-}
 
-template <typename T>
-void _BroadcastToBackwardFallback(int level, const T* gZ, T* gX,
-                                  const BroadcastAux& aux) noexcept {
-  if (level < aux.Z.rank() - 1) {
-    for (int i = 0; i < aux.Z[level]; ++i) {
-      _BroadcastToBackwardFallback(level + 1, gZ, gX, aux);
-      gZ += aux.Zstrides[level];
-      gX += aux.Xstrides[level];
-    }
+  int last = aux.crank - 1;
+  int n = aux.cZ[last];
+  if (aux.cXstrides[last]) {
+    detail::BroadcastForEachRun(
+        aux, [&](int x, int, int z) { LLMath<T>::copy(n, X + x, Z + z); });
   } else {
-    if (aux.vectorization) {
-      BroadcastToMeta<T>::Backward(aux.Z[level], gZ, gX);
-    } else {
-      for (int i = 0; i < aux.Z[level]; ++i) {
-        BroadcastToMeta<T>::Backward(gZ, gX);
-        gZ += aux.Zstrides[level];
-        gX += aux.Xstrides[level];
-      }
-    }
+    detail::BroadcastForEachRun(
+        aux, [&](int x, int, int z) { std::fill(Z + z, Z + z + n, X[x]); });
   }
 }
 
 template <typename T>
 void _BroadcastToBackward(const T* gZ, T* gX,
                           const BroadcastAux& aux) noexcept {
-  if (aux.XY_same_shape) {
-    BroadcastToMeta<T>::Backward(aux.Z_total_dim, gZ, gX);
-  } else if (aux.Z.is_rank(1)) {
-    _BroadcastToBackwardRank1(gZ, gX, aux);
-  } else if (aux.Z.is_rank(2)) {
-    _BroadcastToBackwardRank2(gZ, gX, aux);
-  } else if (aux.Z.is_rank(3)) {
-    _BroadcastToBackwardRank3(gZ, gX, aux);
+  if (aux.pattern == BROADCAST_PATTERN_SAME) {
+    LLMath<T>::add(aux.Z_total_dim, gX, gZ, gX);
+    return;
+  }
+
+  int last = aux.crank - 1;
+  int n = aux.cZ[last];
+  if (aux.cXstrides[last]) {
+    detail::BroadcastForEachRun(aux, [&](int x, int, int z) {
+      LLMath<T>::add(n, gX + x, gZ + z, gX + x);
+    });
   } else {
-    _BroadcastToBackwardFallback(0, gZ, gX, aux);
+    detail::BroadcastForEachRun(aux, [&](int x, int, int z) {
+      gX[x] += LLMath<T>::sum(n, gZ + z);
+    });
   }
 }
 
@@ -10,6 +10,36 @@ namespace deepx_core {
 /************************************************************************/
 /* Broadcast */
 /************************************************************************/
+TEST(BroadcastPrepareTest, Pattern) {
+  struct Case {
+    Shape X;
+    Shape Y;
+    int pattern;
+    int crank;
+  };
+  const std::vector<Case> CASES = {
+      {Shape(2, 3), Shape(2, 3), BROADCAST_PATTERN_SAME, 1},
+      {Shape(2, 3), Shape(1, 2, 3), BROADCAST_PATTERN_SAME, 1},
+      {Shape(1, 1), Shape(1), BROADCAST_PATTERN_SAME, 0},
+      {Shape(2, 3), Shape(1), BROADCAST_PATTERN_SCALAR, 1},
+      {Shape(1, 1), Shape(2, 3, 4), BROADCAST_PATTERN_SCALAR, 1},
+      {Shape(2, 3, 4), Shape(4), BROADCAST_PATTERN_ROW, 2},
+      {Shape(2, 3, 4), Shape(3, 4), BROADCAST_PATTERN_ROW, 2},
+      {Shape(1, 4), Shape(2, 3, 4), BROADCAST_PATTERN_ROW, 2},
+      {Shape(2, 3, 4), Shape(2, 1, 1), BROADCAST_PATTERN_COL, 2},
+      {Shape(2, 3, 1), Shape(2, 3, 4), BROADCAST_PATTERN_COL, 2},
+      {Shape(2, 3, 1), Shape(1, 1, 4), BROADCAST_PATTERN_OUTER, 2},
+      {Shape(1, 4), Shape(3, 1), BROADCAST_PATTERN_OUTER, 2},
+      {Shape(2, 3, 4), Shape(1, 3, 1), BROADCAST_PATTERN_GENERAL, 3},
+      {Shape(2, 1, 4, 1), Shape(1, 3, 1, 5), BROADCAST_PATTERN_GENERAL, 4}};
+  for (const auto& entry : CASES) {
+    BroadcastAux aux;
+    ASSERT_TRUE(BroadcastPrepare(entry.X, entry.Y, &aux));
+    EXPECT_EQ(aux.pattern, entry.pattern);
+    EXPECT_EQ(aux.crank, entry.crank);
+  }
+}
+
 class BroadcastForwardTest : public testing::Test, public DataType {
  protected:
   static void TestBroadcastAdd(const Shape& Xshape, const Shape& Yshape,
@@ -120,6 +150,28 @@ TEST_F(BroadcastForwardTest, BroadcastAdd_Xshape2141_Yshape1315) {
   TestBroadcastAdd(Shape(2, 1, 4, 1), Shape(1, 3, 1, 5), expected_Z);
 }
 
+TEST_F(BroadcastForwardTest, BroadcastSub_blocked) {
+  int n = detail::BROADCAST_BLOCK + 3;
+  for (const auto& Yshape : {Shape(1), Shape(2, 1), Shape(1, n)}) {
+    ConstantNode X("X", Shape(2, n), TENSOR_INITIALIZER_TYPE_ARANGE, 0, 0);
+    ConstantNode Y("Y", Yshape, TENSOR_INITIALIZER_TYPE_ARANGE, 0, 0);
+    BroadcastSubNode Z("Z", &Y, &X);
+    tsr_t expected_Z(Shape(2, n));
+    for (int i = 0; i < 2; ++i) {
+      for (int j = 0; j < n; ++j) {
+        int y = 0;
+        if (Yshape == Shape(2, 1)) {
+          y = i;
+        } else if (Yshape == Shape(1, n)) {
+          y = j;
+        }
+        expected_Z.data(i * n + j) = (float_t)(y - (i * n + j));
+      }
+    }
+    CheckOpForward(&Z, 0, expected_Z);
+  }
+}
+
 class BroadcastBackwardTest : public testing::Test {
  protected:
   const std::vector<std::pair<Shape, Shape>> SHAPE_PAIRS = {
@@ -144,7 +196,10 @@ class BroadcastBackwardTest : public testing::Test {
       {Shape(2, 3, 4, 5), Shape(2, 1, 4, 1)},
       {Shape(2, 3, 4, 5), Shape(2, 3, 4, 5)},
       {Shape(2, 1, 4, 1), Shape(1, 3, 1, 5)},
-      {Shape(1, 3, 1, 5), Shape(2, 1, 4, 1)}};
+      {Shape(1, 3, 1, 5), Shape(2, 1, 4, 1)},
+      {Shape(2, 300), Shape(1)},
+      {Shape(2, 1), Shape(2, 300)},
+      {Shape(300, 1), Shape(1, 2)}};
 };
 
 TEST_F(BroadcastBackwardTest, BroadcastAdd) {
@@ -299,7 +354,8 @@ class BroadcastToBackwardTest : public testing::Test {
       {Shape(3, 4, 5), Shape(2, 3, 4, 5)},
       {Shape(1, 3, 1, 5), Shape(2, 3, 4, 5)},
       {Shape(2, 1, 4, 1), Shape(2, 3, 4, 5)},
-      {Shape(2, 3, 4, 5), Shape(2, 3, 4, 5)}};
+      {Shape(2, 3, 4, 5), Shape(2, 3, 4, 5)},
+      {Shape(2, 1), Shape(2, 300)}};
 };
 
 TEST_F(BroadcastToBackwardTest, BroadcastTo) {
@@ -0,0 +1,291 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#pragma once
+#include <deepx_core/common/hash.h>
+#include <deepx_core/graph/op_impl.h>
+#include <vector>
+
+namespace deepx_core {
+
+/************************************************************************/
+/* EmbeddingLookupPlan */
+/************************************************************************/
+// An embedding lookup plan of a batch.
+//
+// Every id is looked up in W once, no matter how many times it appears in the
+// batch, rows of all unique ids are resolved in one pass before they are
+// summed into Z.
+template <typename T, typename I>
+struct EmbeddingLookupPlan {
+  // indexed by lookup
+  std::vector<int> uid;  // index of the unique id, -1 means skipped
+  std::vector<int> Zoffset;
+
+  // indexed by unique id
+  std::vector<I> id;
+  std::vector<int> col;
+  std::vector<int> goffset;  // offset in 'grad'
+  std::vector<const T*> row;
+
+  std::vector<int> table;  // open addressing table of unique ids
+  std::vector<T> grad;     // gradients accumulated by unique id
+  std::vector<T> buf;      // dequantized rows by unique id
+};
+
+namespace detail {
+
+// Compute y += alpha * x, for the commonest embedding sizes, 'n' is a compile
+// time constant, so that the loop is fully unrolled and vectorized.
+template <int N, typename T>
+void EmbeddingAxpy(T alpha, const T* x, T* y) noexcept {
+  for (int i = 0; i < N; ++i) {
+    y[i] += alpha * x[i];
+  }
+}
+
+template <typename T>
+void EmbeddingAxpy(int n, T alpha, const T* x, T* y) noexcept {
+  switch (n) {
+    case 1:
+      y[0] += alpha * x[0];
+      break;
+    case 4:
+      EmbeddingAxpy<4>(alpha, x, y);
+      break;
+    case 8:
+      EmbeddingAxpy<8>(alpha, x, y);
+      break;
+    case 16:
+      EmbeddingAxpy<16>(alpha, x, y);
+      break;
+    case 32:
+      EmbeddingAxpy<32>(alpha, x, y);
+      break;
+    case 64:
+      EmbeddingAxpy<64>(alpha, x, y);
+      break;
+    default:
+      LLMath<T>::axpy(n, alpha, x, y);
+      break;
+  }
+}
+
+}  // namespace detail
+
+// Build 'plan' from 'n' lookups of ids 'X'.
+//
+// 'func(k, j, &Zoffset, &col)' returns false if lookup 'k' of id 'j' is
+// skipped, otherwise it outputs the offset in Z and the embedding size.
+template <typename T, typename I, class Func>
+void EmbeddingLookupPlanInit(int n, const I* X, Func&& func,
+                             EmbeddingLookupPlan<T, I>* plan) {
+  size_t table_size = 16;  // magic number
+  while (table_size < 2 * (size_t)n) {
+    table_size *= 2;
+  }
+  size_t mask = table_size - 1;
+  plan->uid.resize(n);
+  plan->Zoffset.resize(n);
+  plan->id.clear();
+  plan->col.clear();
+  plan->goffset.clear();
+  plan->table.assign(table_size, -1);
+
+  int goffset = 0;
+  for (int k = 0; k < n; ++k) {
+    I j = X[k];
+    int Zoffset, col;
+    if (!func(k, j, &Zoffset, &col)) {
+      plan->uid[k] = -1;
+      continue;
+    }
+
+    size_t index = (size_t)MurmurHash3Mix((uint64_t)j) & mask;
+    for (;;) {
+      int& uid = plan->table[index];
+      if (uid < 0) {
+        uid = (int)plan->id.size();
+        plan->id.emplace_back(j);
+        plan->col.emplace_back(col);
+        plan->goffset.emplace_back(goffset);
+        goffset += col;
+        break;
+      }
+      if (plan->id[uid] == j) {
+        break;
+      }
+      index = (index + 1) & mask;
+    }
+    plan->uid[k] = plan->table[index];
+    plan->Zoffset[k] = Zoffset;
+  }
+}
+
+// Resolve rows of unique ids in 'plan'.
+//
+// 'prefetch_func(j)' prefetches the row of id 'j',
+// 'row_func(j)' returns the row of id 'j' or nullptr.
+template <typename T, typename I, class PrefetchFunc, class RowFunc>
+void EmbeddingLookupResolve(PrefetchFunc&& prefetch_func, RowFunc&& row_func,
+                            EmbeddingLookupPlan<T, I>* plan) {
+  constexpr int PREFETCH_DISTANCE = 8;  // magic number
+  int m = (int)plan->id.size();
+  plan->row.resize(m);
+  for (int u = 0; u < m && u < PREFETCH_DISTANCE; ++u) {
+    prefetch_func(plan->id[u]);
+  }
+  for (int u = 0; u < m; ++u) {
+    if (u + PREFETCH_DISTANCE < m) {
+      prefetch_func(plan->id[u + PREFETCH_DISTANCE]);
+    }
+    plan->row[u] = row_func(plan->id[u]);
+  }
+}
+
+// Resolve rows of unique ids in 'plan', where rows may be quantized.
+//
+// 'prefetch_func(j)' prefetches the row of id 'j',
+// 'row_func(j, buf)' returns the row of id 'j' or nullptr,
+// a quantized row is dequantized to 'buf' of its embedding size,
+// then 'buf' is returned.
+//
+// Every unique row is dequantized once per batch.
+template <typename T, typename I, class PrefetchFunc, class RowFunc>
+void EmbeddingLookupResolveQuantized(PrefetchFunc&& prefetch_func,
+                                     RowFunc&& row_func,
+                                     EmbeddingLookupPlan<T, I>* plan) {
+  constexpr int PREFETCH_DISTANCE = 8;  // magic number
+  int m = (int)plan->id.size();
+  plan->row.resize(m);
+  plan->buf.resize(m ? plan->goffset[m - 1] + plan->col[m - 1] : 0);
+  for (int u = 0; u < m && u < PREFETCH_DISTANCE; ++u) {
+    prefetch_func(plan->id[u]);
+  }
+  for (int u = 0; u < m; ++u) {
+    if (u + PREFETCH_DISTANCE < m) {
+      prefetch_func(plan->id[u + PREFETCH_DISTANCE]);
+    }
+    plan->row[u] = row_func(plan->id[u], &plan->buf[plan->goffset[u]]);
+  }
+}
+
+// Compute Z = sum of rows weighted by values of CSR 'X'.
+template <typename T, typename I>
+void EmbeddingLookupForward(const CSRMatrix<T, I>& X,
+                            const EmbeddingLookupPlan<T, I>& plan,
+                            Tensor<T>* Z) noexcept {
+  constexpr int PREFETCH_DISTANCE = 4;  // magic number
+  int n = Z->dim(1);
+  int nnz = (int)X.value_size();
+  T* _Z = Z->data();
+  Z->zeros();
+  CSR_FOR_EACH_ROW(X, i) {
+    CSR_FOR_EACH_COL(X, i) {
+      if (__k + PREFETCH_DISTANCE < nnz) {
+        int uid = plan.uid[__k + PREFETCH_DISTANCE];
+        if (uid >= 0 && plan.row[uid]) {
+#if defined __GNUC__
+          __builtin_prefetch(plan.row[uid]);
+#endif
+        }
+      }
+
+      int uid = plan.uid[__k];
+      if (uid < 0 || plan.row[uid] == nullptr) {
+        continue;
+      }
+      detail::EmbeddingAxpy(plan.col[uid], CSR_VALUE(X), plan.row[uid],
+                            _Z + plan.Zoffset[__k]);
+    }
+    _Z += n;
+  }
+}
+
+namespace detail {
+
+template <typename T, typename I>
+void EmbeddingLookupGradInit(EmbeddingLookupPlan<T, I>* plan) {
+  int m = (int)plan->id.size();
+  plan->grad.assign(m ? plan->goffset[m - 1] + plan->col[m - 1] : 0, 0);
+}
+
+template <typename T, typename I, class GradRowFunc>
+void EmbeddingLookupGradApply(GradRowFunc&& grad_row_func,
+                              const EmbeddingLookupPlan<T, I>& plan) {
+  for (size_t u = 0; u < plan.id.size(); ++u) {
+    T* gWj = grad_row_func(plan.id[u]);
+    if (gWj) {
+      const T* gj = plan.grad.data() + plan.goffset[u];
+      LLMath<T>::add(plan.col[u], gj, gWj, gWj);
+    }
+  }
+}
+
+}  // namespace detail
+
+// Accumulate gradients of unique ids from 'gZ' and values of CSR 'X',
+// then add them to rows returned by 'grad_row_func(j)' once per unique id.
+template <typename T, typename I, class GradRowFunc>
+void EmbeddingLookupBackward(const CSRMatrix<T, I>& X, const Tensor<T>& gZ,
+                             GradRowFunc&& grad_row_func,
+                             EmbeddingLookupPlan<T, I>* plan) {
+  int n = gZ.dim(1);
+  const T* _gZ = gZ.data();
+  detail::EmbeddingLookupGradInit(plan);
+  T* grad = plan->grad.data();
+  CSR_FOR_EACH_ROW(X, i) {
+    CSR_FOR_EACH_COL(X, i) {
+      int uid = plan->uid[__k];
+      if (uid < 0) {
+        continue;
+      }
+      detail::EmbeddingAxpy(plan->col[uid], CSR_VALUE(X),
+                            _gZ + plan->Zoffset[__k],
+                            grad + plan->goffset[uid]);
+    }
+    _gZ += n;
+  }
+  detail::EmbeddingLookupGradApply<T, I>(grad_row_func, *plan);
+}
+
+// Copy rows to Z, rows of ids not found are zeros.
+template <typename T, typename I>
+void EmbeddingLookupCopy(const EmbeddingLookupPlan<T, I>& plan,
+                         Tensor<T>* Z) noexcept {
+  T* _Z = Z->data();
+  for (size_t k = 0; k < plan.uid.size(); ++k) {
+    int uid = plan.uid[k];
+    if (uid < 0) {
+      continue;
+    }
+    const T* Wj = plan.row[uid];
+    if (Wj) {
+      LLMath<T>::copy(plan.col[uid], Wj, _Z + plan.Zoffset[k]);
+    } else {
+      LLMath<T>::zero(plan.col[uid], _Z + plan.Zoffset[k]);
+    }
+  }
+}
+
+// The backward of 'EmbeddingLookupCopy'.
+template <typename T, typename I, class GradRowFunc>
+void EmbeddingLookupCopyBackward(const Tensor<T>& gZ,
+                                 GradRowFunc&& grad_row_func,
+                                 EmbeddingLookupPlan<T, I>* plan) {
+  const T* _gZ = gZ.data();
+  detail::EmbeddingLookupGradInit(plan);
+  T* grad = plan->grad.data();
+  for (size_t k = 0; k < plan->uid.size(); ++k) {
+    int uid = plan->uid[k];
+    if (uid < 0) {
+      continue;
+    }
+    LLMath<T>::add(plan->col[uid], _gZ + plan->Zoffset[k],
+                   grad + plan->goffset[uid], grad + plan->goffset[uid]);
+  }
+  detail::EmbeddingLookupGradApply<T, I>(grad_row_func, *plan);
+}
+
+}  // namespace deepx_core
@@ -3,6 +3,7 @@
 //
 
 #include <deepx_core/graph/op_impl.h>
+#include "embedding_lookup.h"
 
 namespace deepx_core {
 namespace {
@@ -44,6 +45,33 @@ void SparseEmbeddingLookupBackward(const CSRMatrix<T, I>& X,
   LLSparseTensor<T, I>::gestmm(X, gZ, 1, gW);
 }
 
+template <typename T, typename I>
+void QuantizedEmbeddingLookup(const CSRMatrix<T, I>& X,
+                              const QuantizedSparseRowMatrix<T, I>& W,
+                              Tensor<T>* Z, EmbeddingLookupPlan<T, I>* plan) {
+  int col = W.col();
+  EmbeddingLookupPlanInit((int)X.col_size(), X.col_begin(),
+                          [col](int /*k*/, I /*j*/, int* Zoffset, int* _col) {
+                            *Zoffset = 0;
+                            *_col = col;
+                            return true;
+                          },
+                          plan);
+  EmbeddingLookupResolveQuantized(
+      [&W](I j) { W.prefetch_row(j); },
+      [&W, col](I j, T* buf) -> const T* {
+        T scale;
+        const int8_t* Qj = W.get_row_no_init(j, &scale);
+        if (Qj == nullptr) {
+          return nullptr;
+        }
+        DequantizeRow(col, Qj, scale, buf);
+        return buf;
+      },
+      plan);
+  EmbeddingLookupForward(X, *plan, Z);
+}
+
 }  // namespace
 
 EmbeddingLookupNode::EmbeddingLookupNode(std::string name, GraphNode* X,
@@ -71,6 +99,8 @@ class EmbeddingLookupOp : public OpImpl {
   const csr_t* X_ = nullptr;
   const tsr_t* Wtsr_ = nullptr;
   const srm_t* Wsrm_ = nullptr;
+  const qsrm_t* Wqsrm_ = nullptr;
+  EmbeddingLookupPlan<float_t, int_t> plan_;
   Shape Zshape_;
   tsr_t* Z_ = nullptr;
   tsr_t* gZ_ = nullptr;
@@ -88,6 +118,7 @@ class EmbeddingLookupOp : public OpImpl {
     X_ = GetPtrCSR(Xnode_);
     Wtsr_ = nullptr;
     Wsrm_ = nullptr;
+    Wqsrm_ = nullptr;
     switch (W_tensor_type_) {
       case TENSOR_TYPE_TSR:
         Wtsr_ = GetPtrTSR(Wnode_);
@@ -95,15 +126,23 @@ class EmbeddingLookupOp : public OpImpl {
             EmbeddingLookupInferShape(X_->row(), Wtsr_->shape(), &Zshape_));
         break;
       case TENSOR_TYPE_SRM:
-        Wsrm_ = GetPtrSRM(Wnode_);
-        DXCHECK_THROW(
-            EmbeddingLookupInferShape(X_->row(), Wsrm_->shape(), &Zshape_));
+        Wqsrm_ = GetPtrQSRM(Wnode_);
+        if (Wqsrm_) {
+          DXCHECK_THROW(
+              EmbeddingLookupInferShape(X_->row(), Wqsrm_->shape(), &Zshape_));
+        } else {
+          Wsrm_ = GetPtrSRM(Wnode_);
+          DXCHECK_THROW(
+              EmbeddingLookupInferShape(X_->row(), Wsrm_->shape(), &Zshape_));
+        }
         break;
     }
     Z_ = InitHiddenTSR(node_, Zshape_);
   }
 
   void InitBackward() override {
+    // quantized params are for inference only
+    DXCHECK_THROW(Wqsrm_ == nullptr);
     gZ_ = GetGradPtrTSR(node_);
     switch (W_tensor_type_) {
       case TENSOR_TYPE_TSR:
@@ -121,7 +160,11 @@ class EmbeddingLookupOp : public OpImpl {
         EmbeddingLookup(*X_, *Wtsr_, Z_);
         break;
       case TENSOR_TYPE_SRM:
-        SparseEmbeddingLookup(*X_, *Wsrm_, Z_);
+        if (Wqsrm_) {
+          QuantizedEmbeddingLookup(*X_, *Wqsrm_, Z_, &plan_);
+        } else {
+          SparseEmbeddingLookup(*X_, *Wsrm_, Z_);
+        }
         break;
     }
   }
@@ -127,4 +127,29 @@ TEST_F(EmbeddingLookupBackwardTest, EmbeddingLookup_SRM_Wcol4) {
   TestSRM(Shape(0, 4));
 }
 
+class EmbeddingLookupPredictQuantizedTest : public EmbeddingLookupForwardTest {
+};
+
+TEST_F(EmbeddingLookupPredictQuantizedTest, EmbeddingLookup_SRM_Wcol8) {
+  InstanceNode X("X", Shape(-1, 0), TENSOR_TYPE_CSR);
+  VariableNode W("W", Shape(0, 8), TENSOR_TYPE_SRM,
+                 TENSOR_INITIALIZER_TYPE_RANDN, 0, 1);
+  EmbeddingLookupNode Z("Z", &X, &W);
+  auto post_param_initializer = [this](std::default_random_engine& engine,
+                                       TensorMap* param) {
+    auto& W = param->get<srm_t>("W");
+    // Row 7 is missing.
+    for (size_t i = 0; i < X_.col_size(); ++i) {
+      if (X_.col(i) != 7) {
+        W.get_row(engine, X_.col(i));
+      }
+    }
+  };
+  auto inst_initializer = [this](Instance* inst) {
+    inst->insert<csr_t>("X") = X_;
+  };
+  CheckOpPredictQuantized(&Z, 0, nullptr, post_param_initializer,
+                          inst_initializer);
+}
+
 }  // namespace deepx_core
@@ -53,9 +53,16 @@ void BatchFMInteractionBackward(const Tensor<T>& X, const Tensor<T>& /*Z*/,
   T* _gX = gX->data();
   for (int i = 0; i < batch; ++i) {
     for (int j = 0; j < m; ++j) {
+      const T* Xj = _X + j * n;
+      T* gXj = _gX + j * n;
       for (int k = j + 1; k < m; ++k) {
-        LLMath<T>::xypz(n, _gZ, _X + k * n, _gX + j * n);
-        LLMath<T>::xypz(n, _gZ, _X + j * n, _gX + k * n);
+        const T* Xk = _X + k * n;
+        T* gXk = _gX + k * n;
+        // one pass over gZ for both gradients
+        for (int l = 0; l < n; ++l) {
+          gXj[l] += _gZ[l] * Xk[l];
+          gXk[l] += _gZ[l] * Xj[l];
+        }
         _gZ += n;
       }
     }
@@ -250,6 +257,110 @@ GRAPH_NODE_OP_REGISTER(BatchFMInteraction2);
 CLASS_FACTORY_REGISTER(GraphNode, BatchFMInteraction2Node,
                        "BatchPairWiseInteraction2Node");
 
+/************************************************************************/
+/* BatchFMInnerProduct */
+/************************************************************************/
+namespace {
+
+bool BatchFMInnerProductInferShape(const Shape& X, Shape* Z) noexcept {
+  if (!X.is_rank(3)) {
+    DXERROR("Invalid X: rank of X %d must be 3.", X.rank());
+    return false;
+  }
+
+  int batch = X[0];
+  int m = X[1];
+  Z->resize(batch, m * (m - 1) / 2);
+  return true;
+}
+
+// Z_i is the strict upper triangle of X_i * X_i^T in row-major order.
+template <typename T>
+void BatchFMInnerProduct(const Tensor<T>& X, Tensor<T>* Z,
+                         Tensor<T>* aux) noexcept {
+  int batch = X.dim(0);
+  int m = X.dim(1);
+  int n = X.dim(2);
+  DXASSERT(aux->same_shape(m, m));
+  const T* _X = X.data();
+  T* _Z = Z->data();
+  T* _aux = aux->data();
+  for (int i = 0; i < batch; ++i) {
+    LLMath<T>::gemm(0, 1, m, m, n, _X, _X, _aux);
+    for (int j = 0; j < m - 1; ++j) {
+      LLMath<T>::copy(m - j - 1, _aux + j * m + j + 1, _Z);
+      _Z += m - j - 1;
+    }
+    _X += m * n;
+  }
+}
+
+template <typename T>
+void BatchFMInnerProductBackward(const Tensor<T>& X, const Tensor<T>& /*Z*/,
+                                 const Tensor<T>& gZ, Tensor<T>* gX,
+                                 Tensor<T>* aux) noexcept {
+  int batch = X.dim(0);
+  int m = X.dim(1);
+  int n = X.dim(2);
+  DXASSERT(aux->same_shape(m, m));
+  const T* _X = X.data();
+  const T* _gZ = gZ.data();
+  T* _gX = gX->data();
+  T* _aux = aux->data();
+  for (int i = 0; i < batch; ++i) {
+    // symmetric gradient matrix with zero diagonal
+    for (int j = 0; j < m; ++j) {
+      _aux[j * m + j] = 0;
+      for (int k = j + 1; k < m; ++k) {
+        _aux[j * m + k] = *_gZ;
+        _aux[k * m + j] = *_gZ;
+        _gZ += 1;
+      }
+    }
+    LLMath<T>::gemm(0, 0, m, n, m, 1, _aux, _X, 1, _gX);
+    _X += m * n;
+    _gX += m * n;
+  }
+}
+
+}  // namespace
+
+BatchFMInnerProductNode::BatchFMInnerProductNode(std::string name, GraphNode* X)
+    : GraphNodeUnaryBase(std::move(name), X) {
+  if (!X->shape().empty()) {
+    (void)BatchFMInnerProductInferShape(X->shape(), &shape_);
+  }
+}
+
+class BatchFMInnerProductOp : public OpUnaryBase {
+ private:
+  Shape Zshape_;
+  tsr_t aux_;
+
+ public:
+  DEFINE_OP_LIKE(BatchFMInnerProductOp);
+
+  const Shape& InferShape() override {
+    DXCHECK_THROW(BatchFMInnerProductInferShape(X_->shape(), &Zshape_));
+    return Zshape_;
+  }
+
+  void InitForward() override {
+    OpUnaryBase::InitForward();
+    aux_.resize(X_->dim(1), X_->dim(1));
+  }
+
+  void Forward() override { BatchFMInnerProduct(*X_, Z_, &aux_); }
+
+  void Backward() override {
+    if (gX_) {
+      BatchFMInnerProductBackward(*X_, *Z_, *gZ_, gX_, &aux_);
+    }
+  }
+};
+
+GRAPH_NODE_OP_REGISTER(BatchFMInnerProduct);
+
 /************************************************************************/
 /* BatchFMQuadratic */
 /************************************************************************/
@@ -60,6 +60,28 @@ TEST_F(BatchFMInteraction2BackwardTest, BatchFMInteraction2) {
   CheckOpBackward(&Z, 0);
 }
 
+/************************************************************************/
+/* BatchFMInnerProduct */
+/************************************************************************/
+class BatchFMInnerProductForwardTest : public testing::Test, public DataType {};
+
+TEST_F(BatchFMInnerProductForwardTest, BatchFMInnerProduct) {
+  ConstantNode X("X", Shape(2, 3, 4), TENSOR_INITIALIZER_TYPE_ARANGE, 0, 0);
+  BatchFMInnerProductNode Z("Z", &X);
+  tsr_t expected_Z{38, 62, 214,  //
+                   950, 1166, 1510};
+  expected_Z.reshape(2, 3);
+  CheckOpForward(&Z, 0, expected_Z);
+}
+
+class BatchFMInnerProductBackwardTest : public testing::Test {};
+
+TEST_F(BatchFMInnerProductBackwardTest, BatchFMInnerProduct) {
+  VariableNode X("X", Shape(2, 4, 5), TENSOR_INITIALIZER_TYPE_RANDN, 0, 1);
+  BatchFMInnerProductNode Z("Z", &X);
+  CheckOpBackward(&Z, 0);
+}
+
 /************************************************************************/
 /* BatchFMQuadratic */
 /************************************************************************/
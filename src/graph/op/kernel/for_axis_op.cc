@@ -3,6 +3,8 @@
 //
 
 #include <deepx_core/graph/op_impl.h>
+#include <cmath>
+#include "reduce.h"
 
 namespace deepx_core {
 namespace {
@@ -53,22 +55,19 @@ bool ForAxisInferShape(const Shape& X, int axis, Shape* Z) noexcept {
 
 template <typename T>
 struct ForAxisMutableAux {
-  Tensor<T> buf1;
-  Tensor<T> buf2;
-  Tensor<T> buf3;
-  Tensor<T> buf4;
+  Tensor<T> buf;
 };
 
 template <typename T>
 void ForAxisPrepare(const ForAxisAux& aux, ForAxisMutableAux<T>* maux) {
   if (aux.n != 1) {
-    maux->buf1.resize(aux.k);
-    maux->buf2.resize(aux.k);
-    maux->buf3.resize(aux.k);
-    maux->buf4.resize(aux.k);
+    maux->buf.resize(2 * aux.n + ReduceSumRowsBufferSize(aux.k, aux.n));
   }
 }
 
+// If n is 1, 'Meta::Forward' works on a contiguous row,
+// otherwise, 'Meta::ForwardRows' works on columns of an (k, n) block, row by
+// row.
 template <typename T, class Meta>
 void ForAxis(const Tensor<T>& X, Tensor<T>* Z, const ForAxisAux& aux,
              ForAxisMutableAux<T>* maux) noexcept {
@@ -82,30 +81,9 @@ void ForAxis(const Tensor<T>& X, Tensor<T>* Z, const ForAxisAux& aux,
       _Z += k;
     }
   } else {
-    const T* __X;
-    const T* ___X;
-    T* __Z;
-    T* ___Z;
-    T* buf1 = maux->buf1.data();
-    T* buf2 = maux->buf2.data();
+    T* buf = maux->buf.data();
     for (int i = 0; i < m; ++i) {
-      __X = _X;
-      __Z = _Z;
-      for (int jj = 0; jj < n; ++jj) {
-        ___X = __X;
-        ___Z = __Z;
-        for (int j = 0; j < k; ++j) {
-          buf1[j] = *___X;
-          ___X += n;
-        }
-        Meta::Forward(k, buf1, buf2);
-        for (int j = 0; j < k; ++j) {
-          *___Z = buf2[j];
-          ___Z += n;
-        }
-        __X += 1;
-        __Z += 1;
-      }
+      Meta::ForwardRows(k, n, _X, _Z, buf);
       _X += k * n;
       _Z += k * n;
     }
@@ -130,49 +108,9 @@ void ForAxisBackward(const Tensor<T>& X, const Tensor<T>& Z,
       _gX += k;
     }
   } else {
-    const T* __X;
-    const T* ___X;
-    const T* __Z;
-    const T* ___Z;
-    const T* __gZ;
-    const T* ___gZ;
-    T* __gX;
-    T* ___gX;
-    T* buf1 = maux->buf1.data();
-    T* buf2 = maux->buf2.data();
-    T* buf3 = maux->buf3.data();
-    T* buf4 = maux->buf4.data();
+    T* buf = maux->buf.data();
     for (int i = 0; i < m; ++i) {
-      __X = _X;
-      __Z = _Z;
-      __gZ = _gZ;
-      __gX = _gX;
-      for (int jj = 0; jj < n; ++jj) {
-        ___X = __X;
-        ___Z = __Z;
-        ___gZ = __gZ;
-        ___gX = __gX;
-        for (int j = 0; j < k; ++j) {
-          buf1[j] = *___X;
-          buf2[j] = *___Z;
-          buf3[j] = *___gZ;
-          buf4[j] = *___gX;
-          ___X += n;
-          ___Z += n;
-          ___gZ += n;
-          ___gX += n;
-        }
-        Meta::Backward(k, buf1, buf2, buf3, buf4);
-        ___gX = __gX;
-        for (int j = 0; j < k; ++j) {
-          *___gX = buf4[j];
-          ___gX += n;
-        }
-        __X += 1;
-        __Z += 1;
-        __gZ += 1;
-        __gX += 1;
-      }
+      Meta::BackwardRows(k, n, _X, _Z, _gZ, _gX, buf);
       _X += k * n;
       _Z += k * n;
       _gZ += k * n;
@@ -181,17 +119,71 @@ void ForAxisBackward(const Tensor<T>& X, const Tensor<T>& Z,
   }
 }
 
+// Compute dot = sum(X * Y, axis=0) of row-major 'X'(k, n) and 'Y'(k, n).
+template <typename T>
+void ForAxisDotRows(int k, int n, const T* X, const T* Y, T* dot) noexcept {
+  LLMath<T>::zero(n, dot);
+  for (int j = 0; j < k; ++j) {
+    LLMath<T>::xypz(n, X, Y, dot);
+    X += n;
+    Y += n;
+  }
+}
+
+// Compute Z = exp(X - max(X, axis=0)) of row-major 'X'(k, n),
+// and the sum of Z along axis 0.
+//
+// 'buf' has '2 * n + ReduceSumRowsBufferSize(k, n)' elements,
+// max is stored in 'buf', sum is stored in 'buf + n'.
+template <typename T>
+void ForAxisExpRows(int k, int n, const T* X, T* Z, T* buf) noexcept {
+  T* max = buf;
+  T* sum = buf + n;
+  ReduceMaxRows(k, n, X, max);
+  for (int j = 0; j < k; ++j) {
+    for (int l = 0; l < n; ++l) {
+      Z[j * n + l] = std::exp(X[j * n + l] - max[l]);
+    }
+  }
+  ReduceSumRows(k, n, Z, sum, buf + 2 * n);
+}
+
 template <typename T>
 struct ForAxisSoftmaxMeta {
   static void Forward(int n, const T* X, T* Z) noexcept {
     LLMath<T>::softmax(n, X, Z);
   }
 
+  static void ForwardRows(int k, int n, const T* X, T* Z, T* buf) noexcept {
+    ForAxisExpRows(k, n, X, Z, buf);
+    T* sum = buf + n;
+    for (int l = 0; l < n; ++l) {
+      sum[l] = 1 / sum[l];
+    }
+    for (int j = 0; j < k; ++j) {
+      LLMath<T>::mul(n, Z + j * n, sum, Z + j * n);
+    }
+  }
+
   static void Backward(int n, const T* /*X*/, const T* Z, const T* gZ,
                        T* gX) noexcept {
     LLMath<T>::xypz(n, gZ, Z, gX);
     LLMath<T>::axpy(n, -LLMath<T>::dot(n, gZ, Z), Z, gX);
   }
+
+  static void BackwardRows(int k, int n, const T* /*X*/, const T* Z,
+                           const T* gZ, T* gX, T* buf) noexcept {
+    T* dot = buf;
+    ForAxisDotRows(k, n, gZ, Z, dot);
+    for (int j = 0; j < k; ++j) {
+      for (int l = 0; l < n; ++l) {
+        gX[l] += Z[l] * (gZ[l] - dot[l]);
+      }
+      Z += n;
+      gZ += n;
+      gX += n;
+    }
+  }
 };
 
 template <typename T>
@@ -200,11 +192,37 @@ struct ForAxisSoftmax2Meta {
     LLMath<T>::softmax2(n, X, Z);
   }
 
+  static void ForwardRows(int k, int n, const T* X, T* Z, T* buf) noexcept {
+    ForAxisExpRows(k, n, X, Z, buf);
+    T* sum = buf + n;
+    for (int l = 0; l < n; ++l) {
+      sum[l] = k / sum[l];
+    }
+    for (int j = 0; j < k; ++j) {
+      LLMath<T>::mul(n, Z + j * n, sum, Z + j * n);
+    }
+  }
+
   static void Backward(int n, const T* /*X*/, const T* Z, const T* gZ,
                        T* gX) noexcept {
     LLMath<T>::xypz(n, gZ, Z, gX);
     LLMath<T>::axpy(n, -LLMath<T>::dot(n, gZ, Z) / n, Z, gX);
   }
+
+  static void BackwardRows(int k, int n, const T* /*X*/, const T* Z,
+                           const T* gZ, T* gX, T* buf) noexcept {
+    T* dot = buf;
+    ForAxisDotRows(k, n, gZ, Z, dot);
+    LLMath<T>::mul_scalar(n, dot, (T)1 / k, dot);
+    for (int j = 0; j < k; ++j) {
+      for (int l = 0; l < n; ++l) {
+        gX[l] += Z[l] * (gZ[l] - dot[l]);
+      }
+      Z += n;
+      gZ += n;
+      gX += n;
+    }
+  }
 };
 
 template <typename T>
@@ -214,6 +232,18 @@ struct ForAxisLogSoftmaxMeta {
     LLMath<T>::log(n, Z, Z);
   }
 
+  static void ForwardRows(int k, int n, const T* X, T* Z, T* buf) noexcept {
+    ForAxisExpRows(k, n, X, Z, buf);
+    T* lse = buf;
+    const T* sum = buf + n;
+    for (int l = 0; l < n; ++l) {
+      lse[l] += std::log(sum[l]);
+    }
+    for (int j = 0; j < k; ++j) {
+      LLMath<T>::sub(n, X + j * n, lse, Z + j * n);
+    }
+  }
+
   static void Backward(int n, const T* /*X*/, const T* Z, const T* gZ,
                        T* gX) noexcept {
     T s = LLMath<T>::sum(n, gZ);
@@ -221,6 +251,20 @@ struct ForAxisLogSoftmaxMeta {
       gX[i] += gZ[i] - std::exp(Z[i]) * s;
     }
   }
+
+  static void BackwardRows(int k, int n, const T* /*X*/, const T* Z,
+                           const T* gZ, T* gX, T* buf) noexcept {
+    T* s = buf;
+    ReduceSumRows(k, n, gZ, s, buf + 2 * n);
+    for (int j = 0; j < k; ++j) {
+      for (int l = 0; l < n; ++l) {
+        gX[l] += gZ[l] - std::exp(Z[l]) * s[l];
+      }
+      Z += n;
+      gZ += n;
+      gX += n;
+    }
+  }
 };
 
 template <typename T>
@@ -238,6 +282,15 @@ struct ForAxisHardmaxMeta {
     }
     Z[j] = 1;
   }
+
+  static void ForwardRows(int k, int n, const T* X, T* Z, T* buf) noexcept {
+    T* index = buf + n;
+    ReduceArgMaxRows(k, n, X, index, buf);
+    LLMath<T>::zero(k * n, Z);
+    for (int l = 0; l < n; ++l) {
+      Z[(int)index[l] * n + l] = 1;
+    }
+  }
 };
 
 template <typename T>
@@ -249,6 +302,24 @@ struct ForAxisNormalize2Meta {
     LLMath<T>::mul_scalar(n, X, a, Z);
   }
 
+  // Compute a = 1 / max(norm2(X, axis=0), 1e-6).
+  static void InvNormRows(int k, int n, const T* X, T* a, T* buf) noexcept {
+    ReduceSumRows(k, n, X, a, buf, [](T x) { return x * x; });
+    for (int l = 0; l < n; ++l) {
+      T norm2_x = std::sqrt(a[l]);
+      norm2_x = norm2_x < (T)1e-6 ? (T)1e-6 : norm2_x;
+      a[l] = 1 / norm2_x;
+    }
+  }
+
+  static void ForwardRows(int k, int n, const T* X, T* Z, T* buf) noexcept {
+    T* a = buf;
+    InvNormRows(k, n, X, a, buf + 2 * n);
+    for (int j = 0; j < k; ++j) {
+      LLMath<T>::mul(n, X + j * n, a, Z + j * n);
+    }
+  }
+
   static void Backward(int n, const T* X, const T* Z, const T* gZ,
                        T* gX) noexcept {
     T norm2_x = LLMath<T>::norm2(n, X);
@@ -257,6 +328,22 @@ struct ForAxisNormalize2Meta {
     LLMath<T>::axpy(n, a, gZ, gX);
     LLMath<T>::axpy(n, -LLMath<T>::dot(n, gZ, Z) * a, Z, gX);
   }
+
+  static void BackwardRows(int k, int n, const T* X, const T* Z, const T* gZ,
+                           T* gX, T* buf) noexcept {
+    T* a = buf;
+    T* dot = buf + n;
+    InvNormRows(k, n, X, a, buf + 2 * n);
+    ForAxisDotRows(k, n, gZ, Z, dot);
+    for (int j = 0; j < k; ++j) {
+      for (int l = 0; l < n; ++l) {
+        gX[l] += a[l] * (gZ[l] - dot[l] * Z[l]);
+      }
+      Z += n;
+      gZ += n;
+      gX += n;
+    }
+  }
 };
 
 #define DEFINE_FOR_AXIS_OP(name)                                     \
@@ -13,7 +13,7 @@ class ForAxisBackwardTest : public testing::Test {
       {Shape(2, 3), 0},        {Shape(2, 3), 1},       {Shape(2, 3, 4), -1},
       {Shape(2, 3, 4), 0},     {Shape(2, 3, 4), 1},    {Shape(2, 3, 4), 2},
       {Shape(2, 3, 4, 5), -1}, {Shape(2, 3, 4, 5), 0}, {Shape(2, 3, 4, 5), 1},
-      {Shape(2, 3, 4, 5), 2},  {Shape(2, 3, 4, 5), 3}};
+      {Shape(2, 3, 4, 5), 2},  {Shape(2, 3, 4, 5), 3}, {Shape(2, 37, 3), 1}};
 };
 
 TEST_F(ForAxisBackwardTest, Softmax) {
@@ -79,6 +79,7 @@ class FullyConnectOp : public OpImpl {
  protected:
   const tsr_t* X_ = nullptr;
   const tsr_t* W_ = nullptr;
+  const qtsr_t* qW_ = nullptr;
   const tsr_t* b_ = nullptr;
   Shape Zshape_;
   tsr_t* Z_ = nullptr;
@@ -86,6 +87,8 @@ class FullyConnectOp : public OpImpl {
   tsr_t* gX_ = nullptr;
   tsr_t* gW_ = nullptr;
   tsr_t* gb_ = nullptr;
+  std::vector<int8_t> qX_;
+  std::vector<float_t> Xscale_;
 #if HAVE_SAGE2_SGEMM_JIT == 1 && HAVE_FLOAT64 == 0
   int m_ = 0;
   int n_ = 0;
@@ -116,16 +119,23 @@ class FullyConnectOp : public OpImpl {
 
   void InitForward() override {
     X_ = GetPtrTSR(node_->input(0));
-    W_ = GetPtrTSR(node_->input(1));
+    qW_ = GetPtrQTSR(node_->input(1));
+    W_ = qW_ ? nullptr : GetPtrTSR(node_->input(1));
+    const Shape& Wshape = qW_ ? qW_->shape() : W_->shape();
     if (node_->input_size() == 2) {
       b_ = nullptr;
-      DXCHECK_THROW(FullyConnectInferShape(X_->shape(), W_->shape(), &Zshape_));
+      DXCHECK_THROW(FullyConnectInferShape(X_->shape(), Wshape, &Zshape_));
     } else {
       b_ = GetPtrTSR(node_->input(2));
-      DXCHECK_THROW(FullyConnectInferShape(X_->shape(), W_->shape(),
-                                           b_->shape(), &Zshape_));
+      DXCHECK_THROW(FullyConnectInferShape(X_->shape(), Wshape, b_->shape(),
+                                           &Zshape_));
     }
     Z_ = InitHiddenTSR(node_, Zshape_);
+    if (qW_) {
+      qX_.resize(X_->total_dim());
+      Xscale_.resize(X_->dim(0));
+      return;
+    }
 #if HAVE_SAGE2_SGEMM_JIT == 1 && HAVE_FLOAT64 == 0
     m_ = X_->shape()[0];
     n_ = W_->shape()[1];
@@ -142,6 +152,8 @@ class FullyConnectOp : public OpImpl {
   }
 
   void InitBackward() override {
+    // quantized params are for inference only
+    DXCHECK_THROW(qW_ == nullptr);
     gZ_ = GetGradPtrTSR(node_);
     gX_ = InitGradTSR(node_->input(0), X_->shape());
     gW_ = InitGradTSR(node_->input(1), W_->shape());
@@ -175,11 +187,15 @@ class FullyConnectOp : public OpImpl {
   }
 
   void Forward() override {
+    if (qW_) {
+      QuantizedForward();
+    } else {
 #if HAVE_SAGE2_SGEMM_JIT == 1 && HAVE_FLOAT64 == 0
-    forward_(forward_jit_, X_->data(), W_->data(), Z_->data());
+      forward_(forward_jit_, X_->data(), W_->data(), Z_->data());
 #else
-    ll_tensor_t::gemm(0, 0, *X_, *W_, Z_);
+      ll_tensor_t::gemm(0, 0, *X_, *W_, Z_);
 #endif
+    }
     if (b_) {
       ll_tensor_t::add_row(1, *Z_, 1, *b_, Z_);
     }
@@ -205,6 +221,20 @@ class FullyConnectOp : public OpImpl {
       ll_tensor_t::sum_row(1, *gZ_, 1, gb_);
     }
   }
+
+ private:
+  // Quantize rows of X dynamically, then compute Z = X * W in int8.
+  void QuantizedForward() noexcept {
+    int m = X_->dim(0);
+    int k = X_->dim(1);
+    int n = qW_->dim(1);
+    const float_t* _X = X_->data();
+    for (int i = 0; i < m; ++i) {
+      Xscale_[i] = QuantizeRow(k, _X + i * k, &qX_[(size_t)i * k]);
+    }
+    QuantizedGEMM(m, n, k, qX_.data(), Xscale_.data(), qW_->data(),
+                  qW_->scale(), Z_->data());
+  }
 };
 
 GRAPH_NODE_OP_REGISTER(FullyConnect);
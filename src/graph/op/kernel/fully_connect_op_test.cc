@@ -23,4 +23,15 @@ TEST_F(FullyConnectBackwardTest, FullyConnect_b) {
   CheckOpBackward(&Z, 0);
 }
 
+class FullyConnectPredictQuantizedTest : public testing::Test {};
+
+TEST_F(FullyConnectPredictQuantizedTest, FullyConnect_b) {
+  // 40 covers both the vectorized and the remaining int8 dot products.
+  VariableNode X("X", Shape(5, 40), TENSOR_INITIALIZER_TYPE_RANDN, 0, 1);
+  VariableNode W("W", Shape(40, 7), TENSOR_INITIALIZER_TYPE_RANDN, 0, 1);
+  VariableNode b("b", Shape(1, 7), TENSOR_INITIALIZER_TYPE_RANDN, 0, 1);
+  FullyConnectNode Z("Y", &X, &W, &b);
+  CheckOpPredictQuantized(&Z, 0);
+}
+
 }  // namespace deepx_core
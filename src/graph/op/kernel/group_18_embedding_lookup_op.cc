@@ -3,6 +3,7 @@
 //
 
 #include <deepx_core/graph/op_impl.h>
+#include "embedding_lookup.h"
 
 namespace deepx_core {
 
@@ -59,104 +60,87 @@ bool Group18EmbeddingLookupInferShape(int Xrow,
   return true;
 }
 
+template <typename T, typename I>
+void Group18EmbeddingLookupPlanInit(const CSRMatrix<T, I>& X,
+                                    const std::vector<int>& Wcol,
+                                    const Group18EmbeddingLookupAux& aux,
+                                    EmbeddingLookupPlan<T, I>* plan) {
+  auto func = [&Wcol, &aux](int /*k*/, I j, int* Zoffset, int* col) {
+    int group_id = LLSparseTensor<T, I>::group_18_get_group_id(j);
+    *Zoffset = aux.GetZoffset(group_id);
+    if (*Zoffset < 0) {
+      return false;
+    }
+    *col = Wcol[group_id];
+    return true;
+  };
+  EmbeddingLookupPlanInit((int)X.col_size(), X.col_begin(), func, plan);
+}
+
 template <typename T, typename I>
 void Group18EmbeddingLookup(const CSRMatrix<T, I>& X,
                             const std::vector<const Tensor<T>*>& W,
-                            Tensor<T>* Z,
-                            const Group18EmbeddingLookupAux& aux) noexcept {
-  int n = Z->dim(1);
-  T* _Z = Z->data();
-  Z->zeros();
-  CSR_FOR_EACH_ROW(X, i) {
-    CSR_FOR_EACH_COL(X, i) {
-      I j = CSR_COL(X);
-      T Xij = CSR_VALUE(X);
-      int group_id = LLSparseTensor<T, I>::group_18_get_group_id(j);
-      int Zoffset = aux.GetZoffset(group_id);
-      if (Zoffset < 0) {
-        continue;
-      }
-
-      const auto& _W = *W[group_id];
-      int Wrow = _W.dim(0);
-      int Wcol = _W.dim(1);
-      j = j % Wrow;
-      if (Wcol == 1) {
-        _Z[Zoffset] += Xij * _W.data(j);
-      } else {
-        LLMath<T>::axpy(Wcol, Xij, _W.data() + j * Wcol, _Z + Zoffset);
-      }
+                            Tensor<T>* Z, const Group18EmbeddingLookupAux& aux,
+                            EmbeddingLookupPlan<T, I>* plan) {
+  std::vector<int> Wcol(W.size(), 0);
+  for (size_t i = 0; i < W.size(); ++i) {
+    if (W[i]) {
+      Wcol[i] = W[i]->dim(1);
     }
-    _Z += n;
   }
+  Group18EmbeddingLookupPlanInit(X, Wcol, aux, plan);
+  EmbeddingLookupResolve(
+      [](I /*j*/) {},
+      [&W](I j) -> const T* {
+        const auto& _W = *W[LLSparseTensor<T, I>::group_18_get_group_id(j)];
+        return _W.data() + (j % _W.dim(0)) * _W.dim(1);
+      },
+      plan);
+  EmbeddingLookupForward(X, *plan, Z);
 }
 
 template <typename T, typename I>
-void Group18EmbeddingLookupBackward(
-    const CSRMatrix<T, I>& X, const std::vector<const Tensor<T>*>& W,
-    const Tensor<T>& /*Z*/, const Tensor<T>& gZ,
-    std::vector<SparseRowMatrix<T, I>*>* gW,
-    const Group18EmbeddingLookupAux& aux) noexcept {
-  int n = gZ.dim(1);
-  const T* _gZ = gZ.data();
-  CSR_FOR_EACH_ROW(X, i) {
-    CSR_FOR_EACH_COL(X, i) {
-      I j = CSR_COL(X);
-      T Xij = CSR_VALUE(X);
-      int group_id = LLSparseTensor<T, I>::group_18_get_group_id(j);
-      int Zoffset = aux.GetZoffset(group_id);
-      if (Zoffset < 0) {
-        continue;
-      }
-
-      const auto& _W = *W[group_id];
-      int Wrow = _W.dim(0);
-      int Wcol = _W.dim(1);
-      j = j % Wrow;
-      auto* _gW = (*gW)[group_id];
-      if (_gW) {
-        if (Wcol == 1) {
-          _gW->get_scalar_no_init(j) += Xij * _gZ[Zoffset];
-        } else {
-          LLMath<T>::axpy(Wcol, Xij, _gZ + Zoffset, _gW->get_row_no_init(j));
+void Group18EmbeddingLookupBackward(const CSRMatrix<T, I>& X,
+                                    const std::vector<const Tensor<T>*>& W,
+                                    const Tensor<T>& /*Z*/, const Tensor<T>& gZ,
+                                    std::vector<SparseRowMatrix<T, I>*>* gW,
+                                    EmbeddingLookupPlan<T, I>* plan) {
+  EmbeddingLookupBackward(
+      X, gZ,
+      [&W, gW](I j) -> T* {
+        int group_id = LLSparseTensor<T, I>::group_18_get_group_id(j);
+        auto* _gW = (*gW)[group_id];
+        if (_gW == nullptr) {
+          return nullptr;
         }
-      }
-    }
-    _gZ += n;
-  }
+        return _gW->get_row_no_init(j % W[group_id]->dim(0));
+      },
+      plan);
 }
 
 template <typename T, typename I>
 void Group18SparseEmbeddingLookup(
     const CSRMatrix<T, I>& X,
     const std::vector<const SparseRowMatrix<T, I>*>& W, Tensor<T>* Z,
-    const Group18EmbeddingLookupAux& aux) noexcept {
-  int n = Z->dim(1);
-  T* _Z = Z->data();
-  Z->zeros();
-  CSR_FOR_EACH_ROW(X, i) {
-    CSR_FOR_EACH_COL(X, i) {
-      I j = CSR_COL(X);
-      T Xij = CSR_VALUE(X);
-      int group_id = LLSparseTensor<T, I>::group_18_get_group_id(j);
-      int Zoffset = aux.GetZoffset(group_id);
-      if (Zoffset < 0) {
-        continue;
-      }
-
-      const auto& _W = *W[group_id];
-      int Wcol = _W.col();
-      if (Wcol == 1) {
-        _Z[Zoffset] += Xij * _W.get_scalar_no_init(j);
-      } else {
-        const T* Wj = _W.get_row_no_init(j);
-        if (Wj) {
-          LLMath<T>::axpy(Wcol, Xij, Wj, _Z + Zoffset);
-        }
-      }
+    const Group18EmbeddingLookupAux& aux, EmbeddingLookupPlan<T, I>* plan) {
+  std::vector<int> Wcol(W.size(), 0);
+  for (size_t i = 0; i < W.size(); ++i) {
+    if (W[i]) {
+      Wcol[i] = W[i]->col();
     }
-    _Z += n;
   }
+  Group18EmbeddingLookupPlanInit(X, Wcol, aux, plan);
+  EmbeddingLookupResolve(
+      [&W](I j) {
+        int group_id = LLSparseTensor<T, I>::group_18_get_group_id(j);
+        W[group_id]->prefetch_row(j);
+      },
+      [&W](I j) {
+        int group_id = LLSparseTensor<T, I>::group_18_get_group_id(j);
+        return W[group_id]->get_row_no_init(j);
+      },
+      plan);
+  EmbeddingLookupForward(X, *plan, Z);
 }
 
 template <typename T, typename I>
@@ -164,32 +148,17 @@ void Group18SparseEmbeddingLookupBackward(
     const CSRMatrix<T, I>& X,
     const std::vector<const SparseRowMatrix<T, I>*>& /*W*/,
     const Tensor<T>& /*Z*/, const Tensor<T>& gZ,
-    std::vector<SparseRowMatrix<T, I>*>* gW,
-    const Group18EmbeddingLookupAux& aux) noexcept {
-  int n = gZ.dim(1);
-  const T* _gZ = gZ.data();
-  CSR_FOR_EACH_ROW(X, i) {
-    CSR_FOR_EACH_COL(X, i) {
-      I j = CSR_COL(X);
-      T Xij = CSR_VALUE(X);
-      int group_id = LLSparseTensor<T, I>::group_18_get_group_id(j);
-      int Zoffset = aux.GetZoffset(group_id);
-      if (Zoffset < 0) {
-        continue;
-      }
-
-      auto* _gW = (*gW)[group_id];
-      if (_gW) {
-        int Wcol = _gW->col();
-        if (Wcol == 1) {
-          _gW->get_scalar_no_init(j) += Xij * _gZ[Zoffset];
-        } else {
-          LLMath<T>::axpy(Wcol, Xij, _gZ + Zoffset, _gW->get_row_no_init(j));
+    std::vector<SparseRowMatrix<T, I>*>* gW, EmbeddingLookupPlan<T, I>* plan) {
+  EmbeddingLookupBackward(
+      X, gZ,
+      [gW](I j) -> T* {
+        auto* _gW = (*gW)[LLSparseTensor<T, I>::group_18_get_group_id(j)];
+        if (_gW == nullptr) {
+          return nullptr;
         }
-      }
-    }
-    _gZ += n;
-  }
+        return _gW->get_row_no_init(j);
+      },
+      plan);
 }
 
 }  // namespace
@@ -244,6 +213,7 @@ class Group18EmbeddingLookupOp : public OpImpl {
   tsr_t* gZ_ = nullptr;
   std::vector<srm_t*> gW_;  // indexed by group id
   Group18EmbeddingLookupAux aux_;
+  EmbeddingLookupPlan<float_t, int_t> plan_;
 
  public:
   DEFINE_OP_LIKE(Group18EmbeddingLookupOp);
@@ -311,10 +281,10 @@ class Group18EmbeddingLookupOp : public OpImpl {
   void Forward() override {
     switch (W_tensor_type_) {
       case TENSOR_TYPE_TSR:
-        Group18EmbeddingLookup(*X_, Wtsr_, Z_, aux_);
+        Group18EmbeddingLookup(*X_, Wtsr_, Z_, aux_, &plan_);
         break;
       case TENSOR_TYPE_SRM:
-        Group18SparseEmbeddingLookup(*X_, Wsrm_, Z_, aux_);
+        Group18SparseEmbeddingLookup(*X_, Wsrm_, Z_, aux_, &plan_);
         break;
     }
   }
@@ -323,11 +293,11 @@ class Group18EmbeddingLookupOp : public OpImpl {
     if (gZ_) {
       switch (W_tensor_type_) {
         case TENSOR_TYPE_TSR:
-          Group18EmbeddingLookupBackward(*X_, Wtsr_, *Z_, *gZ_, &gW_, aux_);
+          Group18EmbeddingLookupBackward(*X_, Wtsr_, *Z_, *gZ_, &gW_, &plan_);
           break;
         case TENSOR_TYPE_SRM:
           Group18SparseEmbeddingLookupBackward(*X_, Wsrm_, *Z_, *gZ_, &gW_,
-                                               aux_);
+                                               &plan_);
           break;
       }
     }
@@ -399,177 +369,63 @@ bool Group18EmbeddingLookup2InferShape(int Xrow, const Shape& W,
   return true;
 }
 
+template <typename T, typename I>
+void Group18EmbeddingLookup2PlanInit(const CSRMatrix<T, I>& X, int Wcol,
+                                     const Group18EmbeddingLookupAux& aux,
+                                     EmbeddingLookupPlan<T, I>* plan) {
+  auto func = [Wcol, &aux](int /*k*/, I j, int* Zoffset, int* col) {
+    *Zoffset = aux.GetZoffset(LLSparseTensor<T, I>::group_18_get_group_id(j));
+    *col = Wcol;
+    return *Zoffset >= 0;
+  };
+  EmbeddingLookupPlanInit((int)X.col_size(), X.col_begin(), func, plan);
+}
+
 template <typename T, typename I>
 void Group18EmbeddingLookup2(const CSRMatrix<T, I>& X, const Tensor<T>& W,
-                             Tensor<T>* Z,
-                             const Group18EmbeddingLookupAux& aux) noexcept {
+                             Tensor<T>* Z, const Group18EmbeddingLookupAux& aux,
+                             EmbeddingLookupPlan<T, I>* plan) {
   int Wrow = W.dim(0);
   int Wcol = W.dim(1);
-  int n = Z->dim(1);
-  T* _Z = Z->data();
-  Z->zeros();
-  if (Wcol == 1) {
-    CSR_FOR_EACH_ROW(X, i) {
-      CSR_FOR_EACH_COL(X, i) {
-        I j = CSR_COL(X);
-        T Xij = CSR_VALUE(X);
-        int group_id = LLSparseTensor<T, I>::group_18_get_group_id(j);
-        int Zoffset = aux.GetZoffset(group_id);
-        if (Zoffset < 0) {
-          continue;
-        }
-
-        j = j % Wrow;
-        _Z[Zoffset] += Xij * W.data(j);
-      }
-      _Z += n;
-    }
-  } else {
-    CSR_FOR_EACH_ROW(X, i) {
-      CSR_FOR_EACH_COL(X, i) {
-        I j = CSR_COL(X);
-        T Xij = CSR_VALUE(X);
-        int group_id = LLSparseTensor<T, I>::group_18_get_group_id(j);
-        int Zoffset = aux.GetZoffset(group_id);
-        if (Zoffset < 0) {
-          continue;
-        }
-
-        j = j % Wrow;
-        LLMath<T>::axpy(Wcol, Xij, W.data() + j * Wcol, _Z + Zoffset);
-      }
-      _Z += n;
-    }
-  }
+  Group18EmbeddingLookup2PlanInit(X, Wcol, aux, plan);
+  EmbeddingLookupResolve(
+      [](I /*j*/) {},
+      [&W, Wrow, Wcol](I j) { return W.data() + (j % Wrow) * Wcol; }, plan);
+  EmbeddingLookupForward(X, *plan, Z);
 }
 
 template <typename T, typename I>
-void Group18EmbeddingLookup2Backward(
-    const CSRMatrix<T, I>& X, const Tensor<T>& W, const Tensor<T>& /*Z*/,
-    const Tensor<T>& gZ, SparseRowMatrix<T, I>* gW,
-    const Group18EmbeddingLookupAux& aux) noexcept {
+void Group18EmbeddingLookup2Backward(const CSRMatrix<T, I>& X,
+                                     const Tensor<T>& W, const Tensor<T>& /*Z*/,
+                                     const Tensor<T>& gZ,
+                                     SparseRowMatrix<T, I>* gW,
+                                     EmbeddingLookupPlan<T, I>* plan) {
   int Wrow = W.dim(0);
-  int Wcol = W.dim(1);
-  int n = gZ.dim(1);
-  const T* _gZ = gZ.data();
-  if (Wcol == 1) {
-    CSR_FOR_EACH_ROW(X, i) {
-      CSR_FOR_EACH_COL(X, i) {
-        I j = CSR_COL(X);
-        T Xij = CSR_VALUE(X);
-        int group_id = LLSparseTensor<T, I>::group_18_get_group_id(j);
-        int Zoffset = aux.GetZoffset(group_id);
-        if (Zoffset < 0) {
-          continue;
-        }
-
-        j = j % Wrow;
-        gW->get_scalar_no_init(j) += Xij * _gZ[Zoffset];
-      }
-      _gZ += n;
-    }
-  } else {
-    CSR_FOR_EACH_ROW(X, i) {
-      CSR_FOR_EACH_COL(X, i) {
-        I j = CSR_COL(X);
-        T Xij = CSR_VALUE(X);
-        int group_id = LLSparseTensor<T, I>::group_18_get_group_id(j);
-        int Zoffset = aux.GetZoffset(group_id);
-        if (Zoffset < 0) {
-          continue;
-        }
-
-        j = j % Wrow;
-        LLMath<T>::axpy(Wcol, Xij, _gZ + Zoffset, gW->get_row_no_init(j));
-      }
-      _gZ += n;
-    }
-  }
+  EmbeddingLookupBackward(
+      X, gZ, [gW, Wrow](I j) { return gW->get_row_no_init(j % Wrow); },
+      plan);
 }
 
 template <typename T, typename I>
-void Group18SparseEmbeddingLookup2(
-    const CSRMatrix<T, I>& X, const SparseRowMatrix<T, I>& W, Tensor<T>* Z,
-    const Group18EmbeddingLookupAux& aux) noexcept {
-  int Wcol = W.col();
-  int n = Z->dim(1);
-  T* _Z = Z->data();
-  Z->zeros();
-  if (Wcol == 1) {
-    CSR_FOR_EACH_ROW(X, i) {
-      CSR_FOR_EACH_COL(X, i) {
-        I j = CSR_COL(X);
-        T Xij = CSR_VALUE(X);
-        int group_id = LLSparseTensor<T, I>::group_18_get_group_id(j);
-        int Zoffset = aux.GetZoffset(group_id);
-        if (Zoffset < 0) {
-          continue;
-        }
-
-        _Z[Zoffset] += Xij * W.get_scalar_no_init(j);
-      }
-      _Z += n;
-    }
-  } else {
-    CSR_FOR_EACH_ROW(X, i) {
-      CSR_FOR_EACH_COL(X, i) {
-        I j = CSR_COL(X);
-        T Xij = CSR_VALUE(X);
-        int group_id = LLSparseTensor<T, I>::group_18_get_group_id(j);
-        int Zoffset = aux.GetZoffset(group_id);
-        if (Zoffset < 0) {
-          continue;
-        }
-
-        const T* Wj = W.get_row_no_init(j);
-        if (Wj) {
-          LLMath<T>::axpy(Wcol, Xij, Wj, _Z + Zoffset);
-        }
-      }
-      _Z += n;
-    }
-  }
+void Group18SparseEmbeddingLookup2(const CSRMatrix<T, I>& X,
+                                   const SparseRowMatrix<T, I>& W, Tensor<T>* Z,
+                                   const Group18EmbeddingLookupAux& aux,
+                                   EmbeddingLookupPlan<T, I>* plan) {
+  Group18EmbeddingLookup2PlanInit(X, W.col(), aux, plan);
+  EmbeddingLookupResolve([&W](I j) { W.prefetch_row(j); },
+                         [&W](I j) { return W.get_row_no_init(j); }, plan);
+  EmbeddingLookupForward(X, *plan, Z);
 }
 
 template <typename T, typename I>
-void Group18SparseEmbeddingLookup2Backward(
-    const CSRMatrix<T, I>& X, const SparseRowMatrix<T, I>& /*W*/,
-    const Tensor<T>& /*Z*/, const Tensor<T>& gZ, SparseRowMatrix<T, I>* gW,
-    const Group18EmbeddingLookupAux& aux) noexcept {
-  int Wcol = gW->col();
-  int n = gZ.dim(1);
-  const T* _gZ = gZ.data();
-  if (Wcol == 1) {
-    CSR_FOR_EACH_ROW(X, i) {
-      CSR_FOR_EACH_COL(X, i) {
-        I j = CSR_COL(X);
-        T Xij = CSR_VALUE(X);
-        int group_id = LLSparseTensor<T, I>::group_18_get_group_id(j);
-        int Zoffset = aux.GetZoffset(group_id);
-        if (Zoffset < 0) {
-          continue;
-        }
-
-        gW->get_scalar_no_init(j) += Xij * _gZ[Zoffset];
-      }
-      _gZ += n;
-    }
-  } else {
-    CSR_FOR_EACH_ROW(X, i) {
-      CSR_FOR_EACH_COL(X, i) {
-        I j = CSR_COL(X);
-        T Xij = CSR_VALUE(X);
-        int group_id = LLSparseTensor<T, I>::group_18_get_group_id(j);
-        int Zoffset = aux.GetZoffset(group_id);
-        if (Zoffset < 0) {
-          continue;
-        }
-
-        LLMath<T>::axpy(Wcol, Xij, _gZ + Zoffset, gW->get_row_no_init(j));
-      }
-      _gZ += n;
-    }
-  }
+void Group18SparseEmbeddingLookup2Backward(const CSRMatrix<T, I>& X,
+                                           const SparseRowMatrix<T, I>& /*W*/,
+                                           const Tensor<T>& /*Z*/,
+                                           const Tensor<T>& gZ,
+                                           SparseRowMatrix<T, I>* gW,
+                                           EmbeddingLookupPlan<T, I>* plan) {
+  EmbeddingLookupBackward(
+      X, gZ, [gW](I j) { return gW->get_row_no_init(j); }, plan);
 }
 
 }  // namespace
@@ -606,6 +462,7 @@ class Group18EmbeddingLookup2Op : public OpImpl {
   tsr_t* gZ_ = nullptr;
   srm_t* gW_ = nullptr;
   Group18EmbeddingLookupAux aux_;
+  EmbeddingLookupPlan<float_t, int_t> plan_;
 
  public:
   DEFINE_OP_LIKE(Group18EmbeddingLookup2Op);
@@ -651,10 +508,10 @@ class Group18EmbeddingLookup2Op : public OpImpl {
   void Forward() override {
     switch (W_tensor_type_) {
       case TENSOR_TYPE_TSR:
-        Group18EmbeddingLookup2(*X_, *Wtsr_, Z_, aux_);
+        Group18EmbeddingLookup2(*X_, *Wtsr_, Z_, aux_, &plan_);
         break;
       case TENSOR_TYPE_SRM:
-        Group18SparseEmbeddingLookup2(*X_, *Wsrm_, Z_, aux_);
+        Group18SparseEmbeddingLookup2(*X_, *Wsrm_, Z_, aux_, &plan_);
         break;
     }
   }
@@ -663,11 +520,11 @@ class Group18EmbeddingLookup2Op : public OpImpl {
     if (gW_) {
       switch (W_tensor_type_) {
         case TENSOR_TYPE_TSR:
-          Group18EmbeddingLookup2Backward(*X_, *Wtsr_, *Z_, *gZ_, gW_, aux_);
+          Group18EmbeddingLookup2Backward(*X_, *Wtsr_, *Z_, *gZ_, gW_, &plan_);
           break;
         case TENSOR_TYPE_SRM:
           Group18SparseEmbeddingLookup2Backward(*X_, *Wsrm_, *Z_, *gZ_, gW_,
-                                                aux_);
+                                                &plan_);
           break;
       }
     }
@@ -3,6 +3,7 @@
 //
 
 #include <deepx_core/graph/op_impl.h>
+#include "embedding_lookup.h"
 
 namespace deepx_core {
 
@@ -61,35 +62,43 @@ bool GroupEmbeddingLookupInferShape(int Xrow,
   return true;
 }
 
+template <typename T, typename I>
+void GroupEmbeddingLookupPlanInit(const CSRMatrix<T, I>& X,
+                                  const std::vector<int>& Wcol,
+                                  const GroupEmbeddingLookupAux& aux,
+                                  EmbeddingLookupPlan<T, I>* plan) {
+  auto func = [&Wcol, &aux](int /*k*/, I j, int* Zoffset, int* col) {
+    uint16_t group_id = LLSparseTensor<T, I>::get_group_id(j);
+    *Zoffset = aux.GetZoffset(group_id);
+    if (*Zoffset < 0) {
+      return false;
+    }
+    *col = Wcol[group_id];
+    return true;
+  };
+  EmbeddingLookupPlanInit((int)X.col_size(), X.col_begin(), func, plan);
+}
+
 template <typename T, typename I>
 void GroupEmbeddingLookup(const CSRMatrix<T, I>& X,
                           const std::vector<const Tensor<T>*>& W, Tensor<T>* Z,
-                          const GroupEmbeddingLookupAux& aux) noexcept {
-  int n = Z->dim(1);
-  T* _Z = Z->data();
-  Z->zeros();
-  CSR_FOR_EACH_ROW(X, i) {
-    CSR_FOR_EACH_COL(X, i) {
-      I j = CSR_COL(X);
-      T Xij = CSR_VALUE(X);
-      uint16_t group_id = LLSparseTensor<T, I>::get_group_id(j);
-      int Zoffset = aux.GetZoffset(group_id);
-      if (Zoffset < 0) {
-        continue;
-      }
-
-      const auto& _W = *W[group_id];
-      int Wrow = _W.dim(0);
-      int Wcol = _W.dim(1);
-      j = j % Wrow;
-      if (Wcol == 1) {
-        _Z[Zoffset] += Xij * _W.data(j);
-      } else {
-        LLMath<T>::axpy(Wcol, Xij, _W.data() + j * Wcol, _Z + Zoffset);
-      }
+                          const GroupEmbeddingLookupAux& aux,
+                          EmbeddingLookupPlan<T, I>* plan) {
+  std::vector<int> Wcol(W.size(), 0);
+  for (size_t i = 0; i < W.size(); ++i) {
+    if (W[i]) {
+      Wcol[i] = W[i]->dim(1);
     }
-    _Z += n;
   }
+  GroupEmbeddingLookupPlanInit(X, Wcol, aux, plan);
+  EmbeddingLookupResolve(
+      [](I /*j*/) {},
+      [&W](I j) -> const T* {
+        const auto& _W = *W[LLSparseTensor<T, I>::get_group_id(j)];
+        return _W.data() + (j % _W.dim(0)) * _W.dim(1);
+      },
+      plan);
+  EmbeddingLookupForward(X, *plan, Z);
 }
 
 template <typename T, typename I>
@@ -97,67 +106,43 @@ void GroupEmbeddingLookupBackward(const CSRMatrix<T, I>& X,
                                   const std::vector<const Tensor<T>*>& W,
                                   const Tensor<T>& /*Z*/, const Tensor<T>& gZ,
                                   std::vector<SparseRowMatrix<T, I>*>* gW,
-                                  const GroupEmbeddingLookupAux& aux) noexcept {
-  int n = gZ.dim(1);
-  const T* _gZ = gZ.data();
-  CSR_FOR_EACH_ROW(X, i) {
-    CSR_FOR_EACH_COL(X, i) {
-      I j = CSR_COL(X);
-      T Xij = CSR_VALUE(X);
-      uint16_t group_id = LLSparseTensor<T, I>::get_group_id(j);
-      int Zoffset = aux.GetZoffset(group_id);
-      if (Zoffset < 0) {
-        continue;
-      }
-
-      const auto& _W = *W[group_id];
-      int Wrow = _W.dim(0);
-      int Wcol = _W.dim(1);
-      j = j % Wrow;
-      auto* _gW = (*gW)[group_id];
-      if (_gW) {
-        if (Wcol == 1) {
-          _gW->get_scalar_no_init(j) += Xij * _gZ[Zoffset];
-        } else {
-          LLMath<T>::axpy(Wcol, Xij, _gZ + Zoffset, _gW->get_row_no_init(j));
+                                  EmbeddingLookupPlan<T, I>* plan) {
+  EmbeddingLookupBackward(
+      X, gZ,
+      [&W, gW](I j) -> T* {
+        uint16_t group_id = LLSparseTensor<T, I>::get_group_id(j);
+        auto* _gW = (*gW)[group_id];
+        if (_gW == nullptr) {
+          return nullptr;
         }
-      }
-    }
-    _gZ += n;
-  }
+        return _gW->get_row_no_init(j % W[group_id]->dim(0));
+      },
+      plan);
 }
 
 template <typename T, typename I>
 void GroupSparseEmbeddingLookup(
     const CSRMatrix<T, I>& X,
     const std::vector<const SparseRowMatrix<T, I>*>& W, Tensor<T>* Z,
-    const GroupEmbeddingLookupAux& aux) noexcept {
-  int n = Z->dim(1);
-  T* _Z = Z->data();
-  Z->zeros();
-  CSR_FOR_EACH_ROW(X, i) {
-    CSR_FOR_EACH_COL(X, i) {
-      I j = CSR_COL(X);
-      T Xij = CSR_VALUE(X);
-      uint16_t group_id = LLSparseTensor<T, I>::get_group_id(j);
-      int Zoffset = aux.GetZoffset(group_id);
-      if (Zoffset < 0) {
-        continue;
-      }
-
-      const auto& _W = *W[group_id];
-      int Wcol = _W.col();
-      if (Wcol == 1) {
-        _Z[Zoffset] += Xij * _W.get_scalar_no_init(j);
-      } else {
-        const T* Wj = _W.get_row_no_init(j);
-        if (Wj) {
-          LLMath<T>::axpy(Wcol, Xij, Wj, _Z + Zoffset);
-        }
-      }
+    const GroupEmbeddingLookupAux& aux, EmbeddingLookupPlan<T, I>* plan) {
+  std::vector<int> Wcol(W.size(), 0);
+  for (size_t i = 0; i < W.size(); ++i) {
+    if (W[i]) {
+      Wcol[i] = W[i]->col();
     }
-    _Z += n;
   }
+  GroupEmbeddingLookupPlanInit(X, Wcol, aux, plan);
+  EmbeddingLookupResolve(
+      [&W](I j) {
+        uint16_t group_id = LLSparseTensor<T, I>::get_group_id(j);
+        W[group_id]->prefetch_row(j);
+      },
+      [&W](I j) {
+        uint16_t group_id = LLSparseTensor<T, I>::get_group_id(j);
+        return W[group_id]->get_row_no_init(j);
+      },
+      plan);
+  EmbeddingLookupForward(X, *plan, Z);
 }
 
 template <typename T, typename I>
@@ -165,32 +150,60 @@ void GroupSparseEmbeddingLookupBackward(
     const CSRMatrix<T, I>& X,
     const std::vector<const SparseRowMatrix<T, I>*>& /*W*/,
     const Tensor<T>& /*Z*/, const Tensor<T>& gZ,
-    std::vector<SparseRowMatrix<T, I>*>* gW,
-    const GroupEmbeddingLookupAux& aux) noexcept {
-  int n = gZ.dim(1);
-  const T* _gZ = gZ.data();
-  CSR_FOR_EACH_ROW(X, i) {
-    CSR_FOR_EACH_COL(X, i) {
-      I j = CSR_COL(X);
-      T Xij = CSR_VALUE(X);
-      uint16_t group_id = LLSparseTensor<T, I>::get_group_id(j);
-      int Zoffset = aux.GetZoffset(group_id);
-      if (Zoffset < 0) {
-        continue;
-      }
-
-      auto* _gW = (*gW)[group_id];
-      if (_gW) {
-        int Wcol = _gW->col();
-        if (Wcol == 1) {
-          _gW->get_scalar_no_init(j) += Xij * _gZ[Zoffset];
-        } else {
-          LLMath<T>::axpy(Wcol, Xij, _gZ + Zoffset, _gW->get_row_no_init(j));
+    std::vector<SparseRowMatrix<T, I>*>* gW, EmbeddingLookupPlan<T, I>* plan) {
+  EmbeddingLookupBackward(
+      X, gZ,
+      [gW](I j) -> T* {
+        auto* _gW = (*gW)[LLSparseTensor<T, I>::get_group_id(j)];
+        if (_gW == nullptr) {
+          return nullptr;
         }
-      }
+        return _gW->get_row_no_init(j);
+      },
+      plan);
+}
+
+template <typename T, typename I>
+void GroupQuantizedEmbeddingLookup(
+    const CSRMatrix<T, I>& X,
+    const std::vector<const SparseRowMatrix<T, I>*>& W,
+    const std::vector<const QuantizedSparseRowMatrix<T, I>*>& qW,
+    Tensor<T>* Z, const GroupEmbeddingLookupAux& aux,
+    EmbeddingLookupPlan<T, I>* plan) {
+  std::vector<int> Wcol(W.size(), 0);
+  for (size_t i = 0; i < W.size(); ++i) {
+    if (W[i]) {
+      Wcol[i] = W[i]->col();
+    } else if (qW[i]) {
+      Wcol[i] = qW[i]->col();
     }
-    _gZ += n;
   }
+  GroupEmbeddingLookupPlanInit(X, Wcol, aux, plan);
+  EmbeddingLookupResolveQuantized(
+      [&W, &qW](I j) {
+        uint16_t group_id = LLSparseTensor<T, I>::get_group_id(j);
+        if (qW[group_id]) {
+          qW[group_id]->prefetch_row(j);
+        } else {
+          W[group_id]->prefetch_row(j);
+        }
+      },
+      [&W, &qW](I j, T* buf) -> const T* {
+        uint16_t group_id = LLSparseTensor<T, I>::get_group_id(j);
+        const auto* _qW = qW[group_id];
+        if (_qW == nullptr) {
+          return W[group_id]->get_row_no_init(j);
+        }
+        T scale;
+        const int8_t* Qj = _qW->get_row_no_init(j, &scale);
+        if (Qj == nullptr) {
+          return nullptr;
+        }
+        DequantizeRow(_qW->col(), Qj, scale, buf);
+        return buf;
+      },
+      plan);
+  EmbeddingLookupForward(X, *plan, Z);
 }
 
 }  // namespace
@@ -241,10 +254,13 @@ class GroupEmbeddingLookupOp : public OpImpl {
   std::vector<const Shape*> Wshape_;      // indexed by i
   std::vector<const tsr_t*> Wtsr_;        // indexed by group id
   std::vector<const srm_t*> Wsrm_;        // indexed by group id
+  std::vector<const qsrm_t*> Wqsrm_;      // indexed by group id
+  int quantized_ = 0;
   tsr_t* Z_ = nullptr;
   tsr_t* gZ_ = nullptr;
   std::vector<srm_t*> gW_;  // indexed by group id
   GroupEmbeddingLookupAux aux_;
+  EmbeddingLookupPlan<float_t, int_t> plan_;
 
  public:
   DEFINE_OP_LIKE(GroupEmbeddingLookupOp);
@@ -267,6 +283,8 @@ class GroupEmbeddingLookupOp : public OpImpl {
     Wshape_.assign(Wsize_, nullptr);
     Wtsr_.clear();
     Wsrm_.clear();
+    Wqsrm_.clear();
+    quantized_ = 0;
     switch (W_tensor_type_) {
       case TENSOR_TYPE_TSR:
         Wtsr_.assign(max_group_id_, nullptr);
@@ -278,10 +296,18 @@ class GroupEmbeddingLookupOp : public OpImpl {
         break;
       case TENSOR_TYPE_SRM:
         Wsrm_.assign(max_group_id_, nullptr);
+        Wqsrm_.assign(max_group_id_, nullptr);
         for (int i = 0; i < Wsize_; ++i) {
-          srm_t* W = GetPtrSRM(Wnode2_[i]);
-          Wsrm_[group_ids_[i]] = W;
-          Wshape_[i] = &W->shape();
+          const qsrm_t* qW = GetPtrQSRM(Wnode2_[i]);
+          if (qW) {
+            Wqsrm_[group_ids_[i]] = qW;
+            Wshape_[i] = &qW->shape();
+            quantized_ = 1;
+          } else {
+            srm_t* W = GetPtrSRM(Wnode2_[i]);
+            Wsrm_[group_ids_[i]] = W;
+            Wshape_[i] = &W->shape();
+          }
         }
         break;
     }
@@ -291,6 +317,8 @@ class GroupEmbeddingLookupOp : public OpImpl {
   }
 
   void InitBackward() override {
+    // quantized params are for inference only
+    DXCHECK_THROW(!quantized_);
     gZ_ = GetGradPtrTSR(node_);
     gW_.assign(max_group_id_, nullptr);
     switch (W_tensor_type_) {
@@ -312,10 +340,14 @@ class GroupEmbeddingLookupOp : public OpImpl {
   void Forward() override {
     switch (W_tensor_type_) {
       case TENSOR_TYPE_TSR:
-        GroupEmbeddingLookup(*X_, Wtsr_, Z_, aux_);
+        GroupEmbeddingLookup(*X_, Wtsr_, Z_, aux_, &plan_);
         break;
       case TENSOR_TYPE_SRM:
-        GroupSparseEmbeddingLookup(*X_, Wsrm_, Z_, aux_);
+        if (quantized_) {
+          GroupQuantizedEmbeddingLookup(*X_, Wsrm_, Wqsrm_, Z_, aux_, &plan_);
+        } else {
+          GroupSparseEmbeddingLookup(*X_, Wsrm_, Z_, aux_, &plan_);
+        }
         break;
     }
   }
@@ -324,10 +356,11 @@ class GroupEmbeddingLookupOp : public OpImpl {
     if (gZ_) {
       switch (W_tensor_type_) {
         case TENSOR_TYPE_TSR:
-          GroupEmbeddingLookupBackward(*X_, Wtsr_, *Z_, *gZ_, &gW_, aux_);
+          GroupEmbeddingLookupBackward(*X_, Wtsr_, *Z_, *gZ_, &gW_, &plan_);
           break;
         case TENSOR_TYPE_SRM:
-          GroupSparseEmbeddingLookupBackward(*X_, Wsrm_, *Z_, *gZ_, &gW_, aux_);
+          GroupSparseEmbeddingLookupBackward(*X_, Wsrm_, *Z_, *gZ_, &gW_,
+                                             &plan_);
           break;
       }
     }
@@ -400,177 +433,84 @@ bool GroupEmbeddingLookup2InferShape(int Xrow, const Shape& W,
   return true;
 }
 
+template <typename T, typename I>
+void GroupEmbeddingLookup2PlanInit(const CSRMatrix<T, I>& X, int Wcol,
+                                   const GroupEmbeddingLookupAux& aux,
+                                   EmbeddingLookupPlan<T, I>* plan) {
+  auto func = [Wcol, &aux](int /*k*/, I j, int* Zoffset, int* col) {
+    *Zoffset = aux.GetZoffset(LLSparseTensor<T, I>::get_group_id(j));
+    *col = Wcol;
+    return *Zoffset >= 0;
+  };
+  EmbeddingLookupPlanInit((int)X.col_size(), X.col_begin(), func, plan);
+}
+
 template <typename T, typename I>
 void GroupEmbeddingLookup2(const CSRMatrix<T, I>& X, const Tensor<T>& W,
-                           Tensor<T>* Z,
-                           const GroupEmbeddingLookupAux& aux) noexcept {
+                           Tensor<T>* Z, const GroupEmbeddingLookupAux& aux,
+                           EmbeddingLookupPlan<T, I>* plan) {
   int Wrow = W.dim(0);
   int Wcol = W.dim(1);
-  int n = Z->dim(1);
-  T* _Z = Z->data();
-  Z->zeros();
-  if (Wcol == 1) {
-    CSR_FOR_EACH_ROW(X, i) {
-      CSR_FOR_EACH_COL(X, i) {
-        I j = CSR_COL(X);
-        T Xij = CSR_VALUE(X);
-        uint16_t group_id = LLSparseTensor<T, I>::get_group_id(j);
-        int Zoffset = aux.GetZoffset(group_id);
-        if (Zoffset < 0) {
-          continue;
-        }
-
-        j = j % Wrow;
-        _Z[Zoffset] += Xij * W.data(j);
-      }
-      _Z += n;
-    }
-  } else {
-    CSR_FOR_EACH_ROW(X, i) {
-      CSR_FOR_EACH_COL(X, i) {
-        I j = CSR_COL(X);
-        T Xij = CSR_VALUE(X);
-        uint16_t group_id = LLSparseTensor<T, I>::get_group_id(j);
-        int Zoffset = aux.GetZoffset(group_id);
-        if (Zoffset < 0) {
-          continue;
-        }
-
-        j = j % Wrow;
-        LLMath<T>::axpy(Wcol, Xij, W.data() + j * Wcol, _Z + Zoffset);
-      }
-      _Z += n;
-    }
-  }
+  GroupEmbeddingLookup2PlanInit(X, Wcol, aux, plan);
+  EmbeddingLookupResolve(
+      [](I /*j*/) {},
+      [&W, Wrow, Wcol](I j) { return W.data() + (j % Wrow) * Wcol; }, plan);
+  EmbeddingLookupForward(X, *plan, Z);
 }
 
 template <typename T, typename I>
-void GroupEmbeddingLookup2Backward(
-    const CSRMatrix<T, I>& X, const Tensor<T>& W, const Tensor<T>& /*Z*/,
-    const Tensor<T>& gZ, SparseRowMatrix<T, I>* gW,
-    const GroupEmbeddingLookupAux& aux) noexcept {
+void GroupEmbeddingLookup2Backward(const CSRMatrix<T, I>& X, const Tensor<T>& W,
+                                   const Tensor<T>& /*Z*/, const Tensor<T>& gZ,
+                                   SparseRowMatrix<T, I>* gW,
+                                   EmbeddingLookupPlan<T, I>* plan) {
   int Wrow = W.dim(0);
-  int Wcol = W.dim(1);
-  int n = gZ.dim(1);
-  const T* _gZ = gZ.data();
-  if (Wcol == 1) {
-    CSR_FOR_EACH_ROW(X, i) {
-      CSR_FOR_EACH_COL(X, i) {
-        I j = CSR_COL(X);
-        T Xij = CSR_VALUE(X);
-        uint16_t group_id = LLSparseTensor<T, I>::get_group_id(j);
-        int Zoffset = aux.GetZoffset(group_id);
-        if (Zoffset < 0) {
-          continue;
-        }
-
-        j = j % Wrow;
-        gW->get_scalar_no_init(j) += Xij * _gZ[Zoffset];
-      }
-      _gZ += n;
-    }
-  } else {
-    CSR_FOR_EACH_ROW(X, i) {
-      CSR_FOR_EACH_COL(X, i) {
-        I j = CSR_COL(X);
-        T Xij = CSR_VALUE(X);
-        uint16_t group_id = LLSparseTensor<T, I>::get_group_id(j);
-        int Zoffset = aux.GetZoffset(group_id);
-        if (Zoffset < 0) {
-          continue;
-        }
-
-        j = j % Wrow;
-        LLMath<T>::axpy(Wcol, Xij, _gZ + Zoffset, gW->get_row_no_init(j));
-      }
-      _gZ += n;
-    }
-  }
+  EmbeddingLookupBackward(
+      X, gZ, [gW, Wrow](I j) { return gW->get_row_no_init(j % Wrow); },
+      plan);
 }
 
 template <typename T, typename I>
 void GroupSparseEmbeddingLookup2(const CSRMatrix<T, I>& X,
                                  const SparseRowMatrix<T, I>& W, Tensor<T>* Z,
-                                 const GroupEmbeddingLookupAux& aux) noexcept {
-  int Wcol = W.col();
-  int n = Z->dim(1);
-  T* _Z = Z->data();
-  Z->zeros();
-  if (Wcol == 1) {
-    CSR_FOR_EACH_ROW(X, i) {
-      CSR_FOR_EACH_COL(X, i) {
-        I j = CSR_COL(X);
-        T Xij = CSR_VALUE(X);
-        uint16_t group_id = LLSparseTensor<T, I>::get_group_id(j);
-        int Zoffset = aux.GetZoffset(group_id);
-        if (Zoffset < 0) {
-          continue;
-        }
-
-        _Z[Zoffset] += Xij * W.get_scalar_no_init(j);
-      }
-      _Z += n;
-    }
-  } else {
-    CSR_FOR_EACH_ROW(X, i) {
-      CSR_FOR_EACH_COL(X, i) {
-        I j = CSR_COL(X);
-        T Xij = CSR_VALUE(X);
-        uint16_t group_id = LLSparseTensor<T, I>::get_group_id(j);
-        int Zoffset = aux.GetZoffset(group_id);
-        if (Zoffset < 0) {
-          continue;
-        }
-
-        const T* Wj = W.get_row_no_init(j);
-        if (Wj) {
-          LLMath<T>::axpy(Wcol, Xij, Wj, _Z + Zoffset);
-        }
-      }
-      _Z += n;
-    }
-  }
+                                 const GroupEmbeddingLookupAux& aux,
+                                 EmbeddingLookupPlan<T, I>* plan) {
+  GroupEmbeddingLookup2PlanInit(X, W.col(), aux, plan);
+  EmbeddingLookupResolve([&W](I j) { W.prefetch_row(j); },
+                         [&W](I j) { return W.get_row_no_init(j); }, plan);
+  EmbeddingLookupForward(X, *plan, Z);
 }
 
 template <typename T, typename I>
-void GroupSparseEmbeddingLookup2Backward(
-    const CSRMatrix<T, I>& X, const SparseRowMatrix<T, I>& /*W*/,
-    const Tensor<T>& /*Z*/, const Tensor<T>& gZ, SparseRowMatrix<T, I>* gW,
-    const GroupEmbeddingLookupAux& aux) noexcept {
-  int Wcol = gW->col();
-  int n = gZ.dim(1);
-  const T* _gZ = gZ.data();
-  if (Wcol == 1) {
-    CSR_FOR_EACH_ROW(X, i) {
-      CSR_FOR_EACH_COL(X, i) {
-        I j = CSR_COL(X);
-        T Xij = CSR_VALUE(X);
-        uint16_t group_id = LLSparseTensor<T, I>::get_group_id(j);
-        int Zoffset = aux.GetZoffset(group_id);
-        if (Zoffset < 0) {
-          continue;
-        }
+void GroupSparseEmbeddingLookup2Backward(const CSRMatrix<T, I>& X,
+                                         const SparseRowMatrix<T, I>& /*W*/,
+                                         const Tensor<T>& /*Z*/,
+                                         const Tensor<T>& gZ,
+                                         SparseRowMatrix<T, I>* gW,
+                                         EmbeddingLookupPlan<T, I>* plan) {
+  EmbeddingLookupBackward(
+      X, gZ, [gW](I j) { return gW->get_row_no_init(j); }, plan);
+}
 
-        gW->get_scalar_no_init(j) += Xij * _gZ[Zoffset];
-      }
-      _gZ += n;
-    }
-  } else {
-    CSR_FOR_EACH_ROW(X, i) {
-      CSR_FOR_EACH_COL(X, i) {
-        I j = CSR_COL(X);
-        T Xij = CSR_VALUE(X);
-        uint16_t group_id = LLSparseTensor<T, I>::get_group_id(j);
-        int Zoffset = aux.GetZoffset(group_id);
-        if (Zoffset < 0) {
-          continue;
+template <typename T, typename I>
+void GroupQuantizedEmbeddingLookup2(const CSRMatrix<T, I>& X,
+                                    const QuantizedSparseRowMatrix<T, I>& W,
+                                    Tensor<T>* Z,
+                                    const GroupEmbeddingLookupAux& aux,
+                                    EmbeddingLookupPlan<T, I>* plan) {
+  GroupEmbeddingLookup2PlanInit(X, W.col(), aux, plan);
+  EmbeddingLookupResolveQuantized(
+      [&W](I j) { W.prefetch_row(j); },
+      [&W](I j, T* buf) -> const T* {
+        T scale;
+        const int8_t* Qj = W.get_row_no_init(j, &scale);
+        if (Qj == nullptr) {
+          return nullptr;
         }
-
-        LLMath<T>::axpy(Wcol, Xij, _gZ + Zoffset, gW->get_row_no_init(j));
-      }
-      _gZ += n;
-    }
-  }
+        DequantizeRow(W.col(), Qj, scale, buf);
+        return buf;
+      },
+      plan);
+  EmbeddingLookupForward(X, *plan, Z);
 }
 
 }  // namespace
@@ -604,10 +544,12 @@ class GroupEmbeddingLookup2Op : public OpImpl {
   const csr_t* X_ = nullptr;
   const tsr_t* Wtsr_ = nullptr;
   const srm_t* Wsrm_ = nullptr;
+  const qsrm_t* Wqsrm_ = nullptr;
   tsr_t* Z_ = nullptr;
   tsr_t* gZ_ = nullptr;
   srm_t* gW_ = nullptr;
   GroupEmbeddingLookupAux aux_;
+  EmbeddingLookupPlan<float_t, int_t> plan_;
 
  public:
   DEFINE_OP_LIKE(GroupEmbeddingLookup2Op);
@@ -623,6 +565,7 @@ class GroupEmbeddingLookup2Op : public OpImpl {
     X_ = GetPtrCSR(Xnode_);
     Wtsr_ = nullptr;
     Wsrm_ = nullptr;
+    Wqsrm_ = nullptr;
     switch (W_tensor_type_) {
       case TENSOR_TYPE_TSR:
         Wtsr_ = GetPtrTSR(Wnode_);
@@ -630,15 +573,23 @@ class GroupEmbeddingLookup2Op : public OpImpl {
                                                    group_ids, &aux_));
         break;
       case TENSOR_TYPE_SRM:
-        Wsrm_ = GetPtrSRM(Wnode_);
-        DXCHECK_THROW(GroupEmbeddingLookup2Prepare(X_->row(), Wsrm_->shape(),
-                                                   group_ids, &aux_));
+        Wqsrm_ = GetPtrQSRM(Wnode_);
+        if (Wqsrm_) {
+          DXCHECK_THROW(GroupEmbeddingLookup2Prepare(
+              X_->row(), Wqsrm_->shape(), group_ids, &aux_));
+        } else {
+          Wsrm_ = GetPtrSRM(Wnode_);
+          DXCHECK_THROW(GroupEmbeddingLookup2Prepare(
+              X_->row(), Wsrm_->shape(), group_ids, &aux_));
+        }
         break;
     }
     Z_ = InitHiddenTSR(node_, aux_.Z);
   }
 
   void InitBackward() override {
+    // quantized params are for inference only
+    DXCHECK_THROW(Wqsrm_ == nullptr);
     gZ_ = GetGradPtrTSR(node_);
     switch (W_tensor_type_) {
       case TENSOR_TYPE_TSR:
@@ -653,10 +604,14 @@ class GroupEmbeddingLookup2Op : public OpImpl {
   void Forward() override {
     switch (W_tensor_type_) {
       case TENSOR_TYPE_TSR:
-        GroupEmbeddingLookup2(*X_, *Wtsr_, Z_, aux_);
+        GroupEmbeddingLookup2(*X_, *Wtsr_, Z_, aux_, &plan_);
         break;
       case TENSOR_TYPE_SRM:
-        GroupSparseEmbeddingLookup2(*X_, *Wsrm_, Z_, aux_);
+        if (Wqsrm_) {
+          GroupQuantizedEmbeddingLookup2(*X_, *Wqsrm_, Z_, aux_, &plan_);
+        } else {
+          GroupSparseEmbeddingLookup2(*X_, *Wsrm_, Z_, aux_, &plan_);
+        }
         break;
     }
   }
@@ -665,11 +620,11 @@ class GroupEmbeddingLookup2Op : public OpImpl {
     if (gW_) {
       switch (W_tensor_type_) {
         case TENSOR_TYPE_TSR:
-          GroupEmbeddingLookup2Backward(*X_, *Wtsr_, *Z_, *gZ_, gW_, aux_);
+          GroupEmbeddingLookup2Backward(*X_, *Wtsr_, *Z_, *gZ_, gW_, &plan_);
           break;
         case TENSOR_TYPE_SRM:
           GroupSparseEmbeddingLookup2Backward(*X_, *Wsrm_, *Z_, *gZ_, gW_,
-                                              aux_);
+                                              &plan_);
           break;
       }
     }
@@ -74,6 +74,37 @@ TEST_F(GroupEmbeddingLookupBackwardTest, GroupEmbeddingLookup_SRM) {
   CheckOpBackward(&Z, 0, nullptr, post_param_initializer, inst_initializer);
 }
 
+class GroupEmbeddingLookupPredictQuantizedTest
+    : public GroupEmbeddingLookupBaseTest {};
+
+TEST_F(GroupEmbeddingLookupPredictQuantizedTest, GroupEmbeddingLookup_SRM) {
+  InstanceNode X("X", Shape(-1, 0), TENSOR_TYPE_CSR);
+  // Only W3 is quantized, W1 and W2 are too narrow.
+  VariableNode W1("W1", Shape(10, 1), TENSOR_TYPE_SRM,
+                  TENSOR_INITIALIZER_TYPE_RANDN, 0, 1);
+  VariableNode W2("W2", Shape(10, 2), TENSOR_TYPE_SRM,
+                  TENSOR_INITIALIZER_TYPE_RANDN, 0, 1);
+  VariableNode W3("W3", Shape(10, 8), TENSOR_TYPE_SRM,
+                  TENSOR_INITIALIZER_TYPE_RANDN, 0, 1);
+  GroupEmbeddingLookupNode Z("Z", &X, {&W1, &W2, &W3}, GROUP_IDS);
+  auto post_param_initializer = [this](std::default_random_engine& engine,
+                                       TensorMap* param) {
+    auto& W1 = param->get<srm_t>("W1");
+    auto& W2 = param->get<srm_t>("W2");
+    auto& W3 = param->get<srm_t>("W3");
+    for (size_t i = 0; i < X_.col_size(); ++i) {
+      W1.get_row(engine, X_.col(i));
+      W2.get_row(engine, X_.col(i));
+      W3.get_row(engine, X_.col(i));
+    }
+  };
+  auto inst_initializer = [this](Instance* inst) {
+    inst->insert<csr_t>("X") = X_;
+  };
+  CheckOpPredictQuantized(&Z, 0, nullptr, post_param_initializer,
+                          inst_initializer);
+}
+
 /************************************************************************/
 /* GroupEmbeddingLookup2 */
 /************************************************************************/
@@ -124,4 +155,27 @@ TEST_F(GroupEmbeddingLookup2BackwardTest, GroupEmbeddingLookup2_SRM_Wcol4) {
   TestSRM(Shape(0, 4));
 }
 
+class GroupEmbeddingLookup2PredictQuantizedTest
+    : public GroupEmbeddingLookupBaseTest {};
+
+TEST_F(GroupEmbeddingLookup2PredictQuantizedTest,
+       GroupEmbeddingLookup2_SRM_Wcol8) {
+  InstanceNode X("X", Shape(-1, 0), TENSOR_TYPE_CSR);
+  VariableNode W("W", Shape(0, 8), TENSOR_TYPE_SRM,
+                 TENSOR_INITIALIZER_TYPE_RANDN, 0, 1);
+  GroupEmbeddingLookup2Node Z("Z", &X, &W, GROUP_IDS);
+  auto post_param_initializer = [this](std::default_random_engine& engine,
+                                       TensorMap* param) {
+    auto& W = param->get<srm_t>("W");
+    for (size_t i = 0; i < X_.col_size(); ++i) {
+      W.get_row(engine, X_.col(i));
+    }
+  };
+  auto inst_initializer = [this](Instance* inst) {
+    inst->insert<csr_t>("X") = X_;
+  };
+  CheckOpPredictQuantized(&Z, 0, nullptr, post_param_initializer,
+                          inst_initializer);
+}
+
 }  // namespace deepx_core
@@ -3,6 +3,7 @@
 //
 
 #include <deepx_core/graph/op_impl.h>
+#include "norm.h"
 
 namespace deepx_core {
 namespace {
@@ -54,117 +55,91 @@ bool LayerNormInferShape(const Shape& X, const Shape& gamma, const Shape& beta,
 template <typename T>
 struct LayerNormMutableAux {
   Tensor<T> mean;     // mean(X, axis=1)
-  Tensor<T> var;      // var(X, axis=1)
-  Tensor<T> inv_std;  // 1 / sqrt(var + eps)
-  Tensor<T> Z1;       // X - mean
-  Tensor<T> Z2;       // (X - mean) * (X - mean)
-  Tensor<T> Z3;       // (X - mean) / sqrt(var + eps)
-
-  Tensor<T> gvar;
-  Tensor<T> gZ3;
-  Tensor<T> I;
-  Tensor<T> buf1;
-  Tensor<T> buf2;
+  Tensor<T> inv_std;  // 1 / sqrt(var(X, axis=1) + eps)
 };
 
 template <typename T>
 void LayerNormPrepare(const LayerNormAux& aux, LayerNormMutableAux<T>* maux) {
   maux->mean.resize(aux.batch);
-  maux->var.resize(aux.batch);
   maux->inv_std.resize(aux.batch);
-  maux->Z1.resize(aux.Z);
-  maux->Z2.resize(aux.Z);
-  maux->Z3.resize(aux.Z);
-}
-
-template <typename T>
-void LayerNormPrepareBackward(const LayerNormAux& aux,
-                              LayerNormMutableAux<T>* maux) {
-  maux->gvar.resize(aux.batch);
-  maux->gZ3.resize(aux.Z);
-  maux->I.resize(aux.Z);
-  maux->buf1.resize(aux.Z);
-  maux->buf2.resize(aux.batch);
 }
 
+// Statistics and normalization of a row are fused in one sweep, while the
+// row is in cache.
 template <typename T>
 void LayerNorm(const Tensor<T>& X, const Tensor<T>& gamma,
                const Tensor<T>& beta, Tensor<T>* Z, const LayerNormAux& aux,
-               LayerNormMutableAux<T>* maux) {
+               LayerNormMutableAux<T>* maux) noexcept {
   int batch = aux.batch;
   int m = aux.m;
-  int total_dim = batch * m;
   const T* _X = X.data();
   const T* _gamma = gamma.data();
   const T* _beta = beta.data();
   T* _Z = Z->data();
   T* _mean = maux->mean.data();
-  T* _var = maux->var.data();
   T* _inv_std = maux->inv_std.data();
-  T* _Z1 = maux->Z1.data();
-  T* _Z2 = maux->Z2.data();
-  T* _Z3 = maux->Z3.data();
-  LLMath<T>::sum_col(batch, m, (T)1 / m, _X, 0, _mean);
-  LLMath<T>::sub_col(batch, m, 1, _X, 1, _mean, _Z1);
-  LLMath<T>::square(total_dim, _Z1, _Z2);
-  LLMath<T>::sum_col(batch, m, (T)1 / m, _Z2, 0, _var);
-  LLMath<T>::add_scalar(batch, _var, (T)1e-6, _inv_std);
-  LLMath<T>::sqrt(batch, _inv_std, _inv_std);
-  LLMath<T>::inv(batch, _inv_std, _inv_std);
-  LLMath<T>::mul_col(batch, m, _Z1, _inv_std, _Z3);
-  LLMath<T>::mul_row(batch, m, _Z3, _gamma, _Z);
-  LLMath<T>::add_row(batch, m, 1, _Z, 1, _beta, _Z);
+  T var;
+  for (int i = 0; i < batch; ++i) {
+    NormRowMoments(m, _X, &_mean[i], &var);
+    _inv_std[i] = NormInvStd(var);
+    // Z = ((X - mean) * inv_std) * gamma + beta
+    T a = _inv_std[i];
+    T b = -_mean[i] * a;
+    for (int j = 0; j < m; ++j) {
+      _Z[j] = (_X[j] * a + b) * _gamma[j] + _beta[j];
+    }
+    _X += m;
+    _Z += m;
+  }
 }
 
 template <typename T>
-void LayerNormBackward(const Tensor<T>& /*X*/, const Tensor<T>& gamma,
+void LayerNormBackward(const Tensor<T>& X, const Tensor<T>& gamma,
                        const Tensor<T>& /*beta*/, const Tensor<T>& /*Z*/,
                        const Tensor<T>& gZ, Tensor<T>* gX, Tensor<T>* ggamma,
                        Tensor<T>* gbeta, const LayerNormAux& aux,
-                       LayerNormMutableAux<T>* maux) {
+                       LayerNormMutableAux<T>* maux) noexcept {
   int batch = aux.batch;
   int m = aux.m;
-  int total_dim = batch * m;
+  const T* _X = X.data();
   const T* _gamma = gamma.data();
   const T* _gZ = gZ.data();
-  T* _inv_std = maux->inv_std.data();
-  T* _Z1 = maux->Z1.data();
-  T* _Z3 = maux->Z3.data();
-  T* _gvar = maux->gvar.data();
-  T* _gZ3 = maux->gZ3.data();
-  T* _I = maux->I.data();
-  T* _buf1 = maux->buf1.data();
-  T* _buf2 = maux->buf2.data();
-
-  if (gX) {
-    T* _gX = gX->data();
-    // gZ3
-    LLMath<T>::mul_row(batch, m, _gZ, _gamma, _gZ3);
-    // gvar
-    LLMath<T>::mul(total_dim, _gZ3, _Z1, _buf1);
-    LLMath<T>::cubic(batch, _inv_std, _buf2);
-    LLMath<T>::mul_col(batch, m, _buf1, _buf2, _buf1);
-    LLMath<T>::sum_col(batch, m, (T)-0.5, _buf1, 0, _gvar);
-    // I
-    LLMath<T>::mul_col(batch, m, _gZ3, _inv_std, _I);
-    LLMath<T>::mul_col(batch, m, _Z1, _gvar, _buf1);
-    LLMath<T>::mul_scalar(total_dim, _buf1, (T)2 / m, _buf1);
-    LLMath<T>::add(total_dim, _I, _buf1, _I);
-    // gX
-    LLMath<T>::sum_col(batch, m, (T)-1 / m, _I, 0, _buf2);
-    LLMath<T>::add_col(batch, m, 1, _I, 1, _buf2, _buf1);
-    LLMath<T>::add(total_dim, _gX, _buf1, _gX);
-  }
-
-  if (ggamma) {
-    T* _ggamma = ggamma->data();
-    LLMath<T>::mul(total_dim, _gZ, _Z3, _buf1);
-    LLMath<T>::sum_row(batch, m, 1, _buf1, 1, _ggamma);
-  }
-
-  if (gbeta) {
-    T* _gbeta = gbeta->data();
-    LLMath<T>::sum_row(batch, m, 1, _gZ, 1, _gbeta);
+  const T* _mean = maux->mean.data();
+  const T* _inv_std = maux->inv_std.data();
+  T* _gX = gX ? gX->data() : nullptr;
+  T* _ggamma = ggamma ? ggamma->data() : nullptr;
+  T* _gbeta = gbeta ? gbeta->data() : nullptr;
+  for (int i = 0; i < batch; ++i) {
+    // Xhat = (X - mean) * inv_std = X * a + b
+    T a = _inv_std[i];
+    T b = -_mean[i] * a;
+    if (_gX) {
+      // gXhat = gZ * gamma
+      // gX = inv_std * (gXhat - mean(gXhat) - Xhat * mean(gXhat * Xhat))
+      T sum = 0, sum2 = 0;
+      for (int j = 0; j < m; ++j) {
+        T gXhat = _gZ[j] * _gamma[j];
+        sum += gXhat;
+        sum2 += gXhat * (_X[j] * a + b);
+      }
+      T c1 = sum / m;
+      T c2 = sum2 / m;
+      for (int j = 0; j < m; ++j) {
+        T gXhat = _gZ[j] * _gamma[j];
+        _gX[j] += a * (gXhat - c1 - (_X[j] * a + b) * c2);
+      }
+      _gX += m;
+    }
+    if (_ggamma) {
+      for (int j = 0; j < m; ++j) {
+        _ggamma[j] += _gZ[j] * (_X[j] * a + b);
+      }
+    }
+    if (_gbeta) {
+      LLMath<T>::add(m, _gZ, _gbeta, _gbeta);
+    }
+    _X += m;
+    _gZ += m;
   }
 }
 
@@ -218,9 +193,6 @@ class LayerNormOp : public OpImpl {
     gX_ = InitGradTSR(node_->input(0), X_->shape());
     ggamma_ = InitGradTSR(node_->input(1), gamma_->shape());
     gbeta_ = InitGradTSR(node_->input(2), beta_->shape());
-    if (gX_ || ggamma_ || gbeta_) {
-      LayerNormPrepareBackward(aux_, &maux_);
-    }
   }
 
   void Forward() override { LayerNorm(*X_, *gamma_, *beta_, Z_, aux_, &maux_); }
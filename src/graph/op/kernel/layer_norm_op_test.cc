@@ -6,6 +6,21 @@
 
 namespace deepx_core {
 
+class LayerNormForwardTest : public testing::Test, public DataType {};
+
+TEST_F(LayerNormForwardTest, LayerNorm) {
+  ConstantNode X("X", Shape(2, 10), TENSOR_INITIALIZER_TYPE_ARANGE, 0, 0);
+  ConstantNode gamma("gamma", Shape(10), TENSOR_INITIALIZER_TYPE_ONES, 0, 0);
+  ConstantNode beta("beta", Shape(10), TENSOR_INITIALIZER_TYPE_ZEROS, 0, 0);
+  LayerNormNode Z("Z", &X, &gamma, &beta);
+  tsr_t expected_Z{-1.5666988, -1.2185435, -0.8703882, -0.5222329, -0.1740776,
+                   0.1740776,  0.5222329,  0.8703882,  1.2185435,  1.5666988,
+                   -1.5666988, -1.2185435, -0.8703882, -0.5222329, -0.1740776,
+                   0.1740776,  0.5222329,  0.8703882,  1.2185435,  1.5666988};
+  expected_Z.reshape(2, 10);
+  CheckOpForward(&Z, 0, expected_Z);
+}
+
 class LayerNormBackwardTest : public testing::Test {};
 
 TEST_F(LayerNormBackwardTest, LayerNorm) {
@@ -18,4 +33,13 @@ TEST_F(LayerNormBackwardTest, LayerNorm) {
   CheckOpBackward(&Z, 0);
 }
 
+TEST_F(LayerNormBackwardTest, LayerNorm_rank3) {
+  int batch = 7;
+  VariableNode X("X", Shape(batch, 3, 7), TENSOR_INITIALIZER_TYPE_RANDN, 0, 1);
+  VariableNode gamma("gamma", Shape(21), TENSOR_INITIALIZER_TYPE_RANDN, 0, 1);
+  VariableNode beta("beta", Shape(21), TENSOR_INITIALIZER_TYPE_RANDN, 0, 1);
+  LayerNormNode Z("Z", &X, &gamma, &beta);
+  CheckOpBackward(&Z, 0);
+}
+
 }  // namespace deepx_core
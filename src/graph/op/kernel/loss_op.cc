@@ -3,6 +3,7 @@
 //
 
 #include <deepx_core/graph/op_impl.h>
+#include <cmath>
 
 namespace deepx_core {
 
@@ -267,42 +268,81 @@ GRAPH_NODE_OP_REGISTER(BCELoss2);
 /************************************************************************/
 namespace {
 
-template <typename T>
-void SigmoidBCELoss(const Tensor<T>& X, const Tensor<T>& Y, Tensor<T>* Z,
-                    Tensor<T>* aux) noexcept {
+// The loss and its gradient with respect to X are computed in one forward,
+// the gradient is stored in 'aux', so that the backward is a multiply-add.
+//
+// Elements are processed in blocks of 'LOSS_BLOCK', which stay in L1 cache.
+// exp and log of a block are computed by 'LLMath', which is vectorized with
+// SAGE2=1 (or SIMD=1). Other loops are branch-free and call no math
+// function, so that they are vectorized by -O3 alone.
+//
+// With p = sigmoid(x) and e = exp(-|x|),
+// -log(p) = max(-x, 0) + log(1 + e),
+// -log(1 - p) = max(x, 0) + log(1 + e),
+// which never overflow.
+constexpr int LOSS_BLOCK = 256;  // magic number
+
+// Z = -Y * log(p) - (1 - Y) * log(1 - p), aux = p - Y.
+// If 'W' is not null, Z and aux are multiplied by 'W'.
+//
+// If 'HARD_LABEL' is true, Y is 1 if Y > 0, otherwise 0.
+template <typename T, bool HARD_LABEL>
+void SigmoidBCELossWithGrad(const Tensor<T>& X, const Tensor<T>& Y,
+                            const Tensor<T>* W, Tensor<T>* Z,
+                            Tensor<T>* aux) noexcept {
   DXASSERT_SAME_SHAPE(X, Y, *Z, *aux);
   const T* _X = X.data();
   const T* _Y = Y.data();
+  const T* _W = W ? W->data() : nullptr;
   T* _Z = Z->data();
   T* _aux = aux->data();
-  T p;
-  for (int i = 0; i < X.total_dim(); ++i) {
-    p = LLMath<T>::sigmoid(_X[i]);
-    if (_Y[i] > 0) {
-      _Z[i] = -LLMath<T>::safe_log(p);
-    } else {
-      _Z[i] = -LLMath<T>::safe_log(1 - p);
+  T e[LOSS_BLOCK];
+  int total_dim = X.total_dim();
+  for (int i = 0; i < total_dim; i += LOSS_BLOCK) {
+    int n = (total_dim - i < LOSS_BLOCK) ? total_dim - i : LOSS_BLOCK;
+    const T* x = _X + i;
+    const T* y = _Y + i;
+    T* z = _Z + i;
+    T* a = _aux + i;
+    for (int j = 0; j < n; ++j) {
+      e[j] = -std::fabs(x[j]);
+    }
+    LLMath<T>::exp(n, e, e);
+    LLMath<T>::add_scalar(n, e, 1, z);
+    LLMath<T>::log(n, z, z);
+    for (int j = 0; j < n; ++j) {
+      T _y = HARD_LABEL ? ((y[j] > 0) ? (T)1 : (T)0) : y[j];
+      T r = 1 / (1 + e[j]);
+      T p = (x[j] >= 0) ? r : e[j] * r;
+      z[j] += ((x[j] > 0) ? x[j] : (T)0) - x[j] * _y;
+      a[j] = p - _y;
+    }
+    if (_W) {
+      LLMath<T>::mul(n, z, _W + i, z);
+      LLMath<T>::mul(n, a, _W + i, a);
     }
-    _aux[i] = p;
   }
 }
 
+// gX += gZ * aux, where 'aux' is the gradient of Z with respect to X.
+template <typename T>
+void LossWithGradBackward(const Tensor<T>& gZ, Tensor<T>* gX,
+                          const Tensor<T>& aux) noexcept {
+  DXASSERT_SAME_SHAPE(gZ, *gX, aux);
+  LLMath<T>::xypz(gZ.total_dim(), gZ.data(), aux.data(), gX->data());
+}
+
+template <typename T>
+void SigmoidBCELoss(const Tensor<T>& X, const Tensor<T>& Y, Tensor<T>* Z,
+                    Tensor<T>* aux) noexcept {
+  SigmoidBCELossWithGrad<T, true>(X, Y, nullptr, Z, aux);
+}
+
 template <typename T>
-void SigmoidBCELossBackward(const Tensor<T>& /*X*/, const Tensor<T>& Y,
+void SigmoidBCELossBackward(const Tensor<T>& /*X*/, const Tensor<T>& /*Y*/,
                             const Tensor<T>& /*Z*/, const Tensor<T>& gZ,
                             Tensor<T>* gX, const Tensor<T>& aux) noexcept {
-  DXASSERT_SAME_SHAPE(Y, gZ, *gX, aux);
-  const T* _Y = Y.data();
-  const T* _gZ = gZ.data();
-  T* _gX = gX->data();
-  const T* _aux = aux.data();
-  for (int i = 0; i < Y.total_dim(); ++i) {
-    if (_Y[i] > 0) {
-      _gX[i] += _gZ[i] * (_aux[i] - 1);
-    } else {
-      _gX[i] += _gZ[i] * _aux[i];
-    }
-  }
+  LossWithGradBackward(gZ, gX, aux);
 }
 
 }  // namespace
@@ -343,32 +383,14 @@ namespace {
 template <typename T>
 void SigmoidBCELoss2(const Tensor<T>& X, const Tensor<T>& Y, Tensor<T>* Z,
                      Tensor<T>* aux) noexcept {
-  DXASSERT_SAME_SHAPE(X, Y, *Z, *aux);
-  const T* _X = X.data();
-  const T* _Y = Y.data();
-  T* _Z = Z->data();
-  T* _aux = aux->data();
-  T p;
-  for (int i = 0; i < X.total_dim(); ++i) {
-    p = LLMath<T>::sigmoid(_X[i]);
-    _Z[i] = -_Y[i] * LLMath<T>::safe_log(p) -
-            (1 - _Y[i]) * LLMath<T>::safe_log(1 - p);
-    _aux[i] = p;
-  }
+  SigmoidBCELossWithGrad<T, false>(X, Y, nullptr, Z, aux);
 }
 
 template <typename T>
-void SigmoidBCELoss2Backward(const Tensor<T>& /*X*/, const Tensor<T>& Y,
+void SigmoidBCELoss2Backward(const Tensor<T>& /*X*/, const Tensor<T>& /*Y*/,
                              const Tensor<T>& /*Z*/, const Tensor<T>& gZ,
                              Tensor<T>* gX, const Tensor<T>& aux) noexcept {
-  DXASSERT_SAME_SHAPE(Y, gZ, *gX, aux);
-  const T* _Y = Y.data();
-  const T* _gZ = gZ.data();
-  T* _gX = gX->data();
-  const T* _aux = aux.data();
-  for (int i = 0; i < Y.total_dim(); ++i) {
-    _gX[i] += _gZ[i] * (_aux[i] - _Y[i]);
-  }
+  LossWithGradBackward(gZ, gX, aux);
 }
 
 }  // namespace
@@ -401,6 +423,114 @@ class SigmoidBCELoss2Op : public OpBinaryElementWiseBase {
 
 GRAPH_NODE_OP_REGISTER(SigmoidBCELoss2);
 
+/************************************************************************/
+/* WeightedSigmoidBCELoss */
+/************************************************************************/
+namespace {
+
+bool WeightedSigmoidBCELossInferShape(const Shape& X, const Shape& Y,
+                                      const Shape& W, Shape* Z) noexcept {
+  if (X != Y) {
+    DXERROR("Invalid X and Y: inconsistent shape %s vs %s.",
+            to_string(X).c_str(), to_string(Y).c_str());
+    return false;
+  }
+
+  if (X != W) {
+    DXERROR("Invalid X and W: inconsistent shape %s vs %s.",
+            to_string(X).c_str(), to_string(W).c_str());
+    return false;
+  }
+
+  *Z = X;
+  return true;
+}
+
+// Z = W * SigmoidBCELoss(X, Y), aux = W * (p - Y).
+template <typename T>
+void WeightedSigmoidBCELoss(const Tensor<T>& X, const Tensor<T>& Y,
+                            const Tensor<T>& W, Tensor<T>* Z,
+                            Tensor<T>* aux) noexcept {
+  SigmoidBCELossWithGrad<T, true>(X, Y, &W, Z, aux);
+}
+
+template <typename T>
+void WeightedSigmoidBCELossBackward(
+    const Tensor<T>& /*X*/, const Tensor<T>& /*Y*/, const Tensor<T>& /*W*/,
+    const Tensor<T>& /*Z*/, const Tensor<T>& gZ, Tensor<T>* gX,
+    const Tensor<T>& aux) noexcept {
+  LossWithGradBackward(gZ, gX, aux);
+}
+
+}  // namespace
+
+WeightedSigmoidBCELossNode::WeightedSigmoidBCELossNode(std::string name,
+                                                       GraphNode* X,
+                                                       GraphNode* Y,
+                                                       GraphNode* W)
+    : GraphNode(std::move(name)) {
+  DXCHECK_THROW(X->tensor_type() == TENSOR_TYPE_TSR);
+  DXCHECK_THROW(Y->tensor_type() == TENSOR_TYPE_TSR);
+  DXCHECK_THROW(W->tensor_type() == TENSOR_TYPE_TSR);
+  input_ = {X, Y, W};
+  node_type_ = GRAPH_NODE_TYPE_HIDDEN;
+  tensor_type_ = TENSOR_TYPE_TSR;
+
+  if (!X->shape().empty() && !Y->shape().empty() && !W->shape().empty()) {
+    (void)WeightedSigmoidBCELossInferShape(X->shape(), Y->shape(), W->shape(),
+                                           &shape_);
+  }
+}
+
+class WeightedSigmoidBCELossOp : public OpImpl {
+ private:
+  const GraphNode* Xnode_ = nullptr;
+  const GraphNode* Ynode_ = nullptr;
+  const GraphNode* Wnode_ = nullptr;
+  const tsr_t* X_ = nullptr;
+  const tsr_t* Y_ = nullptr;
+  const tsr_t* W_ = nullptr;
+  Shape Zshape_;
+  tsr_t* Z_ = nullptr;
+  tsr_t aux_;
+  tsr_t* gZ_ = nullptr;
+  tsr_t* gX_ = nullptr;
+
+ public:
+  DEFINE_OP_LIKE(WeightedSigmoidBCELossOp);
+
+  void InitForward() override {
+    Xnode_ = node_->input(0);
+    Ynode_ = node_->input(1);
+    Wnode_ = node_->input(2);
+    X_ = GetPtrTSR(Xnode_);
+    Y_ = GetPtrTSR(Ynode_);
+    W_ = GetPtrTSR(Wnode_);
+    DXCHECK_THROW(WeightedSigmoidBCELossInferShape(X_->shape(), Y_->shape(),
+                                                   W_->shape(), &Zshape_));
+    Z_ = InitHiddenTSR(node_, Zshape_);
+    aux_.resize(Zshape_);
+  }
+
+  void InitBackward() override {
+    gZ_ = GetGradPtrTSR(node_);
+    gX_ = InitGradTSR(Xnode_, X_->shape());
+  }
+
+  void Forward() override {
+    WeightedSigmoidBCELoss(*X_, *Y_, *W_, Z_, &aux_);
+  }
+
+  void Backward() override {
+    if (gX_) {
+      WeightedSigmoidBCELossBackward(*X_, *Y_, *W_, *Z_, *gZ_, gX_, aux_);
+    }
+    // gY and gW are not computed.
+  }
+};
+
+GRAPH_NODE_OP_REGISTER(WeightedSigmoidBCELoss);
+
 /************************************************************************/
 /* BatchCELoss */
 /************************************************************************/
@@ -617,6 +747,21 @@ bool BatchSoftmaxCELossInferShape(const Shape& X, const Shape& Y,
   return BatchCELossInferShape(X, Y, Z);
 }
 
+// Compute aux = softmax(X) of a row, return log-sum-exp of X.
+//
+// exp is computed by 'LLMath', which is vectorized with SAGE2=1 (or SIMD=1),
+// and log is called once per row.
+template <typename T>
+T SoftmaxRow(int m, const T* X, T* aux) noexcept {
+  T max = LLMath<T>::max(m, X);
+  LLMath<T>::sub_scalar(m, X, max, aux);
+  LLMath<T>::exp(m, aux, aux);
+  T sum = LLMath<T>::sum(m, aux);
+  LLMath<T>::mul_scalar(m, aux, 1 / sum, aux);
+  return max + std::log(sum);
+}
+
+// Z = lse(X) - X[label], aux = softmax(X) - onehot(label).
 template <typename T>
 void BatchSoftmaxCELoss(const Tensor<T>& X, const Tensor<T>& Y, Tensor<T>* Z,
                         Tensor<T>* aux) noexcept {
@@ -629,10 +774,11 @@ void BatchSoftmaxCELoss(const Tensor<T>& X, const Tensor<T>& Y, Tensor<T>* Z,
   T* _aux = aux->data();
   int label;
   for (int i = 0; i < batch; ++i) {
-    LLMath<T>::softmax(m, _X, _aux);
+    T lse = SoftmaxRow(m, _X, _aux);
     label = (int)(*_Y);
     DXASSERT(0 <= label && label < m);
-    *_Z = -LLMath<T>::safe_log(_aux[label]);
+    *_Z = lse - _X[label];
+    _aux[label] -= 1;
     _X += m;
     _Y += 1;
     _Z += 1;
@@ -641,23 +787,17 @@ void BatchSoftmaxCELoss(const Tensor<T>& X, const Tensor<T>& Y, Tensor<T>* Z,
 }
 
 template <typename T>
-void BatchSoftmaxCELossBackward(const Tensor<T>& /*X*/, const Tensor<T>& Y,
+void BatchSoftmaxCELossBackward(const Tensor<T>& /*X*/, const Tensor<T>& /*Y*/,
                                 const Tensor<T>& /*Z*/, const Tensor<T>& gZ,
                                 Tensor<T>* gX, const Tensor<T>& aux) noexcept {
   int batch = gX->dim(0);
   int m = gX->dim(1);
   DXASSERT(aux.same_shape(batch, m));
-  const T* _Y = Y.data();
   const T* _gZ = gZ.data();
   T* _gX = gX->data();
   const T* _aux = aux.data();
-  int label;
   for (int i = 0; i < batch; ++i) {
     LLMath<T>::axpy(m, *_gZ, _aux, _gX);
-    label = (int)(*_Y);
-    DXASSERT(0 <= label && label < m);
-    _gX[label] -= *_gZ;
-    _Y += 1;
     _gZ += 1;
     _gX += m;
     _aux += m;
@@ -715,6 +855,8 @@ bool BatchSoftmaxCELoss2InferShape(const Shape& X, const Shape& Y,
   return BatchCELoss2InferShape(X, Y, Z);
 }
 
+// Z = -sum(Y * log(softmax(X))) = lse(X) * sum(Y) - dot(X, Y),
+// aux = softmax(X) - Y.
 template <typename T>
 void BatchSoftmaxCELoss2(const Tensor<T>& X, const Tensor<T>& Y, Tensor<T>* Z,
                          Tensor<T>* aux) noexcept {
@@ -725,15 +867,11 @@ void BatchSoftmaxCELoss2(const Tensor<T>& X, const Tensor<T>& Y, Tensor<T>* Z,
   const T* _Y = Y.data();
   T* _Z = Z->data();
   T* _aux = aux->data();
-  T z;
   for (int i = 0; i < batch; ++i) {
     // '_Y' is not checked to be a probability distribution.
-    LLMath<T>::softmax(m, _X, _aux);
-    z = 0;
-    for (int j = 0; j < m; ++j) {
-      z -= std::log(_aux[j]) * _Y[j];
-    }
-    *_Z = z;
+    T lse = SoftmaxRow(m, _X, _aux);
+    *_Z = lse * LLMath<T>::sum(m, _Y) - LLMath<T>::dot(m, _X, _Y);
+    LLMath<T>::sub(m, _aux, _Y, _aux);
     _X += m;
     _Y += m;
     _Z += 1;
@@ -742,26 +880,10 @@ void BatchSoftmaxCELoss2(const Tensor<T>& X, const Tensor<T>& Y, Tensor<T>* Z,
 }
 
 template <typename T>
-void BatchSoftmaxCELoss2Backward(const Tensor<T>& /*X*/, const Tensor<T>& Y,
-                                 const Tensor<T>& /*Z*/, const Tensor<T>& gZ,
+void BatchSoftmaxCELoss2Backward(const Tensor<T>& X, const Tensor<T>& Y,
+                                 const Tensor<T>& Z, const Tensor<T>& gZ,
                                  Tensor<T>* gX, const Tensor<T>& aux) noexcept {
-  int batch = gX->dim(0);
-  int m = gX->dim(1);
-  DXASSERT(aux.same_shape(batch, m));
-  const T* _Y = Y.data();
-  const T* _gZ = gZ.data();
-  T* _gX = gX->data();
-  const T* _aux = aux.data();
-  for (int i = 0; i < batch; ++i) {
-    // '_Y' is not checked to be a probability distribution.
-    for (int j = 0; j < m; ++j) {
-      _gX[j] += *_gZ * (_aux[j] - _Y[j]);
-    }
-    _Y += m;
-    _gZ += 1;
-    _gX += m;
-    _aux += m;
-  }
+  BatchSoftmaxCELossBackward(X, Y, Z, gZ, gX, aux);
 }
 
 }  // namespace
@@ -898,51 +1020,58 @@ GRAPH_NODE_OP_REGISTER(FocalLoss);
 /************************************************************************/
 namespace {
 
+// With t = 1 if Y > 0, otherwise 0,
+// r = t ? p : 1 - p, q = 1 - r, w = t ? alpha : 1 - alpha,
+// Z = -w * q^gamma * log(r),
+// aux = (t ? 1 : -1) * (-w * q^(gamma + 1) - gamma * r * Z).
+//
+// With x = t ? X : -X, q^gamma = exp(-gamma * (max(x, 0) + log(1 + e))),
+// so that it is computed by 'LLMath' like exp and log.
 template <typename T>
 void SigmoidFocalLoss(const Tensor<T>& X, const Tensor<T>& Y, Tensor<T>* Z,
-                      T alpha, T gamma, Tensor<T>* aux1,
-                      Tensor<T>* aux2) noexcept {
-  DXASSERT_SAME_SHAPE(X, Y, *Z, *aux1, *aux2);
+                      T alpha, T gamma, Tensor<T>* aux) noexcept {
+  DXASSERT_SAME_SHAPE(X, Y, *Z, *aux);
   const T* _X = X.data();
   const T* _Y = Y.data();
   T* _Z = Z->data();
-  T* _aux1 = aux1->data();
-  T* _aux2 = aux2->data();
-  T p;
-  for (int i = 0; i < X.total_dim(); ++i) {
-    p = LLMath<T>::sigmoid(_X[i]);
-    if (_Y[i] > 0) {
-      _aux1[i] = -alpha * std::pow(1 - p, gamma);
-      _Z[i] = _aux1[i] * LLMath<T>::safe_log(p);
-    } else {
-      _aux1[i] = -(1 - alpha) * std::pow(p, gamma);
-      _Z[i] = _aux1[i] * LLMath<T>::safe_log(1 - p);
+  T* _aux = aux->data();
+  T e[LOSS_BLOCK], l[LOSS_BLOCK], qg[LOSS_BLOCK];
+  int total_dim = X.total_dim();
+  for (int i = 0; i < total_dim; i += LOSS_BLOCK) {
+    int n = (total_dim - i < LOSS_BLOCK) ? total_dim - i : LOSS_BLOCK;
+    const T* _x = _X + i;
+    const T* y = _Y + i;
+    for (int j = 0; j < n; ++j) {
+      e[j] = -std::fabs(_x[j]);
+    }
+    LLMath<T>::exp(n, e, e);
+    LLMath<T>::add_scalar(n, e, 1, l);
+    LLMath<T>::log(n, l, l);
+    for (int j = 0; j < n; ++j) {
+      T x = (y[j] > 0) ? _x[j] : -_x[j];
+      qg[j] = -gamma * (((x > 0) ? x : (T)0) + l[j]);
+    }
+    LLMath<T>::exp(n, qg, qg);
+    for (int j = 0; j < n; ++j) {
+      int t = y[j] > 0;
+      T x = t ? _x[j] : -_x[j];
+      T d = 1 / (1 + e[j]);
+      T r = (x >= 0) ? d : e[j] * d;
+      T q = (x >= 0) ? e[j] * d : d;
+      T log_r = -(((x < 0) ? -x : (T)0) + l[j]);
+      T a = -(t ? alpha : 1 - alpha) * qg[j];
+      T z = a * log_r;
+      _Z[i + j] = z;
+      _aux[i + j] = (t ? (T)1 : (T)-1) * (a * q - gamma * r * z);
     }
-    _aux2[i] = p;
   }
 }
 
 template <typename T>
-void SigmoidFocalLossBackward(const Tensor<T>& /*X*/, const Tensor<T>& Y,
-                              const Tensor<T>& Z, const Tensor<T>& gZ,
-                              Tensor<T>* gX, T /*alpha*/, T gamma,
-                              const Tensor<T>& aux1, const Tensor<T>& aux2) {
-  DXASSERT_SAME_SHAPE(Y, gZ, *gX, aux1, aux2);
-  const T* _Y = Y.data();
-  const T* _Z = Z.data();
-  const T* _gZ = gZ.data();
-  T* _gX = gX->data();
-  const T* _aux1 = aux1.data();
-  const T* _aux2 = aux2.data();
-  for (int i = 0; i < Y.total_dim(); ++i) {
-    if (_Y[i] > 0) {
-      _gX[i] +=
-          _gZ[i] * (gamma * _Z[i] * (-_aux2[i]) + _aux1[i] * (1 - _aux2[i]));
-    } else {
-      _gX[i] +=
-          _gZ[i] * (gamma * _Z[i] * (1 - _aux2[i]) + _aux1[i] * (-_aux2[i]));
-    }
-  }
+void SigmoidFocalLossBackward(const Tensor<T>& /*X*/, const Tensor<T>& /*Y*/,
+                              const Tensor<T>& /*Z*/, const Tensor<T>& gZ,
+                              Tensor<T>* gX, const Tensor<T>& aux) noexcept {
+  LossWithGradBackward(gZ, gX, aux);
 }
 
 }  // namespace
@@ -959,9 +1088,7 @@ SigmoidFocalLossNode::SigmoidFocalLossNode(std::string name, GraphNode* X,
 
 class SigmoidFocalLossOp : public OpBinaryElementWiseBase {
  private:
-  tsr_t aux1_;
-  tsr_t aux2_;
-
+  tsr_t aux_;
   float_t alpha_ = 0;
   float_t gamma_ = 0;
 
@@ -970,20 +1097,18 @@ class SigmoidFocalLossOp : public OpBinaryElementWiseBase {
 
   void InitForward() override {
     OpBinaryElementWiseBase::InitForward();
-    aux1_.resize(X_->shape());
-    aux2_.resize(X_->shape());
+    aux_.resize(X_->shape());
     alpha_ = (float_t)((const SigmoidFocalLossNode*)node_)->alpha();
     gamma_ = (float_t)((const SigmoidFocalLossNode*)node_)->gamma();
   }
 
   void Forward() override {
-    SigmoidFocalLoss(*X_, *Y_, Z_, alpha_, gamma_, &aux1_, &aux2_);
+    SigmoidFocalLoss(*X_, *Y_, Z_, alpha_, gamma_, &aux_);
   }
 
   void Backward() override {
     if (gX_) {
-      SigmoidFocalLossBackward(*X_, *Y_, *Z_, *gZ_, gX_, alpha_, gamma_, aux1_,
-                               aux2_);
+      SigmoidFocalLossBackward(*X_, *Y_, *Z_, *gZ_, gX_, aux_);
     }
     // gY is not computed.
   }
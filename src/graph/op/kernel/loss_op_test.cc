@@ -6,6 +6,37 @@
 
 namespace deepx_core {
 
+class LossForwardTest : public testing::Test, public DataType {};
+
+TEST_F(LossForwardTest, SigmoidBCELoss_saturated) {
+  ConstantNode X("X", Shape(2, 3), {-100, 100, 0, -100, 100, 0});
+  ConstantNode Y("Y", Shape(2, 3), {1, 0, 1, 0, 1, 0});
+  SigmoidBCELossNode Z("Z", &X, &Y);
+  float_t log2 = (float_t)0.69314718055994531;
+  tsr_t expected_Z{{100, 100, log2}, {0, 0, log2}};
+  CheckOpForward(&Z, 0, expected_Z);
+}
+
+TEST_F(LossForwardTest, WeightedSigmoidBCELoss_saturated) {
+  ConstantNode X("X", Shape(2, 3), {-100, 100, 0, -100, 100, 0});
+  ConstantNode Y("Y", Shape(2, 3), {1, 0, 1, 0, 1, 0});
+  ConstantNode W("W", Shape(2, 3), {1, 2, 3, 4, 5, 6});
+  WeightedSigmoidBCELossNode Z("Z", &X, &Y, &W);
+  float_t log2 = (float_t)0.69314718055994531;
+  tsr_t expected_Z{{100, 200, 3 * log2}, {0, 0, 6 * log2}};
+  CheckOpForward(&Z, 0, expected_Z);
+}
+
+TEST_F(LossForwardTest, BatchSoftmaxCELoss_saturated) {
+  ConstantNode X("X", Shape(2, 3), {1000, 0, 0, 0, 0, 0});
+  ConstantNode Y("Y", Shape(2, 1), {1, 2});
+  BatchSoftmaxCELossNode Z("Z", &X, &Y);
+  float_t log3 = (float_t)1.0986122886681098;
+  tsr_t expected_Z{1000, log3};
+  expected_Z.reshape(2, 1);
+  CheckOpForward(&Z, 0, expected_Z);
+}
+
 class LossBackwardTest : public testing::Test {};
 
 TEST_F(LossBackwardTest, AbsoluteError) {
@@ -49,6 +80,33 @@ TEST_F(LossBackwardTest, SigmoidBCELoss) {
   ConstantNode Y("Y", Shape(2, 3), TENSOR_INITIALIZER_TYPE_RAND, -1, 1);
   SigmoidBCELossNode Z("Z", &X, &Y);
   CheckOpBackward(&Z, 0);
+
+  X.set_initializer(TENSOR_INITIALIZER_TYPE_RANDN, 0, 10);
+  CheckOpBackward(&Z, 0);
+}
+
+TEST_F(LossBackwardTest, SigmoidBCELoss_multi_label) {
+  // more elements than a block
+  VariableNode X("X", Shape(100, 3), TENSOR_INITIALIZER_TYPE_RANDN, 0, 1);
+  ConstantNode Y("Y", Shape(100, 3), TENSOR_INITIALIZER_TYPE_RAND, -1, 1);
+  SigmoidBCELossNode Z("Z", &X, &Y);
+  CheckOpBackward(&Z, 0);
+}
+
+TEST_F(LossBackwardTest, WeightedSigmoidBCELoss) {
+  VariableNode X("X", Shape(2, 1), TENSOR_INITIALIZER_TYPE_RANDN, 0, 1);
+  ConstantNode Y("Y", Shape(2, 1), TENSOR_INITIALIZER_TYPE_RAND, -1, 1);
+  ConstantNode W("W", Shape(2, 1), TENSOR_INITIALIZER_TYPE_RAND, 0, 2);
+  WeightedSigmoidBCELossNode Z("Z", &X, &Y, &W);
+  CheckOpBackward(&Z, 0);
+}
+
+TEST_F(LossBackwardTest, WeightedSigmoidBCELoss_multi_label) {
+  VariableNode X("X", Shape(100, 3), TENSOR_INITIALIZER_TYPE_RANDN, 0, 1);
+  ConstantNode Y("Y", Shape(100, 3), TENSOR_INITIALIZER_TYPE_RAND, -1, 1);
+  ConstantNode W("W", Shape(100, 3), TENSOR_INITIALIZER_TYPE_RAND, 0, 2);
+  WeightedSigmoidBCELossNode Z("Z", &X, &Y, &W);
+  CheckOpBackward(&Z, 0);
 }
 
 TEST_F(LossBackwardTest, SigmoidBCELoss2) {
@@ -110,6 +168,19 @@ TEST_F(LossBackwardTest, SigmoidFocalLoss) {
   ConstantNode Y("Y", Shape(2, 3), TENSOR_INITIALIZER_TYPE_RAND, -1, 1);
   SigmoidFocalLossNode Z("Z", &X, &Y, 0.5, 2);
   CheckOpBackward(&Z, 0);
+
+  SigmoidFocalLossNode Z2("Z2", &X, &Y, 0.25, 0.5);
+  CheckOpBackward(&Z2, 0);
+}
+
+TEST_F(LossBackwardTest, SigmoidFocalLoss_multi_label) {
+  VariableNode X("X", Shape(100, 3), TENSOR_INITIALIZER_TYPE_RANDN, 0, 1);
+  ConstantNode Y("Y", Shape(100, 3), TENSOR_INITIALIZER_TYPE_RAND, -1, 1);
+  SigmoidFocalLossNode Z("Z", &X, &Y, 0.25, 2);
+  CheckOpBackward(&Z, 0);
+
+  SigmoidFocalLossNode Z2("Z2", &X, &Y, 0.5, 0);
+  CheckOpBackward(&Z2, 0);
 }
 
 }  // namespace deepx_core
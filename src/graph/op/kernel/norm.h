@@ -0,0 +1,93 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#pragma once
+#include <deepx_core/graph/op_impl.h>
+#include <cmath>
+
+namespace deepx_core {
+
+// Moments of normalization ops are computed in one pass with shifted data,
+// var = E[(x - K)^2] - (E[x - K])^2, where K is the first sample. Shifting
+// by a sample close to the mean avoids the cancellation of the naive
+// E[x^2] - E[x]^2, and unlike Welford's update it needs no division per
+// element, so that the accumulation vectorizes.
+//
+// The variance is the biased one.
+
+namespace detail {
+
+constexpr int NORM_LANE = 8;  // magic number
+
+template <typename T>
+void NormMomentsFinalize(int n, T K, T sum, T sum2, T* mean, T* var) noexcept {
+  T dmean = sum / n;
+  T _var = sum2 / n - dmean * dmean;
+  *mean = K + dmean;
+  *var = (_var > 0) ? _var : 0;
+}
+
+}  // namespace detail
+
+// Compute mean and var of 'n' elements of 'X'.
+template <typename T>
+void NormRowMoments(int n, const T* X, T* mean, T* var) noexcept {
+  using detail::NORM_LANE;
+  T K = X[0];
+  // two-level reduction, by lane and then across lanes
+  T sum[NORM_LANE] = {0}, sum2[NORM_LANE] = {0};
+  int i = 0;
+  for (; i + NORM_LANE <= n; i += NORM_LANE) {
+    for (int l = 0; l < NORM_LANE; ++l) {
+      T d = X[i + l] - K;
+      sum[l] += d;
+      sum2[l] += d * d;
+    }
+  }
+  T _sum = 0, _sum2 = 0;
+  for (; i < n; ++i) {
+    T d = X[i] - K;
+    _sum += d;
+    _sum2 += d * d;
+  }
+  for (int l = 0; l < NORM_LANE; ++l) {
+    _sum += sum[l];
+    _sum2 += sum2[l];
+  }
+  detail::NormMomentsFinalize(n, K, _sum, _sum2, mean, var);
+}
+
+// Compute mean and var of every column of row-major matrix 'X'(m, n).
+//
+// 'buf' has 2 * n elements.
+template <typename T>
+void NormColMoments(int m, int n, const T* X, T* mean, T* var,
+                    T* buf) noexcept {
+  const T* K = X;
+  T* sum = buf;
+  T* sum2 = buf + n;
+  for (int j = 0; j < n; ++j) {
+    sum[j] = 0;
+    sum2[j] = 0;
+  }
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      T d = X[j] - K[j];
+      sum[j] += d;
+      sum2[j] += d * d;
+    }
+    X += n;
+  }
+  for (int j = 0; j < n; ++j) {
+    detail::NormMomentsFinalize(m, K[j], sum[j], sum2[j], &mean[j], &var[j]);
+  }
+}
+
+// Compute inv_std = 1 / sqrt(var + eps).
+template <typename T>
+T NormInvStd(T var) noexcept {
+  return 1 / std::sqrt(var + (T)1e-6);  // magic number
+}
+
+}  // namespace deepx_core
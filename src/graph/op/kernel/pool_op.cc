@@ -307,6 +307,36 @@ int ComputeOffset(int di, int hi, int wi, int hw, int w, int stride) noexcept {
   return (di * hw + hi * w + wi) * stride;
 }
 
+// Avg pooling walks the window in the outer loops and the 'n' contiguous
+// channels of a position in the inner loop, which is vectorized for NHWC.
+template <typename T>
+void AvgPoolZero(int n, T* Z) noexcept {
+  for (int i = 0; i < n; ++i) {
+    Z[i] = 0;
+  }
+}
+
+template <typename T>
+void AvgPoolAdd(int n, const T* X, T* Z) noexcept {
+  for (int i = 0; i < n; ++i) {
+    Z[i] += X[i];
+  }
+}
+
+template <typename T>
+void AvgPoolScale(int n, T alpha, T* Z) noexcept {
+  for (int i = 0; i < n; ++i) {
+    Z[i] *= alpha;
+  }
+}
+
+template <typename T>
+void AvgPoolAxpy(int n, T alpha, const T* X, T* Y) noexcept {
+  for (int i = 0; i < n; ++i) {
+    Y[i] += alpha * X[i];
+  }
+}
+
 /************************************************************************/
 /* Pool */
 /************************************************************************/
@@ -506,14 +536,13 @@ void AvgPool1d(const Tensor<T>& X, Tensor<T>* Z, const PoolAux& aux) noexcept {
       int Z_offset = ComputeOffset(Z_wi, in_spatial_stride);
       int no_pad_total_dim = (X_wi_end - X_wi_start);
       int count = count_include_pad ? kernel_total_dim : no_pad_total_dim;
-      for (int in_i = 0; in_i < in_spatial_loop; ++in_i) {
-        T sum = 0;
-        for (int X_wi = X_wi_start; X_wi < X_wi_end; ++X_wi) {
-          int X_offset = ComputeOffset(X_wi, in_spatial_stride);
-          sum += _X[X_offset + in_i];
-        }
-        _Z[Z_offset + in_i] = sum / count;
+      T* Z_row = _Z + Z_offset;
+      AvgPoolZero(in_spatial_loop, Z_row);
+      for (int X_wi = X_wi_start; X_wi < X_wi_end; ++X_wi) {
+        int X_offset = ComputeOffset(X_wi, in_spatial_stride);
+        AvgPoolAdd(in_spatial_loop, _X + X_offset, Z_row);
       }
+      AvgPoolScale(in_spatial_loop, (T)1 / count, Z_row);
     }
     _X += X_out_spatial_stride;
     _Z += Z_out_spatial_stride;
@@ -551,17 +580,15 @@ void AvgPool2d(const Tensor<T>& X, Tensor<T>* Z, const PoolAux& aux) noexcept {
         int no_pad_total_dim =
             (X_hi_end - X_hi_start) * (X_wi_end - X_wi_start);
         int count = count_include_pad ? kernel_total_dim : no_pad_total_dim;
-        for (int in_i = 0; in_i < in_spatial_loop; ++in_i) {
-          T sum = 0;
-          for (int X_hi = X_hi_start; X_hi < X_hi_end; ++X_hi) {
-            for (int X_wi = X_wi_start; X_wi < X_wi_end; ++X_wi) {
-              int X_index =
-                  ComputeOffset(X_hi, X_wi, X_w, aux.in_spatial_stride) + in_i;
-              sum += _X[X_index];
-            }
+        T* Z_row = _Z + Z_offset;
+        AvgPoolZero(in_spatial_loop, Z_row);
+        for (int X_hi = X_hi_start; X_hi < X_hi_end; ++X_hi) {
+          for (int X_wi = X_wi_start; X_wi < X_wi_end; ++X_wi) {
+            int X_offset = ComputeOffset(X_hi, X_wi, X_w, in_spatial_stride);
+            AvgPoolAdd(in_spatial_loop, _X + X_offset, Z_row);
           }
-          _Z[Z_offset + in_i] = sum / count;
         }
+        AvgPoolScale(in_spatial_loop, (T)1 / count, Z_row);
       }
     }
     _X += X_out_spatial_stride;
@@ -611,20 +638,18 @@ void AvgPool3d(const Tensor<T>& X, Tensor<T>* Z, const PoolAux& aux) noexcept {
                                  (X_hi_end - X_hi_start) *
                                  (X_wi_end - X_wi_start);
           int count = count_include_pad ? kernel_total_dim : no_pad_total_dim;
-          for (int in_i = 0; in_i < in_spatial_loop; ++in_i) {
-            T sum = 0;
-            for (int X_di = X_di_start; X_di < X_di_end; ++X_di) {
-              for (int X_hi = X_hi_start; X_hi < X_hi_end; ++X_hi) {
-                for (int X_wi = X_wi_start; X_wi < X_wi_end; ++X_wi) {
-                  int X_index = ComputeOffset(X_di, X_hi, X_wi, X_hw, X_w,
-                                              in_spatial_stride) +
-                                in_i;
-                  sum += _X[X_index];
-                }
+          T* Z_row = _Z + Z_offset;
+          AvgPoolZero(in_spatial_loop, Z_row);
+          for (int X_di = X_di_start; X_di < X_di_end; ++X_di) {
+            for (int X_hi = X_hi_start; X_hi < X_hi_end; ++X_hi) {
+              for (int X_wi = X_wi_start; X_wi < X_wi_end; ++X_wi) {
+                int X_offset = ComputeOffset(X_di, X_hi, X_wi, X_hw, X_w,
+                                             in_spatial_stride);
+                AvgPoolAdd(in_spatial_loop, _X + X_offset, Z_row);
               }
             }
-            _Z[Z_offset + in_i] = sum / count;
           }
+          AvgPoolScale(in_spatial_loop, (T)1 / count, Z_row);
         }
       }
     }
@@ -881,11 +906,11 @@ void AvgPoolBackward1d(const Tensor<T>& /*X*/, const Tensor<T>& /*Z*/,
       int Z_offset = ComputeOffset(Z_wi, in_spatial_stride);
       int no_pad_total_dim = (X_wi_end - X_wi_start);
       int count = count_include_pad ? kernel_total_dim : no_pad_total_dim;
-      for (int in_i = 0; in_i < in_spatial_loop; ++in_i) {
-        T grad = _gZ[Z_offset + in_i] / count;
-        for (int X_wi = X_wi_start; X_wi < X_wi_end; ++X_wi) {
-          _gX[ComputeOffset(X_wi, in_spatial_stride) + in_i] += grad;
-        }
+      const T* gZ_row = _gZ + Z_offset;
+      T alpha = (T)1 / count;
+      for (int X_wi = X_wi_start; X_wi < X_wi_end; ++X_wi) {
+        int X_offset = ComputeOffset(X_wi, in_spatial_stride);
+        AvgPoolAxpy(in_spatial_loop, alpha, gZ_row, _gX + X_offset);
       }
     }
     _gX += X_out_spatial_stride;
@@ -926,14 +951,12 @@ void AvgPoolBackward2d(const Tensor<T>& /*X*/, const Tensor<T>& /*Z*/,
         int count = count_include_pad
                         ? kernel_total_dim
                         : (X_hi_end - X_hi_start) * (X_wi_end - X_wi_start);
-        for (int in_i = 0; in_i < in_spatial_loop; ++in_i) {
-          T grad = _gZ[Z_offset + in_i] / count;
-          for (int X_hi = X_hi_start; X_hi < X_hi_end; ++X_hi) {
-            for (int X_wi = X_wi_start; X_wi < X_wi_end; ++X_wi) {
-              int X_index =
-                  ComputeOffset(X_hi, X_wi, X_w, aux.in_spatial_stride) + in_i;
-              _gX[X_index] += grad;
-            }
+        const T* gZ_row = _gZ + Z_offset;
+        T alpha = (T)1 / count;
+        for (int X_hi = X_hi_start; X_hi < X_hi_end; ++X_hi) {
+          for (int X_wi = X_wi_start; X_wi < X_wi_end; ++X_wi) {
+            int X_offset = ComputeOffset(X_hi, X_wi, X_w, in_spatial_stride);
+            AvgPoolAxpy(in_spatial_loop, alpha, gZ_row, _gX + X_offset);
           }
         }
       }
@@ -987,16 +1010,14 @@ void AvgPoolBackward3d(const Tensor<T>& /*X*/, const Tensor<T>& /*Z*/,
                                  (X_hi_end - X_hi_start) *
                                  (X_wi_end - X_wi_start);
           int count = count_include_pad ? kernel_total_dim : no_pad_total_dim;
-          for (int in_i = 0; in_i < in_spatial_loop; ++in_i) {
-            T grad = _gZ[Z_offset + in_i] / count;
-            for (int X_di = X_di_start; X_di < X_di_end; ++X_di) {
-              for (int X_hi = X_hi_start; X_hi < X_hi_end; ++X_hi) {
-                for (int X_wi = X_wi_start; X_wi < X_wi_end; ++X_wi) {
-                  int X_index = ComputeOffset(X_di, X_hi, X_wi, X_hw, X_w,
-                                              in_spatial_stride) +
-                                in_i;
-                  _gX[X_index] += grad;
-                }
+          const T* gZ_row = _gZ + Z_offset;
+          T alpha = (T)1 / count;
+          for (int X_di = X_di_start; X_di < X_di_end; ++X_di) {
+            for (int X_hi = X_hi_start; X_hi < X_hi_end; ++X_hi) {
+              for (int X_wi = X_wi_start; X_wi < X_wi_end; ++X_wi) {
+                int X_offset = ComputeOffset(X_di, X_hi, X_wi, X_hw, X_w,
+                                             in_spatial_stride);
+                AvgPoolAxpy(in_spatial_loop, alpha, gZ_row, _gX + X_offset);
               }
             }
           }
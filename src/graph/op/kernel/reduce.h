@@ -0,0 +1,165 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#pragma once
+#include <deepx_core/graph/op_impl.h>
+
+namespace deepx_core {
+
+// Reduction along an axis is canonicalized to a row-major (m, k, n) tensor,
+// where m is the pre axis dim, k is the axis dim and n is the post axis dim.
+//
+// If n is 1, a reduction is over a contiguous row.
+// Otherwise, it is over k rows of n contiguous elements, which are traversed
+// row by row, so that memory is accessed sequentially and the element-wise
+// work is vectorized across n.
+//
+// Sums are computed by blocked pairwise summation, whose error grows with
+// O(log(k)) instead of O(k).
+
+namespace detail {
+
+constexpr int REDUCE_LANE = 8;        // magic number
+constexpr int REDUCE_BLOCK = 128;     // magic number
+constexpr int REDUCE_ROW_BLOCK = 16;  // magic number
+
+template <typename T>
+struct ReduceIdentity {
+  T operator()(T x) const noexcept { return x; }
+};
+
+}  // namespace detail
+
+// Compute sum(func(X)) of 'n' contiguous elements.
+template <typename T, class Func>
+T ReduceSum(int n, const T* X, Func&& func) noexcept {
+  using detail::REDUCE_LANE;
+  if (n > detail::REDUCE_BLOCK) {
+    int h = n / 2 / REDUCE_LANE * REDUCE_LANE;
+    return ReduceSum(h, X, func) + ReduceSum(n - h, X + h, func);
+  }
+
+  T sum[REDUCE_LANE] = {0};
+  int i = 0;
+  for (; i + REDUCE_LANE <= n; i += REDUCE_LANE) {
+    for (int l = 0; l < REDUCE_LANE; ++l) {
+      sum[l] += func(X[i + l]);
+    }
+  }
+  T _sum = 0;
+  for (; i < n; ++i) {
+    _sum += func(X[i]);
+  }
+  for (int l = 0; l < REDUCE_LANE; ++l) {
+    _sum += sum[l];
+  }
+  return _sum;
+}
+
+template <typename T>
+T ReduceSum(int n, const T* X) noexcept {
+  return ReduceSum(n, X, detail::ReduceIdentity<T>());
+}
+
+// Return the size of 'buf' of 'ReduceSumRows'.
+inline int ReduceSumRowsBufferSize(int k, int n) noexcept {
+  int depth = 0;
+  while (k > detail::REDUCE_ROW_BLOCK) {
+    k -= k / 2;
+    ++depth;
+  }
+  return depth * n;
+}
+
+// Compute Z = sum(func(X), axis=0) of row-major 'X'(k, n).
+//
+// 'buf' has 'ReduceSumRowsBufferSize(k, n)' elements.
+template <typename T, class Func>
+void ReduceSumRows(int k, int n, const T* X, T* Z, T* buf,
+                   Func&& func) noexcept {
+  if (k > detail::REDUCE_ROW_BLOCK) {
+    int h = k / 2;
+    ReduceSumRows(h, n, X, Z, buf + n, func);
+    ReduceSumRows(k - h, n, X + h * n, buf, buf + n, func);
+    LLMath<T>::add(n, Z, buf, Z);
+    return;
+  }
+
+  for (int l = 0; l < n; ++l) {
+    Z[l] = func(X[l]);
+  }
+  for (int j = 1; j < k; ++j) {
+    X += n;
+    for (int l = 0; l < n; ++l) {
+      Z[l] += func(X[l]);
+    }
+  }
+}
+
+template <typename T>
+void ReduceSumRows(int k, int n, const T* X, T* Z, T* buf) noexcept {
+  ReduceSumRows(k, n, X, Z, buf, detail::ReduceIdentity<T>());
+}
+
+// Compute Z = max(X, axis=0) of row-major 'X'(k, n).
+template <typename T>
+void ReduceMaxRows(int k, int n, const T* X, T* Z) noexcept {
+  LLMath<T>::copy(n, X, Z);
+  for (int j = 1; j < k; ++j) {
+    X += n;
+    for (int l = 0; l < n; ++l) {
+      Z[l] = (X[l] > Z[l]) ? X[l] : Z[l];
+    }
+  }
+}
+
+// Compute Z = min(X, axis=0) of row-major 'X'(k, n).
+template <typename T>
+void ReduceMinRows(int k, int n, const T* X, T* Z) noexcept {
+  LLMath<T>::copy(n, X, Z);
+  for (int j = 1; j < k; ++j) {
+    X += n;
+    for (int l = 0; l < n; ++l) {
+      Z[l] = (X[l] < Z[l]) ? X[l] : Z[l];
+    }
+  }
+}
+
+// Compute Z = argmax(X, axis=0) of row-major 'X'(k, n),
+// the first index is returned if there are ties.
+//
+// 'buf' has 'n' elements.
+template <typename T>
+void ReduceArgMaxRows(int k, int n, const T* X, T* Z, T* buf) noexcept {
+  LLMath<T>::copy(n, X, buf);
+  LLMath<T>::zero(n, Z);
+  for (int j = 1; j < k; ++j) {
+    X += n;
+    for (int l = 0; l < n; ++l) {
+      int greater = X[l] > buf[l];
+      buf[l] = greater ? X[l] : buf[l];
+      Z[l] = greater ? (T)j : Z[l];
+    }
+  }
+}
+
+// Compute Z = argmin(X, axis=0) of row-major 'X'(k, n),
+// the first index is returned if there are ties.
+//
+// 'buf' has 'n' elements.
+template <typename T>
+void ReduceArgMinRows(int k, int n, const T* X, T* Z, T* buf) noexcept {
+  LLMath<T>::copy(n, X, buf);
+  LLMath<T>::zero(n, Z);
+  for (int j = 1; j < k; ++j) {
+    X += n;
+    for (int l = 0; l < n; ++l) {
+      int less = X[l] < buf[l];
+      buf[l] = less ? X[l] : buf[l];
+      Z[l] = less ? (T)j : Z[l];
+    }
+  }
+}
+
+}  // namespace deepx_core
@@ -3,6 +3,8 @@
 //
 
 #include <deepx_core/graph/op_impl.h>
+#include <cmath>
+#include "reduce.h"
 
 namespace deepx_core {
 namespace {
@@ -92,19 +94,20 @@ bool ReduceAxisInferShape(const Shape& X, Shape* Z) noexcept {
 
 template <typename T>
 struct ReduceAxisMutableAux {
-  Tensor<T> buf1;
-  Tensor<T> buf2;
+  Tensor<T> buf;
 };
 
 template <typename T>
 void ReduceAxisPrepare(const ReduceAxisAux& aux,
                        ReduceAxisMutableAux<T>* maux) {
   if (aux.n != 1) {
-    maux->buf1.resize(aux.k);
-    maux->buf2.resize(aux.k);
+    int buf_size = ReduceSumRowsBufferSize(aux.k, aux.n);
+    maux->buf.resize(buf_size < aux.n ? aux.n : buf_size);
   }
 }
 
+// If n is 1, 'Meta::Forward' reduces a contiguous row,
+// otherwise, 'Meta::ForwardRows' reduces rows of an (k, n) block.
 template <typename T, class Meta>
 void ReduceAxis(const Tensor<T>& X, Tensor<T>* Z, const ReduceAxisAux& aux,
                 ReduceAxisMutableAux<T>* maux) noexcept {
@@ -118,34 +121,23 @@ void ReduceAxis(const Tensor<T>& X, Tensor<T>* Z, const ReduceAxisAux& aux,
       _Z += 1;
     }
   } else {
-    const T* __X;
-    const T* ___X;
-    T* __Z;
-    T* buf1 = maux->buf1.data();
+    T* buf = maux->buf.data();
     for (int i = 0; i < m; ++i) {
-      __X = _X;
-      __Z = _Z;
-      for (int jj = 0; jj < n; ++jj) {
-        ___X = __X;
-        for (int j = 0; j < k; ++j) {
-          buf1[j] = *___X;
-          ___X += n;
-        }
-        Meta::Forward(k, buf1, __Z);
-        __X += 1;
-        __Z += 1;
-      }
+      Meta::ForwardRows(k, n, _X, _Z, buf);
       _X += k * n;
       _Z += n;
     }
   }
 }
 
+// If n is 1, 'Meta::Backward' computes the gradient of a contiguous row,
+// otherwise, 'Meta::BackwardRow' computes the gradient of every row of an
+// (k, n) block.
 template <typename T, class Meta>
 void ReduceAxisBackward(const Tensor<T>& X, const Tensor<T>& Z,
                         const Tensor<T>& gZ, Tensor<T>* gX,
                         const ReduceAxisAux& aux,
-                        ReduceAxisMutableAux<T>* maux) noexcept {
+                        ReduceAxisMutableAux<T>* /*maux*/) noexcept {
   int m = aux.m, n = aux.n, k = aux.k;
   const T* _X = X.data();
   const T* _Z = Z.data();
@@ -160,70 +152,69 @@ void ReduceAxisBackward(const Tensor<T>& X, const Tensor<T>& Z,
       _gX += k;
     }
   } else {
-    const T* __X;
-    const T* ___X;
-    const T* __Z;
-    const T* __gZ;
-    T* __gX;
-    T* ___gX;
-    T* buf1 = maux->buf1.data();
-    T* buf2 = maux->buf2.data();
     for (int i = 0; i < m; ++i) {
-      __X = _X;
-      __Z = _Z;
-      __gZ = _gZ;
-      __gX = _gX;
-      for (int jj = 0; jj < n; ++jj) {
-        ___X = __X;
-        ___gX = __gX;
-        for (int j = 0; j < k; ++j) {
-          buf1[j] = *___X;
-          buf2[j] = *___gX;
-          ___X += n;
-          ___gX += n;
-        }
-        Meta::Backward(k, buf1, __Z, __gZ, buf2);
-        ___X = __X;
-        ___gX = __gX;
-        for (int j = 0; j < k; ++j) {
-          *___gX = buf2[j];
-          ___gX += n;
-        }
-        __X += 1;
-        __Z += 1;
-        __gZ += 1;
-        __gX += 1;
+      for (int j = 0; j < k; ++j) {
+        Meta::BackwardRow(k, n, _X, _Z, _gZ, _gX);
+        _X += n;
+        _gX += n;
       }
-      _X += k * n;
       _Z += n;
       _gZ += n;
-      _gX += k * n;
     }
   }
 }
 
+template <typename T>
+struct ReduceAxisAbs {
+  T operator()(T x) const noexcept { return std::fabs(x); }
+};
+
+template <typename T>
+struct ReduceAxisSquare {
+  T operator()(T x) const noexcept { return x * x; }
+};
+
 template <typename T>
 struct ReduceAxisReduceSumMeta {
   static void Forward(int n, const T* X, T* Z) noexcept {
-    *Z = LLMath<T>::sum(n, X);
+    *Z = ReduceSum(n, X);
+  }
+
+  static void ForwardRows(int k, int n, const T* X, T* Z, T* buf) noexcept {
+    ReduceSumRows(k, n, X, Z, buf);
   }
 
   static void Backward(int n, const T* /*X*/, const T* /*Z*/, const T* gZ,
                        T* gX) noexcept {
     LLMath<T>::add_scalar(n, gX, *gZ, gX);
   }
+
+  static void BackwardRow(int /*k*/, int n, const T* /*X*/, const T* /*Z*/,
+                          const T* gZ, T* gX) noexcept {
+    LLMath<T>::add(n, gX, gZ, gX);
+  }
 };
 
 template <typename T>
 struct ReduceAxisReduceMeanMeta {
   static void Forward(int n, const T* X, T* Z) noexcept {
-    *Z = LLMath<T>::sum(n, X) / n;
+    *Z = ReduceSum(n, X) / n;
+  }
+
+  static void ForwardRows(int k, int n, const T* X, T* Z, T* buf) noexcept {
+    ReduceSumRows(k, n, X, Z, buf);
+    LLMath<T>::mul_scalar(n, Z, (T)1 / k, Z);
   }
 
   static void Backward(int n, const T* /*X*/, const T* /*Z*/, const T* gZ,
                        T* gX) noexcept {
     LLMath<T>::add_scalar(n, gX, *gZ / n, gX);
   }
+
+  static void BackwardRow(int k, int n, const T* /*X*/, const T* /*Z*/,
+                          const T* gZ, T* gX) noexcept {
+    LLMath<T>::axpy(n, (T)1 / k, gZ, gX);
+  }
 };
 
 template <typename T>
@@ -232,6 +223,10 @@ struct ReduceAxisReduceMaxMeta {
     *Z = LLMath<T>::max(n, X);
   }
 
+  static void ForwardRows(int k, int n, const T* X, T* Z, T* /*buf*/) noexcept {
+    ReduceMaxRows(k, n, X, Z);
+  }
+
   static void Backward(int n, const T* X, const T* Z, const T* gZ,
                        T* gX) noexcept {
     for (int i = 0; i < n; ++i) {
@@ -240,6 +235,13 @@ struct ReduceAxisReduceMaxMeta {
       }
     }
   }
+
+  static void BackwardRow(int /*k*/, int n, const T* X, const T* Z,
+                          const T* gZ, T* gX) noexcept {
+    for (int l = 0; l < n; ++l) {
+      gX[l] += (X[l] == Z[l]) ? gZ[l] : (T)0;
+    }
+  }
 };
 
 template <typename T>
@@ -248,6 +250,10 @@ struct ReduceAxisReduceMinMeta {
     *Z = LLMath<T>::min(n, X);
   }
 
+  static void ForwardRows(int k, int n, const T* X, T* Z, T* /*buf*/) noexcept {
+    ReduceMinRows(k, n, X, Z);
+  }
+
   static void Backward(int n, const T* X, const T* Z, const T* gZ,
                        T* gX) noexcept {
     for (int i = 0; i < n; ++i) {
@@ -256,12 +262,23 @@ struct ReduceAxisReduceMinMeta {
       }
     }
   }
+
+  static void BackwardRow(int /*k*/, int n, const T* X, const T* Z,
+                          const T* gZ, T* gX) noexcept {
+    for (int l = 0; l < n; ++l) {
+      gX[l] += (X[l] == Z[l]) ? gZ[l] : (T)0;
+    }
+  }
 };
 
 template <typename T>
 struct ReduceAxisReduceL1Meta {
   static void Forward(int n, const T* X, T* Z) noexcept {
-    *Z = LLMath<T>::norm1(n, X);
+    *Z = ReduceSum(n, X, ReduceAxisAbs<T>());
+  }
+
+  static void ForwardRows(int k, int n, const T* X, T* Z, T* buf) noexcept {
+    ReduceSumRows(k, n, X, Z, buf, ReduceAxisAbs<T>());
   }
 
   static void Backward(int n, const T* X, const T* /*Z*/, const T* gZ,
@@ -274,12 +291,24 @@ struct ReduceAxisReduceL1Meta {
       }
     }
   }
+
+  static void BackwardRow(int /*k*/, int n, const T* X, const T* /*Z*/,
+                          const T* gZ, T* gX) noexcept {
+    for (int l = 0; l < n; ++l) {
+      gX[l] += (X[l] > 0) ? gZ[l] : -gZ[l];
+    }
+  }
 };
 
 template <typename T>
 struct ReduceAxisReduceL2Meta {
   static void Forward(int n, const T* X, T* Z) noexcept {
-    *Z = LLMath<T>::norm2(n, X);
+    *Z = std::sqrt(ReduceSum(n, X, ReduceAxisSquare<T>()));
+  }
+
+  static void ForwardRows(int k, int n, const T* X, T* Z, T* buf) noexcept {
+    ReduceSumRows(k, n, X, Z, buf, ReduceAxisSquare<T>());
+    LLMath<T>::sqrt(n, Z, Z);
   }
 
   static void Backward(int n, const T* X, const T* Z, const T* gZ,
@@ -292,6 +321,14 @@ struct ReduceAxisReduceL2Meta {
       }
     }
   }
+
+  static void BackwardRow(int /*k*/, int n, const T* X, const T* Z,
+                          const T* gZ, T* gX) noexcept {
+    for (int l = 0; l < n; ++l) {
+      T z = (Z[l] > (T)1e-6) ? Z[l] : (T)1e-6;
+      gX[l] += X[l] * (gZ[l] / z);
+    }
+  }
 };
 
 template <typename T>
@@ -307,6 +344,10 @@ struct ReduceAxisArgMaxMeta {
     }
     *Z = (T)j;
   }
+
+  static void ForwardRows(int k, int n, const T* X, T* Z, T* buf) noexcept {
+    ReduceArgMaxRows(k, n, X, Z, buf);
+  }
 };
 
 template <typename T>
@@ -322,6 +363,10 @@ struct ReduceAxisArgMinMeta {
     }
     *Z = (T)j;
   }
+
+  static void ForwardRows(int k, int n, const T* X, T* Z, T* buf) noexcept {
+    ReduceArgMinRows(k, n, X, Z, buf);
+  }
 };
 
 #define DEFINE_REDUCE_AXIS_OP(name)                                     \
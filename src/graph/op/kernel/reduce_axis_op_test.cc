@@ -60,6 +60,51 @@ TEST_F(ArgAxisForwardTest, ArgMin_Xshape234_axis2) {
   CheckOpForward(&Y, 0, expected_Y);
 }
 
+TEST_F(ArgAxisForwardTest, ArgMax_Xshape232_axis1_tie) {
+  ConstantNode X("X", Shape(2, 3, 2), {1, 3,  //
+                                       2, 3,  //
+                                       2, 0,  //
+                                       5, 4,  //
+                                       5, 6,  //
+                                       0, 6});
+  ArgMaxNode Y("Y", &X, 1);
+  tsr_t expected_Y{{1, 0}, {0, 1}};
+  CheckOpForward(&Y, 0, expected_Y);
+}
+
+TEST_F(ArgAxisForwardTest, ArgMin_Xshape232_axis1_tie) {
+  ConstantNode X("X", Shape(2, 3, 2), {1, 3,  //
+                                       2, 3,  //
+                                       1, 0,  //
+                                       5, 4,  //
+                                       5, 6,  //
+                                       0, 4});
+  ArgMinNode Y("Y", &X, 1);
+  tsr_t expected_Y{{0, 2}, {2, 0}};
+  CheckOpForward(&Y, 0, expected_Y);
+}
+
+class ReduceAxisForwardTest : public testing::Test, public DataType {};
+
+TEST_F(ReduceAxisForwardTest, ReduceSum_Xshape2373_axis1) {
+  std::vector<double> values(2 * 37 * 3);
+  tsr_t expected_Z;
+  expected_Z.resize(2, 3);
+  expected_Z.zeros();
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 37; ++j) {
+      for (int l = 0; l < 3; ++l) {
+        double x = (i + 1) * (j - 18) + l;
+        values[(i * 37 + j) * 3 + l] = x;
+        expected_Z.data(i * 3 + l) += (float_t)x;
+      }
+    }
+  }
+  ConstantNode X("X", Shape(2, 37, 3), values);
+  ReduceSumNode Z("Z", &X, 1, 0);
+  CheckOpForward(&Z, 0, expected_Z);
+}
+
 class ReduceAxisBackwardTest : public testing::Test {
  protected:
   const std::vector<std::pair<Shape, int>> SHAPE_AXIS_PAIRS = {
@@ -67,7 +112,7 @@ class ReduceAxisBackwardTest : public testing::Test {
       {Shape(2, 3), 0},        {Shape(2, 3), 1},       {Shape(2, 3, 4), -1},
       {Shape(2, 3, 4), 0},     {Shape(2, 3, 4), 1},    {Shape(2, 3, 4), 0},
       {Shape(2, 3, 4, 5), -1}, {Shape(2, 3, 4, 5), 0}, {Shape(2, 3, 4, 5), 1},
-      {Shape(2, 3, 4, 5), 2},  {Shape(2, 3, 4, 5), 3}};
+      {Shape(2, 3, 4, 5), 2},  {Shape(2, 3, 4, 5), 3}, {Shape(2, 37, 3), 1}};
 };
 
 TEST_F(ReduceAxisBackwardTest, ReduceSum_keep_dim0) {
@@ -3,6 +3,7 @@
 //
 
 #include <deepx_core/graph/op_impl.h>
+#include "embedding_lookup.h"
 
 namespace deepx_core {
 namespace {
@@ -61,84 +62,45 @@ void TFEmbeddingLookup(const Tensor<I>& X, const Tensor<T>& W,
   }
 }
 
+template <typename T, typename I>
+void TFEmbeddingLookupPlanInit(const Tensor<I>& X, int Wcol,
+                               EmbeddingLookupPlan<T, I>* plan) {
+  auto func = [Wcol](int k, I /*j*/, int* Zoffset, int* col) {
+    *Zoffset = k * Wcol;
+    *col = Wcol;
+    return true;
+  };
+  EmbeddingLookupPlanInit(X.total_dim(), X.data(), func, plan);
+}
+
 template <typename T, typename I>
 void TFEmbeddingLookupBackward(const Tensor<I>& X, const Tensor<T>& W,
                                const Tensor<T>& /*Z*/, const Tensor<T>& gZ,
-                               SparseRowMatrix<T, I>* gW) noexcept {
+                               SparseRowMatrix<T, I>* gW,
+                               EmbeddingLookupPlan<T, I>* plan) {
   int Wrow = W.dim(0);
-  int Wcol = W.dim(1);
-  const I* _X = X.data();
-  const T* _gZ = gZ.data();
-
-  if (Wcol == 1) {
-    for (int i = 0; i < X.total_dim(); ++i) {
-      gW->get_scalar_no_init(*_X % Wrow) += *_gZ;
-      _X += 1;
-      _gZ += 1;
-    }
-  } else {
-    T* gWj;
-    for (int i = 0; i < X.total_dim(); ++i) {
-      gWj = gW->get_row_no_init(*_X % Wrow);
-      LLMath<T>::add(Wcol, _gZ, gWj, gWj);
-      _X += 1;
-      _gZ += Wcol;
-    }
-  }
+  TFEmbeddingLookupPlanInit(X, W.dim(1), plan);
+  EmbeddingLookupCopyBackward(
+      gZ, [gW, Wrow](I j) { return gW->get_row_no_init(j % Wrow); }, plan);
 }
 
 template <typename T, typename I>
 void TFEmbeddingLookup(const Tensor<I>& X, const SparseRowMatrix<T, I>& W,
-                       Tensor<T>* Z) noexcept {
-  int Wcol = W.col();
-  const I* _X = X.data();
-  T* _Z = Z->data();
-
-  if (Wcol == 1) {
-    for (int i = 0; i < X.total_dim(); ++i) {
-      *_Z = W.get_scalar_no_init(*_X);
-      _X += 1;
-      _Z += 1;
-    }
-  } else {
-    const T* Wj;
-    for (int i = 0; i < X.total_dim(); ++i) {
-      Wj = W.get_row_no_init(*_X);
-      if (Wj) {
-        LLMath<T>::copy(Wcol, Wj, _Z);
-      } else {
-        LLMath<T>::zero(Wcol, _Z);
-      }
-      _X += 1;
-      _Z += Wcol;
-    }
-  }
+                       Tensor<T>* Z, EmbeddingLookupPlan<T, I>* plan) {
+  TFEmbeddingLookupPlanInit(X, W.col(), plan);
+  EmbeddingLookupResolve([&W](I j) { W.prefetch_row(j); },
+                         [&W](I j) { return W.get_row_no_init(j); }, plan);
+  EmbeddingLookupCopy(*plan, Z);
 }
 
 template <typename T, typename I>
-void TFEmbeddingLookupBackward(const Tensor<I>& X,
-                               const SparseRowMatrix<T, I>& W,
+void TFEmbeddingLookupBackward(const Tensor<I>& /*X*/,
+                               const SparseRowMatrix<T, I>& /*W*/,
                                const Tensor<T>& /*Z*/, const Tensor<T>& gZ,
-                               SparseRowMatrix<T, I>* gW) noexcept {
-  int Wcol = W.col();
-  const I* _X = X.data();
-  const T* _gZ = gZ.data();
-
-  if (Wcol == 1) {
-    for (int i = 0; i < X.total_dim(); ++i) {
-      gW->get_scalar_no_init(*_X) += *_gZ;
-      _X += 1;
-      _gZ += 1;
-    }
-  } else {
-    T* gWj;
-    for (int i = 0; i < X.total_dim(); ++i) {
-      gWj = gW->get_row_no_init(*_X);
-      LLMath<T>::add(Wcol, _gZ, gWj, gWj);
-      _X += 1;
-      _gZ += Wcol;
-    }
-  }
+                               SparseRowMatrix<T, I>* gW,
+                               EmbeddingLookupPlan<T, I>* plan) {
+  EmbeddingLookupCopyBackward(
+      gZ, [gW](I j) { return gW->get_row_no_init(j); }, plan);
 }
 
 }  // namespace
@@ -172,6 +134,7 @@ class TFEmbeddingLookupOp : public OpImpl {
   tsr_t* Z_ = nullptr;
   tsr_t* gZ_ = nullptr;
   srm_t* gW_ = nullptr;
+  EmbeddingLookupPlan<float_t, int_t> plan_;
 
  public:
   DEFINE_OP_LIKE(TFEmbeddingLookupOp);
@@ -218,7 +181,7 @@ class TFEmbeddingLookupOp : public OpImpl {
         TFEmbeddingLookup(*X_, *Wtsr_, Z_);
         break;
       case TENSOR_TYPE_SRM:
-        TFEmbeddingLookup(*X_, *Wsrm_, Z_);
+        TFEmbeddingLookup(*X_, *Wsrm_, Z_, &plan_);
         break;
     }
   }
@@ -227,10 +190,10 @@ class TFEmbeddingLookupOp : public OpImpl {
     if (gW_) {
       switch (W_tensor_type_) {
         case TENSOR_TYPE_TSR:
-          TFEmbeddingLookupBackward(*X_, *Wtsr_, *Z_, *gZ_, gW_);
+          TFEmbeddingLookupBackward(*X_, *Wtsr_, *Z_, *gZ_, gW_, &plan_);
           break;
         case TENSOR_TYPE_SRM:
-          TFEmbeddingLookupBackward(*X_, *Wsrm_, *Z_, *gZ_, gW_);
+          TFEmbeddingLookupBackward(*X_, *Wsrm_, *Z_, *gZ_, gW_, &plan_);
           break;
       }
     }
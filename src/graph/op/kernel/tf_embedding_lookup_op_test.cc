@@ -77,30 +77,38 @@ TEST_F(TFEmbeddingLookupForwardTest, TFEmbeddingLookup_SRM_Wcol4) {
 
 class TFEmbeddingLookupBackwardTest : public TFEmbeddingLookupForwardTest {
  protected:
-  void TestTSR(const Shape& Wshape) {
+  // ids repeat and collide modulo row
+  const tsri_t dup_X_{{1, 11, 1}, {21, 1, 11}};
+
+ protected:
+  void TestTSR(const Shape& Wshape) { TestTSR(Wshape, X_); }
+
+  void TestTSR(const Shape& Wshape, const tsri_t& _X) {
     InstanceNode X("X", Shape(-1, 0), TENSOR_TYPE_TSRI);
     VariableNode W("W", Wshape, TENSOR_INITIALIZER_TYPE_RANDN, 0, 1);
     TFEmbeddingLookupNode Z("Z", &X, &W);
-    auto inst_initializer = [this](Instance* inst) {
-      inst->insert<tsri_t>("X") = X_;
+    auto inst_initializer = [&_X](Instance* inst) {
+      inst->insert<tsri_t>("X") = _X;
     };
     CheckOpBackward(&Z, 0, nullptr, nullptr, inst_initializer);
   }
 
-  void TestSRM(const Shape& Wshape) {
+  void TestSRM(const Shape& Wshape) { TestSRM(Wshape, X_); }
+
+  void TestSRM(const Shape& Wshape, const tsri_t& _X) {
     InstanceNode X("X", Shape(-1, 0), TENSOR_TYPE_TSRI);
     VariableNode W("W", Wshape, TENSOR_TYPE_SRM, TENSOR_INITIALIZER_TYPE_RANDN,
                    0, 1);
     TFEmbeddingLookupNode Z("Z", &X, &W);
-    auto post_param_initializer = [this](std::default_random_engine& engine,
-                                         TensorMap* param) {
+    auto post_param_initializer = [&_X](std::default_random_engine& engine,
+                                        TensorMap* param) {
       auto& W = param->get<srm_t>("W");
-      for (int i = 0; i < X_.total_dim(); ++i) {
-        W.get_row(engine, X_.data(i));
+      for (int i = 0; i < _X.total_dim(); ++i) {
+        W.get_row(engine, _X.data(i));
       }
     };
-    auto inst_initializer = [this](Instance* inst) {
-      inst->insert<tsri_t>("X") = X_;
+    auto inst_initializer = [&_X](Instance* inst) {
+      inst->insert<tsri_t>("X") = _X;
     };
     CheckOpBackward(&Z, 0, nullptr, post_param_initializer, inst_initializer);
   }
@@ -122,4 +130,12 @@ TEST_F(TFEmbeddingLookupBackwardTest, TFEmbeddingLookup_SRM_Wcol4) {
   TestSRM(Shape(0, 4));
 }
 
+TEST_F(TFEmbeddingLookupBackwardTest, TFEmbeddingLookup_TSR_duplicate) {
+  TestTSR(Shape(10, 4), dup_X_);
+}
+
+TEST_F(TFEmbeddingLookupBackwardTest, TFEmbeddingLookup_SRM_duplicate) {
+  TestSRM(Shape(0, 4), dup_X_);
+}
+
 }  // namespace deepx_core
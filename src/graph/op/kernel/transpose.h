@@ -4,6 +4,9 @@
 
 #pragma once
 #include <deepx_core/graph/op_impl.h>
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
 
 namespace deepx_core {
 
@@ -11,6 +14,12 @@ struct TransposeAux {
   Shape Z;
   Shape Xstrides;
   Shape Zstrides;
+  // canonical form, axes of dimension 1 are removed and
+  // axes adjacent in both X and Z are merged
+  int crank;
+  int cZ[SHAPE_MAX_RANK];
+  int cXstrides[SHAPE_MAX_RANK];
+  int cZstrides[SHAPE_MAX_RANK];
 };
 
 inline bool TransposePrepare(const Shape& X, const Shape& axes,
@@ -59,6 +68,29 @@ inline bool TransposePrepare(const Shape& X, const Shape& axes,
     Zstrides[i] = aux->Xstrides[axes[i]];
   }
   aux->Zstrides.assign(&Zstrides[0], &Zstrides[rank]);
+
+  int crank = 0;
+  for (int i = 0; i < rank; ++i) {
+    if (Zdims[i] == 1) {
+      continue;
+    }
+    if (crank > 0 &&
+        aux->cXstrides[crank - 1] == Zdims[i] * Zstrides[i]) {
+      aux->cZ[crank - 1] *= Zdims[i];
+      aux->cXstrides[crank - 1] = Zstrides[i];
+    } else {
+      aux->cZ[crank] = Zdims[i];
+      aux->cXstrides[crank] = Zstrides[i];
+      ++crank;
+    }
+  }
+  aux->crank = crank;
+  if (crank > 0) {
+    aux->cZstrides[crank - 1] = 1;
+    for (int i = crank - 2; i >= 0; --i) {
+      aux->cZstrides[i] = aux->cZ[i + 1] * aux->cZstrides[i + 1];
+    }
+  }
   return true;
 }
 
@@ -74,116 +106,241 @@ inline bool TransposeInferShape(const Shape& X, const Shape& axes,
 
 namespace detail {
 
-template <typename T>
-void Transpose(const T* X, T* Z, const TransposeAux& aux) {
-  int rank = aux.Z.rank();
-  if (rank == 1) {
-    LLMath<T>::copy(aux.Z.total_dim(), X, Z);
-  } else if (rank == 2) {
-    int i = 0;
-    int k = 0;
-    for (int i0 = 0; i0 < aux.Z[0]; ++i0) {
-      for (int i1 = 0; i1 < aux.Z[1]; ++i1) {
-        Z[i++] = X[k];
-        k += aux.Zstrides[1];
+// Call 'func(x, z)' for all indices of 'rank' axes,
+// 'x' and 'z' are the offsets in X and Z.
+template <class Func>
+void TransposeForEach(int rank, const int* dims, const int* Xstrides,
+                      const int* Zstrides, Func&& func) {
+  int index[SHAPE_MAX_RANK] = {0};
+  int x = 0, z = 0;
+  for (;;) {
+    func(x, z);
+    int j = rank - 1;
+    for (; j >= 0; --j) {
+      x += Xstrides[j];
+      z += Zstrides[j];
+      if (++index[j] < dims[j]) {
+        break;
       }
-      k -= aux.Z[1] * aux.Zstrides[1];
-      k += aux.Zstrides[0];
+      index[j] = 0;
+      x -= dims[j] * Xstrides[j];
+      z -= dims[j] * Zstrides[j];
     }
-  } else if (rank == 3) {
-    int i = 0;
-    int k = 0;
-    for (int i0 = 0; i0 < aux.Z[0]; ++i0) {
-      for (int i1 = 0; i1 < aux.Z[1]; ++i1) {
-        for (int i2 = 0; i2 < aux.Z[2]; ++i2) {
-          Z[i++] = X[k];
-          k += aux.Zstrides[2];
-        }
-        k -= aux.Z[2] * aux.Zstrides[2];
-        k += aux.Zstrides[1];
-      }
-      k -= aux.Z[1] * aux.Zstrides[1];
-      k += aux.Zstrides[0];
+    if (j < 0) {
+      break;
     }
-  } else {
-    int index[SHAPE_MAX_RANK] = {0};
-    int k = 0;
-    int carry;
-    Z[0] = X[k];
-    for (int i = 1; i < aux.Z.total_dim(); ++i) {
-      ++index[rank - 1];
-      k += aux.Zstrides[rank - 1];
-      carry = 0;
-      for (int j = rank - 1; j >= 0; --j) {
-        index[j] += carry;
-        k += carry * aux.Zstrides[j];
-        carry = index[j] == aux.Z[j];
-        if (carry) {
-          index[j] = 0;
-          k -= aux.Z[j] * aux.Zstrides[j];
-        } else {
-          break;
-        }
+  }
+}
+
+// dst[j * ld_dst + i] = src[i * ld_src + j], if 'ADD' is false.
+// dst[j * ld_dst + i] += src[i * ld_src + j], if 'ADD' is true.
+// 0 <= i < rows, 0 <= j < cols.
+template <bool ADD, typename T>
+void TransposeScalar(const T* src, int ld_src, T* dst, int ld_dst, int rows,
+                     int cols) noexcept {
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      if (ADD) {
+        dst[j * ld_dst + i] += src[i * ld_src + j];
+      } else {
+        dst[j * ld_dst + i] = src[i * ld_src + j];
       }
-      Z[i] = X[k];
     }
   }
 }
 
-template <typename T>
-void TransposeBackward(const T* gZ, T* gX, const TransposeAux& aux) {
-  int rank = aux.Z.rank();
-  if (rank == 1) {
-    LLMath<T>::add(aux.Z.total_dim(), gZ, gX, gX);
-  } else if (rank == 2) {
-    int i = 0;
-    int k = 0;
-    for (int i0 = 0; i0 < aux.Z[0]; ++i0) {
-      for (int i1 = 0; i1 < aux.Z[1]; ++i1) {
-        gX[k] += gZ[i++];
-        k += aux.Zstrides[1];
+template <bool ADD, typename T>
+struct TransposeTile {
+  static void Run(const T* src, int ld_src, T* dst, int ld_dst, int rows,
+                  int cols) noexcept {
+    TransposeScalar<ADD>(src, ld_src, dst, ld_dst, rows, cols);
+  }
+};
+
+#if defined(__AVX__)
+template <bool ADD>
+void Transpose8x8(const float* src, int ld_src, float* dst,
+                  int ld_dst) noexcept {
+  __m256 r0 = _mm256_loadu_ps(src + 0 * ld_src);
+  __m256 r1 = _mm256_loadu_ps(src + 1 * ld_src);
+  __m256 r2 = _mm256_loadu_ps(src + 2 * ld_src);
+  __m256 r3 = _mm256_loadu_ps(src + 3 * ld_src);
+  __m256 r4 = _mm256_loadu_ps(src + 4 * ld_src);
+  __m256 r5 = _mm256_loadu_ps(src + 5 * ld_src);
+  __m256 r6 = _mm256_loadu_ps(src + 6 * ld_src);
+  __m256 r7 = _mm256_loadu_ps(src + 7 * ld_src);
+  __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+  __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+  __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+  __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+  __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+  __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+  __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+  __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+  __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+  __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+  __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+  __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+  __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+  __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+  __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+  __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+  r0 = _mm256_permute2f128_ps(s0, s4, 0x20);
+  r1 = _mm256_permute2f128_ps(s1, s5, 0x20);
+  r2 = _mm256_permute2f128_ps(s2, s6, 0x20);
+  r3 = _mm256_permute2f128_ps(s3, s7, 0x20);
+  r4 = _mm256_permute2f128_ps(s0, s4, 0x31);
+  r5 = _mm256_permute2f128_ps(s1, s5, 0x31);
+  r6 = _mm256_permute2f128_ps(s2, s6, 0x31);
+  r7 = _mm256_permute2f128_ps(s3, s7, 0x31);
+  if (ADD) {
+    r0 = _mm256_add_ps(r0, _mm256_loadu_ps(dst + 0 * ld_dst));
+    r1 = _mm256_add_ps(r1, _mm256_loadu_ps(dst + 1 * ld_dst));
+    r2 = _mm256_add_ps(r2, _mm256_loadu_ps(dst + 2 * ld_dst));
+    r3 = _mm256_add_ps(r3, _mm256_loadu_ps(dst + 3 * ld_dst));
+    r4 = _mm256_add_ps(r4, _mm256_loadu_ps(dst + 4 * ld_dst));
+    r5 = _mm256_add_ps(r5, _mm256_loadu_ps(dst + 5 * ld_dst));
+    r6 = _mm256_add_ps(r6, _mm256_loadu_ps(dst + 6 * ld_dst));
+    r7 = _mm256_add_ps(r7, _mm256_loadu_ps(dst + 7 * ld_dst));
+  }
+  _mm256_storeu_ps(dst + 0 * ld_dst, r0);
+  _mm256_storeu_ps(dst + 1 * ld_dst, r1);
+  _mm256_storeu_ps(dst + 2 * ld_dst, r2);
+  _mm256_storeu_ps(dst + 3 * ld_dst, r3);
+  _mm256_storeu_ps(dst + 4 * ld_dst, r4);
+  _mm256_storeu_ps(dst + 5 * ld_dst, r5);
+  _mm256_storeu_ps(dst + 6 * ld_dst, r6);
+  _mm256_storeu_ps(dst + 7 * ld_dst, r7);
+}
+
+template <bool ADD>
+struct TransposeTile<ADD, float> {
+  static void Run(const float* src, int ld_src, float* dst, int ld_dst,
+                  int rows, int cols) noexcept {
+    int j = 0;
+    for (; j + 8 <= cols; j += 8) {
+      int i = 0;
+      for (; i + 8 <= rows; i += 8) {
+        Transpose8x8<ADD>(src + i * ld_src + j, ld_src, dst + j * ld_dst + i,
+                          ld_dst);
       }
-      k -= aux.Z[1] * aux.Zstrides[1];
-      k += aux.Zstrides[0];
+      TransposeScalar<ADD>(src + i * ld_src + j, ld_src, dst + j * ld_dst + i,
+                           ld_dst, rows - i, 8);
     }
-  } else if (rank == 3) {
-    int i = 0;
-    int k = 0;
-    for (int i0 = 0; i0 < aux.Z[0]; ++i0) {
-      for (int i1 = 0; i1 < aux.Z[1]; ++i1) {
-        for (int i2 = 0; i2 < aux.Z[2]; ++i2) {
-          gX[k] += gZ[i++];
-          k += aux.Zstrides[2];
-        }
-        k -= aux.Z[2] * aux.Zstrides[2];
-        k += aux.Zstrides[1];
-      }
-      k -= aux.Z[1] * aux.Zstrides[1];
-      k += aux.Zstrides[0];
+    TransposeScalar<ADD>(src + j, ld_src, dst + j * ld_dst, ld_dst, rows,
+                         cols - j);
+  }
+};
+#endif
+
+// The same as 'TransposeScalar', but src and dst are processed tile by tile,
+// so that both the source tile and the destination tile stay in L1 cache.
+template <bool ADD, typename T>
+void TransposeBlock(const T* src, int ld_src, T* dst, int ld_dst, int rows,
+                    int cols) noexcept {
+  constexpr int TILE = 16;  // magic number
+  for (int i = 0; i < rows; i += TILE) {
+    int tile_rows = std::min(TILE, rows - i);
+    for (int j = 0; j < cols; j += TILE) {
+      int tile_cols = std::min(TILE, cols - j);
+      TransposeTile<ADD, T>::Run(src + i * ld_src + j, ld_src,
+                                 dst + j * ld_dst + i, ld_dst, tile_rows,
+                                 tile_cols);
     }
-  } else {
-    int index[SHAPE_MAX_RANK] = {0};
-    int k = 0;
-    int carry;
-    gX[0] = gZ[0];
-    for (int i = 1; i < aux.Z.total_dim(); ++i) {
-      ++index[rank - 1];
-      k += aux.Zstrides[rank - 1];
-      carry = 0;
-      for (int j = rank - 1; j >= 0; --j) {
-        index[j] += carry;
-        k += carry * aux.Zstrides[j];
-        carry = index[j] == aux.Z[j];
-        if (carry) {
-          index[j] = 0;
-          k -= aux.Z[j] * aux.Zstrides[j];
-        } else {
-          break;
-        }
+  }
+}
+
+// Split the canonical form into
+// 1. the last axis 'p' of Z,
+// 2. the axis 'q' whose stride in X is 1,
+// 3. other axes.
+struct TransposeSplit {
+  int p;
+  int q;
+  int rank;
+  int dims[SHAPE_MAX_RANK];
+  int Xstrides[SHAPE_MAX_RANK];
+  int Zstrides[SHAPE_MAX_RANK];
+
+  explicit TransposeSplit(const TransposeAux& aux) noexcept {
+    p = aux.crank - 1;
+    q = 0;
+    rank = 0;
+    for (int i = 0; i < p; ++i) {
+      if (aux.cXstrides[i] == 1) {
+        q = i;
+      } else {
+        dims[rank] = aux.cZ[i];
+        Xstrides[rank] = aux.cXstrides[i];
+        Zstrides[rank] = aux.cZstrides[i];
+        ++rank;
       }
-      gX[k] += gZ[i];
     }
   }
+};
+
+template <typename T>
+void Transpose(const T* X, T* Z, const TransposeAux& aux) {
+  if (aux.Z.total_dim() == 0) {
+    return;
+  }
+
+  int rank = aux.crank;
+  if (rank <= 1) {
+    LLMath<T>::copy(aux.Z.total_dim(), X, Z);
+    return;
+  }
+
+  if (aux.cXstrides[rank - 1] == 1) {
+    // The last axis is kept, copy rows.
+    int n = aux.cZ[rank - 1];
+    TransposeForEach(rank - 1, aux.cZ, aux.cXstrides, aux.cZstrides,
+                     [X, Z, n](int x, int z) {
+                       LLMath<T>::copy(n, X + x, Z + z);
+                     });
+    return;
+  }
+
+  TransposeSplit split(aux);
+  int p = split.p, q = split.q;
+  TransposeForEach(split.rank, split.dims, split.Xstrides, split.Zstrides,
+                   [X, Z, &aux, p, q](int x, int z) {
+                     TransposeBlock<false>(X + x, aux.cXstrides[p], Z + z,
+                                           aux.cZstrides[q], aux.cZ[p],
+                                           aux.cZ[q]);
+                   });
+}
+
+template <typename T>
+void TransposeBackward(const T* gZ, T* gX, const TransposeAux& aux) {
+  if (aux.Z.total_dim() == 0) {
+    return;
+  }
+
+  int rank = aux.crank;
+  if (rank <= 1) {
+    LLMath<T>::add(aux.Z.total_dim(), gZ, gX, gX);
+    return;
+  }
+
+  if (aux.cXstrides[rank - 1] == 1) {
+    // The last axis is kept, add rows.
+    int n = aux.cZ[rank - 1];
+    TransposeForEach(rank - 1, aux.cZ, aux.cXstrides, aux.cZstrides,
+                     [gZ, gX, n](int x, int z) {
+                       LLMath<T>::add(n, gZ + z, gX + x, gX + x);
+                     });
+    return;
+  }
+
+  TransposeSplit split(aux);
+  int p = split.p, q = split.q;
+  TransposeForEach(split.rank, split.dims, split.Xstrides, split.Zstrides,
+                   [gZ, gX, &aux, p, q](int x, int z) {
+                     TransposeBlock<true>(gZ + z, aux.cZstrides[q], gX + x,
+                                          aux.cXstrides[p], aux.cZ[q],
+                                          aux.cZ[p]);
+                   });
 }
 
 }  // namespace detail
@@ -136,6 +136,42 @@ TEST_F(TransposeForwardTest, Transpose_Xshape2345_axes2310) {
   Test(Shape(2, 3, 4, 5), Shape(2, 3, 1, 0), expected_Z);
 }
 
+TEST_F(TransposeForwardTest, Transpose_tiled) {
+  // Shapes larger than a tile, with axes of dimension 1 and adjacent axes.
+  const std::vector<std::pair<Shape, Shape>> SHAPE_AXES_PAIRS = {
+      {Shape(37, 45), Shape(1, 0)},
+      {Shape(3, 17, 40), Shape(0, 2, 1)},
+      {Shape(17, 3, 40), Shape(2, 1, 0)},
+      {Shape(2, 1, 19, 9), Shape(0, 3, 1, 2)},
+      {Shape(2, 5, 3, 16), Shape(0, 2, 1, 3)},
+      {Shape(2, 5, 3, 16), Shape(1, 3, 0, 2)},
+      {Shape(3, 4, 5, 6, 7), Shape(4, 1, 3, 0, 2)}};
+  for (const auto& entry : SHAPE_AXES_PAIRS) {
+    const Shape& Xshape = entry.first;
+    const Shape& axes = entry.second;
+    int rank = Xshape.rank();
+    int Xstrides[SHAPE_MAX_RANK];
+    Xstrides[rank - 1] = 1;
+    for (int i = rank - 2; i >= 0; --i) {
+      Xstrides[i] = Xshape[i + 1] * Xstrides[i + 1];
+    }
+
+    ConstantNode X("X", Xshape, TENSOR_INITIALIZER_TYPE_ZEROS, 0, 0);
+    TransposeNode Z("Z", &X, axes);
+    const Shape& Zshape = Z.shape();
+    tsr_t expected_Z(Zshape);
+    for (int i = 0; i < Zshape.total_dim(); ++i) {
+      int k = 0;
+      for (int j = rank - 1, index = i; j >= 0; --j) {
+        k += index % Zshape[j] * Xstrides[axes[j]];
+        index /= Zshape[j];
+      }
+      expected_Z.data(i) = (float_t)k;
+    }
+    Test(Xshape, axes, expected_Z);
+  }
+}
+
 class TransposeBackwardTest : public testing::Test {
  protected:
   const std::vector<std::pair<Shape, Shape>> SHAPE_AXES_PAIRS = {
@@ -148,7 +184,10 @@ class TransposeBackwardTest : public testing::Test {
       {Shape(2, 3, 4), Shape(1, 2, 0)},
       {Shape(2, 3, 4), Shape(2, 0, 1)},
       {Shape(2, 3, 4), Shape(2, 1, 0)},
-      {Shape(2, 3, 4, 5), Shape(2, 3, 0, 1)}};
+      {Shape(2, 3, 4, 5), Shape(2, 3, 0, 1)},
+      {Shape(9, 11), Shape(1, 0)},
+      {Shape(2, 1, 9, 10), Shape(0, 3, 1, 2)},
+      {Shape(2, 3, 4, 5), Shape(0, 2, 1, 3)}};
 };
 
 TEST_F(TransposeBackwardTest, Transpose) {
@@ -58,14 +58,22 @@ class VariableOp : public OpImpl {
   void InitForward() override {
     Any& Wany = param_->at(node_->name());
     switch (node_->tensor_type()) {
-      case TENSOR_TYPE_TSR: {
-        auto& W = Wany.unsafe_to_ref<tsr_t>();
-        InitPtrTSR(node_, &W);
-      } break;
-      case TENSOR_TYPE_SRM: {
-        auto& W = Wany.unsafe_to_ref<srm_t>();
-        InitPtrSRM(node_, &W);
-      } break;
+      case TENSOR_TYPE_TSR:
+        if (Wany.is<qtsr_t>()) {
+          InitPtrQTSR(node_, &Wany.unsafe_to_ref<qtsr_t>());
+        } else {
+          auto& W = Wany.unsafe_to_ref<tsr_t>();
+          InitPtrTSR(node_, &W);
+        }
+        break;
+      case TENSOR_TYPE_SRM:
+        if (Wany.is<qsrm_t>()) {
+          InitPtrQSRM(node_, &Wany.unsafe_to_ref<qsrm_t>());
+        } else {
+          auto& W = Wany.unsafe_to_ref<srm_t>();
+          InitPtrSRM(node_, &W);
+        }
+        break;
     }
   }
 };
@@ -4,7 +4,10 @@
 
 #include "op_test.h"
 #include <deepx_core/graph/graph.h>
+#include <deepx_core/graph/model.h>
 #include <deepx_core/graph/op_context.h>
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <string>
 #include <type_traits>  // std::is_same
@@ -22,6 +25,7 @@ class OpTestDataType : public DataType {
       std::is_same<float_t, double>::value ? (float_t)1e-6 : (float_t)1e-3;
   static constexpr float_t CHECK_GRAD_EPS =
       std::is_same<float_t, double>::value ? (float_t)1e-4 : (float_t)5e-2;
+  static constexpr float_t CHECK_QUANTIZED_EPS = (float_t)3e-2;
   static constexpr int FORWARD_SEED = 9527;  // magic number
   static const std::string LOSS_NAME;
 };
@@ -55,6 +59,8 @@ class OpTestContext : public OpTestDataType {
   void ComputeNumericalGrad(tsr_t* W, srm_t* G);
   void ComputeNumericalGrad(srm_t* W, srm_t* G);
   void CompareGrad();
+  void Predict(const inst_initializer_t& inst_initializer, TensorMap* param,
+               const GraphNode* node, tsr_t* forward);
 
  public:
   void CheckForward(GraphNode* node, int on_heap,
@@ -66,6 +72,11 @@ class OpTestContext : public OpTestDataType {
                      const param_initializer_t& pre_param_initializer,
                      const param_initializer_t& post_param_initializer,
                      const inst_initializer_t& inst_initializer);
+  void CheckPredictQuantized(
+      GraphNode* node, int on_heap,
+      const param_initializer_t& pre_param_initializer,
+      const param_initializer_t& post_param_initializer,
+      const inst_initializer_t& inst_initializer);
 };
 
 void OpTestContext::InitGraph(GraphNode* node, int on_heap,
@@ -293,6 +304,20 @@ void OpTestContext::CompareGrad() {
   }
 }
 
+void OpTestContext::Predict(const inst_initializer_t& inst_initializer,
+                            TensorMap* param, const GraphNode* node,
+                            tsr_t* forward) {
+  OpContext op_context;
+  if (inst_initializer) {
+    inst_initializer(op_context.mutable_hidden()->mutable_inst());
+  }
+  op_context.Init(&graph_, param);
+  ASSERT_TRUE(op_context.InitOp(std::vector<std::string>{node->name()}, -1));
+  op_context.InitPredict();
+  op_context.Predict();
+  *forward = *op_context.ptr().get<tsr_t*>(node->name());
+}
+
 void OpTestContext::CheckForward(
     GraphNode* node, int on_heap, const DataType::tsr_t& expected_forward,
     const param_initializer_t& pre_param_initializer,
@@ -335,6 +360,33 @@ void OpTestContext::CheckBackward(
   check();
 }
 
+void OpTestContext::CheckPredictQuantized(
+    GraphNode* node, int on_heap,
+    const param_initializer_t& pre_param_initializer,
+    const param_initializer_t& post_param_initializer,
+    const inst_initializer_t& inst_initializer) {
+  InitGraph(node, on_heap, 1);
+  InitParam(pre_param_initializer, post_param_initializer);
+
+  tsr_t expected_forward;
+  Predict(inst_initializer, &param_, node, &expected_forward);
+
+  Model model;
+  model.Init(&graph_);
+  *model.mutable_param() = param_;
+  ASSERT_GT(model.Quantize(), 0);
+  tsr_t forward;
+  Predict(inst_initializer, model.mutable_param(), node, &forward);
+
+  // Errors are relative to the largest magnitude.
+  float_t max_abs = 1;
+  for (int i = 0; i < expected_forward.total_dim(); ++i) {
+    max_abs = std::max(max_abs, std::fabs(expected_forward.data(i)));
+  }
+  EXPECT_TSR_NEAR_EPS(forward, expected_forward,
+                      CHECK_QUANTIZED_EPS * max_abs);
+}
+
 void CheckOpForward(GraphNode* node, int on_heap,
                     const DataType::tsr_t& expected_forward,
                     const param_initializer_t& pre_param_initializer,
@@ -355,4 +407,15 @@ void CheckOpBackward(GraphNode* node, int on_heap,
                                 post_param_initializer, inst_initializer);
 }
 
+void CheckOpPredictQuantized(
+    GraphNode* node, int on_heap,
+    const param_initializer_t& pre_param_initializer,
+    const param_initializer_t& post_param_initializer,
+    const inst_initializer_t& inst_initializer) {
+  OpTestContext op_test_context;
+  op_test_context.CheckPredictQuantized(node, on_heap, pre_param_initializer,
+                                        post_param_initializer,
+                                        inst_initializer);
+}
+
 }  // namespace deepx_core
@@ -35,5 +35,12 @@ void CheckOpBackward(
     const param_initializer_t& pre_param_initializer = nullptr,
     const param_initializer_t& post_param_initializer = nullptr,
     const inst_initializer_t& inst_initializer = nullptr);
+// Check predictions with params quantized by 'Model::Quantize' are close to
+// predictions with float params.
+void CheckOpPredictQuantized(
+    GraphNode* node, int on_heap,
+    const param_initializer_t& pre_param_initializer = nullptr,
+    const param_initializer_t& post_param_initializer = nullptr,
+    const inst_initializer_t& inst_initializer = nullptr);
 
 }  // namespace deepx_core
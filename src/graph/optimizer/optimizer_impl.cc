@@ -2,6 +2,7 @@
 // Author: Yafei Zhang (kimmyzhang@tencent.com)
 //
 
+#include <deepx_core/common/chunked_stream.h>
 #include <deepx_core/graph/optimizer_impl.h>
 
 namespace deepx_core {
@@ -190,10 +191,9 @@ bool OptimizerImpl::MergeLegacy(Optimizer* other, const Shard* shard,
   auto srm_reduce_func = [shard, shard_id](const std::string& name,
                                            srm_t& local_W, srm_t& remote_W) {
     DXINFO("Merging SRM %s...", name.c_str());
-    local_W.merge_if(
-        std::move(remote_W), [shard, shard_id](const srm_t::value_type& entry) {
-          return shard == nullptr || shard->HasSRM(shard_id, entry.first);
-        });
+    local_W.merge_if(std::move(remote_W), [shard, shard_id](int_t id) {
+      return shard == nullptr || shard->HasSRM(shard_id, id);
+    });
   };
   if (!Reduce(other, config_reduce_func, tsr_reduce_func, srm_reduce_func,
               shard, shard_id)) {
@@ -218,10 +218,9 @@ bool OptimizerImpl::Merge(Optimizer* other, const Shard* shard, int shard_id) {
   auto srm_reduce_func = [shard, shard_id](const std::string& name,
                                            srm_t& local_W, srm_t& remote_W) {
     DXINFO("Merging SRM %s...", name.c_str());
-    local_W.merge_if(
-        std::move(remote_W), [shard, shard_id](const srm_t::value_type& entry) {
-          return shard == nullptr || shard->HasSRM(shard_id, entry.first);
-        });
+    local_W.merge_if(std::move(remote_W), [shard, shard_id](int_t id) {
+      return shard == nullptr || shard->HasSRM(shard_id, id);
+    });
   };
   if (!Reduce(other, config_reduce_func, tsr_reduce_func, srm_reduce_func,
               shard, shard_id)) {
@@ -293,12 +292,47 @@ void OptimizerImpl::UpdateParam(const std::string& name, Any* Gany, Any* Wany) {
       auto& G = Gany->unsafe_to_ref<srm_t>();
       if (W.col() == G.col()) {
         ll_optimizer_t::Clip(&G);
-        UpdateSRM2SRM(name, G, &W, &srm_slot_map_[name]);
+        if (IsHalfDtype(W.storage_dtype())) {
+          UpdateHalfSRM2SRM(name, G, &W, &srm_slot_map_[name]);
+        } else {
+          UpdateSRM2SRM(name, G, &W, &srm_slot_map_[name]);
+        }
       }
     }
   }
 }
 
+void OptimizerImpl::UpdateHalfSRM2SRM(const std::string& name, const srm_t& G,
+                                      srm_t* W, OptimizerSRMSlot* slot) {
+  srm_t float_W;
+  float_W.set_col(W->col());
+  float_W.reserve(G.size());
+  if (use_lock_) {
+    for (const auto& entry : G) {
+      W->decode_row(entry.first, float_W.get_row_no_init(entry.first),
+                    slot->Wlock.get());
+    }
+  } else {
+    for (const auto& entry : G) {
+      W->decode_row(entry.first, float_W.get_row_no_init(entry.first));
+    }
+  }
+
+  UpdateSRM2SRM(name, G, &float_W, slot);
+
+  PhiloxEngine engine(++round_seed_);
+  if (use_lock_) {
+    for (const auto& entry : float_W) {
+      W->assign_stochastic(engine, entry.first, entry.second,
+                           slot->Wlock.get());
+    }
+  } else {
+    for (const auto& entry : float_W) {
+      W->assign_stochastic(engine, entry.first, entry.second);
+    }
+  }
+}
+
 bool OptimizerImpl::Reduce(Optimizer* other,
                            const config_reduce_func_t& config_reduce_func,
                            const tsr_reduce_func_t& tsr_reduce_func,
@@ -430,25 +464,21 @@ bool SaveOptimizerLegacy(const std::string& file, const Optimizer& optimizer) {
   return true;
 }
 
-bool SaveOptimizer(const std::string& file, const Optimizer& optimizer) {
-  AutoOutputFileStream os;
-  if (!os.Open(file)) {
-    DXERROR("Failed to open: %s.", file.c_str());
-    return false;
-  }
-
+bool SaveOptimizer(const std::string& file, const Optimizer& optimizer,
+                   size_t chunk_size, bool compress) {
   DXINFO("Saving optimizer to %s...", file.c_str());
-  std::string name = optimizer.class_name();
-  os << name;
-  if (!os) {
-    DXERROR("Failed to write optimizer.");
-    return false;
-  }
-
-  if (!optimizer.Write(os)) {
+  auto write = [&optimizer](OutputStream& os) {
+    std::string name = optimizer.class_name();
+    os << name;
+    if (!os) {
+      DXERROR("Failed to write optimizer.");
+      return false;
+    }
+    return optimizer.Write(os);
+  };
+  if (!SaveFile(file, chunk_size, write, compress)) {
     return false;
   }
-
   DXINFO("Done.");
   return true;
 }
@@ -482,7 +512,7 @@ std::unique_ptr<Optimizer> LoadOptimizerLegacy(const std::string& file) {
 }
 
 std::unique_ptr<Optimizer> LoadOptimizer(const std::string& file) {
-  AutoInputFileStream is;
+  ChunkedInputFileStream is;
   if (!is.Open(file)) {
     DXERROR("Failed to open: %s.", file.c_str());
     return nullptr;
@@ -510,7 +540,7 @@ std::unique_ptr<Optimizer> LoadOptimizer(const std::string& file) {
 }
 
 bool LoadOptimizerName(const std::string& file, std::string* name) {
-  AutoInputFileStream is;
+  ChunkedInputFileStream is;
   if (!is.Open(file)) {
     DXERROR("Failed to open: %s.", file.c_str());
     return false;
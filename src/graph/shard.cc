@@ -44,6 +44,29 @@ class ModuloShardFunc : public DataType {
   }
 };
 
+/************************************************************************/
+/* BucketShardFunc */
+/************************************************************************/
+// Parameters are hashed to 'Shard::BUCKET_SIZE' virtual buckets,
+// consecutive buckets are assigned to the same shard.
+//
+// When the shard size changes, a shard only needs the shards whose bucket
+// ranges overlap with its own.
+class BucketShardFunc : public DataType {
+ public:
+  static int TSRShardFunc(const std::string& name, int shard_size) noexcept {
+    int bucket = (int)((uint32_t)MurmurHash2(name) % Shard::BUCKET_SIZE);
+    return Shard::GetBucketShardId(bucket, shard_size);
+  }
+
+  static int SRMShardFunc(int_t id, int shard_size) noexcept {
+    // Fibonacci hashing, use the high 16 bits.
+    uint64_t h = (uint64_t)id * UINT64_C(0x9e3779b97f4a7c15);
+    int bucket = (int)(h >> 48);
+    return Shard::GetBucketShardId(bucket, shard_size);
+  }
+};
+
 /************************************************************************/
 /* ShardFuncMap */
 /************************************************************************/
@@ -108,6 +131,27 @@ class ModuloShardFuncRegister {
   }
 } modulo_shard_func_register;
 
+/************************************************************************/
+/* BucketShardFuncRegister */
+/************************************************************************/
+class BucketShardFuncRegister {
+ public:
+  BucketShardFuncRegister() {
+    ShardFuncMap::GetInstance().Register("bucket",
+                                         &BucketShardFunc::TSRShardFunc,
+                                         &BucketShardFunc::SRMShardFunc);
+  }
+} bucket_shard_func_register;
+
+int GCD(int a, int b) noexcept {
+  while (b != 0) {
+    int t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
 }  // namespace
 
 /************************************************************************/
@@ -148,6 +192,8 @@ bool LoadShard(const std::string& dir, Shard* shard) {
 /************************************************************************/
 /* Shard */
 /************************************************************************/
+constexpr int Shard::BUCKET_SIZE;
+
 void Shard::RegisterShardFunc(const std::string& shard_func_name,
                               const tsr_shard_func_t& tsr_shard_func,
                               const srm_shard_func_t& srm_shard_func) {
@@ -170,6 +216,32 @@ void Shard::InitShard(int shard_size, const std::string& shard_func_name) {
   _Init(1, shard_size, shard_func_name);
 }
 
+bool Shard::Overlap(int shard_id, const Shard& other,
+                    int other_shard_id) const {
+  if (shard_func_name_ != other.shard_func_name_) {
+    return true;
+  }
+
+  if (shard_func_name_ == "bucket") {
+    int begin, end, other_begin, other_end;
+    GetBucketRange(shard_id, shard_size_, &begin, &end);
+    GetBucketRange(other_shard_id, other.shard_size_, &other_begin,
+                   &other_end);
+    return begin < other_end && other_begin < end;
+  }
+
+  if (shard_func_name_ == "default" || shard_func_name_ == "modulo") {
+    // Both of them are 'hash % shard_size'.
+    // 'h % a == i' and 'h % b == j' have a solution,
+    // if and only if 'i % gcd(a, b) == j % gcd(a, b)'.
+    int gcd = GCD(shard_size_, other.shard_size_);
+    return shard_id % gcd == other_shard_id % gcd;
+  }
+
+  // unknown shard func
+  return shard_size_ != other.shard_size_ || shard_id == other_shard_id;
+}
+
 bool Shard::Write(OutputStream& os) const {
   int version = 0x203de81b;  // magic number version
   os << version;
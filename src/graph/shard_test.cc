@@ -0,0 +1,100 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/graph/shard.h>
+#include <deepx_core/tensor/data_type.h>
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+
+namespace deepx_core {
+
+class ShardTest : public testing::Test, public DataType {
+ protected:
+  // Check that 'Overlap' returns true for all observed shard id pairs.
+  // Return the number of overlapping shard id pairs.
+  static int TestOverlap(const std::string& shard_func_name, int shard_size,
+                         int other_shard_size) {
+    Shard shard, other;
+    shard.InitShard(shard_size, shard_func_name);
+    other.InitShard(other_shard_size, shard_func_name);
+
+    std::default_random_engine engine;
+    std::uniform_int_distribution<int_t> dist;
+    std::set<std::pair<int, int>> observed;
+    for (int i = 0; i < 100000; ++i) {
+      int_t id = dist(engine);
+      observed.emplace(shard.GetSRMShardId(id), other.GetSRMShardId(id));
+    }
+    for (int i = 0; i < 1000; ++i) {
+      std::string name = "W" + std::to_string(i);
+      observed.emplace(shard.GetTSRShardId(name), other.GetTSRShardId(name));
+    }
+    for (const auto& entry : observed) {
+      EXPECT_TRUE(shard.Overlap(entry.first, other, entry.second));
+    }
+
+    int overlap = 0;
+    for (int i = 0; i < shard_size; ++i) {
+      for (int j = 0; j < other_shard_size; ++j) {
+        if (shard.Overlap(i, other, j)) {
+          ++overlap;
+        }
+      }
+    }
+    return overlap;
+  }
+};
+
+TEST_F(ShardTest, BucketShardFunc) {
+  Shard shard;
+  shard.InitShard(7, "bucket");
+  int begin, end, prev_end = 0;
+  for (int i = 0; i < shard.shard_size(); ++i) {
+    Shard::GetBucketRange(i, shard.shard_size(), &begin, &end);
+    EXPECT_EQ(begin, prev_end);
+    EXPECT_LT(begin, end);
+    EXPECT_EQ(Shard::GetBucketShardId(begin, shard.shard_size()), i);
+    EXPECT_EQ(Shard::GetBucketShardId(end - 1, shard.shard_size()), i);
+    prev_end = end;
+  }
+  EXPECT_EQ(prev_end, Shard::BUCKET_SIZE);
+
+  for (int_t id = 0; id < 10000; ++id) {
+    int shard_id = shard.GetSRMShardId(id);
+    EXPECT_GE(shard_id, 0);
+    EXPECT_LT(shard_id, shard.shard_size());
+  }
+}
+
+TEST_F(ShardTest, Overlap_default) {
+  EXPECT_EQ(TestOverlap("default", 4, 4), 4);
+  EXPECT_EQ(TestOverlap("default", 4, 8), 8);
+  EXPECT_EQ(TestOverlap("default", 8, 4), 8);
+  EXPECT_EQ(TestOverlap("default", 6, 4), 12);
+  EXPECT_EQ(TestOverlap("default", 3, 5), 15);
+}
+
+TEST_F(ShardTest, Overlap_bucket) {
+  EXPECT_EQ(TestOverlap("bucket", 4, 4), 4);
+  EXPECT_EQ(TestOverlap("bucket", 4, 8), 8);
+  EXPECT_EQ(TestOverlap("bucket", 8, 4), 8);
+  EXPECT_EQ(TestOverlap("bucket", 6, 4), 8);
+  EXPECT_EQ(TestOverlap("bucket", 3, 5), 7);
+}
+
+TEST_F(ShardTest, Overlap_different_shard_func) {
+  Shard shard, other;
+  shard.InitShard(4, "default");
+  other.InitShard(4, "bucket");
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      EXPECT_TRUE(shard.Overlap(i, other, j));
+    }
+  }
+}
+
+}  // namespace deepx_core
@@ -796,6 +796,56 @@ bool FuseTransposeIntoMatmulOrGEMMStage::TrySimplify(GraphNode* node) {
   return true;
 }
 
+/************************************************************************/
+/* RewriteReduceSumOfFMInteractionStage */
+/************************************************************************/
+bool RewriteReduceSumOfFMInteractionStage::MaySimplify(
+    const GraphNode* node) const noexcept {
+  if (node->type_index() != typeid(ReduceSumNode) || IsTarget(node)) {
+    return false;
+  }
+  const GraphNode* X = node->input(0);
+  if (X->type_index() != typeid(BatchFMInteractionNode) || IsTarget(X) ||
+      !IsSingleOutput(X)) {
+    return false;
+  }
+  return GetReducedAxis(node) > 0;
+}
+
+bool RewriteReduceSumOfFMInteractionStage::TrySimplify(GraphNode* node) {
+  GraphNode* X = node->input()[0]->input()[0];
+  std::string name = NewNodeName(node->name());
+  GraphNode* new_node;
+  if (GetReducedAxis(node) == 1) {
+    // sum of pairwise products, O(m * n) by sum-square minus square-sum
+    new_node = BatchGroupFMQuadratic2(name, X);
+  } else {
+    // pairwise inner products, by GEMM
+    new_node = BatchFMInnerProduct(name, X);
+  }
+  ctx_->item->Add(new_node);
+  ctx_->nodes_to_simp.PushBack(new_node);
+  ctx_->item->ReplaceInputOfAllOutputs(node->name(), new_node->name());
+  return true;
+}
+
+// Return the axis reduced by 'node' on a rank 3 'BatchFMInteraction',
+// or -1 if 'node' can't be rewritten.
+int RewriteReduceSumOfFMInteractionStage::GetReducedAxis(
+    const GraphNode* node) noexcept {
+  const auto* reduce_sum = (const ReduceSumNode*)node;
+  const Shape& Xshape = node->input(0)->shape();
+  if (reduce_sum->reduce_all() || reduce_sum->keep_dim() ||
+      !Xshape.is_rank(3)) {
+    return -1;
+  }
+  int axis = reduce_sum->axis();
+  if (!Xshape.real_axis(&axis)) {
+    return -1;
+  }
+  return axis;
+}
+
 /************************************************************************/
 /* RemoveInvolutionBase */
 /************************************************************************/
@@ -1061,6 +1111,7 @@ bool ArithmeticSimp::Simplify(SimpItem* mutable_item) const {
   stages.emplace_back(new RewriteInvStage(name(), &ctx));
   stages.emplace_back(new RewriteSuccessiveReshapeStage(name(), &ctx));
   stages.emplace_back(new FuseTransposeIntoMatmulOrGEMMStage(name(), &ctx));
+  stages.emplace_back(new RewriteReduceSumOfFMInteractionStage(name(), &ctx));
   stages.emplace_back(new RemoveInvInvolutionStage(name(), &ctx));
   stages.emplace_back(new RemoveNegateInvolutionStage(name(), &ctx));
   stages.emplace_back(
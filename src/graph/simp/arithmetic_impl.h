@@ -174,6 +174,18 @@ class FuseTransposeIntoMatmulOrGEMMStage : public SimpStage {
   bool TrySimplify(GraphNode* node) override;
 };
 
+class RewriteReduceSumOfFMInteractionStage : public SimpStage {
+ public:
+  DEFINE_SIMP_STAGE_LIKE(RewriteReduceSumOfFMInteractionStage);
+
+ public:
+  bool MaySimplify(const GraphNode* node) const noexcept override;
+  bool TrySimplify(GraphNode* node) override;
+
+ private:
+  static int GetReducedAxis(const GraphNode* node) noexcept;
+};
+
 #define DEFINE_REMOVE_INVOLUTION_LIKE(clazz_name)            \
   clazz_name(const std::string& simp_name, SimpContext* ctx) \
       : RemoveInvolutionBase(simp_name, #clazz_name, ctx) {}
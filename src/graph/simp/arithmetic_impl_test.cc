@@ -655,6 +655,49 @@ TEST_F(ArithmeticSimpStageTest, FuseTransposeIntoMatmulOrGEMMStage_GEMM) {
   AssertInputsEQ(reduce_mean2->name(), {new_batch_gemm_name});
 }
 
+/*
+ * FMi is BatchFMInteractioni.
+ *
+ *  Sigmoid     Relu                      Sigmoid      Relu
+ *     |          |     ReduceSum3           |           |      ReduceSum3
+ * ReduceSum1 ReduceSum2    |          *BatchGroup- *BatchFM-       |
+ *     |          |        FM3     ->  FMQuadratic2 InnerProduct   FM3
+ *    FM1        FM2       /                 \           |         /
+ *      \_________|_______/                   \__________I________/
+ *                I
+ */
+TEST_F(ArithmeticSimpStageTest, RewriteReduceSumOfFMInteractionStage) {
+  shape.resize(2, 5, 4);
+  auto* I = new InstanceNode("I", shape, TENSOR_TYPE_TSR);
+  auto* fm1 = BatchFMInteraction("BatchFMInteraction1", I);
+  auto* fm2 = BatchFMInteraction("BatchFMInteraction2", I);
+  auto* fm3 = BatchFMInteraction("BatchFMInteraction3", I);
+  auto* reduce_sum1 = ReduceSum("ReduceSum1", fm1, 1, 0);
+  auto* reduce_sum2 = ReduceSum("ReduceSum2", fm2, -1, 0);
+  auto* reduce_sum3 = ReduceSum("ReduceSum3", fm3, 1, 1);
+  auto* sigmoid = Sigmoid("Sigmoid", reduce_sum1);
+  auto* relu = Relu("Relu", reduce_sum2);
+  ASSERT_TRUE(graph.Compile({sigmoid, relu, reduce_sum3}, 1));
+  item.FromGraph(graph);
+
+  stage.reset(new RewriteReduceSumOfFMInteractionStage(simp_name, &ctx));
+  SimplifyTwice();
+  ASSERT_EQ(7, item.node_size());
+
+  std::string new_quadratic_name = ScopedName("ReduceSum1");
+  AssertTypeEQ(new_quadratic_name, typeid(BatchGroupFMQuadratic2Node));
+  std::string new_inner_product_name = ScopedName("ReduceSum2");
+  AssertTypeEQ(new_inner_product_name, typeid(BatchFMInnerProductNode));
+
+  AssertNodesDeleted({fm1, fm2, reduce_sum1, reduce_sum2});
+
+  AssertInputsEQ(new_quadratic_name, {I->name()});
+  AssertInputsEQ(sigmoid->name(), {new_quadratic_name});
+  AssertInputsEQ(new_inner_product_name, {I->name()});
+  AssertInputsEQ(relu->name(), {new_inner_product_name});
+  AssertInputsEQ(reduce_sum3->name(), {fm3->name()});
+}
+
 /*
  *  Relu   Sigmoid
  *   |       |                 Sigmoid
@@ -0,0 +1,21 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#pragma once
+#include "simp_impl.h"
+
+namespace deepx_core {
+
+/************************************************************************/
+/* InferenceSimp */
+/************************************************************************/
+// Simplifications valid only when the graph is used for inference, e.g.
+// BatchNorm uses moving statistics rather than batch statistics.
+class InferenceSimp : public Simp {
+ public:
+  InferenceSimp();
+  bool Simplify(SimpItem* item) const override;
+};
+
+}  // namespace deepx_core
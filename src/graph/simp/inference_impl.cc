@@ -0,0 +1,93 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include "inference_impl.h"
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace deepx_core {
+
+/************************************************************************/
+/* FoldBatchNormIntoFullyConnectStage */
+/************************************************************************/
+bool FoldBatchNormIntoFullyConnectStage::MaySimplify(
+    const GraphNode* node) const noexcept {
+  if (node->type_index() != typeid(BatchNormNode) || IsTarget(node)) {
+    return false;
+  }
+  const GraphNode* X = node->input(0);
+  return X->type_index() == typeid(FullyConnectNode) && !IsTarget(X) &&
+         IsSingleOutput(X);
+}
+
+/*
+ * In inference, BatchNorm is an affine transform by moving statistics.
+ *
+ *   BatchNorm(X * W + b) = (X * W + b - mean) * scale + beta
+ *                        = X * (W * scale) + ((b - mean) * scale + beta)
+ *
+ * where scale = gamma / sqrt(var + eps).
+ */
+bool FoldBatchNormIntoFullyConnectStage::TrySimplify(GraphNode* node) {
+  GraphNode* fc = node->input()[0];
+  GraphNode* X = fc->input()[0];
+  GraphNode* W = fc->input()[1];
+  GraphNode* gamma = node->input()[1];
+  GraphNode* beta = node->input()[2];
+  GraphNode* mean = node->input()[3];
+  GraphNode* var = node->input()[4];
+  const std::string& name = node->name();
+  auto add = [this](GraphNode* new_node) {
+    ctx_->item->Add(new_node);
+    return new_node;
+  };
+
+  auto* eps = add(Constant(NewNodeName(name, "eps"), var->shape(), 1e-6));
+  auto* var_eps = add(Add(NewNodeName(name, "var_eps"), var, eps));
+  auto* stddev = add(Sqrt(NewNodeName(name, "std"), var_eps));
+  auto* scale = add(Div(NewNodeName(name, "scale"), gamma, stddev));
+  auto* new_W = add(BroadcastMul(NewNodeName(name, "W"), W, scale));
+  auto* mean_scale = add(Mul(NewNodeName(name, "mean_scale"), mean, scale));
+  auto* shift = add(Sub(NewNodeName(name, "shift"), beta, mean_scale));
+  GraphNode* new_b;
+  if (fc->input_size() == 3) {
+    GraphNode* b = fc->input()[2];
+    auto* b_scale = add(BroadcastMul(NewNodeName(name, "b_scale"), b, scale));
+    new_b = add(BroadcastAdd(NewNodeName(name, "b"), b_scale, shift));
+  } else {
+    new_b = add(Reshape2(NewNodeName(name, "b"), shift, Shape(1, -1)));
+  }
+  auto* new_node = add(FullyConnect(NewNodeName(name), X, new_W, new_b));
+  ctx_->nodes_to_simp.PushBack(new_node);
+  ctx_->item->ReplaceInputOfAllOutputs(name, new_node->name());
+  return true;
+}
+
+/************************************************************************/
+/* InferenceSimp */
+/************************************************************************/
+InferenceSimp::InferenceSimp() : Simp("inference") {}
+
+bool InferenceSimp::Simplify(SimpItem* mutable_item) const {
+  SimpContext ctx;
+  std::vector<std::unique_ptr<SimpStage>> stages;
+  stages.emplace_back(new FoldBatchNormIntoFullyConnectStage(name(), &ctx));
+  SimpPipeline pipeline(&ctx, std::move(stages));
+
+  ctx.Init(mutable_item);
+  bool simplified = false;
+  while (!ctx.nodes_to_simp.Empty()) {
+    GraphNode* node = ctx.nodes_to_simp.PopBack();
+    if (pipeline.TrySimplify(node)) {
+      simplified = true;
+    }
+  }
+  ctx.item->Prune();
+
+  return simplified;
+}
+
+}  // namespace deepx_core
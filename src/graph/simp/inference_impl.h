@@ -0,0 +1,20 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#pragma once
+#include "inference.h"
+#include "simp_stage.h"
+
+namespace deepx_core {
+
+class FoldBatchNormIntoFullyConnectStage : public SimpStage {
+ public:
+  DEFINE_SIMP_STAGE_LIKE(FoldBatchNormIntoFullyConnectStage);
+
+ public:
+  bool MaySimplify(const GraphNode* node) const noexcept override;
+  bool TrySimplify(GraphNode* node) override;
+};
+
+}  // namespace deepx_core
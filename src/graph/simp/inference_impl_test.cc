@@ -0,0 +1,132 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include "inference_impl.h"
+#include <deepx_core/graph/graph_simp.h>
+#include <deepx_core/graph/op_context.h>
+#include <deepx_core/graph/tensor_map.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "simp_test.h"
+
+namespace deepx_core {
+
+class InferenceSimpStageTest : public SimpStageTestBase {
+ protected:
+  void SetUp() override { simp_name = "inference_simp"; }
+};
+
+/*
+ *    Sigmoid1      Sigmoid2               Sigmoid1      Sigmoid2
+ *       |             |                      |             |
+ *   BatchNorm1    BatchNorm2     ->   *FullyConnect  *FullyConnect
+ *       |             |                 /    |   \     /    |   \
+ * FullyConnect1 FullyConnect2          I  *W1  *b1    I  *W2   *b2
+ *   /   |   \      /    |
+ *  I    W1   b1   I     W2
+ */
+TEST_F(InferenceSimpStageTest, FoldBatchNormIntoFullyConnectStage) {
+  auto* I = new InstanceNode("I", Shape(-1, 3), TENSOR_TYPE_TSR);
+  auto* W1 = new VariableNode("W1", Shape(3, 4));
+  auto* b1 = new VariableNode("b1", Shape(1, 4));
+  auto* W2 = new VariableNode("W2", Shape(3, 4));
+  auto* fc1 = FullyConnect("FullyConnect1", I, W1, b1);
+  auto* fc2 = FullyConnect("FullyConnect2", I, W2);
+  std::vector<GraphNode*> bn_inputs;
+  for (const char* name : {"gamma", "beta", "mean", "var"}) {
+    auto* node = new VariableNode(name, Shape(4));
+    node->set_need_grad(0);
+    bn_inputs.emplace_back(node);
+  }
+  auto* bn1 = new BatchNormNode("BatchNorm1", fc1, bn_inputs[0], bn_inputs[1],
+                                bn_inputs[2], bn_inputs[3]);
+  auto* bn2 = new BatchNormNode("BatchNorm2", fc2, bn_inputs[0], bn_inputs[1],
+                                bn_inputs[2], bn_inputs[3]);
+  auto* sigmoid1 = Sigmoid("Sigmoid1", bn1);
+  auto* sigmoid2 = Sigmoid("Sigmoid2", bn2);
+  ASSERT_TRUE(graph.Compile({sigmoid1, sigmoid2}, 0));
+  item.FromGraph(graph);
+
+  stage.reset(new FoldBatchNormIntoFullyConnectStage(simp_name, &ctx));
+  SimplifyTwice();
+
+  std::string new_fc1_name = ScopedName("BatchNorm1");
+  std::string new_fc2_name = ScopedName("BatchNorm2");
+  AssertTypeEQ(new_fc1_name, typeid(FullyConnectNode));
+  AssertTypeEQ(new_fc2_name, typeid(FullyConnectNode));
+
+  AssertNodesDeleted({fc1, fc2, bn1, bn2});
+
+  AssertInputsEQ(sigmoid1->name(), {new_fc1_name});
+  AssertInputsEQ(sigmoid2->name(), {new_fc2_name});
+  ASSERT_EQ(item.find_node(new_fc1_name)->input(0)->name(), I->name());
+  ASSERT_EQ(item.find_node(new_fc2_name)->input(0)->name(), I->name());
+}
+
+class InferenceSimpTest : public testing::Test, public DataType {
+ protected:
+  std::default_random_engine engine;
+  TensorMap param;
+  tsr_t X;
+
+ protected:
+  void InitParam(const std::string& name, const Shape& shape, float_t min,
+                 float_t max) {
+    auto& W = param.insert<tsr_t>(name);
+    W.resize(shape);
+    W.rand(engine, min, max);
+  }
+
+  tsr_t Predict(const Graph& graph, const std::string& target_name) {
+    OpContext op_context;
+    op_context.mutable_inst()->insert<tsr_t>("X") = X;
+    op_context.Init(&graph, &param);
+    DXCHECK_THROW(op_context.InitOp(std::vector<int>{0}, -1));
+    op_context.InitPredict();
+    op_context.Predict();
+    return op_context.hidden().get<tsr_t>(target_name);
+  }
+};
+
+TEST_F(InferenceSimpTest, FoldBatchNormIntoFullyConnect) {
+  int batch = 5, m = 3, n = 4;
+  auto* I = new InstanceNode("X", Shape(-1, m), TENSOR_TYPE_TSR);
+  auto* W = new VariableNode("W", Shape(m, n));
+  auto* b = new VariableNode("b", Shape(1, n));
+  auto* gamma = new VariableNode("gamma", Shape(n));
+  auto* beta = new VariableNode("beta", Shape(n));
+  auto* mean = new VariableNode("mean", Shape(n));
+  auto* var = new VariableNode("var", Shape(n));
+  mean->set_need_grad(0);
+  var->set_need_grad(0);
+  auto* fc = FullyConnect("FullyConnect", I, W, b);
+  auto* bn = new BatchNormNode("BatchNorm", fc, gamma, beta, mean, var);
+  auto* Z = Sigmoid("Z", bn);
+
+  Graph graph;
+  ASSERT_TRUE(graph.Compile({Z}, 0));
+  SimpConfig config;
+  config.inference = 1;
+  Graph simplified;
+  ASSERT_TRUE(Simplify(graph, config, &simplified));
+
+  InitParam("W", Shape(m, n), -1, 1);
+  InitParam("b", Shape(1, n), -1, 1);
+  InitParam("gamma", Shape(n), 0.5, 2);
+  InitParam("beta", Shape(n), -1, 1);
+  InitParam("mean", Shape(n), -1, 1);
+  InitParam("var", Shape(n), 0.5, 2);
+  X.resize(batch, m);
+  X.rand(engine, -1, 1);
+
+  tsr_t expected_Z = Predict(graph, "Z");
+  tsr_t Z2 = Predict(simplified, "Z");
+  ASSERT_EQ(Z2.shape(), expected_Z.shape());
+  for (int i = 0; i < expected_Z.total_dim(); ++i) {
+    EXPECT_NEAR(Z2.data(i), expected_Z.data(i), 1e-5);
+  }
+}
+
+}  // namespace deepx_core
@@ -10,6 +10,7 @@
 #include "arithmetic.h"
 #include "cf.h"
 #include "cse.h"
+#include "inference.h"
 
 namespace deepx_core {
 namespace {
@@ -18,6 +19,9 @@ using simps_t = std::vector<std::unique_ptr<Simp>>;
 
 simps_t GetSimps(const SimpConfig& config) {
   simps_t simps;
+  if (config.inference) {
+    simps.emplace_back(new InferenceSimp);
+  }
   simps.emplace_back(new ArithmeticSimp);
 
   CFConfig cf_config;
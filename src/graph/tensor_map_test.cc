@@ -68,6 +68,27 @@ TEST_F(TensorMapTest, WriteReadView) {
   EXPECT_EQ(tensor_map.get<tsrs_t>("4"), read_tensor_map.get<tsrs_t>("4"));
 }
 
+TEST_F(TensorMapTest, WriteRead_quantized) {
+  TensorMap quantized_tensor_map;
+  auto& qtsr = quantized_tensor_map.insert<qtsr_t>("0");
+  auto& qsrm = quantized_tensor_map.insert<qsrm_t>("1");
+  qtsr.quantize(tsr_t{{1, 2}, {3, 4}});
+  qsrm.quantize(srm_t{{0, 1, 2}, {{0, 0, 0}, {1, 1, 1}, {2, 2, 2}}});
+
+  OutputStringStream os;
+  InputStringStream is;
+
+  os << quantized_tensor_map;
+  ASSERT_TRUE(os);
+
+  is.SetView(os.GetBuf());
+  is >> read_tensor_map;
+  ASSERT_TRUE(is);
+
+  EXPECT_EQ(qtsr, read_tensor_map.get<qtsr_t>("0"));
+  EXPECT_EQ(qsrm, read_tensor_map.get<qsrm_t>("1"));
+}
+
 TEST_F(TensorMapTest, ClearSRMValue) {
   tensor_map.ClearSRMValue();
 
@@ -3,6 +3,7 @@
 // Author: Yafei Zhang (kimmyzhang@tencent.com)
 //
 
+#include <deepx_core/common/chunked_stream.h>
 #include <deepx_core/dx_log.h>
 #include <deepx_core/graph/ts_store.h>
 #include <cstdint>
@@ -147,14 +148,11 @@ bool TSStore::SaveLegacy(const std::string& file) const {
   return true;
 }
 
-bool TSStore::Save(const std::string& file) const {
-  AutoOutputFileStream os;
-  if (!os.Open(file)) {
-    DXERROR("Failed to open: %s.", file.c_str());
-    return false;
-  }
+bool TSStore::Save(const std::string& file, size_t chunk_size,
+                   bool compress) const {
   DXINFO("Saving TSStore to %s...", file.c_str());
-  if (!Write(os)) {
+  auto write = [this](OutputStream& os) { return Write(os); };
+  if (!SaveFile(file, chunk_size, write, compress)) {
     return false;
   }
   DXINFO("Done.");
@@ -176,7 +174,7 @@ bool TSStore::LoadLegacy(const std::string& file) {
 }
 
 bool TSStore::Load(const std::string& file) {
-  AutoInputFileStream is;
+  ChunkedInputFileStream is;
   if (!is.Open(file)) {
     DXERROR("Failed to open: %s.", file.c_str());
     return false;
@@ -27,14 +27,32 @@ bool DistMessage::HasResponse(int type) noexcept {
 
 OutputStringStream& operator<<(OutputStringStream& os,
                                const DistMessage& message) {
+  DistMessageSegments segments;
+  SerializeSegments(message, &segments);
+  os.clear();
+  os.Write(segments.head.data(), segments.head.size());
+  if (!segments.payload.empty()) {
+    os.Write(segments.payload.data(), segments.payload.size());
+  }
+  return os;
+}
+
+/************************************************************************/
+/* DistMessageSegments */
+/************************************************************************/
+void SerializeSegments(const DistMessage& message,
+                       DistMessageSegments* segments) {
+  OutputStringStream os;
+  os.SetView(&segments->head);
   os.BeginMessage();
   os << message.type();
+  const std::string* payload = nullptr;
   switch (message.type()) {
     case DIST_MESSAGE_TYPE_ECHO_REQUEST:
-      os << message.echo_request().buf;
+      payload = &message.echo_request().buf;
       break;
     case DIST_MESSAGE_TYPE_ECHO_RESPONSE:
-      os << message.echo_response().buf;
+      payload = &message.echo_response().buf;
       break;
     case DIST_MESSAGE_TYPE_HEART_BEAT_NOTIFY:
       break;
@@ -50,13 +68,13 @@ OutputStringStream& operator<<(OutputStringStream& os,
       os << message.file_finish_notify().loss_weight;
       break;
     case DIST_MESSAGE_TYPE_PULL_REQUEST:
-      os << message.pull_request().buf;
+      payload = &message.pull_request().buf;
       break;
     case DIST_MESSAGE_TYPE_PULL_RESPONSE:
-      os << message.pull_response().buf;
+      payload = &message.pull_response().buf;
       break;
     case DIST_MESSAGE_TYPE_PUSH_NOTIFY:
-      os << message.push_notify().buf;
+      payload = &message.push_notify().buf;
       break;
     case DIST_MESSAGE_TYPE_MODEL_SAVE_REQUEST:
       os << message.model_save_request().epoch;
@@ -68,17 +86,26 @@ OutputStringStream& operator<<(OutputStringStream& os,
     case DIST_MESSAGE_TYPE_TERMINATION_NOTIFY:
       break;
     case DIST_MESSAGE_TYPE_USER_REQUEST:
-      os << message.user_request().buf;
+      payload = &message.user_request().buf;
       break;
     case DIST_MESSAGE_TYPE_USER_RESPONSE:
-      os << message.user_response().buf;
+      payload = &message.user_response().buf;
       break;
     case DIST_MESSAGE_TYPE_USER_NOTIFY:
-      os << message.user_notify().buf;
+      payload = &message.user_notify().buf;
       break;
   }
-  os.EndMessage();
-  return os;
+
+  if (payload) {
+    // the size prefix of a serialized std::string
+    int payload_size = (int)payload->size();
+    os << payload_size;
+    segments->payload = const_string_view(payload->data(), payload->size());
+  } else {
+    segments->payload.clear();
+  }
+
+  *(int*)&segments->head[0] = (int)segments->size();
 }
 
 /************************************************************************/
@@ -5,6 +5,7 @@
 #include <deepx_core/common/stream.h>
 #include <deepx_core/ps/dist_message.h>
 #include <gtest/gtest.h>
+#include <string>
 
 namespace deepx_core {
 
@@ -30,4 +31,31 @@ TEST_F(DistMessageTest, WriteReadView) {
   EXPECT_EQ(message.pull_request().buf, read_message.pull_request().buf);
 }
 
+TEST_F(DistMessageTest, SerializeSegments) {
+  DistMessage message;
+  DistMessageSegments segments;
+  OutputStringStream os;
+  for (int type : {DIST_MESSAGE_TYPE_PUSH_NOTIFY,
+                   DIST_MESSAGE_TYPE_FILE_FINISH_NOTIFY,
+                   DIST_MESSAGE_TYPE_TERMINATION_NOTIFY}) {
+    message.set_type(type);
+    message.mutable_push_notify()->buf = "test";
+    message.mutable_file_finish_notify()->file = "file";
+    SerializeSegments(message, &segments);
+    os << message;
+    ASSERT_TRUE(os);
+
+    std::string packet = segments.head;
+    packet.append(segments.payload.data(), segments.payload.size());
+    EXPECT_EQ(packet, os.GetString());
+    EXPECT_EQ(segments.size(), packet.size());
+    if (type == DIST_MESSAGE_TYPE_PUSH_NOTIFY) {
+      // in place
+      EXPECT_EQ(segments.payload.data(), message.push_notify().buf.data());
+    } else {
+      EXPECT_TRUE(segments.payload.empty());
+    }
+  }
+}
+
 }  // namespace deepx_core
@@ -7,6 +7,7 @@
 #include <deepx_core/ps/tcp_connection.h>
 #include <chrono>
 #include <cstdint>
+#include <cstring>  // memcpy
 #include <limits>  // std::numeric_limits
 #include <sstream>
 #include <system_error>
@@ -15,12 +16,46 @@
 
 namespace deepx_core {
 
+/************************************************************************/
+/* TcpEndpoint */
+/************************************************************************/
+TcpEndpoint::ip_endpoint_t TcpEndpoint::to_tcp() const {
+  ip_endpoint_t endpoint;
+  if (is_unix() || size() > endpoint.capacity()) {
+    DXTHROW_INVALID_ARGUMENT("Not a tcp endpoint.");
+  }
+  memcpy(endpoint.data(), data(), size());
+  endpoint.resize(size());
+  return endpoint;
+}
+
+std::string TcpEndpoint::path() const {
+  if (!is_unix()) {
+    DXTHROW_INVALID_ARGUMENT("Not a unix domain socket endpoint.");
+  }
+#if OS_POSIX == 1
+  unix_endpoint_t endpoint;
+  memcpy(endpoint.data(), data(), size());
+  endpoint.resize(size());
+  return endpoint.path();
+#else
+  return std::string();
+#endif
+}
+
 /************************************************************************/
 /* TcpEndpoint functions */
 /************************************************************************/
+namespace {
+
+const char UNIX_PREFIX[] = "unix:";
+constexpr size_t UNIX_PREFIX_SIZE = sizeof(UNIX_PREFIX) - 1;
+
+}  // namespace
+
 TcpEndpoint MakeTcpEndpoint(const std::string& ip, int port) {
   std::error_code ec;
-  TcpEndpoint endpoint;
+  asio::ip::tcp::endpoint endpoint;
   endpoint.address(IpAddress::from_string(ip, ec));
   if (ec) {
     DXTHROW_INVALID_ARGUMENT("Invalid ip: %s.", ip.c_str());
@@ -34,13 +69,28 @@ TcpEndpoint MakeTcpEndpoint(const std::string& ip, int port) {
 }
 
 TcpEndpoint MakeTcpEndpoint(const std::string& addr) {
+  if (addr.compare(0, UNIX_PREFIX_SIZE, UNIX_PREFIX) == 0) {
+#if OS_POSIX == 1
+    std::string path = addr.substr(UNIX_PREFIX_SIZE);
+    // 'sun_path' is NUL-terminated.
+    if (path.empty() || path.size() >= sizeof(sockaddr_un::sun_path)) {
+      DXTHROW_INVALID_ARGUMENT("Invalid addr: %s.", addr.c_str());
+    }
+    return asio::local::stream_protocol::endpoint(path);
+#else
+    DXTHROW_INVALID_ARGUMENT(
+        "Unix domain sockets are not supported on this platform: %s.",
+        addr.c_str());
+#endif
+  }
+
   size_t semi = addr.rfind(':');
   if (semi == std::string::npos) {
     DXTHROW_INVALID_ARGUMENT("Invalid addr: %s.", addr.c_str());
   }
 
   std::error_code ec;
-  TcpEndpoint endpoint;
+  asio::ip::tcp::endpoint endpoint;
   endpoint.address(IpAddress::from_string(addr.substr(0, semi), ec));
   if (ec) {
     DXTHROW_INVALID_ARGUMENT("Invalid addr: %s.", addr.c_str());
@@ -67,8 +117,11 @@ std::vector<TcpEndpoint> MakeTcpEndpoints(const std::string& _addrs) {
 }
 
 std::string to_string(const TcpEndpoint& endpoint) {
+  if (endpoint.is_unix()) {
+    return UNIX_PREFIX + endpoint.path();
+  }
   std::ostringstream os;
-  os << endpoint;
+  os << endpoint.to_tcp();
   return os.str();
 }
 
@@ -99,12 +152,24 @@ MutableBuffers TcpConnection::GetInBuf() {
   }
 
   size_t in_buf_bytes = in_buf_.size();
+  if (in_bytes_ >= sizeof(int)) {
+    // The packet size is known,
+    // grow 'in_buf_' once to hold the whole packet.
+    int packet_bytes = *(const int*)in_buf_.data();
+    if (packet_bytes > 0 && (size_t)packet_bytes > in_buf_bytes) {
+      in_buf_bytes = (size_t)packet_bytes;
+      in_buf_.resize(in_buf_bytes);
+    }
+  }
+
   if (in_buf_bytes == in_bytes_) {
     // double 'in_buf_'
     in_buf_bytes = in_buf_bytes * 2;
     in_buf_.resize(in_buf_bytes);
-  } else if (in_bytes_ == 0 && in_buf_bytes > MAX_BUF_BYTES) {
-    // shrink 'in_buf_'
+  } else if (in_bytes_ == 0 && in_buf_bytes > MAX_BUF_BYTES &&
+             last_packet_bytes_ < in_buf_bytes / 4) {
+    // Shrink 'in_buf_' when it is mostly unused,
+    // it is kept for steady large messages.
     in_buf_bytes = INITIAL_BUF_BYTES;
     in_buf_.resize(in_buf_bytes);
     in_buf_.shrink_to_fit();
@@ -113,14 +178,23 @@ MutableBuffers TcpConnection::GetInBuf() {
 }
 
 void TcpConnection::PrepareOutBuf() {
-  out_stream_ << out_message_;
-  DXCHECK_THROW(out_stream_);
+  SerializeSegments(out_message_, &out_segments_);
   out_bytes_ = 0;
 }
 
-MutableBuffers TcpConnection::GetOutBuf() {
-  return asio::buffer((void*)(out_stream_.GetData() + out_bytes_),
-                      out_stream_.GetSize() - out_bytes_);
+ConstBuffers TcpConnection::GetOutBuf() const noexcept {
+  const char* data[2] = {out_segments_.head.data(),
+                         out_segments_.payload.data()};
+  size_t size[2] = {out_segments_.head.size(), out_segments_.payload.size()};
+  ConstBuffers bufs;
+  // skip written bytes
+  size_t skip = out_bytes_;
+  for (int i = 0; i < 2; ++i) {
+    size_t n = (skip < size[i]) ? skip : size[i];
+    bufs[i] = asio::buffer(data[i] + n, size[i] - n);
+    skip -= n;
+  }
+  return bufs;
 }
 
 int TcpConnection::TryReadMessage(size_t in_bytes) {
@@ -134,6 +208,7 @@ int TcpConnection::TryReadMessage(size_t in_bytes) {
   if (in_bytes_ < packet_bytes) {
     return 1;
   }
+  last_packet_bytes_ = packet_bytes;
 
   in_stream_.SetView(in_packet, packet_bytes);
   ReadView(in_stream_, in_message_);
@@ -179,7 +254,7 @@ int TcpConnection::WriteMessage() {
   std::error_code ec;
   size_t to_out_bytes, n;
   PrepareOutBuf();
-  to_out_bytes = out_stream_.GetSize();
+  to_out_bytes = out_segments_.size();
   while (to_out_bytes != 0) {
     n = socket_->write_some(GetOutBuf(), ec);
     if (ec) {
@@ -195,7 +270,7 @@ int TcpConnection::WriteMessage() {
 }
 
 int TcpConnection::OnWritten(size_t out_bytes) {
-  if ((out_bytes_ += out_bytes) == out_stream_.GetSize()) {
+  if ((out_bytes_ += out_bytes) == out_segments_.size()) {
     return 0;
   }
   return 1;
@@ -398,4 +473,114 @@ int TcpConnections::RpcUserNotify(const std::vector<int>* masks) {
   return Rpc(DIST_MESSAGE_TYPE_USER_NOTIFY, masks);
 }
 
+int TcpConnections::RpcAsync(int type, const std::vector<int>* masks,
+                             const callback_t& callback) {
+  if (masks) {
+    DXASSERT(size() == masks->size());
+  }
+
+  async_type_ = type;
+  async_callback_ = &callback;
+  async_error_ = 0;
+  async_begin_.resize(size());
+  latencies_.assign(size(), 0);
+  for (size_t i = 0; i < size(); ++i) {
+    if (masks == nullptr || (*masks)[i]) {
+      TcpConnection* conn = (*this)[i].get();
+      conn->mutable_out_message()->set_type(type);
+      conn->PrepareOutBuf();
+      async_begin_[i] = std::chrono::steady_clock::now();
+      AsyncWrite(i);
+    }
+  }
+
+  // 'io_' may have been stopped by the last run.
+  io_->restart();
+  io_->run();
+  async_callback_ = nullptr;
+  return async_error_ ? -1 : 0;
+}
+
+int TcpConnections::RpcPullRequestAsync(const std::vector<int>* masks,
+                                        const callback_t& callback) {
+  return RpcAsync(DIST_MESSAGE_TYPE_PULL_REQUEST, masks, callback);
+}
+
+int TcpConnections::RpcPushNotifyAsync(const std::vector<int>* masks) {
+  return RpcAsync(DIST_MESSAGE_TYPE_PUSH_NOTIFY, masks);
+}
+
+void TcpConnections::AsyncWrite(size_t i) {
+  TcpConnection* conn = (*this)[i].get();
+  conn->socket().async_write_some(
+      conn->GetOutBuf(),
+      [this, i](const std::error_code& ec, size_t out_bytes) {
+        if (ec) {
+          OnRpcAsyncError(i, "write to", ec);
+        } else {
+          OnWrite(i, out_bytes);
+        }
+      });
+}
+
+void TcpConnections::OnWrite(size_t i, size_t out_bytes) {
+  if ((*this)[i]->OnWritten(out_bytes) == 1) {
+    AsyncWrite(i);
+  } else if (DistMessage::HasResponse(async_type_)) {
+    // the response may have been partially read
+    OnRead(i, 0);
+  } else {
+    OnRpcAsync(i);
+  }
+}
+
+void TcpConnections::AsyncRead(size_t i) {
+  TcpConnection* conn = (*this)[i].get();
+  conn->socket().async_read_some(
+      conn->GetInBuf(), [this, i](const std::error_code& ec, size_t in_bytes) {
+        if (ec) {
+          OnRpcAsyncError(i, "read from", ec);
+        } else {
+          OnRead(i, in_bytes);
+        }
+      });
+}
+
+void TcpConnections::OnRead(size_t i, size_t in_bytes) {
+  TcpConnection* conn = (*this)[i].get();
+  switch (conn->TryReadMessage(in_bytes)) {
+    case 0:
+      OnRpcAsync(i);
+      break;
+    case 1:
+      AsyncRead(i);
+      break;
+    case -2:
+    default:
+      DXERROR("Failed to deserialize message from %s.",
+              to_string(conn->remote()).c_str());
+      conn->Close();
+      async_error_ = 1;
+      break;
+  }
+}
+
+void TcpConnections::OnRpcAsync(size_t i) {
+  latencies_[i] = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now() - async_begin_[i])
+                      .count();
+  if (*async_callback_) {
+    (*async_callback_)(i);
+  }
+}
+
+void TcpConnections::OnRpcAsyncError(size_t i, const char* op,
+                                     const std::error_code& ec) {
+  TcpConnection* conn = (*this)[i].get();
+  DXERROR("Failed to %s %s: %s.", op, to_string(conn->remote()).c_str(),
+          ec.message().c_str());
+  conn->Close();
+  async_error_ = 1;
+}
+
 }  // namespace deepx_core
@@ -2,8 +2,16 @@
 // Author: Yafei Zhang (kimmyzhang@tencent.com)
 //
 
+#include <deepx_core/common/stream.h>
+#include <deepx_core/ps/dist_message.h>
+#include <deepx_core/ps/rpc_server.h>
 #include <deepx_core/ps/tcp_connection.h>
+#include <deepx_core/ps/tcp_server.h>
 #include <gtest/gtest.h>
+#include <cstdio>  // std::remove
+#include <memory>
+#include <string>
+#include <thread>
 #include <vector>
 
 namespace deepx_core {
@@ -76,4 +84,169 @@ TEST_F(TcpEndpointTest, MakeTcpEndpoints) {
   EXPECT_EQ(endpoints[2].port(), 9529u);
 }
 
+#if OS_POSIX == 1
+TEST_F(TcpEndpointTest, MakeTcpEndpoint_unix) {
+  TcpEndpoint endpoint = MakeTcpEndpoint("unix:/tmp/deepx.sock");
+  EXPECT_TRUE(endpoint.is_unix());
+  EXPECT_EQ(endpoint.path(), "/tmp/deepx.sock");
+  EXPECT_EQ(to_string(endpoint), "unix:/tmp/deepx.sock");
+  EXPECT_ANY_THROW(endpoint.port());
+
+  endpoint = MakeTcpEndpoint("127.0.0.1:9527");
+  EXPECT_FALSE(endpoint.is_unix());
+  EXPECT_EQ(to_string(endpoint), "127.0.0.1:9527");
+  EXPECT_ANY_THROW(endpoint.path());
+
+  std::vector<TcpEndpoint> endpoints =
+      MakeTcpEndpoints("unix:/tmp/deepx.sock;127.0.0.1:9527");
+  EXPECT_EQ(endpoints.size(), 2u);
+  EXPECT_TRUE(endpoints[0].is_unix());
+  EXPECT_FALSE(endpoints[1].is_unix());
+
+  EXPECT_ANY_THROW(MakeTcpEndpoint("unix:"));
+  EXPECT_ANY_THROW(MakeTcpEndpoint("unix:/" + std::string(200, 'x')));
+}
+#else
+TEST_F(TcpEndpointTest, MakeTcpEndpoint_unix) {
+  EXPECT_ANY_THROW(MakeTcpEndpoint("unix:/tmp/deepx.sock"));
+  EXPECT_FALSE(MakeTcpEndpoint("127.0.0.1:9527").is_unix());
+}
+#endif
+
+class TcpConnectionTest : public testing::Test {
+ protected:
+  static int Echo(const std::string& request, std::string* response) {
+    *response = request;
+    return 0;
+  }
+};
+
+#if OS_POSIX == 1
+TEST_F(TcpConnectionTest, Rpc_unix) {
+  const int rpc_type_echo = 1;  // magic number
+  TcpServerConfig config;
+  config.listen_endpoint = MakeTcpEndpoint("unix:/tmp/deepx_tcp_test.sock");
+  RpcServer server;
+  server.set_config(config);
+  server.RegisterRequestHandler<std::string, std::string>(rpc_type_echo,
+                                                          &Echo);
+  std::thread server_thread([&server] { server.Run(); });
+
+  IoContext io;
+  TcpConnection conn(&io);
+  ASSERT_EQ(conn.ConnectRetry(config.listen_endpoint, 100, 1), 0);
+
+  std::string request((size_t)1024 * 1024, 'a');
+  std::string& buf = conn.mutable_out_message()->mutable_user_request()->buf;
+  OutputStringStream os;
+  os.SetView(&buf);
+  os << rpc_type_echo << request;
+  ASSERT_TRUE(os);
+  ASSERT_EQ(conn.RpcUserRequest(), 0);
+
+  const const_string_view& in_buf = conn.in_message().user_response().buf;
+  InputStringStream is;
+  is.SetView(in_buf.data(), in_buf.size());
+  int rpc_type;
+  std::string response;
+  is >> rpc_type >> response;
+  ASSERT_TRUE(is);
+  EXPECT_EQ(response, request);
+
+  ASSERT_EQ(conn.RpcTerminationNotify(), 0);
+  server_thread.join();
+}
+
+TEST_F(TcpConnectionTest, Rpc_unix_not_socket) {
+  // An ordinary file at the socket path is kept, and binding fails.
+  const std::string file = "/tmp/deepx_tcp_test.txt";
+  {
+    AutoOutputFileStream os;
+    ASSERT_TRUE(os.Open(file));
+    os << file;
+  }
+  TcpServerConfig config;
+  config.listen_endpoint = MakeTcpEndpoint("unix:" + file);
+  RpcServer server;
+  server.set_config(config);
+  EXPECT_ANY_THROW(server.Run());
+  EXPECT_TRUE(AutoFileSystem::Exists(file));
+  std::remove(file.c_str());
+}
+#endif
+
+class TcpConnectionsTest : public testing::Test {
+ protected:
+  static int Echo(const std::string& request, std::string* response) {
+    *response = request;
+    return 0;
+  }
+};
+
+TEST_F(TcpConnectionsTest, RpcAsync) {
+  const int shard_size = 3;
+  const int port = 61527;  // magic number
+  const int rpc_type_echo = 1;  // magic number
+  std::vector<std::unique_ptr<RpcServer>> servers(shard_size);
+  std::vector<std::thread> threads;
+  std::vector<TcpEndpoint> endpoints;
+  for (int i = 0; i < shard_size; ++i) {
+    TcpServerConfig config;
+    config.listen_endpoint = MakeTcpEndpoint("127.0.0.1", port + i);
+    servers[i].reset(new RpcServer);
+    servers[i]->set_config(config);
+    servers[i]->RegisterRequestHandler<std::string, std::string>(rpc_type_echo,
+                                                                 &Echo);
+    threads.emplace_back([&servers, i] { servers[i]->Run(); });
+    endpoints.emplace_back(config.listen_endpoint);
+  }
+
+  IoContext io;
+  TcpConnections conns(&io);
+  ASSERT_EQ(conns.ConnectRetry(endpoints, 100, 1), 0);
+
+  // Requests are large enough to be written and read in pieces.
+  std::vector<std::string> requests(shard_size);
+  OutputStringStream os;
+  for (int i = 0; i < shard_size; ++i) {
+    requests[i].assign((size_t)(i + 1) * 1024 * 1024, (char)('a' + i));
+    std::string& buf =
+        conns[i]->mutable_out_message()->mutable_user_request()->buf;
+    buf.clear();
+    os.SetView(&buf);
+    os << rpc_type_echo << requests[i];
+    ASSERT_TRUE(os);
+  }
+
+  std::vector<int> responses(shard_size);
+  auto callback = [&conns, &requests, &responses](size_t i) {
+    const const_string_view& buf = conns[i]->in_message().user_response().buf;
+    InputStringStream is;
+    is.SetView(buf.data(), buf.size());
+    int rpc_type;
+    std::string response;
+    is >> rpc_type >> response;
+    ASSERT_TRUE(is);
+    EXPECT_EQ(response, requests[i]);
+    ++responses[i];
+  };
+
+  std::vector<int> masks{1, 0, 1};
+  ASSERT_EQ(conns.RpcAsync(DIST_MESSAGE_TYPE_USER_REQUEST, &masks, callback),
+            0);
+  EXPECT_EQ(responses, masks);
+  EXPECT_GT(conns.latencies()[0], 0);
+  EXPECT_EQ(conns.latencies()[1], 0);
+  EXPECT_GT(conns.latencies()[2], 0);
+
+  ASSERT_EQ(conns.RpcAsync(DIST_MESSAGE_TYPE_USER_REQUEST, nullptr, callback),
+            0);
+  EXPECT_EQ(responses, std::vector<int>({2, 1, 2}));
+
+  ASSERT_EQ(conns.RpcTerminationNotify(), 0);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
 }  // namespace deepx_core
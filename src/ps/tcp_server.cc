@@ -4,11 +4,35 @@
 
 #include <deepx_core/dx_log.h>
 #include <deepx_core/ps/tcp_server.h>
+#if OS_POSIX == 1
+#include <sys/stat.h>  // lstat
+#include <unistd.h>    // unlink
+#endif
+#include <string>
 #include <system_error>
 #include <thread>
 #include <vector>
 
 namespace deepx_core {
+namespace {
+
+// Remove the socket file 'path', but never anything else at 'path'.
+void RemoveSocketFile(const std::string& path) {
+#if OS_POSIX == 1
+  struct stat buf;
+  if (lstat(path.c_str(), &buf) == 0) {
+    if (S_ISSOCK(buf.st_mode)) {
+      (void)unlink(path.c_str());
+    } else {
+      DXERROR("Not a socket file: %s.", path.c_str());
+    }
+  }
+#else
+  (void)path;
+#endif
+}
+
+}  // namespace
 
 void TcpServer::set_config(const TcpServerConfig& config) {
   DXCHECK_THROW(config.thread > 0);
@@ -20,6 +44,10 @@ void TcpServer::DeleteConnection(conn_t /*conn*/) {}
 void TcpServer::RunLoop() {
   DXINFO("Listening at %s.", to_string(config_.listen_endpoint).c_str());
   io_.reset(new IoContext);
+  if (config_.listen_endpoint.is_unix()) {
+    // Remove the socket file left by a previous server.
+    RemoveSocketFile(config_.listen_endpoint.path());
+  }
   acceptor_.reset(new TcpAcceptor(*io_, config_.listen_endpoint));
   AsyncAccept();
 
@@ -33,6 +61,9 @@ void TcpServer::RunLoop() {
   }
 
   acceptor_.reset();
+  if (config_.listen_endpoint.is_unix()) {
+    RemoveSocketFile(config_.listen_endpoint.path());
+  }
   DXINFO("Stopped.");
 }
 
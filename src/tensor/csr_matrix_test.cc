@@ -24,4 +24,15 @@ TEST_F(CSRMatrixTest, iterator) {
   EXPECT_EQ(sum_xij, (float_t)10);
 }
 
+TEST_F(CSRMatrixTest, append) {
+  csr_t X{{0, 1, 1, 4}, {1, 2, 3, 4}, {1, 2, 3, 4}};
+  csr_t Y;
+  Y.append(X, 0, 0);
+  EXPECT_EQ(Y, csr_t());
+  Y.append(X, 1, 3);
+  Y.append(X, 0, 1);
+  csr_t expected_Y{{0, 0, 3, 4}, {2, 3, 4, 1}, {2, 3, 4, 1}};
+  EXPECT_EQ(Y, expected_Y);
+}
+
 }  // namespace deepx_core
@@ -0,0 +1,106 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/tensor/half.h>
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace deepx_core {
+
+class HalfTest : public testing::Test {
+ protected:
+  const float NaN = std::numeric_limits<float>::quiet_NaN();
+  std::default_random_engine engine;
+};
+
+TEST_F(HalfTest, BF16) {
+  EXPECT_EQ(FloatToBF16(0.0f), 0x0000);
+  EXPECT_EQ(FloatToBF16(-0.0f), 0x8000);
+  EXPECT_EQ(FloatToBF16(1.0f), 0x3f80);
+  EXPECT_EQ(FloatToBF16(-2.0f), 0xc000);
+  // ties to even
+  EXPECT_EQ(FloatToBF16(1.00390625f), 0x3f80);
+  EXPECT_EQ(FloatToBF16(1.01171875f), 0x3f82);
+  EXPECT_EQ(FloatToBF16(std::numeric_limits<float>::infinity()), 0x7f80);
+  EXPECT_GT(FloatToBF16(NaN) & 0x7fff, 0x7f80);
+
+  EXPECT_EQ(BF16ToFloat(0x3f80), 1.0f);
+  EXPECT_EQ(BF16ToFloat(0xc000), -2.0f);
+  EXPECT_EQ(BF16ToFloat(0x3fc9), 1.5703125f);
+}
+
+TEST_F(HalfTest, FP16) {
+  EXPECT_EQ(FloatToFP16(0.0f), 0x0000);
+  EXPECT_EQ(FloatToFP16(-0.0f), 0x8000);
+  EXPECT_EQ(FloatToFP16(1.0f), 0x3c00);
+  EXPECT_EQ(FloatToFP16(-2.0f), 0xc000);
+  EXPECT_EQ(FloatToFP16(65504.0f), 0x7bff);
+  EXPECT_EQ(FloatToFP16(65520.0f), 0x7c00);
+  EXPECT_EQ(FloatToFP16(1e10f), 0x7c00);
+  // ties to even
+  EXPECT_EQ(FloatToFP16(1.00048828125f), 0x3c00);
+  EXPECT_EQ(FloatToFP16(1.00146484375f), 0x3c02);
+  // subnormal
+  EXPECT_EQ(FloatToFP16(5.9604644775390625e-8f), 0x0001);
+  EXPECT_EQ(FloatToFP16(6.103515625e-5f), 0x0400);
+  EXPECT_EQ(FloatToFP16(1e-10f), 0x0000);
+  EXPECT_GT(FloatToFP16(NaN) & 0x7fff, 0x7c00);
+
+  EXPECT_EQ(FP16ToFloat(0x3c00), 1.0f);
+  EXPECT_EQ(FP16ToFloat(0xc000), -2.0f);
+  EXPECT_EQ(FP16ToFloat(0x7bff), 65504.0f);
+  EXPECT_EQ(FP16ToFloat(0x0001), 5.9604644775390625e-8f);
+  EXPECT_EQ(FP16ToFloat(0x0400), 6.103515625e-5f);
+  EXPECT_EQ(FloatToFP16(FP16ToFloat(0x7c00)), 0x7c00);
+}
+
+TEST_F(HalfTest, RoundTrip) {
+  // NaN is excluded.
+  for (uint32_t h = 0; h < 0x10000; ++h) {
+    if ((h & 0x7fff) <= 0x7c00) {
+      EXPECT_EQ(FloatToFP16(FP16ToFloat((uint16_t)h)), h);
+    }
+    if ((h & 0x7fff) <= 0x7f80) {
+      EXPECT_EQ(FloatToBF16(BF16ToFloat((uint16_t)h)), h);
+    }
+  }
+}
+
+TEST_F(HalfTest, HalfEncodeDecode) {
+  std::vector<float> X = {0, 1, -2, 0.5f, 1024, -0.25f};
+  std::vector<uint16_t> Y(X.size());
+  std::vector<double> Z(X.size());
+  for (int dtype : {TENSOR_DTYPE_FLOAT16, TENSOR_DTYPE_BFLOAT16}) {
+    HalfEncode(dtype, (int)X.size(), X.data(), Y.data());
+    HalfDecode(dtype, (int)X.size(), Y.data(), Z.data());
+    for (size_t i = 0; i < X.size(); ++i) {
+      EXPECT_EQ(Z[i], X[i]);
+    }
+  }
+}
+
+TEST_F(HalfTest, HalfEncode_stochastic) {
+  // 1 + 2^-13 is 1/8 of the way from 1 to the next float16 1 + 2^-10.
+  const float x = 1 + 0.0001220703125f;
+  const int n = 20000;
+  std::vector<float> X(n, x);
+  std::vector<uint16_t> Y(n);
+  HalfEncode(TENSOR_DTYPE_FLOAT16, engine, n, X.data(), Y.data());
+  double sum = 0;
+  for (uint16_t h : Y) {
+    float y = FP16ToFloat(h);
+    EXPECT_TRUE(y == 1 || y == 1 + 0.0009765625f);
+    sum += y;
+  }
+  EXPECT_NEAR(sum / n, x, 2e-5);
+
+  // Rounding to nearest loses the update.
+  uint16_t h;
+  HalfEncode(TENSOR_DTYPE_FLOAT16, 1, &x, &h);
+  EXPECT_EQ(FP16ToFloat(h), 1);
+}
+
+}  // namespace deepx_core
@@ -0,0 +1,177 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/tensor/data_type.h>
+#include <deepx_core/tensor/philox.h>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace deepx_core {
+
+class PhiloxTest : public testing::Test, public DataTypeD {
+ protected:
+  PhiloxEngine engine;
+
+ protected:
+  static void CheckMoments(const std::vector<double>& X, double mean,
+                           double var, double eps) {
+    double sum = 0, sum2 = 0;
+    for (double x : X) {
+      sum += x;
+      sum2 += x * x;
+    }
+    double n = (double)X.size();
+    double _mean = sum / n;
+    EXPECT_NEAR(_mean, mean, eps);
+    EXPECT_NEAR(sum2 / n - _mean * _mean, var, eps);
+  }
+};
+
+TEST_F(PhiloxTest, Philox4x32) {
+  // known answers of Random123
+  uint32_t out[4];
+  const uint32_t ctr1[4] = {0, 0, 0, 0};
+  Philox4x32(ctr1, 0, out);
+  EXPECT_EQ(out[0], 0x6627e8d5u);
+  EXPECT_EQ(out[1], 0xe169c58du);
+  EXPECT_EQ(out[2], 0xbc57ac4cu);
+  EXPECT_EQ(out[3], 0x9b00dbd8u);
+
+  const uint32_t ctr2[4] = {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff};
+  Philox4x32(ctr2, 0xffffffffffffffff, out);
+  EXPECT_EQ(out[0], 0x408f276du);
+  EXPECT_EQ(out[1], 0x41c83b0eu);
+  EXPECT_EQ(out[2], 0xa20bc7c6u);
+  EXPECT_EQ(out[3], 0x6d5451fdu);
+
+  const uint32_t ctr3[4] = {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344};
+  Philox4x32(ctr3, 0x299f31d0a4093822, out);
+  EXPECT_EQ(out[0], 0xd16cfe09u);
+  EXPECT_EQ(out[1], 0x94fdccebu);
+  EXPECT_EQ(out[2], 0x5001e420u);
+  EXPECT_EQ(out[3], 0x24126ea1u);
+}
+
+TEST_F(PhiloxTest, PhiloxFill) {
+  // The counter crosses 2^64, the low word crosses 2^32.
+  const uint64_t key = 7;
+  const uint64_t stream = 0x123456789;
+  for (uint64_t counter : {(uint64_t)0, (uint64_t)0xfffffffa,
+                           (uint64_t)0xfffffffffffffffa}) {
+    for (int blocks : {0, 1, 7, 8, 9, 21}) {
+      std::vector<uint32_t> out(blocks * 4);
+      PhiloxFill(key, stream, counter, blocks, out.data());
+      for (int i = 0; i < blocks; ++i) {
+        uint64_t c = counter + i;
+        uint32_t ctr[4] = {(uint32_t)c, (uint32_t)(c >> 32), (uint32_t)stream,
+                           (uint32_t)(stream >> 32)};
+        uint32_t expected_out[4];
+        Philox4x32(ctr, key, expected_out);
+        for (int j = 0; j < 4; ++j) {
+          EXPECT_EQ(out[i * 4 + j], expected_out[j]);
+        }
+      }
+    }
+  }
+}
+
+TEST_F(PhiloxTest, PhiloxUniform) {
+  EXPECT_GT(PhiloxUniform<float>(0), 0);
+  EXPECT_LT(PhiloxUniform<float>(0xffffffff), 1);
+  EXPECT_GT(PhiloxUniform<double>(0), 0);
+  EXPECT_LT(PhiloxUniform<double>(0xffffffff), 1);
+}
+
+TEST_F(PhiloxTest, seed) {
+  PhiloxEngine engine1(1), engine2(1), engine3(2);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(engine1(), engine2());
+  }
+  engine2();
+  engine1.seed(2);
+  EXPECT_EQ(engine1(), engine3());
+}
+
+TEST_F(PhiloxTest, distribution) {
+  std::uniform_int_distribution<int> dist(0, 9);
+  std::vector<int> count(10);
+  for (int i = 0; i < 10000; ++i) {
+    ++count[dist(engine)];
+  }
+  for (int c : count) {
+    EXPECT_GT(c, 800);
+    EXPECT_LT(c, 1200);
+  }
+}
+
+TEST_F(PhiloxTest, uniform) {
+  for (int n : {1, 3, 255, 256, 257, 100000}) {
+    std::vector<double> X(n);
+    engine.uniform(n, X.data(), -1.0, 3.0);
+    for (double x : X) {
+      EXPECT_GT(x, -1);
+      EXPECT_LT(x, 3);
+    }
+    if (n == 100000) {
+      CheckMoments(X, 1, 16.0 / 12, 2e-2);
+    }
+  }
+}
+
+TEST_F(PhiloxTest, normal) {
+  for (int n : {1, 3, 255, 256, 257, 100000}) {
+    std::vector<double> X(n);
+    engine.normal(n, X.data(), 1.0, 2.0);
+    for (double x : X) {
+      EXPECT_LT(std::fabs(x - 1), 2 * 7);
+    }
+    if (n == 100000) {
+      CheckMoments(X, 1, 4, 5e-2);
+    }
+  }
+}
+
+TEST_F(PhiloxTest, keyed) {
+  const int n = 300;
+  std::vector<float> X1(n), X2(n), X3(n);
+  // Keyed generators do not depend on the state of the engine.
+  engine.normal(0, (uint64_t)5, n, X1.data(), 0.0f, 1.0f);
+  engine.normal(n, X2.data(), 0.0f, 1.0f);
+  engine.normal(0, (uint64_t)5, n, X2.data(), 0.0f, 1.0f);
+  EXPECT_EQ(X1, X2);
+  engine.normal(0, (uint64_t)6, n, X3.data(), 0.0f, 1.0f);
+  EXPECT_NE(X1, X3);
+  // Different salts give different values for the same key.
+  engine.normal(1, (uint64_t)5, n, X3.data(), 0.0f, 1.0f);
+  EXPECT_NE(X1, X3);
+
+  engine.uniform(0, (uint64_t)5, n, X1.data(), 0.0f, 1.0f);
+  engine.uniform(0, (uint64_t)5, n, X2.data(), 0.0f, 1.0f);
+  EXPECT_EQ(X1, X2);
+  // A prefix is the same.
+  engine.uniform(0, (uint64_t)5, 17, X3.data(), 0.0f, 1.0f);
+  for (int i = 0; i < 17; ++i) {
+    EXPECT_EQ(X3[i], X1[i]);
+  }
+  // Keyed generators do not overlap sequential ones.
+  engine.seed(0);
+  engine.uniform(n, X3.data(), 0.0f, 1.0f);
+  engine.uniform(0, (uint64_t)0, n, X2.data(), 0.0f, 1.0f);
+  EXPECT_NE(X2, X3);
+}
+
+TEST_F(PhiloxTest, Tensor_randn_he) {
+  // truncated normal values with stddev sqrt(2 / 100)
+  tsr_t X;
+  X.resize(100, 10);
+  X.randn_he(engine);
+  double upper = 2 * std::sqrt(2.0 / 100);
+  for (double x : X) {
+    EXPECT_LE(std::fabs(x), upper);
+  }
+}
+
+}  // namespace deepx_core
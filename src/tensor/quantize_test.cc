@@ -0,0 +1,146 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/common/stream.h>
+#include <deepx_core/dx_gtest.h>
+#include <deepx_core/tensor/data_type.h>
+#include <deepx_core/tensor/quantize.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace deepx_core {
+
+class QuantizeTest : public testing::Test, public DataType {
+ protected:
+  std::default_random_engine engine;
+};
+
+TEST_F(QuantizeTest, QuantizeRow) {
+  std::vector<float_t> X = {0, 1, -2, 0.5, 2, -1.99};
+  std::vector<int8_t> Q(X.size());
+  float_t scale = QuantizeRow((int)X.size(), X.data(), Q.data());
+  EXPECT_NEAR(scale, 2.0 / 127, 1e-6);
+  std::vector<int8_t> expected_Q = {0, 64, -127, 32, 127, -126};
+  EXPECT_EQ(Q, expected_Q);
+
+  std::vector<float_t> Y(X.size());
+  DequantizeRow((int)X.size(), Q.data(), scale, Y.data());
+  for (size_t i = 0; i < X.size(); ++i) {
+    EXPECT_NEAR(Y[i], X[i], scale / 2 + 1e-6);
+  }
+}
+
+TEST_F(QuantizeTest, QuantizeRow_zeros) {
+  std::vector<float_t> X(5, 0);
+  std::vector<int8_t> Q(X.size(), 1);
+  EXPECT_EQ(QuantizeRow((int)X.size(), X.data(), Q.data()), 0);
+  EXPECT_EQ(Q, std::vector<int8_t>(X.size(), 0));
+}
+
+TEST_F(QuantizeTest, QuantizedDot) {
+  std::uniform_int_distribution<int> dist(-127, 127);
+  for (int n : {0, 1, 31, 32, 33, 100}) {
+    std::vector<int8_t> X(n), Y(n);
+    int32_t expected = 0;
+    for (int i = 0; i < n; ++i) {
+      X[i] = (int8_t)dist(engine);
+      Y[i] = (int8_t)dist(engine);
+      expected += (int32_t)X[i] * (int32_t)Y[i];
+    }
+    EXPECT_EQ(QuantizedDot(n, X.data(), Y.data()), expected);
+  }
+
+  // the extreme case for 'pmaddubsw'
+  std::vector<int8_t> X(64, -127), Y(64, -127);
+  EXPECT_EQ(QuantizedDot(64, X.data(), Y.data()), 64 * 127 * 127);
+}
+
+TEST_F(QuantizeTest, QuantizedGEMM) {
+  int m = 3, n = 5, k = 70;
+  tsr_t X, W, Z;
+  X.resize(m, k);
+  X.randn(engine);
+  W.resize(k, n);
+  W.randn(engine);
+
+  qtsr_t qW;
+  qW.quantize(W);
+  std::vector<int8_t> qX((size_t)m * k);
+  std::vector<float_t> Xscale(m);
+  for (int i = 0; i < m; ++i) {
+    Xscale[i] = QuantizeRow(k, X.data() + i * k, &qX[(size_t)i * k]);
+  }
+  Z.resize(m, n);
+  QuantizedGEMM(m, n, k, qX.data(), Xscale.data(), qW.data(), qW.scale(),
+                Z.data());
+
+  tsr_t expected_Z;
+  expected_Z.resize(m, n);
+  ll_tensor_t::gemm(0, 0, X, W, &expected_Z);
+  EXPECT_TSR_NEAR_EPS(Z, expected_Z, 0.5);
+}
+
+TEST_F(QuantizeTest, QuantizedTensor) {
+  tsr_t W{{1, -4}, {2, 0}, {-0.5, 8}};
+  qtsr_t qW;
+  EXPECT_ANY_THROW(qW.quantize(tsr_t{1, 2, 3}));
+  qW.quantize(W);
+  EXPECT_EQ(qW.shape(), W.shape());
+  EXPECT_NEAR(qW.scale()[0], 2.0 / 127, 1e-6);
+  EXPECT_NEAR(qW.scale()[1], 8.0 / 127, 1e-6);
+  EXPECT_EQ(qW.channel(0)[1], 127);
+  EXPECT_EQ(qW.channel(1)[2], 127);
+  EXPECT_EQ(qW.channel(1)[0], -64);
+
+  tsr_t dW;
+  qW.dequantize(&dW);
+  EXPECT_TSR_NEAR_EPS(dW, W, 8.0 / 127 / 2);
+
+  OutputStringStream os;
+  InputStringStream is;
+  os << qW;
+  ASSERT_TRUE(os);
+  qtsr_t read_qW;
+  is.SetView(os.GetBuf());
+  is >> read_qW;
+  ASSERT_TRUE(is);
+  EXPECT_EQ(qW, read_qW);
+}
+
+TEST_F(QuantizeTest, QuantizedSparseRowMatrix) {
+  srm_t W{{1, 2, 3}, {{1, -1, 0.5, 0}, {0, 0, 0, 0}, {3, 30, -300, 0.3}}};
+  qsrm_t qW;
+  qW.quantize(W);
+  EXPECT_EQ(qW.size(), 3u);
+  EXPECT_EQ(qW.col(), 4);
+
+  float_t scale;
+  const int8_t* Q = qW.get_row_no_init(1, &scale);
+  ASSERT_TRUE(Q != nullptr);
+  EXPECT_NEAR(scale, 1.0 / 127, 1e-6);
+  EXPECT_EQ(Q[0], 127);
+  EXPECT_EQ(Q[1], -127);
+  EXPECT_EQ(Q[2], 64);
+  EXPECT_EQ(qW.get_row_no_init(4, &scale), nullptr);
+
+  srm_t dW;
+  qW.dequantize(&dW);
+  EXPECT_EQ(dW.size(), 3u);
+  EXPECT_EQ(dW.get_row_no_init(2)[0], 0);
+  EXPECT_NEAR(dW.get_row_no_init(3)[2], -300, 1e-3);
+  EXPECT_NEAR(dW.get_row_no_init(3)[1], 30, 300.0 / 127 / 2);
+
+  OutputStringStream os;
+  InputStringStream is;
+  os << qW;
+  ASSERT_TRUE(os);
+  qsrm_t read_qW;
+  is.SetView(os.GetBuf());
+  ReadView(is, read_qW);
+  ASSERT_TRUE(is);
+  EXPECT_EQ(qW, read_qW);
+}
+
+}  // namespace deepx_core
@@ -79,8 +79,7 @@ TEST_F(SparseRowMatrixTest, upsert) {
 TEST_F(SparseRowMatrixTest, upsert_if) {
   srm_t X{{1, 3}, {{1, 1}, {2, 2}}};
   srm_t Y{{3, 4}, {{3, 3}, {4, 4}}};
-  X.upsert_if(
-      Y, [](const srm_t::value_type& entry) { return entry.first % 2 == 0; });
+  X.upsert_if(Y, [](int_t row) { return row % 2 == 0; });
 
   srm_t expected_X{{1, 3, 4}, {{1, 1}, {2, 2}, {4, 4}}};
   EXPECT_EQ(X, expected_X);
@@ -107,8 +106,7 @@ TEST_F(SparseRowMatrixTest, merge_2) {
 TEST_F(SparseRowMatrixTest, merge_if_1) {
   srm_t X{{1, 2}, {{1, 1}, {2, 2}}};
   srm_t Y{{3, 4}, {{3, 3}, {4, 4}}};
-  X.merge_if(
-      Y, [](const srm_t::value_type& entry) { return entry.first % 2 == 0; });
+  X.merge_if(Y, [](int_t row) { return row % 2 == 0; });
 
   srm_t expected_X{{1, 2, 4}, {{1, 1}, {2, 2}, {4, 4}}};
   EXPECT_EQ(X, expected_X);
@@ -117,9 +115,7 @@ TEST_F(SparseRowMatrixTest, merge_if_1) {
 TEST_F(SparseRowMatrixTest, merge_if_2) {
   srm_t X{{1, 2}, {{1, 1}, {2, 2}}};
   srm_t Y{{3, 4}, {{3, 3}, {4, 4}}};
-  X.merge_if(std::move(Y), [](const srm_t::value_type& entry) {
-    return entry.first % 2 == 0;
-  });
+  X.merge_if(std::move(Y), [](int_t row) { return row % 2 == 0; });
 
   srm_t expected_X{{1, 2, 4}, {{1, 1}, {2, 2}, {4, 4}}};
   EXPECT_EQ(X, expected_X);
@@ -172,14 +168,23 @@ TEST_F(SparseRowMatrixTest, remove_if) {
            {8, 88},
            {9, 99},
            {10, 1010}}};
-  X.remove_if(
-      [](const srm_t::value_type& entry) { return entry.first % 2 == 0; });
+  X.remove_if([](int_t row) { return row % 2 == 0; });
 
   srm_t expected_X{{1, 3, 5, 7, 9},
                    {{1, 11}, {3, 33}, {5, 55}, {7, 77}, {9, 99}}};
   EXPECT_EQ(X, expected_X);
 }
 
+TEST_F(SparseRowMatrixTest, erase) {
+  srm_t X{{1, 2, 3}, {{1, 11}, {2, 22}, {3, 33}}};
+  EXPECT_EQ(X.erase(2), 1u);
+  EXPECT_EQ(X.erase(2), 0u);
+  EXPECT_EQ(X.erase(4), 0u);
+
+  srm_t expected_X{{1, 3}, {{1, 11}, {3, 33}}};
+  EXPECT_EQ(X, expected_X);
+}
+
 TEST_F(SparseRowMatrixTest, remove_zeros) {
   srm_t X{{1, 2, 3, 4, 5, 6, 7, 8, 9, 10},
           {{0, 11},
@@ -265,6 +270,71 @@ TEST_F(SparseRowMatrixTest, get_row_TENSOR_INITIALIZER_TYPE_RANDN) {
   EXPECT_EQ(X.get_row_no_init(2)[1], 22);
 }
 
+TEST_F(SparseRowMatrixTest, get_row_PhiloxEngine) {
+  // Initial values of a row do not depend on the order rows arrive.
+  PhiloxEngine engine1(1), engine2(1);
+  ReadWriteLock lock;
+  for (int initializer_type :
+       {TENSOR_INITIALIZER_TYPE_RAND, TENSOR_INITIALIZER_TYPE_RANDN}) {
+    srm_t X, Y;
+    X.set_col(5);
+    X.set_initializer(initializer_type, 0.5, 1.0);
+    Y.set_col(5);
+    Y.set_initializer(initializer_type, 0.5, 1.0);
+    for (int_t i = 0; i < 10; ++i) {
+      X.get_row(engine1, i);
+    }
+    for (int_t i = 10; i > 0; --i) {
+      Y.get_row(engine2, i - 1, &lock);
+    }
+    EXPECT_EQ(X, Y);
+    EXPECT_NE(X.get_row_no_init(1)[0], X.get_row_no_init(2)[0]);
+  }
+}
+
+TEST_F(SparseRowMatrixTest, get_row_PhiloxEngine_salt) {
+  // SRMs with different salts are initialized differently for the same id.
+  PhiloxEngine engine(1);
+  for (int initializer_type :
+       {TENSOR_INITIALIZER_TYPE_RAND, TENSOR_INITIALIZER_TYPE_RANDN}) {
+    srm_t X, Y, Z;
+    for (srm_t* W : {&X, &Y, &Z}) {
+      W->set_col(5);
+      W->set_initializer(initializer_type, 0.5, 1.0);
+    }
+    X.set_initializer_salt(1);
+    Y.set_initializer_salt(2);
+    Z.set_initializer_salt(1);
+    const float_t* x = X.get_row(engine, 7);
+    const float_t* y = Y.get_row(engine, 7);
+    const float_t* z = Z.get_row(engine, 7);
+    EXPECT_NE(std::vector<float_t>(x, x + 5), std::vector<float_t>(y, y + 5));
+    EXPECT_EQ(std::vector<float_t>(x, x + 5), std::vector<float_t>(z, z + 5));
+  }
+}
+
+TEST_F(SparseRowMatrixTest, get_row_PhiloxEngine_seed_keyed) {
+  // Engines of different shards share the keyed seed,
+  // rows are initialized the same regardless of the number of shards.
+  PhiloxEngine engine1(1 + 10099), engine2(1 + 2 * 10099), engine3(2);
+  engine1.seed_keyed(1);
+  engine2.seed_keyed(1);
+  engine3.seed_keyed(2);
+  for (int initializer_type :
+       {TENSOR_INITIALIZER_TYPE_RAND, TENSOR_INITIALIZER_TYPE_RANDN}) {
+    srm_t X, Y, Z;
+    for (srm_t* W : {&X, &Y, &Z}) {
+      W->set_col(5);
+      W->set_initializer(initializer_type, 0.5, 1.0);
+    }
+    const float_t* x = X.get_row(engine1, 7);
+    const float_t* y = Y.get_row(engine2, 7);
+    const float_t* z = Z.get_row(engine3, 7);
+    EXPECT_EQ(std::vector<float_t>(x, x + 5), std::vector<float_t>(y, y + 5));
+    EXPECT_NE(std::vector<float_t>(x, x + 5), std::vector<float_t>(z, z + 5));
+  }
+}
+
 TEST_F(SparseRowMatrixTest, get_scalar_TENSOR_INITIALIZER_TYPE_ZEROS) {
   srm_t X{{2}, {{2}}};
   X.set_initializer(TENSOR_INITIALIZER_TYPE_ZEROS);
@@ -400,4 +470,140 @@ TEST_F(SparseRowMatrixTest, WriteReadView) {
   EXPECT_EQ(X, read_X);
 }
 
+TEST_F(SparseRowMatrixTest, set_storage_dtype) {
+  srm_t X{{1, 2}, {{1, 1.00048828125}, {2, 3.14159}}};
+  X.set_storage_dtype(TENSOR_DTYPE_BFLOAT16);
+  EXPECT_EQ(X.storage_dtype(), TENSOR_DTYPE_BFLOAT16);
+  EXPECT_EQ(X.size(), 2u);
+  EXPECT_EQ(X.half_rows().size(), 2u);
+  // Rows are not in 'float_t' any more.
+  EXPECT_FALSE(((const srm_t&)X).get_row_no_init(1));
+  EXPECT_TRUE(X.begin() == X.end());
+
+  std::vector<float_t> row_value(2);
+  EXPECT_TRUE(X.decode_row(1, row_value.data()));
+  EXPECT_EQ(row_value, std::vector<float_t>({1, 1}));
+  EXPECT_TRUE(X.decode_row(2, row_value.data()));
+  EXPECT_EQ(row_value, std::vector<float_t>({2, 3.140625}));
+  EXPECT_FALSE(X.decode_row(3, row_value.data()));
+
+  X.set_storage_dtype(TENSOR_DTYPE_NONE);
+  srm_t expected_X{{1, 2}, {{1, 1}, {2, 3.140625}}};
+  EXPECT_EQ(X, expected_X);
+  EXPECT_TRUE(X.half_rows().empty());
+  EXPECT_ANY_THROW(X.set_storage_dtype(TENSOR_DTYPE_INT8));
+}
+
+TEST_F(SparseRowMatrixTest, get_half_row) {
+  srm_t X, Y;
+  X.set_col(16);
+  X.set_initializer(TENSOR_INITIALIZER_TYPE_RANDN, 0, 1);
+  Y = X;
+  X.set_storage_dtype(TENSOR_DTYPE_FLOAT16);
+  EXPECT_FALSE(X.get_half_row_no_init(1));
+  PhiloxEngine engine1, engine2;
+  const uint16_t* row = X.get_half_row(engine1, 1);
+  EXPECT_EQ(X.get_half_row_no_init(1), row);
+  // Initial values are those in 'float_t' rounded to nearest.
+  const float_t* expected_row = Y.get_row(engine2, 1);
+  for (int i = 0; i < X.col(); ++i) {
+    EXPECT_EQ(row[i], FloatToFP16((float)expected_row[i]));
+  }
+}
+
+TEST_F(SparseRowMatrixTest, assign_storage_dtype) {
+  srm_t X;
+  X.set_col(2);
+  X.set_storage_dtype(TENSOR_DTYPE_BFLOAT16);
+  std::vector<float_t> row_value = {1.00048828125, 2};
+  X.assign(1, row_value.data());
+  std::vector<uint16_t> half_row_value = {FloatToBF16(3), FloatToBF16(4)};
+  X.assign_half_view(2, half_row_value.data());
+
+  srm_t expected_X{{1, 2}, {{1, 2}, {3, 4}}};
+  expected_X.set_storage_dtype(TENSOR_DTYPE_BFLOAT16);
+  EXPECT_EQ(X, expected_X);
+
+  // 1 + 2^-10 is 1/8 of the way from 1 to the next bfloat16 1 + 2^-7.
+  X.set_col(1);
+  X.zeros();
+  row_value = {1 + 0.0009765625};
+  double sum = 0;
+  for (int i = 0; i < 10000; ++i) {
+    X.assign_stochastic(engine, 1, row_value.data());
+    float_t value;
+    ASSERT_TRUE(X.decode_row(1, &value));
+    EXPECT_TRUE(value == 1 || value == 1.0078125);
+    sum += value;
+  }
+  EXPECT_NEAR(sum / 10000, 1 + 0.0009765625, 1e-4);
+}
+
+TEST_F(SparseRowMatrixTest, merge_storage_dtype) {
+  srm_t X{{1, 2}, {{1, 1}, {2, 2}}};
+  srm_t Y{{2, 3}, {{22, 22}, {3, 3}}};
+  srm_t Z{{3, 4}, {{33, 33}, {4, 4}}};
+  X.set_storage_dtype(TENSOR_DTYPE_FLOAT16);
+  Z.set_storage_dtype(TENSOR_DTYPE_FLOAT16);
+  // from 'float_t'
+  X.merge(Y);
+  // from the same storage dtype
+  X.merge(std::move(Z));
+  EXPECT_TRUE(Z.empty());
+
+  srm_t expected_X{{1, 2, 3, 4}, {{1, 1}, {2, 2}, {3, 3}, {4, 4}}};
+  expected_X.set_storage_dtype(TENSOR_DTYPE_FLOAT16);
+  EXPECT_EQ(X, expected_X);
+
+  // to 'float_t'
+  Y.upsert(X);
+  expected_X.set_storage_dtype(TENSOR_DTYPE_NONE);
+  EXPECT_EQ(Y, expected_X);
+
+  X.remove_if([](int_t row) { return row % 2 == 0; });
+  EXPECT_EQ(X.size(), 2u);
+  std::vector<float_t> row_value = {0, 0};
+  X.assign(5, row_value.data());
+  X.remove_zeros();
+  EXPECT_EQ(X.size(), 2u);
+  EXPECT_EQ(X.erase(1), 1u);
+  EXPECT_EQ(X.erase(1), 0u);
+  EXPECT_EQ(X.size(), 1u);
+}
+
+TEST_F(SparseRowMatrixTest, WriteRead_storage_dtype) {
+  for (int storage_dtype : {TENSOR_DTYPE_FLOAT16, TENSOR_DTYPE_BFLOAT16}) {
+    srm_t X{{1, 2, 3}, {{1, 11}, {2, 22}, {3, 33.5}}}, read_X, read_view_X;
+    X.set_storage_dtype(storage_dtype);
+
+    OutputStringStream os;
+    InputStringStream is;
+
+    os << X;
+    ASSERT_TRUE(os);
+
+    srm_t full_X{{1, 2, 3}, {{1, 11}, {2, 22}, {3, 33.5}}};
+    OutputStringStream full_os;
+    full_os << full_X;
+    ASSERT_TRUE(full_os);
+    EXPECT_LT(os.GetBuf().second, full_os.GetBuf().second);
+
+    is.SetView(os.GetBuf());
+    is >> read_X;
+    ASSERT_TRUE(is);
+    EXPECT_EQ(X, read_X);
+
+    is.SetView(os.GetBuf());
+    ReadView(is, read_view_X);
+    ASSERT_TRUE(is);
+    EXPECT_EQ(X, read_view_X);
+
+    // Rows in 'float_t' overwrite rows in 16 bits.
+    is.SetView(full_os.GetBuf());
+    is >> read_X;
+    ASSERT_TRUE(is);
+    EXPECT_EQ(read_X, full_X);
+  }
+}
+
 }  // namespace deepx_core
@@ -13,11 +13,11 @@
 #include <deepx_core/graph/model.h>
 #include <deepx_core/graph/op_context.h>
 #include <deepx_core/graph/tensor_map.h>
+#include <deepx_core/tensor/philox.h>
 #include <gflags/gflags.h>
 #include <cstdint>
 #include <iostream>
 #include <memory>
-#include <random>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -117,7 +117,7 @@ class MockModelContext {
 
   void InitModel(const std::vector<int_t>& ids) {
     DXINFO("Initializing mock model...");
-    std::default_random_engine engine;
+    PhiloxEngine engine;
     model_.Init(&graph_);
     DXCHECK_THROW(model_.InitParam(engine));
     for (auto& entry : *model_.mutable_param()) {
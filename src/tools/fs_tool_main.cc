@@ -36,7 +36,7 @@ int real_main(int argc, char** argv) {
 
     std::string line;
     while (GetLine(is, line)) {
-      std::cout << line << std::endl;
+      std::cout << line << '\n';
     }
   } else if (action == "testwr") {
     AutoOutputFileStream os;
@@ -66,6 +66,7 @@ int main(int argc, char** argv) {
     model_shards[i].reset(new ModelShard);
     model_shards[i]->InitShard(&FLAGS_shard, i);
     model_shards[i]->InitGraph(&graph);
+    model_shards[i]->set_keep_srm_storage_dtype(true);
     DXCHECK_THROW(model_shards[i]->LoadModel(FLAGS_in_model));
   }
 
@@ -0,0 +1,123 @@
+// Copyright 2026 the deepx authors.
+// Author: agent (agent@local)
+//
+
+#include <deepx_core/common/stream.h>
+#include <deepx_core/dx_log.h>
+#include <deepx_core/graph/graph.h>
+#include <deepx_core/graph/model_shard.h>
+#include <deepx_core/graph/shard.h>
+#include <gflags/gflags.h>
+#include <string>
+
+DEFINE_string(in_model, "", "input model dir");
+DEFINE_string(out_model, "", "output model dir");
+DEFINE_int32(shard_size, 0, "output shard size");
+DEFINE_string(shard_func, "",
+              "output shard func name(optional), default: same as input");
+DEFINE_int32(reshard_optimizer, 1, "reshard optimizer");
+DEFINE_int32(reshard_ts_store, 0, "reshard timestamp store");
+DEFINE_int32(reshard_freq_store, 0, "reshard frequency store");
+DEFINE_int32(out_model_chunk_size, 0,
+             "chunk size(MB) of output model files, 0 disables chunking");
+DEFINE_int32(out_model_compress, 0, "compress output model files by LZ4");
+
+namespace deepx_core {
+namespace {
+
+Shard FLAGS_in_shard;
+Shard FLAGS_out_shard;
+
+void CheckFlags() {
+  AutoFileSystem fs;
+
+  CanonicalizePath(&FLAGS_in_model);
+  DXCHECK_THROW(!FLAGS_in_model.empty());
+  DXCHECK_THROW(fs.Open(FLAGS_in_model));
+  DXCHECK_THROW(!IsStdinStdoutPath(FLAGS_in_model));
+
+  CanonicalizePath(&FLAGS_out_model);
+  if (FLAGS_out_model.empty()) {
+    FLAGS_out_model = FLAGS_in_model + ".reshard";
+    DXINFO("Didn't specify --out_model, output to: %s.",
+           FLAGS_out_model.c_str());
+  }
+  DXCHECK_THROW(fs.Open(FLAGS_out_model));
+  DXCHECK_THROW(!IsStdinStdoutPath(FLAGS_out_model));
+  DXCHECK_THROW(FLAGS_out_model != FLAGS_in_model);
+
+  DXCHECK_THROW(LoadShard(FLAGS_in_model, &FLAGS_in_shard));
+  DXCHECK_THROW(FLAGS_in_shard.shard_mode() == 1);
+  DXCHECK_THROW(FLAGS_shard_size > 0);
+  DXCHECK_THROW(FLAGS_out_model_chunk_size >= 0);
+  if (FLAGS_shard_func.empty()) {
+    FLAGS_shard_func = FLAGS_in_shard.shard_func_name();
+  }
+  FLAGS_out_shard.InitShard(FLAGS_shard_size, FLAGS_shard_func);
+}
+
+int main(int argc, char** argv) {
+  google::SetUsageMessage("Usage: [Options]");
+#if HAVE_COMPILE_FLAGS_H == 1
+  google::SetVersionString("\n\n"
+#include "compile_flags.h"
+  );
+#endif
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  CheckFlags();
+
+  DXINFO("shard_size: %d -> %d", FLAGS_in_shard.shard_size(),
+         FLAGS_out_shard.shard_size());
+  DXINFO("shard_func: %s -> %s", FLAGS_in_shard.shard_func_name().c_str(),
+         FLAGS_out_shard.shard_func_name().c_str());
+
+  Graph graph;
+  DXCHECK_THROW(LoadGraph(FLAGS_in_model, &graph));
+
+  std::string new_path;
+  if (AutoFileSystem::BackupIfExists(FLAGS_out_model, &new_path)) {
+    DXINFO("Backed up %s to %s.", FLAGS_out_model.c_str(), new_path.c_str());
+  }
+  if (!AutoFileSystem::Exists(FLAGS_out_model)) {
+    DXCHECK_THROW(AutoFileSystem::MakeDir(FLAGS_out_model));
+  }
+
+  // Output shards are produced one by one to bound the memory usage,
+  // every output shard only reads the input shards overlapping with it.
+  for (int i = 0; i < FLAGS_out_shard.shard_size(); ++i) {
+    DXINFO("Resharding shard %d...", i);
+    ModelShard model_shard;
+    model_shard.InitShard(&FLAGS_out_shard, i);
+    model_shard.InitGraph(&graph);
+    model_shard.set_chunk_size((size_t)FLAGS_out_model_chunk_size << 20);
+    model_shard.set_compress(FLAGS_out_model_compress != 0);
+    model_shard.set_keep_srm_storage_dtype(true);
+    DXCHECK_THROW(model_shard.LoadModel(FLAGS_in_model));
+    DXCHECK_THROW(model_shard.SaveModel(FLAGS_out_model));
+    if (FLAGS_reshard_optimizer) {
+      DXCHECK_THROW(model_shard.LoadOptimizer(FLAGS_in_model, ""));
+      DXCHECK_THROW(model_shard.SaveOptimizer(FLAGS_out_model));
+    }
+    if (FLAGS_reshard_ts_store) {
+      DXCHECK_THROW(model_shard.LoadTSStore(FLAGS_in_model, 0, 0));
+      DXCHECK_THROW(model_shard.SaveTSStore(FLAGS_out_model));
+    }
+    if (FLAGS_reshard_freq_store) {
+      DXCHECK_THROW(model_shard.LoadFreqStore(FLAGS_in_model, 0));
+      DXCHECK_THROW(model_shard.SaveFreqStore(FLAGS_out_model));
+    }
+    DXCHECK_THROW(model_shard.SaveSuccess(FLAGS_out_model));
+  }
+
+  DXCHECK_THROW(SaveGraph(FLAGS_out_model, graph));
+  DXCHECK_THROW(SaveShard(FLAGS_out_model, FLAGS_out_shard));
+
+  google::ShutDownCommandLineFlags();
+  return 0;
+}
+
+}  // namespace
+}  // namespace deepx_core
+
+int main(int argc, char** argv) { return deepx_core::main(argc, argv); }